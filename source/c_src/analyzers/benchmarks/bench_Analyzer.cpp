@@ -0,0 +1,124 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/benchmarks/bench_Analyzer.cpp
+//
+// @file
+// @brief Measures how the parallel driver scales with the number of worker
+//        threads on a set of real C files.
+//
+// Usage: bench_Analyzer [-t max_threads] [-r rounds] path...
+//
+// Every path is a C file or a directory searched for `.c` files. The whole
+// set is analyzed with 1, 2, 4, ... threads up to `max_threads` (the number
+// of hardware threads by default), each `rounds` times (3 by default) after
+// a warm-up run, and the best time of each thread count is reported with
+// its speedup and efficiency over one thread. Analysis of a unit includes a
+// style pass counting its calls, so the workers do some work after parsing.
+// ================================
+
+#include "analyzer/Analyzer.h"
+#include "core/CAnalyzer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ca;
+using namespace ca::analyzers;
+using namespace ca::analyzers::c;
+
+namespace {
+
+std::unique_ptr<IAnalyzer>
+make_analyzer(ca_size_t) {
+    auto analyzer = std::make_unique<CAnalyzer>();
+    analyzer->add_pass(CAnalysisStage::STAGE_STYLE, [](const CAst &ast, AnalysisContext &, AnalysisResult &result) {
+        result.findings += ast.nodes_of_kind(CNodeKind::NODE_CALL).size();
+    });
+    return analyzer;
+}
+
+}
+
+int
+main(int argc, char **argv) {
+    ca_size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    int rounds = 3;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            max_threads = std::max(1, std::atoi(argv[++i]));
+            continue;
+        }
+        if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+            continue;
+        }
+        std::error_code error;
+        if (std::filesystem::is_directory(argv[i], error)) {
+            for (const auto &entry : std::filesystem::recursive_directory_iterator(
+                     argv[i], std::filesystem::directory_options::skip_permission_denied, error)) {
+                if (entry.is_regular_file(error) && entry.path().extension() == ".c") {
+                    files.push_back(entry.path().string());
+                }
+            }
+        } else {
+            files.emplace_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        std::fprintf(stderr, "usage: %s [-t max_threads] [-r rounds] path...\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<ca_size_t> counts;
+    for (ca_size_t threads = 1; threads < max_threads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(max_threads);
+
+    std::printf("%zu files\n", files.size());
+    std::printf("%8s %10s %10s %8s %8s %8s %8s\n", "threads", "seconds", "MB/s", "speedup", "effic.", "busy", "steals");
+    double serial_seconds = 0;
+    for (const ca_size_t threads : counts) {
+        AnalyzerOptions options;
+        options.threads = threads;
+        Analyzer driver(make_analyzer, options);
+        AnalysisResultSink sink(files.size());
+
+        // The warm-up run makes the analyzers and loads the page cache
+        driver.run(files, &sink);
+        double best = 1e30;
+        AnalyzerStats best_stats{};
+        for (int r = 0; r < rounds; ++r) {
+            sink.clear();
+            driver.run(files, &sink);
+            const double seconds = static_cast<double>(driver.stats().nanoseconds) / 1e9;
+            if (seconds < best) {
+                best = seconds;
+                best_stats = driver.stats();
+            }
+        }
+        if (threads == 1) {
+            serial_seconds = best;
+        }
+
+        const double speedup = serial_seconds / best;
+        // Fraction of the wall time the workers spent in units
+        const double busy = static_cast<double>(best_stats.busy_nanoseconds) /
+                            (static_cast<double>(best_stats.nanoseconds) * static_cast<double>(best_stats.threads));
+        std::printf("%8zu %10.3f %10.1f %8.2f %7.0f%% %7.0f%% %8zu\n", best_stats.threads, best,
+                    static_cast<double>(best_stats.bytes) / best / 1e6, speedup,
+                    100.0 * speedup / static_cast<double>(best_stats.threads), 100.0 * busy, best_stats.steals);
+        if (best_stats.failures != 0) {
+            std::printf("%zu files could not be analyzed\n", best_stats.failures);
+        }
+    }
+    return 0;
+}
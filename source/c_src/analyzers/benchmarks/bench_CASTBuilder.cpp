@@ -0,0 +1,85 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/benchmarks/bench_CASTBuilder.cpp
+//
+// @file
+// @brief Measures the throughput of `CASTBuilder` and the memory of the
+//        trees it builds on real C files.
+//
+// Usage: bench_CASTBuilder [-r rounds] file.c...
+//
+// Every file is read into memory once, then built `rounds` times (10 by
+// default) into one reused tree, as a translation unit driver would.
+// ================================
+
+#include "core/parser/CASTBuilder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace ca;
+using namespace ca::analyzers::c;
+
+int
+main(int argc, char **argv) {
+    int rounds = 10;
+    std::vector<std::string> sources;
+    std::vector<const char *> names;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+            continue;
+        }
+        std::ifstream in(argv[i], std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "cannot open %s\n", argv[i]);
+            return 1;
+        }
+        sources.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        names.push_back(argv[i]);
+    }
+    if (sources.empty()) {
+        std::fprintf(stderr, "usage: %s [-r rounds] file.c...\n", argv[0]);
+        return 1;
+    }
+
+    ca_string::ca_intern_pool pool;
+    CASTBuilder builder(&pool);
+    CAst ast;
+    double total_seconds = 0;
+    ca_uint64_t total_bytes = 0;
+
+    for (ca_size_t f = 0; f < sources.size(); ++f) {
+        const std::string &source = sources[f];
+        double best = 1e30;
+        for (int r = 0; r < rounds; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            if (builder.build(reinterpret_cast<const ca_string::ca_char_t*>(source.data()), source.size(), &ast) != 0) {
+                std::fprintf(stderr, "%s is too large\n", names[f]);
+                return 1;
+            }
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count());
+            total_seconds += elapsed.count();
+            total_bytes += source.size();
+        }
+        std::printf("%-40s %10zu bytes %9zu nodes %8.1f MB/s %5.1f bytes/node (best of %d)\n", names[f],
+                    source.size(), ast.size(), static_cast<double>(source.size()) / best / 1e6, ast.bytes_per_node(),
+                    rounds);
+    }
+
+    const CASTBuilderStats &stats = builder.stats();
+    std::printf("total: %.1f MB/s, %.2f nodes/token, %.1f bytes/node (node record %zu bytes), %llu syntax errors\n",
+                static_cast<double>(total_bytes) / total_seconds / 1e6,
+                static_cast<double>(stats.nodes) / static_cast<double>(std::max<ca_uint64_t>(stats.tokens, 1)),
+                static_cast<double>(stats.node_bytes) / static_cast<double>(std::max<ca_uint64_t>(stats.nodes, 1)),
+                sizeof(CAstNode), static_cast<unsigned long long>(stats.errors / static_cast<ca_uint64_t>(rounds)));
+    return 0;
+}
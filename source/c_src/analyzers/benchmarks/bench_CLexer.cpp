@@ -0,0 +1,85 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/benchmarks/bench_CLexer.cpp
+//
+// @file
+// @brief Measures the throughput of `CLexer` in MB/s on real C files.
+//
+// Usage: bench_CLexer [-r rounds] file.c...
+//
+// Every file is read into memory once, then lexed `rounds` times (10 by
+// default) with one lexer and one pool, as a translation unit driver would.
+// Large real-world files such as sqlite3.c or the Linux kernel sources give
+// the most meaningful numbers.
+// ================================
+
+#include "core/parser/CLexer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace ca;
+using namespace ca::analyzers::c;
+
+int
+main(int argc, char **argv) {
+    int rounds = 10;
+    std::vector<std::string> sources;
+    std::vector<const char *> names;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+            continue;
+        }
+        std::ifstream in(argv[i], std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "cannot open %s\n", argv[i]);
+            return 1;
+        }
+        sources.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        names.push_back(argv[i]);
+    }
+    if (sources.empty()) {
+        std::fprintf(stderr, "usage: %s [-r rounds] file.c...\n", argv[0]);
+        return 1;
+    }
+
+    ca_string::ca_intern_pool pool;
+    CLexer lexer(&pool);
+    CTokenStream tokens;
+    double total_seconds = 0;
+    ca_uint64_t total_bytes = 0;
+
+    for (ca_size_t f = 0; f < sources.size(); ++f) {
+        const std::string &source = sources[f];
+        double best = 1e30;
+        for (int r = 0; r < rounds; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            if (lexer.lex(reinterpret_cast<const ca_string::ca_char_t*>(source.data()), source.size(), &tokens) != 0) {
+                std::fprintf(stderr, "%s is too large\n", names[f]);
+                return 1;
+            }
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count());
+            total_seconds += elapsed.count();
+            total_bytes += source.size();
+        }
+        std::printf("%-40s %10zu bytes %9zu tokens %8.1f MB/s (best of %d)\n", names[f], source.size(),
+                    tokens.size() - 1, static_cast<double>(source.size()) / best / 1e6, rounds);
+    }
+
+    const CLexerStats &stats = lexer.stats();
+    std::printf("total: %.1f MB/s, %.1f bytes/token, %.1f%% comments, %zu distinct identifiers\n",
+                static_cast<double>(total_bytes) / total_seconds / 1e6,
+                static_cast<double>(stats.bytes) / static_cast<double>(std::max<ca_uint64_t>(stats.tokens, 1)),
+                100.0 * static_cast<double>(stats.comment_bytes) / static_cast<double>(std::max<ca_uint64_t>(stats.bytes, 1)),
+                pool.size());
+    return 0;
+}
@@ -0,0 +1,84 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/c/core/CAnalyzer.cpp
+//
+// @file
+// @brief Implements `CAnalyzer`.
+// ================================
+
+#include "core/CAnalyzer.h"
+
+#include <utility>
+
+namespace ca::analyzers::c {
+
+namespace {
+
+/**
+ * @brief Describes why a unit could not be read.
+ */
+const char *
+read_error(const ca_io::ca_file_result result) {
+    switch (result) {
+    case ca_io::ca_file_result::FILE_ERROR_NOT_FOUND:
+        return "file not found";
+    case ca_io::ca_file_result::FILE_ERROR_ACCESS_DENIED:
+        return "access denied";
+    case ca_io::ca_file_result::FILE_ERROR_OUT_OF_MEMORY:
+        return "out of memory";
+    case ca_io::ca_file_result::FILE_ERROR_IO_ERROR:
+        return "I/O error";
+    default:
+        return "cannot read file";
+    }
+}
+
+}
+
+CAnalyzer::CAnalyzer(const ca_io::ca_file_read_options &read_options, const CIncludeOptions &include_options)
+    : options(read_options), parser(&pool), includes(&pool, include_options, read_options) {}
+
+void
+CAnalyzer::add_pass(const CAnalysisStage stage, CAnalysisPass pass) {
+    passes[static_cast<ca_size_t>(stage)].push_back(std::move(pass));
+}
+
+int
+CAnalyzer::analyze(const std::string &filepath, AnalysisContext &context, AnalysisResult *result) {
+    const ca_io::ca_file_result read = ca_io::ca_file_read(filepath.c_str(), &source, options);
+    if (read != ca_io::ca_file_result::FILE_OK) {
+        tree.reset();
+        inclusions = CIncludeUnit();
+        result->error = read_error(read);
+        return -1;
+    }
+    result->bytes = source.size();
+
+    // Stage 1: the syntax tree
+    const ca_uint64_t errors_before = parser.stats().errors;
+    if (parser.build(source.data(), source.size(), &tree) != 0) {
+        source.reset();
+        inclusions = CIncludeUnit();
+        result->error = "file too large";
+        return -1;
+    }
+    result->tokens = tree.tokens.size();
+    result->nodes = tree.size();
+    result->syntax_errors = parser.stats().errors - errors_before;
+
+    // The passes of stages 1 to 9 over the tree, with the includes followed
+    // before those of stage 2
+    for (ca_size_t stage = 0; stage < C_ANALYSIS_STAGE_COUNT; ++stage) {
+        if (stage == static_cast<ca_size_t>(CAnalysisStage::STAGE_INCLUDES)) {
+            includes.analyze(filepath, source.data(), tree.tokens, &inclusions);
+            result->headers = inclusions.headers.size();
+            result->avoided_reads = inclusions.avoided_reads;
+        }
+        for (const CAnalysisPass &pass : passes[stage]) {
+            pass(tree, context, *result);
+        }
+    }
+
+    return 0;
+}
+
+}
@@ -0,0 +1,473 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/c/core/include/CIncludeAnalyzer.cpp
+//
+// @file
+// @brief Implements `CIncludeAnalyzer`.
+// ================================
+
+#include "core/include/CIncludeAnalyzer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace ca::analyzers::c {
+
+namespace {
+
+/**
+ * @brief Variant index of inclusions that were not cached.
+ */
+constexpr ca_size_t NO_VARIANT = CA_SIZE_T_MAX;
+
+/**
+ * @brief Token index meaning no token.
+ */
+constexpr ca_size_t NO_TOKEN = CA_SIZE_T_MAX;
+
+/**
+ * @brief Interns a C string.
+ */
+CTokenStream::id_type
+intern(ca_string::ca_intern_pool &pool, const char *text) {
+    return pool.intern(reinterpret_cast<const ca_string::ca_char_t *>(text), std::strlen(text));
+}
+
+/**
+ * @brief Returns the index of the first token of the line after a
+ *        directive.
+ */
+ca_size_t
+line_end(const CTokenStream &tokens, const ca_size_t hash, const ca_size_t count) {
+    ca_size_t end = hash + 1;
+    while (end < count && (tokens.flags[end] & C_TOKEN_LINE_START) == 0) {
+        ++end;
+    }
+    return end;
+}
+
+/**
+ * @brief Checks if a token starts a directive.
+ */
+bool
+is_directive(const CTokenStream &tokens, const ca_size_t i) {
+    return tokens.kinds[i] == CTokenKind::PUNCT_HASH && (tokens.flags[i] & C_TOKEN_LINE_START) != 0;
+}
+
+/**
+ * @brief Checks if a directive continues or closes a conditional.
+ */
+bool
+continues_conditional(const CDirectiveKind kind) {
+    return kind == CDirectiveKind::DIRECTIVE_ELIF || kind == CDirectiveKind::DIRECTIVE_ELIFDEF ||
+           kind == CDirectiveKind::DIRECTIVE_ELIFNDEF || kind == CDirectiveKind::DIRECTIVE_ELSE ||
+           kind == CDirectiveKind::DIRECTIVE_ENDIF;
+}
+
+}
+
+CIncludeAnalyzer::CIncludeAnalyzer(ca_string::ca_intern_pool *pool, const CIncludeOptions &options,
+                                   const ca_io::ca_file_read_options &read_options)
+    : read_options(read_options), max_depth(options.max_depth), lexer(pool), macro_table(pool),
+      includes(options.search_paths), once_id(intern(lexer.pool(), "once")),
+      defined_id(intern(lexer.pool(), "defined")), current(nullptr), probing(ca_io::ca_path_table::INVALID_ID),
+      totals() {
+    macro_table.set_include_probe([this](const std::string_view name, const bool angled, const bool next) {
+        return includes.resolve(probing, name, angled, next) != ca_io::ca_path_table::INVALID_ID;
+    });
+    // `-DNAME=BODY` is `#define NAME BODY`, and `-DNAME` is `#define NAME 1`
+    for (const std::string &define : options.defines) {
+        const ca_size_t equal = define.find('=');
+        predefined_source += "#define ";
+        if (equal == std::string::npos) {
+            predefined_source += define;
+            predefined_source += " 1";
+        } else {
+            predefined_source.append(define, 0, equal);
+            predefined_source += ' ';
+            predefined_source.append(define, equal + 1);
+        }
+        predefined_source += '\n';
+    }
+    lexer.lex(reinterpret_cast<const ca_string::ca_char_t *>(predefined_source.data()), predefined_source.size(),
+              &predefined);
+}
+
+void
+CIncludeAnalyzer::analyze(const std::string_view path, const ca_string::ca_char_t *source,
+                          const CTokenStream &tokens, CIncludeUnit *unit) {
+    assert(unit != nullptr);
+    *unit = CIncludeUnit();
+    current = unit;
+    entered.clear();
+    ++totals.units;
+
+    macro_table.reset();
+    const auto *predefined_text = reinterpret_cast<const ca_string::ca_char_t *>(predefined_source.data());
+    for (ca_size_t i = 0; i + 1 < predefined.size(); ++i) {
+        if (predefined.kinds[i] == CTokenKind::PUNCT_HASH) {
+            ca_size_t end = i + 1;
+            while (end + 1 < predefined.size() && (predefined.flags[end] & C_TOKEN_LINE_START) == 0) {
+                ++end;
+            }
+            macro_table.directive(macro_table.directive_kind(predefined, i), predefined_text, predefined, i + 2, end);
+            i = end - 1;
+        }
+    }
+
+    unit->file = includes.paths().intern(path);
+    summary contents;
+    walk(unit->file, source, tokens.offsets.back(), &tokens, 0, &contents);
+    collect(contents);
+
+    std::sort(unit->declarations.begin(), unit->declarations.end());
+    unit->declarations.erase(std::unique(unit->declarations.begin(), unit->declarations.end()),
+                             unit->declarations.end());
+    current = nullptr;
+}
+
+void
+CIncludeAnalyzer::walk(const ca_io::ca_path_id file, const ca_string::ca_char_t *source, const ca_size_t size,
+                       const CTokenStream *tokens, const ca_size_t depth, summary *out) {
+    // Conditionals opened by the includers cannot be closed by this file
+    const ca_size_t floor = macro_table.depth();
+    while (tokens == nullptr && sections.size() <= depth) {
+        sections.emplace_back();
+    }
+    const CTokenStream &stream = tokens != nullptr ? *tokens : sections[depth];
+    ca_size_t count = tokens != nullptr ? tokens->size() - 1 : 0;
+    // Where the next section starts, when lexing section by section
+    ca_size_t offset = 0;
+    ca_size_t braces = 0;
+    ca_size_t parens = 0;
+    bool initializer = false;
+    ca_size_t previous = NO_TOKEN;
+
+    for (ca_size_t i = 0;;) {
+        if (i == count) {
+            if (tokens != nullptr || offset >= size) {
+                break;
+            }
+            const ca_size_t start = offset;
+            lexer.lex_section(source, size, start, &sections[depth], &offset);
+            totals.bytes_lexed += offset - start;
+            count = stream.size() - 1;
+            i = 0;
+            continue;
+        }
+
+        if (is_directive(stream, i)) {
+            const ca_size_t end = line_end(stream, i, count);
+            const CDirectiveKind kind = macro_table.directive_kind(stream, i);
+            const ca_size_t first = kind == CDirectiveKind::DIRECTIVE_NONE ? i + 1 : i + 2;
+            if (continues_conditional(kind) && macro_table.depth() <= floor) {
+                ++out->errors;
+                out->cacheable = false;
+            } else if (kind == CDirectiveKind::DIRECTIVE_INCLUDE || kind == CDirectiveKind::DIRECTIVE_INCLUDE_NEXT) {
+                if (macro_table.active()) {
+                    include(file, source, stream, kind, first, end, depth, out);
+                }
+            } else {
+                if (kind == CDirectiveKind::DIRECTIVE_PRAGMA && first < end && stream.ids[first] == once_id &&
+                    macro_table.active()) {
+                    pragma_once(file);
+                }
+                probing = file;
+                if (macro_table.directive(kind, source, stream, first, end) != 0) {
+                    // A condition that could not be evaluated may have
+                    // picked the wrong group
+                    ++out->errors;
+                    out->cacheable = false;
+                }
+            }
+            previous = NO_TOKEN;
+            i = end;
+
+            // The rest of a group that is not compiled is jumped over, up
+            // to the directive ending it
+            if (!macro_table.active()) {
+                const ca_size_t from = i < count ? stream.offsets[i] : tokens != nullptr ? size : offset;
+                const ca_size_t to = lexer.skip_group(source, size, from);
+                if (tokens == nullptr) {
+                    offset = to;
+                    totals.bytes_skipped += to - from;
+                } else {
+                    const auto it = std::lower_bound(stream.offsets.begin() + i, stream.offsets.begin() + count, to);
+                    const auto target = static_cast<ca_size_t>(it - stream.offsets.begin());
+                    // Tokens the scan disagrees with are walked one by one
+                    if (target == count ? to == size
+                                        : stream.offsets[target] == to && is_directive(stream, target)) {
+                        i = target;
+                        totals.unit_bytes_jumped += to - from;
+                    }
+                }
+            }
+            continue;
+        }
+        if (!macro_table.active()) {
+            ++i;
+            continue;
+        }
+
+        // Declarations at file scope: an identifier followed by one of the
+        // tokens ending a declarator
+        const bool file_scope = braces == 0 && parens == 0;
+        const bool after_name = file_scope && previous != NO_TOKEN &&
+                                stream.kinds[previous] == CTokenKind::TOKEN_IDENTIFIER;
+        switch (stream.kinds[i]) {
+        case CTokenKind::PUNCT_L_PAREN:
+            // `__attribute__((...))` and the like are not declarations
+            if (after_name && !initializer && stream.kinds[i + 1] != CTokenKind::PUNCT_L_PAREN) {
+                out->declarations.push_back(stream.ids[previous]);
+            }
+            ++parens;
+            break;
+        case CTokenKind::PUNCT_R_PAREN:
+            parens -= parens != 0;
+            break;
+        case CTokenKind::PUNCT_L_BRACE:
+            ++braces;
+            break;
+        case CTokenKind::PUNCT_R_BRACE:
+            braces -= braces != 0;
+            break;
+        case CTokenKind::PUNCT_SEMI:
+        case CTokenKind::PUNCT_COMMA:
+        case CTokenKind::PUNCT_EQUAL:
+        case CTokenKind::PUNCT_L_SQUARE:
+            if (after_name && !initializer) {
+                out->declarations.push_back(stream.ids[previous]);
+            }
+            if (file_scope && stream.kinds[i] != CTokenKind::PUNCT_L_SQUARE) {
+                initializer = stream.kinds[i] == CTokenKind::PUNCT_EQUAL;
+            }
+            break;
+        default:
+            break;
+        }
+        previous = i;
+        ++i;
+    }
+
+    if (macro_table.depth() != floor) {
+        // Unterminated conditionals
+        ++out->errors;
+        out->cacheable = false;
+        macro_table.truncate(floor);
+    }
+}
+
+void
+CIncludeAnalyzer::include(const ca_io::ca_path_id file, const ca_string::ca_char_t *source,
+                          const CTokenStream &tokens, const CDirectiveKind kind, const ca_size_t first,
+                          const ca_size_t last, const ca_size_t depth, summary *out) {
+    ++out->includes;
+    // Only literal operands are followed, not those built by macros
+    const bool angled = first < last && tokens.kinds[first] == CTokenKind::TOKEN_HEADER_NAME;
+    const bool quoted = first < last && tokens.kinds[first] == CTokenKind::TOKEN_STRING &&
+                        source[tokens.offsets[first]] == '"';
+    if (!angled && !quoted) {
+        ++out->unresolved;
+        return;
+    }
+    const std::string_view name(reinterpret_cast<const char *>(source) + tokens.offsets[first] + 1,
+                                tokens.length(first) - 2);
+    const ca_io::ca_path_id target = includes.resolve(file, name, angled,
+                                                      kind == CDirectiveKind::DIRECTIVE_INCLUDE_NEXT);
+    if (target == ca_io::ca_path_table::INVALID_ID) {
+        ++out->unresolved;
+        return;
+    }
+
+    // A header whose guard is defined expands to nothing, so it is not read
+    const bool known = includes.guard(target).kind != CIncludeGuardKind::GUARD_UNKNOWN;
+    if (known && guarded(target)) {
+        includes.add_edge(file, target);
+        ++out->avoided_reads;
+        return;
+    }
+
+    header &entry = load(target);
+    if (!entry.readable) {
+        ++out->unresolved;
+        return;
+    }
+    includes.add_edge(file, target);
+    // The first load finds the guard, which is tested before the walk too
+    if (!known && guarded(target)) {
+        ++out->avoided_reads;
+        return;
+    }
+    if (depth + 1 > max_depth) {
+        ++out->errors;
+        out->cacheable = false;
+        return;
+    }
+
+    // A variant whose tested macros agree with the table is replayed
+    for (ca_size_t v = 0; v < entry.variants.size(); ++v) {
+        const CMacroRecording &recording = entry.variants[v].macros;
+        if (macro_table.signature(recording.tested) == recording.signature) {
+            macro_table.replay(recording);
+            ++totals.cache_hits;
+            ++current->cache_hits;
+            out->inclusions.push_back({ target, &entry, v });
+            gather(out->inclusions.back());
+            return;
+        }
+    }
+
+    if (entered.insert(target).second) {
+        current->headers.push_back(target);
+    }
+    ++totals.headers_walked;
+    macro_table.begin_recording();
+    summary contents;
+    walk(target, entry.text.data(), entry.text.size(), nullptr, depth + 1, &contents);
+    CMacroRecording recording = macro_table.end_recording();
+    collect(contents);
+
+    ca_size_t index = NO_VARIANT;
+    if (contents.cacheable && entry.variants.size() < MAX_VARIANTS) {
+        index = entry.variants.size();
+        entry.variants.push_back({ std::move(recording), std::move(contents) });
+    } else {
+        // The includer cannot be replayed without this inclusion
+        out->cacheable = false;
+    }
+    out->inclusions.push_back({ target, &entry, index });
+}
+
+CIncludeAnalyzer::header &
+CIncludeAnalyzer::load(const ca_io::ca_path_id file) {
+    std::unique_ptr<header> &slot = headers[file];
+    if (slot != nullptr) {
+        return *slot;
+    }
+    slot = std::make_unique<header>();
+    header &entry = *slot;
+    // Token offsets are 32-bit
+    if (ca_io::ca_file_read(includes.paths().view(file).data(), &entry.text, read_options) ==
+            ca_io::ca_file_result::FILE_OK &&
+        entry.text.size() <= CA_UINT32_MAX) {
+        entry.readable = true;
+        ++totals.files_read;
+        totals.bytes_read += entry.text.size();
+        includes.set_guard(file, find_guard(entry.text.data(), entry.text.size()));
+    }
+    return entry;
+}
+
+CIncludeGuard
+CIncludeAnalyzer::find_guard(const ca_string::ca_char_t *source, const ca_size_t size) {
+    CIncludeGuard guard;
+    guard.kind = CIncludeGuardKind::GUARD_NONE;
+    const CTokenStream &tokens = guard_tokens;
+
+    // `#ifndef X`, `#if !defined X` or `#if !defined(X)` first
+    ca_size_t next = 0;
+    lexer.lex_section(source, size, 0, &guard_tokens, &next);
+    const ca_size_t count = tokens.size() - 1;
+    if (count == 0 || !is_directive(tokens, 0)) {
+        return guard;
+    }
+    const CDirectiveKind opening = macro_table.directive_kind(tokens, 0);
+    ca_size_t name = NO_TOKEN;
+    if (opening == CDirectiveKind::DIRECTIVE_IFNDEF && count == 3) {
+        name = 2;
+    } else if (opening == CDirectiveKind::DIRECTIVE_IF && count >= 5 &&
+               tokens.kinds[2] == CTokenKind::PUNCT_EXCLAIM && tokens.ids[3] == defined_id) {
+        if (count == 5) {
+            name = 4;
+        } else if (count == 7 && tokens.kinds[4] == CTokenKind::PUNCT_L_PAREN &&
+                   tokens.kinds[6] == CTokenKind::PUNCT_R_PAREN) {
+            name = 5;
+        }
+    }
+    if (name == NO_TOKEN || tokens.kinds[name] != CTokenKind::TOKEN_IDENTIFIER) {
+        return guard;
+    }
+    const CTokenStream::id_type macro = tokens.ids[name];
+
+    // `#define X` on the next line
+    lexer.lex_section(source, size, next, &guard_tokens, &next);
+    if (tokens.size() < 4 || !is_directive(tokens, 0) ||
+        macro_table.directive_kind(tokens, 0) != CDirectiveKind::DIRECTIVE_DEFINE || tokens.ids[2] != macro) {
+        return guard;
+    }
+
+    // The matching `#endif` last, with no `#else` or `#elif` of its own
+    const ca_size_t close = lexer.skip_group(source, size, next);
+    if (close == size) {
+        return guard;
+    }
+    lexer.lex_section(source, size, close, &guard_tokens, &next);
+    if (macro_table.directive_kind(tokens, 0) == CDirectiveKind::DIRECTIVE_ENDIF && next == size) {
+        guard.kind = CIncludeGuardKind::GUARD_MACRO;
+        guard.macro = macro;
+    }
+    return guard;
+}
+
+bool
+CIncludeAnalyzer::guarded(const ca_io::ca_path_id file) {
+    const CIncludeGuard guard = includes.guard(file);
+    return (guard.kind == CIncludeGuardKind::GUARD_MACRO || guard.kind == CIncludeGuardKind::GUARD_PRAGMA_ONCE) &&
+           macro_table.defined(guard.macro);
+}
+
+void
+CIncludeAnalyzer::pragma_once(const ca_io::ca_path_id file) {
+    CIncludeGuard guard = includes.guard(file);
+    if (guard.kind == CIncludeGuardKind::GUARD_MACRO) {
+        // The guard macro already keeps the header from being read again
+        return;
+    }
+    if (guard.kind != CIncludeGuardKind::GUARD_PRAGMA_ONCE) {
+        // The marker cannot be spelled in C, so it never clashes with a macro
+        const std::string marker = "#once:" + std::to_string(file);
+        guard.kind = CIncludeGuardKind::GUARD_PRAGMA_ONCE;
+        guard.macro = intern(lexer.pool(), marker.c_str());
+        includes.set_guard(file, guard);
+    }
+    // The marker is only known once the walk gets here, so it is read
+    // before it is defined, making the includers' variants depend on it
+    (void)macro_table.defined(guard.macro);
+    macro_table.define_marker(guard.macro);
+}
+
+void
+CIncludeAnalyzer::gather(const inclusion &entry) {
+    if (entered.insert(entry.file).second) {
+        current->headers.push_back(entry.file);
+    }
+    const summary &contents = entry.target->variants[entry.variant].contents;
+    collect(contents);
+    for (const inclusion &nested : contents.inclusions) {
+        gather(nested);
+    }
+}
+
+void
+CIncludeAnalyzer::collect(const summary &contents) {
+    current->declarations.insert(current->declarations.end(), contents.declarations.begin(),
+                                 contents.declarations.end());
+    current->includes += contents.includes;
+    current->unresolved += contents.unresolved;
+    current->avoided_reads += contents.avoided_reads;
+    current->errors += contents.errors;
+    totals.includes += contents.includes;
+    totals.unresolved += contents.unresolved;
+    totals.avoided_reads += contents.avoided_reads;
+    totals.errors += contents.errors;
+}
+
+void
+CIncludeAnalyzer::clear() {
+    headers.clear();
+    includes.clear();
+}
+
+}
@@ -0,0 +1,122 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/c/core/include/CIncludeGraphBuilder.cpp
+//
+// @file
+// @brief Implements `CIncludeGraphBuilder`.
+// ================================
+
+#include "core/include/CIncludeGraphBuilder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace ca::analyzers::c {
+
+CIncludeGraphBuilder::CIncludeGraphBuilder(std::vector<std::string> search_paths, ca_io::ca_path_table *paths)
+    : directories(std::move(search_paths)), table(paths), edge_count(0), totals() {
+    assert(paths != nullptr);
+    // Normalized like the paths of the table, so `#include_next` can find
+    // the search path of its includer by prefix
+    for (std::string &directory : directories) {
+        ca_io::ca_io_path path(directory);
+        directory = path.normalize().view();
+    }
+}
+
+ca_io::ca_path_id
+CIncludeGraphBuilder::resolve(const ca_io::ca_path_id includer, const std::string_view name, const bool angled,
+                              const bool next) {
+    ++totals.resolutions;
+    const ca_io::ca_io_path includer_path(table->view(includer));
+    const std::string_view directory = includer_path.parent();
+
+    ca_size_t first = 0;
+    if (next) {
+        const std::string_view path = includer_path.view();
+        for (ca_size_t i = 0; i < directories.size(); ++i) {
+            const std::string &candidate = directories[i];
+            if (path.size() > candidate.size() && path.starts_with(candidate) &&
+                ca_io::ca_io_path::is_separator(path[candidate.size()])) {
+                first = i + 1;
+                break;
+            }
+        }
+    }
+
+    // Only quoted includes depend on the directory of their includer
+    key.clear();
+    if (!angled && !next) {
+        key += directory;
+    }
+    key += '\0';
+    key += angled ? '<' : '"';
+    if (next) {
+        key += std::to_string(first);
+    }
+    key += '\0';
+    key += name;
+    if (const auto it = resolved.find(key); it != resolved.end()) {
+        ++totals.cached;
+        return it->second;
+    }
+
+    ca_io::ca_path_id id = ca_io::ca_path_table::INVALID_ID;
+    if (!angled && !next) {
+        id = probe(directory, name);
+    }
+    for (ca_size_t i = first; i < directories.size() && id == ca_io::ca_path_table::INVALID_ID; ++i) {
+        id = probe(directories[i], name);
+    }
+    resolved.emplace(key, id);
+    return id;
+}
+
+ca_io::ca_path_id
+CIncludeGraphBuilder::probe(const std::string_view directory, const std::string_view name) {
+    ++totals.probes;
+    // An absolute operand replaces the directory
+    ca_io::ca_io_path path(directory);
+    path.append(name);
+    if (!path.exists()) {
+        return ca_io::ca_path_table::INVALID_ID;
+    }
+    return table->intern(path.view());
+}
+
+void
+CIncludeGraphBuilder::add_edge(const ca_io::ca_path_id from, const ca_io::ca_path_id to) {
+    std::vector<ca_io::ca_path_id> &targets = edges[from];
+    if (std::find(targets.begin(), targets.end(), to) == targets.end()) {
+        targets.push_back(to);
+        ++edge_count;
+    }
+}
+
+const std::vector<ca_io::ca_path_id> &
+CIncludeGraphBuilder::includes(const ca_io::ca_path_id file) const {
+    static const std::vector<ca_io::ca_path_id> none;
+    const auto it = edges.find(file);
+    return it != edges.end() ? it->second : none;
+}
+
+void
+CIncludeGraphBuilder::set_guard(const ca_io::ca_path_id file, const CIncludeGuard &guard) {
+    guards[file] = guard;
+}
+
+CIncludeGuard
+CIncludeGraphBuilder::guard(const ca_io::ca_path_id file) const {
+    const auto it = guards.find(file);
+    return it != guards.end() ? it->second : CIncludeGuard();
+}
+
+void
+CIncludeGraphBuilder::clear() {
+    resolved.clear();
+    edges.clear();
+    guards.clear();
+    edge_count = 0;
+}
+
+}
@@ -0,0 +1,896 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/c/core/macro/CMacroAnalyzer.cpp
+//
+// @file
+// @brief Implements `CMacroAnalyzer` and its condition evaluator.
+// ================================
+
+#include "core/macro/CMacroAnalyzer.h"
+
+#include "ca_hash.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace ca::analyzers::c {
+
+namespace {
+
+using ca_string::ca_char_t;
+
+/**
+ * @brief Maximum nesting of macro expansions in a condition.
+ */
+constexpr ca_size_t MAX_EXPANSION_DEPTH = 64;
+
+/**
+ * @brief Interns a C string.
+ */
+CTokenStream::id_type
+intern(ca_string::ca_intern_pool *pool, const char *text) {
+    return pool->intern(reinterpret_cast<const ca_char_t *>(text), std::strlen(text));
+}
+
+/**
+ * @brief Returns the value of a hexadecimal digit, or 16.
+ */
+unsigned
+digit_value(const ca_char_t c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    const ca_char_t lower = c | 0x20;
+    return lower >= 'a' && lower <= 'f' ? lower - 'a' + 10 : 16;
+}
+
+/**
+ * @brief Parses an integer constant, with its digit separators and suffix.
+ *
+ * @return Whether the token is an integer constant.
+ */
+bool
+parse_integer(const ca_char_t *text, const ca_size_t size, ca_int64_t *value) {
+    unsigned base = 10;
+    ca_size_t i = 0;
+    if (size >= 2 && text[0] == '0' && (text[1] | 0x20) == 'x') {
+        base = 16;
+        i = 2;
+    } else if (size >= 2 && text[0] == '0' && (text[1] | 0x20) == 'b') {
+        base = 2;
+        i = 2;
+    } else if (text[0] == '0') {
+        base = 8;
+    }
+
+    ca_uint64_t result = 0;
+    bool digits = false;
+    for (; i < size; ++i) {
+        if (text[i] == '\'') {
+            continue;
+        }
+        const unsigned digit = digit_value(text[i]);
+        if (digit >= 16 || (base != 16 && digit >= 10)) {
+            break;
+        }
+        if (digit >= base) {
+            return false;
+        }
+        result = result * base + digit;
+        digits = true;
+    }
+    // The suffixes `u`, `l`, `ll` and `wb`, in any case
+    for (; i < size; ++i) {
+        const ca_char_t c = text[i] | 0x20;
+        if (c != 'u' && c != 'l' && c != 'w' && c != 'b') {
+            return false;
+        }
+    }
+    *value = static_cast<ca_int64_t>(result);
+    return digits;
+}
+
+/**
+ * @brief Parses a character constant, taking the value of its first
+ *        character.
+ */
+ca_int64_t
+parse_character(const ca_char_t *text, const ca_size_t size) {
+    ca_size_t i = 0;
+    while (i < size && text[i] != '\'') {
+        ++i;
+    }
+    if (++i >= size) {
+        return 0;
+    }
+    if (text[i] != '\\') {
+        return text[i];
+    }
+    if (++i >= size) {
+        return 0;
+    }
+    switch (text[i]) {
+    case 'n': return '\n';
+    case 't': return '\t';
+    case 'r': return '\r';
+    case 'a': return '\a';
+    case 'b': return '\b';
+    case 'f': return '\f';
+    case 'v': return '\v';
+    case 'e': return 0x1B;
+    case 'x': {
+        ca_int64_t value = 0;
+        for (++i; i < size && digit_value(text[i]) < 16; ++i) {
+            value = value * 16 + digit_value(text[i]);
+        }
+        return value;
+    }
+    default:
+        if (text[i] >= '0' && text[i] <= '7') {
+            ca_int64_t value = 0;
+            for (ca_size_t n = 0; n < 3 && i < size && text[i] >= '0' && text[i] <= '7'; ++n, ++i) {
+                value = value * 8 + (text[i] - '0');
+            }
+            return value;
+        }
+        return text[i];
+    }
+}
+
+/**
+ * @brief Returns the precedence of a binary operator, 0 for other tokens.
+ */
+int
+precedence(const CTokenKind kind) {
+    switch (kind) {
+    case CTokenKind::PUNCT_PIPE_PIPE: return 1;
+    case CTokenKind::PUNCT_AMP_AMP: return 2;
+    case CTokenKind::PUNCT_PIPE: return 3;
+    case CTokenKind::PUNCT_CARET: return 4;
+    case CTokenKind::PUNCT_AMP: return 5;
+    case CTokenKind::PUNCT_EQUAL_EQUAL:
+    case CTokenKind::PUNCT_EXCLAIM_EQUAL: return 6;
+    case CTokenKind::PUNCT_LESS:
+    case CTokenKind::PUNCT_GREATER:
+    case CTokenKind::PUNCT_LESS_EQUAL:
+    case CTokenKind::PUNCT_GREATER_EQUAL: return 7;
+    case CTokenKind::PUNCT_LESS_LESS:
+    case CTokenKind::PUNCT_GREATER_GREATER: return 8;
+    case CTokenKind::PUNCT_PLUS:
+    case CTokenKind::PUNCT_MINUS: return 9;
+    case CTokenKind::PUNCT_STAR:
+    case CTokenKind::PUNCT_SLASH:
+    case CTokenKind::PUNCT_PERCENT: return 10;
+    default: return 0;
+    }
+}
+
+/**
+ * @struct condition_parser
+ * @brief Precedence-climbing evaluator of an expanded condition.
+ *
+ * Arithmetic wraps around instead of overflowing. Operands that are not
+ * evaluated, such as the right side of `0 && x`, may divide by zero.
+ */
+struct condition_parser {
+    const CMacroToken *tokens;      ///< The expanded tokens.
+    ca_size_t count;                ///< Number of tokens.
+    ca_size_t i = 0;                ///< Next token.
+    ca_size_t unevaluated = 0;      ///< Nesting of operands that are not evaluated.
+    bool failed = false;            ///< Whether the condition is malformed.
+
+    [[nodiscard]] CTokenKind
+    peek() const {
+        return i < count ? tokens[i].kind : CTokenKind::TOKEN_END;
+    }
+
+    bool
+    accept(const CTokenKind kind) {
+        if (peek() != kind) {
+            failed = true;
+            return false;
+        }
+        ++i;
+        return true;
+    }
+
+    ca_int64_t
+    conditional() {
+        const ca_int64_t condition = binary(1);
+        if (peek() != CTokenKind::PUNCT_QUESTION) {
+            return condition;
+        }
+        ++i;
+        unevaluated += condition == 0;
+        const ca_int64_t then = conditional();
+        unevaluated -= condition == 0;
+        accept(CTokenKind::PUNCT_COLON);
+        unevaluated += condition != 0;
+        const ca_int64_t otherwise = conditional();
+        unevaluated -= condition != 0;
+        return condition != 0 ? then : otherwise;
+    }
+
+    ca_int64_t
+    binary(const int min_precedence) {
+        ca_int64_t lhs = unary();
+        for (;;) {
+            const CTokenKind op = peek();
+            const int op_precedence = precedence(op);
+            if (op_precedence == 0 || op_precedence < min_precedence || failed) {
+                return lhs;
+            }
+            ++i;
+            const bool short_circuit = (op == CTokenKind::PUNCT_AMP_AMP && lhs == 0) ||
+                                       (op == CTokenKind::PUNCT_PIPE_PIPE && lhs != 0);
+            unevaluated += short_circuit;
+            const ca_int64_t rhs = binary(op_precedence + 1);
+            unevaluated -= short_circuit;
+            lhs = apply(op, lhs, rhs);
+        }
+    }
+
+    ca_int64_t
+    unary() {
+        switch (peek()) {
+        case CTokenKind::PUNCT_EXCLAIM:
+            ++i;
+            return unary() == 0;
+        case CTokenKind::PUNCT_TILDE:
+            ++i;
+            return ~unary();
+        case CTokenKind::PUNCT_MINUS:
+            ++i;
+            return static_cast<ca_int64_t>(0 - static_cast<ca_uint64_t>(unary()));
+        case CTokenKind::PUNCT_PLUS:
+            ++i;
+            return unary();
+        case CTokenKind::PUNCT_L_PAREN: {
+            ++i;
+            const ca_int64_t value = conditional();
+            accept(CTokenKind::PUNCT_R_PAREN);
+            return value;
+        }
+        case CTokenKind::TOKEN_NUMBER:
+        case CTokenKind::TOKEN_CHAR:
+            return tokens[i++].value;
+        default:
+            failed = true;
+            return 0;
+        }
+    }
+
+    ca_int64_t
+    apply(const CTokenKind op, const ca_int64_t lhs, const ca_int64_t rhs) {
+        const auto a = static_cast<ca_uint64_t>(lhs);
+        const auto b = static_cast<ca_uint64_t>(rhs);
+        switch (op) {
+        case CTokenKind::PUNCT_PIPE_PIPE: return lhs != 0 || rhs != 0;
+        case CTokenKind::PUNCT_AMP_AMP: return lhs != 0 && rhs != 0;
+        case CTokenKind::PUNCT_PIPE: return lhs | rhs;
+        case CTokenKind::PUNCT_CARET: return lhs ^ rhs;
+        case CTokenKind::PUNCT_AMP: return lhs & rhs;
+        case CTokenKind::PUNCT_EQUAL_EQUAL: return lhs == rhs;
+        case CTokenKind::PUNCT_EXCLAIM_EQUAL: return lhs != rhs;
+        case CTokenKind::PUNCT_LESS: return lhs < rhs;
+        case CTokenKind::PUNCT_GREATER: return lhs > rhs;
+        case CTokenKind::PUNCT_LESS_EQUAL: return lhs <= rhs;
+        case CTokenKind::PUNCT_GREATER_EQUAL: return lhs >= rhs;
+        case CTokenKind::PUNCT_LESS_LESS: return rhs < 0 || rhs >= 64 ? 0 : static_cast<ca_int64_t>(a << rhs);
+        case CTokenKind::PUNCT_GREATER_GREATER: return rhs < 0 || rhs >= 64 ? (lhs < 0 ? -1 : 0) : lhs >> rhs;
+        case CTokenKind::PUNCT_PLUS: return static_cast<ca_int64_t>(a + b);
+        case CTokenKind::PUNCT_MINUS: return static_cast<ca_int64_t>(a - b);
+        case CTokenKind::PUNCT_STAR: return static_cast<ca_int64_t>(a * b);
+        default:
+            // Division and remainder
+            if (rhs == 0 || (lhs == CA_INT64_MIN && rhs == -1)) {
+                failed |= unevaluated == 0;
+                return 0;
+            }
+            return op == CTokenKind::PUNCT_SLASH ? lhs / rhs : lhs % rhs;
+        }
+    }
+};
+
+/**
+ * @brief Feeds one value to a hash state.
+ */
+void
+hash_value(ca_string::ca_hash_state *state, const ca_uint64_t value) {
+    state->update(reinterpret_cast<const ca_char_t *>(&value), sizeof(value));
+}
+
+}
+
+CMacroAnalyzer::CMacroAnalyzer(ca_string::ca_intern_pool *pool) : totals() {
+    assert(pool != nullptr);
+    define_id = intern(pool, "define");
+    undef_id = intern(pool, "undef");
+    ifdef_id = intern(pool, "ifdef");
+    ifndef_id = intern(pool, "ifndef");
+    elif_id = intern(pool, "elif");
+    elifdef_id = intern(pool, "elifdef");
+    elifndef_id = intern(pool, "elifndef");
+    endif_id = intern(pool, "endif");
+    include_id = intern(pool, "include");
+    include_next_id = intern(pool, "include_next");
+    pragma_id = intern(pool, "pragma");
+    defined_id = intern(pool, "defined");
+    has_include_id = intern(pool, "__has_include");
+    has_include_next_id = intern(pool, "__has_include_next");
+    va_args_id = intern(pool, "__VA_ARGS__");
+}
+
+CDirectiveKind
+CMacroAnalyzer::directive_kind(const CTokenStream &tokens, const ca_size_t hash) const {
+    const ca_size_t name = hash + 1;
+    if (tokens.kinds[name] == CTokenKind::TOKEN_END || (tokens.flags[name] & C_TOKEN_LINE_START) != 0) {
+        return CDirectiveKind::DIRECTIVE_NONE;
+    }
+    switch (tokens.kinds[name]) {
+    case CTokenKind::KEYWORD_IF:
+        return CDirectiveKind::DIRECTIVE_IF;
+    case CTokenKind::KEYWORD_ELSE:
+        return CDirectiveKind::DIRECTIVE_ELSE;
+    case CTokenKind::TOKEN_IDENTIFIER:
+        break;
+    default:
+        return CDirectiveKind::DIRECTIVE_OTHER;
+    }
+
+    const CTokenStream::id_type id = tokens.ids[name];
+    if (id == include_id) {
+        return CDirectiveKind::DIRECTIVE_INCLUDE;
+    }
+    if (id == define_id) {
+        return CDirectiveKind::DIRECTIVE_DEFINE;
+    }
+    if (id == ifdef_id) {
+        return CDirectiveKind::DIRECTIVE_IFDEF;
+    }
+    if (id == ifndef_id) {
+        return CDirectiveKind::DIRECTIVE_IFNDEF;
+    }
+    if (id == endif_id) {
+        return CDirectiveKind::DIRECTIVE_ENDIF;
+    }
+    if (id == undef_id) {
+        return CDirectiveKind::DIRECTIVE_UNDEF;
+    }
+    if (id == elif_id) {
+        return CDirectiveKind::DIRECTIVE_ELIF;
+    }
+    if (id == pragma_id) {
+        return CDirectiveKind::DIRECTIVE_PRAGMA;
+    }
+    if (id == include_next_id) {
+        return CDirectiveKind::DIRECTIVE_INCLUDE_NEXT;
+    }
+    if (id == elifdef_id) {
+        return CDirectiveKind::DIRECTIVE_ELIFDEF;
+    }
+    if (id == elifndef_id) {
+        return CDirectiveKind::DIRECTIVE_ELIFNDEF;
+    }
+    return CDirectiveKind::DIRECTIVE_OTHER;
+}
+
+int
+CMacroAnalyzer::directive(const CDirectiveKind kind, const ca_char_t *source, const CTokenStream &tokens,
+                          const ca_size_t first, const ca_size_t last) {
+    ++totals.directives;
+    int status = 0;
+    bool value = false;
+
+    switch (kind) {
+    case CDirectiveKind::DIRECTIVE_DEFINE:
+    case CDirectiveKind::DIRECTIVE_UNDEF:
+        if (!active()) {
+            return 0;
+        }
+        ++totals.definitions;
+        if (kind == CDirectiveKind::DIRECTIVE_DEFINE) {
+            status = define(source, tokens, first, last);
+        } else if (first < last && tokens.ids[first] != ca_string::ca_intern_pool::INVALID_ID) {
+            write(tokens.ids[first], nullptr);
+        } else {
+            status = -1;
+        }
+        break;
+
+    case CDirectiveKind::DIRECTIVE_IF:
+    case CDirectiveKind::DIRECTIVE_IFDEF:
+    case CDirectiveKind::DIRECTIVE_IFNDEF:
+        if (!active()) {
+            // Only tracked to find the matching `#endif`
+            conditionals.push_back({ false, true, false });
+            return 0;
+        }
+        status = kind == CDirectiveKind::DIRECTIVE_IF ? evaluate(source, tokens, first, last, &value)
+                                                      : is_defined(tokens, first, last, &value);
+        value = status == 0 && value != (kind == CDirectiveKind::DIRECTIVE_IFNDEF);
+        conditionals.push_back({ value, value, false });
+        break;
+
+    case CDirectiveKind::DIRECTIVE_ELIF:
+    case CDirectiveKind::DIRECTIVE_ELIFDEF:
+    case CDirectiveKind::DIRECTIVE_ELIFNDEF: {
+        if (conditionals.empty()) {
+            status = -1;
+            break;
+        }
+        if (conditionals.back().seen_else) {
+            status = -1;
+        }
+        if (conditionals.back().taken) {
+            conditionals.back().active = false;
+            break;
+        }
+        const int evaluated = kind == CDirectiveKind::DIRECTIVE_ELIF ? evaluate(source, tokens, first, last, &value)
+                                                                     : is_defined(tokens, first, last, &value);
+        value = evaluated == 0 && value != (kind == CDirectiveKind::DIRECTIVE_ELIFNDEF);
+        conditionals.back().active = value;
+        conditionals.back().taken = value;
+        status |= evaluated;
+        break;
+    }
+
+    case CDirectiveKind::DIRECTIVE_ELSE:
+        if (conditionals.empty() || conditionals.back().seen_else) {
+            status = -1;
+            if (conditionals.empty()) {
+                break;
+            }
+        }
+        conditionals.back().active = !conditionals.back().taken;
+        conditionals.back().taken = true;
+        conditionals.back().seen_else = true;
+        break;
+
+    case CDirectiveKind::DIRECTIVE_ENDIF:
+        if (conditionals.empty()) {
+            status = -1;
+            break;
+        }
+        conditionals.pop_back();
+        break;
+
+    default:
+        break;
+    }
+
+    if (status != 0) {
+        ++totals.errors;
+    }
+    return status;
+}
+
+int
+CMacroAnalyzer::define(const ca_char_t *source, const CTokenStream &tokens, const ca_size_t first,
+                       const ca_size_t last) {
+    if (first >= last || tokens.ids[first] == ca_string::ca_intern_pool::INVALID_ID) {
+        return -1;
+    }
+    auto macro = std::make_shared<CMacro>();
+    ca_size_t i = first + 1;
+    macro->function_like = i < last && tokens.kinds[i] == CTokenKind::PUNCT_L_PAREN &&
+                           (tokens.flags[i] & C_TOKEN_SPACE_BEFORE) == 0;
+    if (macro->function_like) {
+        // Names separated by commas, the last of which may be `...` or, as
+        // a GNU extension, a name followed by `...`
+        ++i;
+        while (i < last && tokens.kinds[i] != CTokenKind::PUNCT_R_PAREN) {
+            if (tokens.kinds[i] == CTokenKind::PUNCT_ELLIPSIS) {
+                macro->parameters.push_back(va_args_id);
+                macro->variadic = true;
+            } else if (tokens.ids[i] != ca_string::ca_intern_pool::INVALID_ID) {
+                macro->parameters.push_back(tokens.ids[i]);
+                if (i + 1 < last && tokens.kinds[i + 1] == CTokenKind::PUNCT_ELLIPSIS) {
+                    macro->variadic = true;
+                    ++i;
+                }
+            } else {
+                return -1;
+            }
+            ++i;
+            if (macro->variadic || i == last || tokens.kinds[i] != CTokenKind::PUNCT_COMMA) {
+                break;
+            }
+            ++i;
+        }
+        if (i == last || tokens.kinds[i] != CTokenKind::PUNCT_R_PAREN) {
+            return -1;
+        }
+        ++i;
+    }
+
+    // The hash covers the parameters and body, token by token, so that a
+    // redefinition differing only in whitespace hashes the same
+    ca_string::ca_hash_state state;
+    hash_value(&state, macro->function_like);
+    for (ca_size_t j = first + 1; j < last; ++j) {
+        state.update(source + tokens.offsets[j], tokens.length(j));
+        state.update(reinterpret_cast<const ca_char_t *>(" "), 1);
+    }
+    macro->hash = std::max<ca_uint64_t>(state.digest64(), 1);
+
+    macro->body.reserve(last - i);
+    for (; i < last; ++i) {
+        CMacroToken token{ tokens.kinds[i], tokens.ids[i], 0 };
+        if (token.kind == CTokenKind::TOKEN_NUMBER) {
+            parse_integer(source + tokens.offsets[i], tokens.length(i), &token.value);
+        } else if (token.kind == CTokenKind::TOKEN_CHAR) {
+            token.value = parse_character(source + tokens.offsets[i], tokens.length(i));
+        }
+        macro->body.push_back(token);
+    }
+    write(tokens.ids[first], std::move(macro));
+    return 0;
+}
+
+int
+CMacroAnalyzer::evaluate(const ca_char_t *source, const CTokenStream &tokens, const ca_size_t first,
+                         const ca_size_t last, bool *value) {
+    constexpr CTokenStream::id_type NO_ID = ca_string::ca_intern_pool::INVALID_ID;
+    ++totals.evaluations;
+    line.clear();
+    for (ca_size_t i = first; i < last; ++i) {
+        CMacroToken token{ tokens.kinds[i], tokens.ids[i], 0 };
+        if ((token.id == has_include_id || token.id == has_include_next_id) && i + 1 < last &&
+            tokens.kinds[i + 1] == CTokenKind::PUNCT_L_PAREN) {
+            bool found = false;
+            if (has_include(source, tokens, last, token.id == has_include_next_id, &i, &found) != 0) {
+                return -1;
+            }
+            line.push_back({ CTokenKind::TOKEN_NUMBER, NO_ID, found });
+            continue;
+        }
+        if (token.kind == CTokenKind::TOKEN_NUMBER &&
+            !parse_integer(source + tokens.offsets[i], tokens.length(i), &token.value)) {
+            return -1;
+        }
+        if (token.kind == CTokenKind::TOKEN_CHAR) {
+            token.value = parse_character(source + tokens.offsets[i], tokens.length(i));
+        }
+        line.push_back(token);
+    }
+
+    expanded.clear();
+    expanding.clear();
+    if (expand(line.data(), line.size(), 0, &expanded) != 0 || expanded.empty()) {
+        return -1;
+    }
+    // Function-like macro names left without arguments are identifiers
+    for (CMacroToken &token : expanded) {
+        if (token.id != NO_ID) {
+            token = { CTokenKind::TOKEN_NUMBER, NO_ID, 0 };
+        }
+    }
+    condition_parser parser{ expanded.data(), expanded.size() };
+    const ca_int64_t result = parser.conditional();
+    if (parser.failed || parser.i != parser.count) {
+        return -1;
+    }
+    *value = result != 0;
+    return 0;
+}
+
+int
+CMacroAnalyzer::has_include(const ca_char_t *source, const CTokenStream &tokens, const ca_size_t last,
+                            const bool next, ca_size_t *i, bool *found) {
+    if (!include_probe) {
+        return -1;
+    }
+    ca_size_t j = *i + 2;
+    ca_size_t begin;
+    ca_size_t end;
+    bool angled;
+    if (j < last && tokens.kinds[j] == CTokenKind::TOKEN_STRING && source[tokens.offsets[j]] == '"') {
+        begin = tokens.offsets[j] + 1;
+        end = tokens.offsets[j] + tokens.length(j) - 1;
+        angled = false;
+    } else if (j < last && tokens.kinds[j] == CTokenKind::PUNCT_LESS) {
+        // `<...>` is only lexed as one token after `#include`, so the name
+        // is spelled by the source up to the first `>`
+        begin = tokens.offsets[j] + 1;
+        while (++j < last && tokens.kinds[j] != CTokenKind::PUNCT_GREATER) {
+        }
+        if (j == last) {
+            return -1;
+        }
+        end = tokens.offsets[j];
+        angled = true;
+    } else {
+        // Operands built by macros are not supported
+        return -1;
+    }
+    if (++j >= last || tokens.kinds[j] != CTokenKind::PUNCT_R_PAREN) {
+        return -1;
+    }
+    *found = include_probe(std::string_view(reinterpret_cast<const char *>(source) + begin, end - begin), angled,
+                           next);
+    *i = j;
+    return 0;
+}
+
+int
+CMacroAnalyzer::expand(const CMacroToken *tokens, const ca_size_t count, const ca_size_t depth,
+                       std::vector<CMacroToken> *out) {
+    constexpr CTokenStream::id_type NO_ID = ca_string::ca_intern_pool::INVALID_ID;
+    for (ca_size_t i = 0; i < count; ++i) {
+        const CMacroToken &token = tokens[i];
+        if (token.id == defined_id) {
+            ca_size_t j = i + 1;
+            const bool parenthesized = j < count && tokens[j].kind == CTokenKind::PUNCT_L_PAREN;
+            j += parenthesized;
+            if (j >= count || tokens[j].id == NO_ID) {
+                return -1;
+            }
+            const bool defined = is_defined_name(tokens[j].id);
+            ++j;
+            if (parenthesized) {
+                if (j >= count || tokens[j].kind != CTokenKind::PUNCT_R_PAREN) {
+                    return -1;
+                }
+                ++j;
+            }
+            out->push_back({ CTokenKind::TOKEN_NUMBER, NO_ID, defined });
+            i = j - 1;
+            continue;
+        }
+        if (token.kind == CTokenKind::KEYWORD_TRUE || token.kind == CTokenKind::KEYWORD_FALSE) {
+            out->push_back({ CTokenKind::TOKEN_NUMBER, NO_ID, token.kind == CTokenKind::KEYWORD_TRUE });
+            continue;
+        }
+        if (token.id == NO_ID) {
+            out->push_back(token);
+            continue;
+        }
+
+        const CMacro *macro = read(token.id);
+        const bool call = i + 1 < count && tokens[i + 1].kind == CTokenKind::PUNCT_L_PAREN;
+        if (macro != nullptr && std::find(expanding.begin(), expanding.end(), token.id) == expanding.end()) {
+            if (macro->function_like && !call) {
+                out->push_back(token);
+                continue;
+            }
+            if (depth >= MAX_EXPANSION_DEPTH) {
+                return -1;
+            }
+            int status;
+            if (macro->function_like) {
+                ++i;
+                status = expand_call(*macro, token.id, tokens, count, depth, &i, out);
+            } else {
+                expanding.push_back(token.id);
+                status = expand(macro->body.data(), macro->body.size(), depth + 1, out);
+                expanding.pop_back();
+            }
+            if (status != 0) {
+                return -1;
+            }
+            continue;
+        }
+        if (call) {
+            // A builtin such as `__has_attribute`, or a macro that is not
+            // defined or is being expanded, has no value to call for
+            return -1;
+        }
+        out->push_back({ CTokenKind::TOKEN_NUMBER, NO_ID, 0 });
+    }
+    return 0;
+}
+
+int
+CMacroAnalyzer::expand_call(const CMacro &macro, const CTokenStream::id_type name, const CMacroToken *tokens,
+                            const ca_size_t count, const ca_size_t depth, ca_size_t *i,
+                            std::vector<CMacroToken> *out) {
+    constexpr CTokenStream::id_type NO_ID = ca_string::ca_intern_pool::INVALID_ID;
+    // The arguments are split at the commas outside parentheses, except
+    // that the variable arguments are one
+    std::vector<std::pair<ca_size_t, ca_size_t>> arguments;
+    const ca_size_t named = macro.parameters.size() - macro.variadic;
+    ca_size_t begin = *i + 1;
+    ca_size_t nesting = 0;
+    ca_size_t j = begin;
+    for (; j < count; ++j) {
+        if (tokens[j].kind == CTokenKind::PUNCT_L_PAREN) {
+            ++nesting;
+        } else if (tokens[j].kind == CTokenKind::PUNCT_R_PAREN) {
+            if (nesting == 0) {
+                break;
+            }
+            --nesting;
+        } else if (tokens[j].kind == CTokenKind::PUNCT_COMMA && nesting == 0 &&
+                   (!macro.variadic || arguments.size() < named)) {
+            arguments.emplace_back(begin, j);
+            begin = j + 1;
+        }
+    }
+    if (j == count) {
+        // The call goes on past the sequence, such as past a macro body
+        return -1;
+    }
+    arguments.emplace_back(begin, j);
+    if (macro.parameters.empty() && begin == j) {
+        arguments.clear();
+    } else if (macro.variadic && arguments.size() == named) {
+        arguments.emplace_back(j, j);
+    }
+    if (arguments.size() != macro.parameters.size()) {
+        return -1;
+    }
+
+    // Arguments are expanded before they are substituted, and the result
+    // is scanned again with the macro itself no longer expanded
+    std::vector<std::vector<CMacroToken>> values(arguments.size());
+    for (ca_size_t k = 0; k < arguments.size(); ++k) {
+        const auto [from, to] = arguments[k];
+        if (expand(tokens + from, to - from, depth + 1, &values[k]) != 0) {
+            return -1;
+        }
+    }
+    std::vector<CMacroToken> replaced;
+    for (const CMacroToken &token : macro.body) {
+        if (token.kind == CTokenKind::PUNCT_HASH || token.kind == CTokenKind::PUNCT_HASH_HASH) {
+            // Stringized and pasted tokens make no integer constant
+            return -1;
+        }
+        const auto parameter = std::find(macro.parameters.begin(), macro.parameters.end(), token.id);
+        if (token.id != NO_ID && parameter != macro.parameters.end()) {
+            const std::vector<CMacroToken> &value = values[parameter - macro.parameters.begin()];
+            replaced.insert(replaced.end(), value.begin(), value.end());
+        } else {
+            replaced.push_back(token);
+        }
+    }
+    expanding.push_back(name);
+    const int status = expand(replaced.data(), replaced.size(), depth + 1, out);
+    expanding.pop_back();
+    *i = j;
+    return status;
+}
+
+int
+CMacroAnalyzer::is_defined(const CTokenStream &tokens, const ca_size_t first, const ca_size_t last, bool *value) {
+    if (first >= last || tokens.ids[first] == ca_string::ca_intern_pool::INVALID_ID) {
+        return -1;
+    }
+    *value = is_defined_name(tokens.ids[first]);
+    return 0;
+}
+
+bool
+CMacroAnalyzer::is_defined_name(const CTokenStream::id_type name) {
+    // The builtins are not macros, so testing them is not recorded
+    if (name == has_include_id || name == has_include_next_id) {
+        return static_cast<bool>(include_probe);
+    }
+    return read(name) != nullptr;
+}
+
+void
+CMacroAnalyzer::truncate(const ca_size_t depth) {
+    if (conditionals.size() > depth) {
+        conditionals.resize(depth);
+    }
+}
+
+const CMacro *
+CMacroAnalyzer::find(const CTokenStream::id_type name) const {
+    const auto it = table.find(name);
+    return it != table.end() ? it->second.get() : nullptr;
+}
+
+ca_uint64_t
+CMacroAnalyzer::hash(const CTokenStream::id_type name) const {
+    const CMacro *macro = find(name);
+    return macro != nullptr ? macro->hash : 0;
+}
+
+bool
+CMacroAnalyzer::defined(const CTokenStream::id_type name) {
+    return read(name) != nullptr;
+}
+
+void
+CMacroAnalyzer::define_marker(const CTokenStream::id_type name) {
+    // Markers are never expanded, so they all share one definition
+    static const CMacroPtr marker = std::make_shared<const CMacro>(CMacro{ 1, false, false, {}, {} });
+    write(name, marker);
+}
+
+const CMacro *
+CMacroAnalyzer::read(const CTokenStream::id_type name) {
+    const CMacro *macro = find(name);
+    // A recording opened later than another sees a subset of its lookups,
+    // so the walk stops at the first one that already saw the macro
+    for (auto it = recordings.rbegin(); it != recordings.rend(); ++it) {
+        if (!it->seen.try_emplace(name, false).second) {
+            break;
+        }
+        it->tested.emplace_back(name, macro != nullptr ? macro->hash : 0);
+    }
+    return macro;
+}
+
+void
+CMacroAnalyzer::write(const CTokenStream::id_type name, CMacroPtr macro) {
+    for (auto it = recordings.rbegin(); it != recordings.rend(); ++it) {
+        const auto [entry, inserted] = it->seen.try_emplace(name, true);
+        if (!inserted) {
+            if (entry->second) {
+                break;
+            }
+            entry->second = true;
+        }
+    }
+    if (macro != nullptr) {
+        table[name] = std::move(macro);
+    } else {
+        table.erase(name);
+    }
+}
+
+ca_uint64_t
+CMacroAnalyzer::signature(const std::vector<CTokenStream::id_type> &names) const {
+    ca_string::ca_hash_state state;
+    for (const CTokenStream::id_type name : names) {
+        hash_value(&state, name);
+        hash_value(&state, hash(name));
+    }
+    return state.digest64();
+}
+
+void
+CMacroAnalyzer::begin_recording() {
+    recordings.emplace_back();
+}
+
+CMacroRecording
+CMacroAnalyzer::end_recording() {
+    assert(!recordings.empty());
+    recording closed = std::move(recordings.back());
+    recordings.pop_back();
+
+    CMacroRecording result;
+    std::sort(closed.tested.begin(), closed.tested.end());
+    ca_string::ca_hash_state state;
+    result.tested.reserve(closed.tested.size());
+    for (const auto &[name, macro_hash] : closed.tested) {
+        result.tested.push_back(name);
+        hash_value(&state, name);
+        hash_value(&state, macro_hash);
+    }
+    result.signature = state.digest64();
+
+    for (const auto &[name, written] : closed.seen) {
+        if (written) {
+            const auto it = table.find(name);
+            result.effects.emplace_back(name, it != table.end() ? it->second : nullptr);
+        }
+    }
+    std::sort(result.effects.begin(), result.effects.end(), [](const auto &a, const auto &b) {
+        return a.first < b.first;
+    });
+    return result;
+}
+
+void
+CMacroAnalyzer::replay(const CMacroRecording &recording) {
+    for (const CTokenStream::id_type name : recording.tested) {
+        read(name);
+    }
+    for (const auto &[name, macro] : recording.effects) {
+        write(name, macro);
+    }
+}
+
+void
+CMacroAnalyzer::reset() {
+    table.clear();
+    conditionals.clear();
+    recordings.clear();
+}
+
+}
@@ -0,0 +1,1470 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/c/core/parser/CASTBuilder.cpp
+//
+// @file
+// @brief Implements `CASTBuilder` and its recursive-descent parser.
+// ================================
+
+#include "core/parser/CASTBuilder.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace ca::analyzers::c {
+
+namespace {
+
+/**
+ * @brief Typedef names of the C and POSIX headers, taken as types even
+ *        though the headers declaring them are not read.
+ */
+constexpr const char *BUILTIN_TYPE_NAMES[] = {
+    "__int128", "__builtin_va_list", "_Float16", "_Float32", "_Float64", "_Float128", "__fp16",
+    "size_t", "ssize_t", "ptrdiff_t", "intptr_t", "uintptr_t", "intmax_t", "uintmax_t", "wchar_t",
+    "int8_t", "int16_t", "int32_t", "int64_t", "uint8_t", "uint16_t", "uint32_t", "uint64_t",
+    "va_list", "FILE", "off_t", "pid_t", "time_t", "clock_t", "mode_t", "socklen_t",
+};
+
+/**
+ * @brief Extension keywords that qualify a declaration or expression and
+ *        are skipped.
+ */
+constexpr const char *QUALIFIER_NAMES[] = {
+    "__extension__", "__inline", "__inline__", "__restrict", "__restrict__", "__const", "__volatile",
+    "__volatile__", "__signed", "__signed__", "__cdecl", "__stdcall", "__fastcall", "__forceinline",
+    "_Nullable", "_Nonnull", "__thread",
+};
+
+/**
+ * @brief Extension keywords that are skipped with their parenthesized operand.
+ */
+constexpr const char *ATTRIBUTE_NAMES[] = {
+    "__attribute__", "__attribute", "__declspec", "__asm__", "__asm", "asm", "__typeof__", "__typeof",
+    "__alignas", "__alignof__",
+};
+
+/**
+ * @brief Returns the precedence of a binary operator, or 0.
+ */
+int
+binary_precedence(const CTokenKind kind) {
+    switch (kind) {
+    case CTokenKind::PUNCT_PIPE_PIPE: return 1;
+    case CTokenKind::PUNCT_AMP_AMP: return 2;
+    case CTokenKind::PUNCT_PIPE: return 3;
+    case CTokenKind::PUNCT_CARET: return 4;
+    case CTokenKind::PUNCT_AMP: return 5;
+    case CTokenKind::PUNCT_EQUAL_EQUAL:
+    case CTokenKind::PUNCT_EXCLAIM_EQUAL: return 6;
+    case CTokenKind::PUNCT_LESS:
+    case CTokenKind::PUNCT_GREATER:
+    case CTokenKind::PUNCT_LESS_EQUAL:
+    case CTokenKind::PUNCT_GREATER_EQUAL: return 7;
+    case CTokenKind::PUNCT_LESS_LESS:
+    case CTokenKind::PUNCT_GREATER_GREATER: return 8;
+    case CTokenKind::PUNCT_PLUS:
+    case CTokenKind::PUNCT_MINUS: return 9;
+    case CTokenKind::PUNCT_STAR:
+    case CTokenKind::PUNCT_SLASH:
+    case CTokenKind::PUNCT_PERCENT: return 10;
+    default: return 0;
+    }
+}
+
+/**
+ * @brief Checks if a token is an assignment operator.
+ */
+bool
+is_assignment(const CTokenKind kind) {
+    switch (kind) {
+    case CTokenKind::PUNCT_EQUAL:
+    case CTokenKind::PUNCT_STAR_EQUAL:
+    case CTokenKind::PUNCT_SLASH_EQUAL:
+    case CTokenKind::PUNCT_PERCENT_EQUAL:
+    case CTokenKind::PUNCT_PLUS_EQUAL:
+    case CTokenKind::PUNCT_MINUS_EQUAL:
+    case CTokenKind::PUNCT_LESS_LESS_EQUAL:
+    case CTokenKind::PUNCT_GREATER_GREATER_EQUAL:
+    case CTokenKind::PUNCT_AMP_EQUAL:
+    case CTokenKind::PUNCT_CARET_EQUAL:
+    case CTokenKind::PUNCT_PIPE_EQUAL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Checks if a keyword is a declaration specifier.
+ *
+ * @param type_specifier [out] Whether it names (part of) a type, rather
+ *                       than being a storage class or qualifier.
+ */
+bool
+is_specifier_keyword(const CTokenKind kind, bool *type_specifier) {
+    switch (kind) {
+    case CTokenKind::KEYWORD_CHAR:
+    case CTokenKind::KEYWORD_DOUBLE:
+    case CTokenKind::KEYWORD_FLOAT:
+    case CTokenKind::KEYWORD_INT:
+    case CTokenKind::KEYWORD_LONG:
+    case CTokenKind::KEYWORD_SHORT:
+    case CTokenKind::KEYWORD_SIGNED:
+    case CTokenKind::KEYWORD_UNSIGNED:
+    case CTokenKind::KEYWORD_VOID:
+    case CTokenKind::KEYWORD_BOOL:
+    case CTokenKind::KEYWORD__BOOL:
+    case CTokenKind::KEYWORD__COMPLEX:
+    case CTokenKind::KEYWORD__IMAGINARY:
+    case CTokenKind::KEYWORD__DECIMAL128:
+    case CTokenKind::KEYWORD__DECIMAL32:
+    case CTokenKind::KEYWORD__DECIMAL64:
+    case CTokenKind::KEYWORD_STRUCT:
+    case CTokenKind::KEYWORD_UNION:
+    case CTokenKind::KEYWORD_ENUM:
+    case CTokenKind::KEYWORD_TYPEOF:
+    case CTokenKind::KEYWORD_TYPEOF_UNQUAL:
+    case CTokenKind::KEYWORD__BITINT:
+        *type_specifier = true;
+        return true;
+    case CTokenKind::KEYWORD_AUTO:
+    case CTokenKind::KEYWORD_CONST:
+    case CTokenKind::KEYWORD_EXTERN:
+    case CTokenKind::KEYWORD_INLINE:
+    case CTokenKind::KEYWORD_REGISTER:
+    case CTokenKind::KEYWORD_RESTRICT:
+    case CTokenKind::KEYWORD_STATIC:
+    case CTokenKind::KEYWORD_TYPEDEF:
+    case CTokenKind::KEYWORD_VOLATILE:
+    case CTokenKind::KEYWORD_ALIGNAS:
+    case CTokenKind::KEYWORD_CONSTEXPR:
+    case CTokenKind::KEYWORD_THREAD_LOCAL:
+    case CTokenKind::KEYWORD__ALIGNAS:
+    case CTokenKind::KEYWORD__ATOMIC:
+    case CTokenKind::KEYWORD__NORETURN:
+    case CTokenKind::KEYWORD__THREAD_LOCAL:
+        *type_specifier = false;
+        return true;
+    default:
+        return false;
+    }
+}
+
+}
+
+/**
+ * @struct CParser
+ * @brief Parsing state of one unit.
+ *
+ * Completed nodes are staged in post-order and pushed on `pending`. A node
+ * under construction remembers the size of `pending` when it started (its
+ * mark); when it is completed, everything pushed since is its children,
+ * whose subtrees are the staged nodes just before it.
+ */
+struct CParser {
+    typedef CAst::index_type index_type;
+    typedef CTokenStream::id_type id_type;
+
+    CASTBuilder &builder;
+    const CTokenStream &tokens;
+    std::vector<index_type> &pending;
+    ca_size_t pos;          ///< Current token.
+    ca_size_t last;         ///< Last consumed token.
+    ca_size_t depth;        ///< Nesting of the construct being parsed.
+    ca_uint64_t errors;     ///< Syntax errors so far.
+
+    CParser(CASTBuilder &owner, const CTokenStream &stream)
+        : builder(owner), tokens(stream), pending(owner.pending), pos(0), last(0), depth(0), errors(0) {
+        pos = skip_directives(0);
+    }
+
+    /**
+     * @struct nesting
+     * @brief Enters a nested construct for the scope of a parse function.
+     *
+     * Past `MAX_NESTING` levels the construct is skipped instead, see
+     * `skip_nested`.
+     */
+    struct nesting {
+        CParser &parser;
+        bool entered;   ///< Whether the construct is to be parsed.
+
+        nesting(CParser &owner, const bool statement)
+            : parser(owner), entered(owner.depth < CASTBuilder::MAX_NESTING) {
+            if (entered) {
+                ++parser.depth;
+            } else {
+                parser.skip_nested(statement);
+            }
+        }
+
+        ~nesting() {
+            if (entered) {
+                --parser.depth;
+            }
+        }
+
+        nesting(const nesting &) = delete;
+        nesting &operator=(const nesting &) = delete;
+    };
+
+    // ---------------- Tokens ----------------
+
+    /**
+     * @brief Skips the preprocessing directive lines starting at `i`.
+     */
+    [[nodiscard]] ca_size_t
+    skip_directives(ca_size_t i) const {
+        while (tokens.kinds[i] == CTokenKind::PUNCT_HASH && (tokens.flags[i] & C_TOKEN_LINE_START) != 0) {
+            ++i;
+            while (tokens.kinds[i] != CTokenKind::TOKEN_END && (tokens.flags[i] & C_TOKEN_LINE_START) == 0) {
+                ++i;
+            }
+        }
+        return i;
+    }
+
+    [[nodiscard]] ca_size_t
+    next(const ca_size_t i) const {
+        return tokens.kinds[i] == CTokenKind::TOKEN_END ? i : skip_directives(i + 1);
+    }
+
+    [[nodiscard]] CTokenKind
+    kind() const {
+        return tokens.kinds[pos];
+    }
+
+    [[nodiscard]] CTokenKind
+    peek(const int k = 1) const {
+        ca_size_t i = pos;
+        for (int n = 0; n < k; ++n) {
+            i = next(i);
+        }
+        return tokens.kinds[i];
+    }
+
+    [[nodiscard]] bool
+    at(const CTokenKind k) const {
+        return tokens.kinds[pos] == k;
+    }
+
+    [[nodiscard]] bool
+    at_line_start() const {
+        return (tokens.flags[pos] & C_TOKEN_LINE_START) != 0;
+    }
+
+    [[nodiscard]] bool
+    in(const std::unordered_set<id_type> &set, const ca_size_t i) const {
+        return tokens.kinds[i] == CTokenKind::TOKEN_IDENTIFIER && set.contains(tokens.ids[i]);
+    }
+
+    void
+    advance() {
+        last = pos;
+        pos = next(pos);
+    }
+
+    bool
+    accept(const CTokenKind k) {
+        if (at(k)) {
+            advance();
+            return true;
+        }
+        return false;
+    }
+
+    bool
+    expect(const CTokenKind k) {
+        if (accept(k)) {
+            return true;
+        }
+        ++errors;
+        return false;
+    }
+
+    /**
+     * @brief Skips a balanced `(...)`, `[...]` or `{...}` group at `pos`.
+     */
+    void
+    skip_balanced() {
+        int depth = 0;
+        do {
+            switch (kind()) {
+            case CTokenKind::PUNCT_L_PAREN:
+            case CTokenKind::PUNCT_L_SQUARE:
+            case CTokenKind::PUNCT_L_BRACE:
+                ++depth;
+                break;
+            case CTokenKind::PUNCT_R_PAREN:
+            case CTokenKind::PUNCT_R_SQUARE:
+            case CTokenKind::PUNCT_R_BRACE:
+                --depth;
+                break;
+            case CTokenKind::TOKEN_END:
+                return;
+            default:
+                break;
+            }
+            advance();
+        } while (depth > 0);
+    }
+
+    /**
+     * @brief Skips to the end of the current statement or declaration: past
+     *        the next `;`, or to the `}` closing the enclosing block.
+     */
+    void
+    sync() {
+        int depth = 0;
+        while (!at(CTokenKind::TOKEN_END)) {
+            const CTokenKind k = kind();
+            if (depth == 0 && k == CTokenKind::PUNCT_R_BRACE) {
+                return;
+            }
+            advance();
+            if (k == CTokenKind::PUNCT_L_PAREN || k == CTokenKind::PUNCT_L_SQUARE || k == CTokenKind::PUNCT_L_BRACE) {
+                ++depth;
+            } else if ((k == CTokenKind::PUNCT_R_PAREN || k == CTokenKind::PUNCT_R_SQUARE ||
+                        k == CTokenKind::PUNCT_R_BRACE) && depth > 0) {
+                --depth;
+            } else if (depth == 0 && k == CTokenKind::PUNCT_SEMI) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Expects the `)` closing a group, skipping what precedes it.
+     */
+    void
+    close_paren() {
+        if (accept(CTokenKind::PUNCT_R_PAREN)) {
+            return;
+        }
+        ++errors;
+        int depth = 0;
+        while (!at(CTokenKind::TOKEN_END)) {
+            const CTokenKind k = kind();
+            if (depth == 0 && (k == CTokenKind::PUNCT_SEMI || k == CTokenKind::PUNCT_L_BRACE ||
+                               k == CTokenKind::PUNCT_R_BRACE)) {
+                return;
+            }
+            advance();
+            if (k == CTokenKind::PUNCT_L_PAREN) {
+                ++depth;
+            } else if (k == CTokenKind::PUNCT_R_PAREN && depth-- == 0) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Ends a statement or declaration at its `;`.
+     *
+     * A missing `;` before a new line is accepted, as macro invocations
+     * used as statements often omit it.
+     */
+    void
+    end_statement() {
+        if (accept(CTokenKind::PUNCT_SEMI) || at_line_start() || at(CTokenKind::PUNCT_R_BRACE) ||
+            at(CTokenKind::TOKEN_END)) {
+            return;
+        }
+        ++errors;
+        sync();
+    }
+
+    /**
+     * @brief Skips a construct nested too deep, pushing a `NODE_ERROR`.
+     *
+     * @param statement [in] Whether the construct is a statement or
+     *                  declaration, skipped with its `;`, rather than an
+     *                  operand, skipped up to the `,`, `;` or closing
+     *                  bracket that ends it.
+     */
+    void
+    skip_nested(const bool statement) {
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        ++errors;
+        if (statement) {
+            at(CTokenKind::PUNCT_L_BRACE) ? skip_balanced() : sync();
+        } else {
+            int open = 0;
+            while (!at(CTokenKind::TOKEN_END)) {
+                const CTokenKind k = kind();
+                const bool closing = k == CTokenKind::PUNCT_R_PAREN || k == CTokenKind::PUNCT_R_SQUARE ||
+                                     k == CTokenKind::PUNCT_R_BRACE;
+                if (open == 0 && (closing || k == CTokenKind::PUNCT_SEMI || k == CTokenKind::PUNCT_COMMA)) {
+                    break;
+                }
+                advance();
+                if (k == CTokenKind::PUNCT_L_PAREN || k == CTokenKind::PUNCT_L_SQUARE || k == CTokenKind::PUNCT_L_BRACE) {
+                    ++open;
+                } else if (closing) {
+                    --open;
+                }
+            }
+        }
+        finish(CNodeKind::NODE_ERROR, start, first);
+    }
+
+    // ---------------- Nodes ----------------
+
+    [[nodiscard]] ca_size_t
+    mark() const {
+        return pending.size();
+    }
+
+    [[nodiscard]] ca_uint16_t
+    recovered(const ca_uint64_t errors_before) const {
+        return errors != errors_before ? C_NODE_RECOVERED : 0;
+    }
+
+    /**
+     * @brief Completes a node whose children are the nodes pushed since `start`.
+     */
+    index_type
+    finish(const CNodeKind kind, const ca_size_t start, const ca_size_t first, const ca_size_t token = CAst::INVALID_INDEX,
+           const CTokenKind op = CTokenKind::TOKEN_UNKNOWN, const ca_uint16_t flags = 0) {
+        CAstNode node{};
+        node.kind = kind;
+        node.op = op;
+        node.flags = flags;
+        node.token = static_cast<index_type>(token);
+        node.first_token = static_cast<index_type>(first);
+        node.last_token = static_cast<index_type>(last >= first ? last : first);
+        index_type size = 1;
+        for (ca_size_t i = start; i < pending.size(); ++i) {
+            size += builder.staged_sizes[pending[i]];
+        }
+        const index_type index = static_cast<index_type>(builder.staged.size());
+        builder.staged.push_back(node);
+        builder.staged_sizes.push_back(size);
+        pending.resize(start);
+        pending.push_back(index);
+        return index;
+    }
+
+    // ---------------- Declarations ----------------
+
+    /**
+     * @brief Checks if the token at `i` is an identifier followed by a
+     *        qualifier, or by `*`s and then `)`, a qualifier, or a name
+     *        followed by `=` or `[]`, which no expression can be.
+     */
+    [[nodiscard]] bool
+    is_pointer_type(const ca_size_t i) const {
+        if (tokens.kinds[i] != CTokenKind::TOKEN_IDENTIFIER) {
+            return false;
+        }
+        ca_size_t j = next(i);
+        if (tokens.kinds[j] == CTokenKind::KEYWORD_CONST || tokens.kinds[j] == CTokenKind::KEYWORD_VOLATILE) {
+            return true;
+        }
+        if (tokens.kinds[j] != CTokenKind::PUNCT_STAR) {
+            return false;
+        }
+        while (tokens.kinds[j] == CTokenKind::PUNCT_STAR) {
+            j = next(j);
+        }
+        const CTokenKind k = tokens.kinds[j];
+        if (k == CTokenKind::TOKEN_IDENTIFIER) {
+            j = next(j);
+            return tokens.kinds[j] == CTokenKind::PUNCT_EQUAL ||
+                   (tokens.kinds[j] == CTokenKind::PUNCT_L_SQUARE && tokens.kinds[next(j)] == CTokenKind::PUNCT_R_SQUARE);
+        }
+        return k == CTokenKind::PUNCT_R_PAREN || k == CTokenKind::KEYWORD_CONST ||
+               k == CTokenKind::KEYWORD_RESTRICT || k == CTokenKind::KEYWORD_VOLATILE;
+    }
+
+    /**
+     * @brief Checks if the `(` at `pos` is a cast to an unknown type name,
+     *        that is `(name)` followed by an operand, which a parenthesized
+     *        expression cannot be.
+     */
+    [[nodiscard]] bool
+    is_unknown_cast() const {
+        const ca_size_t name = next(pos);
+        if (tokens.kinds[name] != CTokenKind::TOKEN_IDENTIFIER) {
+            return false;
+        }
+        const ca_size_t close = next(name);
+        if (tokens.kinds[close] != CTokenKind::PUNCT_R_PAREN) {
+            return false;
+        }
+        switch (tokens.kinds[next(close)]) {
+        case CTokenKind::TOKEN_IDENTIFIER:
+        case CTokenKind::TOKEN_NUMBER:
+        case CTokenKind::TOKEN_CHAR:
+        case CTokenKind::TOKEN_STRING:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief Checks if the token at `i` can start a type name.
+     */
+    [[nodiscard]] bool
+    is_type_name_start(const ca_size_t i) const {
+        bool type_specifier;
+        return is_specifier_keyword(tokens.kinds[i], &type_specifier) || in(builder.typedef_names, i) ||
+               in(builder.builtin_types, i) || is_pointer_type(i);
+    }
+
+    /**
+     * @brief Checks if the statement at `pos` is a declaration.
+     */
+    [[nodiscard]] bool
+    is_declaration_start() const {
+        const CTokenKind k = kind();
+        if (k == CTokenKind::KEYWORD_STATIC_ASSERT || k == CTokenKind::KEYWORD__STATIC_ASSERT) {
+            return true;
+        }
+        if (k == CTokenKind::PUNCT_L_SQUARE) {
+            return peek() == CTokenKind::PUNCT_L_SQUARE;
+        }
+        if (k != CTokenKind::TOKEN_IDENTIFIER) {
+            return is_type_name_start(pos);
+        }
+        if (in(builder.qualifiers, pos) || in(builder.attributes, pos)) {
+            return true;
+        }
+        const CTokenKind following = peek();
+        bool type_specifier;
+        if (following == CTokenKind::PUNCT_COLON) {
+            return false;
+        }
+        return in(builder.typedef_names, pos) || in(builder.builtin_types, pos) ||
+               following == CTokenKind::TOKEN_IDENTIFIER || is_specifier_keyword(following, &type_specifier) ||
+               is_pointer_type(pos);
+    }
+
+    /**
+     * @brief Skips attributes, and extension qualifiers if `qualifiers_too`.
+     */
+    void
+    skip_attributes(const bool qualifiers_too) {
+        for (;;) {
+            if (in(builder.attributes, pos)) {
+                advance();
+                if (at(CTokenKind::PUNCT_L_PAREN)) {
+                    skip_balanced();
+                }
+            } else if (qualifiers_too && in(builder.qualifiers, pos)) {
+                advance();
+            } else if (at(CTokenKind::PUNCT_L_SQUARE) && peek() == CTokenKind::PUNCT_L_SQUARE) {
+                skip_balanced();
+            } else {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Parses declaration specifiers.
+     *
+     * @param assume_types [in] Whether an unknown identifier followed by `*`
+     *                     is a type, as in file scope, parameters and members.
+     * @param flags [out] Receives the storage class flags.
+     * @return Whether any specifier was parsed.
+     */
+    bool
+    specifiers(const bool assume_types, ca_uint16_t *flags) {
+        bool saw_type = false;
+        bool any = false;
+        for (;; any = true) {
+            const CTokenKind k = kind();
+            bool type_specifier;
+            if (k == CTokenKind::TOKEN_IDENTIFIER) {
+                if (in(builder.qualifiers, pos) || in(builder.attributes, pos)) {
+                    skip_attributes(true);
+                    continue;
+                }
+                // A declarator name is never followed by a name or `*`, so such an
+                // identifier is a type, or a macro expanding to specifiers
+                const ca_size_t following_index = next(pos);
+                const CTokenKind following = tokens.kinds[following_index];
+                const bool before_name = following == CTokenKind::TOKEN_IDENTIFIER &&
+                                         !in(builder.attributes, following_index) &&
+                                         !in(builder.qualifiers, following_index);
+                if (before_name || is_specifier_keyword(following, &type_specifier) ||
+                    ((assume_types || saw_type) && following == CTokenKind::PUNCT_STAR) ||
+                    (!saw_type && (any || is_pointer_type(pos)) && following == CTokenKind::PUNCT_STAR) ||
+                    (!saw_type && (in(builder.typedef_names, pos) || in(builder.builtin_types, pos)))) {
+                    saw_type = true;
+                    advance();
+                    continue;
+                }
+                return any;
+            }
+            if (k == CTokenKind::PUNCT_L_SQUARE && peek() == CTokenKind::PUNCT_L_SQUARE) {
+                skip_balanced();
+                continue;
+            }
+            if (!is_specifier_keyword(k, &type_specifier)) {
+                return any;
+            }
+
+            saw_type = saw_type || type_specifier;
+            switch (k) {
+            case CTokenKind::KEYWORD_TYPEDEF: *flags |= C_NODE_TYPEDEF; break;
+            case CTokenKind::KEYWORD_STATIC: *flags |= C_NODE_STATIC; break;
+            case CTokenKind::KEYWORD_EXTERN: *flags |= C_NODE_EXTERN; break;
+            case CTokenKind::KEYWORD_INLINE: *flags |= C_NODE_INLINE; break;
+            default: break;
+            }
+
+            if (k == CTokenKind::KEYWORD_STRUCT || k == CTokenKind::KEYWORD_UNION || k == CTokenKind::KEYWORD_ENUM) {
+                record_or_enum();
+                continue;
+            }
+            advance();
+            // _Atomic(T), alignas(...), typeof(...), _BitInt(N)
+            if (at(CTokenKind::PUNCT_L_PAREN) &&
+                (k == CTokenKind::KEYWORD__ATOMIC || k == CTokenKind::KEYWORD_ALIGNAS ||
+                 k == CTokenKind::KEYWORD__ALIGNAS || k == CTokenKind::KEYWORD_TYPEOF ||
+                 k == CTokenKind::KEYWORD_TYPEOF_UNQUAL || k == CTokenKind::KEYWORD__BITINT)) {
+                saw_type = saw_type || k == CTokenKind::KEYWORD__ATOMIC;
+                skip_balanced();
+            }
+        }
+    }
+
+    /**
+     * @brief Parses a `struct`, `union` or `enum` specifier, creating a node
+     *        if it has a body.
+     */
+    void
+    record_or_enum() {
+        const nesting level(*this, false);
+        if (!level.entered) {
+            return;
+        }
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        const ca_uint64_t errors_before = errors;
+        const CTokenKind op = kind();
+        advance();
+        skip_attributes(false);
+
+        ca_size_t tag = CAst::INVALID_INDEX;
+        if (at(CTokenKind::TOKEN_IDENTIFIER)) {
+            tag = pos;
+            advance();
+            skip_attributes(false);
+        }
+        if (op == CTokenKind::KEYWORD_ENUM && accept(CTokenKind::PUNCT_COLON)) {
+            // C23 fixed underlying type
+            ca_uint16_t ignored = 0;
+            specifiers(true, &ignored);
+        }
+        if (!accept(CTokenKind::PUNCT_L_BRACE)) {
+            return;
+        }
+
+        if (op == CTokenKind::KEYWORD_ENUM) {
+            while (at(CTokenKind::TOKEN_IDENTIFIER)) {
+                const ca_size_t enumerator_first = pos;
+                const ca_size_t enumerator_start = mark();
+                advance();
+                skip_attributes(false);
+                if (accept(CTokenKind::PUNCT_EQUAL)) {
+                    conditional();
+                }
+                finish(CNodeKind::NODE_ENUMERATOR, enumerator_start, enumerator_first, enumerator_first);
+                if (!accept(CTokenKind::PUNCT_COMMA)) {
+                    break;
+                }
+            }
+        } else {
+            while (!at(CTokenKind::PUNCT_R_BRACE) && !at(CTokenKind::TOKEN_END)) {
+                if (accept(CTokenKind::PUNCT_SEMI)) {
+                    continue;
+                }
+                const ca_size_t before = pos;
+                declaration(true, true);
+                if (pos == before) {
+                    ++errors;
+                    advance();
+                }
+            }
+        }
+        if (!accept(CTokenKind::PUNCT_R_BRACE)) {
+            ++errors;
+            sync();
+            accept(CTokenKind::PUNCT_R_BRACE);
+        }
+        finish(op == CTokenKind::KEYWORD_ENUM ? CNodeKind::NODE_ENUM : CNodeKind::NODE_RECORD, start, first, tag, op,
+               recovered(errors_before));
+    }
+
+    /**
+     * @brief Checks if the `(` at `pos` opens a nested declarator rather
+     *        than a parameter list.
+     */
+    [[nodiscard]] bool
+    is_nested_declarator() const {
+        const ca_size_t i = next(pos);
+        const CTokenKind k = tokens.kinds[i];
+        if (k == CTokenKind::PUNCT_STAR || k == CTokenKind::PUNCT_CARET || k == CTokenKind::PUNCT_L_PAREN) {
+            return true;
+        }
+        return k == CTokenKind::TOKEN_IDENTIFIER && !is_type_name_start(i) && !in(builder.attributes, i) &&
+               !in(builder.qualifiers, i);
+    }
+
+    /**
+     * @brief Parses a declarator, or an abstract declarator.
+     *
+     * Parameters of the function the declarator declares are pushed as
+     * `NODE_PARAMETER` nodes.
+     *
+     * @param flags [in, out] Receives `C_NODE_FUNCTION` and `C_NODE_VARIADIC`.
+     * @return The index of the declared name, or `INVALID_INDEX`.
+     */
+    ca_size_t
+    declarator(ca_uint16_t *flags) {
+        const nesting level(*this, false);
+        if (!level.entered) {
+            return CAst::INVALID_INDEX;
+        }
+        for (;;) {
+            bool type_specifier;
+            if (at(CTokenKind::PUNCT_STAR) || at(CTokenKind::PUNCT_CARET) ||
+                (is_specifier_keyword(kind(), &type_specifier) && !type_specifier)) {
+                advance();
+                if (at(CTokenKind::PUNCT_L_PAREN) && tokens.kinds[last] == CTokenKind::KEYWORD__ATOMIC) {
+                    skip_balanced();
+                }
+            } else if (in(builder.qualifiers, pos) || in(builder.attributes, pos) ||
+                       (at(CTokenKind::PUNCT_L_SQUARE) && peek() == CTokenKind::PUNCT_L_SQUARE)) {
+                skip_attributes(true);
+            } else {
+                break;
+            }
+        }
+
+        ca_size_t name = CAst::INVALID_INDEX;
+        bool nested = false;
+        if (at(CTokenKind::TOKEN_IDENTIFIER)) {
+            name = pos;
+            advance();
+        } else if (at(CTokenKind::PUNCT_L_PAREN) && is_nested_declarator()) {
+            advance();
+            name = declarator(flags);
+            close_paren();
+            nested = true;
+        }
+
+        bool function = false;
+        for (;;) {
+            skip_attributes(false);
+            if (at(CTokenKind::PUNCT_L_SQUARE)) {
+                skip_balanced();
+            } else if (at(CTokenKind::PUNCT_L_PAREN)) {
+                if (!nested && !function) {
+                    parameters(flags);
+                    function = true;
+                } else {
+                    skip_balanced();
+                }
+            } else {
+                break;
+            }
+        }
+        skip_attributes(true);
+        if (function) {
+            *flags |= C_NODE_FUNCTION;
+        }
+        return name;
+    }
+
+    /**
+     * @brief Parses a parameter list.
+     */
+    void
+    parameters(ca_uint16_t *flags) {
+        advance();
+        if (accept(CTokenKind::PUNCT_R_PAREN)) {
+            return;
+        }
+        do {
+            if (accept(CTokenKind::PUNCT_ELLIPSIS)) {
+                *flags |= C_NODE_VARIADIC;
+                continue;
+            }
+            const ca_size_t first = pos;
+            const ca_size_t start = mark();
+            ca_uint16_t parameter_flags = 0;
+            specifiers(true, &parameter_flags);
+            const ca_size_t name = declarator(&parameter_flags);
+            finish(CNodeKind::NODE_PARAMETER, start, first, name, CTokenKind::TOKEN_UNKNOWN,
+                   parameter_flags & (C_NODE_FUNCTION | C_NODE_VARIADIC));
+        } while (accept(CTokenKind::PUNCT_COMMA));
+        close_paren();
+    }
+
+    /**
+     * @brief Parses `static_assert(condition, message);`.
+     */
+    void
+    static_assertion() {
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        const CTokenKind op = kind();
+        advance();
+        if (expect(CTokenKind::PUNCT_L_PAREN)) {
+            assignment();
+            if (accept(CTokenKind::PUNCT_COMMA)) {
+                assignment();
+            }
+            close_paren();
+        }
+        end_statement();
+        finish(CNodeKind::NODE_STATIC_ASSERT, start, first, CAst::INVALID_INDEX, op);
+    }
+
+    /**
+     * @brief Parses a declaration or a function definition.
+     *
+     * @param assume_types [in] See `specifiers`.
+     * @param member [in] Whether this is a member of a record.
+     */
+    void
+    declaration(const bool assume_types, const bool member) {
+        const nesting level(*this, true);
+        if (!level.entered) {
+            return;
+        }
+        if (at(CTokenKind::KEYWORD_STATIC_ASSERT) || at(CTokenKind::KEYWORD__STATIC_ASSERT)) {
+            static_assertion();
+            return;
+        }
+
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        const ca_uint64_t errors_before = errors;
+        ca_uint16_t flags = 0;
+        specifiers(assume_types, &flags);
+
+        if (!accept(CTokenKind::PUNCT_SEMI)) {
+            for (bool first_declarator = true;; first_declarator = false) {
+                const ca_size_t declarator_first = pos;
+                const ca_size_t declarator_start = mark();
+                ca_uint16_t declarator_flags = 0;
+                const ca_size_t name = declarator(&declarator_flags);
+
+                if (first_declarator && !member && (declarator_flags & C_NODE_FUNCTION) != 0) {
+                    // Old-style parameter declarations
+                    while (!at(CTokenKind::PUNCT_L_BRACE) && is_type_name_start(pos)) {
+                        declaration(true, false);
+                    }
+                    if (at(CTokenKind::PUNCT_L_BRACE)) {
+                        compound();
+                        finish(CNodeKind::NODE_FUNCTION_DEFINITION, start, first, name, CTokenKind::TOKEN_UNKNOWN,
+                               flags | declarator_flags | recovered(errors_before));
+                        return;
+                    }
+                }
+
+                if (member && accept(CTokenKind::PUNCT_COLON)) {
+                    conditional();
+                }
+                if (accept(CTokenKind::PUNCT_EQUAL)) {
+                    initializer();
+                }
+                skip_attributes(true);
+                finish(CNodeKind::NODE_DECLARATOR, declarator_start, declarator_first, name, CTokenKind::TOKEN_UNKNOWN,
+                       declarator_flags);
+                if ((flags & C_NODE_TYPEDEF) != 0 && name != CAst::INVALID_INDEX) {
+                    builder.typedef_names.insert(tokens.ids[name]);
+                }
+                if (!accept(CTokenKind::PUNCT_COMMA)) {
+                    break;
+                }
+            }
+            end_statement();
+        }
+        finish(CNodeKind::NODE_DECLARATION, start, first, CAst::INVALID_INDEX, CTokenKind::TOKEN_UNKNOWN,
+               flags | recovered(errors_before));
+    }
+
+    /**
+     * @brief Parses a type name, as in a cast or `sizeof`.
+     */
+    void
+    type_name() {
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        ca_uint16_t flags = 0;
+        specifiers(true, &flags);
+        declarator(&flags);
+        finish(CNodeKind::NODE_TYPE_NAME, start, first);
+    }
+
+    // ---------------- Statements ----------------
+
+    void
+    compound() {
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        const ca_uint64_t errors_before = errors;
+        advance();
+        while (!at(CTokenKind::PUNCT_R_BRACE) && !at(CTokenKind::TOKEN_END)) {
+            const ca_size_t before = pos;
+            statement();
+            if (pos == before) {
+                ++errors;
+                advance();
+            }
+        }
+        expect(CTokenKind::PUNCT_R_BRACE);
+        finish(CNodeKind::NODE_COMPOUND, start, first, CAst::INVALID_INDEX, CTokenKind::TOKEN_UNKNOWN,
+               recovered(errors_before));
+    }
+
+    /**
+     * @brief Parses `( expression )`.
+     */
+    void
+    paren_expression() {
+        if (expect(CTokenKind::PUNCT_L_PAREN)) {
+            expression();
+            close_paren();
+        }
+    }
+
+    /**
+     * @brief Pushes a `NODE_EMPTY` for an absent clause.
+     */
+    void
+    empty() {
+        finish(CNodeKind::NODE_EMPTY, mark(), pos);
+    }
+
+    /**
+     * @brief Parses the statement after a label, which C23 allows to be absent.
+     */
+    void
+    labeled_statement() {
+        if (!at(CTokenKind::PUNCT_R_BRACE)) {
+            statement();
+        }
+    }
+
+    void
+    statement() {
+        const nesting level(*this, true);
+        if (!level.entered) {
+            return;
+        }
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        const ca_uint64_t errors_before = errors;
+        CNodeKind node_kind;
+        ca_size_t token = CAst::INVALID_INDEX;
+
+        switch (kind()) {
+        case CTokenKind::PUNCT_L_BRACE:
+            compound();
+            return;
+        case CTokenKind::KEYWORD_IF:
+            advance();
+            paren_expression();
+            statement();
+            if (accept(CTokenKind::KEYWORD_ELSE)) {
+                statement();
+            }
+            node_kind = CNodeKind::NODE_IF;
+            break;
+        case CTokenKind::KEYWORD_WHILE:
+        case CTokenKind::KEYWORD_SWITCH:
+            node_kind = at(CTokenKind::KEYWORD_WHILE) ? CNodeKind::NODE_WHILE : CNodeKind::NODE_SWITCH;
+            advance();
+            paren_expression();
+            statement();
+            break;
+        case CTokenKind::KEYWORD_DO:
+            advance();
+            statement();
+            if (expect(CTokenKind::KEYWORD_WHILE)) {
+                paren_expression();
+            }
+            end_statement();
+            node_kind = CNodeKind::NODE_DO;
+            break;
+        case CTokenKind::KEYWORD_FOR:
+            advance();
+            if (expect(CTokenKind::PUNCT_L_PAREN)) {
+                if (at(CTokenKind::PUNCT_SEMI)) {
+                    empty();
+                    advance();
+                } else if (is_declaration_start()) {
+                    declaration(false, false);
+                } else {
+                    expression();
+                    expect(CTokenKind::PUNCT_SEMI);
+                }
+                at(CTokenKind::PUNCT_SEMI) ? empty() : expression();
+                expect(CTokenKind::PUNCT_SEMI);
+                at(CTokenKind::PUNCT_R_PAREN) ? empty() : expression();
+                close_paren();
+            }
+            statement();
+            node_kind = CNodeKind::NODE_FOR;
+            break;
+        case CTokenKind::KEYWORD_CASE:
+            advance();
+            conditional();
+            if (accept(CTokenKind::PUNCT_ELLIPSIS)) {
+                conditional();
+            }
+            expect(CTokenKind::PUNCT_COLON);
+            labeled_statement();
+            node_kind = CNodeKind::NODE_CASE;
+            break;
+        case CTokenKind::KEYWORD_DEFAULT:
+            advance();
+            expect(CTokenKind::PUNCT_COLON);
+            labeled_statement();
+            node_kind = CNodeKind::NODE_DEFAULT;
+            break;
+        case CTokenKind::KEYWORD_GOTO:
+            advance();
+            token = pos;
+            if (!accept(CTokenKind::TOKEN_IDENTIFIER) && accept(CTokenKind::PUNCT_STAR)) {
+                cast_expression();
+            }
+            end_statement();
+            node_kind = CNodeKind::NODE_GOTO;
+            break;
+        case CTokenKind::KEYWORD_BREAK:
+        case CTokenKind::KEYWORD_CONTINUE:
+            node_kind = at(CTokenKind::KEYWORD_BREAK) ? CNodeKind::NODE_BREAK : CNodeKind::NODE_CONTINUE;
+            advance();
+            end_statement();
+            break;
+        case CTokenKind::KEYWORD_RETURN:
+            advance();
+            if (!at(CTokenKind::PUNCT_SEMI)) {
+                expression();
+            }
+            end_statement();
+            node_kind = CNodeKind::NODE_RETURN;
+            break;
+        case CTokenKind::PUNCT_SEMI:
+            advance();
+            node_kind = CNodeKind::NODE_NULL_STATEMENT;
+            break;
+        default:
+            if (at(CTokenKind::TOKEN_IDENTIFIER) && peek() == CTokenKind::PUNCT_COLON) {
+                token = pos;
+                advance();
+                advance();
+                labeled_statement();
+                node_kind = CNodeKind::NODE_LABEL;
+                break;
+            }
+            if (is_declaration_start()) {
+                declaration(false, false);
+                return;
+            }
+            expression();
+            end_statement();
+            node_kind = CNodeKind::NODE_EXPRESSION_STATEMENT;
+            break;
+        }
+        finish(node_kind, start, first, token, CTokenKind::TOKEN_UNKNOWN, recovered(errors_before));
+    }
+
+    // ---------------- Expressions ----------------
+
+    void
+    expression() {
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        assignment();
+        while (at(CTokenKind::PUNCT_COMMA)) {
+            const ca_size_t op = pos;
+            advance();
+            assignment();
+            finish(CNodeKind::NODE_BINARY, start, first, op, CTokenKind::PUNCT_COMMA);
+        }
+    }
+
+    void
+    assignment() {
+        const nesting level(*this, false);
+        if (!level.entered) {
+            return;
+        }
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        conditional();
+        if (is_assignment(kind())) {
+            const ca_size_t op = pos;
+            advance();
+            assignment();
+            finish(CNodeKind::NODE_BINARY, start, first, op, tokens.kinds[op]);
+        }
+    }
+
+    void
+    conditional() {
+        const nesting level(*this, false);
+        if (!level.entered) {
+            return;
+        }
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        binary(1);
+        if (accept(CTokenKind::PUNCT_QUESTION)) {
+            // GNU `a ?: b` has no middle operand
+            if (!at(CTokenKind::PUNCT_COLON)) {
+                expression();
+            }
+            expect(CTokenKind::PUNCT_COLON);
+            conditional();
+            finish(CNodeKind::NODE_CONDITIONAL, start, first);
+        }
+    }
+
+    void
+    binary(const int min_precedence) {
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        cast_expression();
+        for (;;) {
+            const int precedence = binary_precedence(kind());
+            if (precedence == 0 || precedence < min_precedence) {
+                return;
+            }
+            const ca_size_t op = pos;
+            advance();
+            binary(precedence + 1);
+            finish(CNodeKind::NODE_BINARY, start, first, op, tokens.kinds[op]);
+        }
+    }
+
+    void
+    cast_expression() {
+        const nesting level(*this, false);
+        if (!level.entered) {
+            return;
+        }
+        skip_attributes(true);
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        const CTokenKind k = kind();
+
+        switch (k) {
+        case CTokenKind::PUNCT_PLUS_PLUS:
+        case CTokenKind::PUNCT_MINUS_MINUS:
+        case CTokenKind::PUNCT_AMP:
+        case CTokenKind::PUNCT_STAR:
+        case CTokenKind::PUNCT_PLUS:
+        case CTokenKind::PUNCT_MINUS:
+        case CTokenKind::PUNCT_TILDE:
+        case CTokenKind::PUNCT_EXCLAIM:
+        case CTokenKind::PUNCT_AMP_AMP:     // GNU address of label
+            advance();
+            cast_expression();
+            finish(CNodeKind::NODE_UNARY, start, first, first, k);
+            return;
+        case CTokenKind::KEYWORD_SIZEOF:
+        case CTokenKind::KEYWORD_ALIGNOF:
+        case CTokenKind::KEYWORD__ALIGNOF:
+            advance();
+            if (at(CTokenKind::PUNCT_L_PAREN) && is_type_name_start(next(pos))) {
+                advance();
+                type_name();
+                close_paren();
+                finish(CNodeKind::NODE_SIZEOF_TYPE, start, first, first, k);
+            } else {
+                cast_expression();
+                finish(CNodeKind::NODE_UNARY, start, first, first, k);
+            }
+            return;
+        case CTokenKind::PUNCT_L_PAREN:
+            if (is_type_name_start(next(pos)) || is_unknown_cast()) {
+                advance();
+                type_name();
+                close_paren();
+                if (at(CTokenKind::PUNCT_L_BRACE)) {
+                    initializer_list();
+                    finish(CNodeKind::NODE_COMPOUND_LITERAL, start, first);
+                    postfix(start, first);
+                } else {
+                    cast_expression();
+                    finish(CNodeKind::NODE_CAST, start, first);
+                }
+                return;
+            }
+            if (peek() == CTokenKind::PUNCT_L_BRACE) {
+                advance();
+                compound();
+                close_paren();
+                finish(CNodeKind::NODE_STATEMENT_EXPRESSION, start, first);
+                postfix(start, first);
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+        primary();
+        postfix(start, first);
+    }
+
+    void
+    primary() {
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        switch (kind()) {
+        case CTokenKind::TOKEN_IDENTIFIER:
+        case CTokenKind::KEYWORD_TRUE:
+        case CTokenKind::KEYWORD_FALSE:
+        case CTokenKind::KEYWORD_NULLPTR:
+            advance();
+            finish(CNodeKind::NODE_NAME, start, first, first);
+            return;
+        case CTokenKind::TOKEN_NUMBER:
+            advance();
+            finish(CNodeKind::NODE_NUMBER, start, first, first);
+            return;
+        case CTokenKind::TOKEN_CHAR:
+            advance();
+            finish(CNodeKind::NODE_CHAR, start, first, first);
+            return;
+        case CTokenKind::TOKEN_STRING:
+            // Adjacent literals, possibly with format macros such as PRIu64 between them
+            while (at(CTokenKind::TOKEN_STRING) ||
+                   (at(CTokenKind::TOKEN_IDENTIFIER) && peek() == CTokenKind::TOKEN_STRING)) {
+                advance();
+            }
+            finish(CNodeKind::NODE_STRING, start, first, first);
+            return;
+        case CTokenKind::PUNCT_L_PAREN:
+            advance();
+            expression();
+            close_paren();
+            return;
+        case CTokenKind::KEYWORD__GENERIC:
+            generic();
+            return;
+        case CTokenKind::PUNCT_SEMI:
+        case CTokenKind::PUNCT_R_BRACE:
+        case CTokenKind::PUNCT_R_PAREN:
+        case CTokenKind::PUNCT_R_SQUARE:
+        case CTokenKind::PUNCT_COMMA:
+        case CTokenKind::TOKEN_END:
+            break;
+        default:
+            advance();
+            break;
+        }
+        ++errors;
+        finish(CNodeKind::NODE_ERROR, start, first);
+    }
+
+    /**
+     * @brief Parses the postfix operators applied to the operand pushed since `start`.
+     */
+    void
+    postfix(const ca_size_t start, const ca_size_t first) {
+        for (;;) {
+            const CTokenKind k = kind();
+            if (k == CTokenKind::PUNCT_L_PAREN) {
+                const CAstNode &callee = builder.staged[pending[start]];
+                const ca_size_t name = callee.kind == CNodeKind::NODE_NAME ? callee.token : CAst::INVALID_INDEX;
+                advance();
+                if (!at(CTokenKind::PUNCT_R_PAREN)) {
+                    do {
+                        // Macros such as va_arg take type names
+                        if (is_type_name_start(pos)) {
+                            type_name();
+                        } else {
+                            assignment();
+                        }
+                    } while (accept(CTokenKind::PUNCT_COMMA));
+                }
+                close_paren();
+                finish(CNodeKind::NODE_CALL, start, first, name);
+            } else if (k == CTokenKind::PUNCT_L_SQUARE) {
+                advance();
+                expression();
+                expect(CTokenKind::PUNCT_R_SQUARE);
+                finish(CNodeKind::NODE_SUBSCRIPT, start, first);
+            } else if (k == CTokenKind::PUNCT_PERIOD || k == CTokenKind::PUNCT_ARROW) {
+                advance();
+                const ca_size_t member = at(CTokenKind::TOKEN_IDENTIFIER) ? pos : CAst::INVALID_INDEX;
+                expect(CTokenKind::TOKEN_IDENTIFIER);
+                finish(CNodeKind::NODE_MEMBER, start, first, member, k);
+            } else if (k == CTokenKind::PUNCT_PLUS_PLUS || k == CTokenKind::PUNCT_MINUS_MINUS) {
+                const ca_size_t op = pos;
+                advance();
+                finish(CNodeKind::NODE_POSTFIX, start, first, op, k);
+            } else {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Parses `_Generic(controlling, type: expression, ...)`.
+     */
+    void
+    generic() {
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        advance();
+        if (expect(CTokenKind::PUNCT_L_PAREN)) {
+            assignment();
+            while (accept(CTokenKind::PUNCT_COMMA)) {
+                // The type name of the association is not kept
+                while (!at(CTokenKind::PUNCT_COLON) && !at(CTokenKind::PUNCT_R_PAREN) && !at(CTokenKind::TOKEN_END)) {
+                    at(CTokenKind::PUNCT_L_PAREN) || at(CTokenKind::PUNCT_L_SQUARE) ? skip_balanced() : advance();
+                }
+                if (!expect(CTokenKind::PUNCT_COLON)) {
+                    break;
+                }
+                assignment();
+            }
+            close_paren();
+        }
+        finish(CNodeKind::NODE_GENERIC, start, first);
+    }
+
+    void
+    initializer() {
+        const nesting level(*this, false);
+        if (!level.entered) {
+            return;
+        }
+        if (at(CTokenKind::PUNCT_L_BRACE)) {
+            initializer_list();
+        } else {
+            assignment();
+        }
+    }
+
+    void
+    initializer_list() {
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        const ca_uint64_t errors_before = errors;
+        advance();
+        while (!at(CTokenKind::PUNCT_R_BRACE) && !at(CTokenKind::TOKEN_END)) {
+            if (at(CTokenKind::PUNCT_PERIOD) || at(CTokenKind::PUNCT_L_SQUARE)) {
+                designation();
+            } else {
+                initializer();
+            }
+            if (!accept(CTokenKind::PUNCT_COMMA)) {
+                break;
+            }
+        }
+        if (!accept(CTokenKind::PUNCT_R_BRACE)) {
+            ++errors;
+            sync();
+            accept(CTokenKind::PUNCT_R_BRACE);
+        }
+        finish(CNodeKind::NODE_INIT_LIST, start, first, CAst::INVALID_INDEX, CTokenKind::TOKEN_UNKNOWN,
+               recovered(errors_before));
+    }
+
+    void
+    designation() {
+        const ca_size_t first = pos;
+        const ca_size_t start = mark();
+        for (;;) {
+            if (accept(CTokenKind::PUNCT_PERIOD)) {
+                expect(CTokenKind::TOKEN_IDENTIFIER);
+            } else if (accept(CTokenKind::PUNCT_L_SQUARE)) {
+                conditional();
+                if (accept(CTokenKind::PUNCT_ELLIPSIS)) {
+                    conditional();
+                }
+                expect(CTokenKind::PUNCT_R_SQUARE);
+            } else {
+                break;
+            }
+        }
+        expect(CTokenKind::PUNCT_EQUAL);
+        initializer();
+        finish(CNodeKind::NODE_DESIGNATION, start, first);
+    }
+
+    // ---------------- Translation unit ----------------
+
+    void
+    translation_unit() {
+        const ca_size_t start = mark();
+        while (!at(CTokenKind::TOKEN_END)) {
+            // `extern "C" {` and its closing `}` in headers shared with C++
+            if (at(CTokenKind::KEYWORD_EXTERN) && peek() == CTokenKind::TOKEN_STRING) {
+                advance();
+                advance();
+                accept(CTokenKind::PUNCT_L_BRACE);
+                continue;
+            }
+            if (accept(CTokenKind::PUNCT_SEMI) || accept(CTokenKind::PUNCT_R_BRACE)) {
+                continue;
+            }
+            const ca_size_t before = pos;
+            declaration(true, false);
+            if (pos == before) {
+                ++errors;
+                advance();
+            }
+        }
+        finish(CNodeKind::NODE_TRANSLATION_UNIT, start, 0, CAst::INVALID_INDEX, CTokenKind::TOKEN_UNKNOWN,
+               recovered(0));
+    }
+};
+
+CASTBuilder::CASTBuilder(ca_string::ca_intern_pool *pool)
+    : tokenizer(pool), totals() {
+    const auto intern_all = [pool](const auto &names, std::unordered_set<id_type> &set) {
+        for (const char *name : names) {
+            set.insert(pool->intern(reinterpret_cast<const ca_string::ca_char_t*>(name), std::strlen(name)));
+        }
+    };
+    intern_all(BUILTIN_TYPE_NAMES, builtin_types);
+    intern_all(QUALIFIER_NAMES, qualifiers);
+    intern_all(ATTRIBUTE_NAMES, attributes);
+}
+
+int
+CASTBuilder::build(const ca_string::ca_char_t *source, const ca_size_t size, CAst *ast) {
+    assert(ast != nullptr);
+
+    ast->reset();
+    if (tokenizer.lex(source, size, &ast->tokens) != 0) {
+        return -1;
+    }
+    // Real-world C has about 3 nodes for every 4 tokens
+    staged.clear();
+    staged_sizes.clear();
+    staged.reserve(ast->tokens.size() / 4 * 3 + 16);
+    staged_sizes.reserve(staged.capacity());
+    typedef_names.clear();
+    pending.clear();
+
+    CParser parser(*this, ast->tokens);
+    parser.translation_unit();
+    assert(pending.size() == 1);
+    ast->assign(staged, staged_sizes);
+
+    ++totals.units;
+    totals.tokens += ast->tokens.size();
+    totals.nodes += ast->size();
+    totals.node_bytes += static_cast<ca_uint64_t>(ast->bytes_per_node() * static_cast<double>(ast->size()));
+    totals.errors += parser.errors;
+    return 0;
+}
+
+}
@@ -0,0 +1,109 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/c/core/parser/CAst.cpp
+//
+// @file
+// @brief Implements `CAst` and the node kind names.
+// ================================
+
+#include "core/parser/CAst.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace ca::analyzers::c {
+
+namespace {
+
+/**
+ * @brief Names of the node kinds, in the order of their kinds.
+ */
+constexpr const char *NODE_KIND_NAMES[] = {
+    "translation-unit", "function-definition", "declaration", "declarator", "parameter", "record", "enum",
+    "enumerator", "static-assert", "type-name", "compound", "if", "while", "do", "for", "switch", "case",
+    "default", "label", "goto", "break", "continue", "return", "expression-statement", "null-statement",
+    "empty", "name", "number", "char", "string", "unary", "postfix", "binary", "conditional", "cast",
+    "sizeof-type", "call", "subscript", "member", "compound-literal", "init-list", "designation",
+    "statement-expression", "generic", "error",
+};
+
+static_assert(std::size(NODE_KIND_NAMES) == static_cast<ca_size_t>(CNodeKind::NODE_ERROR) + 1);
+
+}
+
+const char *
+c_node_kind_name(const CNodeKind kind) {
+    return NODE_KIND_NAMES[static_cast<ca_size_t>(kind)];
+}
+
+void
+CAst::assign(const std::span<const CAstNode> post_order, const std::span<const index_type> subtree_sizes) {
+    assert(post_order.size() == subtree_sizes.size());
+    assert(post_order.size() < INVALID_INDEX);
+    const index_type count = static_cast<index_type>(post_order.size());
+    nodes.resize(count);
+    kind_offsets.fill(0);
+    if (count == 0) {
+        kind_nodes.clear();
+        return;
+    }
+    assert(subtree_sizes[count - 1] == count);
+
+    // Walk from the root down: a node is placed before its children, and its
+    // children, found from the last one back, are placed from the end of its
+    // subtree back. `kind_nodes` holds the pre-order positions meanwhile.
+    kind_nodes.resize(count);
+    index_type *position = kind_nodes.data();
+    position[count - 1] = 0;
+    for (index_type i = count; i-- > 0;) {
+        const index_type at = position[i];
+        const index_type size = subtree_sizes[i];
+        nodes[at] = post_order[i];
+        nodes[at].subtree_end = at + size;
+        ++kind_offsets[static_cast<ca_size_t>(post_order[i].kind) + 1];
+
+        index_type end = at + size;
+        for (index_type child_end = i; child_end > i + 1 - size;) {
+            const index_type child = child_end - 1;
+            assert(subtree_sizes[child] <= child_end - (i + 1 - size));
+            end -= subtree_sizes[child];
+            position[child] = end;
+            child_end -= subtree_sizes[child];
+        }
+        assert(end == at + 1);
+    }
+
+    // Counting sort of the nodes by kind, keeping pre-order within a kind
+    for (ca_size_t k = 1; k < kind_offsets.size(); ++k) {
+        kind_offsets[k] += kind_offsets[k - 1];
+    }
+    std::array<index_type, C_NODE_KIND_COUNT> next;
+    std::copy(kind_offsets.begin(), kind_offsets.end() - 1, next.begin());
+    for (index_type i = 0; i < count; ++i) {
+        kind_nodes[next[static_cast<ca_size_t>(nodes[i].kind)]++] = i;
+    }
+}
+
+void
+CAst::reset() {
+    tokens.clear();
+    nodes.clear();
+    kind_nodes.clear();
+    kind_offsets.fill(0);
+}
+
+ca_size_t
+CAst::memory_usage() const {
+    return nodes.capacity() * sizeof(CAstNode) + kind_nodes.capacity() * sizeof(index_type);
+}
+
+double
+CAst::bytes_per_node() const {
+    if (nodes.empty()) {
+        return 0;
+    }
+    return static_cast<double>(nodes.size() * sizeof(CAstNode) + kind_nodes.size() * sizeof(index_type)) /
+           static_cast<double>(nodes.size());
+}
+
+}
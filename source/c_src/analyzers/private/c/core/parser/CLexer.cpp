@@ -0,0 +1,728 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/c/core/parser/CLexer.cpp
+//
+// @file
+// @brief Implements `CLexer`, including the SIMD character class scans.
+// ================================
+
+#include "core/parser/CLexer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <string_view>
+#include <emmintrin.h>  // SSE2
+#ifdef __AVX2__
+#include <immintrin.h>  // AVX2
+#endif
+
+namespace ca::analyzers::c {
+
+using ca_string::ca_char_t;
+
+namespace {
+
+/**
+ * @brief Checks if a byte may continue an identifier: `[A-Za-z0-9_$]` or
+ *        any byte of a UTF-8 sequence.
+ */
+constexpr bool
+is_identifier_char(const ca_char_t c) {
+    return static_cast<ca_char_t>((c | 0x20) - 'a') < 26 || static_cast<ca_char_t>(c - '0') < 10 ||
+           c == '_' || c == '$' || c >= 0x80;
+}
+
+/**
+ * @brief Checks if a byte is horizontal whitespace, or `\r`.
+ */
+constexpr bool
+is_blank(const ca_char_t c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Returns 0xFF in every byte of `v` within `[lo, lo + span]`, unsigned.
+ */
+inline __m128i
+in_range(const __m128i v, const char lo, const char span) {
+    const __m128i shifted = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(span)), shifted);
+}
+
+#ifdef __AVX2__
+inline __m256i
+in_range(const __m256i v, const char lo, const char span) {
+    const __m256i shifted = _mm256_sub_epi8(v, _mm256_set1_epi8(lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(span)), shifted);
+}
+#endif
+
+/**
+ * @brief Stops at bytes that are not blanks (so also at `\n`).
+ */
+struct blank_stop {
+    static bool
+    test(const ca_char_t c) {
+        return !is_blank(c);
+    }
+
+    static __m128i
+    test(const __m128i v) {
+        // ' ' or [\t, \r] but not \n
+        const __m128i blank = _mm_andnot_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                               _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                                            in_range(v, '\t', '\r' - '\t')));
+        return _mm_xor_si128(blank, _mm_set1_epi8(-1));
+    }
+
+#ifdef __AVX2__
+    static __m256i
+    test(const __m256i v) {
+        const __m256i blank = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                                                  _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                                                  in_range(v, '\t', '\r' - '\t')));
+        return _mm256_xor_si256(blank, _mm256_set1_epi8(-1));
+    }
+#endif
+};
+
+/**
+ * @brief Stops at bytes that cannot continue an identifier.
+ */
+struct identifier_stop {
+    static bool
+    test(const ca_char_t c) {
+        return !is_identifier_char(c);
+    }
+
+    static __m128i
+    test(const __m128i v) {
+        const __m128i letter = in_range(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 25);
+        const __m128i digit = in_range(v, '0', 9);
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('_')),
+                                             _mm_cmpeq_epi8(v, _mm_set1_epi8('$')));
+        const __m128i high = _mm_cmplt_epi8(v, _mm_setzero_si128());
+        const __m128i identifier = _mm_or_si128(_mm_or_si128(letter, digit), _mm_or_si128(special, high));
+        return _mm_xor_si128(identifier, _mm_set1_epi8(-1));
+    }
+
+#ifdef __AVX2__
+    static __m256i
+    test(const __m256i v) {
+        const __m256i letter = in_range(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 25);
+        const __m256i digit = in_range(v, '0', 9);
+        const __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')),
+                                                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('$')));
+        const __m256i high = _mm256_cmpgt_epi8(_mm256_setzero_si256(), v);
+        const __m256i identifier = _mm256_or_si256(_mm256_or_si256(letter, digit), _mm256_or_si256(special, high));
+        return _mm256_xor_si256(identifier, _mm256_set1_epi8(-1));
+    }
+#endif
+};
+
+/**
+ * @brief Stops at any of three bytes.
+ */
+struct bytes_stop {
+    ca_char_t a;
+    ca_char_t b;
+    ca_char_t c;
+
+    bool
+    test(const ca_char_t x) const {
+        return x == a || x == b || x == c;
+    }
+
+    __m128i
+    test(const __m128i v) const {
+        return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(a))),
+                                         _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(b)))),
+                            _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(c))));
+    }
+
+#ifdef __AVX2__
+    __m256i
+    test(const __m256i v) const {
+        return _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>(a))),
+                                               _mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>(b)))),
+                               _mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>(c))));
+    }
+#endif
+};
+
+/**
+ * @brief Returns the first index in `[i, size)` where `stop` holds, or `size`.
+ */
+template <typename Stop>
+ca_size_t
+scan(const Stop &stop, const ca_char_t *buf, ca_size_t i, const ca_size_t size) {
+#if defined(__AVX2__)
+    while (i + 32 <= size) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf + i));
+        const auto mask = static_cast<ca_uint32_t>(_mm256_movemask_epi8(stop.test(chunk)));
+        if (mask != 0) {
+            return i + std::countr_zero(mask);
+        }
+        i += 32;
+    }
+#endif
+
+    while (i + 16 <= size) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i));
+        const auto mask = static_cast<ca_uint32_t>(_mm_movemask_epi8(stop.test(chunk)));
+        if (mask != 0) {
+            return i + std::countr_zero(mask);
+        }
+        i += 16;
+    }
+
+    while (i < size && !stop.test(buf[i])) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * @brief Returns the length of a backslash-newline splice at `i`, or 0.
+ */
+ca_size_t
+splice_length(const ca_char_t *buf, const ca_size_t i, const ca_size_t size) {
+    if (i + 1 < size && buf[i + 1] == '\n') {
+        return 2;
+    }
+    if (i + 2 < size && buf[i + 1] == '\r' && buf[i + 2] == '\n') {
+        return 3;
+    }
+    return 0;
+}
+
+/**
+ * @brief Lexing state of one buffer.
+ */
+struct lexer_run {
+    const ca_char_t *buf;
+    ca_size_t size;
+    ca_size_t i;
+    ca_uint64_t comment_bytes;
+
+    ca_char_t
+    peek(const ca_size_t k) const {
+        return i + k < size ? buf[i + k] : 0;
+    }
+
+    /**
+     * @brief Skips whitespace, splices and comments before the next token.
+     *
+     * @return The `C_TOKEN_LINE_START` and `C_TOKEN_SPACE_BEFORE` flags of
+     *         the next token.
+     */
+    ca_uint8_t
+    skip_trivia(ca_uint8_t flags) {
+        static constexpr blank_stop BLANK;
+        for (;;) {
+            const ca_size_t start = i;
+            i = scan(BLANK, buf, i, size);
+            if (i != start) {
+                flags |= C_TOKEN_SPACE_BEFORE;
+            }
+            if (i >= size) {
+                return flags;
+            }
+
+            const ca_char_t c = buf[i];
+            if (c == '\n') {
+                flags |= C_TOKEN_LINE_START | C_TOKEN_SPACE_BEFORE;
+                ++i;
+            } else if (c == '\\' && splice_length(buf, i, size) != 0) {
+                i += splice_length(buf, i, size);
+            } else if (c == '/' && peek(1) == '*') {
+                flags |= C_TOKEN_SPACE_BEFORE;
+                if (skip_block_comment()) {
+                    flags |= C_TOKEN_LINE_START;
+                }
+            } else if (c == '/' && peek(1) == '/') {
+                flags |= C_TOKEN_SPACE_BEFORE;
+                skip_line_comment();
+            } else {
+                return flags;
+            }
+        }
+    }
+
+    /**
+     * @brief Skips a block comment starting at `i`.
+     *
+     * @return Whether the comment spans a newline.
+     */
+    bool
+    skip_block_comment() {
+        const ca_size_t start = i;
+        const bytes_stop stop{ '*', '\n', '\n' };
+        bool newline = false;
+        ca_size_t p = i + 2;
+        for (;;) {
+            p = scan(stop, buf, p, size);
+            if (p >= size) {
+                break;
+            }
+            if (buf[p] == '\n') {
+                newline = true;
+                ++p;
+            } else if (p + 1 < size && buf[p + 1] == '/') {
+                p += 2;
+                break;
+            } else {
+                ++p;
+            }
+        }
+        i = p;
+        comment_bytes += i - start;
+        return newline;
+    }
+
+    /**
+     * @brief Skips a line comment starting at `i`, leaving `i` at its `\n`.
+     */
+    void
+    skip_line_comment() {
+        const ca_size_t start = i;
+        const bytes_stop stop{ '\n', '\\', '\\' };
+        ca_size_t p = i + 2;
+        for (;;) {
+            p = scan(stop, buf, p, size);
+            if (p >= size || buf[p] == '\n') {
+                break;
+            }
+            p += splice_length(buf, p, size) != 0 ? splice_length(buf, p, size) : 1;
+        }
+        i = p;
+        comment_bytes += i - start;
+    }
+
+    /**
+     * @brief Finds the end of a character constant or string literal whose
+     *        opening quote is at `p`.
+     *
+     * @return The index after the closing quote, or the index of the `\n`
+     *         or end of buffer ending an unterminated literal.
+     * @param terminated [out] Whether the closing quote was found.
+     */
+    ca_size_t
+    literal_end(ca_size_t p, bool *terminated) const {
+        const ca_char_t quote = buf[p];
+        const bytes_stop stop{ quote, '\\', '\n' };
+        ++p;
+        for (;;) {
+            p = scan(stop, buf, p, size);
+            if (p >= size || buf[p] == '\n') {
+                *terminated = false;
+                return p;
+            }
+            if (buf[p] == quote) {
+                *terminated = true;
+                return p + 1;
+            }
+            // An escape, or a splice inside the literal; a `\` ending the
+            // buffer escapes nothing
+            p = std::min(p + (splice_length(buf, p, size) != 0 ? splice_length(buf, p, size) : 2), size);
+        }
+    }
+
+    /**
+     * @brief Finds the end of a preprocessing number starting at `i`.
+     */
+    ca_size_t
+    number_end() const {
+        ca_size_t p = i + 1;
+        while (p < size) {
+            const ca_char_t c = buf[p];
+            if (is_identifier_char(c) || c == '.') {
+                ++p;
+            } else if ((c == '+' || c == '-') &&
+                       ((buf[p - 1] | 0x20) == 'e' || (buf[p - 1] | 0x20) == 'p')) {
+                ++p;
+            } else if (c == '\'' && p + 1 < size && is_identifier_char(buf[p + 1])) {
+                p += 2;
+            } else {
+                break;
+            }
+        }
+        return p;
+    }
+
+    /**
+     * @brief Lexes the punctuator at `i`.
+     *
+     * @param length [out] Number of bytes of the punctuator.
+     * @return Its kind, or `TOKEN_UNKNOWN` for a byte that starts no token.
+     */
+    CTokenKind
+    punctuator(ca_size_t *length) const {
+        const ca_char_t c1 = peek(1);
+        const ca_char_t c2 = peek(2);
+        *length = 1;
+
+        const auto two = [length](const CTokenKind kind) {
+            *length = 2;
+            return kind;
+        };
+        const auto three = [length](const CTokenKind kind) {
+            *length = 3;
+            return kind;
+        };
+
+        switch (buf[i]) {
+        case '[': return CTokenKind::PUNCT_L_SQUARE;
+        case ']': return CTokenKind::PUNCT_R_SQUARE;
+        case '(': return CTokenKind::PUNCT_L_PAREN;
+        case ')': return CTokenKind::PUNCT_R_PAREN;
+        case '{': return CTokenKind::PUNCT_L_BRACE;
+        case '}': return CTokenKind::PUNCT_R_BRACE;
+        case '~': return CTokenKind::PUNCT_TILDE;
+        case '?': return CTokenKind::PUNCT_QUESTION;
+        case ';': return CTokenKind::PUNCT_SEMI;
+        case ',': return CTokenKind::PUNCT_COMMA;
+        case '.':
+            return c1 == '.' && c2 == '.' ? three(CTokenKind::PUNCT_ELLIPSIS) : CTokenKind::PUNCT_PERIOD;
+        case '-':
+            if (c1 == '>') return two(CTokenKind::PUNCT_ARROW);
+            if (c1 == '-') return two(CTokenKind::PUNCT_MINUS_MINUS);
+            if (c1 == '=') return two(CTokenKind::PUNCT_MINUS_EQUAL);
+            return CTokenKind::PUNCT_MINUS;
+        case '+':
+            if (c1 == '+') return two(CTokenKind::PUNCT_PLUS_PLUS);
+            if (c1 == '=') return two(CTokenKind::PUNCT_PLUS_EQUAL);
+            return CTokenKind::PUNCT_PLUS;
+        case '&':
+            if (c1 == '&') return two(CTokenKind::PUNCT_AMP_AMP);
+            if (c1 == '=') return two(CTokenKind::PUNCT_AMP_EQUAL);
+            return CTokenKind::PUNCT_AMP;
+        case '|':
+            if (c1 == '|') return two(CTokenKind::PUNCT_PIPE_PIPE);
+            if (c1 == '=') return two(CTokenKind::PUNCT_PIPE_EQUAL);
+            return CTokenKind::PUNCT_PIPE;
+        case '*':
+            return c1 == '=' ? two(CTokenKind::PUNCT_STAR_EQUAL) : CTokenKind::PUNCT_STAR;
+        case '/':
+            return c1 == '=' ? two(CTokenKind::PUNCT_SLASH_EQUAL) : CTokenKind::PUNCT_SLASH;
+        case '^':
+            return c1 == '=' ? two(CTokenKind::PUNCT_CARET_EQUAL) : CTokenKind::PUNCT_CARET;
+        case '!':
+            return c1 == '=' ? two(CTokenKind::PUNCT_EXCLAIM_EQUAL) : CTokenKind::PUNCT_EXCLAIM;
+        case '=':
+            return c1 == '=' ? two(CTokenKind::PUNCT_EQUAL_EQUAL) : CTokenKind::PUNCT_EQUAL;
+        case '#':
+            return c1 == '#' ? two(CTokenKind::PUNCT_HASH_HASH) : CTokenKind::PUNCT_HASH;
+        case ':':
+            if (c1 == ':') return two(CTokenKind::PUNCT_COLON_COLON);
+            if (c1 == '>') return two(CTokenKind::PUNCT_R_SQUARE);
+            return CTokenKind::PUNCT_COLON;
+        case '%':
+            if (c1 == '=') return two(CTokenKind::PUNCT_PERCENT_EQUAL);
+            if (c1 == '>') return two(CTokenKind::PUNCT_R_BRACE);
+            if (c1 == ':') {
+                if (c2 == '%' && peek(3) == ':') {
+                    *length = 4;
+                    return CTokenKind::PUNCT_HASH_HASH;
+                }
+                return two(CTokenKind::PUNCT_HASH);
+            }
+            return CTokenKind::PUNCT_PERCENT;
+        case '<':
+            if (c1 == '<') return c2 == '=' ? three(CTokenKind::PUNCT_LESS_LESS_EQUAL) : two(CTokenKind::PUNCT_LESS_LESS);
+            if (c1 == '=') return two(CTokenKind::PUNCT_LESS_EQUAL);
+            if (c1 == ':') return two(CTokenKind::PUNCT_L_SQUARE);
+            if (c1 == '%') return two(CTokenKind::PUNCT_L_BRACE);
+            return CTokenKind::PUNCT_LESS;
+        case '>':
+            if (c1 == '>') {
+                return c2 == '=' ? three(CTokenKind::PUNCT_GREATER_GREATER_EQUAL)
+                                 : two(CTokenKind::PUNCT_GREATER_GREATER);
+            }
+            if (c1 == '=') return two(CTokenKind::PUNCT_GREATER_EQUAL);
+            return CTokenKind::PUNCT_GREATER;
+        default:
+            return CTokenKind::TOKEN_UNKNOWN;
+        }
+    }
+};
+
+/**
+ * @brief Checks if `buf[start, end)` is an encoding prefix of a literal.
+ */
+bool
+is_literal_prefix(const ca_char_t *buf, const ca_size_t start, const ca_size_t end) {
+    const ca_size_t length = end - start;
+    if (length == 1) {
+        return buf[start] == 'L' || buf[start] == 'u' || buf[start] == 'U';
+    }
+    return length == 2 && buf[start] == 'u' && buf[start + 1] == '8';
+}
+
+/**
+ * @brief Checks if only blanks separate `p` from the start of its line.
+ *
+ * @param boundary An offset known to start a line, such as the end of a
+ *                 comment spanning a newline; the search stops there.
+ */
+bool
+starts_line(const ca_char_t *buf, ca_size_t p, const ca_size_t boundary) {
+    while (p > boundary && is_blank(buf[p - 1])) {
+        --p;
+    }
+    if (p == boundary) {
+        return true;
+    }
+    if (buf[p - 1] != '\n') {
+        return false;
+    }
+    // A spliced newline does not end the line
+    return !(p >= 2 && buf[p - 2] == '\\') && !(p >= 3 && buf[p - 2] == '\r' && buf[p - 3] == '\\');
+}
+
+/**
+ * @brief Checks if `p` is inside a character constant or string literal
+ *        opened in `buf[from, p)`.
+ */
+bool
+in_literal(const ca_char_t *buf, const ca_size_t from, const ca_size_t p) {
+    ca_char_t quote = 0;
+    for (ca_size_t q = from; q < p; ++q) {
+        if (quote == 0) {
+            if (buf[q] == '"' || buf[q] == '\'') {
+                quote = buf[q];
+            }
+        } else if (buf[q] == '\\') {
+            ++q;
+        } else if (buf[q] == quote) {
+            quote = 0;
+        }
+    }
+    return quote != 0;
+}
+
+/**
+ * @brief Interns a C string.
+ */
+CTokenStream::id_type
+intern(ca_string::ca_intern_pool *pool, const char *text) {
+    return pool->intern(reinterpret_cast<const ca_char_t*>(text), std::strlen(text));
+}
+
+}
+
+CLexer::CLexer(ca_string::ca_intern_pool *pool)
+    : identifiers(pool), totals() {
+    assert(pool != nullptr);
+    for (ca_size_t k = 0; k < C_KEYWORD_COUNT; ++k) {
+        [[maybe_unused]] const CTokenStream::id_type id = intern(pool, C_KEYWORD_SPELLINGS[k]);
+        assert(id == k && "the pool must be empty or seeded by a CLexer");
+    }
+    include_id = intern(pool, "include");
+    include_next_id = intern(pool, "include_next");
+    embed_id = intern(pool, "embed");
+}
+
+int
+CLexer::lex(const ca_char_t *source, const ca_size_t size, CTokenStream *tokens) {
+    assert(source != nullptr || size == 0);
+    assert(tokens != nullptr);
+
+    tokens->clear();
+    if (size > CA_UINT32_MAX) {
+        return -1;
+    }
+    // Real-world C averages a token every 5 to 7 bytes
+    tokens->reserve(size / 6 + 16);
+    lex_from(source, size, 0, false, tokens);
+    ++totals.buffers;
+    return 0;
+}
+
+int
+CLexer::lex_section(const ca_char_t *source, const ca_size_t size, const ca_size_t offset, CTokenStream *tokens,
+                    ca_size_t *next) {
+    assert(source != nullptr || size == 0);
+    assert(tokens != nullptr && next != nullptr);
+    assert(offset <= size);
+
+    tokens->clear();
+    if (size > CA_UINT32_MAX) {
+        *next = size;
+        return -1;
+    }
+    *next = lex_from(source, size, offset, true, tokens);
+    return 0;
+}
+
+ca_size_t
+CLexer::lex_from(const ca_char_t *source, const ca_size_t size, const ca_size_t offset, const bool section,
+                 CTokenStream *tokens) {
+    static constexpr identifier_stop IDENTIFIER;
+    lexer_run run{ source, size, offset, 0 };
+    ca_uint8_t flags = C_TOKEN_LINE_START;
+    // 0: nothing, 1: after a line-initial `#`, 2: after `#include`
+    int directive = 0;
+    bool in_directive = false;
+
+    for (;;) {
+        flags = run.skip_trivia(flags);
+        if (run.i >= size || (section && in_directive && (flags & C_TOKEN_LINE_START) != 0)) {
+            break;
+        }
+
+        const ca_size_t start = run.i;
+        const ca_char_t c = source[start];
+        CTokenKind kind;
+        ca_size_t end;
+        CTokenStream::id_type id = ca_string::ca_intern_pool::INVALID_ID;
+
+        if (is_identifier_char(c) && static_cast<ca_char_t>(c - '0') >= 10) {
+            end = scan(IDENTIFIER, source, start + 1, size);
+            if (end < size && (source[end] == '"' || source[end] == '\'') && is_literal_prefix(source, start, end)) {
+                bool terminated;
+                kind = source[end] == '"' ? CTokenKind::TOKEN_STRING : CTokenKind::TOKEN_CHAR;
+                end = run.literal_end(end, &terminated);
+                if (!terminated) {
+                    kind = CTokenKind::TOKEN_UNKNOWN;
+                }
+            } else {
+                id = identifiers->intern(source + start, end - start);
+                kind = id < C_KEYWORD_COUNT
+                           ? static_cast<CTokenKind>(static_cast<ca_size_t>(CTokenKind::KEYWORD_FIRST) + id)
+                           : CTokenKind::TOKEN_IDENTIFIER;
+            }
+        } else if (static_cast<ca_char_t>(c - '0') < 10 ||
+                   (c == '.' && static_cast<ca_char_t>(run.peek(1) - '0') < 10)) {
+            kind = CTokenKind::TOKEN_NUMBER;
+            end = run.number_end();
+        } else if (c == '"' || c == '\'') {
+            bool terminated;
+            kind = c == '"' ? CTokenKind::TOKEN_STRING : CTokenKind::TOKEN_CHAR;
+            end = run.literal_end(start, &terminated);
+            if (!terminated) {
+                kind = CTokenKind::TOKEN_UNKNOWN;
+            }
+        } else {
+            end = size;
+            if (c == '<' && directive == 2) {
+                end = scan(bytes_stop{ '>', '\n', '\n' }, source, start + 1, size);
+            }
+            if (end < size && source[end] == '>') {
+                kind = CTokenKind::TOKEN_HEADER_NAME;
+                ++end;
+            } else {
+                ca_size_t length;
+                kind = run.punctuator(&length);
+                end = start + length;
+            }
+        }
+
+        tokens->push(kind, static_cast<ca_uint32_t>(start), static_cast<ca_uint32_t>(end - start), id, flags);
+        run.i = end;
+
+        if (kind == CTokenKind::PUNCT_HASH && (flags & C_TOKEN_LINE_START) != 0) {
+            directive = 1;
+            in_directive = true;
+        } else if (directive == 1 && (id == include_id || id == include_next_id || id == embed_id)) {
+            directive = 2;
+        } else {
+            directive = 0;
+        }
+        flags = 0;
+    }
+
+    const ca_size_t stop = std::min(run.i, size);
+    tokens->push(CTokenKind::TOKEN_END, static_cast<ca_uint32_t>(stop), 0, ca_string::ca_intern_pool::INVALID_ID,
+                 flags);
+
+    totals.bytes += stop - offset;
+    totals.tokens += tokens->size() - 1;
+    totals.comment_bytes += run.comment_bytes;
+    return stop;
+}
+
+ca_size_t
+CLexer::skip_group(const ca_char_t *source, const ca_size_t size, const ca_size_t offset) {
+    assert(source != nullptr || size == 0);
+    assert(offset <= size);
+
+    static constexpr identifier_stop IDENTIFIER;
+    // `%` for the `%:` digraph of `#`
+    static constexpr bytes_stop STOP{ '#', '/', '%' };
+    lexer_run run{ source, size, offset, 0 };
+    // Offsets known to start a line, and the end of the last comment
+    ca_size_t boundary = offset;
+    ca_size_t resume = offset;
+    ca_size_t depth = 0;
+    ca_size_t result = size;
+
+    while (run.i < size) {
+        const ca_size_t p = scan(STOP, source, run.i, size);
+        if (p >= size) {
+            break;
+        }
+        const ca_char_t next = p + 1 < size ? source[p + 1] : 0;
+
+        if (source[p] == '/') {
+            run.i = p + 1;
+            if (next != '*' && next != '/') {
+                continue;
+            }
+            // Literals only matter where they would hide a comment
+            ca_size_t line = p;
+            while (line > resume && source[line - 1] != '\n') {
+                --line;
+            }
+            if (in_literal(source, line, p)) {
+                continue;
+            }
+            run.i = p;
+            if (next == '*') {
+                const bool initial = starts_line(source, p, boundary);
+                if (run.skip_block_comment() || initial) {
+                    boundary = run.i;
+                }
+            } else {
+                run.skip_line_comment();
+            }
+            resume = run.i;
+            continue;
+        }
+
+        ca_size_t name = p + 1;
+        if (source[p] == '%') {
+            if (next != ':') {
+                run.i = p + 1;
+                continue;
+            }
+            name = p + 2;
+        }
+        run.i = name;
+        // `##` and `%:%:` start no directive
+        if ((name < size && (source[name] == '#' || source[name] == '%')) || !starts_line(source, p, boundary)) {
+            continue;
+        }
+
+        while (name < size && is_blank(source[name])) {
+            ++name;
+        }
+        const ca_size_t end = scan(IDENTIFIER, source, name, size);
+        run.i = end;
+        const std::string_view directive(reinterpret_cast<const char *>(source) + name, end - name);
+        if (directive == "if" || directive == "ifdef" || directive == "ifndef") {
+            ++depth;
+        } else if (directive == "endif" && depth != 0) {
+            --depth;
+        } else if (depth == 0 && (directive == "endif" || directive == "else" || directive == "elif" ||
+                                  directive == "elifdef" || directive == "elifndef")) {
+            result = p;
+            break;
+        }
+    }
+
+    return result;
+}
+
+}
@@ -0,0 +1,102 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/c/core/parser/CToken.cpp
+//
+// @file
+// @brief Implements the token kind tables and `CTokenStream`.
+// ================================
+
+#include "core/parser/CToken.h"
+
+#include <iterator>
+
+namespace ca::analyzers::c {
+
+const char *const C_KEYWORD_SPELLINGS[C_KEYWORD_COUNT] = {
+    "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum",
+    "extern", "float", "for", "goto", "if", "inline", "int", "long", "register", "restrict", "return",
+    "short", "signed", "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void",
+    "volatile", "while", "alignas", "alignof", "bool", "constexpr", "false", "nullptr", "static_assert",
+    "thread_local", "true", "typeof", "typeof_unqual", "_Alignas", "_Alignof", "_Atomic", "_BitInt",
+    "_Bool", "_Complex", "_Decimal128", "_Decimal32", "_Decimal64", "_Generic", "_Imaginary",
+    "_Noreturn", "_Static_assert", "_Thread_local",
+};
+
+namespace {
+
+/**
+ * @brief Names of the kinds before the keywords.
+ */
+constexpr const char *BASIC_NAMES[] = {
+    "end of file", "identifier", "number", "character constant", "string literal", "header name", "unknown",
+};
+
+/**
+ * @brief Spellings of the punctuators, in the order of their kinds.
+ */
+constexpr const char *PUNCTUATOR_SPELLINGS[] = {
+    "[", "]", "(", ")", "{", "}", ".", "->", "++", "--", "&", "*", "+", "-", "~", "!", "/", "%", "<<", ">>",
+    "<", ">", "<=", ">=", "==", "!=", "^", "|", "&&", "||", "?", ":", "::", ";", "...", "=", "*=", "/=",
+    "%=", "+=", "-=", "<<=", ">>=", "&=", "^=", "|=", ",", "#", "##",
+};
+
+static_assert(std::size(BASIC_NAMES) == static_cast<ca_size_t>(CTokenKind::KEYWORD_FIRST));
+static_assert(std::size(PUNCTUATOR_SPELLINGS) ==
+              static_cast<ca_size_t>(CTokenKind::PUNCT_HASH_HASH) - static_cast<ca_size_t>(CTokenKind::PUNCT_L_SQUARE) + 1);
+
+}
+
+const char *
+c_token_kind_name(const CTokenKind kind) {
+    const auto index = static_cast<ca_size_t>(kind);
+    if (kind < CTokenKind::KEYWORD_FIRST) {
+        return BASIC_NAMES[index];
+    }
+    if (c_is_keyword(kind)) {
+        return C_KEYWORD_SPELLINGS[index - static_cast<ca_size_t>(CTokenKind::KEYWORD_FIRST)];
+    }
+    return PUNCTUATOR_SPELLINGS[index - static_cast<ca_size_t>(CTokenKind::PUNCT_L_SQUARE)];
+}
+
+void
+CTokenStream::push(const CTokenKind kind, const ca_uint32_t offset, const ca_uint32_t length, const id_type id,
+                   const ca_uint8_t token_flags) {
+    if (length >= LONG_LENGTH) {
+        long_lengths.emplace(static_cast<ca_uint32_t>(kinds.size()), length);
+        lengths.push_back(LONG_LENGTH);
+    } else {
+        lengths.push_back(static_cast<ca_uint16_t>(length));
+    }
+    kinds.push_back(kind);
+    offsets.push_back(offset);
+    ids.push_back(id);
+    flags.push_back(token_flags);
+}
+
+void
+CTokenStream::reserve(const ca_size_t count) {
+    kinds.reserve(count);
+    offsets.reserve(count);
+    lengths.reserve(count);
+    ids.reserve(count);
+    flags.reserve(count);
+}
+
+void
+CTokenStream::clear() {
+    kinds.clear();
+    offsets.clear();
+    lengths.clear();
+    ids.clear();
+    flags.clear();
+    long_lengths.clear();
+}
+
+ca_size_t
+CTokenStream::memory_usage() const {
+    return kinds.capacity() * sizeof(CTokenKind) + offsets.capacity() * sizeof(ca_uint32_t) +
+           lengths.capacity() * sizeof(ca_uint16_t) + ids.capacity() * sizeof(id_type) +
+           flags.capacity() * sizeof(ca_uint8_t) +
+           long_lengths.size() * (sizeof(ca_uint32_t) * 2 + sizeof(void *) * 2);
+}
+
+}
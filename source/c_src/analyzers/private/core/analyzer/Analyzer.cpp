@@ -1,3 +1,157 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/core/analyzer/Analyzer.cpp
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Implements the `Analyzer` driver.
+// ================================
+
+#include "analyzer/Analyzer.h"
+#include "ca_parallel.h"
+#include "ca_task_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <numeric>
+#include <system_error>
+#include <utility>
+
+#ifdef CA_ENABLE_THREADING
+#include <thread>
+#endif
+
+namespace ca::analyzers {
+
+namespace {
+
+/**
+ * @brief Returns the nanoseconds elapsed since `start`.
+ */
+ca_uint64_t
+elapsed_ns(const std::chrono::steady_clock::time_point start) {
+    return static_cast<ca_uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+}
+
+/**
+ * @struct Analyzer::Worker
+ * @brief The state of one worker, kept across runs.
+ */
+struct Analyzer::Worker {
+    explicit Worker(const ca_size_t index) : context(index) {}
+
+    std::unique_ptr<IAnalyzer> analyzer;    ///< Made on the first run.
+    AnalysisContext context;                ///< Context of the worker.
+
+    ca_size_t units = 0;                    ///< Units done in the current run.
+    ca_size_t failures = 0;                 ///< Units failed in the current run.
+    ca_uint64_t bytes = 0;                  ///< Bytes analyzed in the current run.
+    ca_uint64_t avoided_reads = 0;          ///< Header reads avoided in the current run.
+    ca_uint64_t busy_ns = 0;                ///< Time spent in units in the current run.
+};
+
+Analyzer::Analyzer(factory_type factory, const AnalyzerOptions &options)
+    : make_analyzer(std::move(factory)), options(options), last_stats() {
+    ca_size_t count = 1;
+#ifdef CA_ENABLE_THREADING
+    count = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+#endif
+    workers.reserve(count);
+    for (ca_size_t i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>(i));
+    }
+    if (count > 1) {
+        ca_task::ca_task_pool_options pool_options;
+        pool_options.threads = count - 1;
+        pool_options.pin_threads = options.pin_threads;
+        pool = std::make_unique<ca_task::ca_task_pool>(pool_options);
+    }
+}
+
+Analyzer::~Analyzer() = default;
+
+int
+Analyzer::run(const std::span<const std::string> files, AnalysisResultSink *sink) {
+    assert(sink != nullptr);
+    if (sink->capacity() - sink->size() < files.size() || files.size() > 0xFFFFFFFF) {
+        return -1;
+    }
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<ca_uint32_t> order(files.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (options.largest_first) {
+        std::vector<ca_uint64_t> sizes(files.size());
+        for (ca_size_t i = 0; i < files.size(); ++i) {
+            std::error_code error;
+            const auto size = std::filesystem::file_size(files[i], error);
+            sizes[i] = error ? 0 : static_cast<ca_uint64_t>(size);
+        }
+        std::stable_sort(order.begin(), order.end(), [&sizes](const ca_uint32_t a, const ca_uint32_t b) {
+            return sizes[a] > sizes[b];
+        });
+    }
+    for (const auto &worker : workers) {
+        worker->units = worker->failures = 0;
+        worker->bytes = worker->avoided_reads = worker->busy_ns = 0;
+    }
+
+    const auto work = [this, files, sink, &order](const ca_size_t begin, const ca_size_t end) {
+        // Pool worker `i` is driver worker `i + 1`, the calling thread is 0
+        const ca_size_t index = pool ? pool->worker_index() : ca_task::ca_task_pool::NOT_A_WORKER;
+        const ca_size_t w = index == ca_task::ca_task_pool::NOT_A_WORKER ? 0 : index + 1;
+        Worker &worker = *workers[w];
+        if (!worker.analyzer) {
+            worker.analyzer = make_analyzer(w);
+        }
+        for (ca_size_t i = begin; i < end; ++i) {
+            const ca_uint32_t unit = order[i];
+            const auto unit_start = std::chrono::steady_clock::now();
+            worker.context.begin_unit();
+            AnalysisResult result;
+            result.path = files[unit];
+            result.unit = unit;
+            result.worker = w;
+            result.status = worker.analyzer->analyze(files[unit], worker.context, &result);
+            result.nanoseconds = elapsed_ns(unit_start);
+
+            ++worker.units;
+            worker.failures += result.status != 0;
+            worker.bytes += result.bytes;
+            worker.avoided_reads += result.avoided_reads;
+            worker.busy_ns += result.nanoseconds;
+            const int pushed = sink->push(std::move(result));
+            assert(pushed == 0);
+            (void)pushed;
+        }
+    };
+
+    // One unit per range: units are large enough that splitting finer than
+    // the files only costs a queue operation each
+    ca_uint64_t stolen = 0;
+    if (pool) {
+        stolen = pool->stats().stolen;
+        ca_task::ca_parallel_for(*pool, 0, order.size(), 1, work);
+        stolen = pool->stats().stolen - stolen;
+    } else {
+        work(0, order.size());
+    }
+
+    last_stats = {};
+    last_stats.threads = workers.size();
+    last_stats.steals = static_cast<ca_size_t>(stolen);
+    for (const auto &worker : workers) {
+        last_stats.units += worker->units;
+        last_stats.failures += worker->failures;
+        last_stats.bytes += worker->bytes;
+        last_stats.avoided_reads += worker->avoided_reads;
+        last_stats.busy_nanoseconds += worker->busy_ns;
+    }
+    last_stats.nanoseconds = elapsed_ns(start);
+    return last_stats.failures == 0 ? 0 : -1;
+}
+
+}
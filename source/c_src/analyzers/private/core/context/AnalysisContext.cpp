@@ -1,3 +1,21 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/core/context/AnalysisContext.cpp
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Implements `AnalysisContext`.
+// ================================
+
+#include "context/AnalysisContext.h"
+
+namespace ca::analyzers {
+
+AnalysisContext::AnalysisContext(const ca_size_t worker)
+    : index(worker), num_units(0), resource(scratch) {}
+
+void
+AnalysisContext::begin_unit() {
+    ++num_units;
+    scratch.reset();
+}
+
+}
@@ -0,0 +1,56 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/private/core/report/AnalysisResult.cpp
+//
+// @file
+// @brief Implements `AnalysisResultSink`.
+// ================================
+
+#include "report/AnalysisResult.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace ca::analyzers {
+
+AnalysisResultSink::AnalysisResultSink(const ca_size_t capacity)
+    : num_slots(capacity), slots(std::make_unique<Slot[]>(capacity)), claimed(0) {}
+
+int
+AnalysisResultSink::push(AnalysisResult &&result) {
+    const ca_size_t index = claimed.fetch_add(1, std::memory_order_relaxed);
+    if (index >= num_slots) {
+        return -1;
+    }
+    slots[index].result = std::move(result);
+    slots[index].published.store(true, std::memory_order_release);
+    return 0;
+}
+
+ca_size_t
+AnalysisResultSink::size() const {
+    return std::min(claimed.load(std::memory_order_relaxed), num_slots);
+}
+
+bool
+AnalysisResultSink::ready(const ca_size_t index) const {
+    return index < num_slots && slots[index].published.load(std::memory_order_acquire);
+}
+
+const AnalysisResult &
+AnalysisResultSink::operator[](const ca_size_t index) const {
+    assert(ready(index));
+    return slots[index].result;
+}
+
+void
+AnalysisResultSink::clear() {
+    const ca_size_t count = size();
+    for (ca_size_t i = 0; i < count; ++i) {
+        slots[i].result = AnalysisResult();
+        slots[i].published.store(false, std::memory_order_relaxed);
+    }
+    claimed.store(0, std::memory_order_relaxed);
+}
+
+}
@@ -6,10 +6,38 @@
 #ifndef IANALYZER_H
 #define IANALYZER_H
 
-//class IAnalyzer {
-//public:
-//    virtual ~IAnalyzer() = default;
-//    virtual void analyze(const std::string& filepath) = 0;
-//};
+#include <string>
+
+namespace ca::analyzers {
+
+class AnalysisContext;
+struct AnalysisResult;
+
+/**
+ * @class IAnalyzer
+ * @brief Analyzes one translation unit at a time.
+ *
+ * The driver creates one analyzer per worker thread, so an analyzer may keep
+ * and reuse state between units without locking.
+ */
+class IAnalyzer {
+public:
+    virtual ~IAnalyzer() = default;
+
+    /**
+     * @brief Analyzes one translation unit.
+     *
+     * @param filepath [in] Path of the unit.
+     * @param context [in,out] The context of the calling worker.
+     * @param result [out] Receives the result; `path` and `worker` are set by the caller.
+     * @return
+     * - `0` on success.
+     * - `-1` if the unit could not be analyzed; `result->error` tells why.
+     */
+    virtual int
+    analyze(const std::string &filepath, AnalysisContext &context, AnalysisResult *result) = 0;
+};
+
+}
 
 #endif //IANALYZER_H
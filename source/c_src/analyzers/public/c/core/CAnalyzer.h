@@ -1,45 +1,149 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/c/core/CAnalyzer.h
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Defines `CAnalyzer`, which runs the nine-stage C analysis
+//        pipeline on one translation unit at a time.
+// ================================
 
 #ifndef CANALYZER_H
 #define CANALYZER_H
 
-//void CAnalyzer::analyze(const std::string& filepath) {
-//    // 1. AST 构建
-//    auto ast = CASTBuilder::build(filepath);
-//
-//    // 2. 头文件分析
-//    CIncludeAnalyzer::analyze(filepath);
-//    CIncludeGraphBuilder::build(ast);
-//
-//    // 3. 宏分析
-//    CMacroAnalyzer::scan(ast);
-//    CMacroExpansionEngine::expand(ast);
-//
-//    // 4. 构建符号表
-//    auto symbols = CSymbolResolver::resolve(ast);
-//
-//    // 5. 类型检查
-//    CTypeChecker::check(ast, symbols);
-//
-//    // 6. 控制流构建 + 流分析
-//    auto cfg = CCFGBuilder::build(ast);
-//    CDataFlowAnalyzer::analyze(cfg);
-//    CLivenessAnalyzer::analyze(cfg);
-//
-//    // 7. 语义 + 结构分析
-//    CSemanticChecker::check(ast, symbols);
-//    CReturnChecker::check(ast);
-//    CUnreachableCodeDetector::analyze(cfg);
-//
-//    // 8. 内存 & 指针分析
-//    CMemoryLeakAnalyzer::scan(ast);
-//    CPointerSafetyAnalyzer::check(ast, symbols);
-//
-//    // 9. 风格 & 危险 API
-//    CStyleChecker::check(ast);
-//    CUnsafeFunctionChecker::check(ast);
-//}
+#include "IAnalyzer.h"
+#include "context/AnalysisContext.h"
+#include "core/include/CIncludeAnalyzer.h"
+#include "core/parser/CASTBuilder.h"
+#include "core/rw/ca_io_file_rw_sync.h"
+#include "report/AnalysisResult.h"
+#include "ca_intern_pool.h"
+#include "ca_math.h"
+
+#include <array>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ca::analyzers::c {
+
+/**
+ * @enum CAnalysisStage
+ * @brief The stages of the C pipeline, in the order they run.
+ */
+enum class CAnalysisStage : ca_uint8_t {
+    STAGE_AST,          ///< 1. AST building (`CASTBuilder`).
+    STAGE_INCLUDES,     ///< 2. Header analysis (`CIncludeAnalyzer`, `CIncludeGraphBuilder`).
+    STAGE_MACROS,       ///< 3. Macro analysis (`CMacroAnalyzer`, `CMacroExpansionEngine`).
+    STAGE_SYMBOLS,      ///< 4. Symbol table (`CSymbolResolver`).
+    STAGE_TYPES,        ///< 5. Type checking (`CTypeChecker`).
+    STAGE_FLOW,         ///< 6. Control flow and data flow (`CCFGBuilder`, `CDataFlowAnalyzer`, `CLivenessAnalyzer`).
+    STAGE_SEMANTICS,    ///< 7. Semantics and structure (`CSemanticChecker`, `CReturnChecker`, `CUnreachableCodeDetector`).
+    STAGE_MEMORY,       ///< 8. Memory and pointers (`CMemoryLeakAnalyzer`, `CPointerSafetyAnalyzer`).
+    STAGE_STYLE,        ///< 9. Style and dangerous APIs (`CStyleChecker`, `CUnsafeFunctionChecker`).
+};
+
+/**
+ * @brief Number of stages of the C pipeline.
+ */
+inline constexpr ca_size_t C_ANALYSIS_STAGE_COUNT = static_cast<ca_size_t>(CAnalysisStage::STAGE_STYLE) + 1;
+
+/**
+ * @typedef CAnalysisPass
+ * @brief A pass of a stage: reads the tree of the unit, may allocate in the
+ *        context and adds to the counters of the result.
+ */
+typedef std::function<void(const CAst &, AnalysisContext &, AnalysisResult &)> CAnalysisPass;
+
+/**
+ * @class CAnalyzer
+ * @brief Analyzes C translation units through the nine-stage pipeline.
+ *
+ * A unit is loaded with `ca_file_read` and parsed into a syntax tree, then
+ * the passes of each stage run over the tree, stage by stage. Stage 1 is
+ * the parser itself, and its passes run right after it; stage 2 starts with
+ * `CIncludeAnalyzer` following the includes of the unit. The components of
+ * the other stages register their passes as they come.
+ *
+ * The analyzer owns its intern pool, builder, tree and header cache and
+ * reuses them for every unit, so it is meant to be used by one worker of an
+ * `Analyzer`:
+ *
+ * @code
+ * Analyzer driver([](ca_size_t) { return std::make_unique<CAnalyzer>(); });
+ * @endcode
+ */
+class CAnalyzer : public IAnalyzer {
+public:
+    /**
+     * @brief Constructs an analyzer with no passes.
+     *
+     * @param read_options Options of the loads.
+     * @param include_options Search paths and predefined macros of the units.
+     */
+    explicit CAnalyzer(const ca_io::ca_file_read_options &read_options = {},
+                       const CIncludeOptions &include_options = {});
+
+    /**
+     * @brief Adds a pass to a stage, after the passes already there.
+     */
+    void
+    add_pass(CAnalysisStage stage, CAnalysisPass pass);
+
+    int
+    analyze(const std::string &filepath, AnalysisContext &context, AnalysisResult *result) override;
+
+    /**
+     * @brief Returns the tree of the last unit analyzed.
+     */
+    [[nodiscard]] const CAst &
+    ast() const {
+        return tree;
+    }
+
+    /**
+     * @brief Returns the contents of the last unit analyzed, which the token
+     *        offsets of the tree refer to.
+     */
+    [[nodiscard]] const ca_io::ca_file_view &
+    text() const {
+        return source;
+    }
+
+    /**
+     * @brief Returns the builder, whose stats cover every unit analyzed.
+     */
+    [[nodiscard]] const CASTBuilder &
+    builder() const {
+        return parser;
+    }
+
+    /**
+     * @brief Returns the include analyzer, whose stats and graph cover every
+     *        unit analyzed.
+     */
+    [[nodiscard]] const CIncludeAnalyzer &
+    include_analyzer() const {
+        return includes;
+    }
+
+    /**
+     * @brief Returns the includes of the last unit analyzed.
+     */
+    [[nodiscard]] const CIncludeUnit &
+    unit_includes() const {
+        return inclusions;
+    }
+
+private:
+    ca_io::ca_file_read_options options;                                    ///< Options of the loads.
+    ca_string::ca_intern_pool pool;                                         ///< Identifiers of every unit.
+    CASTBuilder parser;                                                     ///< The parser.
+    CAst tree;                                                              ///< Tree of the current unit.
+    CIncludeAnalyzer includes;                                              ///< Headers of the units.
+    CIncludeUnit inclusions;                                                ///< Includes of the current unit.
+    ca_io::ca_file_view source;                                             ///< Contents of the current unit.
+    std::array<std::vector<CAnalysisPass>, C_ANALYSIS_STAGE_COUNT> passes;  ///< Passes of each stage.
+};
+
+}
 
 #endif //CANALYZER_H
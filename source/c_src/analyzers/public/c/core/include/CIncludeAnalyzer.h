@@ -1,8 +1,304 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/c/core/include/CIncludeAnalyzer.h
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Defines `CIncludeAnalyzer`, which follows the includes of a unit
+//        and caches what each header contributes under a macro state.
+// ================================
 
 #ifndef CINCLUDEANALYZER_H
 #define CINCLUDEANALYZER_H
 
+#include "CIncludeGraphBuilder.h"
+#include "core/macro/CMacroAnalyzer.h"
+#include "core/parser/CLexer.h"
+#include "core/rw/ca_io_file_rw_sync.h"
+#include "ca_intern_pool.h"
+#include "ca_math.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ca::analyzers::c {
+
+/**
+ * @struct CIncludeOptions
+ * @brief Options of a `CIncludeAnalyzer`.
+ */
+struct CIncludeOptions {
+    std::vector<std::string> search_paths;      ///< Directories searched for headers, in order.
+    std::vector<std::string> defines;           ///< Predefined macros, `NAME` or `NAME=BODY` as for `-D`.
+    ca_size_t max_depth = 200;                  ///< Deepest nesting of includes followed.
+};
+
+/**
+ * @struct CIncludeStats
+ * @brief Totals accumulated by a `CIncludeAnalyzer`.
+ */
+struct CIncludeStats {
+    ca_uint64_t units;              ///< Units analyzed.
+    ca_uint64_t includes;           ///< Include directives in active regions.
+    ca_uint64_t unresolved;         ///< Includes of files not found or not readable.
+    ca_uint64_t files_read;         ///< Headers read, once each.
+    ca_uint64_t bytes_read;         ///< Bytes of those headers.
+    ca_uint64_t bytes_lexed;        ///< Bytes of headers lexed by the walks.
+    ca_uint64_t bytes_skipped;      ///< Bytes of header groups not compiled, jumped over without being lexed.
+    ca_uint64_t unit_bytes_jumped;  ///< Bytes of unit groups not compiled, lexed with the unit but whose tokens were jumped over.
+    ca_uint64_t headers_walked;     ///< Inclusions processed directive by directive.
+    ca_uint64_t cache_hits;         ///< Inclusions served by a cached summary.
+    ca_uint64_t avoided_reads;      ///< Includes skipped because the header's guard was defined.
+    ca_uint64_t errors;             ///< Malformed directives, unbalanced conditionals and too deep includes.
+};
+
+/**
+ * @struct CIncludeUnit
+ * @brief What the includes of one unit amount to.
+ */
+struct CIncludeUnit {
+    ca_io::ca_path_id file = ca_io::ca_path_table::INVALID_ID;     ///< The unit.
+    std::vector<ca_io::ca_path_id> headers;                         ///< Headers entered, each once, in the order first entered.
+    std::vector<CTokenStream::id_type> declarations;                ///< Names declared by the unit and its headers, sorted.
+    ca_size_t includes = 0;                                         ///< Include directives in active regions.
+    ca_size_t unresolved = 0;                                       ///< Includes of files not found or not readable.
+    ca_size_t cache_hits = 0;                                       ///< Inclusions served by a cached summary.
+    ca_size_t avoided_reads = 0;                                    ///< Includes skipped because the header's guard was defined.
+    ca_size_t errors = 0;                                           ///< As in `CIncludeStats`.
+};
+
+/**
+ * @class CIncludeAnalyzer
+ * @brief Walks the directives of a unit and of the headers it includes.
+ *
+ * The walk feeds `CMacroAnalyzer` with every directive, follows the
+ * includes of active regions through `CIncludeGraphBuilder`, and collects
+ * the names declared at file scope in active regions (an identifier
+ * followed by `(`, `;`, `=`, `[` or `,` outside braces and parentheses).
+ *
+ * Headers are lexed by the walk a section at a time, up to the next
+ * directive, and a group that is not compiled is jumped over with
+ * `CLexer::skip_group` without being lexed. The unit comes already lexed,
+ * so its walk uses the same scan to jump over the tokens of such groups.
+ *
+ * Units mostly include the same headers under the same macros, so the
+ * analyzer caches at two levels:
+ * - each header is read once, and its text is kept;
+ * - each inclusion of a header records the macros it tested before
+ *   defining them, and its summary (macro effects, nested inclusions and
+ *   declarations) is kept as a variant keyed by the signature of those
+ *   macros. A later inclusion whose macro table gives the same signature
+ *   replays the variant instead of walking the header again.
+ *
+ * Headers whose walk had errors are not cached, and a header keeps at most
+ * `MAX_VARIANTS` variants. `__has_include` in a condition resolves its
+ * operand as an include of the file being walked would, so its answer is
+ * the same whenever the header is walked.
+ *
+ * Before either, an include of a guarded header is skipped when the guard
+ * is defined. The guard is found when the header is first loaded: an
+ * `#ifndef X` or `#if !defined(X)` opening the header, `#define X` right
+ * after it and the matching `#endif` closing it; or a `#pragma once` in an
+ * active region, which defines a marker macro when the header is entered.
+ * Guards are kept in the graph, and testing them is recorded like any
+ * other macro lookup, so skips stay correct in cached variants.
+ *
+ * Token ids refer to the pool of the analyzer, so the caches are tied to it
+ * and an analyzer is meant to live as long as the `CAnalyzer` of a worker.
+ *
+ * @note An analyzer is not thread-safe; use one per thread.
+ */
+class CIncludeAnalyzer {
+public:
+    /**
+     * @brief Maximum number of cached variants per header.
+     */
+    static constexpr ca_size_t MAX_VARIANTS = 16;
+
+    /**
+     * @brief Constructs an analyzer with empty caches.
+     *
+     * @param pool [in] The pool of the lexer of the units. Must not be
+     *             `nullptr` and must outlive the analyzer.
+     * @param options Search paths, predefined macros and limits.
+     * @param read_options Options of the header loads.
+     */
+    explicit CIncludeAnalyzer(ca_string::ca_intern_pool *pool, const CIncludeOptions &options = {},
+                              const ca_io::ca_file_read_options &read_options = {});
+
+    CIncludeAnalyzer(const CIncludeAnalyzer &) = delete;
+    CIncludeAnalyzer &operator=(const CIncludeAnalyzer &) = delete;
+
+    /**
+     * @brief Analyzes the includes of a unit, starting from the predefined
+     *        macros.
+     *
+     * @param path [in] Path of the unit, which quoted includes are relative to.
+     * @param source [in] The contents of the unit.
+     * @param tokens [in] Its tokens, lexed in the pool of the analyzer.
+     * @param unit [out] The result. Must not be `nullptr`.
+     */
+    void
+    analyze(std::string_view path, const ca_string::ca_char_t *source, const CTokenStream &tokens,
+            CIncludeUnit *unit);
+
+    /**
+     * @brief Returns the graph of every unit analyzed so far.
+     */
+    [[nodiscard]] const CIncludeGraphBuilder &
+    graph() const {
+        return includes;
+    }
+
+    /**
+     * @brief Returns the macro analyzer, holding the table at the end of
+     *        the last unit.
+     */
+    [[nodiscard]] const CMacroAnalyzer &
+    macros() const {
+        return macro_table;
+    }
+
+    /**
+     * @brief Returns the totals so far.
+     */
+    [[nodiscard]] const CIncludeStats &
+    stats() const {
+        return totals;
+    }
+
+    /**
+     * @brief Drops the cached headers, such as after they changed on disk.
+     */
+    void
+    clear();
+
+private:
+    struct header;
+
+    /**
+     * @struct inclusion
+     * @brief An include followed during a walk.
+     */
+    struct inclusion {
+        ca_io::ca_path_id file;     ///< The included file.
+        const header *target;       ///< Its cache entry.
+        ca_size_t variant;          ///< The variant it amounted to.
+    };
+
+    /**
+     * @struct summary
+     * @brief What one inclusion of a header contributes, besides macros.
+     */
+    struct summary {
+        std::vector<inclusion> inclusions;                  ///< Includes followed, in order.
+        std::vector<CTokenStream::id_type> declarations;    ///< Names declared by the header itself.
+        ca_size_t includes = 0;                             ///< Include directives in active regions.
+        ca_size_t unresolved = 0;                           ///< Includes not found or not readable.
+        ca_size_t avoided_reads = 0;                        ///< Includes skipped by a guard.
+        ca_size_t errors = 0;                               ///< Errors of the header itself.
+        bool cacheable = true;                              ///< Whether the walk can be replayed.
+    };
+
+    /**
+     * @struct variant
+     * @brief A cached inclusion of a header.
+     */
+    struct variant {
+        CMacroRecording macros;     ///< What it tested and changed.
+        summary contents;           ///< What it contributed.
+    };
+
+    /**
+     * @struct header
+     * @brief The cache entry of a header.
+     */
+    struct header {
+        ca_io::ca_file_view text;           ///< The contents.
+        bool readable = false;              ///< Whether the header was read.
+        std::vector<variant> variants;      ///< The cached inclusions.
+    };
+
+    /**
+     * @brief Walks the directives and declarations of a buffer.
+     *
+     * @param file The file being walked.
+     * @param source The contents of the file.
+     * @param size Their size in bytes.
+     * @param tokens Its tokens, or `nullptr` to lex it section by section.
+     * @param depth Nesting of the file, 0 for the unit.
+     * @param out [out] Receives what the walk contributes.
+     */
+    void
+    walk(ca_io::ca_path_id file, const ca_string::ca_char_t *source, ca_size_t size, const CTokenStream *tokens,
+         ca_size_t depth, summary *out);
+
+    /**
+     * @brief Follows an include directive.
+     */
+    void
+    include(ca_io::ca_path_id file, const ca_string::ca_char_t *source, const CTokenStream &tokens,
+            CDirectiveKind kind, ca_size_t first, ca_size_t last, ca_size_t depth, summary *out);
+
+    /**
+     * @brief Returns the cache entry of a header, reading it on first use.
+     */
+    header &
+    load(ca_io::ca_path_id file);
+
+    /**
+     * @brief Finds the include guard of a header from its text.
+     */
+    [[nodiscard]] CIncludeGuard
+    find_guard(const ca_string::ca_char_t *source, ca_size_t size);
+
+    /**
+     * @brief Tells whether the known guard of a header is defined.
+     *
+     * The lookup is recorded, so the variants of the includers depend on it.
+     */
+    [[nodiscard]] bool
+    guarded(ca_io::ca_path_id file);
+
+    /**
+     * @brief Handles a `#pragma once` in an active region of a file.
+     */
+    void
+    pragma_once(ca_io::ca_path_id file);
+
+    /**
+     * @brief Adds an inclusion replayed from the cache to the unit.
+     */
+    void
+    gather(const inclusion &entry);
+
+    /**
+     * @brief Adds a contribution to the unit.
+     */
+    void
+    collect(const summary &contents);
+
+    ca_io::ca_file_read_options read_options;                   ///< Options of the loads.
+    ca_size_t max_depth;                                        ///< Deepest nesting followed.
+    CLexer lexer;                                               ///< Lexer of the headers.
+    CMacroAnalyzer macro_table;                                 ///< Macros and conditionals.
+    CIncludeGraphBuilder includes;                              ///< Resolutions, edges and guards.
+    CTokenStream::id_type once_id;                              ///< Id of `once`.
+    CTokenStream::id_type defined_id;                           ///< Id of `defined`.
+    std::string predefined_source;                              ///< The predefined macros as directives.
+    CTokenStream predefined;                                    ///< Their tokens.
+    std::unordered_map<ca_io::ca_path_id, std::unique_ptr<header>> headers;    ///< Cached headers.
+    std::deque<CTokenStream> sections;                          ///< Section being walked, by depth.
+    CTokenStream guard_tokens;                                  ///< Sections read to find a guard.
+    CIncludeUnit *current;                                      ///< The unit being analyzed.
+    ca_io::ca_path_id probing;                                  ///< File of the directive being processed.
+    std::unordered_set<ca_io::ca_path_id> entered;              ///< Headers of the unit so far.
+    CIncludeStats totals;                                       ///< Totals so far.
+};
+
+}
+
 #endif //CINCLUDEANALYZER_H
@@ -1,8 +1,181 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/c/core/include/CIncludeGraphBuilder.h
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Defines `CIncludeGraphBuilder`, which resolves `#include`
+//        operands to files and records who includes whom.
+// ================================
 
 #ifndef CINCLUDEGRAPHBUILDER_H
 #define CINCLUDEGRAPHBUILDER_H
 
+#include "core/ca_io_path.h"
+#include "ca_intern_pool.h"
+#include "ca_math.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ca::analyzers::c {
+
+/**
+ * @enum CIncludeGuardKind
+ * @brief How a header protects itself against being included twice.
+ */
+enum class CIncludeGuardKind : ca_uint8_t {
+    GUARD_UNKNOWN,          ///< The header was not read yet.
+    GUARD_NONE,             ///< The header has no guard.
+    GUARD_MACRO,            ///< `#ifndef X` / `#define X` ... `#endif` around the whole header.
+    GUARD_PRAGMA_ONCE,      ///< `#pragma once`.
+};
+
+/**
+ * @struct CIncludeGuard
+ * @brief The guard of a header.
+ *
+ * A header whose guard macro is defined would expand to nothing, so the
+ * include can be skipped without reading it. For `#pragma once` the macro
+ * is a marker defined when a unit enters the header.
+ */
+struct CIncludeGuard {
+    CIncludeGuardKind kind = CIncludeGuardKind::GUARD_UNKNOWN;                  ///< Kind of guard.
+    ca_string::ca_intern_pool::id_type macro = ca_string::ca_intern_pool::INVALID_ID;  ///< The guard macro or marker.
+};
+
+/**
+ * @struct CIncludeGraphStats
+ * @brief Totals accumulated by a `CIncludeGraphBuilder`.
+ */
+struct CIncludeGraphStats {
+    ca_uint64_t resolutions;        ///< Operands resolved, found or not.
+    ca_uint64_t cached;             ///< Resolutions answered without touching the file system.
+    ca_uint64_t probes;             ///< Candidate paths checked on the file system.
+};
+
+/**
+ * @class CIncludeGraphBuilder
+ * @brief Resolves includes and builds the include graph of the analyzed
+ *        units.
+ *
+ * Files are identified by their id in a `ca_path_table`, so a header reached
+ * through different spellings of its path is one node. A quoted include is
+ * looked up next to its includer first, then in the search paths; an
+ * angled one in the search paths only. `#include_next` resumes the search
+ * after the search path the includer was found in.
+ *
+ * Resolutions are cached by includer directory and operand, found or not,
+ * so each distinct include costs file system probes once per builder. The
+ * graph also keeps the guard of each header, found on its first read.
+ *
+ * @note A builder is not thread-safe; use one per thread.
+ */
+class CIncludeGraphBuilder {
+public:
+    /**
+     * @brief Constructs an empty graph.
+     *
+     * @param search_paths The directories searched, in order.
+     * @param paths [in] The table files are identified in. Must not be
+     *              `nullptr` and must outlive the builder.
+     */
+    explicit CIncludeGraphBuilder(std::vector<std::string> search_paths = {},
+                                  ca_io::ca_path_table *paths = &ca_io::ca_path_table::global());
+
+    /**
+     * @brief Resolves the operand of an include.
+     *
+     * @param includer The file containing the directive.
+     * @param name The operand, without its delimiters.
+     * @param angled Whether the operand was written `<name>`.
+     * @param next Whether the directive is `#include_next`.
+     * @return The id of the file, or `ca_path_table::INVALID_ID` if no
+     *         candidate exists.
+     */
+    ca_io::ca_path_id
+    resolve(ca_io::ca_path_id includer, std::string_view name, bool angled, bool next = false);
+
+    /**
+     * @brief Records that a file includes another. Repeated edges are
+     *        recorded once.
+     */
+    void
+    add_edge(ca_io::ca_path_id from, ca_io::ca_path_id to);
+
+    /**
+     * @brief Returns the files a file includes, in the order first seen.
+     */
+    [[nodiscard]] const std::vector<ca_io::ca_path_id> &
+    includes(ca_io::ca_path_id file) const;
+
+    /**
+     * @brief Records the guard of a header.
+     */
+    void
+    set_guard(ca_io::ca_path_id file, const CIncludeGuard &guard);
+
+    /**
+     * @brief Returns the guard of a header, `GUARD_UNKNOWN` if not recorded.
+     */
+    [[nodiscard]] CIncludeGuard
+    guard(ca_io::ca_path_id file) const;
+
+    /**
+     * @brief Returns the number of files including another.
+     */
+    [[nodiscard]] ca_size_t
+    num_includers() const {
+        return edges.size();
+    }
+
+    /**
+     * @brief Returns the number of edges.
+     */
+    [[nodiscard]] ca_size_t
+    num_edges() const {
+        return edge_count;
+    }
+
+    /**
+     * @brief Returns the table files are identified in.
+     */
+    [[nodiscard]] ca_io::ca_path_table &
+    paths() const {
+        return *table;
+    }
+
+    /**
+     * @brief Returns the totals so far.
+     */
+    [[nodiscard]] const CIncludeGraphStats &
+    stats() const {
+        return totals;
+    }
+
+    /**
+     * @brief Removes every edge, guard and cached resolution.
+     */
+    void
+    clear();
+
+private:
+    /**
+     * @brief Returns the id of `directory/name` if the file exists.
+     */
+    ca_io::ca_path_id
+    probe(std::string_view directory, std::string_view name);
+
+    std::vector<std::string> directories;                                       ///< The search paths.
+    ca_io::ca_path_table *table;                                                ///< Ids of the files.
+    std::unordered_map<std::string, ca_io::ca_path_id> resolved;                ///< Resolutions, by directory and operand.
+    std::unordered_map<ca_io::ca_path_id, std::vector<ca_io::ca_path_id>> edges;    ///< Included files, by includer.
+    std::unordered_map<ca_io::ca_path_id, CIncludeGuard> guards;                ///< Guards, by header.
+    ca_size_t edge_count;                                                       ///< Number of edges.
+    std::string key;                                                            ///< Key of the current resolution.
+    CIncludeGraphStats totals;                                                  ///< Totals so far.
+};
+
+}
+
 #endif //CINCLUDEGRAPHBUILDER_H
@@ -1,8 +1,402 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/c/core/macro/CMacroAnalyzer.h
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Defines `CMacroAnalyzer`, which tracks macro definitions and
+//        conditional inclusion while the directives of a unit are walked.
+// ================================
 
 #ifndef CMACROANALYZER_H
 #define CMACROANALYZER_H
 
+#include "core/parser/CToken.h"
+#include "ca_char_types.h"
+#include "ca_intern_pool.h"
+#include "ca_math.h"
+
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ca::analyzers::c {
+
+/**
+ * @enum CDirectiveKind
+ * @brief Kind of a preprocessing directive.
+ */
+enum class CDirectiveKind : ca_uint8_t {
+    DIRECTIVE_NONE,             ///< The null directive, a `#` alone on its line.
+    DIRECTIVE_INCLUDE,
+    DIRECTIVE_INCLUDE_NEXT,
+    DIRECTIVE_DEFINE,
+    DIRECTIVE_UNDEF,
+    DIRECTIVE_IF,
+    DIRECTIVE_IFDEF,
+    DIRECTIVE_IFNDEF,
+    DIRECTIVE_ELIF,
+    DIRECTIVE_ELIFDEF,
+    DIRECTIVE_ELIFNDEF,
+    DIRECTIVE_ELSE,
+    DIRECTIVE_ENDIF,
+    DIRECTIVE_PRAGMA,
+    DIRECTIVE_OTHER,            ///< Any other directive, such as `#line` or `#error`.
+};
+
+/**
+ * @struct CMacroToken
+ * @brief A token of a macro body, independent of the buffer it came from.
+ */
+struct CMacroToken {
+    CTokenKind kind;                ///< Kind of the token.
+    CTokenStream::id_type id;       ///< Interned spelling of identifiers and keywords, `INVALID_ID` otherwise.
+    ca_int64_t value;               ///< Value of integer and character constants, 0 otherwise.
+};
+
+/**
+ * @struct CMacro
+ * @brief The definition of a macro.
+ */
+struct CMacro {
+    ca_uint64_t hash;                                   ///< Hash of the parameters and body, never 0.
+    bool function_like;                                 ///< Whether the macro takes arguments.
+    bool variadic;                                      ///< Whether the parameters end with `...`.
+    std::vector<CTokenStream::id_type> parameters;      ///< Names of the parameters, the variable arguments last.
+    std::vector<CMacroToken> body;                      ///< The replacement list.
+};
+
+/**
+ * @typedef CMacroPtr
+ * @brief Shared handle of a definition. Definitions are immutable, so the
+ *        macro table and the recordings of cached headers share them.
+ */
+typedef std::shared_ptr<const CMacro> CMacroPtr;
+
+/**
+ * @typedef CIncludeProbe
+ * @brief Tells whether the operand of `__has_include`, spelled without its
+ *        delimiters, names a header; `angled` for `<...>` operands and
+ *        `next` for `__has_include_next`.
+ */
+typedef std::function<bool(std::string_view name, bool angled, bool next)> CIncludeProbe;
+
+/**
+ * @struct CMacroRecording
+ * @brief What a stretch of directives read from and did to the macro table.
+ *
+ * A recording says everything the stretch depends on: replaying the same
+ * directives from any table giving the same `signature` to `tested` has the
+ * same effects.
+ */
+struct CMacroRecording {
+    std::vector<CTokenStream::id_type> tested;      ///< Macros read before being written, sorted.
+    ca_uint64_t signature;                          ///< `CMacroAnalyzer::signature` of `tested` at the start.
+    std::vector<std::pair<CTokenStream::id_type, CMacroPtr>> effects;   ///< Final definition of each macro written, `nullptr` if undefined.
+};
+
+/**
+ * @struct CMacroStats
+ * @brief Totals accumulated by a `CMacroAnalyzer`.
+ */
+struct CMacroStats {
+    ca_uint64_t directives;         ///< Directives processed.
+    ca_uint64_t definitions;        ///< `#define` and `#undef` directives in active regions.
+    ca_uint64_t evaluations;        ///< Conditions evaluated.
+    ca_uint64_t errors;             ///< Malformed directives and conditions.
+};
+
+/**
+ * @class CMacroAnalyzer
+ * @brief Keeps the macro table and the conditional stack of a unit.
+ *
+ * The analyzer is fed the directive lines of a unit, in order, as the
+ * tokens `CLexer` produced for them. It records `#define` and `#undef`,
+ * evaluates `#if`, `#ifdef` and their `#elif` forms, and tells whether the
+ * current line is in an active region.
+ *
+ * Conditions are evaluated on 64-bit signed integers. Macros are expanded,
+ * function-like ones with their arguments, `defined` and `true`/`false` are
+ * handled, and any other identifier is 0. `__has_include` and
+ * `__has_include_next` ask the include probe, and are not defined without
+ * one. A call that cannot be evaluated, such as that of a builtin like
+ * `__has_attribute` or of a macro using `#` or `##`, makes the condition
+ * malformed rather than 0.
+ *
+ * Every macro looked up, through a condition or `defined`, is reported to
+ * the open recordings, so that the effect of a header can be cached and
+ * reused for any unit whose table agrees on the macros the header tests.
+ *
+ * @note An analyzer is not thread-safe; use one per thread.
+ */
+class CMacroAnalyzer {
+public:
+    /**
+     * @brief Constructs an analyzer with an empty table.
+     *
+     * @param pool [in] The pool the tokens were interned in by a `CLexer`.
+     *             Must not be `nullptr` and must outlive the analyzer.
+     */
+    explicit CMacroAnalyzer(ca_string::ca_intern_pool *pool);
+
+    /**
+     * @brief Returns the kind of the directive starting at a line-initial `#`.
+     *
+     * @param tokens [in] The tokens of the buffer.
+     * @param hash [in] Index of the `#` token.
+     */
+    [[nodiscard]] CDirectiveKind
+    directive_kind(const CTokenStream &tokens, ca_size_t hash) const;
+
+    /**
+     * @brief Processes a directive line.
+     *
+     * Conditional directives are processed in every region, to track their
+     * nesting; `#define` and `#undef` only in active regions. Other kinds
+     * are ignored.
+     *
+     * @param kind [in] Kind of the directive, from `directive_kind`.
+     * @param source [in] The buffer the tokens refer to.
+     * @param tokens [in] The tokens of the buffer.
+     * @param first [in] Index of the first token after the directive name.
+     * @param last [in] Index of the first token of the next line.
+     * @return
+     * - `0` on success.
+     * - `-1` if the directive is malformed; conditions that cannot be
+     *   evaluated are false.
+     */
+    int
+    directive(CDirectiveKind kind, const ca_string::ca_char_t *source, const CTokenStream &tokens, ca_size_t first,
+              ca_size_t last);
+
+    /**
+     * @brief Checks if the current line is in an active region.
+     */
+    [[nodiscard]] bool
+    active() const {
+        return conditionals.empty() || conditionals.back().active;
+    }
+
+    /**
+     * @brief Returns the number of open conditionals.
+     */
+    [[nodiscard]] ca_size_t
+    depth() const {
+        return conditionals.size();
+    }
+
+    /**
+     * @brief Closes the conditionals opened past a depth, such as those a
+     *        header left unterminated.
+     */
+    void
+    truncate(ca_size_t depth);
+
+    /**
+     * @brief Returns the definition of a macro, without reporting the lookup.
+     *
+     * @return The definition, or `nullptr` if the macro is not defined.
+     */
+    [[nodiscard]] const CMacro *
+    find(CTokenStream::id_type name) const;
+
+    /**
+     * @brief Checks if a macro is defined, reporting the lookup as `#ifdef`
+     *        would.
+     */
+    [[nodiscard]] bool
+    defined(CTokenStream::id_type name);
+
+    /**
+     * @brief Defines a macro with an empty body, reporting the change.
+     *
+     * Used for markers that are not spelled in the source, such as the
+     * name a header with `#pragma once` defines when it is entered.
+     */
+    void
+    define_marker(CTokenStream::id_type name);
+
+    /**
+     * @brief Sets the probe `__has_include` asks, or removes it if empty.
+     *
+     * The probe is not recorded, so its answers must only depend on the
+     * operand and the file being walked.
+     */
+    void
+    set_include_probe(CIncludeProbe probe) {
+        include_probe = std::move(probe);
+    }
+
+    /**
+     * @brief Returns the hash of a macro's definition, 0 if it is undefined,
+     *        without reporting the lookup.
+     */
+    [[nodiscard]] ca_uint64_t
+    hash(CTokenStream::id_type name) const;
+
+    /**
+     * @brief Combines the current hashes of a sorted list of macros.
+     */
+    [[nodiscard]] ca_uint64_t
+    signature(const std::vector<CTokenStream::id_type> &names) const;
+
+    /**
+     * @brief Starts recording the lookups and changes of the table.
+     *
+     * Recordings nest: a lookup or change is reported to every open one.
+     */
+    void
+    begin_recording();
+
+    /**
+     * @brief Ends the innermost recording.
+     *
+     * @return What the table was read for and how it changed since
+     *         `begin_recording`.
+     */
+    CMacroRecording
+    end_recording();
+
+    /**
+     * @brief Replays a recording: reports its lookups to the open recordings,
+     *        then applies its effects.
+     */
+    void
+    replay(const CMacroRecording &recording);
+
+    /**
+     * @brief Empties the table, the conditional stack and the recordings.
+     */
+    void
+    reset();
+
+    /**
+     * @brief Returns the totals so far.
+     */
+    [[nodiscard]] const CMacroStats &
+    stats() const {
+        return totals;
+    }
+
+private:
+    /**
+     * @struct conditional
+     * @brief An open `#if` group.
+     */
+    struct conditional {
+        bool active;        ///< Whether the current group is active.
+        bool taken;         ///< Whether a group was taken, or the enclosing region is inactive.
+        bool seen_else;     ///< Whether `#else` was seen.
+    };
+
+    /**
+     * @struct recording
+     * @brief An open recording.
+     */
+    struct recording {
+        std::vector<std::pair<CTokenStream::id_type, ca_uint64_t>> tested;  ///< Macros read first, with their hash then.
+        std::unordered_map<CTokenStream::id_type, bool> seen;               ///< Macros tested or written, to whether written.
+    };
+
+    /**
+     * @brief Looks up a macro, reporting the lookup.
+     */
+    const CMacro *
+    read(CTokenStream::id_type name);
+
+    /**
+     * @brief Defines a macro, or undefines it if `macro` is `nullptr`,
+     *        reporting the change.
+     */
+    void
+    write(CTokenStream::id_type name, CMacroPtr macro);
+
+    /**
+     * @brief Parses a `#define` line.
+     */
+    int
+    define(const ca_string::ca_char_t *source, const CTokenStream &tokens, ca_size_t first, ca_size_t last);
+
+    /**
+     * @brief Evaluates a condition, reporting the macros it looks up.
+     *
+     * @return `0` on success, or `-1` if the condition is malformed.
+     */
+    int
+    evaluate(const ca_string::ca_char_t *source, const CTokenStream &tokens, ca_size_t first, ca_size_t last,
+             bool *value);
+
+    /**
+     * @brief Replaces a `__has_include` operand by the answer of the probe.
+     *
+     * @param i [in,out] Index of `__has_include`, then of the closing `)`.
+     * @param found [out] The answer of the probe.
+     * @return `0` on success, or `-1` if the operand is malformed or there
+     *         is no probe.
+     */
+    int
+    has_include(const ca_string::ca_char_t *source, const CTokenStream &tokens, ca_size_t last, bool next,
+                ca_size_t *i, bool *found);
+
+    /**
+     * @brief Appends the tokens of a condition with macros expanded and
+     *        `defined` replaced by its value.
+     *
+     * Function-like macro names not followed by `(` are kept, since the
+     * arguments of a call may follow the sequence.
+     */
+    int
+    expand(const CMacroToken *tokens, ca_size_t count, ca_size_t depth, std::vector<CMacroToken> *out);
+
+    /**
+     * @brief Expands a call of a function-like macro.
+     *
+     * @param i [in,out] Index of the `(` opening the arguments, then of the
+     *          `)` closing them.
+     */
+    int
+    expand_call(const CMacro &macro, CTokenStream::id_type name, const CMacroToken *tokens, ca_size_t count,
+                ca_size_t depth, ca_size_t *i, std::vector<CMacroToken> *out);
+
+    /**
+     * @brief Checks if a name is defined for `defined` and `#ifdef`.
+     */
+    bool
+    is_defined_name(CTokenStream::id_type name);
+
+    /**
+     * @brief Evaluates `#ifdef` or `#ifndef` style operands.
+     */
+    int
+    is_defined(const CTokenStream &tokens, ca_size_t first, ca_size_t last, bool *value);
+
+    CTokenStream::id_type define_id;            ///< Id of `define`.
+    CTokenStream::id_type undef_id;             ///< Id of `undef`.
+    CTokenStream::id_type ifdef_id;             ///< Id of `ifdef`.
+    CTokenStream::id_type ifndef_id;            ///< Id of `ifndef`.
+    CTokenStream::id_type elif_id;              ///< Id of `elif`.
+    CTokenStream::id_type elifdef_id;           ///< Id of `elifdef`.
+    CTokenStream::id_type elifndef_id;          ///< Id of `elifndef`.
+    CTokenStream::id_type endif_id;             ///< Id of `endif`.
+    CTokenStream::id_type include_id;           ///< Id of `include`.
+    CTokenStream::id_type include_next_id;      ///< Id of `include_next`.
+    CTokenStream::id_type pragma_id;            ///< Id of `pragma`.
+    CTokenStream::id_type defined_id;           ///< Id of `defined`.
+    CTokenStream::id_type has_include_id;       ///< Id of `__has_include`.
+    CTokenStream::id_type has_include_next_id;  ///< Id of `__has_include_next`.
+    CTokenStream::id_type va_args_id;           ///< Id of `__VA_ARGS__`.
+
+    std::unordered_map<CTokenStream::id_type, CMacroPtr> table;     ///< Defined macros.
+    std::vector<conditional> conditionals;                          ///< Open conditionals, innermost last.
+    std::vector<recording> recordings;                              ///< Open recordings, innermost last.
+    std::vector<CTokenStream::id_type> expanding;                   ///< Macros being expanded in a condition.
+    std::vector<CMacroToken> line;                                  ///< Tokens of the condition being evaluated.
+    std::vector<CMacroToken> expanded;                              ///< Its tokens after expansion.
+    CIncludeProbe include_probe;                                    ///< Answers `__has_include`, if set.
+    CMacroStats totals;                                             ///< Totals so far.
+};
+
+}
+
 #endif //CMACROANALYZER_H
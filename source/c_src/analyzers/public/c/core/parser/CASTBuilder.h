@@ -1,8 +1,124 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/c/core/parser/CASTBuilder.h
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Defines `CASTBuilder`, which lexes and parses a C translation
+//        unit into a `CAst`.
+// ================================
 
 #ifndef CASTBUILDER_H
 #define CASTBUILDER_H
 
+#include "CAst.h"
+#include "CLexer.h"
+#include "ca_char_types.h"
+#include "ca_intern_pool.h"
+#include "ca_math.h"
+
+#include <unordered_set>
+#include <vector>
+
+namespace ca::analyzers::c {
+
+/**
+ * @struct CASTBuilderStats
+ * @brief Totals accumulated by a `CASTBuilder` over every unit it built.
+ */
+struct CASTBuilderStats {
+    ca_uint64_t units;          ///< Number of units built.
+    ca_uint64_t tokens;         ///< Number of tokens parsed.
+    ca_uint64_t nodes;          ///< Number of nodes created.
+    ca_uint64_t node_bytes;     ///< Bytes of the pre-order node records and per-kind index lists, excluding unused capacity.
+    ca_uint64_t errors;         ///< Number of syntax errors recovered from.
+};
+
+/**
+ * @class CASTBuilder
+ * @brief Builds syntax trees of C translation units.
+ *
+ * The parser is a recursive-descent parser over the unexpanded tokens of
+ * one file. Preprocessing directives are skipped, so macros are seen as
+ * the identifiers and calls they are spelled as. To tell declarations from
+ * expressions it tracks the typedef names of the unit and takes an unknown
+ * identifier as a type name where no expression could stand, as in `T x`,
+ * `T *const p`, `T *p = 0` or `(T *)p`, which covers types declared in
+ * headers that are not read.
+ *
+ * The parser completes nodes bottom-up into post-order staging arrays kept
+ * by the builder, which `CAst::assign` then lays out in pre-order.
+ *
+ * Syntax errors do not stop the parse: the parser skips to the end of the
+ * statement or declaration and marks the enclosing node with
+ * `C_NODE_RECOVERED`. A construct missing its `;` at the end of a line
+ * (typically a macro invocation) ends there.
+
+ * Constructs nested deeper than `MAX_NESTING` levels are skipped as a
+ * `NODE_ERROR` and counted as syntax errors, so that deeply nested input
+ * cannot overflow the stack.
+ *
+ * @note A builder is not thread-safe; use one per thread.
+ */
+class CASTBuilder {
+public:
+    /**
+     * @brief Deepest nesting of recursively parsed constructs: statements,
+     *        declarations, declarators, initializers, and the levels of the
+     *        expression grammar. A parenthesized expression takes three.
+     */
+    static constexpr ca_size_t MAX_NESTING = 1024;
+
+    /**
+     * @brief Constructs a builder interning identifiers into a pool.
+     *
+     * @param pool [in] The pool, under the same conditions as for `CLexer`.
+     */
+    explicit CASTBuilder(ca_string::ca_intern_pool *pool);
+
+    /**
+     * @brief Lexes and parses a buffer, replacing the content of a tree.
+     *
+     * @param source [in] The source bytes. Must not be `nullptr` unless `size` is 0.
+     * @param size [in] Size of the source in bytes.
+     * @param ast [out] The tree. Must not be `nullptr`.
+     * @return
+     * - `0` on success, including when syntax errors were recovered from.
+     * - `-1` if the source is too large for the lexer.
+     */
+    int
+    build(const ca_string::ca_char_t *source, ca_size_t size, CAst *ast);
+
+    /**
+     * @brief Returns the totals over every unit built so far.
+     */
+    [[nodiscard]] const CASTBuilderStats &
+    stats() const {
+        return totals;
+    }
+
+    /**
+     * @brief Returns the lexer of the builder.
+     */
+    [[nodiscard]] const CLexer &
+    lexer() const {
+        return tokenizer;
+    }
+
+private:
+    friend struct CParser;
+
+    typedef CTokenStream::id_type id_type;
+
+    CLexer tokenizer;                           ///< The lexer, interning into the pool.
+    std::unordered_set<id_type> builtin_types;  ///< Identifiers always naming types, such as `__int128`.
+    std::unordered_set<id_type> qualifiers;     ///< Extension keywords that are skipped, such as `__inline`.
+    std::unordered_set<id_type> attributes;     ///< Extension keywords skipped with their parenthesized operand.
+    std::unordered_set<id_type> typedef_names;  ///< Typedef names of the current unit.
+    std::vector<CAstNode> staged;               ///< Nodes of the current unit in post-order.
+    std::vector<CAst::index_type> staged_sizes; ///< Subtree size of each staged node.
+    std::vector<CAst::index_type> pending;      ///< Completed nodes waiting for their parent.
+    CASTBuilderStats totals;                    ///< Totals so far.
+};
+
+}
+
 #endif //CASTBUILDER_H
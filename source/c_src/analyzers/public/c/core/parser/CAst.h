@@ -0,0 +1,321 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/c/core/parser/CAst.h
+//
+// @file
+// @brief Defines `CAst`, the compact index-based syntax tree of one C
+//        translation unit, and its fixed-size node record `CAstNode`.
+// ================================
+
+#ifndef CAST_H
+#define CAST_H
+
+#include "CToken.h"
+#include "ca_math.h"
+
+#include <array>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace ca::analyzers::c {
+
+/**
+ * @enum CNodeKind
+ * @brief Kind of a syntax tree node.
+ *
+ * The children of each kind are listed in source order; optional parts that
+ * are absent are left out unless noted.
+ */
+enum class CNodeKind : ca_uint8_t {
+    NODE_TRANSLATION_UNIT,      ///< Top-level declarations and function definitions.
+    NODE_FUNCTION_DEFINITION,   ///< Records defined in the specifiers, parameters, then the body. Token: the name.
+    NODE_DECLARATION,           ///< Records defined in the specifiers, then the declarators.
+    NODE_DECLARATOR,            ///< Parameters if a function, then the bit-field width or initializer. Token: the name.
+    NODE_PARAMETER,             ///< Records defined in the specifiers. Token: the name, if any.
+    NODE_RECORD,                ///< `struct` or `union` with a body: the member declarations. Token: the tag, if any.
+    NODE_ENUM,                  ///< `enum` with a body: the enumerators. Token: the tag, if any.
+    NODE_ENUMERATOR,            ///< The value, if any. Token: the name.
+    NODE_STATIC_ASSERT,         ///< The condition, then the message if any.
+    NODE_TYPE_NAME,             ///< Operand of a cast, `sizeof` or compound literal: records defined in it.
+
+    NODE_COMPOUND,              ///< The block items.
+    NODE_IF,                    ///< Condition, then statement, then the else statement if any.
+    NODE_WHILE,                 ///< Condition, then body.
+    NODE_DO,                    ///< Body, then condition.
+    NODE_FOR,                   ///< Init, condition, increment (`NODE_EMPTY` when absent), then body.
+    NODE_SWITCH,                ///< Condition, then body.
+    NODE_CASE,                  ///< Value (and the end of a GNU range), then the statement.
+    NODE_DEFAULT,               ///< The statement.
+    NODE_LABEL,                 ///< The statement, if any. Token: the label.
+    NODE_GOTO,                  ///< Token: the label, or `*` for a computed goto followed by its operand.
+    NODE_BREAK,
+    NODE_CONTINUE,
+    NODE_RETURN,                ///< The value, if any.
+    NODE_EXPRESSION_STATEMENT,  ///< The expression.
+    NODE_NULL_STATEMENT,        ///< A lone `;`.
+    NODE_EMPTY,                 ///< Placeholder for an absent `for` clause.
+
+    NODE_NAME,                  ///< An identifier, `true`, `false` or `nullptr`. Token: the name.
+    NODE_NUMBER,
+    NODE_CHAR,
+    NODE_STRING,                ///< One or more adjacent string literals.
+    NODE_UNARY,                 ///< Prefix operator `op` and its operand, or `sizeof`/`alignof` of an expression.
+    NODE_POSTFIX,               ///< Postfix `++` or `--` and its operand.
+    NODE_BINARY,                ///< Binary, assignment or comma operator `op` and its two operands.
+    NODE_CONDITIONAL,           ///< Condition, then true and false operands.
+    NODE_CAST,                  ///< Type name, then operand.
+    NODE_SIZEOF_TYPE,           ///< `sizeof`, `alignof` or `_Alignof` (`op`) of a type name.
+    NODE_CALL,                  ///< Callee, then arguments.
+    NODE_SUBSCRIPT,             ///< Array, then index.
+    NODE_MEMBER,                ///< Object operand; `op` is `.` or `->`. Token: the member.
+    NODE_COMPOUND_LITERAL,      ///< Type name, then initializer list.
+    NODE_INIT_LIST,             ///< The initializers.
+    NODE_DESIGNATION,           ///< Array designator indices, then the initializer.
+    NODE_STATEMENT_EXPRESSION,  ///< GNU `({ ... })`: the compound statement.
+    NODE_GENERIC,               ///< `_Generic`: the controlling expression, then the associated expressions.
+
+    NODE_ERROR,                 ///< Tokens that could not be parsed.
+};
+
+/**
+ * @brief Number of node kinds.
+ */
+inline constexpr ca_size_t C_NODE_KIND_COUNT = static_cast<ca_size_t>(CNodeKind::NODE_ERROR) + 1;
+
+/**
+ * @brief Returns a printable name of a node kind, such as `call`.
+ */
+const char *
+c_node_kind_name(CNodeKind kind);
+
+/**
+ * @brief Flags of a node.
+ */
+inline constexpr ca_uint16_t C_NODE_TYPEDEF = 0x0001;       ///< Declaration with `typedef`.
+inline constexpr ca_uint16_t C_NODE_STATIC = 0x0002;        ///< Declaration or definition with `static`.
+inline constexpr ca_uint16_t C_NODE_EXTERN = 0x0004;        ///< Declaration or definition with `extern`.
+inline constexpr ca_uint16_t C_NODE_INLINE = 0x0008;        ///< Declaration or definition with `inline`.
+inline constexpr ca_uint16_t C_NODE_FUNCTION = 0x0010;      ///< Declarator or definition of a function.
+inline constexpr ca_uint16_t C_NODE_VARIADIC = 0x0020;      ///< Function with a `...` parameter.
+inline constexpr ca_uint16_t C_NODE_RECOVERED = 0x0040;     ///< Node whose tokens held a syntax error.
+
+/**
+ * @struct CAstNode
+ * @brief Fixed-size record of one node.
+ *
+ * Nodes refer to tokens and to other nodes by index only, so a node holds
+ * no pointer and owns no memory. With 32-bit indices a record is 20 bytes;
+ * with `ENABLE_64BIT_INDEX` it is 40 bytes.
+ */
+struct CAstNode {
+    /**
+     * @typedef index_type
+     * @brief Type of node and token indices, 32-bit unless built with
+     *        ENABLE_64BIT_INDEX.
+     */
+    typedef ca_index_t index_type;
+
+    CNodeKind kind;             ///< Kind of the node.
+    CTokenKind op;              ///< Operator or keyword of the node, `TOKEN_UNKNOWN` if none.
+    ca_uint16_t flags;          ///< `C_NODE_*` flags.
+    index_type token;           ///< Main token (see `CNodeKind`), or `CAst::INVALID_INDEX`.
+    index_type first_token;     ///< First token of the node.
+    index_type last_token;      ///< Last token of the node (inclusive).
+    index_type subtree_end;     ///< Index one past the last node of the subtree.
+};
+
+#ifndef CA_ENABLE_64BIT_INDEX
+static_assert(sizeof(CAstNode) == 20);
+#endif
+
+/**
+ * @class CAstChildren
+ * @brief Forward range over the children of a node, in source order.
+ *
+ * The first child directly follows its parent and each next sibling
+ * follows the subtree of the previous one, so stepping is one load.
+ */
+class CAstChildren {
+public:
+    typedef CAstNode::index_type index_type;
+
+    /**
+     * @class iterator
+     * @brief Iterator yielding the index of each child.
+     */
+    class iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef index_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const index_type *pointer;
+        typedef index_type reference;
+
+        iterator() = default;
+
+        iterator(const CAstNode *nodes, const index_type index) : nodes(nodes), index(index) {}
+
+        index_type
+        operator*() const {
+            return index;
+        }
+
+        iterator &
+        operator++() {
+            index = nodes[index].subtree_end;
+            return *this;
+        }
+
+        iterator
+        operator++(int) {
+            const iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool
+        operator==(const iterator &other) const {
+            return index == other.index;
+        }
+
+    private:
+        const CAstNode *nodes = nullptr;    ///< The node records of the tree.
+        index_type index = 0;               ///< The current child.
+    };
+
+    CAstChildren(const CAstNode *nodes, const index_type parent)
+        : nodes(nodes), first(parent + 1), last(nodes[parent].subtree_end) {}
+
+    [[nodiscard]] iterator
+    begin() const {
+        return { nodes, first };
+    }
+
+    [[nodiscard]] iterator
+    end() const {
+        return { nodes, last };
+    }
+
+    [[nodiscard]] bool
+    empty() const {
+        return first == last;
+    }
+
+private:
+    const CAstNode *nodes;  ///< The node records of the tree.
+    index_type first;       ///< The first child, or `last` if none.
+    index_type last;        ///< The end of the subtree of the parent.
+};
+
+/**
+ * @class CAst
+ * @brief Syntax tree of one translation unit.
+ *
+ * The node records are stored in pre-order: the root is node 0, every
+ * node is followed by its subtree, and `CAstNode::subtree_end` gives the
+ * index past that subtree. A scan over every node is a linear sweep of the
+ * array, and a subtree is skipped in O(1) by jumping to its end.
+ *
+ * The tree also keeps, for each node kind, the indices of the nodes of that
+ * kind in pre-order, so a rule looking only at calls visits only calls, and
+ * the token stream its nodes refer to.
+ *
+ * These flat arrays act as the arena of the unit. Nothing is allocated per
+ * node and nothing has a destructor, so `reset` frees a unit in O(1) and
+ * keeps the memory for the next one.
+ */
+class CAst {
+public:
+    typedef CAstNode::index_type index_type;
+
+    /**
+     * @brief Index meaning no node or no token.
+     */
+    static constexpr index_type INVALID_INDEX = CA_INDEX_T_MAX;
+
+    CTokenStream tokens;    ///< The tokens of the unit.
+
+    /**
+     * @brief Returns the root `NODE_TRANSLATION_UNIT`, or `INVALID_INDEX`
+     *        if the tree is empty.
+     */
+    [[nodiscard]] index_type
+    root() const {
+        return nodes.empty() ? INVALID_INDEX : 0;
+    }
+
+    /**
+     * @brief Returns the number of nodes.
+     */
+    [[nodiscard]] ca_size_t
+    size() const {
+        return nodes.size();
+    }
+
+    /**
+     * @brief Returns a node.
+     */
+    [[nodiscard]] const CAstNode &
+    node(const index_type index) const {
+        return nodes[index];
+    }
+
+    /**
+     * @brief Returns the children of a node.
+     */
+    [[nodiscard]] CAstChildren
+    children(const index_type index) const {
+        return { nodes.data(), index };
+    }
+
+    /**
+     * @brief Returns the nodes of a kind, in pre-order.
+     */
+    [[nodiscard]] std::span<const index_type>
+    nodes_of_kind(const CNodeKind kind) const {
+        const ca_size_t k = static_cast<ca_size_t>(kind);
+        return { kind_nodes.data() + kind_offsets[k], kind_nodes.data() + kind_offsets[k + 1] };
+    }
+
+    /**
+     * @brief Replaces the tree with one built in post-order.
+     *
+     * In post-order, as a bottom-up parser completes nodes, the subtree of
+     * node `i` is the range ending at `i` of `subtree_sizes[i]` nodes, and
+     * the last node is the root. The nodes are laid out in pre-order with
+     * their `subtree_end` set; the tokens are kept.
+     *
+     * @param post_order [in] The nodes in post-order; `subtree_end` is ignored.
+     * @param subtree_sizes [in] Number of nodes of each subtree, including its root.
+     */
+    void
+    assign(std::span<const CAstNode> post_order, std::span<const index_type> subtree_sizes);
+
+    /**
+     * @brief Removes all nodes and tokens, keeping the allocated memory.
+     */
+    void
+    reset();
+
+    /**
+     * @brief Returns the number of bytes allocated for the nodes and kind lists.
+     */
+    [[nodiscard]] ca_size_t
+    memory_usage() const;
+
+    /**
+     * @brief Returns the number of bytes the nodes and kind lists use per
+     *        node, not counting unused capacity.
+     */
+    [[nodiscard]] double
+    bytes_per_node() const;
+
+private:
+    std::vector<CAstNode> nodes;                                ///< The node records, in pre-order.
+    std::vector<index_type> kind_nodes;                         ///< Node indices grouped by kind.
+    std::array<index_type, C_NODE_KIND_COUNT + 1> kind_offsets{};   ///< Start of each kind in `kind_nodes`.
+};
+
+}
+
+#endif //CAST_H
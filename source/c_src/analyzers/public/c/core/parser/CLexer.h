@@ -0,0 +1,162 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/c/core/parser/CLexer.h
+//
+// @file
+// @brief Defines `CLexer`, the SIMD-accelerated C lexer feeding
+//        `CASTBuilder`.
+// ================================
+
+#ifndef CLEXER_H
+#define CLEXER_H
+
+#include "CToken.h"
+#include "ca_char_types.h"
+#include "ca_intern_pool.h"
+#include "ca_math.h"
+
+namespace ca::analyzers::c {
+
+/**
+ * @struct CLexerStats
+ * @brief Totals accumulated by a `CLexer` over every buffer it lexed.
+ */
+struct CLexerStats {
+    ca_uint64_t buffers;            ///< Number of buffers lexed whole.
+    ca_uint64_t bytes;              ///< Number of source bytes lexed, by buffer or by section.
+    ca_uint64_t tokens;             ///< Number of tokens produced, without the `TOKEN_END` tokens.
+    ca_uint64_t comment_bytes;      ///< Number of bytes inside comments.
+};
+
+/**
+ * @class CLexer
+ * @brief Splits C source buffers into preprocessing tokens.
+ *
+ * The lexer works on the raw bytes of a translation phase 1 buffer. The hot
+ * loops (whitespace runs, identifier runs, comment ends and literal ends)
+ * classify 16 bytes at a time with SSE2 compares (32 with AVX2) and jump to
+ * the first byte of interest with a bit scan; the remaining bytes of a
+ * buffer are handled by scalar code, so nothing is read past its end.
+ *
+ * Identifiers and keywords are interned in the pool the lexer is given.
+ * The keywords are interned first, in the order of `C_KEYWORD_SPELLINGS`,
+ * so an identifier is a keyword exactly when its id is below
+ * `C_KEYWORD_COUNT` and no keyword table lookup is needed.
+ *
+ * Backslash-newline splices are skipped like whitespace between tokens but
+ * are not removed from inside tokens. Comments are dropped. The operand of
+ * `#include` at the start of a line is lexed as one `TOKEN_HEADER_NAME` if
+ * it starts with `<`.
+ *
+ * A buffer can also be lexed a section at a time, each ending with a
+ * directive line, so that the caller can evaluate the directive before
+ * going on. A conditional group found not to be compiled is then jumped
+ * over with `skip_group`, which looks for line-initial `#` only and never
+ * produces tokens. What is jumped over is left to the caller to count, as
+ * the same scan also serves to probe a buffer.
+ *
+ * @note A lexer is not thread-safe; use one per thread, each with its own
+ *       pool or with a pool the caller protects.
+ */
+class CLexer {
+public:
+    /**
+     * @brief Constructs a lexer interning into a pool.
+     *
+     * @param pool [in] The pool for identifier spellings. Must not be
+     *             `nullptr`, must be empty or have been used by a `CLexer`
+     *             before, and must outlive the lexer.
+     */
+    explicit CLexer(ca_string::ca_intern_pool *pool);
+
+    /**
+     * @brief Lexes a buffer, replacing the content of a token stream.
+     *
+     * The stream always ends with a `TOKEN_END` token at the end offset.
+     *
+     * @param source [in] The source bytes. Must not be `nullptr` unless `size` is 0.
+     * @param size [in] Size of the source in bytes.
+     * @param tokens [out] The tokens. Must not be `nullptr`.
+     * @return
+     * - `0` on success.
+     * - `-1` if the source is 4 GiB or larger.
+     */
+    int
+    lex(const ca_string::ca_char_t *source, ca_size_t size, CTokenStream *tokens);
+
+    /**
+     * @brief Lexes a section of a buffer, replacing the content of a token
+     *        stream.
+     *
+     * A section runs from a line start to the end of the first directive
+     * line after it, or to the end of the buffer. Offsets stay relative to
+     * `source`, and the stream ends with a `TOKEN_END` token where lexing
+     * stopped.
+     *
+     * @param source [in] The whole buffer. Must not be `nullptr` unless `size` is 0.
+     * @param size [in] Size of the buffer in bytes.
+     * @param offset [in] Where the section starts, at the start of a line.
+     * @param tokens [out] The tokens. Must not be `nullptr`.
+     * @param next [out] Where the section stopped and the next one starts.
+     *             Must not be `nullptr`.
+     * @return
+     * - `0` on success.
+     * - `-1` if the buffer is 4 GiB or larger.
+     */
+    int
+    lex_section(const ca_string::ca_char_t *source, ca_size_t size, ca_size_t offset, CTokenStream *tokens,
+                ca_size_t *next);
+
+    /**
+     * @brief Skips the rest of a conditional group that is not compiled.
+     *
+     * Scans from a line start for the line-initial `#` of the `#elif`,
+     * `#elifdef`, `#elifndef`, `#else` or `#endif` ending the group,
+     * jumping over nested conditionals. Only what can hide a `#` is looked
+     * at: comments, and literals on the lines where a comment would start.
+     *
+     * @param source [in] The whole buffer. Must not be `nullptr` unless `size` is 0.
+     * @param size [in] Size of the buffer in bytes.
+     * @param offset [in] Where the scan starts, at the start of a line.
+     * @return The offset of the `#` ending the group, or `size` if the
+     *         group is not ended.
+     */
+    ca_size_t
+    skip_group(const ca_string::ca_char_t *source, ca_size_t size, ca_size_t offset);
+
+    /**
+     * @brief Returns the totals over every buffer lexed so far.
+     */
+    [[nodiscard]] const CLexerStats &
+    stats() const {
+        return totals;
+    }
+
+    /**
+     * @brief Returns the pool identifiers are interned in.
+     */
+    [[nodiscard]] ca_string::ca_intern_pool &
+    pool() const {
+        return *identifiers;
+    }
+
+private:
+    /**
+     * @brief Lexes a buffer from an offset, into an empty token stream.
+     *
+     * @param section Whether to stop at the end of the first directive line.
+     * @return Where lexing stopped.
+     */
+    ca_size_t
+    lex_from(const ca_string::ca_char_t *source, ca_size_t size, ca_size_t offset, bool section,
+             CTokenStream *tokens);
+
+    ca_string::ca_intern_pool *identifiers;         ///< Identifier spellings, keywords first.
+    CTokenStream::id_type include_id;               ///< Id of `include`.
+    CTokenStream::id_type include_next_id;          ///< Id of `include_next`.
+    CTokenStream::id_type embed_id;                 ///< Id of `embed`.
+    CLexerStats totals;                             ///< Totals so far.
+};
+
+}
+
+#endif //CLEXER_H
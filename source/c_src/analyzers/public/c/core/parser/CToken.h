@@ -0,0 +1,260 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/c/core/parser/CToken.h
+//
+// @file
+// @brief Defines the C token kinds and `CTokenStream`, the struct-of-arrays
+//        token buffer produced by `CLexer`.
+// ================================
+
+#ifndef CTOKEN_H
+#define CTOKEN_H
+
+#include "ca_intern_pool.h"
+#include "ca_math.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ca::analyzers::c {
+
+/**
+ * @enum CTokenKind
+ * @brief Kind of a C token.
+ *
+ * Keywords are contiguous and in the order of `C_KEYWORD_SPELLINGS`, so the
+ * kind of a keyword is `KEYWORD_FIRST` plus its index. Digraphs share the
+ * kind of the punctuator they stand for.
+ */
+enum class CTokenKind : ca_uint8_t {
+    TOKEN_END,              ///< End of the source, always the last token.
+    TOKEN_IDENTIFIER,
+    TOKEN_NUMBER,           ///< A preprocessing number, including digit separators.
+    TOKEN_CHAR,             ///< A character constant, with its prefix.
+    TOKEN_STRING,           ///< A string literal, with its prefix.
+    TOKEN_HEADER_NAME,      ///< The `<...>` operand of `#include`.
+    TOKEN_UNKNOWN,          ///< A byte that starts no token, or an unterminated literal.
+
+    KEYWORD_AUTO,
+    KEYWORD_BREAK,
+    KEYWORD_CASE,
+    KEYWORD_CHAR,
+    KEYWORD_CONST,
+    KEYWORD_CONTINUE,
+    KEYWORD_DEFAULT,
+    KEYWORD_DO,
+    KEYWORD_DOUBLE,
+    KEYWORD_ELSE,
+    KEYWORD_ENUM,
+    KEYWORD_EXTERN,
+    KEYWORD_FLOAT,
+    KEYWORD_FOR,
+    KEYWORD_GOTO,
+    KEYWORD_IF,
+    KEYWORD_INLINE,
+    KEYWORD_INT,
+    KEYWORD_LONG,
+    KEYWORD_REGISTER,
+    KEYWORD_RESTRICT,
+    KEYWORD_RETURN,
+    KEYWORD_SHORT,
+    KEYWORD_SIGNED,
+    KEYWORD_SIZEOF,
+    KEYWORD_STATIC,
+    KEYWORD_STRUCT,
+    KEYWORD_SWITCH,
+    KEYWORD_TYPEDEF,
+    KEYWORD_UNION,
+    KEYWORD_UNSIGNED,
+    KEYWORD_VOID,
+    KEYWORD_VOLATILE,
+    KEYWORD_WHILE,
+    KEYWORD_ALIGNAS,
+    KEYWORD_ALIGNOF,
+    KEYWORD_BOOL,
+    KEYWORD_CONSTEXPR,
+    KEYWORD_FALSE,
+    KEYWORD_NULLPTR,
+    KEYWORD_STATIC_ASSERT,
+    KEYWORD_THREAD_LOCAL,
+    KEYWORD_TRUE,
+    KEYWORD_TYPEOF,
+    KEYWORD_TYPEOF_UNQUAL,
+    KEYWORD__ALIGNAS,
+    KEYWORD__ALIGNOF,
+    KEYWORD__ATOMIC,
+    KEYWORD__BITINT,
+    KEYWORD__BOOL,
+    KEYWORD__COMPLEX,
+    KEYWORD__DECIMAL128,
+    KEYWORD__DECIMAL32,
+    KEYWORD__DECIMAL64,
+    KEYWORD__GENERIC,
+    KEYWORD__IMAGINARY,
+    KEYWORD__NORETURN,
+    KEYWORD__STATIC_ASSERT,
+    KEYWORD__THREAD_LOCAL,
+
+    PUNCT_L_SQUARE,         ///< `[` or `<:`
+    PUNCT_R_SQUARE,         ///< `]` or `:>`
+    PUNCT_L_PAREN,
+    PUNCT_R_PAREN,
+    PUNCT_L_BRACE,          ///< `{` or `<%`
+    PUNCT_R_BRACE,          ///< `}` or `%>`
+    PUNCT_PERIOD,
+    PUNCT_ARROW,
+    PUNCT_PLUS_PLUS,
+    PUNCT_MINUS_MINUS,
+    PUNCT_AMP,
+    PUNCT_STAR,
+    PUNCT_PLUS,
+    PUNCT_MINUS,
+    PUNCT_TILDE,
+    PUNCT_EXCLAIM,
+    PUNCT_SLASH,
+    PUNCT_PERCENT,
+    PUNCT_LESS_LESS,
+    PUNCT_GREATER_GREATER,
+    PUNCT_LESS,
+    PUNCT_GREATER,
+    PUNCT_LESS_EQUAL,
+    PUNCT_GREATER_EQUAL,
+    PUNCT_EQUAL_EQUAL,
+    PUNCT_EXCLAIM_EQUAL,
+    PUNCT_CARET,
+    PUNCT_PIPE,
+    PUNCT_AMP_AMP,
+    PUNCT_PIPE_PIPE,
+    PUNCT_QUESTION,
+    PUNCT_COLON,
+    PUNCT_COLON_COLON,
+    PUNCT_SEMI,
+    PUNCT_ELLIPSIS,
+    PUNCT_EQUAL,
+    PUNCT_STAR_EQUAL,
+    PUNCT_SLASH_EQUAL,
+    PUNCT_PERCENT_EQUAL,
+    PUNCT_PLUS_EQUAL,
+    PUNCT_MINUS_EQUAL,
+    PUNCT_LESS_LESS_EQUAL,
+    PUNCT_GREATER_GREATER_EQUAL,
+    PUNCT_AMP_EQUAL,
+    PUNCT_CARET_EQUAL,
+    PUNCT_PIPE_EQUAL,
+    PUNCT_COMMA,
+    PUNCT_HASH,             ///< `#` or `%:`
+    PUNCT_HASH_HASH,        ///< `##` or `%:%:`
+
+    KEYWORD_FIRST = KEYWORD_AUTO,
+    KEYWORD_LAST = KEYWORD__THREAD_LOCAL,
+};
+
+/**
+ * @brief Number of keywords.
+ */
+inline constexpr ca_size_t C_KEYWORD_COUNT =
+    static_cast<ca_size_t>(CTokenKind::KEYWORD_LAST) - static_cast<ca_size_t>(CTokenKind::KEYWORD_FIRST) + 1;
+
+/**
+ * @brief Spellings of the keywords, in the order of their kinds.
+ */
+extern const char *const C_KEYWORD_SPELLINGS[C_KEYWORD_COUNT];
+
+/**
+ * @brief Checks if a token kind is a keyword.
+ */
+constexpr bool
+c_is_keyword(const CTokenKind kind) {
+    return kind >= CTokenKind::KEYWORD_FIRST && kind <= CTokenKind::KEYWORD_LAST;
+}
+
+/**
+ * @brief Returns a printable name of a token kind, such as `identifier`,
+ *        `int` or `+=`.
+ */
+const char *
+c_token_kind_name(CTokenKind kind);
+
+/**
+ * @brief Flags of a token.
+ */
+inline constexpr ca_uint8_t C_TOKEN_LINE_START = 0x01;      ///< First token of its line.
+inline constexpr ca_uint8_t C_TOKEN_SPACE_BEFORE = 0x02;    ///< Preceded by whitespace or a comment.
+
+/**
+ * @struct CTokenStream
+ * @brief The tokens of one source buffer, stored as parallel arrays.
+ *
+ * Token `i` is described by `kinds[i]`, `offsets[i]`, `lengths[i]`,
+ * `ids[i]` and `flags[i]`, so a pass that only looks at kinds streams
+ * through one byte per token. Tokens do not keep a pointer to the source;
+ * their text is `source + offsets[i]` for `length(i)` bytes.
+ *
+ * Lengths are stored in 16 bits. The few longer tokens (long string
+ * literals, mostly) store `LONG_LENGTH` and keep their length in a side
+ * table.
+ */
+struct CTokenStream {
+    /**
+     * @typedef id_type
+     * @brief Type of the interned spellings.
+     */
+    typedef ca_string::ca_intern_pool::id_type id_type;
+
+    /**
+     * @brief Marker stored in `lengths` for tokens of 65535 bytes or more.
+     */
+    static constexpr ca_uint16_t LONG_LENGTH = 0xFFFF;
+
+    std::vector<CTokenKind> kinds;          ///< Kind of each token.
+    std::vector<ca_uint32_t> offsets;       ///< Byte offset of each token in the source.
+    std::vector<ca_uint16_t> lengths;       ///< Length of each token in bytes, or `LONG_LENGTH`.
+    std::vector<id_type> ids;               ///< Interned spelling of identifiers and keywords, `INVALID_ID` otherwise.
+    std::vector<ca_uint8_t> flags;          ///< `C_TOKEN_*` flags of each token.
+
+    std::unordered_map<ca_uint32_t, ca_uint32_t> long_lengths;      ///< Token index to length, for `LONG_LENGTH`.
+
+    /**
+     * @brief Returns the number of tokens, including the final `TOKEN_END`.
+     */
+    [[nodiscard]] ca_size_t
+    size() const {
+        return kinds.size();
+    }
+
+    /**
+     * @brief Returns the length of a token in bytes.
+     */
+    [[nodiscard]] ca_uint32_t
+    length(const ca_size_t index) const {
+        const ca_uint16_t length = lengths[index];
+        return length != LONG_LENGTH ? length : long_lengths.at(static_cast<ca_uint32_t>(index));
+    }
+
+    /**
+     * @brief Appends a token.
+     */
+    void
+    push(CTokenKind kind, ca_uint32_t offset, ca_uint32_t length, id_type id, ca_uint8_t token_flags);
+
+    /**
+     * @brief Reserves room for a number of tokens.
+     */
+    void
+    reserve(ca_size_t count);
+
+    /**
+     * @brief Removes all tokens, keeping the allocated memory.
+     */
+    void
+    clear();
+
+    /**
+     * @brief Returns the number of bytes allocated by the arrays.
+     */
+    [[nodiscard]] ca_size_t
+    memory_usage() const;
+};
+
+}
+
+#endif //CTOKEN_H
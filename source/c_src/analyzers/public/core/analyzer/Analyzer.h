@@ -1,8 +1,149 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/core/analyzer/Analyzer.h
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Defines `Analyzer`, the project-level driver that analyzes every
+//        translation unit of a project on a pool of work-stealing threads.
+// ================================
 
 #ifndef ANALYZER_H
 #define ANALYZER_H
 
+#include "IAnalyzer.h"
+#include "context/AnalysisContext.h"
+#include "report/AnalysisResult.h"
+#include "ca_math.h"
+
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ca::ca_task {
+struct ca_task_pool;
+}
+
+namespace ca::analyzers {
+
+/**
+ * @struct AnalyzerOptions
+ * @brief Controls an `Analyzer`.
+ */
+struct AnalyzerOptions {
+    /**
+     * @brief Number of worker threads, 0 for one per hardware thread. Always
+     *        1 when built without ENABLE_THREADING.
+     */
+    ca_size_t threads = 0;
+
+    /**
+     * @brief Whether to start with the largest units, so that no large unit
+     *        is left alone at the end of the run.
+     */
+    bool largest_first = true;
+
+    /**
+     * @brief Whether to pin the worker threads to CPUs, see
+     *        `ca_task_pool_options::pin_threads`.
+     */
+    bool pin_threads = false;
+};
+
+/**
+ * @struct AnalyzerStats
+ * @brief Counters of the last run of an `Analyzer`.
+ */
+struct AnalyzerStats {
+    ca_size_t threads;              ///< Worker threads used.
+    ca_size_t units;                ///< Units analyzed, including failed ones.
+    ca_size_t failures;             ///< Units that could not be analyzed.
+    ca_size_t steals;               ///< Ranges of units taken from the queue of another worker.
+    ca_uint64_t bytes;              ///< Bytes of the units analyzed.
+    ca_uint64_t avoided_reads;      ///< Includes skipped because the header's guard was defined.
+    ca_uint64_t nanoseconds;        ///< Wall time of the run.
+    ca_uint64_t busy_nanoseconds;   ///< Time the workers spent in units, summed.
+};
+
+/**
+ * @class Analyzer
+ * @brief Runs a language analyzer over every unit of a project in parallel.
+ *
+ * Every worker thread owns an `IAnalyzer`, made by the factory on the worker
+ * itself the first time it runs, and an `AnalysisContext`. Both live as
+ * long as the driver, so the parsers, trees and arenas they hold are reused
+ * from unit to unit and from run to run, and no state is shared between
+ * workers. The calling thread is worker 0; the others are the threads of a
+ * `ca_task_pool` owned by the driver, started once for all runs.
+ *
+ * The units are sorted largest first and split with `ca_parallel_for`: each
+ * worker walks its ranges from their large end, and idle workers steal the
+ * ranges still queued, so the run ends with small units that balance well.
+ *
+ * Each result is pushed to an `AnalysisResultSink` as soon as its unit is
+ * done, in completion order.
+ */
+class Analyzer {
+public:
+    /**
+     * @typedef factory_type
+     * @brief Makes the analyzer of a worker, given the index of the worker.
+     */
+    typedef std::function<std::unique_ptr<IAnalyzer>(ca_size_t)> factory_type;
+
+    /**
+     * @brief Constructs a driver.
+     *
+     * @param factory Makes the analyzer of each worker.
+     * @param options The options.
+     */
+    explicit Analyzer(factory_type factory, const AnalyzerOptions &options = {});
+
+    ~Analyzer();
+
+    Analyzer(const Analyzer &) = delete;
+    Analyzer &operator=(const Analyzer &) = delete;
+
+    /**
+     * @brief Analyzes units, returning when all are done.
+     *
+     * @param files [in] Paths of the units.
+     * @param sink [out] Receives one result per unit. Must not be `nullptr`
+     *             and must have room for every unit.
+     * @return
+     * - `0` if every unit was analyzed.
+     * - `-1` if some unit failed, or if the sink is too small, in which case
+     *   nothing is analyzed.
+     */
+    int
+    run(std::span<const std::string> files, AnalysisResultSink *sink);
+
+    /**
+     * @brief Returns the number of workers a run may use.
+     */
+    [[nodiscard]] ca_size_t
+    threads() const {
+        return workers.size();
+    }
+
+    /**
+     * @brief Returns the counters of the last run.
+     */
+    [[nodiscard]] const AnalyzerStats &
+    stats() const {
+        return last_stats;
+    }
+
+private:
+    struct Worker;
+
+    factory_type make_analyzer;                     ///< The factory.
+    AnalyzerOptions options;                        ///< The options.
+    std::vector<std::unique_ptr<Worker>> workers;   ///< One state per worker.
+    std::unique_ptr<ca_task::ca_task_pool> pool;    ///< Threads of the workers but 0, if any.
+    AnalyzerStats last_stats;                       ///< Counters of the last run.
+};
+
+}
+
 #endif //ANALYZER_H
@@ -1,8 +1,131 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/core/context/AnalysisContext.h
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Defines `AnalysisContext`, the state a worker thread of the driver
+//        keeps across the units it analyzes, including its scratch arena.
+// ================================
 
 #ifndef ANALYSISCONTEXT_H
 #define ANALYSISCONTEXT_H
 
+#include "ca_arena.h"
+#include "ca_arena_resource.h"
+#include "ca_math.h"
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace ca::analyzers {
+
+/**
+ * @class AnalysisContext
+ * @brief Per-worker state of an analysis.
+ *
+ * Every worker of the driver owns one context and passes it to each unit it
+ * analyzes, so nothing in it is shared between threads. The context holds a
+ * `ca_arena` for the scratch data of the current unit: `allocate` hands out
+ * memory from large chunks and `begin_unit` releases all of it at once
+ * before the next unit, keeping the largest chunk so a worker stops
+ * allocating once it has seen its largest unit. `memory_resource` lets
+ * `std::pmr` containers of a stage use the same arena.
+ *
+ * Objects placed in the arena are never destroyed, so they must be
+ * trivially destructible or own nothing, and containers using
+ * `memory_resource` must be gone by the end of the unit.
+ */
+class AnalysisContext {
+public:
+    /**
+     * @brief Size of the first chunk of the arena.
+     */
+    static constexpr ca_size_t MIN_CHUNK_SIZE = ca_misc::ca_arena::MIN_CHUNK_SIZE;
+
+    /**
+     * @brief Constructs the context of a worker.
+     *
+     * @param worker The index of the worker.
+     */
+    explicit AnalysisContext(ca_size_t worker = 0);
+
+    AnalysisContext(const AnalysisContext &) = delete;
+    AnalysisContext &operator=(const AnalysisContext &) = delete;
+
+    /**
+     * @brief Returns the index of the worker owning the context.
+     */
+    [[nodiscard]] ca_size_t
+    worker() const {
+        return index;
+    }
+
+    /**
+     * @brief Releases the scratch memory of the previous unit.
+     */
+    void
+    begin_unit();
+
+    /**
+     * @brief Allocates scratch memory valid until the next `begin_unit`.
+     *
+     * @param size Number of bytes.
+     * @param alignment Alignment, a power of two.
+     * @return The memory, never `nullptr`.
+     */
+    void *
+    allocate(const ca_size_t size, const ca_size_t alignment = alignof(std::max_align_t)) {
+        return scratch.allocate(size, alignment);
+    }
+
+    /**
+     * @brief Allocates an uninitialized array in the scratch memory.
+     */
+    template<typename T>
+    T *
+    allocate_array(const ca_size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Returns the number of units begun.
+     */
+    [[nodiscard]] ca_size_t
+    units() const {
+        return num_units;
+    }
+
+    /**
+     * @brief Returns the number of bytes held by the arena.
+     */
+    [[nodiscard]] ca_size_t
+    arena_capacity() const {
+        return scratch.capacity();
+    }
+
+    /**
+     * @brief Returns the arena of the scratch memory.
+     */
+    [[nodiscard]] ca_misc::ca_arena &
+    arena() {
+        return scratch;
+    }
+
+    /**
+     * @brief Returns a memory resource allocating scratch memory, for
+     *        `std::pmr` containers that live until the next `begin_unit`.
+     */
+    [[nodiscard]] std::pmr::memory_resource *
+    memory_resource() {
+        return &resource;
+    }
+
+private:
+    ca_size_t index;                        ///< Index of the worker.
+    ca_size_t num_units;                    ///< Units begun.
+    ca_misc::ca_arena scratch;              ///< The scratch memory.
+    ca_misc::ca_arena_resource resource;    ///< `scratch` as a memory resource.
+};
+
+}
+
 #endif //ANALYSISCONTEXT_H
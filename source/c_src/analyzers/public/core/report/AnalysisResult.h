@@ -1,8 +1,125 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/public/core/report/AnalysisResult.h
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Defines `AnalysisResult`, the outcome of analyzing one translation
+//        unit, and `AnalysisResultSink`, which collects the results of all
+//        workers without locking.
+// ================================
 
 #ifndef ANALYSISRESULT_H
 #define ANALYSISRESULT_H
 
+#include "ca_math.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace ca::analyzers {
+
+/**
+ * @struct AnalysisResult
+ * @brief Outcome of the analysis of one translation unit.
+ */
+struct AnalysisResult {
+    std::string path;               ///< Path of the unit.
+    ca_size_t unit = 0;             ///< Index of the unit in the list given to the driver.
+    int status = 0;                 ///< `0` if the unit was analyzed, `-1` otherwise.
+    std::string error;              ///< Why the unit was not analyzed, if `status` is `-1`.
+    ca_size_t worker = 0;           ///< Index of the worker that analyzed the unit.
+    ca_uint64_t bytes = 0;          ///< Size of the unit.
+    ca_uint64_t tokens = 0;         ///< Tokens of the unit.
+    ca_uint64_t nodes = 0;          ///< Syntax tree nodes of the unit.
+    ca_uint64_t syntax_errors = 0;  ///< Syntax errors recovered from.
+    ca_uint64_t headers = 0;        ///< Headers the unit includes, directly or not.
+    ca_uint64_t avoided_reads = 0;  ///< Includes skipped because the header's guard was defined.
+    ca_uint64_t findings = 0;       ///< Findings reported by the passes.
+    ca_uint64_t nanoseconds = 0;    ///< Time spent on the unit.
+};
+
+/**
+ * @class AnalysisResultSink
+ * @brief Fixed-capacity collection of results, filled concurrently.
+ *
+ * A producer claims the next slot with one atomic increment, moves its
+ * result in, then publishes the slot. No lock is taken and producers never
+ * wait for each other. Slots are cache-line aligned so producers writing
+ * neighbouring slots do not share a line.
+ *
+ * Results can be read while producers run: slot `i` is readable once
+ * `ready(i)` returns true, and stays unchanged afterwards.
+ */
+class AnalysisResultSink {
+public:
+    /**
+     * @brief Constructs an empty sink.
+     *
+     * @param capacity The maximum number of results.
+     */
+    explicit AnalysisResultSink(ca_size_t capacity);
+
+    AnalysisResultSink(const AnalysisResultSink &) = delete;
+    AnalysisResultSink &operator=(const AnalysisResultSink &) = delete;
+
+    /**
+     * @brief Adds a result. Thread-safe.
+     *
+     * @param result [in] The result, moved from.
+     * @return `0` on success, `-1` if the sink is full.
+     */
+    int
+    push(AnalysisResult &&result);
+
+    /**
+     * @brief Returns the number of slots claimed so far, at most the capacity.
+     */
+    [[nodiscard]] ca_size_t
+    size() const;
+
+    /**
+     * @brief Returns the capacity.
+     */
+    [[nodiscard]] ca_size_t
+    capacity() const {
+        return num_slots;
+    }
+
+    /**
+     * @brief Checks if a slot holds a published result.
+     */
+    [[nodiscard]] bool
+    ready(ca_size_t index) const;
+
+    /**
+     * @brief Returns a published result.
+     *
+     * @param index The slot. `ready(index)` must be true.
+     */
+    [[nodiscard]] const AnalysisResult &
+    operator[](ca_size_t index) const;
+
+    /**
+     * @brief Removes every result. Not thread-safe.
+     */
+    void
+    clear();
+
+private:
+    /**
+     * @struct Slot
+     * @brief One result and its publication flag.
+     */
+    struct alignas(64) Slot {
+        AnalysisResult result;
+        std::atomic<bool> published{ false };
+    };
+
+    ca_size_t num_slots;                ///< Number of slots.
+    std::unique_ptr<Slot[]> slots;      ///< The slots.
+    std::atomic<ca_size_t> claimed;     ///< Number of slots claimed, may exceed `num_slots`.
+};
+
+}
+
 #endif //ANALYSISRESULT_H
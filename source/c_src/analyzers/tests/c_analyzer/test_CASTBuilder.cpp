@@ -0,0 +1,261 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/tests/c_analyzer/test_CASTBuilder.cpp
+//
+// @file
+// @brief Tests the C parser and the compact syntax tree it builds.
+// ================================
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/parser/CASTBuilder.h"
+
+using namespace ca;
+using namespace ca::analyzers::c;
+
+namespace {
+
+class CASTBuilderTest : public ::testing::Test {
+protected:
+    CASTBuilderTest() : builder(&pool) {}
+
+    void build(const std::string_view text) {
+        source = text;
+        ASSERT_EQ(builder.build(reinterpret_cast<const ca_string::ca_char_t*>(source.data()), source.size(), &ast), 0);
+        ASSERT_NE(ast.root(), CAst::INVALID_INDEX);
+    }
+
+    /**
+     * @brief Prints a subtree as `(kind:token child...)`.
+     */
+    std::string dump(const CAst::index_type index) const {
+        const CAstNode &node = ast.node(index);
+        std::string result = "(";
+        result += c_node_kind_name(node.kind);
+        if (node.token != CAst::INVALID_INDEX) {
+            result += ":";
+            result += std::string_view(source).substr(ast.tokens.offsets[node.token], ast.tokens.length(node.token));
+        }
+        for (const CAst::index_type child : ast.children(index)) {
+            EXPECT_GT(child, index);
+            EXPECT_LE(ast.node(child).subtree_end, node.subtree_end);
+            result += " " + dump(child);
+        }
+        return result + ")";
+    }
+
+    /**
+     * @brief Returns the children of a node as a vector.
+     */
+    std::vector<CAst::index_type> children(const CAst::index_type index) const {
+        const CAstChildren range = ast.children(index);
+        return { range.begin(), range.end() };
+    }
+
+    /**
+     * @brief Dumps the only top-level node.
+     */
+    std::string dump_single() const {
+        const std::vector<CAst::index_type> top = children(ast.root());
+        EXPECT_EQ(top.size(), 1u);
+        return top.empty() ? std::string() : dump(top[0]);
+    }
+
+    ca_string::ca_intern_pool pool;
+    CASTBuilder builder;
+    CAst ast;
+    std::string source;
+};
+
+}
+
+TEST_F(CASTBuilderTest, Build_FunctionDefinition) {
+    build("static int add(int a, const char *b, ...) {\n"
+          "    int s = a + b[0] * 2, t;\n"
+          "    for (int i = 0; i < a; ++i) s += f(i, &t)->x;\n"
+          "    if (s > 1) return s; else goto done;\n"
+          "done:\n"
+          "    return (int)sizeof(struct point) + sizeof s;\n"
+          "}\n");
+    EXPECT_EQ(dump_single(),
+              "(function-definition:add (parameter:a) (parameter:b) (compound "
+              "(declaration (declarator:s (binary:+ (name:a) (binary:* (subscript (name:b) (number:0)) (number:2)))) "
+              "(declarator:t)) "
+              "(for (declaration (declarator:i (number:0))) (binary:< (name:i) (name:a)) (unary:++ (name:i)) "
+              "(expression-statement (binary:+= (name:s) (member:x (call:f (name:f) (name:i) (unary:& (name:t))))))) "
+              "(if (binary:> (name:s) (number:1)) (return (name:s)) (goto:done)) "
+              "(label:done (return (binary:+ (cast (type-name) (sizeof-type:sizeof (type-name))) "
+              "(unary:sizeof (name:s)))))))");
+
+    const CAstNode &definition = ast.node(children(ast.root())[0]);
+    EXPECT_EQ(definition.flags & (C_NODE_STATIC | C_NODE_FUNCTION | C_NODE_VARIADIC),
+              C_NODE_STATIC | C_NODE_FUNCTION | C_NODE_VARIADIC);
+    EXPECT_EQ(definition.first_token, 0u);
+    EXPECT_EQ(definition.last_token, ast.tokens.size() - 2);
+    EXPECT_EQ(builder.stats().errors, 0u);
+}
+
+TEST_F(CASTBuilderTest, Build_DeclarationsAndTypedefs) {
+    build("typedef struct node { int v : 3; struct node *next; } node_t, *node_p;\n"
+          "enum color { RED, GREEN = 2 };\n"
+          "void (*signal(int sig, void (*handler)(int)))(int);\n"
+          "node_t *head = &(node_t){ .v = 1, [0] = 2 };\n"
+          "void f(void) { node_t * p; x * y; }\n");
+    const auto top = children(ast.root());
+    ASSERT_EQ(top.size(), 5u);
+    EXPECT_EQ(dump(top[0]),
+              "(declaration (record:node (declaration (declarator:v (number:3))) (declaration (declarator:next))) "
+              "(declarator:node_t) (declarator:node_p))");
+    EXPECT_TRUE(ast.node(top[0]).flags & C_NODE_TYPEDEF);
+    EXPECT_EQ(dump(top[1]), "(declaration (enum:color (enumerator:RED) (enumerator:GREEN (number:2))))");
+    EXPECT_EQ(dump(top[2]), "(declaration (declarator:signal (parameter:sig) (parameter:handler)))");
+    EXPECT_TRUE(ast.node(children(top[2])[0]).flags & C_NODE_FUNCTION);
+    EXPECT_EQ(dump(top[3]),
+              "(declaration (declarator:head (unary:& (compound-literal (type-name) "
+              "(init-list (designation (number:1)) (designation (number:0) (number:2)))))))");
+    // A known typedef makes a declaration, an unknown name an expression
+    EXPECT_EQ(dump(top[4]),
+              "(function-definition:f (parameter) (compound (declaration (declarator:p)) "
+              "(expression-statement (binary:* (name:x) (name:y)))))");
+}
+
+TEST_F(CASTBuilderTest, Build_UnknownTypeNames) {
+    build("void f(void) { U32 *const a = (U32 *)p; BYTE *b = (BYTE)c; const T *d; (x) - y; (T const *)e; }\n");
+    EXPECT_EQ(dump_single(),
+              "(function-definition:f (parameter) (compound "
+              "(declaration (declarator:a (cast (type-name) (name:p)))) "
+              "(declaration (declarator:b (cast (type-name) (name:c)))) "
+              "(declaration (declarator:d)) "
+              "(expression-statement (binary:- (name:x) (name:y))) "
+              "(expression-statement (cast (type-name) (name:e)))))");
+    EXPECT_EQ(builder.stats().errors, 0u);
+}
+
+TEST_F(CASTBuilderTest, Build_StatementsAndDirectives) {
+    build("#include <stdio.h>\n"
+          "#define MAX(a, b) ((a) > (b) ? (a) : (b))\n"
+          "int main(int argc, char **argv) {\n"
+          "    switch (argc) { case 1: break; case 2 ... 3: default: ; }\n"
+          "    do { argc--; } while (argc);\n"
+          "    while (1) continue;\n"
+          "    printf(\"%\" PRIu64 \"\\n\", va_arg(ap, unsigned long));\n"
+          "    LOG_DEBUG(\"no semicolon\")\n"
+          "    return MAX(argc, 0) ?: x;\n"
+          "}\n");
+    EXPECT_EQ(dump_single(),
+              "(function-definition:main (parameter:argc) (parameter:argv) (compound "
+              "(switch (name:argc) (compound (case (number:1) (break)) "
+              "(case (number:2) (number:3) (default (null-statement))))) "
+              "(do (compound (expression-statement (postfix:-- (name:argc)))) (name:argc)) "
+              "(while (number:1) (continue)) "
+              "(expression-statement (call:printf (name:printf) (string:\"%\") "
+              "(call:va_arg (name:va_arg) (name:ap) (type-name)))) "
+              "(expression-statement (call:LOG_DEBUG (name:LOG_DEBUG) (string:\"no semicolon\"))) "
+              "(return (conditional (call:MAX (name:MAX) (name:argc) (number:0)) (name:x)))))");
+    EXPECT_EQ(builder.stats().errors, 0u);
+}
+
+TEST_F(CASTBuilderTest, Build_RecoversFromErrors) {
+    build("int a = ;\n"
+          "int f(void) { int x = (1 + ; return 2; }\n"
+          "}\n"
+          "int b;\n");
+    const auto top = children(ast.root());
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_TRUE(ast.node(top[0]).flags & C_NODE_RECOVERED);
+    EXPECT_EQ(ast.node(top[1]).kind, CNodeKind::NODE_FUNCTION_DEFINITION);
+    EXPECT_TRUE(ast.node(top[1]).flags & C_NODE_RECOVERED);
+    EXPECT_EQ(dump(top[2]), "(declaration (declarator:b))");
+    EXPECT_GT(builder.stats().errors, 0u);
+}
+
+TEST_F(CASTBuilderTest, Build_LimitsNesting) {
+    // Valid but absurdly deep input is cut off instead of overflowing the stack
+    const std::string parens = "int x = " + std::string(50000, '(') + "1" + std::string(50000, ')') + ";\n";
+    const std::string braces = "void f(void) " + std::string(200000, '{') + std::string(200000, '}') + "\n";
+    std::string unary = "int y = ";
+    for (int i = 0; i < 100000; ++i) {
+        unary += "- ";
+    }
+    unary += "1;\n";
+    build(parens + braces + unary + "int z;\n");
+
+    const auto top = children(ast.root());
+    ASSERT_EQ(top.size(), 4u);
+    EXPECT_EQ(ast.node(top[0]).kind, CNodeKind::NODE_DECLARATION);
+    EXPECT_EQ(ast.node(top[1]).kind, CNodeKind::NODE_FUNCTION_DEFINITION);
+    EXPECT_EQ(ast.node(top[2]).kind, CNodeKind::NODE_DECLARATION);
+    EXPECT_EQ(dump(top[3]), "(declaration (declarator:z))");
+    EXPECT_EQ(ast.nodes_of_kind(CNodeKind::NODE_ERROR).size(), 3u);
+    EXPECT_EQ(builder.stats().errors, 3u);
+    EXPECT_LE(ast.nodes_of_kind(CNodeKind::NODE_COMPOUND).size(), CASTBuilder::MAX_NESTING);
+
+    // Nesting within the limit parses as usual
+    build("int w = " + std::string(300, '(') + "1" + std::string(300, ')') + ";\n");
+    EXPECT_TRUE(ast.nodes_of_kind(CNodeKind::NODE_ERROR).empty());
+}
+
+TEST_F(CASTBuilderTest, Ast_PreOrderLayout) {
+    build("int f(int a) { return g(a, h(1)) + a; }\n"
+          "int x = k(2);\n");
+
+    // Every node is followed by its subtree, which nests in its parent's
+    const CAst::index_type root = ast.root();
+    EXPECT_EQ(root, 0u);
+    EXPECT_EQ(ast.node(root).kind, CNodeKind::NODE_TRANSLATION_UNIT);
+    EXPECT_EQ(ast.node(root).subtree_end, ast.size());
+    for (CAst::index_type i = 0; i < ast.size(); ++i) {
+        CAst::index_type end = i + 1;
+        for (const CAst::index_type child : ast.children(i)) {
+            EXPECT_EQ(child, end);
+            end = ast.node(child).subtree_end;
+        }
+        EXPECT_EQ(end, ast.node(i).subtree_end);
+    }
+
+    // The calls in pre-order, without visiting other nodes
+    std::string callees;
+    for (const CAst::index_type call : ast.nodes_of_kind(CNodeKind::NODE_CALL)) {
+        EXPECT_EQ(ast.node(call).kind, CNodeKind::NODE_CALL);
+        callees += dump(call) + " ";
+    }
+    EXPECT_EQ(callees, "(call:g (name:g) (name:a) (call:h (name:h) (number:1))) (call:h (name:h) (number:1)) "
+                       "(call:k (name:k) (number:2)) ");
+
+    // Skipping the subtree of the function definition lands on the declaration
+    const CAst::index_type definition = ast.nodes_of_kind(CNodeKind::NODE_FUNCTION_DEFINITION)[0];
+    EXPECT_EQ(definition, 1u);
+    EXPECT_EQ(dump(ast.node(definition).subtree_end), "(declaration (declarator:x (call:k (name:k) (number:2))))");
+
+    ca_size_t total = 0;
+    for (ca_size_t k = 0; k < C_NODE_KIND_COUNT; ++k) {
+        total += ast.nodes_of_kind(static_cast<CNodeKind>(k)).size();
+    }
+    EXPECT_EQ(total, ast.size());
+}
+
+TEST_F(CASTBuilderTest, Ast_CompactNodes) {
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text += "int f" + std::to_string(i) + "(int a, int b) { if (a < b) return g(a, b + 1) * 2; return a; }\n";
+    }
+    build(text);
+
+    EXPECT_EQ(ast.nodes_of_kind(CNodeKind::NODE_FUNCTION_DEFINITION).size(), 200u);
+    EXPECT_EQ(ast.nodes_of_kind(CNodeKind::NODE_CALL).size(), 200u);
+#ifndef CA_ENABLE_64BIT_INDEX
+    // A node record and its entry in the kind lists
+    EXPECT_EQ(sizeof(CAstNode), 20u);
+    EXPECT_DOUBLE_EQ(ast.bytes_per_node(), 24.0);
+#endif
+    EXPECT_GE(ast.memory_usage(), ast.size() * sizeof(CAstNode));
+
+    // Resetting keeps the memory for the next unit
+    const ca_size_t memory = ast.memory_usage();
+    ast.reset();
+    EXPECT_EQ(ast.size(), 0u);
+    EXPECT_EQ(ast.root(), CAst::INVALID_INDEX);
+    EXPECT_TRUE(ast.nodes_of_kind(CNodeKind::NODE_CALL).empty());
+    EXPECT_EQ(ast.memory_usage(), memory);
+}
@@ -0,0 +1,138 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/tests/c_analyzer/test_CAnalyzer.cpp
+//
+// @file
+// @brief Tests the C pipeline, alone and under the parallel driver.
+// ================================
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "analyzer/Analyzer.h"
+#include "core/CAnalyzer.h"
+#include "ca_test_temp_dir.h"
+
+using namespace ca;
+using namespace ca::analyzers;
+using namespace ca::analyzers::c;
+
+namespace {
+
+class CAnalyzerTest : public ca_test::ca_temp_dir_test<> {
+};
+
+/**
+ * @brief Makes an analyzer whose style stage counts the calls of each unit.
+ */
+std::unique_ptr<CAnalyzer> make_call_counter() {
+    auto analyzer = std::make_unique<CAnalyzer>();
+    analyzer->add_pass(CAnalysisStage::STAGE_STYLE, [](const CAst &ast, AnalysisContext &, AnalysisResult &result) {
+        result.findings += ast.nodes_of_kind(CNodeKind::NODE_CALL).size();
+    });
+    return analyzer;
+}
+
+}
+
+TEST_F(CAnalyzerTest, Analyze_RunsStagesInOrder) {
+    const std::string path = write_file("a.c", "int main(void) { f(g(1)); return h(); }\n");
+    CAnalyzer analyzer;
+    std::string order;
+    analyzer.add_pass(CAnalysisStage::STAGE_STYLE, [&order](const CAst &, AnalysisContext &, AnalysisResult &) {
+        order += "9";
+    });
+    analyzer.add_pass(CAnalysisStage::STAGE_AST, [&order](const CAst &ast, AnalysisContext &context, AnalysisResult &) {
+        EXPECT_EQ(ast.node(ast.root()).kind, CNodeKind::NODE_TRANSLATION_UNIT);
+        EXPECT_NE(context.allocate(64), nullptr);
+        order += "1";
+    });
+    analyzer.add_pass(CAnalysisStage::STAGE_SYMBOLS, [&order](const CAst &, AnalysisContext &, AnalysisResult &) {
+        order += "4";
+    });
+    analyzer.add_pass(CAnalysisStage::STAGE_AST, [&order](const CAst &, AnalysisContext &, AnalysisResult &) {
+        order += "1";
+    });
+
+    AnalysisContext context;
+    AnalysisResult result;
+    ASSERT_EQ(analyzer.analyze(path, context, &result), 0);
+    EXPECT_EQ(order, "1149");
+    EXPECT_EQ(result.bytes, std::filesystem::file_size(path));
+    EXPECT_EQ(result.tokens, analyzer.ast().tokens.size());
+    EXPECT_EQ(result.nodes, analyzer.ast().size());
+    EXPECT_EQ(result.syntax_errors, 0u);
+    EXPECT_EQ(analyzer.text().size(), result.bytes);
+}
+
+TEST_F(CAnalyzerTest, Analyze_MissingFile) {
+    CAnalyzer analyzer;
+    AnalysisContext context;
+    AnalysisResult result;
+    EXPECT_EQ(analyzer.analyze((dir / "missing.c").string(), context, &result), -1);
+    EXPECT_EQ(result.error, "file not found");
+    EXPECT_EQ(analyzer.ast().size(), 0u);
+}
+
+TEST_F(CAnalyzerTest, Analyze_FollowsIncludesBeforeStage2) {
+    write_file("config.h", "#define USE_IO 1\n");
+    write_file("io.h", "int put(const char *text);\n");
+    const std::string path = write_file("a.c",
+                                        "#include \"config.h\"\n"
+                                        "#if USE_IO\n"
+                                        "#include \"io.h\"\n"
+                                        "#endif\n"
+                                        "int main(void) { return put(\"hi\"); }\n");
+    CAnalyzer analyzer;
+    ca_size_t headers_seen = 0;
+    analyzer.add_pass(CAnalysisStage::STAGE_INCLUDES, [&](const CAst &, AnalysisContext &, AnalysisResult &) {
+        headers_seen = analyzer.unit_includes().headers.size();
+    });
+
+    AnalysisContext context;
+    for (int run = 0; run < 2; ++run) {
+        AnalysisResult result;
+        ASSERT_EQ(analyzer.analyze(path, context, &result), 0);
+        EXPECT_EQ(result.headers, 2u);
+        EXPECT_EQ(headers_seen, 2u);
+        EXPECT_EQ(analyzer.ast().nodes_of_kind(CNodeKind::NODE_CALL).size(), 1u);
+    }
+    EXPECT_EQ(analyzer.include_analyzer().stats().files_read, 2u);
+    EXPECT_EQ(analyzer.include_analyzer().stats().cache_hits, 2u);
+}
+
+TEST_F(CAnalyzerTest, Driver_MatchesSerialAnalysis) {
+    std::vector<std::string> files;
+    for (int i = 0; i < 60; ++i) {
+        std::string text;
+        for (int j = 0; j <= i % 7; ++j) {
+            text += "int f" + std::to_string(j) + "(int a) { return g(a) + h(a, " + std::to_string(i) + "); }\n";
+        }
+        files.push_back(write_file("unit" + std::to_string(i) + ".c", text));
+    }
+
+    // Serial reference
+    std::unique_ptr<CAnalyzer> serial = make_call_counter();
+    AnalysisContext context;
+    std::vector<AnalysisResult> expected(files.size());
+    for (ca_size_t i = 0; i < files.size(); ++i) {
+        ASSERT_EQ(serial->analyze(files[i], context, &expected[i]), 0);
+    }
+
+    AnalyzerOptions options;
+    options.threads = 3;
+    Analyzer driver([](ca_size_t) { return make_call_counter(); }, options);
+    AnalysisResultSink sink(files.size());
+    ASSERT_EQ(driver.run(files, &sink), 0);
+    ASSERT_EQ(sink.size(), files.size());
+    for (ca_size_t i = 0; i < sink.size(); ++i) {
+        const AnalysisResult &result = sink[i];
+        const AnalysisResult &reference = expected[result.unit];
+        EXPECT_EQ(result.bytes, reference.bytes);
+        EXPECT_EQ(result.tokens, reference.tokens);
+        EXPECT_EQ(result.nodes, reference.nodes);
+        EXPECT_EQ(result.findings, reference.findings);
+        EXPECT_EQ(result.findings, 2u * (result.unit % 7 + 1));
+    }
+}
@@ -0,0 +1,398 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/tests/c_analyzer/test_CIncludeAnalyzer.cpp
+//
+// @file
+// @brief Tests the include walk, the include graph and the header cache.
+// ================================
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/include/CIncludeAnalyzer.h"
+#include "ca_test_temp_dir.h"
+
+using namespace ca;
+using namespace ca::analyzers::c;
+
+namespace {
+
+class CIncludeAnalyzerTest : public ca_test::ca_temp_dir_test<> {
+protected:
+    CIncludeAnalyzerTest() : lexer(&pool) {}
+
+    void SetUp() override {
+        ca_temp_dir_test::SetUp();
+        std::filesystem::create_directories(dir / "inc");
+    }
+
+    /**
+     * @brief Makes the analyzer, searching `inc` for headers.
+     */
+    void make_analyzer(std::vector<std::string> defines = {}) {
+        CIncludeOptions options;
+        options.search_paths.push_back((dir / "inc").string());
+        options.defines = std::move(defines);
+        analyzer = std::make_unique<CIncludeAnalyzer>(&pool, options);
+    }
+
+    /**
+     * @brief Lexes a unit and analyzes its includes.
+     */
+    const CIncludeUnit &analyze(const std::string &path) {
+        if (analyzer == nullptr) {
+            make_analyzer();
+        }
+        std::ifstream in(path, std::ios::binary);
+        source.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        const auto *bytes = reinterpret_cast<const ca_string::ca_char_t*>(source.data());
+        EXPECT_EQ(lexer.lex(bytes, source.size(), &tokens), 0);
+        analyzer->analyze(path, bytes, tokens, &unit);
+        return unit;
+    }
+
+    ca_io::ca_path_id file_id(const std::string &name) const {
+        return ca_io::ca_path_table::global().intern((dir / name).string());
+    }
+
+    bool declares(const std::string_view name) const {
+        const CTokenStream::id_type id = pool.find(reinterpret_cast<const ca_string::ca_char_t*>(name.data()),
+                                                   name.size());
+        return std::binary_search(unit.declarations.begin(), unit.declarations.end(), id);
+    }
+
+    ca_string::ca_intern_pool pool;
+    CLexer lexer;
+    std::unique_ptr<CIncludeAnalyzer> analyzer;
+    CTokenStream tokens;
+    std::string source;
+    CIncludeUnit unit;
+};
+
+}
+
+TEST_F(CIncludeAnalyzerTest, Analyze_FollowsIncludesAndBuildsGraph) {
+    write_file("a.h", "#include \"b.h\"\nint from_a(void);\n");
+    write_file("b.h", "typedef int from_b;\nstruct tag { int member; };\n");
+    write_file("inc/sys.h", "extern int from_sys, also_sys = 1, *pointer;\n");
+    const std::string main = write_file("main.c",
+                                        "#include \"a.h\"\n"
+                                        "#include <sys.h>\n"
+                                        "#include <missing.h>\n"
+                                        "static int table[4] = { 1, 2 };\n"
+                                        "int main(void) { int local; return 0; }\n");
+
+    const CIncludeUnit &result = analyze(main);
+    EXPECT_EQ(result.file, file_id("main.c"));
+    EXPECT_EQ(result.headers, (std::vector{ file_id("a.h"), file_id("b.h"), file_id("inc/sys.h") }));
+    EXPECT_EQ(result.includes, 4u);
+    EXPECT_EQ(result.unresolved, 1u);
+    EXPECT_EQ(result.errors, 0u);
+
+    for (const char *name : { "from_a", "from_b", "from_sys", "also_sys", "pointer", "table", "main" }) {
+        EXPECT_TRUE(declares(name)) << name;
+    }
+    for (const char *name : { "member", "local", "tag" }) {
+        EXPECT_FALSE(declares(name)) << name;
+    }
+
+    const CIncludeGraphBuilder &graph = analyzer->graph();
+    EXPECT_EQ(graph.includes(file_id("main.c")), (std::vector{ file_id("a.h"), file_id("inc/sys.h") }));
+    EXPECT_EQ(graph.includes(file_id("a.h")), std::vector{ file_id("b.h") });
+    EXPECT_TRUE(graph.includes(file_id("b.h")).empty());
+    EXPECT_EQ(graph.num_edges(), 3u);
+}
+
+TEST_F(CIncludeAnalyzerTest, Cache_ReusesHeadersUnderCompatibleMacros) {
+    write_file("inc/common.h",
+               "#ifdef WIDE\n"
+               "int wide(void);\n"
+               "#else\n"
+               "int narrow(void);\n"
+               "#endif\n"
+               "int shared(void);\n");
+    const std::string first = write_file("first.c", "#include <common.h>\n");
+    const std::string second = write_file("second.c", "#define UNRELATED 1\n#include <common.h>\n");
+    const std::string wide = write_file("wide.c", "#define WIDE\n#include <common.h>\n");
+
+    EXPECT_EQ(analyze(first).cache_hits, 0u);
+    EXPECT_TRUE(declares("narrow"));
+
+    // The header only tests WIDE, so the other macros do not matter
+    EXPECT_EQ(analyze(second).cache_hits, 1u);
+    EXPECT_TRUE(declares("narrow"));
+    EXPECT_TRUE(declares("shared"));
+    EXPECT_EQ(unit.headers, std::vector{ file_id("inc/common.h") });
+
+    EXPECT_EQ(analyze(wide).cache_hits, 0u);
+    EXPECT_TRUE(declares("wide"));
+    EXPECT_FALSE(declares("narrow"));
+
+    EXPECT_EQ(analyze(wide).cache_hits, 1u);
+    EXPECT_TRUE(declares("wide"));
+    EXPECT_EQ(analyze(first).cache_hits, 1u);
+    EXPECT_TRUE(declares("narrow"));
+
+    const CIncludeStats &stats = analyzer->stats();
+    EXPECT_EQ(stats.units, 5u);
+    EXPECT_EQ(stats.files_read, 1u);
+    EXPECT_EQ(stats.headers_walked, 2u);
+    EXPECT_EQ(stats.cache_hits, 3u);
+}
+
+TEST_F(CIncludeAnalyzerTest, Cache_ReplaysMacroEffectsAndNestedHeaders) {
+    write_file("inc/config.h", "#include <features.h>\n#define HAVE_CONFIG 1\n");
+    write_file("inc/features.h", "#ifndef LEVEL\n#define LEVEL 2\n#endif\nint feature(void);\n");
+    const std::string main = write_file("main.c",
+                                        "#include <config.h>\n"
+                                        "#if HAVE_CONFIG && LEVEL == 2\n"
+                                        "int configured;\n"
+                                        "#endif\n");
+
+    analyze(main);
+    EXPECT_TRUE(declares("configured"));
+    EXPECT_TRUE(declares("feature"));
+
+    const CIncludeUnit &result = analyze(main);
+    EXPECT_EQ(result.cache_hits, 1u);
+    EXPECT_TRUE(declares("configured"));
+    EXPECT_TRUE(declares("feature"));
+    EXPECT_EQ(result.headers, (std::vector{ file_id("inc/config.h"), file_id("inc/features.h") }));
+    EXPECT_EQ(result.includes, 2u);
+    EXPECT_EQ(analyzer->stats().headers_walked, 2u);
+
+    // LEVEL is tested by the nested header, so defining it makes both miss
+    const std::string level = write_file("level.c",
+                                         "#define LEVEL 3\n"
+                                         "#include <config.h>\n"
+                                         "#if LEVEL == 3\n"
+                                         "int level_three;\n"
+                                         "#endif\n");
+    EXPECT_EQ(analyze(level).cache_hits, 0u);
+    EXPECT_TRUE(declares("level_three"));
+    EXPECT_EQ(analyzer->stats().headers_walked, 4u);
+}
+
+TEST_F(CIncludeAnalyzerTest, Analyze_AppliesPredefinedMacros) {
+    make_analyzer({ "MODE=2", "VERBOSE" });
+    const std::string main = write_file("main.c",
+                                        "#if MODE == 2 && VERBOSE\n"
+                                        "#include \"missing.h\"\n"
+                                        "int mode_two;\n"
+                                        "#else\n"
+                                        "int other_mode;\n"
+                                        "#endif\n");
+    const CIncludeUnit &result = analyze(main);
+    EXPECT_EQ(result.includes, 1u);
+    EXPECT_EQ(result.unresolved, 1u);
+    EXPECT_TRUE(declares("mode_two"));
+    EXPECT_FALSE(declares("other_mode"));
+
+    // Each unit starts from the predefined macros alone
+    write_file("main.c", "#undef MODE\n");
+    analyze(main);
+    EXPECT_EQ(analyzer->macros().find(pool.find(reinterpret_cast<const ca_string::ca_char_t*>("MODE"), 4)), nullptr);
+    write_file("main.c", "\n");
+    analyze(main);
+    EXPECT_NE(analyzer->macros().find(pool.find(reinterpret_cast<const ca_string::ca_char_t*>("MODE"), 4)), nullptr);
+}
+
+TEST_F(CIncludeAnalyzerTest, Cache_SkipsUnbalancedHeaders) {
+    write_file("inc/open.h", "#if 1\nint opened;\n");
+    write_file("inc/close.h", "#endif\n");
+    const std::string main = write_file("main.c", "#include <open.h>\n#include <close.h>\nint after;\n");
+
+    for (int run = 0; run < 2; ++run) {
+        const CIncludeUnit &result = analyze(main);
+        EXPECT_EQ(result.errors, 2u);
+        EXPECT_EQ(result.cache_hits, 0u);
+        EXPECT_TRUE(declares("opened"));
+        EXPECT_TRUE(declares("after"));
+    }
+    EXPECT_EQ(analyzer->stats().headers_walked, 4u);
+}
+
+TEST_F(CIncludeAnalyzerTest, Conditions_ResolveHasIncludeAndCalls) {
+    write_file("inc/sys.h", "\n");
+    write_file("inc/probe.h",
+               "#define VERSION(major, minor) ((major) * 100 + (minor))\n"
+               "#if __has_include(\"sys.h\") && !__has_include(<missing.h>) && VERSION(1, 2) == 102\n"
+               "int probed;\n"
+               "#endif\n");
+    write_file("inc/builtin.h", "#if __has_builtin(__builtin_expect)\nint builtin;\n#endif\n");
+    const std::string main = write_file("main.c",
+                                        "#include <probe.h>\n"
+                                        "#include <builtin.h>\n"
+                                        "#if __has_include(\"main.c\") && __has_include(<sys.h>)\n"
+                                        "int unit;\n"
+                                        "#endif\n");
+
+    // Headers whose conditions could not be evaluated are walked again
+    for (int run = 0; run < 2; ++run) {
+        const CIncludeUnit &result = analyze(main);
+        EXPECT_EQ(result.errors, 1u);
+        EXPECT_EQ(result.cache_hits, static_cast<ca_size_t>(run));
+        EXPECT_TRUE(declares("probed"));
+        EXPECT_TRUE(declares("unit"));
+        EXPECT_FALSE(declares("builtin"));
+    }
+    EXPECT_EQ(analyzer->stats().headers_walked, 3u);
+    EXPECT_TRUE(analyzer->graph().includes(file_id("inc/probe.h")).empty());
+}
+
+TEST_F(CIncludeAnalyzerTest, Analyze_StopsRecursiveIncludes) {
+    write_file("inc/self.h", "#include <self.h>\n");
+    const std::string main = write_file("main.c", "#include <self.h>\n");
+
+    const CIncludeUnit &result = analyze(main);
+    EXPECT_EQ(result.errors, 1u);
+    EXPECT_EQ(result.headers, std::vector{ file_id("inc/self.h") });
+    EXPECT_EQ(analyzer->stats().headers_walked, CIncludeOptions().max_depth);
+}
+
+TEST_F(CIncludeAnalyzerTest, Guards_SkipIncludesOfGuardedHeaders) {
+    write_file("inc/guarded.h", "#ifndef GUARDED_H\n#define GUARDED_H\nint guarded(void);\n#endif\n");
+    write_file("inc/once.h", "#pragma once\nint from_once(void);\n");
+    write_file("inc/plain.h", "int plain(void);\n");
+    const std::string main = write_file("main.c",
+                                        "#include <guarded.h>\n"
+                                        "#include <once.h>\n"
+                                        "#include <plain.h>\n"
+                                        "#include <guarded.h>\n"
+                                        "#include <once.h>\n"
+                                        "#include <plain.h>\n"
+                                        "#undef GUARDED_H\n"
+                                        "#include <guarded.h>\n");
+
+    for (int run = 0; run < 2; ++run) {
+        const CIncludeUnit &result = analyze(main);
+        EXPECT_EQ(result.includes, 7u);
+        EXPECT_EQ(result.avoided_reads, 2u);
+        EXPECT_EQ(result.headers, (std::vector{ file_id("inc/guarded.h"), file_id("inc/once.h"),
+                                                file_id("inc/plain.h") }));
+        EXPECT_TRUE(declares("guarded"));
+        EXPECT_TRUE(declares("from_once"));
+        EXPECT_TRUE(declares("plain"));
+    }
+    EXPECT_EQ(analyzer->stats().files_read, 3u);
+    EXPECT_EQ(analyzer->stats().avoided_reads, 4u);
+
+    const CIncludeGraphBuilder &graph = analyzer->graph();
+    const CIncludeGuard guarded = graph.guard(file_id("inc/guarded.h"));
+    EXPECT_EQ(guarded.kind, CIncludeGuardKind::GUARD_MACRO);
+    EXPECT_EQ(guarded.macro, pool.find(reinterpret_cast<const ca_string::ca_char_t*>("GUARDED_H"), 9));
+    EXPECT_EQ(graph.guard(file_id("inc/once.h")).kind, CIncludeGuardKind::GUARD_PRAGMA_ONCE);
+    EXPECT_EQ(graph.guard(file_id("inc/plain.h")).kind, CIncludeGuardKind::GUARD_NONE);
+    EXPECT_EQ(graph.guard(file_id("inc/missing.h")).kind, CIncludeGuardKind::GUARD_UNKNOWN);
+
+    // A guard defined before the first include keeps the header out
+    const std::string predefined = write_file("predefined.c", "#define GUARDED_H\n#include <guarded.h>\n");
+    const CIncludeUnit &result = analyze(predefined);
+    EXPECT_EQ(result.avoided_reads, 1u);
+    EXPECT_TRUE(result.headers.empty());
+    EXPECT_FALSE(declares("guarded"));
+}
+
+TEST_F(CIncludeAnalyzerTest, Guards_AreTestedByTheIncludersVariants) {
+    write_file("inc/once.h", "#pragma once\n#define ONCE 1\n");
+    write_file("inc/parent.h", "#include <once.h>\nint parent;\n");
+    write_file("inc/guarded.h", "#ifndef GUARDED_H\n#define GUARDED_H\n#define GUARDED 1\n#endif\n");
+    write_file("inc/outer.h", "#include <guarded.h>\nint outer;\n");
+    const std::string first = write_file("first.c", "#include <parent.h>\n#include <outer.h>\n");
+    const std::string second = write_file("second.c",
+                                          "#include <once.h>\n#include <guarded.h>\n"
+                                          "#undef ONCE\n#undef GUARDED\n"
+                                          "#include <parent.h>\n#include <outer.h>\n"
+                                          "#if defined ONCE || defined GUARDED\n"
+                                          "int bad;\n"
+                                          "#endif\n");
+
+    // The first unit enters the headers before their guards are known
+    EXPECT_EQ(analyze(first).cache_hits, 0u);
+    EXPECT_TRUE(declares("parent"));
+
+    // The headers entered by the second unit keep the cached includers out
+    const CIncludeUnit &result = analyze(second);
+    EXPECT_EQ(result.cache_hits, 2u);
+    EXPECT_EQ(result.avoided_reads, 2u);
+    EXPECT_TRUE(declares("parent"));
+    EXPECT_TRUE(declares("outer"));
+    EXPECT_FALSE(declares("bad"));
+}
+
+TEST_F(CIncludeAnalyzerTest, Guards_CoverTheWholeHeaderOnly) {
+    write_file("inc/defined.h", "#if !defined(DEFINED_H)\n#define DEFINED_H\n#endif\n");
+    write_file("inc/bare.h", "#if !defined BARE_H\n#define BARE_H\n#if 1\n#else\n#endif\n#endif\n");
+    write_file("inc/else.h", "#ifndef ELSE_H\n#define ELSE_H\n#else\nint twice;\n#endif\n");
+    write_file("inc/after.h", "#ifndef AFTER_H\n#define AFTER_H\n#endif\nint after;\n");
+    write_file("inc/before.h", "int before;\n#ifndef BEFORE_H\n#define BEFORE_H\n#endif\n");
+    write_file("inc/other.h", "#ifndef OTHER_H\n#define NOT_OTHER_H\n#endif\n");
+    write_file("inc/late.h", "#ifdef LATE\n#pragma once\n#endif\nint late;\n");
+    const std::string main = write_file("main.c",
+                                        "#include <defined.h>\n#include <bare.h>\n#include <else.h>\n"
+                                        "#include <after.h>\n#include <before.h>\n#include <other.h>\n"
+                                        "#include <late.h>\n#include <late.h>\n");
+
+    const CIncludeUnit &result = analyze(main);
+    EXPECT_EQ(result.errors, 0u);
+    EXPECT_EQ(result.avoided_reads, 0u);
+    const CIncludeGraphBuilder &graph = analyzer->graph();
+    EXPECT_EQ(graph.guard(file_id("inc/defined.h")).kind, CIncludeGuardKind::GUARD_MACRO);
+    EXPECT_EQ(graph.guard(file_id("inc/bare.h")).kind, CIncludeGuardKind::GUARD_MACRO);
+    for (const char *name : { "inc/else.h", "inc/after.h", "inc/before.h", "inc/other.h", "inc/late.h" }) {
+        EXPECT_EQ(graph.guard(file_id(name)).kind, CIncludeGuardKind::GUARD_NONE) << name;
+    }
+}
+
+TEST_F(CIncludeAnalyzerTest, Walk_JumpsOverGroupsNotCompiled) {
+    const std::string header = "#ifdef NEVER\n"
+                               "int hidden_a(void);\n"
+                               "/* #endif in a comment */\n"
+                               "const char *s = \"/* not a comment\";\n"
+                               "#if 1\n"
+                               "int hidden_nested;\n"
+                               "#endif\n"
+                               "#elif defined(ALSO_NEVER)\n"
+                               "int hidden_b;\n"
+                               "#else\n"
+                               "int shown(void);\n"
+                               "#endif\n"
+                               "int after_group;\n";
+    // A guarded header is scanned to find its guard, which skips nothing
+    const std::string guarded = "#ifndef GUARDED_H\n#define GUARDED_H\nint guarded;\n#endif\n";
+    const std::string text = "#include <big.h>\n"
+                             "#include <guarded.h>\n"
+                             "#if 0\n"
+                             "int unit_hidden;\n"
+                             "#else\n"
+                             "int unit_shown;\n"
+                             "#endif\n";
+    write_file("inc/big.h", header);
+    write_file("inc/guarded.h", guarded);
+    const std::string main = write_file("main.c", text);
+
+    const CIncludeUnit &result = analyze(main);
+    EXPECT_EQ(result.errors, 0u);
+    for (const char *name : { "shown", "after_group", "unit_shown", "guarded" }) {
+        EXPECT_TRUE(declares(name)) << name;
+    }
+    for (const char *name : { "hidden_a", "s", "hidden_nested", "hidden_b", "unit_hidden" }) {
+        EXPECT_FALSE(declares(name)) << name;
+    }
+
+    // Each group not compiled runs from the line after its directive to the
+    // next directive of the same conditional. The groups of the unit were
+    // lexed with it, so only their tokens were jumped over
+    const ca_size_t header_skipped = header.find("#elif") - header.find("int hidden_a") +
+                                     header.find("#else") - header.find("int hidden_b");
+    const ca_size_t unit_skipped = text.find("#else") - text.find("int unit_hidden");
+    const CIncludeStats &stats = analyzer->stats();
+    EXPECT_EQ(stats.bytes_read, header.size() + guarded.size());
+    EXPECT_EQ(stats.bytes_skipped, header_skipped);
+    EXPECT_EQ(stats.unit_bytes_jumped, unit_skipped);
+    EXPECT_EQ(stats.bytes_lexed + header_skipped, header.size() + guarded.size());
+}
@@ -0,0 +1,265 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/tests/c_analyzer/test_CLexer.cpp
+//
+// @file
+// @brief Tests the C lexer and its struct-of-arrays token stream.
+// ================================
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/parser/CLexer.h"
+
+using namespace ca;
+using namespace ca::analyzers::c;
+
+namespace {
+
+class CLexerTest : public ::testing::Test {
+protected:
+    CLexerTest() : lexer(&pool) {}
+
+    /**
+     * @brief Lexes a string, checking the stream invariants.
+     */
+    const CTokenStream &lex(const std::string_view text) {
+        source = text;
+        EXPECT_EQ(lexer.lex(reinterpret_cast<const ca_string::ca_char_t*>(source.data()), source.size(), &tokens), 0);
+        EXPECT_EQ(tokens.kinds.back(), CTokenKind::TOKEN_END);
+        EXPECT_EQ(tokens.offsets.size(), tokens.size());
+        EXPECT_EQ(tokens.lengths.size(), tokens.size());
+        EXPECT_EQ(tokens.ids.size(), tokens.size());
+        EXPECT_EQ(tokens.flags.size(), tokens.size());
+        // Tokens stay within the buffer and end before the next one starts
+        for (ca_size_t i = 0; i + 1 < tokens.size(); ++i) {
+            EXPECT_LE(tokens.offsets[i] + tokens.length(i), tokens.offsets[i + 1]) << i;
+        }
+        EXPECT_EQ(tokens.offsets.back(), source.size());
+        return tokens;
+    }
+
+    std::string_view text(const ca_size_t index) const {
+        return std::string_view(source).substr(tokens.offsets[index], tokens.length(index));
+    }
+
+    std::vector<std::string> spellings() const {
+        std::vector<std::string> result;
+        for (ca_size_t i = 0; i + 1 < tokens.size(); ++i) {
+            result.emplace_back(text(i));
+        }
+        return result;
+    }
+
+    std::vector<CTokenKind> kinds() const {
+        return { tokens.kinds.begin(), tokens.kinds.end() - 1 };
+    }
+
+    ca_string::ca_intern_pool pool;
+    CLexer lexer;
+    CTokenStream tokens;
+    std::string source;
+};
+
+}
+
+TEST_F(CLexerTest, Lex_KeywordsAndIdentifiers) {
+    lex("static inline int _Alignof_x(void) { return sizeof(struct node_$1) + \xC3\xA9t\xC3\xA9; }");
+
+    EXPECT_EQ(spellings(), (std::vector<std::string>{ "static", "inline", "int", "_Alignof_x", "(", "void", ")", "{",
+                                                      "return", "sizeof", "(", "struct", "node_$1", ")", "+",
+                                                      "\xC3\xA9t\xC3\xA9", ";", "}" }));
+    EXPECT_EQ(tokens.kinds[0], CTokenKind::KEYWORD_STATIC);
+    EXPECT_EQ(tokens.kinds[2], CTokenKind::KEYWORD_INT);
+    EXPECT_EQ(tokens.kinds[3], CTokenKind::TOKEN_IDENTIFIER);
+    EXPECT_EQ(tokens.kinds[15], CTokenKind::TOKEN_IDENTIFIER);
+
+    // Keyword ids follow the keyword order, and equal spellings share ids
+    EXPECT_EQ(tokens.ids[0], static_cast<CTokenStream::id_type>(CTokenKind::KEYWORD_STATIC) -
+                                 static_cast<CTokenStream::id_type>(CTokenKind::KEYWORD_FIRST));
+    EXPECT_EQ(pool.view(tokens.ids[12]).buf[0], 'n');
+    EXPECT_EQ(tokens.ids[6], ca_string::ca_intern_pool::INVALID_ID);
+    lex("node_$1 node_$1 node");
+    EXPECT_EQ(tokens.ids[0], tokens.ids[1]);
+    EXPECT_NE(tokens.ids[0], tokens.ids[2]);
+    EXPECT_STREQ(c_token_kind_name(CTokenKind::KEYWORD__THREAD_LOCAL), "_Thread_local");
+    EXPECT_STREQ(c_token_kind_name(CTokenKind::PUNCT_LESS_LESS_EQUAL), "<<=");
+}
+
+TEST_F(CLexerTest, Lex_Punctuators) {
+    lex("a->b++ -- <<= >>= ... . && || ## # :: <: :> <% %> %:%: %: != == <= >= |= ^= %=");
+    EXPECT_EQ(kinds(), (std::vector<CTokenKind>{
+        CTokenKind::TOKEN_IDENTIFIER, CTokenKind::PUNCT_ARROW, CTokenKind::TOKEN_IDENTIFIER,
+        CTokenKind::PUNCT_PLUS_PLUS, CTokenKind::PUNCT_MINUS_MINUS, CTokenKind::PUNCT_LESS_LESS_EQUAL,
+        CTokenKind::PUNCT_GREATER_GREATER_EQUAL, CTokenKind::PUNCT_ELLIPSIS, CTokenKind::PUNCT_PERIOD,
+        CTokenKind::PUNCT_AMP_AMP, CTokenKind::PUNCT_PIPE_PIPE, CTokenKind::PUNCT_HASH_HASH, CTokenKind::PUNCT_HASH,
+        CTokenKind::PUNCT_COLON_COLON, CTokenKind::PUNCT_L_SQUARE, CTokenKind::PUNCT_R_SQUARE,
+        CTokenKind::PUNCT_L_BRACE, CTokenKind::PUNCT_R_BRACE, CTokenKind::PUNCT_HASH_HASH, CTokenKind::PUNCT_HASH,
+        CTokenKind::PUNCT_EXCLAIM_EQUAL, CTokenKind::PUNCT_EQUAL_EQUAL, CTokenKind::PUNCT_LESS_EQUAL,
+        CTokenKind::PUNCT_GREATER_EQUAL, CTokenKind::PUNCT_PIPE_EQUAL, CTokenKind::PUNCT_CARET_EQUAL,
+        CTokenKind::PUNCT_PERCENT_EQUAL }));
+
+    lex("x@y");
+    EXPECT_EQ(kinds()[1], CTokenKind::TOKEN_UNKNOWN);
+}
+
+TEST_F(CLexerTest, Lex_NumbersAndLiterals) {
+    lex("0x1e+2 1.5e-3f .5 1'000'000 0b1010u 'a' '\\'' L'x' u8\"s\\\"t\" U\"u\" \"\" \"open\nx");
+    EXPECT_EQ(spellings(), (std::vector<std::string>{ "0x1e+2", "1.5e-3f", ".5", "1'000'000", "0b1010u", "'a'",
+                                                      "'\\''", "L'x'", "u8\"s\\\"t\"", "U\"u\"", "\"\"", "\"open",
+                                                      "x" }));
+    EXPECT_EQ(kinds(), (std::vector<CTokenKind>{
+        CTokenKind::TOKEN_NUMBER, CTokenKind::TOKEN_NUMBER, CTokenKind::TOKEN_NUMBER, CTokenKind::TOKEN_NUMBER,
+        CTokenKind::TOKEN_NUMBER, CTokenKind::TOKEN_CHAR, CTokenKind::TOKEN_CHAR, CTokenKind::TOKEN_CHAR,
+        CTokenKind::TOKEN_STRING, CTokenKind::TOKEN_STRING, CTokenKind::TOKEN_STRING, CTokenKind::TOKEN_UNKNOWN,
+        CTokenKind::TOKEN_IDENTIFIER }));
+
+    // Longer than a 16-bit length
+    const std::string long_string = "\"" + std::string(70000, 'z') + "\"";
+    lex("s = " + long_string + ";");
+    EXPECT_EQ(tokens.lengths[2], CTokenStream::LONG_LENGTH);
+    EXPECT_EQ(tokens.length(2), long_string.size());
+    EXPECT_EQ(tokens.offsets[3], 4u + long_string.size());
+}
+
+TEST_F(CLexerTest, Lex_LiteralsEndingInBackslash) {
+    for (const std::string_view input : { "#define X 'a\\", "s = \"open\\", "'\\", "\"\\\\\\" }) {
+        lex(input);
+        EXPECT_EQ(kinds().back(), CTokenKind::TOKEN_UNKNOWN) << input;
+        EXPECT_EQ(text(tokens.size() - 2).size(), input.size() - tokens.offsets[tokens.size() - 2]) << input;
+
+        // Copy into an exact-size heap buffer so sanitizers catch over-reads
+        const std::unique_ptr<char[]> copy(new char[input.size()]);
+        std::copy_n(input.data(), input.size(), copy.get());
+        ASSERT_EQ(lexer.lex(reinterpret_cast<const ca_string::ca_char_t*>(copy.get()), input.size(), &tokens), 0);
+        for (ca_size_t i = 0; i < tokens.size(); ++i) {
+            ASSERT_LE(tokens.offsets[i] + tokens.length(i), input.size()) << input;
+        }
+    }
+}
+
+TEST_F(CLexerTest, Lex_CommentsAndFlags) {
+    lex("/* header\n comment */ int a; // trailing \\\n continued\n"
+        "  b /* inline */c\\\n"
+        "d\n"
+        "/**/e");
+    EXPECT_EQ(spellings(), (std::vector<std::string>{ "int", "a", ";", "b", "c", "d", "e" }));
+    EXPECT_EQ(tokens.flags[0], C_TOKEN_LINE_START | C_TOKEN_SPACE_BEFORE);
+    EXPECT_EQ(tokens.flags[1], C_TOKEN_SPACE_BEFORE);
+    EXPECT_EQ(tokens.flags[2], 0);
+    EXPECT_EQ(tokens.flags[3], C_TOKEN_LINE_START | C_TOKEN_SPACE_BEFORE);
+    EXPECT_EQ(tokens.flags[4], C_TOKEN_SPACE_BEFORE);
+    // A splice is not a new line
+    EXPECT_EQ(tokens.flags[5] & C_TOKEN_LINE_START, 0);
+    EXPECT_EQ(tokens.flags[6], C_TOKEN_LINE_START | C_TOKEN_SPACE_BEFORE);
+    EXPECT_EQ(lexer.stats().comment_bytes, 21u + 24u + 12u + 4u);
+
+    // Unterminated comments run to the end
+    lex("x /* open");
+    EXPECT_EQ(spellings(), (std::vector<std::string>{ "x" }));
+    EXPECT_EQ(tokens.offsets.back(), source.size());
+}
+
+TEST_F(CLexerTest, Lex_HeaderNames) {
+    lex("#include <sys/types.h>\n"
+        "  %: include_next <a b.h>\n"
+        "#include \"local.h\"\n"
+        "x < y > z\n"
+        "#define LT <x>\n"
+        "#include <unterminated\n");
+    EXPECT_EQ(spellings(), (std::vector<std::string>{ "#", "include", "<sys/types.h>", "%:", "include_next", "<a b.h>",
+                                                      "#", "include", "\"local.h\"", "x", "<", "y", ">", "z", "#",
+                                                      "define", "LT", "<", "x", ">", "#", "include", "<",
+                                                      "unterminated" }));
+    EXPECT_EQ(tokens.kinds[2], CTokenKind::TOKEN_HEADER_NAME);
+    EXPECT_EQ(tokens.kinds[5], CTokenKind::TOKEN_HEADER_NAME);
+    EXPECT_EQ(tokens.kinds[8], CTokenKind::TOKEN_STRING);
+    EXPECT_EQ(tokens.kinds[17], CTokenKind::PUNCT_LESS);
+}
+
+TEST_F(CLexerTest, Lex_AgreesAtEveryBufferLength) {
+    // Cut a source at every length, so that each token crosses the SIMD and
+    // scalar paths, and check the tokens never reach past the end
+    const std::string full = "int identifier_long_enough_for_two_vectors_of_bytes = 42; /* a comment that spans "
+                             "more than thirty-two bytes */ const char *s = \"a string that is also long enough\";\n";
+    lex(full);
+    const std::vector<std::string> expected = spellings();
+    for (ca_size_t n = 0; n <= full.size(); ++n) {
+        // Copy into an exact-size heap buffer so sanitizers catch over-reads
+        const std::unique_ptr<char[]> copy(new char[n]);
+        std::copy_n(full.data(), n, copy.get());
+        ASSERT_EQ(lexer.lex(reinterpret_cast<const ca_string::ca_char_t*>(copy.get()), n, &tokens), 0);
+        for (ca_size_t i = 0; i < tokens.size(); ++i) {
+            ASSERT_LE(tokens.offsets[i] + tokens.length(i), n);
+        }
+    }
+    source = full;
+    EXPECT_EQ(spellings(), expected);
+    EXPECT_EQ(lexer.stats().buffers, full.size() + 2);
+}
+
+TEST_F(CLexerTest, LexSection_StopsAfterEachDirectiveLine) {
+    source = "int a;\n#define X 1\nint b; int c;\n#endif\n  \n";
+    const auto *bytes = reinterpret_cast<const ca_string::ca_char_t*>(source.data());
+    std::vector<std::string> sections;
+    ca_size_t offset = 0;
+    while (offset < source.size()) {
+        ca_size_t next = 0;
+        ASSERT_EQ(lexer.lex_section(bytes, source.size(), offset, &tokens, &next), 0);
+        ASSERT_GT(next, offset);
+        EXPECT_EQ(tokens.kinds.back(), CTokenKind::TOKEN_END);
+        EXPECT_EQ(tokens.offsets.back(), next);
+        EXPECT_NE(tokens.flags[0] & C_TOKEN_LINE_START, 0);
+        std::string spelled;
+        for (ca_size_t i = 0; i + 1 < tokens.size(); ++i) {
+            spelled += text(i);
+            spelled += ' ';
+        }
+        sections.push_back(spelled);
+        offset = next;
+    }
+    EXPECT_EQ(sections, (std::vector<std::string>{ "int a ; # define X 1 ", "int b ; int c ; # endif " }));
+    EXPECT_EQ(lexer.stats().bytes, source.size());
+    EXPECT_EQ(lexer.stats().buffers, 0u);
+}
+
+TEST_F(CLexerTest, SkipGroup_FindsTheDirectiveEndingTheGroup) {
+    const struct {
+        const char *text;
+        const char *end;        // Text from the expected stop, or nullptr for none
+    } cases[] = {
+        { "a\n#if A\n#else\n#endif\n#elif B\n", "#elif B\n" },
+        { "x /*\n#endif\n*/\n// #else\n  # endif\n", "# endif\n" },
+        { "s = \"/*\";\n#else\n", "#else\n" },
+        { "c = '/*';\n// \"\n#elifdef C\n", "#elifdef C\n" },
+        { "#error don't\n#endif\n", "#endif\n" },
+        { "x \\\n#endif\n#endif\n", "#endif\n" },
+        { "/* a\n b */ #else\n", "#else\n" },
+        { "x /* a */ #endif\n#endif", "#endif" },
+        { "%:endif\n", "%:endif\n" },
+        { "##endif\n#ifdef A\n#endif\n#elifndef B\n", "#elifndef B\n" },
+        { "#if 0\nx\n", nullptr },
+    };
+    for (const auto &test : cases) {
+        source = test.text;
+        const auto *bytes = reinterpret_cast<const ca_string::ca_char_t*>(source.data());
+        const ca_size_t expected = test.end != nullptr ? source.rfind(test.end) : source.size();
+        const ca_uint64_t lexed = lexer.stats().bytes;
+        const ca_size_t stop = lexer.skip_group(bytes, source.size(), 0);
+        EXPECT_EQ(stop, expected) << test.text;
+        // Scanning is not lexing
+        EXPECT_EQ(lexer.stats().bytes, lexed) << test.text;
+
+        // The lexer agrees that a directive starts there
+        lex(source);
+        if (stop < source.size()) {
+            const auto it = std::find(tokens.offsets.begin(), tokens.offsets.end(), stop);
+            ASSERT_NE(it, tokens.offsets.end()) << test.text;
+            const auto i = static_cast<ca_size_t>(it - tokens.offsets.begin());
+            EXPECT_EQ(tokens.kinds[i], CTokenKind::PUNCT_HASH) << test.text;
+            EXPECT_NE(tokens.flags[i] & C_TOKEN_LINE_START, 0) << test.text;
+        }
+    }
+}
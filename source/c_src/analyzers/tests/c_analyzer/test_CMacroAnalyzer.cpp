@@ -0,0 +1,303 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/tests/c_analyzer/test_CMacroAnalyzer.cpp
+//
+// @file
+// @brief Tests the macro table, the conditional stack and the recordings.
+// ================================
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/macro/CMacroAnalyzer.h"
+#include "core/parser/CLexer.h"
+
+using namespace ca;
+using namespace ca::analyzers::c;
+
+namespace {
+
+class CMacroAnalyzerTest : public ::testing::Test {
+protected:
+    CMacroAnalyzerTest() : lexer(&pool), macros(&pool) {}
+
+    /**
+     * @brief Feeds the directives of a text to the analyzer.
+     *
+     * @return The number of directives that failed.
+     */
+    int run(const std::string_view text) {
+        source = text;
+        const auto *bytes = reinterpret_cast<const ca_string::ca_char_t*>(source.data());
+        EXPECT_EQ(lexer.lex(bytes, source.size(), &tokens), 0);
+        int failures = 0;
+        for (ca_size_t i = 0; i + 1 < tokens.size();) {
+            ca_size_t end = i + 1;
+            while (end + 1 < tokens.size() && (tokens.flags[end] & C_TOKEN_LINE_START) == 0) {
+                ++end;
+            }
+            if (tokens.kinds[i] == CTokenKind::PUNCT_HASH) {
+                failures += macros.directive(macros.directive_kind(tokens, i), bytes, tokens, i + 2, end) != 0;
+            }
+            i = end;
+        }
+        return failures;
+    }
+
+    CTokenStream::id_type id(const std::string_view name) {
+        return pool.intern(reinterpret_cast<const ca_string::ca_char_t*>(name.data()), name.size());
+    }
+
+    ca_string::ca_intern_pool pool;
+    CLexer lexer;
+    CMacroAnalyzer macros;
+    CTokenStream tokens;
+    std::string source;
+};
+
+}
+
+TEST_F(CMacroAnalyzerTest, DirectiveKind_ClassifiesNames) {
+    run("#include <a.h>\n#if 1\n#else\n#endif\n#pragma once\n#line 3\n#\n");
+    const CDirectiveKind expected[] = {
+        CDirectiveKind::DIRECTIVE_INCLUDE, CDirectiveKind::DIRECTIVE_IF, CDirectiveKind::DIRECTIVE_ELSE,
+        CDirectiveKind::DIRECTIVE_ENDIF, CDirectiveKind::DIRECTIVE_PRAGMA, CDirectiveKind::DIRECTIVE_OTHER,
+        CDirectiveKind::DIRECTIVE_NONE,
+    };
+    ca_size_t next = 0;
+    for (ca_size_t i = 0; i + 1 < tokens.size(); ++i) {
+        if (tokens.kinds[i] == CTokenKind::PUNCT_HASH && (tokens.flags[i] & C_TOKEN_LINE_START) != 0) {
+            ASSERT_LT(next, std::size(expected));
+            EXPECT_EQ(macros.directive_kind(tokens, i), expected[next++]);
+        }
+    }
+    EXPECT_EQ(next, std::size(expected));
+}
+
+TEST_F(CMacroAnalyzerTest, Define_RecordsBodyAndHash) {
+    EXPECT_EQ(run("#define ANSWER (40 + 0x2)\n#define MAX(a, b) ((a) > (b) ? (a) : (b))\n#define EMPTY\n"), 0);
+    const CMacro *answer = macros.find(id("ANSWER"));
+    ASSERT_NE(answer, nullptr);
+    EXPECT_FALSE(answer->function_like);
+    ASSERT_EQ(answer->body.size(), 5u);
+    EXPECT_EQ(answer->body[3].value, 2);
+    ASSERT_NE(macros.find(id("MAX")), nullptr);
+    EXPECT_TRUE(macros.find(id("MAX"))->function_like);
+    ASSERT_NE(macros.find(id("EMPTY")), nullptr);
+    EXPECT_TRUE(macros.find(id("EMPTY"))->body.empty());
+
+    // The same tokens hash the same, whatever the spacing
+    const ca_uint64_t hash = macros.hash(id("ANSWER"));
+    EXPECT_NE(hash, 0u);
+    EXPECT_EQ(run("#define ANSWER ( 40+0x2 )\n"), 0);
+    EXPECT_EQ(macros.hash(id("ANSWER")), hash);
+    EXPECT_EQ(run("#define ANSWER 42\n"), 0);
+    EXPECT_NE(macros.hash(id("ANSWER")), hash);
+
+    EXPECT_EQ(run("#undef ANSWER\n"), 0);
+    EXPECT_EQ(macros.find(id("ANSWER")), nullptr);
+    EXPECT_EQ(macros.hash(id("ANSWER")), 0u);
+}
+
+TEST_F(CMacroAnalyzerTest, If_EvaluatesConditions) {
+    const struct {
+        const char *condition;
+        bool value;
+    } cases[] = {
+        { "1 + 2 * 3 == 7", true },
+        { "(1 + 2) * 3 == 7", false },
+        { "10 / 3 == 3 && 10 % 3 == 1", true },
+        { "-1 < 0 && ~0 == -1 && !0", true },
+        { "1 << 4 == 16 && 256 >> 4 == 0x10", true },
+        { "0b101 == 5 && 010 == 8 && 1'000 == 1000 && 10UL == 10", true },
+        { "'A' == 65 && '\\n' == 10 && '\\x41' == 'A'", true },
+        { "1 ? 2 : 0", true },
+        { "0 ? 1 : 0", false },
+        { "(5 & 3) == 1 && (5 | 3) == 7 && (5 ^ 3) == 6", true },
+        { "FOUR * 2 == 8 && TWICE == 8", true },
+        { "defined(FOUR) && defined FOUR && !defined(NOPE)", true },
+        { "NOPE == 0 && !NOPE", true },
+        { "true && !false", true },
+        { "FN(1, (2)) && !FN(0, 1)", true },
+        { "0 && 1 / 0", false },
+        { "1 || 1 / 0", true },
+    };
+    ASSERT_EQ(run("#define FOUR 4\n#define TWICE (FOUR * 2)\n#define FN(x, y) x\n"), 0);
+    for (const auto &test : cases) {
+        ASSERT_EQ(run(std::string("#if ") + test.condition + "\n"), 0) << test.condition;
+        EXPECT_EQ(macros.active(), test.value) << test.condition;
+        macros.truncate(0);
+    }
+}
+
+TEST_F(CMacroAnalyzerTest, If_MalformedConditionsAreFalse) {
+    for (const char *condition : { "1 / 0", "(1", "1 +", "", "2.5", "defined(", "\"s\"" }) {
+        macros.truncate(0);
+        EXPECT_EQ(run(std::string("#if ") + condition + "\n"), 1) << condition;
+        EXPECT_FALSE(macros.active()) << condition;
+    }
+    macros.truncate(0);
+    EXPECT_EQ(run("#endif\n#else\n"), 2);
+    EXPECT_GE(macros.stats().errors, 9u);
+}
+
+TEST_F(CMacroAnalyzerTest, If_ExpandsFunctionLikeMacros) {
+    ASSERT_EQ(run("#define MAX(a, b) ((a) > (b) ? (a) : (b))\n"
+                  "#define ID(x) x\n"
+                  "#define SEVEN() 7\n"
+                  "#define FIRST(x, ...) x\n"
+                  "#define REST(x, ...) __VA_ARGS__\n"
+                  "#define GNU(args...) args\n"
+                  "#define APPLY(f, x) f(x)\n"
+                  "#define VERSION(major, minor) ((major) * 100 + (minor))\n"
+                  "#define CURRENT VERSION(2, 5)\n"
+                  "#define SELF(x) SELF\n"
+                  "#define STR(x) #x\n"
+                  "#define PASTE(a, b) a ## b\n"), 0);
+    const struct {
+        const char *condition;
+        bool value;
+    } cases[] = {
+        { "MAX(MAX(1, 5), 3) == 5", true },
+        { "MAX(1, 2) < MAX(2, 1)", false },
+        { "SEVEN() == 7 && SEVEN ( ) == 7", true },
+        { "FIRST(4, 5, 6) == 4 && FIRST(9) == 9", true },
+        { "REST(1, 2) == 2 && REST(1) + 3 == 3", true },
+        { "GNU(3) == 3", true },
+        { "APPLY(ID, 8) == 8", true },
+        { "CURRENT >= VERSION(2, 4) && CURRENT < VERSION(3, 0)", true },
+        { "ID(defined ID) && ID(!defined(NOPE))", true },
+        { "MAX", false },
+    };
+    for (const auto &test : cases) {
+        ASSERT_EQ(run(std::string("#if ") + test.condition + "\n"), 0) << test.condition;
+        EXPECT_EQ(macros.active(), test.value) << test.condition;
+        macros.truncate(0);
+    }
+
+    // Calls that cannot be evaluated are errors, not 0
+    for (const char *condition : { "MAX(1)", "MAX(1, 2", "SEVEN(1)", "UNDEFINED(1)", "__has_attribute(x)",
+                                   "SELF(1)(2)", "STR(x)", "PASTE(1, 2)" }) {
+        EXPECT_EQ(run(std::string("#if !") + condition + "\n"), 1) << condition;
+        EXPECT_FALSE(macros.active()) << condition;
+        macros.truncate(0);
+    }
+    EXPECT_EQ(run("#define BAD(a b) a\n#define BAD(a\n"), 2);
+}
+
+TEST_F(CMacroAnalyzerTest, If_AsksTheIncludeProbe) {
+    ASSERT_EQ(run("#if __has_include(<present.h>) || defined __has_include\n#endif\n"), 1);
+    EXPECT_EQ(macros.depth(), 0u);
+
+    std::vector<std::string> asked;
+    macros.set_include_probe([&](const std::string_view name, const bool angled, const bool next) {
+        asked.push_back(std::string(angled ? "<" : "\"") + std::string(name) + (next ? " next" : ""));
+        return name == "present.h";
+    });
+    const struct {
+        const char *condition;
+        bool value;
+    } cases[] = {
+        { "__has_include(<present.h>)", true },
+        { "__has_include(\"present.h\") && !__has_include(<sys/missing.h>)", true },
+        { "__has_include_next(<present.h>)", true },
+        { "defined(__has_include) && defined __has_include_next", true },
+    };
+    for (const auto &test : cases) {
+        ASSERT_EQ(run(std::string("#if ") + test.condition + "\n"), 0) << test.condition;
+        EXPECT_EQ(macros.active(), test.value) << test.condition;
+        macros.truncate(0);
+    }
+    EXPECT_EQ(asked, (std::vector<std::string>{ "<present.h", "\"present.h", "<sys/missing.h",
+                                                "<present.h next" }));
+
+    for (const char *condition : { "__has_include(HEADER)", "__has_include(<a.h)", "__has_include(\"a.h\"" }) {
+        EXPECT_EQ(run(std::string("#if ") + condition + "\n"), 1) << condition;
+        macros.truncate(0);
+    }
+}
+
+TEST_F(CMacroAnalyzerTest, Conditionals_TrackNestingAndGroups) {
+    EXPECT_EQ(run("#define A\n"
+                  "#ifdef A\n"
+                  "#define IN_A\n"
+                  "#elif 1\n"
+                  "#define IN_ELIF\n"
+                  "#else\n"
+                  "#define IN_ELSE\n"
+                  "#endif\n"
+                  "#if 0\n"
+                  "#if 1\n"
+                  "#define NESTED\n"
+                  "#else\n"
+                  "#define NESTED_ELSE\n"
+                  "#endif\n"
+                  "#elifndef A\n"
+                  "#define IN_ELIFNDEF\n"
+                  "#else\n"
+                  "#define SECOND_ELSE\n"
+                  "#endif\n"),
+              0);
+    EXPECT_NE(macros.find(id("IN_A")), nullptr);
+    EXPECT_EQ(macros.find(id("IN_ELIF")), nullptr);
+    EXPECT_EQ(macros.find(id("IN_ELSE")), nullptr);
+    EXPECT_EQ(macros.find(id("NESTED")), nullptr);
+    EXPECT_EQ(macros.find(id("NESTED_ELSE")), nullptr);
+    EXPECT_EQ(macros.find(id("IN_ELIFNDEF")), nullptr);
+    EXPECT_NE(macros.find(id("SECOND_ELSE")), nullptr);
+    EXPECT_EQ(macros.depth(), 0u);
+    EXPECT_TRUE(macros.active());
+
+    EXPECT_EQ(run("#if 1\n#if 0\n"), 0);
+    EXPECT_EQ(macros.depth(), 2u);
+    EXPECT_FALSE(macros.active());
+    macros.truncate(1);
+    EXPECT_TRUE(macros.active());
+}
+
+TEST_F(CMacroAnalyzerTest, Recording_KeepsTestedMacrosAndEffects) {
+    ASSERT_EQ(run("#define CONFIG 2\n"), 0);
+    macros.begin_recording();
+    ASSERT_EQ(run("#ifndef GUARD\n"
+                  "#define GUARD\n"
+                  "#if CONFIG > 1 && defined(GUARD)\n"
+                  "#define WIDE\n"
+                  "#endif\n"
+                  "#undef CONFIG\n"
+                  "#endif\n"),
+              0);
+    const CMacroRecording recording = macros.end_recording();
+
+    // GUARD was defined before being tested again, so only its first test counts
+    std::vector<CTokenStream::id_type> tested = { id("GUARD"), id("CONFIG") };
+    std::sort(tested.begin(), tested.end());
+    EXPECT_EQ(recording.tested, tested);
+    ASSERT_EQ(recording.effects.size(), 3u);
+    for (const auto &[name, macro] : recording.effects) {
+        EXPECT_EQ(macro == nullptr, name == id("CONFIG"));
+    }
+
+    // The signature is that of the state before the recording
+    EXPECT_NE(macros.signature(recording.tested), recording.signature);
+    macros.reset();
+    ASSERT_EQ(run("#define CONFIG 2\n"), 0);
+    EXPECT_EQ(macros.signature(recording.tested), recording.signature);
+
+    // Replaying reports the lookups to an enclosing recording
+    macros.begin_recording();
+    macros.replay(recording);
+    const CMacroRecording outer = macros.end_recording();
+    EXPECT_EQ(outer.tested, tested);
+    EXPECT_EQ(outer.effects.size(), 3u);
+    EXPECT_NE(macros.find(id("WIDE")), nullptr);
+    EXPECT_EQ(macros.find(id("CONFIG")), nullptr);
+}
+
+TEST_F(CMacroAnalyzerTest, Recording_InactiveRegionsTestNothing) {
+    macros.begin_recording();
+    ASSERT_EQ(run("#if 0\n#ifdef HIDDEN\n#define X\n#endif\n#endif\n"), 0);
+    const CMacroRecording recording = macros.end_recording();
+    EXPECT_TRUE(recording.tested.empty());
+    EXPECT_TRUE(recording.effects.empty());
+}
@@ -0,0 +1,196 @@
+// ================================
+// CodeAnalyzer - source/c_src/analyzers/tests/core_analyzer/test_Analyzer.cpp
+//
+// @file
+// @brief Tests the parallel driver, the worker contexts and the result sink.
+// ================================
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "analyzer/Analyzer.h"
+
+using namespace ca;
+using namespace ca::analyzers;
+
+namespace {
+
+/**
+ * @brief Analyzer that does not read its unit: it fails the units whose
+ *        path starts with `!`, and sleeps in the units of worker 0 if asked.
+ */
+class FakeAnalyzer : public IAnalyzer {
+public:
+    explicit FakeAnalyzer(const ca_size_t worker, const bool slow_worker_0)
+        : worker(worker), slow(slow_worker_0 && worker == 0) {}
+
+    int
+    analyze(const std::string &filepath, AnalysisContext &context, AnalysisResult *result) override {
+        EXPECT_EQ(context.worker(), worker);
+        if (slow) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        if (filepath.starts_with("!")) {
+            result->error = "rejected";
+            return -1;
+        }
+        result->bytes = filepath.size();
+        return 0;
+    }
+
+private:
+    ca_size_t worker;
+    bool slow;
+};
+
+std::vector<std::string> unit_names(const int count) {
+    std::vector<std::string> files;
+    for (int i = 0; i < count; ++i) {
+        files.push_back("unit" + std::to_string(i) + ".c");
+    }
+    return files;
+}
+
+}
+
+TEST(AnalyzerTest, Run_AnalyzesEveryUnitOnce) {
+    std::vector<std::atomic<int>> made(4);
+    AnalyzerOptions options;
+    options.threads = 4;
+    Analyzer driver([&made](const ca_size_t worker) {
+        ++made[worker];
+        return std::make_unique<FakeAnalyzer>(worker, false);
+    }, options);
+    const std::vector<std::string> files = unit_names(500);
+    AnalysisResultSink sink(files.size());
+
+    ASSERT_EQ(driver.run(files, &sink), 0);
+    ASSERT_EQ(sink.size(), files.size());
+    std::set<ca_size_t> units;
+    ca_uint64_t bytes = 0;
+    for (ca_size_t i = 0; i < sink.size(); ++i) {
+        ASSERT_TRUE(sink.ready(i));
+        EXPECT_EQ(sink[i].path, files[sink[i].unit]);
+        EXPECT_LT(sink[i].worker, driver.stats().threads);
+        units.insert(sink[i].unit);
+        bytes += sink[i].bytes;
+    }
+    EXPECT_EQ(units.size(), files.size());
+    EXPECT_EQ(driver.stats().units, files.size());
+    EXPECT_EQ(driver.stats().bytes, bytes);
+    EXPECT_EQ(driver.stats().failures, 0u);
+
+    // Analyzers are made at most once per worker and kept across runs
+    sink.clear();
+    ASSERT_EQ(driver.run(files, &sink), 0);
+    EXPECT_EQ(sink.size(), files.size());
+    EXPECT_EQ(made[0].load(), 1);
+    for (const std::atomic<int> &count : made) {
+        EXPECT_LE(count.load(), 1);
+    }
+}
+
+TEST(AnalyzerTest, Run_ReportsFailures) {
+    Analyzer driver([](const ca_size_t worker) { return std::make_unique<FakeAnalyzer>(worker, false); });
+    const std::vector<std::string> files = { "a.c", "!b.c", "c.c" };
+
+    AnalysisResultSink small(2);
+    EXPECT_EQ(driver.run(files, &small), -1);
+    EXPECT_EQ(small.size(), 0u);
+
+    AnalysisResultSink sink(files.size());
+    EXPECT_EQ(driver.run(files, &sink), -1);
+    ASSERT_EQ(sink.size(), 3u);
+    for (ca_size_t i = 0; i < sink.size(); ++i) {
+        EXPECT_EQ(sink[i].status, sink[i].unit == 1 ? -1 : 0);
+        EXPECT_EQ(sink[i].error, sink[i].unit == 1 ? "rejected" : "");
+    }
+    EXPECT_EQ(driver.stats().failures, 1u);
+}
+
+#ifdef CA_ENABLE_THREADING
+TEST(AnalyzerTest, Run_BalancesAwayFromSlowWorkers) {
+    AnalyzerOptions options;
+    options.threads = 2;
+    Analyzer driver([](const ca_size_t worker) { return std::make_unique<FakeAnalyzer>(worker, true); }, options);
+    const std::vector<std::string> files = unit_names(40);
+    AnalysisResultSink sink(files.size());
+
+    ASSERT_EQ(driver.run(files, &sink), 0);
+    EXPECT_EQ(driver.stats().threads, 2u);
+    ca_size_t by_fast = 0;
+    for (ca_size_t i = 0; i < sink.size(); ++i) {
+        by_fast += sink[i].worker == 1;
+    }
+    EXPECT_GT(by_fast, files.size() / 2);
+}
+#endif
+
+TEST(AnalyzerTest, Sink_ConcurrentPush) {
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 1000;
+    AnalysisResultSink sink(THREADS * PER_THREAD);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&sink, t] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                AnalysisResult result;
+                result.unit = static_cast<ca_size_t>(t * PER_THREAD + i);
+                EXPECT_EQ(sink.push(std::move(result)), 0);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(sink.size(), static_cast<ca_size_t>(THREADS * PER_THREAD));
+    std::vector<bool> seen(THREADS * PER_THREAD);
+    for (ca_size_t i = 0; i < sink.size(); ++i) {
+        ASSERT_TRUE(sink.ready(i));
+        seen[sink[i].unit] = true;
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), true), THREADS * PER_THREAD);
+    EXPECT_EQ(sink.push(AnalysisResult()), -1);
+    EXPECT_EQ(sink.size(), sink.capacity());
+    EXPECT_FALSE(sink.ready(sink.capacity()));
+}
+
+TEST(AnalyzerTest, Context_ArenaResetsPerUnit) {
+    AnalysisContext context(3);
+    EXPECT_EQ(context.worker(), 3u);
+    context.begin_unit();
+
+    const auto *small = context.allocate_array<ca_uint32_t>(10);
+    const void *aligned = context.allocate(1, 256);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(small) % alignof(ca_uint32_t), 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 256, 0u);
+    {
+        std::pmr::vector<int> scratch(context.memory_resource());
+        scratch.assign(100, 7);
+        EXPECT_EQ(scratch[99], 7);
+    }
+    EXPECT_EQ(context.arena().stats().allocations, 3u);
+#ifdef CA_ENABLE_OPTIMIZER
+    EXPECT_EQ(context.arena_capacity(), AnalysisContext::MIN_CHUNK_SIZE);
+
+    // Filling the chunk chains a larger one
+    void *large = context.allocate(AnalysisContext::MIN_CHUNK_SIZE);
+    EXPECT_NE(large, nullptr);
+    EXPECT_EQ(context.arena_capacity(), 3 * AnalysisContext::MIN_CHUNK_SIZE);
+
+    // A new unit keeps only the largest chunk and reuses it from its start
+    context.begin_unit();
+    EXPECT_EQ(context.units(), 2u);
+    EXPECT_EQ(context.arena_capacity(), 2 * AnalysisContext::MIN_CHUNK_SIZE);
+    EXPECT_EQ(context.allocate(16, 16), large);
+#endif
+}
@@ -0,0 +1,186 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/ca_io_file_cache.cpp
+//
+// @file
+// @brief Implements the stamp-keyed file cache.
+// ================================
+
+#include "core/ca_io_file_cache.h"
+#include "ca_hash.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace ca::ca_io {
+
+using ca_string::ca_char_t;
+
+namespace {
+
+/**
+ * @brief Checks if every byte of a buffer is ASCII, 32 bytes at a time
+ *        loaded as four 64-bit words.
+ */
+bool
+is_ascii(const ca_char_t *data, const ca_size_t size) {
+    ca_uint64_t bits = 0;
+    ca_size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        ca_uint64_t words[4];
+        std::memcpy(words, data + i, sizeof(words));
+        bits |= words[0] | words[1] | words[2] | words[3];
+        if ((bits & 0x8080808080808080ULL) != 0) {
+            return false;
+        }
+    }
+    for (; i < size; ++i) {
+        bits |= data[i];
+    }
+    return (bits & 0x8080808080808080ULL) == 0;
+}
+
+}
+
+ca_size_t
+ca_cached_file::charge() const {
+    return sizeof(*this) + view.size() + lines.num_lines() * sizeof(ca_string::ca_line_index::offset_type);
+}
+
+ca_size_t
+ca_file_cache::stamp_hash::operator()(const ca_file_stamp &stamp) const {
+    static_assert(sizeof(ca_file_stamp) == 4 * sizeof(ca_uint64_t), "ca_file_stamp must not have padding");
+    return static_cast<ca_size_t>(ca_string::ca_hash64(reinterpret_cast<const ca_char_t *>(&stamp), sizeof(stamp)));
+}
+
+ca_file_cache::ca_file_cache(const ca_size_t budget, const ca_file_read_options &read_options)
+    : shards(NUM_SHARDS), read_options(read_options), max_bytes(budget), hits(0), misses(0), evictions(0) {
+    for (std::unique_ptr<shard> &part : shards) {
+        part = std::make_unique<shard>();
+    }
+}
+
+ca_file_cache::shard &
+ca_file_cache::shard_of(const ca_file_stamp &stamp) {
+    // The low bits pick the map bucket, the high bits the shard
+    return *shards[(stamp_hash{}(stamp) >> 56) % NUM_SHARDS];
+}
+
+ca_file_result
+ca_file_cache::get(const char *path, ca_cached_file_ptr *file) {
+    assert(path != nullptr);
+    assert(file != nullptr);
+
+    ca_file_stamp stamp{};
+    ca_file_result result = ca_file_stat(path, &stamp);
+    if (result != ca_file_result::FILE_OK) {
+        return result;
+    }
+
+    shard &part = shard_of(stamp);
+    {
+        std::lock_guard lock(part.mutex);
+        const auto found = part.index.find(stamp);
+        if (found != part.index.end()) {
+            part.lru.splice(part.lru.begin(), part.lru, found->second);
+            *file = *found->second;
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return ca_file_result::FILE_OK;
+        }
+    }
+    misses.fetch_add(1, std::memory_order_relaxed);
+
+    // Load and analyze outside the lock
+    auto loaded = std::make_shared<ca_cached_file>();
+    result = ca_file_read(path, &loaded->view, read_options);
+    if (result != ca_file_result::FILE_OK) {
+        return result;
+    }
+    loaded->stamp = stamp;
+    loaded->hash = ca_string::ca_hash64(loaded->view.data(), loaded->view.size());
+    loaded->is_ascii = is_ascii(loaded->view.data(), loaded->view.size());
+    loaded->lines.build(loaded->view.data(), loaded->view.size());
+    *file = loaded;
+
+    // Contents read while the file was being written must not be cached
+    ca_file_stamp after{};
+    if (ca_file_stat(path, &after) != ca_file_result::FILE_OK || after != stamp) {
+        return ca_file_result::FILE_OK;
+    }
+
+    const ca_size_t limit = max_bytes.load(std::memory_order_relaxed) / NUM_SHARDS;
+    const ca_size_t charge = loaded->charge();
+    if (charge > limit) {
+        return ca_file_result::FILE_OK;
+    }
+
+    std::lock_guard lock(part.mutex);
+    const auto found = part.index.find(stamp);
+    if (found != part.index.end()) {
+        // Another thread loaded it first; share its copy
+        part.lru.splice(part.lru.begin(), part.lru, found->second);
+        *file = *found->second;
+        return ca_file_result::FILE_OK;
+    }
+    part.lru.push_front(std::move(loaded));
+    part.index.emplace(stamp, part.lru.begin());
+    part.bytes += charge;
+    trim(part, limit);
+    return ca_file_result::FILE_OK;
+}
+
+void
+ca_file_cache::trim(shard &part, const ca_size_t limit) {
+    while (part.bytes > limit && !part.lru.empty()) {
+        const ca_cached_file_ptr &victim = part.lru.back();
+        part.bytes -= victim->charge();
+        part.index.erase(victim->stamp);
+        part.lru.pop_back();
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void
+ca_file_cache::set_budget(const ca_size_t budget) {
+    max_bytes.store(budget, std::memory_order_relaxed);
+    for (const std::unique_ptr<shard> &part : shards) {
+        std::lock_guard lock(part->mutex);
+        trim(*part, budget / NUM_SHARDS);
+    }
+}
+
+ca_size_t
+ca_file_cache::budget() const {
+    return max_bytes.load(std::memory_order_relaxed);
+}
+
+void
+ca_file_cache::clear() {
+    for (const std::unique_ptr<shard> &part : shards) {
+        std::lock_guard lock(part->mutex);
+        part->index.clear();
+        part->lru.clear();
+        part->bytes = 0;
+    }
+}
+
+ca_file_cache_stats
+ca_file_cache::stats() const {
+    ca_file_cache_stats stats{};
+    stats.hits = hits.load(std::memory_order_relaxed);
+    stats.misses = misses.load(std::memory_order_relaxed);
+    stats.evictions = evictions.load(std::memory_order_relaxed);
+    for (const std::unique_ptr<shard> &part : shards) {
+        std::lock_guard lock(part->mutex);
+        stats.entries += part->lru.size();
+        stats.bytes += part->bytes;
+    }
+    return stats;
+}
+
+ca_file_cache &
+ca_file_cache::global() {
+    static ca_file_cache cache;
+    return cache;
+}
+
+}
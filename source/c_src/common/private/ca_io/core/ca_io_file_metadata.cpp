@@ -0,0 +1,145 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/ca_io_file_metadata.cpp
+//
+// @file
+// @brief Implements batched metadata scanning, its threaded fallback, and
+//        the comparison of snapshots.
+// ================================
+
+#include "core/ca_io_file_metadata.h"
+#include "core/internal/ca_io_file_metadata_backend.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+namespace ca::ca_io {
+
+namespace {
+
+/**
+ * @brief Paths claimed at once by a fallback thread.
+ */
+constexpr ca_size_t SCAN_CHUNK_SIZE = 256;
+
+/**
+ * @brief Queries the metadata of many files on several threads, each
+ *        claiming chunks of paths until none are left.
+ */
+void
+query_threaded(const std::span<const char *const> paths, const std::span<ca_file_metadata> metadata,
+               ca_size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = ca_math::ca_max<ca_size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    num_threads = ca_math::ca_min(num_threads, (paths.size() + SCAN_CHUNK_SIZE - 1) / SCAN_CHUNK_SIZE);
+
+    std::atomic<ca_size_t> next = 0;
+    const auto run = [&] {
+        for (;;) {
+            const ca_size_t begin = next.fetch_add(SCAN_CHUNK_SIZE, std::memory_order_relaxed);
+            if (begin >= paths.size()) {
+                return;
+            }
+            const ca_size_t end = ca_math::ca_min(begin + SCAN_CHUNK_SIZE, paths.size());
+            for (ca_size_t i = begin; i < end; ++i) {
+                internal::ca_query_metadata(paths[i], &metadata[i]);
+            }
+        }
+    };
+
+    // The caller is one of the threads
+    std::vector<std::thread> threads;
+    for (ca_size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(run);
+    }
+    run();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Checks if the query of a file found it.
+ */
+bool
+is_present(const ca_file_metadata &metadata) {
+    return metadata.result == ca_file_result::FILE_OK;
+}
+
+}
+
+void
+ca_file_metadata_scan(const std::span<const char *const> paths, const std::span<ca_file_metadata> metadata,
+                      const ca_metadata_scan_options &options) {
+    assert(metadata.size() == paths.size());
+    if (paths.empty()) {
+        return;
+    }
+    if (options.use_io_uring &&
+        internal::ca_query_metadata_io_uring(paths, metadata, options.queue_depth) == 0) {
+        return;
+    }
+    query_threaded(paths, metadata, options.num_threads);
+}
+
+void
+ca_metadata_snapshot_take(const ca_path_table &table, const std::span<const ca_path_id> ids,
+                          ca_metadata_snapshot *snapshot, const ca_metadata_scan_options &options) {
+    assert(snapshot != nullptr);
+
+    snapshot->ids.assign(ids.begin(), ids.end());
+    std::ranges::sort(snapshot->ids);
+    const auto duplicates = std::ranges::unique(snapshot->ids);
+    snapshot->ids.erase(duplicates.begin(), duplicates.end());
+
+    // Interned paths are null terminated and never move
+    std::vector<const char *> paths(snapshot->ids.size());
+    for (ca_size_t i = 0; i < paths.size(); ++i) {
+        paths[i] = table.view(snapshot->ids[i]).data();
+    }
+    snapshot->metadata.resize(paths.size());
+    ca_file_metadata_scan(paths, snapshot->metadata, options);
+}
+
+void
+ca_metadata_snapshot_diff(const ca_metadata_snapshot &before, const ca_metadata_snapshot &after,
+                          std::vector<ca_file_change> *changes) {
+    assert(changes != nullptr);
+    assert(before.ids.size() == before.metadata.size());
+    assert(after.ids.size() == after.metadata.size());
+
+    changes->clear();
+    ca_size_t i = 0;
+    ca_size_t j = 0;
+    while (i < before.ids.size() || j < after.ids.size()) {
+        if (j == after.ids.size() || (i < before.ids.size() && before.ids[i] < after.ids[j])) {
+            if (is_present(before.metadata[i])) {
+                changes->push_back({ before.ids[i], ca_file_change_kind::FILE_CHANGE_REMOVED });
+            }
+            ++i;
+        }
+        else if (i == before.ids.size() || after.ids[j] < before.ids[i]) {
+            if (is_present(after.metadata[j])) {
+                changes->push_back({ after.ids[j], ca_file_change_kind::FILE_CHANGE_ADDED });
+            }
+            ++j;
+        }
+        else {
+            const ca_file_metadata &old = before.metadata[i];
+            const ca_file_metadata &now = after.metadata[j];
+            if (is_present(old) != is_present(now)) {
+                changes->push_back({ after.ids[j], is_present(now) ? ca_file_change_kind::FILE_CHANGE_ADDED
+                                                                   : ca_file_change_kind::FILE_CHANGE_REMOVED });
+            }
+            else if (is_present(now) && old != now) {
+                changes->push_back({ after.ids[j], ca_file_change_kind::FILE_CHANGE_MODIFIED });
+            }
+            ++i;
+            ++j;
+        }
+    }
+}
+
+}
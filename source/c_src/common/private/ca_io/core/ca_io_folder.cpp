@@ -0,0 +1,302 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/ca_io_folder.cpp
+//
+// @file
+// @brief Implements the parallel work-stealing directory walker.
+// ================================
+
+#include "core/ca_io_folder.h"
+#include "core/internal/ca_io_directory.h"
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace ca::ca_io {
+
+namespace {
+
+/**
+ * @brief A directory deque owned by one thread and stolen from by others.
+ */
+struct alignas(64) work_queue {
+    std::mutex mutex;                   ///< Guards `directories`.
+    std::deque<std::string> directories;///< Relative paths of the directories to list.
+};
+
+/**
+ * @struct folder_walker
+ * @brief Shared state of one walk.
+ */
+struct folder_walker {
+    folder_walker(const char *root, const ca_folder_walk_options &options, const ca_folder_visitor &visitor,
+                  const ca_size_t num_threads)
+        : root(root), options(options), visitor(visitor), rules(options.ignore), queues(num_threads) {
+        for (std::unique_ptr<work_queue> &queue : queues) {
+            queue = std::make_unique<work_queue>();
+        }
+        for (const std::string &pattern : options.exclude) {
+            rules.add(pattern);
+        }
+        if (options.follow_symlinks && internal::ca_canonical_path(this->root.c_str(), &canonical_root) != 0) {
+            canonical_root = this->root;
+        }
+    }
+
+    /**
+     * @brief Runs one walker thread until the whole tree is listed.
+     */
+    void
+    run(const ca_size_t id) {
+        std::string directory;
+        for (;;) {
+            if (pop(id, &directory)) {
+                list(id, directory);
+                if (outstanding.fetch_sub(1) == 1) {
+                    // The last directory is done, release the idle threads
+                    std::lock_guard lock(idle_mutex);
+                    idle.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock lock(idle_mutex);
+            ++idle_threads;
+            idle.wait(lock, [this] { return outstanding.load() == 0 || queued.load() > 0; });
+            --idle_threads;
+            if (outstanding.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Queues a directory on the deque of a thread.
+     */
+    void
+    push(const ca_size_t id, std::string directory) {
+        outstanding.fetch_add(1);
+        {
+            std::lock_guard lock(queues[id]->mutex);
+            queues[id]->directories.push_back(std::move(directory));
+            queued.fetch_add(1);
+        }
+        if (idle_threads.load() > 0) {
+            std::lock_guard lock(idle_mutex);
+            idle.notify_one();
+        }
+    }
+
+    /**
+     * @brief Takes the newest directory of the own deque, or steals the
+     *        oldest directory of another thread.
+     */
+    bool
+    pop(const ca_size_t id, std::string *directory) {
+        {
+            work_queue &own = *queues[id];
+            std::lock_guard lock(own.mutex);
+            if (!own.directories.empty()) {
+                *directory = std::move(own.directories.back());
+                own.directories.pop_back();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        for (ca_size_t i = 1; i < queues.size(); ++i) {
+            work_queue &victim = *queues[(id + i) % queues.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.directories.empty()) {
+                *directory = std::move(victim.directories.front());
+                victim.directories.pop_front();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool
+    excluded(const std::string_view relative_path, const bool is_directory) const {
+        return !rules.empty() && rules.excluded(relative_path, is_directory);
+    }
+
+    [[nodiscard]] bool
+    has_extension(const std::string_view name) const {
+        if (options.extensions.empty()) {
+            return true;
+        }
+        const ca_size_t dot = name.rfind('.');
+        if (dot == std::string_view::npos) {
+            return false;
+        }
+        const std::string_view extension = name.substr(dot);
+        for (const std::string &wanted : options.extensions) {
+            if (extension == wanted) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Checks if a linked directory should be descended: only targets
+     *        outside the root, and each of them once, so links cannot loop.
+     */
+    bool
+    claim_linked_directory(const std::string &path) {
+        std::string canonical;
+        if (internal::ca_canonical_path(path.c_str(), &canonical) != 0) {
+            return false;
+        }
+        if (canonical == canonical_root ||
+            (canonical.starts_with(canonical_root) && is_separator(canonical[canonical_root.size()]))) {
+            return false;
+        }
+        std::lock_guard lock(links_mutex);
+        return visited_links.insert(std::move(canonical)).second;
+    }
+
+    /**
+     * @brief Lists one directory, reporting its files and queuing its
+     *        subdirectories.
+     */
+    void
+    list(const ca_size_t id, const std::string &relative) {
+        const std::string path = relative.empty() ? root : join(relative);
+        const ca_size_t prefix_size = relative.empty() ? 0 : relative.size() + 1;
+
+        std::string child;
+        const ca_file_result result = internal::ca_list_directory(path.c_str(),
+            [&](const std::string_view name, const ca_folder_entry_type type, const bool is_symlink) {
+                if (!options.include_hidden && name[0] == '.') {
+                    return;
+                }
+
+                child.assign(relative);
+                if (!relative.empty()) {
+                    child += '/';
+                }
+                child += name;
+
+                if (type == ca_folder_entry_type::FOLDER_ENTRY_DIRECTORY) {
+                    if (excluded(child, true)) {
+                        return;
+                    }
+                    if (is_symlink &&
+                        (!options.follow_symlinks || !claim_linked_directory(join(child)))) {
+                        return;
+                    }
+                    push(id, child);
+                }
+                else if (type == ca_folder_entry_type::FOLDER_ENTRY_FILE) {
+                    if (!has_extension(name) || excluded(child, false)) {
+                        return;
+                    }
+                    const std::string file_path = join(child);
+                    ca_folder_entry entry{};
+                    entry.path = file_path;
+                    entry.relative_path = child;
+                    entry.name = std::string_view(child).substr(prefix_size);
+                    entry.is_symlink = is_symlink;
+                    visitor(entry);
+                    files.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+
+        if (result == ca_file_result::FILE_OK) {
+            directories.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (relative.empty()) {
+            root_result = result;
+        }
+        else {
+            errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Joins the root and a relative path.
+     */
+    [[nodiscard]] std::string
+    join(const std::string_view relative) const {
+        std::string path = root;
+        if (!is_separator(path.back())) {
+            path += '/';
+        }
+        path += relative;
+        return path;
+    }
+
+    static bool
+    is_separator(const char c) {
+        return c == '/' || c == '\\';
+    }
+
+    std::string root;                                   ///< Root without trailing separators.
+    std::string canonical_root;                         ///< Canonical root, when following links.
+    const ca_folder_walk_options &options;              ///< Walk options.
+    const ca_folder_visitor &visitor;                   ///< Receives the files.
+    ca_glob_set rules;                                  ///< `ignore` followed by `exclude`.
+    std::vector<std::unique_ptr<work_queue>> queues;    ///< One deque per thread.
+
+    std::atomic<ca_size_t> outstanding = 0;             ///< Directories queued or being listed.
+    std::atomic<ca_size_t> queued = 0;                  ///< Directories queued.
+    std::atomic<ca_size_t> idle_threads = 0;            ///< Threads waiting for work.
+    std::mutex idle_mutex;                              ///< Guards the idle wait.
+    std::condition_variable idle;                       ///< Signaled on new work and at the end.
+
+    std::mutex links_mutex;                             ///< Guards `visited_links`.
+    std::unordered_set<std::string> visited_links;      ///< Canonical targets of descended links.
+
+    std::atomic<ca_size_t> files = 0;                   ///< Files reported.
+    std::atomic<ca_size_t> directories = 0;             ///< Directories listed.
+    std::atomic<ca_size_t> errors = 0;                  ///< Directories that could not be listed.
+    ca_file_result root_result = ca_file_result::FILE_OK;   ///< Result of listing the root.
+};
+
+}
+
+ca_file_result
+ca_folder_walk(const char *root, const ca_folder_walk_options &options, const ca_folder_visitor &visitor,
+               ca_folder_walk_stats *stats) {
+    assert(root != nullptr);
+
+    std::string root_path(root);
+    while (root_path.size() > 1 && (root_path.back() == '/' || root_path.back() == '\\')) {
+        root_path.pop_back();
+    }
+
+    ca_size_t num_threads = options.num_threads;
+    if (num_threads == 0) {
+        num_threads = ca_math::ca_max<ca_size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    folder_walker walker(root_path.c_str(), options, visitor, num_threads);
+    walker.push(0, std::string());
+
+    // The caller is thread 0
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (ca_size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back([&walker, i] { walker.run(i); });
+    }
+    walker.run(0);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    if (stats != nullptr) {
+        stats->files = walker.files.load();
+        stats->directories = walker.directories.load();
+        stats->errors = walker.errors.load();
+    }
+    return walker.root_result;
+}
+
+}
@@ -0,0 +1,592 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/ca_io_glob.cpp
+//
+// @file
+// @brief Implements the compiled `.gitignore` matcher `ca_glob_set`.
+// ================================
+
+#include "core/ca_io_glob.h"
+#include "ca_hash.h"
+
+#include <algorithm>
+#include <bit>
+#include <bitset>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ca::ca_io::internal {
+
+namespace {
+
+/**
+ * @enum glob_token_kind
+ * @brief Elements of a compiled glob.
+ */
+enum class glob_token_kind : ca_uint8_t {
+    LITERAL,        ///< One given byte.
+    ANY,            ///< `?`, any byte but `/`.
+    CLASS,          ///< `[...]`, a byte of a set.
+    STAR,           ///< `*`, any bytes but `/`.
+    GLOBSTAR,       ///< `**` at the end, any bytes.
+    DIRSTAR,        ///< `**/`, nothing or any bytes ending with `/`.
+};
+
+struct glob_token {
+    glob_token_kind kind;
+    char literal;               ///< The byte of a `LITERAL`.
+    std::bitset<256> set;       ///< The bytes of a `CLASS`.
+};
+
+/**
+ * @brief Splits a glob into tokens.
+ *
+ * `**` is only special as a whole component; elsewhere it is a `*`.
+ */
+std::vector<glob_token>
+tokenize(const std::string_view pattern) {
+    std::vector<glob_token> tokens;
+    const auto push = [&](const glob_token_kind kind, const char literal = 0) {
+        tokens.push_back(glob_token{ kind, literal, {} });
+    };
+
+    for (ca_size_t i = 0; i < pattern.size();) {
+        const char c = pattern[i];
+        if (c == '*') {
+            ca_size_t end = i;
+            while (end < pattern.size() && pattern[end] == '*') {
+                ++end;
+            }
+            const bool whole = end - i >= 2 && (i == 0 || pattern[i - 1] == '/') &&
+                               (end == pattern.size() || pattern[end] == '/');
+            if (whole && end == pattern.size()) {
+                push(glob_token_kind::GLOBSTAR);
+            }
+            else if (whole) {
+                if (tokens.empty() || tokens.back().kind != glob_token_kind::DIRSTAR) {
+                    push(glob_token_kind::DIRSTAR);
+                }
+                ++end;      // the `/` belongs to the token
+            }
+            else if (tokens.empty() || tokens.back().kind != glob_token_kind::STAR) {
+                push(glob_token_kind::STAR);
+            }
+            i = end;
+        }
+        else if (c == '?') {
+            push(glob_token_kind::ANY);
+            ++i;
+        }
+        else if (c == '[') {
+            ca_size_t j = i + 1;
+            const bool negate = j < pattern.size() && (pattern[j] == '!' || pattern[j] == '^');
+            j += negate;
+            std::bitset<256> set;
+            // A ']' right after the opening bracket is part of the class
+            for (bool first = true; j < pattern.size() && (first || pattern[j] != ']'); first = false) {
+                if (j + 2 < pattern.size() && pattern[j + 1] == '-' && pattern[j + 2] != ']') {
+                    for (unsigned b = static_cast<ca_uint8_t>(pattern[j]); b <= static_cast<ca_uint8_t>(pattern[j + 2]);
+                         ++b) {
+                        set.set(b);
+                    }
+                    j += 3;
+                }
+                else {
+                    set.set(static_cast<ca_uint8_t>(pattern[j]));
+                    ++j;
+                }
+            }
+            if (j >= pattern.size()) {
+                // Unterminated class, match the bracket literally
+                push(glob_token_kind::LITERAL, '[');
+                ++i;
+                continue;
+            }
+            if (negate) {
+                set.flip();
+            }
+            set.reset('/');
+            push(glob_token_kind::CLASS);
+            tokens.back().set = set;
+            i = j + 1;
+        }
+        else if (c == '\\' && i + 1 < pattern.size()) {
+            push(glob_token_kind::LITERAL, pattern[i + 1]);
+            i += 2;
+        }
+        else {
+            push(glob_token_kind::LITERAL, c);
+            ++i;
+        }
+    }
+    return tokens;
+}
+
+/**
+ * @brief Collects the bytes of literal tokens.
+ *
+ * @return `false` if a token is not a literal.
+ */
+bool
+literal_text(const std::span<const glob_token> tokens, std::string *text) {
+    text->clear();
+    for (const glob_token &token : tokens) {
+        if (token.kind != glob_token_kind::LITERAL) {
+            return false;
+        }
+        *text += token.literal;
+    }
+    return true;
+}
+
+/**
+ * @struct rule_ref
+ * @brief A rule filed under some key.
+ */
+struct rule_ref {
+    ca_uint32_t rule;           ///< Index of the rule; later rules win.
+    bool directory_only;        ///< Whether the rule only matches directories.
+};
+
+/**
+ * @brief Raises `best` to the last rule of a list applying to the entry.
+ */
+void
+consider(const std::vector<rule_ref> &refs, const bool is_directory, ca_int64_t *best) {
+    for (auto it = refs.rbegin(); it != refs.rend(); ++it) {
+        if (!it->directory_only || is_directory) {
+            *best = ca_math::ca_max<ca_int64_t>(*best, it->rule);
+            return;
+        }
+    }
+}
+
+struct string_hash {
+    using is_transparent = void;
+
+    ca_size_t
+    operator()(const std::string_view text) const {
+        return static_cast<ca_size_t>(
+            ca_string::ca_hash64(reinterpret_cast<const ca_string::ca_char_t *>(text.data()), text.size()));
+    }
+};
+
+typedef std::unordered_map<std::string, std::vector<rule_ref>, string_hash, std::equal_to<>> rule_table;
+
+/**
+ * @struct trie_node
+ * @brief A component of the literal paths of anchored rules.
+ */
+struct trie_node {
+    std::unordered_map<std::string, std::unique_ptr<trie_node>, string_hash, std::equal_to<>> children;
+    std::vector<rule_ref> exact;    ///< Rules matching the path ending here.
+    std::vector<rule_ref> below;    ///< Rules matching every path below.
+};
+
+/**
+ * @brief Words of state kept on the stack while matching.
+ */
+constexpr ca_size_t INLINE_WORDS = 16;
+
+/**
+ * @struct glob_program
+ * @brief Globs compiled into one bit-parallel NFA.
+ *
+ * Each glob owns consecutive states, one per token plus the accepting state,
+ * and two for a `**` directory run: an entry state that moves to the state
+ * after the run for free, and an inner state looping on any byte that only
+ * leaves it on `/`. One step over a byte `c` is
+ *
+ *     next = ((current << 1) & advance[c]) | (current & loop[c])
+ *
+ * followed by the epsilon moves, which match nothing. As later globs own
+ * higher states, the highest accepting state is the winning rule.
+ */
+struct glob_program {
+    /**
+     * @brief Appends the states of a glob.
+     */
+    void
+    add(const std::vector<glob_token> &tokens, const ca_uint32_t rule, const bool directory_only) {
+        const ca_size_t base = states;
+        const auto runs = std::ranges::count(tokens, glob_token_kind::DIRSTAR, &glob_token::kind);
+        resize(states + tokens.size() + static_cast<ca_size_t>(runs) + 1);
+
+        set(&start, base);
+        ca_size_t state = base;
+        ca_size_t chain = 0;
+        for (const glob_token &token : tokens) {
+            switch (token.kind) {
+                case glob_token_kind::LITERAL:
+                    set_byte(&advance, state + 1, static_cast<ca_uint8_t>(token.literal));
+                    break;
+                case glob_token_kind::ANY:
+                    for (unsigned c = 0; c < 256; ++c) {
+                        if (c != '/') {
+                            set_byte(&advance, state + 1, c);
+                        }
+                    }
+                    break;
+                case glob_token_kind::CLASS:
+                    for (unsigned c = 0; c < 256; ++c) {
+                        if (token.set.test(c)) {
+                            set_byte(&advance, state + 1, c);
+                        }
+                    }
+                    break;
+                case glob_token_kind::STAR:
+                case glob_token_kind::GLOBSTAR:
+                    set(&epsilon, state);
+                    for (unsigned c = 0; c < 256; ++c) {
+                        if (c != '/' || token.kind == glob_token_kind::GLOBSTAR) {
+                            set_byte(&loop, state, c);
+                        }
+                    }
+                    break;
+                case glob_token_kind::DIRSTAR:
+                    set(&epsilon, state);
+                    set(&skip, state);
+                    ++state;
+                    for (unsigned c = 0; c < 256; ++c) {
+                        set_byte(&loop, state, c);
+                    }
+                    set_byte(&advance, state + 1, '/');
+                    break;
+            }
+            ++state;
+            chain = token.kind >= glob_token_kind::STAR ? chain + 1 : 0;
+            epsilon_chain = ca_math::ca_max(epsilon_chain, chain);
+        }
+
+        set(directory_only ? &accept_directory : &accept, state);
+        rules[state] = rule;
+    }
+
+    /**
+     * @brief Runs the NFA over a text.
+     *
+     * @return The last rule matching, or -1.
+     */
+    [[nodiscard]] ca_int64_t
+    match(const std::string_view text, const bool is_directory) const {
+        ca_uint64_t inline_state[2 * INLINE_WORDS];
+        std::vector<ca_uint64_t> heap_state;
+        ca_uint64_t *current = inline_state;
+        if (words > INLINE_WORDS) {
+            heap_state.resize(2 * words);
+            current = heap_state.data();
+        }
+        ca_uint64_t *next = current + words;
+
+        std::copy_n(start.data(), words, current);
+        close(current);
+        for (const char byte : text) {
+            const ca_uint64_t *advance_row = advance.data() + static_cast<ca_uint8_t>(byte) * words;
+            const ca_uint64_t *loop_row = loop.data() + static_cast<ca_uint8_t>(byte) * words;
+            ca_uint64_t carry = 0;
+            ca_uint64_t alive = 0;
+            for (ca_size_t w = 0; w < words; ++w) {
+                const ca_uint64_t word = current[w];
+                next[w] = (((word << 1) | carry) & advance_row[w]) | (word & loop_row[w]);
+                carry = word >> 63;
+                alive |= next[w];
+            }
+            if (alive == 0) {
+                return -1;
+            }
+            std::swap(current, next);
+            close(current);
+        }
+
+        for (ca_size_t w = words; w-- > 0;) {
+            const ca_uint64_t accepted = current[w] & (accept[w] | (is_directory ? accept_directory[w] : 0));
+            if (accepted != 0) {
+                return rules[w * 64 + 63 - static_cast<ca_size_t>(std::countl_zero(accepted))];
+            }
+        }
+        return -1;
+    }
+
+    ca_size_t states = 0;                       ///< Number of states.
+    ca_size_t words = 0;                        ///< Words of a state set.
+    ca_size_t epsilon_chain = 0;                ///< Longest chain of epsilon moves.
+    std::vector<ca_uint64_t> advance;           ///< Per byte, states entered from their predecessor.
+    std::vector<ca_uint64_t> loop;              ///< Per byte, states kept.
+    std::vector<ca_uint64_t> epsilon;           ///< States also entering their successor for free.
+    std::vector<ca_uint64_t> skip;              ///< States also entering the state after their successor.
+    std::vector<ca_uint64_t> start;             ///< Initial states.
+    std::vector<ca_uint64_t> accept;            ///< Accepting states.
+    std::vector<ca_uint64_t> accept_directory;  ///< Accepting states of directory-only rules.
+    std::vector<ca_uint32_t> rules;             ///< Rule of each accepting state.
+
+private:
+    /**
+     * @brief Applies the epsilon moves.
+     */
+    void
+    close(ca_uint64_t *current) const {
+        for (ca_size_t round = 0; round < epsilon_chain; ++round) {
+            ca_uint64_t carry = 0;
+            ca_uint64_t skip_carry = 0;
+            for (ca_size_t w = 0; w < words; ++w) {
+                const ca_uint64_t moving = current[w] & epsilon[w];
+                const ca_uint64_t skipping = current[w] & skip[w];
+                current[w] |= (moving << 1) | carry | (skipping << 2) | skip_carry;
+                carry = moving >> 63;
+                skip_carry = skipping >> 62;
+            }
+        }
+    }
+
+    void
+    resize(const ca_size_t new_states) {
+        const ca_size_t new_words = (new_states + 63) / 64;
+        if (new_words != words) {
+            // The byte tables are laid out byte-major, so they are rebuilt
+            const auto relayout = [&](std::vector<ca_uint64_t> *table) {
+                std::vector<ca_uint64_t> grown(256 * new_words);
+                for (ca_size_t c = 0; c < 256; ++c) {
+                    std::copy_n(table->data() + c * words, words, grown.data() + c * new_words);
+                }
+                *table = std::move(grown);
+            };
+            relayout(&advance);
+            relayout(&loop);
+            epsilon.resize(new_words);
+            skip.resize(new_words);
+            start.resize(new_words);
+            accept.resize(new_words);
+            accept_directory.resize(new_words);
+            words = new_words;
+        }
+        states = new_states;
+        rules.resize(new_states);
+    }
+
+    static void
+    set(std::vector<ca_uint64_t> *bits, const ca_size_t state) {
+        (*bits)[state / 64] |= ca_uint64_t{ 1 } << (state % 64);
+    }
+
+    void
+    set_byte(std::vector<ca_uint64_t> *table, const ca_size_t state, const unsigned byte) {
+        (*table)[byte * words + state / 64] |= ca_uint64_t{ 1 } << (state % 64);
+    }
+};
+
+}
+
+/**
+ * @struct ca_glob_matcher
+ * @brief The compiled rules of a `ca_glob_set`.
+ */
+struct ca_glob_matcher {
+    bool
+    add(const std::string_view line) {
+        std::string_view view = line;
+        if (!view.empty() && view.back() == '\r') {
+            view.remove_suffix(1);
+        }
+        if (view.empty() || view[0] == '#') {
+            return false;
+        }
+        while (!view.empty() && view.back() == ' ' && !(view.size() >= 2 && view[view.size() - 2] == '\\')) {
+            view.remove_suffix(1);
+        }
+
+        const bool negate = !view.empty() && view[0] == '!';
+        if (negate) {
+            view.remove_prefix(1);
+        }
+        const bool directory_only = !view.empty() && view.back() == '/';
+        while (!view.empty() && view.back() == '/') {
+            view.remove_suffix(1);
+        }
+        bool anchored = view.find('/') != std::string_view::npos;
+        while (!view.empty() && view.front() == '/') {
+            view.remove_prefix(1);
+        }
+        if (view.empty()) {
+            return false;
+        }
+        // `**/name` is the same as `name`
+        if (anchored && view.starts_with("**/") && view.find('/', 3) == std::string_view::npos) {
+            view.remove_prefix(3);
+            anchored = false;
+        }
+
+        const rule_ref ref{ static_cast<ca_uint32_t>(negated.size()), directory_only };
+        negated.push_back(negate);
+        sources.emplace_back(line);
+
+        const std::vector<glob_token> tokens = tokenize(view);
+        std::string text;
+        if (!anchored) {
+            if (literal_text(tokens, &text)) {
+                names[text].push_back(ref);
+            }
+            else if (tokens[0].kind == glob_token_kind::STAR && literal_text(std::span(tokens).subspan(1), &text) &&
+                     !text.empty() && text[0] == '.') {
+                suffixes[text].push_back(ref);
+            }
+            else {
+                name_program.add(tokens, ref.rule, directory_only);
+            }
+        }
+        else if (literal_text(tokens, &text)) {
+            insert(text)->exact.push_back(ref);
+        }
+        else if (tokens.size() >= 3 && tokens.back().kind == glob_token_kind::GLOBSTAR &&
+                 literal_text(std::span(tokens).first(tokens.size() - 1), &text) && text.back() == '/') {
+            text.pop_back();
+            insert(text)->below.push_back(ref);
+        }
+        else {
+            path_program.add(tokens, ref.rule, directory_only);
+        }
+        return true;
+    }
+
+    [[nodiscard]] ca_glob_result
+    match(const std::string_view path, const bool is_directory) const {
+        ca_int64_t best = -1;
+        const ca_size_t slash = path.rfind('/');
+        const std::string_view name = slash == std::string_view::npos ? path : path.substr(slash + 1);
+
+        if (!names.empty()) {
+            const auto found = names.find(name);
+            if (found != names.end()) {
+                consider(found->second, is_directory, &best);
+            }
+        }
+        if (!suffixes.empty()) {
+            for (ca_size_t dot = name.find('.'); dot != std::string_view::npos; dot = name.find('.', dot + 1)) {
+                const auto found = suffixes.find(name.substr(dot));
+                if (found != suffixes.end()) {
+                    consider(found->second, is_directory, &best);
+                }
+            }
+        }
+        if (!trie.children.empty()) {
+            const trie_node *node = &trie;
+            for (ca_size_t begin = 0;;) {
+                const ca_size_t end = path.find('/', begin);
+                const auto found = node->children.find(path.substr(begin, end - begin));
+                if (found == node->children.end()) {
+                    break;
+                }
+                node = found->second.get();
+                if (end == std::string_view::npos) {
+                    consider(node->exact, is_directory, &best);
+                    break;
+                }
+                consider(node->below, is_directory, &best);
+                begin = end + 1;
+            }
+        }
+        if (name_program.states != 0) {
+            best = ca_math::ca_max(best, name_program.match(name, is_directory));
+        }
+        if (path_program.states != 0) {
+            best = ca_math::ca_max(best, path_program.match(path, is_directory));
+        }
+
+        if (best < 0) {
+            return ca_glob_result::GLOB_NONE;
+        }
+        return negated[best] ? ca_glob_result::GLOB_INCLUDED : ca_glob_result::GLOB_EXCLUDED;
+    }
+
+    std::vector<std::string> sources;   ///< The rules as added, to copy the set.
+    std::vector<bool> negated;          ///< Whether each rule re-includes.
+    rule_table names;                   ///< Literal names.
+    rule_table suffixes;                ///< Literal suffixes starting with `.`.
+    trie_node trie;                     ///< Literal paths of anchored rules.
+    glob_program name_program;          ///< Other unanchored rules, run on names.
+    glob_program path_program;          ///< Other anchored rules, run on paths.
+
+private:
+    trie_node *
+    insert(const std::string_view path) {
+        trie_node *node = &trie;
+        for (ca_size_t begin = 0;;) {
+            const ca_size_t end = path.find('/', begin);
+            const std::string_view component = path.substr(begin, end - begin);
+            auto found = node->children.find(component);
+            if (found == node->children.end()) {
+                found = node->children.emplace(std::string(component), std::make_unique<trie_node>()).first;
+            }
+            node = found->second.get();
+            if (end == std::string_view::npos) {
+                return node;
+            }
+            begin = end + 1;
+        }
+    }
+};
+
+}
+
+namespace ca::ca_io {
+
+ca_glob_set::ca_glob_set()
+    : matcher(std::make_unique<internal::ca_glob_matcher>()) {
+}
+
+ca_glob_set::~ca_glob_set() = default;
+
+ca_glob_set::ca_glob_set(const ca_glob_set &other)
+    : ca_glob_set() {
+    for (const std::string &source : other.matcher->sources) {
+        matcher->add(source);
+    }
+}
+
+ca_glob_set &
+ca_glob_set::operator=(const ca_glob_set &other) {
+    if (this != &other) {
+        ca_glob_set copy(other);
+        matcher = std::move(copy.matcher);
+    }
+    return *this;
+}
+
+ca_glob_set::ca_glob_set(ca_glob_set &&other) noexcept
+    : matcher(std::exchange(other.matcher, std::make_unique<internal::ca_glob_matcher>())) {
+}
+
+ca_glob_set &
+ca_glob_set::operator=(ca_glob_set &&other) noexcept {
+    std::swap(matcher, other.matcher);
+    return *this;
+}
+
+bool
+ca_glob_set::add(const std::string_view rule) {
+    return matcher->add(rule);
+}
+
+ca_size_t
+ca_glob_set::add_lines(std::string_view text) {
+    ca_size_t added = 0;
+    while (!text.empty()) {
+        const ca_size_t end = text.find('\n');
+        added += add(text.substr(0, end));
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    }
+    return added;
+}
+
+ca_glob_result
+ca_glob_set::match(const std::string_view relative_path, const bool is_directory) const {
+    return matcher->match(relative_path, is_directory);
+}
+
+ca_size_t
+ca_glob_set::size() const {
+    return matcher->negated.size();
+}
+
+}
@@ -0,0 +1,436 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/ca_io_path.cpp
+//
+// @file
+// @brief Implements the lexical path operations of `ca_io_path` and the
+//        interned path table.
+// ================================
+
+#include "core/ca_io_path.h"
+
+#include <cassert>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+namespace ca::ca_io {
+
+namespace {
+
+/**
+ * @brief Returns the length of the root prefix of a path, 0 for relative
+ *        paths.
+ *
+ * The prefix is `/` on POSIX systems. On Windows it is a UNC prefix
+ * `\\server\share\`, a drive `C:` optionally followed by a separator, or a
+ * single leading separator.
+ */
+ca_size_t
+root_length(const std::string_view path) {
+    if (path.empty()) {
+        return 0;
+    }
+#ifdef _WIN32
+    if (path.size() > 2 && ca_io_path::is_separator(path[0]) && ca_io_path::is_separator(path[1]) &&
+        !ca_io_path::is_separator(path[2])) {
+        // Skip the server and the share
+        ca_size_t i = 2;
+        for (int component = 0; component < 2 && i < path.size(); ++component) {
+            while (i < path.size() && !ca_io_path::is_separator(path[i])) {
+                ++i;
+            }
+            if (i < path.size()) {
+                ++i;
+            }
+        }
+        return i;
+    }
+    if (path.size() > 1 && path[1] == ':' &&
+        ((path[0] >= 'A' && path[0] <= 'Z') || (path[0] >= 'a' && path[0] <= 'z'))) {
+        return path.size() > 2 && ca_io_path::is_separator(path[2]) ? 3 : 2;
+    }
+#endif
+    return ca_io_path::is_separator(path[0]) ? 1 : 0;
+}
+
+/**
+ * @brief Checks if a path is absolute.
+ */
+bool
+is_absolute_path(const std::string_view path) {
+#ifdef _WIN32
+    const ca_size_t root = root_length(path);
+    return root > 2 || (root == 2 && path[1] != ':');
+#else
+    return !path.empty() && path[0] == '/';
+#endif
+}
+
+}
+
+ca_io_path::ca_io_path() noexcept
+    : heap(nullptr), len(0), cap(0) {
+    local[0] = '\0';
+}
+
+ca_io_path::ca_io_path(const std::string_view path)
+    : ca_io_path() {
+    assign(path);
+}
+
+ca_io_path::ca_io_path(const char *path)
+    : ca_io_path() {
+    assert(path != nullptr);
+    assign(path);
+}
+
+ca_io_path::~ca_io_path() {
+    delete[] heap;
+}
+
+ca_io_path::ca_io_path(const ca_io_path &other)
+    : ca_io_path() {
+    assign(other.view());
+}
+
+ca_io_path &
+ca_io_path::operator=(const ca_io_path &other) {
+    return assign(other.view());
+}
+
+ca_io_path::ca_io_path(ca_io_path &&other) noexcept
+    : ca_io_path() {
+    *this = std::move(other);
+}
+
+ca_io_path &
+ca_io_path::operator=(ca_io_path &&other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    delete[] heap;
+    heap = std::exchange(other.heap, nullptr);
+    cap = std::exchange(other.cap, 0);
+    len = std::exchange(other.len, 0);
+    if (heap == nullptr) {
+        std::memcpy(local, other.local, len + 1);
+    }
+    other.local[0] = '\0';
+    return *this;
+}
+
+ca_io_path &
+ca_io_path::assign(const std::string_view path) {
+    // A view of this path is never longer than the capacity, so it is not
+    // moved by `reserve`
+    reserve(path.size());
+    char *p = data();
+    std::memmove(p, path.data(), path.size());
+    len = path.size();
+    p[len] = '\0';
+    return *this;
+}
+
+ca_io_path &
+ca_io_path::append(std::string_view path) {
+    if (path.empty()) {
+        return *this;
+    }
+    if (len == 0 || root_length(path) > 0) {
+        return assign(path);
+    }
+
+    // Rebase a view of this path after `reserve`
+    const char *old = data();
+    const bool aliased = path.data() >= old && path.data() <= old + len;
+    const ca_size_t offset = aliased ? static_cast<ca_size_t>(path.data() - old) : 0;
+
+    const bool needs_separator = !is_separator(data()[len - 1]);
+    reserve(len + needs_separator + path.size());
+    char *p = data();
+    if (aliased) {
+        path = std::string_view(p + offset, path.size());
+    }
+    if (needs_separator) {
+        p[len++] = PREFERRED_SEPARATOR;
+    }
+    std::memmove(p + len, path.data(), path.size());
+    len += path.size();
+    p[len] = '\0';
+    return *this;
+}
+
+ca_io_path
+ca_io_path::join(const std::string_view path) const {
+    ca_io_path joined(*this);
+    joined.append(path);
+    return joined;
+}
+
+std::string_view
+ca_io_path::parent() const {
+    const std::string_view path = view();
+    const ca_size_t root = root_length(path);
+    const std::string_view last = name();
+    if (last.empty()) {
+        return path.substr(0, root);
+    }
+    ca_size_t end = static_cast<ca_size_t>(last.data() - path.data());
+    while (end > root && is_separator(path[end - 1])) {
+        --end;
+    }
+    return path.substr(0, end);
+}
+
+std::string_view
+ca_io_path::name() const {
+    const std::string_view path = view();
+    const ca_size_t root = root_length(path);
+    ca_size_t end = path.size();
+    while (end > root && is_separator(path[end - 1])) {
+        --end;
+    }
+    ca_size_t begin = end;
+    while (begin > root && !is_separator(path[begin - 1])) {
+        --begin;
+    }
+    return path.substr(begin, end - begin);
+}
+
+std::string_view
+ca_io_path::stem() const {
+    const std::string_view last = name();
+    return last.substr(0, last.size() - suffix().size());
+}
+
+std::string_view
+ca_io_path::suffix() const {
+    const std::string_view last = name();
+    const ca_size_t dot = last.rfind('.');
+    if (dot == std::string_view::npos || dot == 0 || last == "..") {
+        return {};
+    }
+    return last.substr(dot);
+}
+
+bool
+ca_io_path::is_absolute() const {
+    return is_absolute_path(view());
+}
+
+ca_io_path &
+ca_io_path::normalize() {
+    char *p = data();
+    const ca_size_t root = root_length(view());
+    for (ca_size_t i = 0; i < root; ++i) {
+        if (is_separator(p[i])) {
+            p[i] = PREFERRED_SEPARATOR;
+        }
+    }
+    // `..` cannot climb above a root ending in a separator
+    const bool rooted = root > 0 && p[root - 1] == PREFERRED_SEPARATOR;
+
+    // Components are compacted towards the front; the write position never
+    // passes the read position
+    ca_size_t w = root;
+    ca_size_t r = root;
+    while (r < len) {
+        while (r < len && is_separator(p[r])) {
+            ++r;
+        }
+        if (r == len) {
+            break;
+        }
+        const ca_size_t begin = r;
+        while (r < len && !is_separator(p[r])) {
+            ++r;
+        }
+        const ca_size_t size = r - begin;
+
+        if (size == 1 && p[begin] == '.') {
+            continue;
+        }
+        if (size == 2 && p[begin] == '.' && p[begin + 1] == '.') {
+            if (w > root) {
+                ca_size_t last = w;
+                while (last > root && p[last - 1] != PREFERRED_SEPARATOR) {
+                    --last;
+                }
+                if (w - last != 2 || p[last] != '.' || p[last + 1] != '.') {
+                    w = last > root ? last - 1 : root;
+                    continue;
+                }
+            }
+            else if (rooted) {
+                continue;
+            }
+        }
+
+        if (w > root) {
+            p[w++] = PREFERRED_SEPARATOR;
+        }
+        std::memmove(p + w, p + begin, size);
+        w += size;
+    }
+
+    len = w;
+    if (len == 0) {
+        p[len++] = '.';
+    }
+    p[len] = '\0';
+    return *this;
+}
+
+int
+ca_io_path::make_absolute() {
+    if (is_absolute()) {
+        normalize();
+        return 0;
+    }
+    ca_io_path absolute;
+    if (current_directory(&absolute) != 0) {
+        return -1;
+    }
+    absolute.append(view());
+    absolute.normalize();
+    *this = std::move(absolute);
+    return 0;
+}
+
+ca_io_path &
+ca_io_path::make_posix() {
+    char *p = data();
+    for (ca_size_t i = 0; i < len; ++i) {
+        if (p[i] == '\\') {
+            p[i] = '/';
+        }
+    }
+    return *this;
+}
+
+ca_io_path &
+ca_io_path::make_windows() {
+    char *p = data();
+    for (ca_size_t i = 0; i < len; ++i) {
+        if (p[i] == '/') {
+            p[i] = '\\';
+        }
+    }
+    return *this;
+}
+
+bool
+ca_io_path::is_valid() const {
+    const std::string_view path = view();
+    if (path.empty() || path.find('\0') != std::string_view::npos) {
+        return false;
+    }
+#ifdef _WIN32
+    const ca_size_t root = root_length(path);
+    const ca_size_t drive = root >= 2 && path[1] == ':' ? 2 : 0;
+    if (path.find_first_of("<>\"|?*") != std::string_view::npos ||
+        path.find(':', drive) != std::string_view::npos) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+std::string_view
+ca_io_path::view() const {
+    return { c_str(), len };
+}
+
+const char *
+ca_io_path::c_str() const {
+    return heap != nullptr ? heap : local;
+}
+
+ca_size_t
+ca_io_path::size() const {
+    return len;
+}
+
+bool
+ca_io_path::empty() const {
+    return len == 0;
+}
+
+bool
+ca_io_path::is_inline() const {
+    return heap == nullptr;
+}
+
+bool
+operator==(const ca_io_path &lhs, const ca_io_path &rhs) {
+    return lhs.view() == rhs.view();
+}
+
+void
+ca_io_path::reserve(const ca_size_t capacity) {
+    const ca_size_t current = heap != nullptr ? cap : INLINE_CAPACITY;
+    if (capacity <= current) {
+        return;
+    }
+    const ca_size_t grown = ca_math::ca_max(capacity, 2 * current);
+    char *block = new char[grown + 1];
+    std::memcpy(block, data(), len + 1);
+    delete[] heap;
+    heap = block;
+    cap = grown;
+}
+
+char *
+ca_io_path::data() {
+    return heap != nullptr ? heap : local;
+}
+
+ca_path_id
+ca_path_table::intern(const std::string_view path) {
+    ca_io_path normalized(path);
+    normalized.normalize();
+    return intern_normalized(normalized.view());
+}
+
+ca_path_id
+ca_path_table::intern_normalized(const std::string_view path) {
+    const auto *bytes = reinterpret_cast<const ca_string::ca_char_t *>(path.data());
+    {
+        std::shared_lock lock(mutex);
+        const ca_path_id id = pool.find(bytes, path.size());
+        if (id != INVALID_ID) {
+            return id;
+        }
+    }
+    std::unique_lock lock(mutex);
+    return pool.intern(bytes, path.size());
+}
+
+ca_path_id
+ca_path_table::find(const std::string_view path) const {
+    ca_io_path normalized(path);
+    normalized.normalize();
+    std::shared_lock lock(mutex);
+    return pool.find(reinterpret_cast<const ca_string::ca_char_t *>(normalized.c_str()), normalized.size());
+}
+
+std::string_view
+ca_path_table::view(const ca_path_id id) const {
+    std::shared_lock lock(mutex);
+    const ca_string::ca_buffer<ca_string::ca_encoding_t::CA_ENCODING_UTF8> text = pool.view(id);
+    return { reinterpret_cast<const char *>(text.buf), static_cast<ca_size_t>(text.after - text.buf) };
+}
+
+ca_size_t
+ca_path_table::size() const {
+    std::shared_lock lock(mutex);
+    return pool.size();
+}
+
+ca_path_table &
+ca_path_table::global() {
+    static ca_path_table table;
+    return table;
+}
+
+}
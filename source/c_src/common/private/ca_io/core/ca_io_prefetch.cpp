@@ -0,0 +1,144 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/ca_io_prefetch.cpp
+//
+// @file
+// @brief Implements the schedule-ordered prefetcher.
+// ================================
+
+#include "core/ca_io_prefetch.h"
+#include "core/internal/ca_io_prefetch_hint.h"
+
+#include <cassert>
+#include <chrono>
+
+namespace ca::ca_io {
+
+ca_prefetcher::ca_prefetcher(const ca_prefetch_options &options)
+    : options(options), next_hint(0), outstanding_bytes(0), counters{}, stopping(false) {
+    thread = std::thread([this] { run(); });
+}
+
+ca_prefetcher::~ca_prefetcher() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    thread.join();
+}
+
+ca_size_t
+ca_prefetcher::schedule(const std::span<const std::string> paths) {
+    ca_size_t first;
+    {
+        std::lock_guard lock(mutex);
+        first = files.size();
+        for (const std::string &path : paths) {
+            files.push_back({ path, 0, file_state::PENDING });
+        }
+    }
+    wakeup.notify_all();
+    return first;
+}
+
+ca_file_result
+ca_prefetcher::acquire(const ca_size_t index, ca_file_view *view) {
+    assert(view != nullptr);
+
+    std::string file_path;
+    {
+        std::lock_guard lock(mutex);
+        assert(index < files.size());
+        entry &file = files[index];
+        switch (file.state) {
+            case file_state::HINTED:
+                outstanding_bytes -= file.size;
+                break;
+            case file_state::PENDING:
+            case file_state::HINTING:
+                ++counters.stalls;
+                break;
+            case file_state::ACQUIRED:
+                break;
+        }
+        file.state = file_state::ACQUIRED;
+        ++counters.acquired;
+        file_path = file.path;
+    }
+    // Acquiring moves the window and may release budget
+    wakeup.notify_all();
+
+    const auto start = std::chrono::steady_clock::now();
+    const ca_file_result result = ca_file_read(file_path.c_str(), view, options.read);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    std::lock_guard lock(mutex);
+    counters.read_ns += static_cast<ca_uint64_t>(elapsed.count());
+    return result;
+}
+
+std::string
+ca_prefetcher::path(const ca_size_t index) const {
+    std::lock_guard lock(mutex);
+    assert(index < files.size());
+    return files[index].path;
+}
+
+ca_size_t
+ca_prefetcher::size() const {
+    std::lock_guard lock(mutex);
+    return files.size();
+}
+
+ca_prefetch_stats
+ca_prefetcher::stats() const {
+    std::lock_guard lock(mutex);
+    return counters;
+}
+
+bool
+ca_prefetcher::can_hint() const {
+    return next_hint < files.size() && next_hint < counters.acquired + options.distance &&
+           outstanding_bytes < options.memory_budget;
+}
+
+void
+ca_prefetcher::run() {
+    std::unique_lock lock(mutex);
+    for (;;) {
+        wakeup.wait(lock, [this] { return stopping || can_hint(); });
+        if (stopping) {
+            return;
+        }
+
+        const ca_size_t index = next_hint++;
+        if (files[index].state != file_state::PENDING) {
+            continue;
+        }
+        files[index].state = file_state::HINTING;
+        // The schedule may grow and move while unlocked
+        const std::string file_path = files[index].path;
+
+        lock.unlock();
+        ca_size_t size = 0;
+        const bool hinted = internal::ca_prefetch_hint(file_path.c_str(), &size) == 0;
+        lock.lock();
+
+        entry &file = files[index];
+        if (file.state != file_state::HINTING) {
+            // Acquired meanwhile
+            continue;
+        }
+        // Files that cannot be opened are left for `acquire` to report
+        file.state = file_state::HINTED;
+        if (!hinted) {
+            continue;
+        }
+        file.size = size;
+        outstanding_bytes += size;
+        ++counters.hinted;
+        counters.hinted_bytes += size;
+    }
+}
+
+}
@@ -0,0 +1,129 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/ca_io_watcher.cpp
+//
+// @file
+// @brief Implements the debouncing front end of `ca_file_watcher`.
+// ================================
+
+#include "core/ca_io_watcher.h"
+#include "core/internal/ca_io_watch_backend.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace ca::ca_io {
+
+ca_file_watcher::ca_file_watcher()
+    : stopping(false) {
+}
+
+ca_file_watcher::~ca_file_watcher() {
+    stop();
+}
+
+ca_file_result
+ca_file_watcher::start(const char *root, const ca_watch_options &options, const ca_watch_callback &callback) {
+    assert(root != nullptr);
+
+    if (backend != nullptr) {
+        return ca_file_result::FILE_ERROR_BUSY;
+    }
+
+    this->root = root;
+    while (this->root.size() > 1 && (this->root.back() == '/' || this->root.back() == '\\')) {
+        this->root.pop_back();
+    }
+    this->options = options;
+    this->callback = callback;
+
+    ca_file_result result = ca_file_result::FILE_OK;
+    backend = internal::make_watch_backend(this->root, this->options, &result);
+    if (backend == nullptr) {
+        return result;
+    }
+    stopping = false;
+    thread = std::thread([this] { run(); });
+    return ca_file_result::FILE_OK;
+}
+
+void
+ca_file_watcher::stop() {
+    if (backend == nullptr) {
+        return;
+    }
+    stopping = true;
+    backend->wake();
+    thread.join();
+    backend.reset();
+}
+
+bool
+ca_file_watcher::is_running() const {
+    return backend != nullptr;
+}
+
+void
+ca_file_watcher::run() {
+    using clock = std::chrono::steady_clock;
+    const std::chrono::milliseconds debounce(options.debounce_ms);
+    const std::chrono::milliseconds max_delay(options.max_delay_ms);
+
+    std::vector<std::string> changed;
+    bool rescan = false;
+    clock::time_point first_event{};
+    clock::time_point last_event{};
+
+    while (!stopping) {
+        const bool pending = !changed.empty() || rescan;
+        int timeout_ms = -1;
+        if (pending) {
+            const clock::time_point due = std::min(last_event + debounce, first_event + max_delay);
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(due - clock::now()).count();
+            timeout_ms = static_cast<int>(std::max<decltype(left)>(left, 0));
+        }
+
+        const ca_size_t before = changed.size();
+        const bool had_rescan = rescan;
+        backend->wait(timeout_ms, &changed, &rescan);
+        const clock::time_point now = clock::now();
+
+        if (changed.size() != before || rescan != had_rescan) {
+            if (!pending) {
+                first_event = now;
+            }
+            last_event = now;
+        }
+        if ((!changed.empty() || rescan) && (now >= last_event + debounce || now >= first_event + max_delay)) {
+            deliver(&changed, &rescan);
+        }
+    }
+}
+
+void
+ca_file_watcher::deliver(std::vector<std::string> *changed, bool *rescan) {
+    std::ranges::sort(*changed);
+    const auto duplicates = std::ranges::unique(*changed);
+    changed->erase(duplicates.begin(), duplicates.end());
+
+    ca_path_table &table = options.table != nullptr ? *options.table : ca_path_table::global();
+    ca_watch_batch batch;
+    batch.rescan = *rescan;
+    batch.paths.reserve(changed->size());
+    batch.ids.reserve(changed->size());
+    for (const std::string &relative : *changed) {
+        std::string path = root;
+        if (path.back() != '/' && path.back() != '\\') {
+            path += '/';
+        }
+        path += relative;
+        batch.ids.push_back(table.intern(path));
+        batch.paths.push_back(std::move(path));
+    }
+
+    changed->clear();
+    *rescan = false;
+    callback(batch);
+}
+
+}
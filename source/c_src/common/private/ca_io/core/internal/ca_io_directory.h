@@ -0,0 +1,50 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/internal/ca_io_directory.h
+//
+// @file
+// @brief Declares the platform primitives used by the directory walker.
+// ================================
+
+#ifndef CA_IO_DIRECTORY_H
+#define CA_IO_DIRECTORY_H
+
+#include "core/ca_io_folder.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace ca::ca_io::internal {
+
+/**
+ * @typedef ca_directory_callback
+ * @brief Receives the name and the type of a directory entry, and whether
+ *        the entry is a symbolic link.
+ */
+typedef std::function<void(std::string_view name, ca_folder_entry_type type, bool is_symlink)> ca_directory_callback;
+
+/**
+ * @brief Lists the entries of a directory, except `.` and `..`.
+ *
+ * Symbolic links are resolved to the type of their target.
+ *
+ * @param path [in] Path of the directory. Must not be `nullptr`.
+ * @param callback [in] Called for every entry.
+ * @return `FILE_OK`, or the error opening or reading the directory.
+ */
+ca_file_result
+ca_list_directory(const char *path, const ca_directory_callback &callback);
+
+/**
+ * @brief Resolves a path to its canonical absolute form.
+ *
+ * @param path [in] The path. Must not be `nullptr`.
+ * @param canonical [out] Receives the canonical path. Must not be `nullptr`.
+ * @return `0` on success, or `-1` if the path cannot be resolved.
+ */
+int
+ca_canonical_path(const char *path, std::string *canonical);
+
+}
+
+#endif //CA_IO_DIRECTORY_H
@@ -0,0 +1,39 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/internal/ca_io_file_metadata_backend.h
+//
+// @file
+// @brief Declares the platform primitives of metadata scanning.
+// ================================
+
+#ifndef CA_IO_FILE_METADATA_BACKEND_H
+#define CA_IO_FILE_METADATA_BACKEND_H
+
+#include "core/ca_io_file_metadata.h"
+
+namespace ca::ca_io::internal {
+
+/**
+ * @brief Queries the metadata of one file.
+ *
+ * @param path [in] Path of the file. Must not be `nullptr`.
+ * @param metadata [out] Receives the metadata. Must not be `nullptr`.
+ */
+void
+ca_query_metadata(const char *path, ca_file_metadata *metadata);
+
+/**
+ * @brief Queries the metadata of many files with io_uring.
+ *
+ * @param paths [in] Paths of the files.
+ * @param metadata [out] Receives the metadata, as long as `paths`.
+ * @param queue_depth Queries in flight at once.
+ * @return `0` on success, or `-1` if io_uring is unavailable, in which case
+ *         nothing was queried.
+ */
+int
+ca_query_metadata_io_uring(std::span<const char *const> paths, std::span<ca_file_metadata> metadata,
+                           ca_size_t queue_depth);
+
+}
+
+#endif //CA_IO_FILE_METADATA_BACKEND_H
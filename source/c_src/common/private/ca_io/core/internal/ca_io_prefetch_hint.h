@@ -0,0 +1,27 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/internal/ca_io_prefetch_hint.h
+//
+// @file
+// @brief Declares the platform primitive of the prefetcher.
+// ================================
+
+#ifndef CA_IO_PREFETCH_HINT_H
+#define CA_IO_PREFETCH_HINT_H
+
+#include "ca_math.h"
+
+namespace ca::ca_io::internal {
+
+/**
+ * @brief Asks the kernel to start reading a whole file into the page cache.
+ *
+ * @param path [in] Path of the file. Must not be `nullptr`.
+ * @param size [out] Receives the size of the file. Must not be `nullptr`.
+ * @return `0` if the hint was issued, `-1` if the file could not be opened.
+ */
+int
+ca_prefetch_hint(const char *path, ca_size_t *size);
+
+}
+
+#endif //CA_IO_PREFETCH_HINT_H
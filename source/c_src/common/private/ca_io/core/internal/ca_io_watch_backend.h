@@ -0,0 +1,57 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/internal/ca_io_watch_backend.h
+//
+// @file
+// @brief Declares the platform event sources behind `ca_file_watcher`.
+// ================================
+
+#ifndef CA_IO_WATCH_BACKEND_H
+#define CA_IO_WATCH_BACKEND_H
+
+#include "core/ca_io_watcher.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ca::ca_io::internal {
+
+/**
+ * @struct ca_watch_backend
+ * @brief Collects the changes of a watched tree.
+ */
+struct ca_watch_backend {
+    virtual ~ca_watch_backend() = default;
+
+    /**
+     * @brief Waits for events and appends the changed files.
+     *
+     * @param timeout_ms Longest wait, -1 to wait until an event or `wake`.
+     * @param changed [out] Receives the paths of the changed files, relative
+     *                to the root and `/`-separated, possibly repeated.
+     * @param rescan [out] Set to `true` if events were lost.
+     */
+    virtual void
+    wait(int timeout_ms, std::vector<std::string> *changed, bool *rescan) = 0;
+
+    /**
+     * @brief Makes a pending or the next `wait` return at once. Thread-safe.
+     */
+    virtual void
+    wake() = 0;
+};
+
+/**
+ * @brief Creates the backend of the platform and registers the tree.
+ *
+ * @param root [in] The directory to watch, without trailing separators.
+ * @param options [in] Watch options.
+ * @param result [out] Receives the result of the registration. Must not be `nullptr`.
+ * @return The backend, or `nullptr` on failure.
+ */
+std::unique_ptr<ca_watch_backend>
+make_watch_backend(const std::string &root, const ca_watch_options &options, ca_file_result *result);
+
+}
+
+#endif //CA_IO_WATCH_BACKEND_H
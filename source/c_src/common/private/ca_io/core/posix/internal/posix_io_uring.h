@@ -0,0 +1,122 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/internal/posix_io_uring.h
+//
+// @file
+// @brief Defines a minimal io_uring wrapper over the raw system calls.
+// ================================
+
+#ifndef POSIX_IO_URING_H
+#define POSIX_IO_URING_H
+
+#include "ca_math.h"
+
+#include <atomic>
+#include <cstring>
+#include <initializer_list>
+#include <linux/io_uring.h>
+
+namespace ca::ca_io::internal {
+
+/**
+ * @struct posix_io_uring
+ * @brief One io_uring instance with its mapped submission and completion
+ *        queues.
+ *
+ * The wrapper is meant to be driven by a single thread: entries are filled
+ * with `get_sqe`, handed to the kernel by `submit_and_wait`, and completions
+ * are consumed with `for_each_cqe`.
+ */
+struct posix_io_uring {
+    posix_io_uring() = default;
+    ~posix_io_uring();
+
+    posix_io_uring(const posix_io_uring &) = delete;
+    posix_io_uring &operator=(const posix_io_uring &) = delete;
+    posix_io_uring(posix_io_uring &&other) noexcept;
+    posix_io_uring &operator=(posix_io_uring &&other) = delete;
+
+    /**
+     * @brief Creates the ring and maps its queues.
+     *
+     * @param entries Size of the submission queue, a power of two.
+     * @return `0` on success, or `-1` if io_uring is unavailable.
+     */
+    int
+    init(unsigned entries);
+
+    /**
+     * @brief Checks if the kernel supports every given opcode.
+     */
+    [[nodiscard]] bool
+    supports(std::initializer_list<ca_uint8_t> opcodes) const;
+
+    /**
+     * @brief Returns a cleared submission entry, or `nullptr` if the
+     *        submission queue is full.
+     */
+    io_uring_sqe *
+    get_sqe() {
+        const unsigned head = std::atomic_ref(*sq_head).load(std::memory_order_acquire);
+        if (sqe_tail - head >= sq_entries) {
+            return nullptr;
+        }
+        const unsigned index = sqe_tail & *sq_mask;
+        io_uring_sqe *sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sq_array[index] = index;
+        ++sqe_tail;
+        return sqe;
+    }
+
+    /**
+     * @brief Submits the filled entries and waits for completions.
+     *
+     * @param wait_nr Number of completions to wait for.
+     * @return `0` on success, or the negated `errno` of `io_uring_enter`.
+     */
+    int
+    submit_and_wait(unsigned wait_nr);
+
+    /**
+     * @brief Calls `f` on every available completion and consumes them.
+     *
+     * @return The number of completions consumed.
+     */
+    template <typename F>
+    unsigned
+    for_each_cqe(F &&f) {
+        unsigned head = *cq_head;
+        const unsigned tail = std::atomic_ref(*cq_tail).load(std::memory_order_acquire);
+        const unsigned count = tail - head;
+        for (; head != tail; ++head) {
+            f(static_cast<const io_uring_cqe &>(cqes[head & *cq_mask]));
+        }
+        std::atomic_ref(*cq_head).store(tail, std::memory_order_release);
+        return count;
+    }
+
+private:
+    int ring_fd = -1;                   ///< The ring.
+    unsigned sq_entries = 0;            ///< Size of the submission queue.
+    unsigned sqe_tail = 0;              ///< Tail including entries not submitted yet.
+
+    void *sq_ring = nullptr;            ///< Mapping of the submission ring.
+    ca_size_t sq_ring_size = 0;         ///< Size of `sq_ring`.
+    void *cq_ring = nullptr;            ///< Mapping of the completion ring, may alias `sq_ring`.
+    ca_size_t cq_ring_size = 0;         ///< Size of `cq_ring`.
+    io_uring_sqe *sqes = nullptr;       ///< Mapped submission entries.
+    ca_size_t sqes_size = 0;            ///< Size of `sqes` in bytes.
+
+    unsigned *sq_head = nullptr;        ///< Submission head, written by the kernel.
+    unsigned *sq_tail = nullptr;        ///< Submission tail.
+    unsigned *sq_mask = nullptr;        ///< Submission index mask.
+    unsigned *sq_array = nullptr;       ///< Submission index array.
+    unsigned *cq_head = nullptr;        ///< Completion head.
+    unsigned *cq_tail = nullptr;        ///< Completion tail, written by the kernel.
+    unsigned *cq_mask = nullptr;        ///< Completion index mask.
+    io_uring_cqe *cqes = nullptr;       ///< Completion entries.
+};
+
+}
+
+#endif //POSIX_IO_URING_H
@@ -1,5 +1,5 @@
 // ================================
-// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/internal/posix_translater
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/internal/posix_translater.h
 //
 // @file
 // @brief Translator for Posix file operations.
@@ -12,9 +12,10 @@
 #include <errno.h>
 #include "core/file_defs.h"
 
-namespace ca::ca_file::internal {
+namespace ca::ca_io::internal {
 
-static int ca_translate_open_flags(const ca_file_mode mode) {
+inline int
+ca_translate_open_flags(const ca_file_mode mode) {
     switch (mode) {
         case ca_file_mode::FILE_MODE_READ:
         case ca_file_mode::FILE_MODE_READ_EXISTING:
@@ -49,7 +50,8 @@ static int ca_translate_open_flags(const ca_file_mode mode) {
     }
 }
 
-static ca_file_result ca_translate_errno(int err) {
+inline ca_file_result
+ca_translate_errno(const int err) {
     switch (err) {
         case 0: return ca_file_result::FILE_OK;
         case ENOENT: return ca_file_result::FILE_ERROR_NOT_FOUND;
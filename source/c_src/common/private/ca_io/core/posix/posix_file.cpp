@@ -0,0 +1,37 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/posix_file.cpp
+//
+// @file
+// @brief Implements basic file operations for Posix.
+// ================================
+
+#include "core/ca_io_file.h"
+#include "core/posix/internal/posix_translater.h"
+
+#include <cassert>
+#include <sys/stat.h>
+
+namespace ca::ca_io {
+
+ca_file_result
+ca_file_stat(const char *path, ca_file_stamp *stamp) {
+    assert(path != nullptr);
+    assert(stamp != nullptr);
+
+    struct stat st{};
+    if (stat(path, &st) != 0) {
+        return internal::ca_translate_errno(errno);
+    }
+
+    stamp->device = static_cast<ca_uint64_t>(st.st_dev);
+    stamp->inode = static_cast<ca_uint64_t>(st.st_ino);
+    stamp->size = static_cast<ca_uint64_t>(st.st_size);
+#ifdef __APPLE__
+    stamp->mtime_ns = static_cast<ca_int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    stamp->mtime_ns = static_cast<ca_int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    return ca_file_result::FILE_OK;
+}
+
+}
@@ -0,0 +1,125 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/posix_file_metadata.cpp
+//
+// @file
+// @brief Implements metadata queries for Posix, batched through io_uring on
+//        Linux.
+// ================================
+
+#include "core/internal/ca_io_file_metadata_backend.h"
+#include "core/posix/internal/posix_translater.h"
+
+#include <cassert>
+#include <sys/stat.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define CA_IO_HAVE_IO_URING
+#endif
+
+#ifdef CA_IO_HAVE_IO_URING
+#include "core/posix/internal/posix_io_uring.h"
+
+#include <bit>
+#include <fcntl.h>
+#include <vector>
+#endif
+
+namespace ca::ca_io::internal {
+
+void
+ca_query_metadata(const char *path, ca_file_metadata *metadata) {
+    assert(path != nullptr);
+    assert(metadata != nullptr);
+
+    struct stat st{};
+    if (stat(path, &st) != 0) {
+        *metadata = ca_file_metadata{};
+        metadata->result = ca_translate_errno(errno);
+        return;
+    }
+
+    metadata->size = static_cast<ca_uint64_t>(st.st_size);
+#ifdef __APPLE__
+    metadata->mtime_ns = static_cast<ca_int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    metadata->mtime_ns = static_cast<ca_int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    metadata->inode = static_cast<ca_uint64_t>(st.st_ino);
+    metadata->mode = static_cast<ca_uint32_t>(st.st_mode);
+    metadata->result = ca_file_result::FILE_OK;
+}
+
+#ifdef CA_IO_HAVE_IO_URING
+
+int
+ca_query_metadata_io_uring(const std::span<const char *const> paths, const std::span<ca_file_metadata> metadata,
+                           const ca_size_t queue_depth) {
+    assert(metadata.size() == paths.size());
+
+    const ca_size_t depth = ca_math::ca_max<ca_size_t>(ca_math::ca_min(queue_depth, paths.size()), 1);
+    posix_io_uring ring;
+    if (ring.init(static_cast<unsigned>(std::bit_ceil(depth))) != 0 || !ring.supports({ IORING_OP_STATX })) {
+        return -1;
+    }
+
+    // One statx buffer per slot; the user data of an entry is its slot
+    std::vector<struct statx> buffers(depth);
+    std::vector<ca_size_t> slot_file(depth);
+    std::vector<ca_size_t> free_slots(depth);
+    for (ca_size_t i = 0; i < depth; ++i) {
+        free_slots[i] = depth - 1 - i;
+    }
+
+    ca_size_t next = 0;
+    ca_size_t in_flight = 0;
+    while (next < paths.size() || in_flight > 0) {
+        while (next < paths.size() && !free_slots.empty()) {
+            io_uring_sqe *sqe = ring.get_sqe();
+            if (sqe == nullptr) {
+                break;
+            }
+            const ca_size_t slot = free_slots.back();
+            free_slots.pop_back();
+            sqe->opcode = IORING_OP_STATX;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = reinterpret_cast<ca_uint64_t>(paths[next]);
+            sqe->len = STATX_TYPE | STATX_MODE | STATX_INO | STATX_SIZE | STATX_MTIME;
+            sqe->off = reinterpret_cast<ca_uint64_t>(&buffers[slot]);
+            sqe->user_data = slot;
+            slot_file[slot] = next++;
+            ++in_flight;
+        }
+
+        ring.submit_and_wait(1);
+        ring.for_each_cqe([&](const io_uring_cqe &cqe) {
+            const auto slot = static_cast<ca_size_t>(cqe.user_data);
+            ca_file_metadata &out = metadata[slot_file[slot]];
+            if (cqe.res < 0) {
+                out = ca_file_metadata{};
+                out.result = ca_translate_errno(-cqe.res);
+            }
+            else {
+                const struct statx &stx = buffers[slot];
+                out.size = stx.stx_size;
+                out.mtime_ns = static_cast<ca_int64_t>(stx.stx_mtime.tv_sec) * 1000000000 + stx.stx_mtime.tv_nsec;
+                out.inode = stx.stx_ino;
+                out.mode = stx.stx_mode;
+                out.result = ca_file_result::FILE_OK;
+            }
+            free_slots.push_back(slot);
+            --in_flight;
+        });
+    }
+    return 0;
+}
+
+#else
+
+int
+ca_query_metadata_io_uring(std::span<const char *const>, std::span<ca_file_metadata>, ca_size_t) {
+    return -1;
+}
+
+#endif
+
+}
@@ -0,0 +1,482 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/posix_file_rw_asyn.cpp
+//
+// @file
+// @brief Implements the io_uring backend of `ca_async_file_reader` on Linux,
+//        using the raw system calls without liburing.
+// ================================
+
+#include "core/rw/ca_io_file_rw_asyn_backend.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define CA_IO_HAVE_IO_URING
+#endif
+
+#ifdef CA_IO_HAVE_IO_URING
+
+#include "core/posix/internal/posix_io_uring.h"
+#include "core/posix/internal/posix_translater.h"
+#include "core/rw/ca_io_file_view_access.h"
+
+#include <atomic>
+#include <bit>
+#include <deque>
+#include <fcntl.h>
+#include <mutex>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#endif
+
+namespace ca::ca_io::internal {
+
+#ifdef CA_IO_HAVE_IO_URING
+
+namespace {
+
+using ca_string::ca_char_t;
+
+/**
+ * @brief Largest request passed to a single read.
+ */
+constexpr ca_size_t MAX_READ_SIZE = 1u << 30;
+
+/**
+ * @brief Kinds of operations, stored in the low bits of the user data.
+ */
+enum op_kind : ca_uint64_t {
+    OP_OPEN = 0,
+    OP_STAT = 1,
+    OP_READ = 2,
+    OP_CLOSE = 3,
+};
+
+constexpr ca_uint64_t OP_BITS = 2;
+constexpr ca_uint64_t WAKEUP_USER_DATA = ~ca_uint64_t{ 0 };
+
+/**
+ * @struct file_op
+ * @brief State of one file in flight.
+ */
+struct file_op {
+    ca_async_request request;       ///< The request being served.
+    struct statx stx;               ///< Result of the `statx`.
+    int fd;                         ///< Descriptor once opened, -1 before.
+    int error;                      ///< First `errno` met, 0 if none.
+    unsigned outstanding;           ///< Operations submitted but not completed.
+    bool read_by_worker;            ///< Whether the size is unknown and the file is handed to the workers.
+    ca_char_t *buffer;              ///< Pooled buffer receiving the contents.
+    ca_size_t capacity;             ///< Capacity of `buffer`.
+    ca_size_t size;                 ///< Size of the file.
+    ca_size_t done;                 ///< Bytes read so far.
+};
+
+/**
+ * @struct io_uring_backend
+ * @brief Serves all requests from one ring driven by a dedicated thread.
+ *
+ * Submitters queue requests and signal an eventfd that the ring polls, so
+ * the ring thread can block in `io_uring_enter` until either a completion
+ * or new work arrives. Files of unknown size may block their reads, e.g. a
+ * FIFO without a writer, and go to a thread pool backend started on first
+ * use instead. If `io_uring_enter` fails, the files in flight fail with its
+ * error and all later requests go to that backend as well.
+ */
+struct io_uring_backend final : ca_async_backend {
+    io_uring_backend(const ca_async_reader_options &options, posix_io_uring &&ring, const int event_fd)
+        : ring(std::move(ring)), event_fd(event_fd), options(options),
+          pool(options.read.pool != nullptr ? options.read.pool : &ca_io_buffer_pool::global()),
+          slots(ca_math::ca_max<ca_size_t>(options.queue_depth, 1)), stopping(false) {
+        free_slots.reserve(slots.size());
+        for (ca_size_t i = slots.size(); i > 0; --i) {
+            free_slots.push_back(i - 1);
+        }
+        thread = std::thread([this] { run(); });
+    }
+
+    ~io_uring_backend() override {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        signal();
+        thread.join();
+        close(event_fd);
+    }
+
+    void
+    submit(std::vector<ca_async_request> requests) override {
+        bool queued;
+        {
+            std::lock_guard lock(mutex);
+            queued = !broken;
+            if (queued) {
+                for (ca_async_request &request : requests) {
+                    queue.push_back(std::move(request));
+                }
+            }
+        }
+        if (queued) {
+            signal();
+        }
+        else {
+            workers().submit(std::move(requests));
+        }
+    }
+
+    [[nodiscard]] bool
+    is_io_uring() const override {
+        return true;
+    }
+
+private:
+    /**
+     * @brief Returns the workers reading files of unknown size, starting
+     *        them on first use.
+     */
+    ca_async_backend &
+    workers() {
+        std::call_once(workers_started, [this] { fallback = make_thread_pool_backend(options); });
+        return *fallback;
+    }
+
+    /**
+     * @brief Wakes the ring thread.
+     */
+    void
+    signal() const {
+        const ca_uint64_t one = 1;
+        [[maybe_unused]] const ssize_t n = write(event_fd, &one, sizeof(one));
+    }
+
+    /**
+     * @brief Returns a cleared submission entry, submitting queued entries
+     *        first if the queue is full.
+     *
+     * Once the ring failed, returns `discarded`, which is never submitted.
+     */
+    io_uring_sqe *
+    next_sqe() {
+        io_uring_sqe *sqe = ring_error == 0 ? ring.get_sqe() : nullptr;
+        while (sqe == nullptr && ring_error == 0) {
+            if (const int result = ring.submit_and_wait(0); result < 0) {
+                ring_error = -result;
+            }
+            else {
+                sqe = ring.get_sqe();
+            }
+        }
+        if (sqe == nullptr) {
+            discarded = io_uring_sqe{};
+            sqe = &discarded;
+        }
+        return sqe;
+    }
+
+    /**
+     * @brief Queues a poll of the eventfd.
+     */
+    void
+    arm_wakeup() {
+        io_uring_sqe *sqe = next_sqe();
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = event_fd;
+        sqe->poll32_events = POLLIN;
+        sqe->user_data = WAKEUP_USER_DATA;
+    }
+
+    void
+    prep(const ca_size_t slot, const op_kind kind, const ca_uint8_t opcode, const int fd) {
+        io_uring_sqe *sqe = next_sqe();
+        sqe->opcode = opcode;
+        sqe->fd = fd;
+        sqe->user_data = (static_cast<ca_uint64_t>(slot) << OP_BITS) | kind;
+        prepared = sqe;
+        ++slots[slot].outstanding;
+    }
+
+    /**
+     * @brief Starts a request: opens and stats the file at once.
+     */
+    void
+    start(const ca_size_t slot) {
+        file_op &op = slots[slot];
+        const auto path = reinterpret_cast<ca_uint64_t>(op.request.path.c_str());
+
+        prep(slot, OP_OPEN, IORING_OP_OPENAT, AT_FDCWD);
+        prepared->addr = path;
+        prepared->open_flags = O_RDONLY | O_CLOEXEC;
+
+        prep(slot, OP_STAT, IORING_OP_STATX, AT_FDCWD);
+        prepared->addr = path;
+        prepared->len = STATX_TYPE | STATX_SIZE;
+        prepared->off = reinterpret_cast<ca_uint64_t>(&op.stx);
+    }
+
+    void
+    submit_read(const ca_size_t slot) {
+        file_op &op = slots[slot];
+        prep(slot, OP_READ, IORING_OP_READ, op.fd);
+        prepared->addr = reinterpret_cast<ca_uint64_t>(op.buffer + op.done);
+        prepared->len = static_cast<ca_uint32_t>(ca_math::ca_min(op.size - op.done, MAX_READ_SIZE));
+        prepared->off = op.done;
+    }
+
+    void
+    submit_close(const ca_size_t slot) {
+        prep(slot, OP_CLOSE, IORING_OP_CLOSE, slots[slot].fd);
+    }
+
+    /**
+     * @brief Continues once both the open and the stat have completed.
+     */
+    void
+    opened(const ca_size_t slot) {
+        file_op &op = slots[slot];
+        if (op.fd < 0) {
+            finish(slot);
+            return;
+        }
+        if (op.error == 0) {
+            if (S_ISDIR(op.stx.stx_mode)) {
+                op.error = EISDIR;
+            }
+            else if (!S_ISREG(op.stx.stx_mode) || op.stx.stx_size == 0) {
+                op.read_by_worker = true;
+            }
+            else {
+                op.size = static_cast<ca_size_t>(op.stx.stx_size);
+                op.buffer = pool->acquire(op.size, &op.capacity);
+                submit_read(slot);
+                return;
+            }
+        }
+        submit_close(slot);
+    }
+
+    /**
+     * @brief Handles one completion.
+     */
+    void
+    complete(const ca_uint64_t user_data, const int res) {
+        if (user_data == WAKEUP_USER_DATA) {
+            ca_uint64_t count;
+            [[maybe_unused]] const ssize_t n = read(event_fd, &count, sizeof(count));
+            arm_wakeup();
+            return;
+        }
+
+        const ca_size_t slot = static_cast<ca_size_t>(user_data >> OP_BITS);
+        file_op &op = slots[slot];
+        --op.outstanding;
+
+        switch (static_cast<op_kind>(user_data & ((1u << OP_BITS) - 1))) {
+            case OP_OPEN:
+                if (res < 0) {
+                    op.error = -res;
+                }
+                else {
+                    op.fd = res;
+                }
+                if (op.outstanding == 0) {
+                    opened(slot);
+                }
+                break;
+
+            case OP_STAT:
+                if (res < 0 && op.error == 0) {
+                    op.error = -res;
+                }
+                if (op.outstanding == 0) {
+                    opened(slot);
+                }
+                break;
+
+            case OP_READ:
+                if (res == -EINTR || res == -EAGAIN) {
+                    submit_read(slot);
+                    break;
+                }
+                if (res < 0) {
+                    op.error = -res;
+                }
+                else if (res > 0) {
+                    op.done += static_cast<ca_size_t>(res);
+                    if (op.done < op.size) {
+                        submit_read(slot);
+                        break;
+                    }
+                }
+                // res == 0: the file shrank, keep what was read
+                submit_close(slot);
+                break;
+
+            case OP_CLOSE:
+                finish(slot);
+                break;
+        }
+    }
+
+    /**
+     * @brief Delivers the outcome of a request, or hands it to the workers,
+     *        and frees its slot.
+     */
+    void
+    finish(const ca_size_t slot) {
+        file_op &op = slots[slot];
+        const bool forward = op.error == 0 && op.read_by_worker;
+        ca_file_view view;
+        ca_file_result result = ca_file_result::FILE_OK;
+
+        if (op.error != 0) {
+            pool->release(op.buffer, op.capacity);
+            result = ca_translate_errno(op.error);
+        }
+        else if (!forward) {
+            ca_file_view_access::assign_pooled(&view, op.buffer, op.done, op.capacity, pool);
+        }
+
+        ca_async_request request = std::move(op.request);
+        op = file_op{};
+        --active;
+        free_slots.push_back(slot);
+
+        if (forward) {
+            std::vector<ca_async_request> requests;
+            requests.push_back(std::move(request));
+            workers().submit(std::move(requests));
+            return;
+        }
+        (*request.callback)(request.index, result, std::move(view));
+    }
+
+    /**
+     * @brief Fails the files in flight after `io_uring_enter` failed, and
+     *        hands the queued requests to the workers.
+     */
+    void
+    abandon() {
+        std::vector<ca_async_request> requests;
+        {
+            std::lock_guard lock(mutex);
+            broken = true;
+            for (ca_async_request &request : queue) {
+                requests.push_back(std::move(request));
+            }
+            queue.clear();
+        }
+
+        for (ca_size_t slot = 0; slot < slots.size(); ++slot) {
+            file_op &op = slots[slot];
+            if (!op.request.callback) {
+                continue;
+            }
+            if (op.fd >= 0) {
+                close(op.fd);
+            }
+            // A read already submitted may still write to the buffer, which is leaked
+            op.buffer = nullptr;
+            op.capacity = 0;
+            op.error = ring_error;
+            finish(slot);
+        }
+
+        if (!requests.empty()) {
+            workers().submit(std::move(requests));
+        }
+    }
+
+    /**
+     * @brief Takes queued requests into free slots.
+     *
+     * @return `false` once stopping with nothing left to do.
+     */
+    bool
+    admit() {
+        std::lock_guard lock(mutex);
+        while (!free_slots.empty() && !queue.empty()) {
+            const ca_size_t slot = free_slots.back();
+            free_slots.pop_back();
+            slots[slot] = file_op{};
+            slots[slot].fd = -1;
+            slots[slot].request = std::move(queue.front());
+            queue.pop_front();
+            ++active;
+            start(slot);
+        }
+        return !(stopping && queue.empty() && active == 0);
+    }
+
+    void
+    run() {
+        arm_wakeup();
+        while (admit() && ring_error == 0) {
+            if (const int result = ring.submit_and_wait(1); result < 0) {
+                ring_error = -result;
+                break;
+            }
+            ring.for_each_cqe([this](const io_uring_cqe &cqe) {
+                complete(cqe.user_data, cqe.res);
+            });
+        }
+        if (ring_error != 0) {
+            abandon();
+        }
+    }
+
+    posix_io_uring ring;                        ///< The ring, used by the ring thread only.
+    int event_fd;                               ///< Wakes the ring thread.
+    ca_async_reader_options options;            ///< Options, also of the workers.
+    ca_io_buffer_pool *pool;                    ///< Pool of read buffers.
+    std::thread thread;                         ///< The ring thread.
+
+    std::vector<file_op> slots;                 ///< Files in flight, indexed by slot.
+    std::vector<ca_size_t> free_slots;          ///< Unused slots.
+    ca_size_t active = 0;                       ///< Slots in use.
+    io_uring_sqe *prepared = nullptr;           ///< Entry filled by the last `prep`.
+    io_uring_sqe discarded{};                   ///< Entry handed out once the ring failed.
+    int ring_error = 0;                         ///< `errno` of the failed `io_uring_enter`, 0 if none.
+
+    std::mutex mutex;                           ///< Guards `queue`, `stopping` and `broken`.
+    std::deque<ca_async_request> queue;         ///< Requests waiting for a slot.
+    bool stopping;                              ///< Whether the ring thread should exit once idle.
+    bool broken = false;                        ///< Whether the ring failed and requests go to the workers.
+
+    std::once_flag workers_started;             ///< Guards the creation of `fallback`.
+    std::unique_ptr<ca_async_backend> fallback; ///< Workers reading files of unknown size, or `nullptr`.
+};
+
+}
+
+std::unique_ptr<ca_async_backend>
+make_io_uring_backend(const ca_async_reader_options &options) {
+    // Up to two operations per file, and the eventfd poll
+    const ca_size_t depth = ca_math::ca_max<ca_size_t>(options.queue_depth, 1);
+    const auto entries = static_cast<unsigned>(std::bit_ceil(2 * depth + 1));
+
+    posix_io_uring ring;
+    if (ring.init(entries) != 0 ||
+        !ring.supports({ IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_CLOSE, IORING_OP_POLL_ADD })) {
+        return nullptr;
+    }
+
+    const int event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (event_fd < 0) {
+        return nullptr;
+    }
+    return std::make_unique<io_uring_backend>(options, std::move(ring), event_fd);
+}
+
+#else
+
+std::unique_ptr<ca_async_backend>
+make_io_uring_backend(const ca_async_reader_options &) {
+    return nullptr;
+}
+
+#endif
+
+}
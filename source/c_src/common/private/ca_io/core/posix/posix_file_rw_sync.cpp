@@ -0,0 +1,199 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/posix_file_rw_sync.cpp
+//
+// @file
+// @brief Implements synchronous file loading for Posix with `mmap` and
+//        `pread`/`read`.
+// ================================
+
+#include "core/rw/ca_io_file_rw_sync.h"
+#include "core/rw/ca_io_file_view_access.h"
+#include "core/posix/internal/posix_translater.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ca::ca_io {
+
+using ca_string::ca_char_t;
+
+namespace {
+
+/**
+ * @brief Initial buffer size for files of unknown size.
+ */
+constexpr ca_size_t STREAM_INITIAL_SIZE = 64 * 1024;
+
+/**
+ * @brief Closes a descriptor when leaving scope.
+ */
+struct fd_guard {
+    int fd;
+
+    ~fd_guard() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+/**
+ * @brief Reads a regular file of known size into a pooled buffer.
+ *
+ * A file that shrank since `fstat` yields its shorter contents; bytes
+ * appended since are ignored.
+ *
+ * @return `0` on success, or the `errno` of the failed read.
+ */
+int
+read_known_size(const int fd, const ca_size_t size, ca_io_buffer_pool *pool,
+                ca_char_t **data, ca_size_t *len, ca_size_t *capacity) {
+    ca_char_t *block = pool->acquire(size, capacity);
+    ca_size_t done = 0;
+
+    while (done < size) {
+        const ssize_t n = pread(fd, block + done, size - done, static_cast<off_t>(done));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const int err = errno;
+            pool->release(block, *capacity);
+            return err;
+        }
+        if (n == 0) {
+            break;
+        }
+        done += static_cast<ca_size_t>(n);
+    }
+
+    *data = block;
+    *len = done;
+    return 0;
+}
+
+/**
+ * @brief Reads a file of unknown size, such as a pipe, until its end,
+ *        doubling the pooled buffer whenever it fills up.
+ *
+ * @return `0` on success, or the `errno` of the failed read.
+ */
+int
+read_until_end(const int fd, ca_io_buffer_pool *pool,
+               ca_char_t **data, ca_size_t *len, ca_size_t *capacity) {
+    ca_char_t *block = pool->acquire(STREAM_INITIAL_SIZE, capacity);
+    ca_size_t done = 0;
+
+    for (;;) {
+        if (done == *capacity) {
+            ca_size_t new_capacity;
+            ca_char_t *bigger = pool->acquire(*capacity * 2, &new_capacity);
+            memcpy(bigger, block, done);
+            pool->release(block, *capacity);
+            block = bigger;
+            *capacity = new_capacity;
+        }
+
+        const ssize_t n = read(fd, block + done, *capacity - done);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const int err = errno;
+            pool->release(block, *capacity);
+            return err;
+        }
+        if (n == 0) {
+            break;
+        }
+        done += static_cast<ca_size_t>(n);
+    }
+
+    *data = block;
+    *len = done;
+    return 0;
+}
+
+}
+
+void
+ca_file_view::reset() {
+    if (ptr != nullptr) {
+        if (mapped) {
+            munmap(ptr, capacity);
+        }
+        else {
+            pool->release(ptr, capacity);
+        }
+    }
+    ptr = nullptr;
+    len = 0;
+    capacity = 0;
+    pool = nullptr;
+    mapped = false;
+}
+
+ca_file_result
+ca_file_read(const char *path, ca_file_view *view, const ca_file_read_options &options) {
+    assert(path != nullptr);
+    assert(view != nullptr);
+
+    view->reset();
+
+    fd_guard file{ -1 };
+    do {
+        file.fd = open(path, O_RDONLY | O_CLOEXEC);
+    } while (file.fd < 0 && errno == EINTR);
+    if (file.fd < 0) {
+        return internal::ca_translate_errno(errno);
+    }
+
+    struct stat st{};
+    if (fstat(file.fd, &st) != 0) {
+        return internal::ca_translate_errno(errno);
+    }
+    if (S_ISDIR(st.st_mode)) {
+        return internal::ca_translate_errno(EISDIR);
+    }
+
+    // Zero-copy path for large regular files
+    const bool regular = S_ISREG(st.st_mode);
+    const auto file_size = static_cast<ca_size_t>(st.st_size);
+    if (regular && file_size > 0 && file_size >= options.mmap_threshold) {
+        void *map = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (map != MAP_FAILED) {
+            // The hints are advisory; failures are ignored
+            if (options.sequential) {
+                madvise(map, file_size, MADV_SEQUENTIAL);
+            }
+            if (options.will_need) {
+                madvise(map, file_size, MADV_WILLNEED);
+            }
+            internal::ca_file_view_access::assign_mapped(view, static_cast<ca_char_t *>(map), file_size);
+            return ca_file_result::FILE_OK;
+        }
+        // Some file systems do not support mapping; read the file instead
+    }
+
+    // Small files, pipes and devices. Regular files reporting a size of 0,
+    // like most of /proc, are read until their end too.
+    ca_io_buffer_pool *pool = options.pool != nullptr ? options.pool : &ca_io_buffer_pool::global();
+    ca_char_t *data = nullptr;
+    ca_size_t len = 0;
+    ca_size_t capacity = 0;
+    const int err = regular && file_size > 0
+                        ? read_known_size(file.fd, file_size, pool, &data, &len, &capacity)
+                        : read_until_end(file.fd, pool, &data, &len, &capacity);
+    if (err != 0) {
+        return internal::ca_translate_errno(err);
+    }
+
+    internal::ca_file_view_access::assign_pooled(view, data, len, capacity, pool);
+    return ca_file_result::FILE_OK;
+}
+
+}
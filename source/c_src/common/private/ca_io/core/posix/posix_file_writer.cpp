@@ -0,0 +1,136 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/posix_file_writer.cpp
+//
+// @file
+// @brief Implements the primitives of `ca_file_writer` for Posix with
+//        `pwritev` and `rename`.
+// ================================
+
+#include "core/rw/ca_io_file_writer_backend.h"
+#include "core/posix/internal/posix_translater.h"
+
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace ca::ca_io::internal {
+
+namespace {
+
+#ifdef IOV_MAX
+constexpr ca_size_t MAX_IOVECS = IOV_MAX;
+#else
+constexpr ca_size_t MAX_IOVECS = 1024;
+#endif
+
+}
+
+ca_file_result
+ca_writer_create(const char *path, const bool temporary, ca_native_file *file, std::string *created) {
+    assert(path != nullptr);
+    assert(file != nullptr);
+    assert(created != nullptr);
+
+    if (!temporary) {
+        const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (fd < 0) {
+            return ca_translate_errno(errno);
+        }
+        *file = fd;
+        *created = path;
+        return ca_file_result::FILE_OK;
+    }
+
+    // Next to the target, so the final rename stays on one file system
+    std::string name = std::string(path) + ".XXXXXX";
+    const int fd = mkstemp(name.data());
+    if (fd < 0) {
+        return ca_translate_errno(errno);
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    // mkstemp creates the file private; take the mode of the replaced file
+    struct stat st{};
+    const mode_t mode = stat(path, &st) == 0 ? st.st_mode & 07777 : 0644;
+    fchmod(fd, mode);
+
+    *file = fd;
+    *created = std::move(name);
+    return ca_file_result::FILE_OK;
+}
+
+ca_file_result
+ca_writer_write(const ca_native_file file, std::span<const ca_write_segment> segments, ca_uint64_t offset) {
+    const int fd = static_cast<int>(file);
+    iovec vectors[MAX_IOVECS];
+    ca_size_t skip = 0;     // bytes of the first segment already written
+
+    while (!segments.empty()) {
+        const ca_size_t count = ca_math::ca_min(segments.size(), MAX_IOVECS);
+        for (ca_size_t i = 0; i < count; ++i) {
+            vectors[i].iov_base = const_cast<ca_string::ca_char_t *>(segments[i].data);
+            vectors[i].iov_len = segments[i].size;
+        }
+        vectors[0].iov_base = static_cast<char *>(vectors[0].iov_base) + skip;
+        vectors[0].iov_len -= skip;
+
+        const ssize_t n = pwritev(fd, vectors, static_cast<int>(count), static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return ca_translate_errno(errno);
+        }
+        if (n == 0) {
+            return ca_file_result::FILE_ERROR_IO_ERROR;
+        }
+        offset += static_cast<ca_uint64_t>(n);
+
+        // Drop the segments written completely, and remember partial ones
+        ca_size_t left = static_cast<ca_size_t>(n) + skip;
+        while (!segments.empty() && left >= segments.front().size) {
+            left -= segments.front().size;
+            segments = segments.subspan(1);
+        }
+        skip = left;
+    }
+    return ca_file_result::FILE_OK;
+}
+
+ca_file_result
+ca_writer_close(const ca_native_file file, const bool sync) {
+    const int fd = static_cast<int>(file);
+    ca_file_result result = ca_file_result::FILE_OK;
+    if (sync && fsync(fd) != 0) {
+        result = ca_translate_errno(errno);
+    }
+    if (close(fd) != 0 && result == ca_file_result::FILE_OK) {
+        result = ca_translate_errno(errno);
+    }
+    return result;
+}
+
+ca_file_result
+ca_writer_replace(const char *from, const char *to) {
+    assert(from != nullptr);
+    assert(to != nullptr);
+
+    if (rename(from, to) != 0) {
+        return ca_translate_errno(errno);
+    }
+    return ca_file_result::FILE_OK;
+}
+
+void
+ca_writer_remove(const char *path) {
+    assert(path != nullptr);
+
+    unlink(path);
+}
+
+}
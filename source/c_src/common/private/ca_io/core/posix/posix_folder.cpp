@@ -0,0 +1,169 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/posix_folder.cpp
+//
+// @file
+// @brief Implements directory listing for Posix, with `getdents64` on Linux
+//        and `readdir` elsewhere.
+// ================================
+
+#include "core/internal/ca_io_directory.h"
+#include "core/posix/internal/posix_translater.h"
+
+#include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace ca::ca_io::internal {
+
+namespace {
+
+/**
+ * @brief Determines the type of an entry, following symbolic links.
+ */
+ca_folder_entry_type
+entry_type(const int dir_fd, const char *name, const unsigned char d_type, bool *is_symlink) {
+    *is_symlink = d_type == DT_LNK;
+    if (d_type == DT_REG) {
+        return ca_folder_entry_type::FOLDER_ENTRY_FILE;
+    }
+    if (d_type == DT_DIR) {
+        return ca_folder_entry_type::FOLDER_ENTRY_DIRECTORY;
+    }
+    if (d_type != DT_LNK && d_type != DT_UNKNOWN) {
+        return ca_folder_entry_type::FOLDER_ENTRY_OTHER;
+    }
+
+    // Links, and file systems not reporting types
+    struct stat st{};
+    if (d_type == DT_UNKNOWN) {
+        if (fstatat(dir_fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            return ca_folder_entry_type::FOLDER_ENTRY_OTHER;
+        }
+        *is_symlink = S_ISLNK(st.st_mode);
+    }
+    if (*is_symlink && fstatat(dir_fd, name, &st, 0) != 0) {
+        return ca_folder_entry_type::FOLDER_ENTRY_OTHER;  // broken link
+    }
+    if (S_ISREG(st.st_mode)) {
+        return ca_folder_entry_type::FOLDER_ENTRY_FILE;
+    }
+    if (S_ISDIR(st.st_mode)) {
+        return ca_folder_entry_type::FOLDER_ENTRY_DIRECTORY;
+    }
+    return ca_folder_entry_type::FOLDER_ENTRY_OTHER;
+}
+
+bool
+is_dot_or_dot_dot(const char *name) {
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Layout of the records returned by `getdents64`.
+ */
+struct linux_dirent64 {
+    ino64_t d_ino;
+    off64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+/**
+ * @brief Size of the `getdents64` buffer, enough for hundreds of entries per call.
+ */
+constexpr ca_size_t DIRENT_BUFFER_SIZE = 32 * 1024;
+
+#endif
+
+}
+
+ca_file_result
+ca_list_directory(const char *path, const ca_directory_callback &callback) {
+    assert(path != nullptr);
+
+    int fd;
+    do {
+        fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    if (fd < 0) {
+        return ca_translate_errno(errno);
+    }
+
+#ifdef __linux__
+    alignas(linux_dirent64) char buffer[DIRENT_BUFFER_SIZE];
+    for (;;) {
+        const long n = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const int err = errno;
+            close(fd);
+            return ca_translate_errno(err);
+        }
+        if (n == 0) {
+            break;
+        }
+
+        for (long offset = 0; offset < n;) {
+            const auto *entry = reinterpret_cast<const linux_dirent64 *>(buffer + offset);
+            offset += entry->d_reclen;
+            if (is_dot_or_dot_dot(entry->d_name)) {
+                continue;
+            }
+            bool is_symlink;
+            const ca_folder_entry_type type = entry_type(fd, entry->d_name, entry->d_type, &is_symlink);
+            callback(entry->d_name, type, is_symlink);
+        }
+    }
+    close(fd);
+#else
+    DIR *dir = fdopendir(fd);
+    if (dir == nullptr) {
+        const int err = errno;
+        close(fd);
+        return ca_translate_errno(err);
+    }
+    errno = 0;
+    while (const dirent *entry = readdir(dir)) {
+        if (!is_dot_or_dot_dot(entry->d_name)) {
+            bool is_symlink;
+            const ca_folder_entry_type type = entry_type(fd, entry->d_name, entry->d_type, &is_symlink);
+            callback(entry->d_name, type, is_symlink);
+        }
+        errno = 0;
+    }
+    const int err = errno;
+    closedir(dir);
+    if (err != 0) {
+        return ca_translate_errno(err);
+    }
+#endif
+
+    return ca_file_result::FILE_OK;
+}
+
+int
+ca_canonical_path(const char *path, std::string *canonical) {
+    assert(path != nullptr);
+    assert(canonical != nullptr);
+
+    char resolved[PATH_MAX];
+    if (realpath(path, resolved) == nullptr) {
+        return -1;
+    }
+    canonical->assign(resolved);
+    return 0;
+}
+
+}
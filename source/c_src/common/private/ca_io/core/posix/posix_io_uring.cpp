@@ -0,0 +1,150 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/posix_io_uring.cpp
+//
+// @file
+// @brief Implements the io_uring wrapper.
+// ================================
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+
+#include "core/posix/internal/posix_io_uring.h"
+
+#include <cerrno>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <utility>
+
+namespace ca::ca_io::internal {
+
+namespace {
+
+template <typename T>
+T *
+ring_field(void *ring, const unsigned offset) {
+    return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+}
+
+}
+
+posix_io_uring::posix_io_uring(posix_io_uring &&other) noexcept
+    : ring_fd(std::exchange(other.ring_fd, -1)), sq_entries(other.sq_entries), sqe_tail(other.sqe_tail),
+      sq_ring(std::exchange(other.sq_ring, nullptr)), sq_ring_size(other.sq_ring_size),
+      cq_ring(std::exchange(other.cq_ring, nullptr)), cq_ring_size(other.cq_ring_size),
+      sqes(std::exchange(other.sqes, nullptr)), sqes_size(other.sqes_size),
+      sq_head(other.sq_head), sq_tail(other.sq_tail), sq_mask(other.sq_mask), sq_array(other.sq_array),
+      cq_head(other.cq_head), cq_tail(other.cq_tail), cq_mask(other.cq_mask), cqes(other.cqes) {
+}
+
+posix_io_uring::~posix_io_uring() {
+    if (sqes != nullptr) {
+        munmap(sqes, sqes_size);
+    }
+    if (cq_ring != nullptr && cq_ring != sq_ring) {
+        munmap(cq_ring, cq_ring_size);
+    }
+    if (sq_ring != nullptr) {
+        munmap(sq_ring, sq_ring_size);
+    }
+    if (ring_fd >= 0) {
+        close(ring_fd);
+    }
+}
+
+int
+posix_io_uring::init(const unsigned entries) {
+    io_uring_params params{};
+    const long fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) {
+        return -1;  // ENOSYS on old kernels, EPERM when disabled by policy
+    }
+    ring_fd = static_cast<int>(fd);
+    sq_entries = params.sq_entries;
+
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        sq_ring_size = cq_ring_size = ca_math::ca_max(sq_ring_size, cq_ring_size);
+    }
+
+    void *sq = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ring_fd, IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED) {
+        return -1;
+    }
+    sq_ring = sq;
+
+    if (single_mmap) {
+        cq_ring = sq_ring;
+    }
+    else {
+        void *cq = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ring_fd, IORING_OFF_CQ_RING);
+        if (cq == MAP_FAILED) {
+            return -1;
+        }
+        cq_ring = cq;
+    }
+
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void *entries_map = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ring_fd, IORING_OFF_SQES);
+    if (entries_map == MAP_FAILED) {
+        return -1;
+    }
+    sqes = static_cast<io_uring_sqe *>(entries_map);
+
+    sq_head = ring_field<unsigned>(sq_ring, params.sq_off.head);
+    sq_tail = ring_field<unsigned>(sq_ring, params.sq_off.tail);
+    sq_mask = ring_field<unsigned>(sq_ring, params.sq_off.ring_mask);
+    sq_array = ring_field<unsigned>(sq_ring, params.sq_off.array);
+    cq_head = ring_field<unsigned>(cq_ring, params.cq_off.head);
+    cq_tail = ring_field<unsigned>(cq_ring, params.cq_off.tail);
+    cq_mask = ring_field<unsigned>(cq_ring, params.cq_off.ring_mask);
+    cqes = ring_field<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+    sqe_tail = *sq_tail;
+    return 0;
+}
+
+bool
+posix_io_uring::supports(const std::initializer_list<ca_uint8_t> opcodes) const {
+    constexpr unsigned MAX_OPS = 256;
+    const ca_size_t size = sizeof(io_uring_probe) + MAX_OPS * sizeof(io_uring_probe_op);
+    const auto storage = std::make_unique<ca_uint64_t[]>((size + sizeof(ca_uint64_t) - 1) / sizeof(ca_uint64_t));
+    auto *probe = reinterpret_cast<io_uring_probe *>(storage.get());
+
+    // Probing needs Linux 5.6, like the file operations themselves
+    if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, MAX_OPS) < 0) {
+        return false;
+    }
+    for (const ca_uint8_t opcode : opcodes) {
+        if (opcode > probe->last_op || (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+posix_io_uring::submit_and_wait(const unsigned wait_nr) {
+    std::atomic_ref(*sq_tail).store(sqe_tail, std::memory_order_release);
+
+    for (;;) {
+        // Entries the kernel has not consumed yet, also after an interrupted call
+        const unsigned to_submit = sqe_tail - std::atomic_ref(*sq_head).load(std::memory_order_acquire);
+        const long ret = syscall(__NR_io_uring_enter, ring_fd, to_submit, wait_nr,
+                                 wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+        if (ret >= 0) {
+            return 0;
+        }
+        if (errno != EINTR) {
+            return -errno;
+        }
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/posix_path.cpp
+//
+// @file
+// @brief Implements the file system queries of `ca_io_path` for Posix.
+// ================================
+
+#include "core/ca_io_path.h"
+
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <memory>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ca::ca_io {
+
+bool
+ca_io_path::exists() const {
+    struct stat st{};
+    return stat(c_str(), &st) == 0;
+}
+
+int
+ca_io_path::current_directory(ca_io_path *path) {
+    assert(path != nullptr);
+
+    char buffer[PATH_MAX];
+    if (getcwd(buffer, sizeof(buffer)) != nullptr) {
+        path->assign(buffer);
+        return 0;
+    }
+
+    // Deeper than PATH_MAX
+    for (ca_size_t size = 2 * sizeof(buffer); errno == ERANGE; size *= 2) {
+        const std::unique_ptr<char[]> block(new char[size]);
+        if (getcwd(block.get(), size) != nullptr) {
+            path->assign(block.get());
+            return 0;
+        }
+    }
+    return -1;
+}
+
+}
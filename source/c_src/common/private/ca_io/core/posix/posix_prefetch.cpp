@@ -0,0 +1,52 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/posix_prefetch.cpp
+//
+// @file
+// @brief Implements prefetch hints for Posix with `readahead` on Linux and
+//        `posix_fadvise` elsewhere.
+// ================================
+
+#include "core/internal/ca_io_prefetch_hint.h"
+
+#include <cassert>
+#include <climits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ca::ca_io::internal {
+
+int
+ca_prefetch_hint(const char *path, ca_size_t *size) {
+    assert(path != nullptr);
+    assert(size != nullptr);
+
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return -1;
+    }
+    *size = static_cast<ca_size_t>(st.st_size);
+
+    // Only queues the reads; the pages arrive in the background
+#if defined(__linux__)
+    readahead(fd, 0, *size);
+#elif defined(POSIX_FADV_WILLNEED)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#elif defined(F_RDADVISE)
+    radvisory advice{};
+    advice.ra_offset = 0;
+    advice.ra_count = static_cast<int>(ca_math::ca_min<ca_size_t>(*size, INT_MAX));
+    fcntl(fd, F_RDADVISE, &advice);
+#endif
+
+    close(fd);
+    return 0;
+}
+
+}
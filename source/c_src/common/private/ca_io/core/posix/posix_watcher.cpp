@@ -0,0 +1,278 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/posix/posix_watcher.cpp
+//
+// @file
+// @brief Implements the inotify backend of `ca_file_watcher` on Linux.
+// ================================
+
+#include "core/internal/ca_io_watch_backend.h"
+
+#ifdef __linux__
+
+#include "core/internal/ca_io_directory.h"
+#include "core/posix/internal/posix_translater.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <unordered_map>
+
+#endif
+
+namespace ca::ca_io::internal {
+
+#ifdef __linux__
+
+namespace {
+
+/**
+ * @brief Events watched on every directory.
+ */
+constexpr ca_uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                   IN_DELETE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+
+/**
+ * @brief Size of the event buffer, enough for hundreds of events per read.
+ */
+constexpr ca_size_t EVENT_BUFFER_SIZE = 64 * 1024;
+
+/**
+ * @struct inotify_backend
+ * @brief Watches every directory of the tree with one inotify instance.
+ */
+struct inotify_backend final : ca_watch_backend {
+    inotify_backend(const std::string &root, const ca_watch_options &options, const int inotify_fd,
+                    const int event_fd)
+        : root(root), options(options), inotify_fd(inotify_fd), event_fd(event_fd) {
+    }
+
+    ~inotify_backend() override {
+        close(inotify_fd);
+        close(event_fd);
+    }
+
+    /**
+     * @brief Registers a directory and its subdirectories.
+     *
+     * The watch is added before the directory is listed, so entries created
+     * meanwhile raise events.
+     *
+     * @param relative Path of the directory relative to the root.
+     * @param changed Receives the files found, or `nullptr` not to report them.
+     * @return The result of registering the directory itself.
+     */
+    ca_file_result
+    add_tree(const std::string &relative, std::vector<std::string> *changed) {
+        const std::string path = join(root, relative);
+        const int wd = inotify_add_watch(inotify_fd, path.c_str(), WATCH_MASK);
+        if (wd < 0) {
+            return ca_translate_errno(errno);
+        }
+        directories[wd] = relative;
+
+        std::vector<std::string> subdirectories;
+        ca_list_directory(path.c_str(),
+            [&](const std::string_view name, const ca_folder_entry_type type, const bool is_symlink) {
+                if (!options.include_hidden && name[0] == '.') {
+                    return;
+                }
+                if (type == ca_folder_entry_type::FOLDER_ENTRY_DIRECTORY && !is_symlink) {
+                    subdirectories.push_back(join(relative, name));
+                }
+                else if (type == ca_folder_entry_type::FOLDER_ENTRY_FILE && changed != nullptr &&
+                         has_extension(name)) {
+                    changed->push_back(join(relative, name));
+                }
+            });
+        for (const std::string &subdirectory : subdirectories) {
+            // Directories that vanished meanwhile are simply skipped
+            add_tree(subdirectory, changed);
+        }
+        return ca_file_result::FILE_OK;
+    }
+
+    /**
+     * @brief Unregisters a directory and its subdirectories.
+     *
+     * @param relative Path of the directory relative to the root.
+     */
+    void
+    remove_tree(const std::string &relative) {
+        for (auto it = directories.begin(); it != directories.end();) {
+            const std::string &path = it->second;
+            if (path.starts_with(relative) &&
+                (path.size() == relative.size() || path[relative.size()] == '/')) {
+                // The IN_IGNORED event this raises finds no directory
+                inotify_rm_watch(inotify_fd, it->first);
+                it = directories.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    void
+    wait(const int timeout_ms, std::vector<std::string> *changed, bool *rescan) override {
+        pollfd fds[2] = { { inotify_fd, POLLIN, 0 }, { event_fd, POLLIN, 0 } };
+        if (poll(fds, 2, timeout_ms) <= 0) {
+            return;
+        }
+        if ((fds[1].revents & POLLIN) != 0) {
+            ca_uint64_t count;
+            [[maybe_unused]] const ssize_t n = read(event_fd, &count, sizeof(count));
+        }
+        if ((fds[0].revents & POLLIN) != 0) {
+            drain(changed, rescan);
+        }
+    }
+
+    void
+    wake() override {
+        const ca_uint64_t one = 1;
+        [[maybe_unused]] const ssize_t n = write(event_fd, &one, sizeof(one));
+    }
+
+private:
+    /**
+     * @brief Reads and handles all queued events.
+     */
+    void
+    drain(std::vector<std::string> *changed, bool *rescan) {
+        alignas(inotify_event) char buffer[EVENT_BUFFER_SIZE];
+        bool overflowed = false;
+        for (;;) {
+            const ssize_t n = read(inotify_fd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                break;
+            }
+            for (ssize_t offset = 0; offset < n;) {
+                const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                overflowed |= handle(*event, changed, rescan);
+            }
+        }
+        if (overflowed) {
+            // Register the directories created while events were dropped
+            *rescan = true;
+            add_tree(std::string(), nullptr);
+        }
+    }
+
+    /**
+     * @brief Handles one event.
+     *
+     * @return `true` if the event queue overflowed.
+     */
+    bool
+    handle(const inotify_event &event, std::vector<std::string> *changed, bool *rescan) {
+        if ((event.mask & IN_Q_OVERFLOW) != 0) {
+            return true;
+        }
+        const auto found = directories.find(event.wd);
+        if (found == directories.end()) {
+            return false;
+        }
+        if ((event.mask & IN_IGNORED) != 0) {
+            directories.erase(found);
+            return false;
+        }
+        if (event.len == 0) {
+            return false;
+        }
+
+        const std::string_view name(event.name);
+        if (!options.include_hidden && name[0] == '.') {
+            return false;
+        }
+        const std::string relative = join(found->second, name);
+
+        if ((event.mask & IN_ISDIR) != 0) {
+            if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+                add_tree(relative, changed);
+            }
+            else if ((event.mask & IN_MOVED_FROM) != 0) {
+                // The watches below would keep reporting under the old path,
+                // and the files below moved away without events of their own
+                remove_tree(relative);
+                *rescan = true;
+            }
+            return false;
+        }
+        if (has_extension(name)) {
+            changed->push_back(relative);
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool
+    has_extension(const std::string_view name) const {
+        if (options.extensions.empty()) {
+            return true;
+        }
+        const ca_size_t dot = name.rfind('.');
+        if (dot == std::string_view::npos) {
+            return false;
+        }
+        const std::string_view extension = name.substr(dot);
+        for (const std::string &wanted : options.extensions) {
+            if (extension == wanted) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static std::string
+    join(const std::string_view base, const std::string_view name) {
+        std::string path(base);
+        if (!path.empty() && path.back() != '/') {
+            path += '/';
+        }
+        path += name;
+        return path;
+    }
+
+    std::string root;                                       ///< Root without trailing separators.
+    const ca_watch_options &options;                        ///< Watch options, owned by the watcher.
+    int inotify_fd;                                         ///< The inotify instance.
+    int event_fd;                                           ///< Wakes `wait`.
+    std::unordered_map<int, std::string> directories;       ///< Relative paths of the watched directories.
+};
+
+}
+
+std::unique_ptr<ca_watch_backend>
+make_watch_backend(const std::string &root, const ca_watch_options &options, ca_file_result *result) {
+    const int inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd < 0) {
+        *result = ca_translate_errno(errno);
+        return nullptr;
+    }
+    const int event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd < 0) {
+        *result = ca_translate_errno(errno);
+        close(inotify_fd);
+        return nullptr;
+    }
+
+    auto backend = std::make_unique<inotify_backend>(root, options, inotify_fd, event_fd);
+    *result = backend->add_tree(std::string(), nullptr);
+    if (*result != ca_file_result::FILE_OK) {
+        return nullptr;
+    }
+    return backend;
+}
+
+#else
+
+std::unique_ptr<ca_watch_backend>
+make_watch_backend(const std::string &, const ca_watch_options &, ca_file_result *result) {
+    *result = ca_file_result::FILE_ERROR_NOT_SUPPORTED;
+    return nullptr;
+}
+
+#endif
+
+}
@@ -0,0 +1,177 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/rw/ca_io_file_rw_asyn.cpp
+//
+// @file
+// @brief Implements `ca_async_file_reader` and its thread pool backend.
+// ================================
+
+#include "core/rw/ca_io_file_rw_asyn.h"
+#include "core/rw/ca_io_file_rw_asyn_backend.h"
+
+#include <cassert>
+#include <deque>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ca::ca_io {
+
+namespace internal {
+
+namespace {
+
+/**
+ * @struct thread_pool_backend
+ * @brief Reads files with `ca_file_read` on a fixed set of threads.
+ */
+struct thread_pool_backend final : ca_async_backend {
+    explicit thread_pool_backend(const ca_async_reader_options &options)
+        : read_options(options.read), stopping(false) {
+        ca_size_t num_threads = options.num_threads;
+        if (num_threads == 0) {
+            num_threads = ca_math::ca_max<ca_size_t>(std::thread::hardware_concurrency(), 1);
+        }
+        threads.reserve(num_threads);
+        for (ca_size_t i = 0; i < num_threads; ++i) {
+            threads.emplace_back([this] { run(); });
+        }
+    }
+
+    ~thread_pool_backend() override {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    }
+
+    void
+    submit(std::vector<ca_async_request> requests) override {
+        {
+            std::lock_guard lock(mutex);
+            for (ca_async_request &request : requests) {
+                queue.push_back(std::move(request));
+            }
+        }
+        wakeup.notify_all();
+    }
+
+    [[nodiscard]] bool
+    is_io_uring() const override {
+        return false;
+    }
+
+private:
+    void
+    run() {
+        for (;;) {
+            ca_async_request request;
+            {
+                std::unique_lock lock(mutex);
+                wakeup.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                request = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            ca_file_view view;
+            const ca_file_result result = ca_file_read(request.path.c_str(), &view, read_options);
+            (*request.callback)(request.index, result, std::move(view));
+        }
+    }
+
+    ca_file_read_options read_options;          ///< Options of every read.
+    std::vector<std::thread> threads;           ///< Worker threads.
+    std::mutex mutex;                           ///< Guards `queue` and `stopping`.
+    std::condition_variable wakeup;             ///< Signaled on new requests and on stop.
+    std::deque<ca_async_request> queue;         ///< Requests not started yet.
+    bool stopping;                              ///< Whether the workers should exit once idle.
+};
+
+}
+
+std::unique_ptr<ca_async_backend>
+make_thread_pool_backend(const ca_async_reader_options &options) {
+    return std::make_unique<thread_pool_backend>(options);
+}
+
+}
+
+ca_async_file_reader::ca_async_file_reader(const ca_async_reader_options &options)
+    : pending(0) {
+    if (options.use_io_uring) {
+        backend = internal::make_io_uring_backend(options);
+    }
+    if (!backend) {
+        backend = internal::make_thread_pool_backend(options);
+    }
+}
+
+ca_async_file_reader::~ca_async_file_reader() {
+    wait();
+    backend.reset();
+}
+
+void
+ca_async_file_reader::read_batch(const std::span<const std::string> paths, const ca_async_read_callback &callback) {
+    if (paths.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        pending += paths.size();
+    }
+
+    const auto shared = std::make_shared<const ca_async_read_callback>(
+        [this, callback](const ca_size_t index, const ca_file_result result, ca_file_view &&view) {
+            callback(index, result, std::move(view));
+            complete_one();
+        });
+
+    std::vector<internal::ca_async_request> requests;
+    requests.reserve(paths.size());
+    for (ca_size_t i = 0; i < paths.size(); ++i) {
+        requests.push_back({ paths[i], i, shared });
+    }
+    backend->submit(std::move(requests));
+}
+
+std::future<ca_async_read_result>
+ca_async_file_reader::read(const char *path) {
+    assert(path != nullptr);
+
+    auto promise = std::make_shared<std::promise<ca_async_read_result>>();
+    std::future<ca_async_read_result> future = promise->get_future();
+    const std::string paths[] = { path };
+    read_batch(paths, [promise](ca_size_t, const ca_file_result result, ca_file_view &&view) {
+        promise->set_value({ result, std::move(view) });
+    });
+    return future;
+}
+
+void
+ca_async_file_reader::wait() {
+    std::unique_lock lock(mutex);
+    idle.wait(lock, [this] { return pending == 0; });
+}
+
+bool
+ca_async_file_reader::uses_io_uring() const {
+    return backend->is_io_uring();
+}
+
+void
+ca_async_file_reader::complete_one() {
+    std::lock_guard lock(mutex);
+    if (--pending == 0) {
+        idle.notify_all();
+    }
+}
+
+}
@@ -0,0 +1,71 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/rw/ca_io_file_rw_asyn_backend.h
+//
+// @file
+// @brief Defines the interface between `ca_async_file_reader` and the
+//        backends running its reads.
+// ================================
+
+#ifndef CA_IO_FILE_RW_ASYN_BACKEND_H
+#define CA_IO_FILE_RW_ASYN_BACKEND_H
+
+#include "core/rw/ca_io_file_rw_asyn.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ca::ca_io::internal {
+
+/**
+ * @struct ca_async_request
+ * @brief One file to read.
+ */
+struct ca_async_request {
+    std::string path;                                       ///< Path of the file.
+    ca_size_t index;                                        ///< Index of the path in its batch.
+    std::shared_ptr<const ca_async_read_callback> callback; ///< Callback of the batch.
+};
+
+/**
+ * @struct ca_async_backend
+ * @brief Runs reads in the background and calls their callbacks.
+ *
+ * Backends call the callback of every request exactly once. Destroying a
+ * backend waits for its threads; callers make sure no read is pending then.
+ */
+struct ca_async_backend {
+    virtual ~ca_async_backend() = default;
+
+    /**
+     * @brief Queues requests. Thread-safe.
+     */
+    virtual void
+    submit(std::vector<ca_async_request> requests) = 0;
+
+    /**
+     * @brief Checks if the backend uses io_uring.
+     */
+    [[nodiscard]] virtual bool
+    is_io_uring() const = 0;
+};
+
+/**
+ * @brief Creates the backend reading files with `ca_file_read` on a pool of
+ *        threads. Available on every platform.
+ */
+std::unique_ptr<ca_async_backend>
+make_thread_pool_backend(const ca_async_reader_options &options);
+
+/**
+ * @brief Creates the io_uring backend.
+ *
+ * @return The backend, or `nullptr` if the platform or the kernel does not
+ *         support the operations it needs.
+ */
+std::unique_ptr<ca_async_backend>
+make_io_uring_backend(const ca_async_reader_options &options);
+
+}
+
+#endif //CA_IO_FILE_RW_ASYN_BACKEND_H
@@ -0,0 +1,146 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/rw/ca_io_file_rw_sync.cpp
+//
+// @file
+// @brief Implements the platform independent parts of synchronous file
+//        reading: `ca_io_buffer_pool` and the accessors of `ca_file_view`.
+//        Loading and releasing the contents are implemented per platform.
+// ================================
+
+#include "core/rw/ca_io_file_rw_sync.h"
+
+#include <bit>
+#include <cassert>
+#include <utility>
+
+namespace ca::ca_io {
+
+using ca_string::ca_char_t;
+
+// ----------------------------
+// ca_io_buffer_pool
+// ----------------------------
+
+ca_io_buffer_pool::ca_io_buffer_pool(const ca_size_t max_cached_bytes)
+    : cached(0), max_cached(max_cached_bytes) {
+}
+
+ca_size_t
+ca_io_buffer_pool::class_of(const ca_size_t capacity) {
+    return static_cast<ca_size_t>(std::countr_zero(capacity) - std::countr_zero(MIN_BLOCK_SIZE));
+}
+
+ca_char_t *
+ca_io_buffer_pool::acquire(const ca_size_t size, ca_size_t *capacity) {
+    assert(capacity != nullptr);
+
+    const ca_size_t block_size = std::bit_ceil(ca_math::ca_max<ca_size_t>(size, MIN_BLOCK_SIZE));
+    const ca_size_t index = class_of(block_size);
+    *capacity = block_size;
+
+    {
+        std::lock_guard lock(mutex);
+        if (index < free_lists.size() && !free_lists[index].empty()) {
+            ca_char_t *block = free_lists[index].back().release();
+            free_lists[index].pop_back();
+            cached -= block_size;
+            return block;
+        }
+    }
+
+    return new ca_char_t[block_size];
+}
+
+void
+ca_io_buffer_pool::release(ca_char_t *block, const ca_size_t capacity) {
+    if (block == nullptr) {
+        return;
+    }
+    assert(std::has_single_bit(capacity) && capacity >= MIN_BLOCK_SIZE);
+
+    std::unique_ptr<ca_char_t[]> owner(block);
+    const ca_size_t index = class_of(capacity);
+
+    std::lock_guard lock(mutex);
+    if (cached + capacity > max_cached) {
+        return;
+    }
+    if (index >= free_lists.size()) {
+        free_lists.resize(index + 1);
+    }
+    free_lists[index].push_back(std::move(owner));
+    cached += capacity;
+}
+
+ca_size_t
+ca_io_buffer_pool::cached_bytes() const {
+    std::lock_guard lock(mutex);
+    return cached;
+}
+
+ca_io_buffer_pool &
+ca_io_buffer_pool::global() {
+    static ca_io_buffer_pool pool;
+    return pool;
+}
+
+// ----------------------------
+// ca_file_view
+// ----------------------------
+
+ca_file_view::ca_file_view()
+    : ptr(nullptr), len(0), capacity(0), pool(nullptr), mapped(false) {
+}
+
+ca_file_view::~ca_file_view() {
+    reset();
+}
+
+ca_file_view::ca_file_view(ca_file_view &&other) noexcept
+    : ptr(std::exchange(other.ptr, nullptr)), len(std::exchange(other.len, 0)),
+      capacity(std::exchange(other.capacity, 0)), pool(std::exchange(other.pool, nullptr)),
+      mapped(std::exchange(other.mapped, false)) {
+}
+
+ca_file_view &
+ca_file_view::operator=(ca_file_view &&other) noexcept {
+    if (this != &other) {
+        reset();
+        ptr = std::exchange(other.ptr, nullptr);
+        len = std::exchange(other.len, 0);
+        capacity = std::exchange(other.capacity, 0);
+        pool = std::exchange(other.pool, nullptr);
+        mapped = std::exchange(other.mapped, false);
+    }
+    return *this;
+}
+
+ca_string::ca_buffer<ca_string::ca_encoding_t::CA_ENCODING_UTF8>
+ca_file_view::buffer() const {
+    if (len == 0) {
+        return {};
+    }
+    return { ptr, len };
+}
+
+const ca_char_t *
+ca_file_view::data() const {
+    return ptr;
+}
+
+ca_size_t
+ca_file_view::size() const {
+    return len;
+}
+
+bool
+ca_file_view::empty() const {
+    return len == 0;
+}
+
+bool
+ca_file_view::is_mapped() const {
+    return mapped;
+}
+
+}
@@ -0,0 +1,53 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/rw/ca_io_file_view_access.h
+//
+// @file
+// @brief Lets the file readers hand loaded contents over to a `ca_file_view`.
+// ================================
+
+#ifndef CA_IO_FILE_VIEW_ACCESS_H
+#define CA_IO_FILE_VIEW_ACCESS_H
+
+#include "core/rw/ca_io_file_rw_sync.h"
+
+namespace ca::ca_io::internal {
+
+/**
+ * @struct ca_file_view_access
+ * @brief Fills `ca_file_view`s for the sync and async readers.
+ */
+struct ca_file_view_access {
+    /**
+     * @brief Makes an empty view own a memory mapping of `len` bytes.
+     */
+    static void
+    assign_mapped(ca_file_view *view, ca_string::ca_char_t *ptr, const ca_size_t len) {
+        view->ptr = ptr;
+        view->len = len;
+        view->capacity = len;
+        view->mapped = true;
+    }
+
+    /**
+     * @brief Makes an empty view own a pooled buffer holding `len` bytes.
+     *
+     * Empty contents release the buffer right away, so empty views never
+     * hold memory.
+     */
+    static void
+    assign_pooled(ca_file_view *view, ca_string::ca_char_t *ptr, const ca_size_t len,
+                  const ca_size_t capacity, ca_io_buffer_pool *pool) {
+        if (len == 0) {
+            pool->release(ptr, capacity);
+            return;
+        }
+        view->ptr = ptr;
+        view->len = len;
+        view->capacity = capacity;
+        view->pool = pool;
+    }
+};
+
+}
+
+#endif //CA_IO_FILE_VIEW_ACCESS_H
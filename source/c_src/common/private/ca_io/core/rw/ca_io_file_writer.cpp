@@ -0,0 +1,357 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/rw/ca_io_file_writer.cpp
+//
+// @file
+// @brief Implements the batching and background flushing of `ca_file_writer`.
+// ================================
+
+#include "core/rw/ca_io_file_writer.h"
+#include "core/rw/ca_io_file_writer_backend.h"
+
+#include <cassert>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ca::ca_io::internal {
+
+namespace {
+
+/**
+ * @brief Size of the chunks copied fragments are gathered in.
+ */
+constexpr ca_size_t CHUNK_SIZE = 256 * 1024;
+
+/**
+ * @brief Batches waiting for the background thread before `submit` blocks.
+ */
+constexpr ca_size_t MAX_QUEUED_BATCHES = 2;
+
+/**
+ * @struct write_batch
+ * @brief Segments written together, with the chunks holding their copies.
+ */
+struct write_batch {
+    std::vector<ca_write_segment> segments;                             ///< Segments in file order.
+    std::vector<std::unique_ptr<ca_string::ca_char_t[]>> chunks;        ///< Chunks referenced by the segments.
+    ca_uint64_t offset = 0;                                             ///< File offset of the first segment.
+    ca_size_t bytes = 0;                                                ///< Total size of the segments.
+};
+
+}
+
+/**
+ * @struct ca_writer_state
+ * @brief State of an open `ca_file_writer`.
+ */
+struct ca_writer_state {
+    /**
+     * @brief Takes a chunk from the free list, or allocates one.
+     */
+    std::unique_ptr<ca_string::ca_char_t[]>
+    take_chunk() {
+        std::lock_guard lock(mutex);
+        if (free_chunks.empty()) {
+            return std::make_unique_for_overwrite<ca_string::ca_char_t[]>(CHUNK_SIZE);
+        }
+        auto chunk = std::move(free_chunks.back());
+        free_chunks.pop_back();
+        return chunk;
+    }
+
+    /**
+     * @brief Writes a batch and recycles its chunks.
+     */
+    void
+    write(write_batch &written) {
+        ca_file_result result;
+        {
+            std::lock_guard lock(mutex);
+            result = error;
+        }
+        if (result == ca_file_result::FILE_OK) {
+            result = ca_writer_write(file, written.segments, written.offset);
+        }
+
+        std::lock_guard lock(mutex);
+        if (error == ca_file_result::FILE_OK) {
+            error = result;
+        }
+        for (auto &chunk : written.chunks) {
+            free_chunks.push_back(std::move(chunk));
+        }
+    }
+
+    /**
+     * @brief Writes the queued batches until asked to stop.
+     */
+    void
+    run() {
+        std::unique_lock lock(mutex);
+        for (;;) {
+            changed.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+            write_batch next = std::move(queue.front());
+            queue.pop_front();
+            busy = true;
+            changed.notify_all();
+
+            lock.unlock();
+            write(next);
+            lock.lock();
+
+            busy = false;
+            changed.notify_all();
+        }
+    }
+
+    /**
+     * @brief Hands the current batch over to be written.
+     */
+    void
+    submit() {
+        if (current.segments.empty()) {
+            return;
+        }
+        write_batch next = std::move(current);
+        current = write_batch();
+        current.offset = next.offset + next.bytes;
+        cursor = nullptr;
+        cursor_end = nullptr;
+
+        if (!worker.joinable()) {
+            write(next);
+            return;
+        }
+        std::unique_lock lock(mutex);
+        changed.wait(lock, [this] { return queue.size() < MAX_QUEUED_BATCHES; });
+        queue.push_back(std::move(next));
+        changed.notify_all();
+    }
+
+    /**
+     * @brief Submits the current batch and waits until everything is written.
+     *
+     * @return The first error met.
+     */
+    ca_file_result
+    drain() {
+        submit();
+        std::unique_lock lock(mutex);
+        changed.wait(lock, [this] { return queue.empty() && !busy; });
+        return error;
+    }
+
+    /**
+     * @brief Stops the background thread after it wrote everything queued.
+     */
+    void
+    stop() {
+        if (!worker.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        worker.join();
+    }
+
+    /**
+     * @brief Appends a segment to the current batch.
+     */
+    void
+    push(const ca_string::ca_char_t *data, const ca_size_t size) {
+        ca_write_segment &last = current.segments.empty() ? current.segments.emplace_back(data, 0)
+                                                          : current.segments.back();
+        if (last.data + last.size == data) {
+            last.size += size;
+        }
+        else {
+            current.segments.emplace_back(data, size);
+        }
+        current.bytes += size;
+        appended += size;
+    }
+
+    /**
+     * @brief Checks if the current batch is full.
+     */
+    [[nodiscard]] bool
+    full() const {
+        return current.bytes >= options.buffer_size;
+    }
+
+    ca_native_file file = INVALID_NATIVE_FILE;      ///< The file written.
+    std::string target;                             ///< Path of the target.
+    std::string created;                            ///< Path of the file written.
+    ca_file_writer_options options;                 ///< Writer options.
+    ca_uint64_t appended = 0;                       ///< Bytes appended since opening.
+
+    write_batch current;                            ///< Batch being gathered.
+    ca_string::ca_char_t *cursor = nullptr;         ///< Free space of the last chunk of `current`.
+    ca_string::ca_char_t *cursor_end = nullptr;     ///< End of the last chunk of `current`.
+
+    std::mutex mutex;                               ///< Guards the members below.
+    std::condition_variable changed;                ///< Signals changes of the queue.
+    std::deque<write_batch> queue;                  ///< Batches waiting for the background thread.
+    std::vector<std::unique_ptr<ca_string::ca_char_t[]>> free_chunks; ///< Chunks of written batches.
+    ca_file_result error = ca_file_result::FILE_OK; ///< First error met.
+    bool busy = false;                              ///< Whether the background thread is writing.
+    bool stopping = false;                          ///< Whether the background thread should exit.
+    std::thread worker;                             ///< The background thread, if flushing asynchronously.
+};
+
+}
+
+namespace ca::ca_io {
+
+ca_file_writer::ca_file_writer() = default;
+
+ca_file_writer::~ca_file_writer() {
+    if (state == nullptr) {
+        return;
+    }
+    if (state->options.atomic_replace) {
+        discard();
+    }
+    else {
+        commit();
+    }
+}
+
+ca_file_result
+ca_file_writer::open(const char *path, const ca_file_writer_options &options) {
+    assert(path != nullptr);
+
+    if (state != nullptr) {
+        return ca_file_result::FILE_ERROR_BUSY;
+    }
+
+    auto opened = std::make_unique<internal::ca_writer_state>();
+    const ca_file_result result = internal::ca_writer_create(path, options.atomic_replace, &opened->file,
+                                                             &opened->created);
+    if (result != ca_file_result::FILE_OK) {
+        return result;
+    }
+    opened->target = path;
+    opened->options = options;
+    if (options.async_flush) {
+        opened->worker = std::thread([raw = opened.get()] { raw->run(); });
+    }
+    state = std::move(opened);
+    return ca_file_result::FILE_OK;
+}
+
+ca_file_result
+ca_file_writer::write(const void *data, ca_size_t size) {
+    assert(state != nullptr);
+    assert(data != nullptr || size == 0);
+
+    const auto *bytes = static_cast<const ca_string::ca_char_t *>(data);
+    while (size > 0) {
+        if (state->cursor == state->cursor_end) {
+            auto chunk = state->take_chunk();
+            state->cursor = chunk.get();
+            state->cursor_end = chunk.get() + internal::CHUNK_SIZE;
+            state->current.chunks.push_back(std::move(chunk));
+        }
+        const ca_size_t count = ca_math::ca_min(size, static_cast<ca_size_t>(state->cursor_end - state->cursor));
+        std::memcpy(state->cursor, bytes, count);
+        state->push(state->cursor, count);
+        state->cursor += count;
+        bytes += count;
+        size -= count;
+        if (state->full()) {
+            state->submit();
+        }
+    }
+
+    std::lock_guard lock(state->mutex);
+    return state->error;
+}
+
+ca_file_result
+ca_file_writer::write(const std::string_view text) {
+    return write(text.data(), text.size());
+}
+
+ca_file_result
+ca_file_writer::write_borrowed(const void *data, const ca_size_t size) {
+    assert(state != nullptr);
+    assert(data != nullptr || size == 0);
+
+    if (size > 0) {
+        state->push(static_cast<const ca_string::ca_char_t *>(data), size);
+        if (state->full()) {
+            state->submit();
+        }
+    }
+
+    std::lock_guard lock(state->mutex);
+    return state->error;
+}
+
+ca_file_result
+ca_file_writer::flush() {
+    assert(state != nullptr);
+
+    return state->drain();
+}
+
+ca_file_result
+ca_file_writer::commit() {
+    assert(state != nullptr);
+
+    ca_file_result result = state->drain();
+    state->stop();
+    const ca_file_result closed = internal::ca_writer_close(state->file, state->options.sync_on_commit);
+    if (result == ca_file_result::FILE_OK) {
+        result = closed;
+    }
+    if (state->options.atomic_replace) {
+        if (result == ca_file_result::FILE_OK) {
+            result = internal::ca_writer_replace(state->created.c_str(), state->target.c_str());
+        }
+        if (result != ca_file_result::FILE_OK) {
+            internal::ca_writer_remove(state->created.c_str());
+        }
+    }
+    state.reset();
+    return result;
+}
+
+void
+ca_file_writer::discard() {
+    if (state == nullptr) {
+        return;
+    }
+    // Nothing more is written, but queued batches may still borrow memory
+    state->current = internal::write_batch();
+    state->drain();
+    state->stop();
+    internal::ca_writer_close(state->file, false);
+    if (state->options.atomic_replace) {
+        internal::ca_writer_remove(state->created.c_str());
+    }
+    state.reset();
+}
+
+bool
+ca_file_writer::is_open() const {
+    return state != nullptr;
+}
+
+ca_uint64_t
+ca_file_writer::size() const {
+    return state != nullptr ? state->appended : 0;
+}
+
+}
@@ -0,0 +1,89 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/rw/ca_io_file_writer_backend.h
+//
+// @file
+// @brief Declares the platform primitives of `ca_file_writer`.
+// ================================
+
+#ifndef CA_IO_FILE_WRITER_BACKEND_H
+#define CA_IO_FILE_WRITER_BACKEND_H
+
+#include "core/rw/ca_io_file_writer.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace ca::ca_io::internal {
+
+/**
+ * @typedef ca_native_file
+ * @brief A file descriptor, or a `HANDLE` on Windows.
+ */
+typedef std::intptr_t ca_native_file;
+
+/**
+ * @brief Value of a `ca_native_file` that is not open.
+ */
+constexpr ca_native_file INVALID_NATIVE_FILE = -1;
+
+/**
+ * @struct ca_write_segment
+ * @brief Bytes written by one element of a vectored write.
+ */
+struct ca_write_segment {
+    const ca_string::ca_char_t *data;   ///< Start of the bytes.
+    ca_size_t size;                     ///< Number of bytes.
+};
+
+/**
+ * @brief Creates a file for writing, truncating it.
+ *
+ * @param path [in] Path of the target. Must not be `nullptr`.
+ * @param temporary [in] Whether to create a uniquely named file next to the
+ *                  target instead of the target itself.
+ * @param file [out] Receives the file. Must not be `nullptr`.
+ * @param created [out] Receives the path of the created file. Must not be `nullptr`.
+ * @return `FILE_OK`, or the error creating the file.
+ */
+ca_file_result
+ca_writer_create(const char *path, bool temporary, ca_native_file *file, std::string *created);
+
+/**
+ * @brief Writes segments at an offset, retrying partial writes.
+ *
+ * @param file [in] The file.
+ * @param segments [in] The segments, written back to back.
+ * @param offset [in] Offset of the first byte in the file.
+ * @return `FILE_OK`, or the error writing.
+ */
+ca_file_result
+ca_writer_write(ca_native_file file, std::span<const ca_write_segment> segments, ca_uint64_t offset);
+
+/**
+ * @brief Closes a file.
+ *
+ * @param file [in] The file.
+ * @param sync [in] Whether to flush the file to the device first.
+ * @return `FILE_OK`, or the error flushing or closing.
+ */
+ca_file_result
+ca_writer_close(ca_native_file file, bool sync);
+
+/**
+ * @brief Renames a file over another one atomically.
+ *
+ * @return `FILE_OK`, or the error renaming.
+ */
+ca_file_result
+ca_writer_replace(const char *from, const char *to);
+
+/**
+ * @brief Removes a file, ignoring errors.
+ */
+void
+ca_writer_remove(const char *path);
+
+}
+
+#endif //CA_IO_FILE_WRITER_BACKEND_H
@@ -1,5 +1,5 @@
 // ================================
-// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/internal/win32_translater
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/internal/win32_translater.h
 //
 // @file
 // @brief Translator for Win32 file operations.
@@ -11,7 +11,7 @@
 #include <windows.h>
 #include "core/file_defs.h"
 
-namespace ca::ca_file::internal {
+namespace ca::ca_io::internal {
 
 inline DWORD
 ca_translate_access(const ca_file_mode mode) {
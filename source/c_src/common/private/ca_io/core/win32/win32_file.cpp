@@ -0,0 +1,47 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/win32_file.cpp
+//
+// @file
+// @brief Implements basic file operations for Win32.
+// ================================
+
+#include "core/ca_io_file.h"
+#include "core/win32/internal/win32_translater.h"
+
+#include <cassert>
+
+namespace ca::ca_io {
+
+ca_file_result
+ca_file_stat(const char *path, ca_file_stamp *stamp) {
+    assert(path != nullptr);
+    assert(stamp != nullptr);
+
+    // Backup semantics allow opening directories too
+    const HANDLE file = CreateFileA(path, FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return internal::ca_translate_win32_error(GetLastError());
+    }
+
+    BY_HANDLE_FILE_INFORMATION info;
+    const BOOL ok = GetFileInformationByHandle(file, &info);
+    const DWORD error = GetLastError();
+    CloseHandle(file);
+    if (!ok) {
+        return internal::ca_translate_win32_error(error);
+    }
+
+    // FILETIME counts 100 ns intervals since 1601-01-01
+    constexpr ca_int64_t EPOCH_OFFSET = 116444736000000000LL;
+    const ca_int64_t write_time = (static_cast<ca_int64_t>(info.ftLastWriteTime.dwHighDateTime) << 32) |
+                                  info.ftLastWriteTime.dwLowDateTime;
+
+    stamp->device = info.dwVolumeSerialNumber;
+    stamp->inode = (static_cast<ca_uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+    stamp->size = (static_cast<ca_uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    stamp->mtime_ns = (write_time - EPOCH_OFFSET) * 100;
+    return ca_file_result::FILE_OK;
+}
+
+}
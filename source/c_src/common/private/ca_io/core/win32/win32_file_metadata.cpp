@@ -0,0 +1,61 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/win32_file_metadata.cpp
+//
+// @file
+// @brief Implements metadata queries for Win32.
+// ================================
+
+#include "core/internal/ca_io_file_metadata_backend.h"
+#include "core/win32/internal/win32_translater.h"
+
+#include <cassert>
+#include <sys/stat.h>
+
+namespace ca::ca_io::internal {
+
+void
+ca_query_metadata(const char *path, ca_file_metadata *metadata) {
+    assert(path != nullptr);
+    assert(metadata != nullptr);
+
+    *metadata = ca_file_metadata{};
+
+    // Backup semantics allow opening directories too
+    const HANDLE file = CreateFileA(path, FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        metadata->result = ca_translate_win32_error(GetLastError());
+        return;
+    }
+
+    BY_HANDLE_FILE_INFORMATION info;
+    const BOOL ok = GetFileInformationByHandle(file, &info);
+    const DWORD error = GetLastError();
+    CloseHandle(file);
+    if (!ok) {
+        metadata->result = ca_translate_win32_error(error);
+        return;
+    }
+
+    // FILETIME counts 100 ns intervals since 1601-01-01
+    constexpr ca_int64_t EPOCH_OFFSET = 116444736000000000LL;
+    const ca_int64_t write_time = (static_cast<ca_int64_t>(info.ftLastWriteTime.dwHighDateTime) << 32) |
+                                  info.ftLastWriteTime.dwLowDateTime;
+
+    metadata->size = (static_cast<ca_uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    metadata->mtime_ns = (write_time - EPOCH_OFFSET) * 100;
+    metadata->inode = (static_cast<ca_uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+    metadata->mode = (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 ? _S_IFDIR : _S_IFREG;
+    if ((info.dwFileAttributes & FILE_ATTRIBUTE_READONLY) == 0) {
+        metadata->mode |= _S_IWRITE;
+    }
+    metadata->mode |= _S_IREAD;
+    metadata->result = ca_file_result::FILE_OK;
+}
+
+int
+ca_query_metadata_io_uring(std::span<const char *const>, std::span<ca_file_metadata>, ca_size_t) {
+    return -1;
+}
+
+}
@@ -0,0 +1,18 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/win32_file_rw_asyn.cpp
+//
+// @file
+// @brief Win32 has no io_uring; `ca_async_file_reader` uses its thread pool
+//        backend there.
+// ================================
+
+#include "core/rw/ca_io_file_rw_asyn_backend.h"
+
+namespace ca::ca_io::internal {
+
+std::unique_ptr<ca_async_backend>
+make_io_uring_backend(const ca_async_reader_options &) {
+    return nullptr;
+}
+
+}
@@ -0,0 +1,160 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/win32_file_rw_sync.cpp
+//
+// @file
+// @brief Implements synchronous file loading for Win32 with file mappings
+//        and `ReadFile`.
+// ================================
+
+#include "core/rw/ca_io_file_rw_sync.h"
+#include "core/rw/ca_io_file_view_access.h"
+#include "core/win32/internal/win32_translater.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace ca::ca_io {
+
+using ca_string::ca_char_t;
+
+namespace {
+
+/**
+ * @brief Initial buffer size for files of unknown size.
+ */
+constexpr ca_size_t STREAM_INITIAL_SIZE = 64 * 1024;
+
+/**
+ * @brief Largest request passed to a single `ReadFile` call.
+ */
+constexpr ca_size_t MAX_READ_SIZE = 1u << 30;
+
+/**
+ * @brief Closes a handle when leaving scope.
+ */
+struct handle_guard {
+    HANDLE handle;
+
+    ~handle_guard() {
+        if (handle != nullptr && handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(handle);
+        }
+    }
+};
+
+/**
+ * @brief Reads until the end of the file or until `limit` bytes, doubling
+ *        the pooled buffer whenever it fills up.
+ *
+ * @return `ERROR_SUCCESS`, or the error of the failed read.
+ */
+DWORD
+read_all(const HANDLE file, const ca_size_t initial_size, const ca_size_t limit, ca_io_buffer_pool *pool,
+         ca_char_t **data, ca_size_t *len, ca_size_t *capacity) {
+    ca_char_t *block = pool->acquire(initial_size, capacity);
+    ca_size_t done = 0;
+
+    while (done < limit) {
+        if (done == *capacity) {
+            ca_size_t new_capacity;
+            ca_char_t *bigger = pool->acquire(*capacity * 2, &new_capacity);
+            memcpy(bigger, block, done);
+            pool->release(block, *capacity);
+            block = bigger;
+            *capacity = new_capacity;
+        }
+
+        DWORD n = 0;
+        const ca_size_t request = ca_math::ca_min<ca_size_t>(ca_math::ca_min(*capacity, limit) - done, MAX_READ_SIZE);
+        if (!ReadFile(file, block + done, static_cast<DWORD>(request), &n, nullptr)) {
+            const DWORD err = GetLastError();
+            if (err == ERROR_BROKEN_PIPE) {
+                break;  // the writing end of a pipe was closed
+            }
+            pool->release(block, *capacity);
+            return err;
+        }
+        if (n == 0) {
+            break;
+        }
+        done += n;
+    }
+
+    *data = block;
+    *len = done;
+    return ERROR_SUCCESS;
+}
+
+}
+
+void
+ca_file_view::reset() {
+    if (ptr != nullptr) {
+        if (mapped) {
+            UnmapViewOfFile(ptr);
+        }
+        else {
+            pool->release(ptr, capacity);
+        }
+    }
+    ptr = nullptr;
+    len = 0;
+    capacity = 0;
+    pool = nullptr;
+    mapped = false;
+}
+
+ca_file_result
+ca_file_read(const char *path, ca_file_view *view, const ca_file_read_options &options) {
+    assert(path != nullptr);
+    assert(view != nullptr);
+
+    view->reset();
+
+    handle_guard file{ CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+    if (file.handle == INVALID_HANDLE_VALUE) {
+        return internal::ca_translate_win32_error(GetLastError());
+    }
+
+    // Zero-copy path for large regular files
+    const bool regular = GetFileType(file.handle) == FILE_TYPE_DISK;
+    LARGE_INTEGER size{};
+    if (regular && !GetFileSizeEx(file.handle, &size)) {
+        return internal::ca_translate_win32_error(GetLastError());
+    }
+    const auto file_size = static_cast<ca_size_t>(size.QuadPart);
+    if (regular && file_size > 0 && file_size >= options.mmap_threshold) {
+        handle_guard mapping{ CreateFileMappingA(file.handle, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+        if (mapping.handle != nullptr) {
+            void *map = MapViewOfFile(mapping.handle, FILE_MAP_READ, 0, 0, 0);
+            if (map != nullptr) {
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+                if (options.will_need) {
+                    WIN32_MEMORY_RANGE_ENTRY range{ map, file_size };
+                    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+                }
+#endif
+                internal::ca_file_view_access::assign_mapped(view, static_cast<ca_char_t *>(map), file_size);
+                return ca_file_result::FILE_OK;
+            }
+        }
+        // Fall back to reading the file
+    }
+
+    ca_io_buffer_pool *pool = options.pool != nullptr ? options.pool : &ca_io_buffer_pool::global();
+    ca_char_t *data = nullptr;
+    ca_size_t len = 0;
+    ca_size_t capacity = 0;
+    const DWORD err = regular && file_size > 0
+                          ? read_all(file.handle, file_size, file_size, pool, &data, &len, &capacity)
+                          : read_all(file.handle, STREAM_INITIAL_SIZE, CA_SIZE_T_MAX, pool, &data, &len, &capacity);
+    if (err != ERROR_SUCCESS) {
+        return internal::ca_translate_win32_error(err);
+    }
+
+    internal::ca_file_view_access::assign_pooled(view, data, len, capacity, pool);
+    return ca_file_result::FILE_OK;
+}
+
+}
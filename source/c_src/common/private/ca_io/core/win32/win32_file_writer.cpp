@@ -0,0 +1,94 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/win32_file_writer.cpp
+//
+// @file
+// @brief Implements the primitives of `ca_file_writer` for Win32 with
+//        `WriteFile` and `MoveFileExA`.
+// ================================
+
+#include "core/rw/ca_io_file_writer_backend.h"
+#include "core/win32/internal/win32_translater.h"
+
+#include <cassert>
+
+namespace ca::ca_io::internal {
+
+ca_file_result
+ca_writer_create(const char *path, const bool temporary, ca_native_file *file, std::string *created) {
+    assert(path != nullptr);
+    assert(file != nullptr);
+    assert(created != nullptr);
+
+    std::string name = path;
+    if (temporary) {
+        // Next to the target, so the final move stays on one volume
+        name += ".tmp" + std::to_string(GetCurrentProcessId()) + "_" + std::to_string(GetTickCount64());
+    }
+
+    const HANDLE handle = CreateFileA(name.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                      temporary ? CREATE_NEW : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return ca_translate_win32_error(GetLastError());
+    }
+    *file = reinterpret_cast<ca_native_file>(handle);
+    *created = std::move(name);
+    return ca_file_result::FILE_OK;
+}
+
+ca_file_result
+ca_writer_write(const ca_native_file file, const std::span<const ca_write_segment> segments, ca_uint64_t offset) {
+    const auto handle = reinterpret_cast<HANDLE>(file);
+
+    // WriteFileGather needs page-aligned buffers, so the segments go one by one
+    for (const ca_write_segment &segment : segments) {
+        const ca_string::ca_char_t *data = segment.data;
+        ca_size_t left = segment.size;
+        while (left > 0) {
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            const DWORD count = static_cast<DWORD>(ca_math::ca_min<ca_size_t>(left, 1u << 30));
+            DWORD written = 0;
+            if (!WriteFile(handle, data, count, &written, &overlapped)) {
+                return ca_translate_win32_error(GetLastError());
+            }
+            data += written;
+            left -= written;
+            offset += written;
+        }
+    }
+    return ca_file_result::FILE_OK;
+}
+
+ca_file_result
+ca_writer_close(const ca_native_file file, const bool sync) {
+    const auto handle = reinterpret_cast<HANDLE>(file);
+    ca_file_result result = ca_file_result::FILE_OK;
+    if (sync && !FlushFileBuffers(handle)) {
+        result = ca_translate_win32_error(GetLastError());
+    }
+    if (!CloseHandle(handle) && result == ca_file_result::FILE_OK) {
+        result = ca_translate_win32_error(GetLastError());
+    }
+    return result;
+}
+
+ca_file_result
+ca_writer_replace(const char *from, const char *to) {
+    assert(from != nullptr);
+    assert(to != nullptr);
+
+    if (!MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        return ca_translate_win32_error(GetLastError());
+    }
+    return ca_file_result::FILE_OK;
+}
+
+void
+ca_writer_remove(const char *path) {
+    assert(path != nullptr);
+
+    DeleteFileA(path);
+}
+
+}
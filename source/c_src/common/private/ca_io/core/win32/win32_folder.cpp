@@ -0,0 +1,61 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/win32_folder.cpp
+//
+// @file
+// @brief Implements directory listing for Win32 with `FindFirstFileEx`.
+// ================================
+
+#include "core/internal/ca_io_directory.h"
+#include "core/win32/internal/win32_translater.h"
+
+#include <cassert>
+
+namespace ca::ca_io::internal {
+
+ca_file_result
+ca_list_directory(const char *path, const ca_directory_callback &callback) {
+    assert(path != nullptr);
+
+    std::string pattern(path);
+    pattern += "\\*";
+
+    WIN32_FIND_DATAA data;
+    const HANDLE find = FindFirstFileExA(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch,
+                                         nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (find == INVALID_HANDLE_VALUE) {
+        return ca_translate_win32_error(GetLastError());
+    }
+
+    do {
+        const char *name = data.cFileName;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        // Reparse points report the type of their target through the attributes
+        const bool is_symlink = (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+        const ca_folder_entry_type type = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0
+                                              ? ca_folder_entry_type::FOLDER_ENTRY_DIRECTORY
+                                              : ca_folder_entry_type::FOLDER_ENTRY_FILE;
+        callback(name, type, is_symlink);
+    } while (FindNextFileA(find, &data));
+
+    const DWORD err = GetLastError();
+    FindClose(find);
+    return err == ERROR_NO_MORE_FILES ? ca_file_result::FILE_OK : ca_translate_win32_error(err);
+}
+
+int
+ca_canonical_path(const char *path, std::string *canonical) {
+    assert(path != nullptr);
+    assert(canonical != nullptr);
+
+    char resolved[MAX_PATH];
+    const DWORD size = GetFullPathNameA(path, MAX_PATH, resolved, nullptr);
+    if (size == 0 || size >= MAX_PATH) {
+        return -1;
+    }
+    canonical->assign(resolved, size);
+    return 0;
+}
+
+}
@@ -0,0 +1,45 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/win32_path.cpp
+//
+// @file
+// @brief Implements the file system queries of `ca_io_path` for Win32.
+// ================================
+
+#include "core/ca_io_path.h"
+
+#include <cassert>
+#include <memory>
+#include <windows.h>
+
+namespace ca::ca_io {
+
+bool
+ca_io_path::exists() const {
+    return GetFileAttributesA(c_str()) != INVALID_FILE_ATTRIBUTES;
+}
+
+int
+ca_io_path::current_directory(ca_io_path *path) {
+    assert(path != nullptr);
+
+    char buffer[MAX_PATH];
+    DWORD size = GetCurrentDirectoryA(sizeof(buffer), buffer);
+    if (size > 0 && size < sizeof(buffer)) {
+        path->assign(std::string_view(buffer, size));
+        return 0;
+    }
+
+    // The returned size includes the terminator when the buffer is too small
+    while (size >= sizeof(buffer)) {
+        const std::unique_ptr<char[]> block(new char[size]);
+        const DWORD written = GetCurrentDirectoryA(size, block.get());
+        if (written > 0 && written < size) {
+            path->assign(std::string_view(block.get(), written));
+            return 0;
+        }
+        size = written;
+    }
+    return -1;
+}
+
+}
@@ -0,0 +1,54 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/win32_prefetch.cpp
+//
+// @file
+// @brief Implements prefetch hints for Win32 with `PrefetchVirtualMemory`
+//        over a temporary mapping.
+// ================================
+
+#include "core/internal/ca_io_prefetch_hint.h"
+
+#include <cassert>
+#include <windows.h>
+
+namespace ca::ca_io::internal {
+
+int
+ca_prefetch_hint(const char *path, ca_size_t *size) {
+    assert(path != nullptr);
+    assert(size != nullptr);
+
+    const HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return -1;
+    }
+
+    LARGE_INTEGER file_size{};
+    if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return -1;
+    }
+    *size = static_cast<ca_size_t>(file_size.QuadPart);
+
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+    // The pages stay in the file cache after the view is unmapped
+    if (*size > 0) {
+        const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            void *map = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (map != nullptr) {
+                WIN32_MEMORY_RANGE_ENTRY range{ map, *size };
+                PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+                UnmapViewOfFile(map);
+            }
+            CloseHandle(mapping);
+        }
+    }
+#endif
+
+    CloseHandle(file);
+    return 0;
+}
+
+}
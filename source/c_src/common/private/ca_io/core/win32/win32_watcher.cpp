@@ -0,0 +1,18 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_io/core/win32/win32_watcher.cpp
+//
+// @file
+// @brief Win32 has no backend for `ca_file_watcher` yet.
+// ================================
+
+#include "core/internal/ca_io_watch_backend.h"
+
+namespace ca::ca_io::internal {
+
+std::unique_ptr<ca_watch_backend>
+make_watch_backend(const std::string &, const ca_watch_options &, ca_file_result *result) {
+    *result = ca_file_result::FILE_ERROR_NOT_SUPPORTED;
+    return nullptr;
+}
+
+}
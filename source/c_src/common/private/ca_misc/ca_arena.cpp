@@ -0,0 +1,82 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_misc/ca_arena.cpp
+//
+// @file
+// @brief Implements `ca_arena`.
+// ================================
+
+#include "ca_arena.h"
+
+#include <algorithm>
+
+namespace ca::ca_misc {
+
+ca_arena::ca_arena(const ca_size_t first_chunk)
+    : first_size(std::max<ca_size_t>(first_chunk, 64)), cursor(0), limit(0), counters() {}
+
+void *
+ca_arena::allocate_chunk(const ca_size_t size, const ca_size_t alignment) {
+#ifdef CA_ENABLE_OPTIMIZER
+    // Chunks double in size, and are large enough for the request however
+    // the new memory is aligned
+    const ca_size_t previous = chunks.empty() ? first_size / 2 : chunks.back().size;
+    const ca_size_t chunk_size = std::max(std::min(previous * 2, std::max(MAX_CHUNK_SIZE, first_size)),
+                                          size + alignment);
+#else
+    const ca_size_t chunk_size = size + alignment;
+#endif
+    chunks.push_back({ std::make_unique_for_overwrite<std::byte[]>(chunk_size), chunk_size });
+    ++counters.chunks;
+    counters.reserved += chunk_size;
+    counters.peak_reserved = std::max(counters.peak_reserved, counters.reserved);
+
+    rewind();
+    void *memory = allocate(size, alignment);
+#ifndef CA_ENABLE_OPTIMIZER
+    // Leaves no room, so that the next allocation gets a chunk of its own
+    cursor = limit = 0;
+#endif
+    return memory;
+}
+
+void
+ca_arena::rewind() {
+    if (chunks.empty()) {
+        cursor = limit = 0;
+        return;
+    }
+    cursor = reinterpret_cast<std::uintptr_t>(chunks.back().data.get());
+    limit = cursor + chunks.back().size;
+}
+
+void
+ca_arena::reset() {
+    ++counters.resets;
+#ifdef CA_ENABLE_OPTIMIZER
+    if (chunks.size() > 1) {
+        // Keep only the largest chunk, usually the last one
+        const auto largest = std::max_element(chunks.begin(), chunks.end(), [](const chunk &a, const chunk &b) {
+            return a.size < b.size;
+        });
+        chunk kept = std::move(*largest);
+        chunks.clear();
+        chunks.push_back(std::move(kept));
+        counters.reserved = chunks.back().size;
+    }
+    rewind();
+#else
+    chunks.clear();
+    counters.reserved = 0;
+    cursor = limit = 0;
+#endif
+}
+
+void
+ca_arena::release() {
+    ++counters.resets;
+    chunks.clear();
+    counters.reserved = 0;
+    cursor = limit = 0;
+}
+
+}
@@ -0,0 +1,30 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_misc/ca_arena_resource.cpp
+//
+// @file
+// @brief Implements `ca_arena_resource`.
+// ================================
+
+#include "ca_arena_resource.h"
+
+namespace ca::ca_misc {
+
+void *
+ca_arena_resource::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+    return source.allocate(bytes, alignment);
+}
+
+void
+ca_arena_resource::do_deallocate(void *, std::size_t, std::size_t) {
+    // Monotonic: the memory is freed when the arena is reset
+}
+
+bool
+ca_arena_resource::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    // Two resources over the same arena can free each other's memory, which
+    // neither does anyway
+    const auto *resource = dynamic_cast<const ca_arena_resource *>(&other);
+    return resource != nullptr && &resource->source == &source;
+}
+
+}
@@ -0,0 +1,238 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_misc/ca_fixed_pool.cpp
+//
+// @file
+// @brief Implements `ca_fixed_pool`.
+// ================================
+
+#include "ca_fixed_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ca::ca_misc {
+
+namespace {
+
+/**
+ * @brief Source of the pool ids, never reused so that the list a thread
+ *        kept for a destroyed pool cannot be mistaken for a new pool's.
+ */
+std::atomic<ca_uint64_t> next_pool_id{ 1 };
+
+/**
+ * @struct pool_registry
+ * @brief The pools alive, which threads check their lists against.
+ */
+struct pool_registry {
+    std::mutex lock;                            ///< Guards `live`.
+    std::unordered_set<ca_uint64_t> live;       ///< Ids of the pools not destroyed yet.
+    std::atomic<ca_uint64_t> epoch{ 0 };        ///< Number of pools destroyed so far.
+};
+
+/**
+ * @brief Returns the registry, created before the first pool and so
+ *        destroyed after the last one.
+ */
+pool_registry &
+registry() {
+    static pool_registry pools;
+    return pools;
+}
+
+/**
+ * @brief Free lists of the calling thread.
+ */
+template <typename List>
+struct thread_lists {
+    ca_uint64_t last_id = 0;                        ///< Id of the pool used last.
+    List *last = nullptr;                           ///< Its list.
+    ca_uint64_t epoch = 0;                          ///< Registry epoch the lists were last pruned at.
+    std::unordered_map<ca_uint64_t, List> lists;    ///< Every list, by pool id.
+};
+
+/**
+ * @brief Returns the free lists of the calling thread.
+ */
+template <typename List>
+thread_lists<List> &
+current_lists() {
+    static thread_local thread_lists<List> lists;
+    return lists;
+}
+
+}
+
+ca_fixed_pool::ca_fixed_pool(const ca_size_t block_size, const ca_size_t alignment, const ca_size_t blocks_per_slab)
+    : align(std::max(alignment, alignof(node))),
+      id(next_pool_id.fetch_add(1, std::memory_order_relaxed)), allocated(0),
+      shared_head(nullptr), fresh(nullptr), fresh_blocks(0), counters() {
+    assert(std::has_single_bit(alignment));
+    size = (std::max(block_size, sizeof(node)) + align - 1) & ~(align - 1);
+    slab_blocks = blocks_per_slab != 0 ? blocks_per_slab : std::max<ca_size_t>(1, 64 * 1024 / size);
+
+    pool_registry &pools = registry();
+    std::lock_guard guard(pools.lock);
+    pools.live.insert(id);
+}
+
+ca_fixed_pool::~ca_fixed_pool() {
+    // Only the list of this thread can be dropped here; the other threads
+    // drop theirs once they see the epoch move
+    pool_registry &pools = registry();
+    {
+        std::lock_guard guard(pools.lock);
+        pools.live.erase(id);
+    }
+    pools.epoch.fetch_add(1, std::memory_order_release);
+
+    thread_lists<local_list> &lists = current_lists<local_list>();
+    lists.lists.erase(id);
+    if (lists.last_id == id) {
+        lists.last_id = 0;
+        lists.last = nullptr;
+    }
+    for (void *slab : slabs) {
+        ::operator delete(slab, std::align_val_t(align));
+    }
+}
+
+ca_fixed_pool::local_list &
+ca_fixed_pool::local() {
+    thread_lists<local_list> &lists = current_lists<local_list>();
+    if (lists.last_id != id) {
+        // Switching pools is rare enough to also prune the lists of
+        // destroyed pools; their blocks went with their slabs
+        pool_registry &pools = registry();
+        const ca_uint64_t epoch = pools.epoch.load(std::memory_order_acquire);
+        if (epoch != lists.epoch) {
+            std::lock_guard guard(pools.lock);
+            std::erase_if(lists.lists, [&](const auto &entry) { return !pools.live.contains(entry.first); });
+            lists.epoch = epoch;
+        }
+        lists.last = &lists.lists[id];
+        lists.last_id = id;
+    }
+    return *lists.last;
+}
+
+void *
+ca_fixed_pool::allocate() {
+#ifdef CA_ENABLE_OPTIMIZER
+    local_list &list = local();
+    if (list.head == nullptr) {
+        refill(list);
+    }
+    node *block = list.head;
+    list.head = block->next;
+    --list.count;
+    if (++list.allocations == BATCH_SIZE) {
+        allocated.fetch_add(BATCH_SIZE, std::memory_order_relaxed);
+        list.allocations = 0;
+    }
+    return block;
+#else
+    void *block = ::operator new(size, std::align_val_t(align));
+    std::lock_guard guard(lock);
+    ++counters.allocations;
+    ++counters.chunks;
+    counters.requested += size;
+    counters.reserved += size;
+    counters.peak_reserved = std::max(counters.peak_reserved, counters.reserved);
+    return block;
+#endif
+}
+
+void
+ca_fixed_pool::deallocate(void *block) {
+    if (block == nullptr) {
+        return;
+    }
+#ifdef CA_ENABLE_OPTIMIZER
+    local_list &list = local();
+    list.head = ::new (block) node{ list.head };
+    if (++list.count >= 2 * BATCH_SIZE) {
+        give_back(list);
+    }
+#else
+    ::operator delete(block, std::align_val_t(align));
+    std::lock_guard guard(lock);
+    counters.reserved -= size;
+#endif
+}
+
+void
+ca_fixed_pool::refill(local_list &list) {
+    std::lock_guard guard(lock);
+    while (shared_head != nullptr && list.count < BATCH_SIZE) {
+        node *block = shared_head;
+        shared_head = block->next;
+        block->next = list.head;
+        list.head = block;
+        ++list.count;
+    }
+    if (list.count != 0) {
+        return;
+    }
+
+    // Blocks are carved from the current slab a batch at a time, so that a
+    // list never holds more than two batches
+    if (fresh_blocks == 0) {
+        fresh = static_cast<std::byte *>(::operator new(size * slab_blocks, std::align_val_t(align)));
+        fresh_blocks = slab_blocks;
+        slabs.push_back(fresh);
+        ++counters.chunks;
+        counters.reserved += size * slab_blocks;
+        counters.peak_reserved = std::max(counters.peak_reserved, counters.reserved);
+    }
+    const ca_size_t carved = std::min(fresh_blocks, BATCH_SIZE);
+    for (ca_size_t i = carved; i-- > 0;) {
+        list.head = ::new (fresh + i * size) node{ list.head };
+    }
+    fresh += carved * size;
+    fresh_blocks -= carved;
+    list.count = carved;
+}
+
+void
+ca_fixed_pool::give_back(local_list &list) {
+    // The blocks freed last are the most likely to be in the cache of this
+    // thread, so they stay and the batch is cut from the end of the list
+    node *keep_last = list.head;
+    for (ca_size_t i = 1; i < list.count - BATCH_SIZE; ++i) {
+        keep_last = keep_last->next;
+    }
+    node *first = keep_last->next;
+    node *last = first;
+    while (last->next != nullptr) {
+        last = last->next;
+    }
+    keep_last->next = nullptr;
+    list.count -= BATCH_SIZE;
+
+    std::lock_guard guard(lock);
+    last->next = shared_head;
+    shared_head = first;
+}
+
+ca_size_t
+ca_fixed_pool::thread_list_count() {
+    return current_lists<local_list>().lists.size();
+}
+
+ca_memory_stats
+ca_fixed_pool::stats() const {
+    std::lock_guard guard(lock);
+    ca_memory_stats stats = counters;
+#ifdef CA_ENABLE_OPTIMIZER
+    stats.allocations = allocated.load(std::memory_order_relaxed);
+    stats.requested = stats.allocations * size;
+#endif
+    return stats;
+}
+
+}
@@ -1,3 +0,0 @@
-//
-// Created by Eden_ on 2025/4/3.
-//
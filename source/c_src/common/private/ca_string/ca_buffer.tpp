@@ -12,16 +12,20 @@
 #include "ca_utf8_utils.h"
 
 #include <algorithm>
+#include <bit>
+#include <cassert>
 #include <cstring>
+#include <emmintrin.h>  // SSE2
 
 namespace ca::ca_string {
 
 /**
  * @brief A functor for calling specific unary buffer functions based on the specified operation.
  *
- * This template struct enables calling various unary functions (e.g., ISALPHA, ISDIGIT, etc.) on a given
- * buffer of type `ca_buffer<encoding>`. The function to be applied is determined by the `function`
- * template parameter, and the result of the function call is returned as the type `T`.
+ * This template struct enables calling various unary functions (e.g., ISALPHA, ISDIGIT, etc.) on a
+ * codepoint decoded from a buffer of type `ca_buffer<encoding>`. The function to be applied is
+ * determined by the `function` template parameter, and the result of the function call is returned
+ * as the type `T`.
  *
  * The following unary functions are supported:
  * - ISALPHA
@@ -49,31 +53,242 @@ struct call_buffer_member_function {
                   "in call_buffer_member_function.");
 
     /**
-     * @brief Calls the specified unary function on the provided buffer.
+     * @brief Calls the specified unary function on a codepoint.
      *
-     * @param buffer The buffer on which the unary function will be applied.
+     * @param c The codepoint on which the unary function will be applied.
      * @return The result of the unary function.
      */
-    T operator()(ca_buffer<encoding> buffer) {
+    T operator()(const ca_char4_t c) {
         switch (function) {
             case ca_buffer_implemented_unary_functions::ISALPHA:
-                return ca_isalpha<encoding>(*buffer);
+                return ca_isalpha<encoding>(c);
             case ca_buffer_implemented_unary_functions::ISDECIMAL:
-                return ca_isdecimal<encoding>(*buffer);
+                return ca_isdecimal<encoding>(c);
             case ca_buffer_implemented_unary_functions::ISDIGIT:
-                return ca_isdigit<encoding>(*buffer);
+                return ca_isdigit<encoding>(c);
             case ca_buffer_implemented_unary_functions::ISSPACE:
-                return ca_isspace<encoding>(*buffer);
+                return ca_isspace<encoding>(c);
             case ca_buffer_implemented_unary_functions::ISALNUM:
-                return ca_isalnum<encoding>(*buffer);
+                return ca_isalnum<encoding>(c);
             case ca_buffer_implemented_unary_functions::ISNUMERIC:
-                return ca_isnumeric<encoding>(*buffer);
+                return ca_isnumeric<encoding>(c);
             default:
                 return false;
         }
     }
 };
 
+namespace internal {
+/**
+ * @brief ASCII range and delta of a case mapping function.
+ *
+ * Characters in `[lower_bound, upper_bound]` are mapped by adding `delta`,
+ * every other ASCII character maps to itself. Case folding of ASCII is the
+ * same as lowercase mapping.
+ *
+ * @tparam mapping The case mapping function.
+ */
+template <ca_buffer_case_mapping_functions mapping>
+struct ascii_case_mapping_traits {
+    static constexpr bool is_upper = mapping == ca_buffer_case_mapping_functions::TO_UPPER;
+
+    static constexpr ca_char_t lower_bound = is_upper ? 'a' : 'A';  ///< First mapped character.
+    static constexpr ca_char_t upper_bound = is_upper ? 'z' : 'Z';  ///< Last mapped character.
+    static constexpr ca_int8_t delta = is_upper ? -0x20 : 0x20;     ///< Offset added to mapped characters.
+};
+
+/**
+ * @brief Maps one code point according to the case mapping function.
+ *
+ * @param c The code point to map.
+ * @param out [out] Buffer of at least `CA_CASEFOLD_MAX_CODEPOINTS` code points.
+ *
+ * @return The number of code points written to `out`.
+ */
+template <ca_encoding_t encoding, ca_buffer_case_mapping_functions mapping>
+inline int
+case_map_codepoint(const ca_char4_t c, ca_char4_t *out) {
+    switch (mapping) {
+        case ca_buffer_case_mapping_functions::TO_LOWER:
+            out[0] = ca_tolower<encoding>(c);
+            return 1;
+        case ca_buffer_case_mapping_functions::TO_UPPER:
+            out[0] = ca_toupper<encoding>(c);
+            return 1;
+        case ca_buffer_case_mapping_functions::CASEFOLD:
+            return ca_casefold<encoding>(c, out);
+    }
+
+    out[0] = c;
+    return 1;
+}
+
+/**
+ * @brief Returns the length of the leading run of whole 16-byte blocks that
+ *        contain only ASCII bytes.
+ *
+ * @param src Pointer to the bytes to scan.
+ * @param n Number of bytes available.
+ *
+ * @return Number of leading bytes (a multiple of 16) known to be ASCII.
+ */
+inline ca_size_t
+ascii_block_prefix_simd(const ca_char_t *src, const ca_size_t n) {
+    ca_size_t i = 0;
+
+    while (i + 16 <= n) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            break;
+        }
+        i += 16;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Zero-extends 16 bytes into 16 UTF-32 codepoints with SSE2 unpacks.
+ *
+ * @param src Pointer to 16 readable bytes.
+ * @param dst Pointer to room for 16 codepoints.
+ */
+inline void
+widen_ascii16_simd(const ca_char_t *src, ca_char4_t *dst) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+
+    const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+    const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4), _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8), _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 12), _mm_unpackhi_epi16(hi, zero));
+}
+
+/**
+ * @brief Returns the index of the first differing codepoint of two arrays,
+ *        comparing 4 codepoints at a time with SSE2.
+ *
+ * @param a Pointer to the first array.
+ * @param b Pointer to the second array.
+ * @param n Number of codepoints in both arrays.
+ *
+ * @return The index of the first mismatch, or `n` if the arrays are equal.
+ */
+inline ca_size_t
+first_mismatch_simd(const ca_char4_t *a, const ca_char4_t *b, const ca_size_t n) {
+    ca_size_t i = 0;
+
+    while (i + 4 <= n) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        const auto equal = static_cast<ca_uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi32(va, vb)));
+        if (equal != 0xFFFF) {
+            return i + std::countr_zero(~equal) / 4;
+        }
+        i += 4;
+    }
+
+    for (; i < n; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Case maps whole 16-byte blocks of bytes with SSE2 compare/add.
+ *
+ * Each block is mapped by building a mask of the bytes in the ASCII range of
+ * the mapping and adding the masked delta. Bytes at or above 0x80 are negative
+ * as signed bytes and are therefore never mapped.
+ *
+ * @tparam mapping The case mapping function.
+ * @tparam stop_at_non_ascii Whether to stop at the first block containing a
+ *         non-ASCII byte (required for UTF-8, where such bytes start multibyte
+ *         sequences that may need a non-ASCII mapping).
+ *
+ * @param src Pointer to the source bytes.
+ * @param dst Pointer to the destination bytes (may be equal to `src`).
+ * @param n Number of bytes available.
+ *
+ * @return Number of bytes mapped (a multiple of 16).
+ */
+template <ca_buffer_case_mapping_functions mapping, bool stop_at_non_ascii>
+inline ca_size_t
+ascii_case_mapping_simd(const ca_char_t *src, ca_char_t *dst, const ca_size_t n) {
+    using traits = ascii_case_mapping_traits<mapping>;
+
+    const __m128i low = _mm_set1_epi8(static_cast<char>(traits::lower_bound - 1));
+    const __m128i high = _mm_set1_epi8(static_cast<char>(traits::upper_bound + 1));
+    const __m128i delta = _mm_set1_epi8(traits::delta);
+
+    ca_size_t i = 0;
+
+    while (i + 16 <= n) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        if constexpr (stop_at_non_ascii) {
+            if (_mm_movemask_epi8(chunk) != 0) {
+                break;
+            }
+        }
+
+        const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(chunk, low),
+                                               _mm_cmplt_epi8(chunk, high));
+        const __m128i mapped = _mm_add_epi8(chunk, _mm_and_si128(in_range, delta));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), mapped);
+        i += 16;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Case maps whole 4-character blocks of UTF-32 code points that are all ASCII.
+ *
+ * @tparam mapping The case mapping function.
+ *
+ * @param src Pointer to the source code points.
+ * @param dst Pointer to the destination code points (may be equal to `src`).
+ * @param n Number of code points available.
+ *
+ * @return Number of code points mapped (a multiple of 4). Stops at the first
+ *         block holding a non-ASCII code point.
+ */
+template <ca_buffer_case_mapping_functions mapping>
+inline ca_size_t
+utf32_case_mapping_simd(const ca_char4_t *src, ca_char4_t *dst, const ca_size_t n) {
+    using traits = ascii_case_mapping_traits<mapping>;
+
+    const __m128i ascii_max = _mm_set1_epi32(0x7F);
+    const __m128i low = _mm_set1_epi32(traits::lower_bound - 1);
+    const __m128i high = _mm_set1_epi32(traits::upper_bound + 1);
+    const __m128i delta = _mm_set1_epi32(traits::delta);
+
+    ca_size_t i = 0;
+
+    while (i + 4 <= n) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        // code points are at most 0x10FFFF, so signed compares are safe
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(chunk, ascii_max)) != 0) {
+            break;
+        }
+
+        const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi32(chunk, low),
+                                               _mm_cmplt_epi32(chunk, high));
+        const __m128i mapped = _mm_add_epi32(chunk, _mm_and_si128(in_range, delta));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), mapped);
+        i += 4;
+    }
+
+    return i;
+}
+}
+
 // ----------------------------
 // Member function implementations of ca_buffer
 // ----------------------------
@@ -306,23 +521,24 @@ ca_size_t ca_buffer<encoding>::num_bytes_next_character() const {
 template<ca_encoding_t encoding>
 template<ca_buffer_implemented_unary_functions unary_type>
 bool ca_buffer<encoding>::unary_loop() const {
-    const size_t num_codepoints1 = num_codepoints();
-
-    if (num_codepoints1 == 0) {
+    if (empty()) {
         return false;
     }
 
-    ca_buffer<encoding> tmp = *this;
+    ca_buffer_block_iterator<encoding> iter(*this);
     call_buffer_member_function<encoding, unary_type, bool> function;
+    bool any = false;
 
-    for (size_t i = 0; i < num_codepoints1; ++i) {
-        if (const bool result = function(tmp); !result) {
-            return false;
+    for (auto block = iter.next(); !block.empty(); block = iter.next()) {
+        any = true;
+        for (const ca_char4_t c : block) {
+            if (!function(c)) {
+                return false;
+            }
         }
-        ++tmp;
     }
 
-    return true;
+    return any;
 }
 
 template<ca_encoding_t encoding>
@@ -357,74 +573,74 @@ bool ca_buffer<encoding>::is_alphanumeric() const {
 
 template<ca_encoding_t encoding>
 bool ca_buffer<encoding>::islower() const {
-    size_t num_codepoints1 = num_codepoints();
-    if (num_codepoints1 == 0) {
+    if (empty()) {
         return false;
     }
 
-    ca_buffer<encoding> tmp = *this;
+    ca_buffer_block_iterator<encoding> iter(*this);
     bool cased = false;
-    for (size_t i = 0; i < num_codepoints1; ++i) {
-        if (ca_isupper<encoding>(*tmp) || ca_istitle<encoding>(*tmp)) {
-            return false;
-        }
-        else if (!cased && ca_islower<encoding>(*tmp)) {
-            cased = true;
+    for (auto block = iter.next(); !block.empty(); block = iter.next()) {
+        for (const ca_char4_t c : block) {
+            if (ca_isupper<encoding>(c) || ca_istitle<encoding>(c)) {
+                return false;
+            }
+            else if (!cased && ca_islower<encoding>(c)) {
+                cased = true;
+            }
         }
-        ++tmp;
     }
     return cased;
 }
 
 template<ca_encoding_t encoding>
 bool ca_buffer<encoding>::isupper() const {
-    const size_t num_codepoints1 = num_codepoints();
-    if (num_codepoints1 == 0) {
+    if (empty()) {
         return false;
     }
 
-    ca_buffer<encoding> tmp = *this;
+    ca_buffer_block_iterator<encoding> iter(*this);
     bool cased = false;
-    for (size_t i = 0; i < num_codepoints1; ++i) {
-        if (ca_islower<encoding>(*tmp) || ca_istitle<encoding>(*tmp)) {
-            return false;
-        }
-        else if (!cased && ca_isupper<encoding>(*tmp)) {
-            cased = true;
+    for (auto block = iter.next(); !block.empty(); block = iter.next()) {
+        for (const ca_char4_t c : block) {
+            if (ca_islower<encoding>(c) || ca_istitle<encoding>(c)) {
+                return false;
+            }
+            else if (!cased && ca_isupper<encoding>(c)) {
+                cased = true;
+            }
         }
-        ++tmp;
     }
     return cased;
 }
 
 template<ca_encoding_t encoding>
 bool ca_buffer<encoding>::istitle() const {
-    const size_t num_codepoints1 = num_codepoints();
-    if (num_codepoints1 == 0) {
+    if (empty()) {
         return false;
     }
 
-    ca_buffer<encoding> tmp = *this;
+    ca_buffer_block_iterator<encoding> iter(*this);
     bool cased = false;
     bool prev_cased = false;
-    for (size_t i = 0; i < num_codepoints1; ++i) {
-        if (ca_isupper<encoding>(*tmp) || ca_istitle<encoding>(*tmp)) {
-            if (prev_cased) {
-                return false;
+    for (auto block = iter.next(); !block.empty(); block = iter.next()) {
+        for (const ca_char4_t c : block) {
+            if (ca_isupper<encoding>(c) || ca_istitle<encoding>(c)) {
+                if (prev_cased) {
+                    return false;
+                }
+                prev_cased = true;
+                cased = true;
             }
-            prev_cased = true;
-            cased = true;
-        }
-        else if (ca_islower<encoding>(*tmp)) {
-            if (!prev_cased) {
-                return false;
+            else if (ca_islower<encoding>(c)) {
+                if (!prev_cased) {
+                    return false;
+                }
+                cased = true;
+            }
+            else {
+                prev_cased = false;
             }
-            cased = true;
-        }
-        else {
-            prev_cased = false;
         }
-        ++tmp;
     }
     return cased;
 }
@@ -434,6 +650,175 @@ bool ca_buffer<encoding>::isnumeric() const {
     return unary_loop<ca_buffer_implemented_unary_functions::ISNUMERIC>();
 }
 
+template<ca_encoding_t encoding>
+template<ca_buffer_case_mapping_functions mapping>
+inline ca_size_t
+ca_buffer<encoding>::case_mapping_size() const {
+    if (empty()) {
+        return 0;
+    }
+
+    switch (encoding) {
+    case ca_encoding_t::CA_ENCODING_ASCII:
+    {
+        // ASCII mappings are one-to-one
+        return after - buf;
+    }
+    case ca_encoding_t::CA_ENCODING_UTF32:
+    {
+        const auto *src = reinterpret_cast<const ca_char4_t *>(buf);
+        const auto *end = reinterpret_cast<const ca_char4_t *>(after);
+
+        if (mapping != ca_buffer_case_mapping_functions::CASEFOLD) {
+            return end - src;
+        }
+
+        ca_size_t size = 0;
+        ca_char4_t mapped[CA_CASEFOLD_MAX_CODEPOINTS];
+        for (; src < end; ++src) {
+            size += *src < 0x80 ? 1 : ca_casefold<encoding>(*src, mapped);
+        }
+        return size;
+    }
+    case ca_encoding_t::CA_ENCODING_UTF8:
+    {
+        const ca_char_t *src = buf;
+        ca_size_t size = 0;
+        ca_char4_t mapped[CA_CASEFOLD_MAX_CODEPOINTS];
+
+        while (src < after) {
+            const ca_size_t skipped = internal::ascii_block_prefix_simd(src, after - src);
+            src += skipped;
+            size += skipped;
+
+            // Handle one block (or the tail) that contains multibyte characters
+            const ca_char_t *stop = src + ca_math::ca_min<ca_size_t>(16, after - src);
+            while (src < stop) {
+                ca_char4_t c;
+                src += utf8::utf8_char_to_ucs4_code_without_check(src, &c);
+                const int n = internal::case_map_codepoint<encoding, mapping>(c, mapped);
+                for (int i = 0; i < n; ++i) {
+                    size += utf8::num_utf8_bytes_for_codepoint(mapped[i]);
+                }
+            }
+        }
+        return size;
+    }
+    }
+
+    return 0;
+}
+
+template<ca_encoding_t encoding>
+template<ca_buffer_case_mapping_functions mapping>
+inline ca_size_t
+ca_buffer<encoding>::case_mapping(ca_buffer<encoding> out) const {
+    if (empty()) {
+        return 0;
+    }
+    assert(out.buf != nullptr);
+
+    switch (encoding) {
+    case ca_encoding_t::CA_ENCODING_ASCII:
+    {
+        const ca_size_t len = after - buf;
+        ca_size_t i = internal::ascii_case_mapping_simd<mapping, false>(buf, out.buf, len);
+        for (; i < len; ++i) {
+            ca_char4_t mapped[CA_CASEFOLD_MAX_CODEPOINTS];
+            internal::case_map_codepoint<encoding, mapping>(buf[i], mapped);
+            out.buf[i] = static_cast<ca_char_t>(mapped[0]);
+        }
+        return len;
+    }
+    case ca_encoding_t::CA_ENCODING_UTF32:
+    {
+        const auto *src = reinterpret_cast<const ca_char4_t *>(buf);
+        const auto *end = reinterpret_cast<const ca_char4_t *>(after);
+        auto *dst = reinterpret_cast<ca_char4_t *>(out.buf);
+
+        while (src < end) {
+            const ca_size_t done = internal::utf32_case_mapping_simd<mapping>(src, dst, end - src);
+            src += done;
+            dst += done;
+
+            // Handle one block (or the tail) that contains non-ASCII characters
+            const ca_char4_t *stop = src + ca_math::ca_min<ca_size_t>(4, end - src);
+            for (; src < stop; ++src) {
+                ca_char4_t mapped[CA_CASEFOLD_MAX_CODEPOINTS];
+                const int n = internal::case_map_codepoint<encoding, mapping>(*src, mapped);
+                for (int i = 0; i < n; ++i) {
+                    *dst++ = mapped[i];
+                }
+            }
+        }
+        return dst - reinterpret_cast<ca_char4_t *>(out.buf);
+    }
+    case ca_encoding_t::CA_ENCODING_UTF8:
+    {
+        const ca_char_t *src = buf;
+        ca_char_t *dst = out.buf;
+
+        while (src < after) {
+            const ca_size_t done = internal::ascii_case_mapping_simd<mapping, true>(src, dst, after - src);
+            src += done;
+            dst += done;
+
+            // Handle one block (or the tail) that contains multibyte characters
+            const ca_char_t *stop = src + ca_math::ca_min<ca_size_t>(16, after - src);
+            while (src < stop) {
+                ca_char4_t c;
+                src += utf8::utf8_char_to_ucs4_code_without_check(src, &c);
+
+                ca_char4_t mapped[CA_CASEFOLD_MAX_CODEPOINTS];
+                const int n = internal::case_map_codepoint<encoding, mapping>(c, mapped);
+                for (int i = 0; i < n; ++i) {
+                    dst += utf8::ucs4_code_to_utf8_char_without_check(mapped[i], dst);
+                }
+            }
+        }
+        return dst - out.buf;
+    }
+    }
+
+    return 0;
+}
+
+template<ca_encoding_t encoding>
+inline ca_size_t
+ca_buffer<encoding>::to_lower_size() const {
+    return case_mapping_size<ca_buffer_case_mapping_functions::TO_LOWER>();
+}
+
+template<ca_encoding_t encoding>
+inline ca_size_t
+ca_buffer<encoding>::to_lower(ca_buffer<encoding> out) const {
+    return case_mapping<ca_buffer_case_mapping_functions::TO_LOWER>(out);
+}
+
+template<ca_encoding_t encoding>
+inline ca_size_t
+ca_buffer<encoding>::to_upper_size() const {
+    return case_mapping_size<ca_buffer_case_mapping_functions::TO_UPPER>();
+}
+
+template<ca_encoding_t encoding>
+inline ca_size_t
+ca_buffer<encoding>::to_upper(ca_buffer<encoding> out) const {
+    return case_mapping<ca_buffer_case_mapping_functions::TO_UPPER>(out);
+}
+
+template<ca_encoding_t encoding>
+inline ca_size_t
+ca_buffer<encoding>::casefold_size() const {
+    return case_mapping_size<ca_buffer_case_mapping_functions::CASEFOLD>();
+}
+
+template<ca_encoding_t encoding>
+inline ca_size_t
+ca_buffer<encoding>::casefold(ca_buffer<encoding> out) const {
+    return case_mapping<ca_buffer_case_mapping_functions::CASEFOLD>(out);
+}
+
 template<ca_encoding_t encoding>
 inline int
 ca_buffer<encoding>::buffer_memcmp(const ca_buffer<encoding> other, const ca_size_t len) const {
@@ -492,40 +877,22 @@ ca_buffer<encoding>::buffer_memset(const ca_char4_t fill_char, const ca_size_t n
     }
     case ca_encoding_t::CA_ENCODING_UTF32:
     {
-        std::fill_n(buf, n_chars, fill_char);
+        std::fill_n(reinterpret_cast<ca_char4_t *>(buf), n_chars, fill_char);
         return n_chars;
     }
     case ca_encoding_t::CA_ENCODING_UTF8:
     {
         ca_char_t utf8_c[4] = {0};
-        ca_char_t *tmp = buf;
-
         const ca_size_t size = utf8::ucs4_code_to_utf8_char_without_check(fill_char, utf8_c);
-
-        if (n_chars < 64) {
-            for (int i = 0; i < n_chars; ++i) {
-                memcpy(tmp, utf8_c, size);
-                tmp += size;
-            }
-        }
-        else {
-            memcpy(tmp, utf8_c, size);
-            const ca_size_t times = n_chars / 64;
-            const ca_size_t batch_size = size * 64;
-            const ca_size_t remain_bytes = (n_chars - times * 64) * size;
-
-            for (ca_uint64_t i = size; i != 64 * size; i *= 2) {
-                const ca_char_t *temp = tmp;
-                tmp += i;
-                memcpy(tmp, temp, i);
-            }
-
-            for (int i = 1; i < times; i++) {
-                tmp += batch_size;
-                memcpy(buf, tmp, batch_size);
-            }
-
-            memcpy(buf, tmp, remain_bytes);
+        const ca_size_t total = n_chars * size;
+
+        // Encode the character once, then double the filled prefix with memcpy
+        memcpy(buf, utf8_c, size);
+        ca_size_t filled = size;
+        while (filled < total) {
+            const ca_size_t n = ca_math::ca_min<ca_size_t>(filled, total - filled);
+            memcpy(buf + filled, buf, n);
+            filled += n;
         }
 
         return n_chars * size;
@@ -543,16 +910,25 @@ void ca_buffer<encoding>::buffer_fill_with_zeros_after_index(size_t start_index)
 
 template<ca_encoding_t encoding>
 ca_buffer<encoding> ca_buffer<encoding>::rstrip() const {
+    ca_buffer<encoding> stripped = *this;
+    if (empty()) {
+        return stripped;
+    }
+
     ca_buffer<encoding> tmp(after, 0);
 
     --tmp;
     while (tmp >= *this && (*tmp == '\0' || ca_isspace<encoding>(*tmp))) {
+        if (tmp == *this) {
+            stripped.after = buf;
+            return stripped;
+        }
         --tmp;
     }
     ++tmp;
 
-    after = tmp.buf;
-    return *this;
+    stripped.after = tmp.buf;
+    return stripped;
 }
 
 template<ca_encoding_t encoding>
@@ -560,29 +936,128 @@ int ca_buffer<encoding>::strcmp(ca_buffer<encoding> other, bool ignore_trailing_
     ca_buffer<encoding> tmp1 = ignore_trailing_whitespace ? rstrip() : *this;
     ca_buffer<encoding> tmp2 = ignore_trailing_whitespace ? other.rstrip() : other;
 
-    while (!tmp1.empty() && !tmp2.empty()) {
-        if (*tmp1 < *tmp2) {
-            return -1;
+    ca_buffer_block_iterator<encoding> iter1(tmp1);
+    ca_buffer_block_iterator<encoding> iter2(tmp2);
+    std::span<const ca_char4_t> block1 = iter1.next();
+    std::span<const ca_char4_t> block2 = iter2.next();
+
+    while (!block1.empty() && !block2.empty()) {
+        const ca_size_t n = ca_math::ca_min<ca_size_t>(block1.size(), block2.size());
+        if (const ca_size_t i = internal::first_mismatch_simd(block1.data(), block2.data(), n); i < n) {
+            return block1[i] < block2[i] ? -1 : 1;
         }
-        if (*tmp2 < *tmp1) {
-            return 1;
+
+        block1 = block1.subspan(n);
+        block2 = block2.subspan(n);
+        if (block1.empty()) {
+            block1 = iter1.next();
+        }
+        if (block2.empty()) {
+            block2 = iter2.next();
         }
-        ++tmp1;
-        ++tmp2;
     }
-    while (!tmp1.empty()) {
-        if (*tmp1) {
+
+    // The longer buffer only compares equal if the rest is null characters
+    for (; !block1.empty(); block1 = iter1.next()) {
+        if (std::any_of(block1.begin(), block1.end(), [](const ca_char4_t c) { return c != 0; })) {
             return 1;
         }
-        ++tmp1;
     }
-    while (!tmp2.empty()) {
-        if (*tmp2) {
+    for (; !block2.empty(); block2 = iter2.next()) {
+        if (std::any_of(block2.begin(), block2.end(), [](const ca_char4_t c) { return c != 0; })) {
             return -1;
         }
-        ++tmp2;
     }
     return 0;
 }
 
+// ----------------------------
+// Member function implementations of ca_buffer_block_iterator
+// ----------------------------
+
+template<ca_encoding_t encoding>
+inline
+ca_buffer_block_iterator<encoding>::ca_buffer_block_iterator(const ca_buffer<encoding> buffer) {
+    cur = buffer.buf;
+    end = buffer.empty() ? buffer.buf : buffer.after;
+
+    switch (encoding) {
+    case ca_encoding_t::CA_ENCODING_ASCII:
+    {
+        while (end > cur && end[-1] == '\0') {
+            --end;
+        }
+        break;
+    }
+    case ca_encoding_t::CA_ENCODING_UTF32:
+    {
+        end = cur + (end - cur) / sizeof(ca_char4_t) * sizeof(ca_char4_t);
+        while (end > cur && *reinterpret_cast<const ca_char4_t *>(end - sizeof(ca_char4_t)) == 0) {
+            end -= sizeof(ca_char4_t);
+        }
+        break;
+    }
+    case ca_encoding_t::CA_ENCODING_UTF8:
+    {
+        break;
+    }
+    }
+}
+
+template<ca_encoding_t encoding>
+inline std::span<const ca_char4_t>
+ca_buffer_block_iterator<encoding>::next() {
+    switch (encoding) {
+    case ca_encoding_t::CA_ENCODING_ASCII:
+    {
+        const ca_size_t n = ca_math::ca_min<ca_size_t>(BLOCK_SIZE, end - cur);
+        ca_size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            internal::widen_ascii16_simd(cur + i, block + i);
+        }
+        for (; i < n; ++i) {
+            block[i] = cur[i];
+        }
+        cur += n;
+        return { block, n };
+    }
+    case ca_encoding_t::CA_ENCODING_UTF32:
+    {
+        // Already fixed-width, hand out the buffer in place
+        const ca_size_t n = ca_math::ca_min<ca_size_t>(BLOCK_SIZE, (end - cur) / sizeof(ca_char4_t));
+        const auto *chars = reinterpret_cast<const ca_char4_t *>(cur);
+        cur += n * sizeof(ca_char4_t);
+        return { chars, n };
+    }
+    case ca_encoding_t::CA_ENCODING_UTF8:
+    {
+        ca_size_t n = 0;
+        while (n < BLOCK_SIZE && cur < end) {
+            // Widen a whole ASCII run of 16 bytes at once
+            if (n + 16 <= BLOCK_SIZE && end - cur >= 16 &&
+                _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cur))) == 0) {
+                internal::widen_ascii16_simd(cur, block + n);
+                cur += 16;
+                n += 16;
+                continue;
+            }
+
+            const auto size = static_cast<ca_size_t>(
+                    utf8::num_utf8_bytes_for_utf8_character_without_check(cur));
+            if (size > static_cast<ca_size_t>(end - cur)) {
+                // Incomplete sequence at the end of the buffer
+                cur = end;
+                break;
+            }
+            utf8::utf8_char_to_ucs4_code_without_check(cur, block + n);
+            cur += size;
+            ++n;
+        }
+        return { block, n };
+    }
+    }
+
+    return {};
+}
+
 }
@@ -14,6 +14,8 @@ extern "C" {
 
 #include "ca_utf8_utils.h"
 
+#include <cassert>
+
 namespace ca::ca_string {
 // ----------------------------
 // template <ca_encoding_t encoding>
@@ -434,6 +436,129 @@ ca_isdecimal(const ca_char4_t c) {
     return false;
 }
 
+// ----------------------------
+// template <ca_encoding_t encoding>
+// inline ca_char4_t
+// ca_tolower(ca_char4_t c);
+// ----------------------------
+
+template <>
+inline ca_char4_t
+ca_tolower<ca_encoding_t::CA_ENCODING_ASCII>(const ca_char4_t c) {
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+template <>
+inline ca_char4_t
+ca_tolower<ca_encoding_t::CA_ENCODING_UTF8>(const ca_char4_t c) {
+    return static_cast<ca_char4_t>(utf8proc_tolower(static_cast<utf8proc_int32_t>(c)));
+}
+
+template <>
+inline ca_char4_t
+ca_tolower<ca_encoding_t::CA_ENCODING_UTF32>(const ca_char4_t c) {
+    return static_cast<ca_char4_t>(utf8proc_tolower(static_cast<utf8proc_int32_t>(c)));
+}
+
+template <ca_encoding_t encoding>
+inline ca_char4_t
+ca_tolower(const ca_char4_t c) {
+    return c;
+}
+
+// ----------------------------
+// template <ca_encoding_t encoding>
+// inline ca_char4_t
+// ca_toupper(ca_char4_t c);
+// ----------------------------
+
+template <>
+inline ca_char4_t
+ca_toupper<ca_encoding_t::CA_ENCODING_ASCII>(const ca_char4_t c) {
+    return (c >= 'a' && c <= 'z') ? c - ('a' - 'A') : c;
+}
+
+template <>
+inline ca_char4_t
+ca_toupper<ca_encoding_t::CA_ENCODING_UTF8>(const ca_char4_t c) {
+    return static_cast<ca_char4_t>(utf8proc_toupper(static_cast<utf8proc_int32_t>(c)));
+}
+
+template <>
+inline ca_char4_t
+ca_toupper<ca_encoding_t::CA_ENCODING_UTF32>(const ca_char4_t c) {
+    return static_cast<ca_char4_t>(utf8proc_toupper(static_cast<utf8proc_int32_t>(c)));
+}
+
+template <ca_encoding_t encoding>
+inline ca_char4_t
+ca_toupper(const ca_char4_t c) {
+    return c;
+}
+
+// ----------------------------
+// template <ca_encoding_t encoding>
+// inline int
+// ca_casefold(ca_char4_t c, ca_char4_t *out);
+// ----------------------------
+
+namespace internal {
+inline int
+utf8proc_casefold(const ca_char4_t c, ca_char4_t *out) {
+    assert(out != nullptr);
+
+    if (c < 0x80) {
+        out[0] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+        return 1;
+    }
+
+    utf8proc_int32_t folded[CA_CASEFOLD_MAX_CODEPOINTS];
+    int boundclass = 0;
+    const utf8proc_ssize_t n = utf8proc_decompose_char(
+            static_cast<utf8proc_int32_t>(c), folded, CA_CASEFOLD_MAX_CODEPOINTS,
+            UTF8PROC_CASEFOLD, &boundclass);
+
+    if (n <= 0 || n > CA_CASEFOLD_MAX_CODEPOINTS) {
+        // unassigned or unexpected expansion, keep the character as is
+        out[0] = c;
+        return 1;
+    }
+
+    for (utf8proc_ssize_t i = 0; i < n; ++i) {
+        out[i] = static_cast<ca_char4_t>(folded[i]);
+    }
+    return static_cast<int>(n);
+}
+}
+
+template <>
+inline int
+ca_casefold<ca_encoding_t::CA_ENCODING_ASCII>(const ca_char4_t c, ca_char4_t *out) {
+    assert(out != nullptr);
+    out[0] = ca_tolower<ca_encoding_t::CA_ENCODING_ASCII>(c);
+    return 1;
+}
+
+template <>
+inline int
+ca_casefold<ca_encoding_t::CA_ENCODING_UTF8>(const ca_char4_t c, ca_char4_t *out) {
+    return internal::utf8proc_casefold(c, out);
+}
+
+template <>
+inline int
+ca_casefold<ca_encoding_t::CA_ENCODING_UTF32>(const ca_char4_t c, ca_char4_t *out) {
+    return internal::utf8proc_casefold(c, out);
+}
+
+template <ca_encoding_t encoding>
+inline int
+ca_casefold(const ca_char4_t c, ca_char4_t *out) {
+    assert(out != nullptr);
+    out[0] = c;
+    return 1;
+}
+
 // ----------------------------
 // Misc Function
 // ----------------------------
@@ -10,6 +10,7 @@
 
 #include "ca_math.h"
 
+#include <bit>
 #include <cassert>
 #include <emmintrin.h>  // SSE2
 #ifdef __AVX2__
@@ -364,17 +365,17 @@ inline const char_type* memchr_simd(const char_type* Buf, char_type Val, const c
     else {
 #if defined(__AVX2__)
         // ----------- ca_char4_t / uint32_t path (AVX2) ------------
-        const __m256i target = _mm256_set1_epi32(_Val);
+        const __m256i target = _mm256_set1_epi32(Val);
 
-        while (i + 8 <= _MaxCount) {
-            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_Buf + i));
+        while (i + 8 <= MaxCount) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Buf + i));
             const __m256i cmp = _mm256_cmpeq_epi32(chunk, target);
             const ca_int_t mask = _mm256_movemask_ps(_mm256_castsi256_ps(cmp));  // 8-bit result
 
             if (mask != 0) {
                 for (int j = 0; j < 8; ++j) {
-                    if (_Buf[i + j] == _Val) {
-                        return _Buf + i + j;
+                    if (Buf[i + j] == Val) {
+                        return Buf + i + j;
                     }
                 }
             }
@@ -467,19 +468,19 @@ inline const char_type* rmemchr_simd(const char_type* Buf, char_type Val, const
     else {
 #if defined(__AVX2__)
         // ----------- ca_char4_t / uint32_t path (AVX2) ------------
-        const __m256i target = _mm256_set1_epi32(_Val);
+        const __m256i target = _mm256_set1_epi32(Val);
 
         while (i - 8 >= 0) {
             i -= 8;
 
-            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_Buf + i));
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Buf + i));
             const __m256i cmp = _mm256_cmpeq_epi32(chunk, target);
             const ca_int_t mask = _mm256_movemask_ps(_mm256_castsi256_ps(cmp));  // 8-bit result
 
             if (mask != 0) {
                 for (int j = 0; j < 8; ++j) {
-                    if (_Buf[i + j] == _Val) {
-                        return _Buf + i + j;
+                    if (Buf[i + j] == Val) {
+                        return Buf + i + j;
                     }
                 }
             }
@@ -590,11 +591,89 @@ rfind_char(const CheckedIndexer<char_type, false> str, const ca_size_t n, const
     return false;
 }
 
+namespace internal {
+template <typename char_type>
+inline ca_size_t count_simd(const char_type* Buf, char_type Val, const ca_size_t MaxCount, const ca_size_t MaxHits) {
+    static_assert(sizeof(char_type) == 1 || sizeof(char_type) == 2 || sizeof(char_type) == 4,
+            "Only 1-byte, 2-byte or 4-byte types supported.");
+
+    ca_size_t i = 0;
+    ca_size_t count = 0;
+
+    if constexpr (sizeof(char_type) == 1) {
+#if defined(__AVX2__)
+        // ----------- ca_char_t / uint8_t path (AVX2) ------------
+        const __m256i target = _mm256_set1_epi8(static_cast<char>(Val));
+
+        while (i + 32 <= MaxCount && count < MaxHits) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Buf + i));
+            const __m256i cmp = _mm256_cmpeq_epi8(chunk, target);
+            count += std::popcount(static_cast<ca_uint32_t>(_mm256_movemask_epi8(cmp)));  // 32-bit result
+            i += 32;
+        }
+#endif
+        // ----------- ca_char_t / uint8_t path (SSE2) ------------
+        const __m128i target16 = _mm_set1_epi8(static_cast<char>(Val));
+
+        while (i + 16 <= MaxCount && count < MaxHits) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buf + i));
+            const __m128i cmp = _mm_cmpeq_epi8(chunk, target16);
+            count += std::popcount(static_cast<ca_uint32_t>(_mm_movemask_epi8(cmp)));  // 16-bit result
+            i += 16;
+        }
+    }
+    else if constexpr (sizeof(char_type) == 2) {
+        // ----------- ca_char2_t / uint16_t path (SSE2) ------------
+        const __m128i target = _mm_set1_epi16(static_cast<short>(Val));
+
+        while (i + 8 <= MaxCount && count < MaxHits) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buf + i));
+            const __m128i cmp = _mm_cmpeq_epi16(chunk, target);
+            // 2 mask bits per matching element
+            count += std::popcount(static_cast<ca_uint32_t>(_mm_movemask_epi8(cmp))) / 2;
+            i += 8;
+        }
+    }
+    else {
+        // ----------- ca_char4_t / uint32_t path (SSE2) ------------
+        const __m128i target = _mm_set1_epi32(static_cast<int>(Val));
+
+        while (i + 4 <= MaxCount && count < MaxHits) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buf + i));
+            const __m128i cmp = _mm_cmpeq_epi32(chunk, target);
+            count += std::popcount(static_cast<ca_uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(cmp))));  // 4-bit result
+            i += 4;
+        }
+    }
+
+    // ----------- Tail fallback (scalar) ------------
+    for (; i < MaxCount && count < MaxHits; ++i) {
+        if (Buf[i] == Val) {
+            ++count;
+        }
+    }
+
+    return count < MaxHits ? count : MaxHits;
+}
+}
+
 template <typename char_type, bool from_right>
 static inline ca_size_t
 count_char(const CheckedIndexer<char_type, from_right> str, const ca_size_t n,
            const char_type ch, const ca_size_t max_count)
 {
+    constexpr bool use_simd = (sizeof(char_type) == 1 || sizeof(char_type) == 2 || sizeof(char_type) == 4);
+
+    // The count is capped by `max_count`, so its value does not depend on the
+    // scan direction and the whole range can be counted forward in blocks.
+    if (n > MEMCHR_CUT_OFF && n <= str.get_length() && use_simd) {
+        const char_type *start = str.get_buffer();
+        if constexpr (from_right) {
+            start -= (n - 1);
+        }
+        return internal::count_simd<char_type>(start, ch, n, max_count);
+    }
+
     ca_size_t count = 0;
     for (ca_size_t i = 0; i < n; i++) {
         if (str[i] == ch) {
@@ -0,0 +1,747 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_string/ca_hash.cpp
+//
+// @file
+// @brief Implements the XXH3 64-bit and 128-bit hashes, modified from xxHash.
+// ================================
+
+#include "ca_hash.h"
+
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <emmintrin.h>  // SSE2
+#ifdef __AVX2__
+#include <immintrin.h>  // AVX2
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>     // _umul128
+#endif
+
+namespace ca::ca_string {
+
+namespace {
+/*******************************************************************************/
+// The hash below is a port of XXH3 from xxHash 0.8
+// License: BSD 2-Clause
+// Copyright (c) 2012-2021 Yann Collet
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above
+//   copyright notice, this list of conditions and the following disclaimer
+//   in the documentation and/or other materials provided with the
+//   distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+constexpr ca_uint32_t PRIME32_1 = 0x9E3779B1U;
+constexpr ca_uint32_t PRIME32_2 = 0x85EBCA77U;
+constexpr ca_uint32_t PRIME32_3 = 0xC2B2AE3DU;
+
+constexpr ca_uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr ca_uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr ca_uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr ca_uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr ca_uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+constexpr ca_uint64_t PRIME_MX1 = 0x165667919E3779F9ULL;
+constexpr ca_uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+constexpr ca_size_t STRIPE_LEN = 64;
+constexpr ca_size_t ACC_NB = STRIPE_LEN / sizeof(ca_uint64_t);
+constexpr ca_size_t SECRET_CONSUME_RATE = 8;
+constexpr ca_size_t SECRET_SIZE_MIN = 136;
+constexpr ca_size_t SECRET_DEFAULT_SIZE = 192;
+constexpr ca_size_t SECRET_LASTACC_START = 7;
+constexpr ca_size_t SECRET_MERGEACCS_START = 11;
+constexpr ca_size_t MIDSIZE_MAX = 240;
+constexpr ca_size_t MIDSIZE_STARTOFFSET = 3;
+constexpr ca_size_t MIDSIZE_LASTOFFSET = 17;
+
+// Pseudorandom secret taken directly from FARSH
+alignas(64) constexpr ca_char_t kSecret[SECRET_DEFAULT_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// ----------------------------
+// Primitives (little-endian reads)
+// ----------------------------
+
+inline ca_uint32_t
+read32(const ca_char_t *p) {
+    ca_uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline ca_uint64_t
+read64(const ca_char_t *p) {
+    ca_uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void
+write64(ca_char_t *p, const ca_uint64_t v) {
+    memcpy(p, &v, sizeof(v));
+}
+
+inline ca_hash128_t
+mult64to128(const ca_uint64_t lhs, const ca_uint64_t rhs) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    ca_uint64_t high;
+    const ca_uint64_t low = _umul128(lhs, rhs, &high);
+    return { low, high };
+#else
+    const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+    return { static_cast<ca_uint64_t>(product), static_cast<ca_uint64_t>(product >> 64) };
+#endif
+}
+
+inline ca_uint64_t
+mul128_fold64(const ca_uint64_t lhs, const ca_uint64_t rhs) {
+    const ca_hash128_t product = mult64to128(lhs, rhs);
+    return product.low ^ product.high;
+}
+
+inline ca_uint64_t
+xorshift64(const ca_uint64_t v, const int shift) {
+    return v ^ (v >> shift);
+}
+
+inline ca_uint64_t
+xxh64_avalanche(ca_uint64_t h) {
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline ca_uint64_t
+avalanche(ca_uint64_t h) {
+    h = xorshift64(h, 37);
+    h *= PRIME_MX1;
+    return xorshift64(h, 32);
+}
+
+inline ca_uint64_t
+rrmxmx(ca_uint64_t h, const ca_uint64_t len) {
+    h ^= std::rotl(h, 49) ^ std::rotl(h, 24);
+    h *= PRIME_MX2;
+    h ^= (h >> 35) + len;
+    h *= PRIME_MX2;
+    return xorshift64(h, 28);
+}
+
+// ----------------------------
+// Short inputs, 64 bits
+// ----------------------------
+
+inline ca_uint64_t
+len_1to3_64b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, const ca_uint64_t seed) {
+    const ca_char_t c1 = input[0];
+    const ca_char_t c2 = input[len >> 1];
+    const ca_char_t c3 = input[len - 1];
+    const ca_uint32_t combined = (static_cast<ca_uint32_t>(c1) << 16) | (static_cast<ca_uint32_t>(c2) << 24) |
+                                 static_cast<ca_uint32_t>(c3) | (static_cast<ca_uint32_t>(len) << 8);
+    const ca_uint64_t bitflip = (read32(secret) ^ read32(secret + 4)) + seed;
+    return xxh64_avalanche(combined ^ bitflip);
+}
+
+inline ca_uint64_t
+len_4to8_64b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, ca_uint64_t seed) {
+    seed ^= static_cast<ca_uint64_t>(std::byteswap(static_cast<ca_uint32_t>(seed))) << 32;
+    const ca_uint32_t input1 = read32(input);
+    const ca_uint32_t input2 = read32(input + len - 4);
+    const ca_uint64_t bitflip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+    const ca_uint64_t input64 = input2 + (static_cast<ca_uint64_t>(input1) << 32);
+    return rrmxmx(input64 ^ bitflip, len);
+}
+
+inline ca_uint64_t
+len_9to16_64b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, const ca_uint64_t seed) {
+    const ca_uint64_t bitflip1 = (read64(secret + 24) ^ read64(secret + 32)) + seed;
+    const ca_uint64_t bitflip2 = (read64(secret + 40) ^ read64(secret + 48)) - seed;
+    const ca_uint64_t input_lo = read64(input) ^ bitflip1;
+    const ca_uint64_t input_hi = read64(input + len - 8) ^ bitflip2;
+    const ca_uint64_t acc = len + std::byteswap(input_lo) + input_hi + mul128_fold64(input_lo, input_hi);
+    return avalanche(acc);
+}
+
+inline ca_uint64_t
+len_0to16_64b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, const ca_uint64_t seed) {
+    if (len > 8) {
+        return len_9to16_64b(input, len, secret, seed);
+    }
+    if (len >= 4) {
+        return len_4to8_64b(input, len, secret, seed);
+    }
+    if (len > 0) {
+        return len_1to3_64b(input, len, secret, seed);
+    }
+    return xxh64_avalanche(seed ^ (read64(secret + 56) ^ read64(secret + 64)));
+}
+
+inline ca_uint64_t
+mix16b(const ca_char_t *input, const ca_char_t *secret, const ca_uint64_t seed) {
+    return mul128_fold64(read64(input) ^ (read64(secret) + seed),
+                         read64(input + 8) ^ (read64(secret + 8) - seed));
+}
+
+inline ca_uint64_t
+len_17to128_64b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, const ca_uint64_t seed) {
+    ca_uint64_t acc = len * PRIME64_1;
+
+    if (len > 32) {
+        if (len > 64) {
+            if (len > 96) {
+                acc += mix16b(input + 48, secret + 96, seed);
+                acc += mix16b(input + len - 64, secret + 112, seed);
+            }
+            acc += mix16b(input + 32, secret + 64, seed);
+            acc += mix16b(input + len - 48, secret + 80, seed);
+        }
+        acc += mix16b(input + 16, secret + 32, seed);
+        acc += mix16b(input + len - 32, secret + 48, seed);
+    }
+    acc += mix16b(input, secret, seed);
+    acc += mix16b(input + len - 16, secret + 16, seed);
+
+    return avalanche(acc);
+}
+
+inline ca_uint64_t
+len_129to240_64b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, const ca_uint64_t seed) {
+    ca_uint64_t acc = len * PRIME64_1;
+    const ca_size_t num_rounds = len / 16;
+
+    for (ca_size_t i = 0; i < 8; ++i) {
+        acc += mix16b(input + 16 * i, secret + 16 * i, seed);
+    }
+    ca_uint64_t acc_end = mix16b(input + len - 16, secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET, seed);
+    acc = avalanche(acc);
+
+    for (ca_size_t i = 8; i < num_rounds; ++i) {
+        acc_end += mix16b(input + 16 * i, secret + 16 * (i - 8) + MIDSIZE_STARTOFFSET, seed);
+    }
+    return avalanche(acc + acc_end);
+}
+
+// ----------------------------
+// Short inputs, 128 bits
+// ----------------------------
+
+inline ca_hash128_t
+len_1to3_128b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, const ca_uint64_t seed) {
+    const ca_char_t c1 = input[0];
+    const ca_char_t c2 = input[len >> 1];
+    const ca_char_t c3 = input[len - 1];
+    const ca_uint32_t combinedl = (static_cast<ca_uint32_t>(c1) << 16) | (static_cast<ca_uint32_t>(c2) << 24) |
+                                  static_cast<ca_uint32_t>(c3) | (static_cast<ca_uint32_t>(len) << 8);
+    const ca_uint32_t combinedh = std::rotl(std::byteswap(combinedl), 13);
+    const ca_uint64_t bitflipl = (read32(secret) ^ read32(secret + 4)) + seed;
+    const ca_uint64_t bitfliph = (read32(secret + 8) ^ read32(secret + 12)) - seed;
+    return { xxh64_avalanche(combinedl ^ bitflipl), xxh64_avalanche(combinedh ^ bitfliph) };
+}
+
+inline ca_hash128_t
+len_4to8_128b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, ca_uint64_t seed) {
+    seed ^= static_cast<ca_uint64_t>(std::byteswap(static_cast<ca_uint32_t>(seed))) << 32;
+    const ca_uint32_t input_lo = read32(input);
+    const ca_uint32_t input_hi = read32(input + len - 4);
+    const ca_uint64_t input_64 = input_lo + (static_cast<ca_uint64_t>(input_hi) << 32);
+    const ca_uint64_t bitflip = (read64(secret + 16) ^ read64(secret + 24)) + seed;
+    const ca_uint64_t keyed = input_64 ^ bitflip;
+
+    ca_hash128_t m128 = mult64to128(keyed, PRIME64_1 + (len << 2));
+    m128.high += m128.low << 1;
+    m128.low ^= m128.high >> 3;
+    m128.low = xorshift64(m128.low, 35);
+    m128.low *= PRIME_MX2;
+    m128.low = xorshift64(m128.low, 28);
+    m128.high = avalanche(m128.high);
+    return m128;
+}
+
+inline ca_hash128_t
+len_9to16_128b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, const ca_uint64_t seed) {
+    const ca_uint64_t bitflipl = (read64(secret + 32) ^ read64(secret + 40)) - seed;
+    const ca_uint64_t bitfliph = (read64(secret + 48) ^ read64(secret + 56)) + seed;
+    const ca_uint64_t input_lo = read64(input);
+    ca_uint64_t input_hi = read64(input + len - 8);
+
+    ca_hash128_t m128 = mult64to128(input_lo ^ input_hi ^ bitflipl, PRIME64_1);
+    m128.low += static_cast<ca_uint64_t>(len - 1) << 54;
+    input_hi ^= bitfliph;
+    m128.high += input_hi + static_cast<ca_uint64_t>(static_cast<ca_uint32_t>(input_hi)) * (PRIME32_2 - 1);
+    m128.low ^= std::byteswap(m128.high);
+
+    ca_hash128_t h128 = mult64to128(m128.low, PRIME64_2);
+    h128.high += m128.high * PRIME64_2;
+    h128.low = avalanche(h128.low);
+    h128.high = avalanche(h128.high);
+    return h128;
+}
+
+inline ca_hash128_t
+len_0to16_128b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, const ca_uint64_t seed) {
+    if (len > 8) {
+        return len_9to16_128b(input, len, secret, seed);
+    }
+    if (len >= 4) {
+        return len_4to8_128b(input, len, secret, seed);
+    }
+    if (len > 0) {
+        return len_1to3_128b(input, len, secret, seed);
+    }
+    const ca_uint64_t bitflipl = read64(secret + 64) ^ read64(secret + 72);
+    const ca_uint64_t bitfliph = read64(secret + 80) ^ read64(secret + 88);
+    return { xxh64_avalanche(seed ^ bitflipl), xxh64_avalanche(seed ^ bitfliph) };
+}
+
+inline ca_hash128_t
+mix32b(ca_hash128_t acc, const ca_char_t *input_1, const ca_char_t *input_2,
+       const ca_char_t *secret, const ca_uint64_t seed) {
+    acc.low += mix16b(input_1, secret, seed);
+    acc.low ^= read64(input_2) + read64(input_2 + 8);
+    acc.high += mix16b(input_2, secret + 16, seed);
+    acc.high ^= read64(input_1) + read64(input_1 + 8);
+    return acc;
+}
+
+inline ca_hash128_t
+finalize_mid_128b(const ca_hash128_t acc, const ca_size_t len, const ca_uint64_t seed) {
+    ca_hash128_t h128;
+    h128.low = acc.low + acc.high;
+    h128.high = acc.low * PRIME64_1 + acc.high * PRIME64_4 + (len - seed) * PRIME64_2;
+    h128.low = avalanche(h128.low);
+    h128.high = 0 - avalanche(h128.high);
+    return h128;
+}
+
+inline ca_hash128_t
+len_17to128_128b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, const ca_uint64_t seed) {
+    ca_hash128_t acc = { len * PRIME64_1, 0 };
+
+    if (len > 32) {
+        if (len > 64) {
+            if (len > 96) {
+                acc = mix32b(acc, input + 48, input + len - 64, secret + 96, seed);
+            }
+            acc = mix32b(acc, input + 32, input + len - 48, secret + 64, seed);
+        }
+        acc = mix32b(acc, input + 16, input + len - 32, secret + 32, seed);
+    }
+    acc = mix32b(acc, input, input + len - 16, secret, seed);
+
+    return finalize_mid_128b(acc, len, seed);
+}
+
+inline ca_hash128_t
+len_129to240_128b(const ca_char_t *input, const ca_size_t len, const ca_char_t *secret, const ca_uint64_t seed) {
+    ca_hash128_t acc = { len * PRIME64_1, 0 };
+
+    for (ca_size_t i = 32; i < 160; i += 32) {
+        acc = mix32b(acc, input + i - 32, input + i - 16, secret + i - 32, seed);
+    }
+    acc.low = avalanche(acc.low);
+    acc.high = avalanche(acc.high);
+
+    for (ca_size_t i = 160; i <= len; i += 32) {
+        acc = mix32b(acc, input + i - 32, input + i - 16, secret + MIDSIZE_STARTOFFSET + i - 160, seed);
+    }
+    acc = mix32b(acc, input + len - 16, input + len - 32,
+                 secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET - 16, 0 - seed);
+
+    return finalize_mid_128b(acc, len, seed);
+}
+
+// ----------------------------
+// Long inputs
+// ----------------------------
+
+/**
+ * @brief Accumulates one 64-byte stripe into the 8 accumulators.
+ */
+inline void
+accumulate_512(ca_uint64_t *acc, const ca_char_t *input, const ca_char_t *secret) {
+#if defined(__AVX2__)
+    for (ca_size_t i = 0; i < STRIPE_LEN / sizeof(__m256i); ++i) {
+        const __m256i data_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input) + i);
+        const __m256i key_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i);
+        const __m256i data_key = _mm256_xor_si256(data_vec, key_vec);
+        const __m256i data_key_lo = _mm256_srli_epi64(data_key, 32);
+        const __m256i product = _mm256_mul_epu32(data_key, data_key_lo);
+        const __m256i data_swap = _mm256_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+        __m256i *xacc = reinterpret_cast<__m256i*>(acc) + i;
+        _mm256_store_si256(xacc, _mm256_add_epi64(product, _mm256_add_epi64(_mm256_load_si256(xacc), data_swap)));
+    }
+#else
+    for (ca_size_t i = 0; i < STRIPE_LEN / sizeof(__m128i); ++i) {
+        const __m128i data_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input) + i);
+        const __m128i key_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+        const __m128i data_key = _mm_xor_si128(data_vec, key_vec);
+        const __m128i data_key_lo = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+        const __m128i product = _mm_mul_epu32(data_key, data_key_lo);
+        const __m128i data_swap = _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128i *xacc = reinterpret_cast<__m128i*>(acc) + i;
+        _mm_store_si128(xacc, _mm_add_epi64(product, _mm_add_epi64(_mm_load_si128(xacc), data_swap)));
+    }
+#endif
+}
+
+/**
+ * @brief Scrambles the accumulators at the end of a block.
+ */
+inline void
+scramble_acc(ca_uint64_t *acc, const ca_char_t *secret) {
+#if defined(__AVX2__)
+    const __m256i prime32 = _mm256_set1_epi32(static_cast<int>(PRIME32_1));
+    for (ca_size_t i = 0; i < STRIPE_LEN / sizeof(__m256i); ++i) {
+        __m256i *xacc = reinterpret_cast<__m256i*>(acc) + i;
+        const __m256i acc_vec = _mm256_load_si256(xacc);
+        const __m256i data_vec = _mm256_xor_si256(acc_vec, _mm256_srli_epi64(acc_vec, 47));
+        const __m256i key_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i);
+        const __m256i data_key = _mm256_xor_si256(data_vec, key_vec);
+        const __m256i data_key_hi = _mm256_srli_epi64(data_key, 32);
+        const __m256i prod_lo = _mm256_mul_epu32(data_key, prime32);
+        const __m256i prod_hi = _mm256_mul_epu32(data_key_hi, prime32);
+        _mm256_store_si256(xacc, _mm256_add_epi64(prod_lo, _mm256_slli_epi64(prod_hi, 32)));
+    }
+#else
+    const __m128i prime32 = _mm_set1_epi32(static_cast<int>(PRIME32_1));
+    for (ca_size_t i = 0; i < STRIPE_LEN / sizeof(__m128i); ++i) {
+        __m128i *xacc = reinterpret_cast<__m128i*>(acc) + i;
+        const __m128i acc_vec = _mm_load_si128(xacc);
+        const __m128i data_vec = _mm_xor_si128(acc_vec, _mm_srli_epi64(acc_vec, 47));
+        const __m128i key_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+        const __m128i data_key = _mm_xor_si128(data_vec, key_vec);
+        const __m128i data_key_hi = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+        const __m128i prod_lo = _mm_mul_epu32(data_key, prime32);
+        const __m128i prod_hi = _mm_mul_epu32(data_key_hi, prime32);
+        _mm_store_si128(xacc, _mm_add_epi64(prod_lo, _mm_slli_epi64(prod_hi, 32)));
+    }
+#endif
+}
+
+inline void
+accumulate(ca_uint64_t *acc, const ca_char_t *input, const ca_char_t *secret, const ca_size_t num_stripes) {
+    for (ca_size_t n = 0; n < num_stripes; ++n) {
+        accumulate_512(acc, input + n * STRIPE_LEN, secret + n * SECRET_CONSUME_RATE);
+    }
+}
+
+inline void
+init_acc(ca_uint64_t *acc) {
+    acc[0] = PRIME32_3;
+    acc[1] = PRIME64_1;
+    acc[2] = PRIME64_2;
+    acc[3] = PRIME64_3;
+    acc[4] = PRIME64_4;
+    acc[5] = PRIME32_2;
+    acc[6] = PRIME64_5;
+    acc[7] = PRIME32_1;
+}
+
+inline void
+init_custom_secret(ca_char_t *custom_secret, const ca_uint64_t seed) {
+    for (ca_size_t i = 0; i < SECRET_DEFAULT_SIZE / 16; ++i) {
+        write64(custom_secret + 16 * i, read64(kSecret + 16 * i) + seed);
+        write64(custom_secret + 16 * i + 8, read64(kSecret + 16 * i + 8) - seed);
+    }
+}
+
+void
+hash_long_loop(ca_uint64_t *acc, const ca_char_t *input, const ca_size_t len,
+               const ca_char_t *secret, const ca_size_t secret_size) {
+    const ca_size_t stripes_per_block = (secret_size - STRIPE_LEN) / SECRET_CONSUME_RATE;
+    const ca_size_t block_len = STRIPE_LEN * stripes_per_block;
+    const ca_size_t num_blocks = (len - 1) / block_len;
+
+    for (ca_size_t n = 0; n < num_blocks; ++n) {
+        accumulate(acc, input + n * block_len, secret, stripes_per_block);
+        scramble_acc(acc, secret + secret_size - STRIPE_LEN);
+    }
+
+    // Last partial block, then the last stripe (overlapping the previous one)
+    const ca_size_t num_stripes = ((len - 1) - block_len * num_blocks) / STRIPE_LEN;
+    accumulate(acc, input + num_blocks * block_len, secret, num_stripes);
+    accumulate_512(acc, input + len - STRIPE_LEN, secret + secret_size - STRIPE_LEN - SECRET_LASTACC_START);
+}
+
+inline ca_uint64_t
+mix2accs(const ca_uint64_t *acc, const ca_char_t *secret) {
+    return mul128_fold64(acc[0] ^ read64(secret), acc[1] ^ read64(secret + 8));
+}
+
+ca_uint64_t
+merge_accs(const ca_uint64_t *acc, const ca_char_t *secret, const ca_uint64_t start) {
+    ca_uint64_t result = start;
+    for (ca_size_t i = 0; i < 4; ++i) {
+        result += mix2accs(acc + 2 * i, secret + 16 * i);
+    }
+    return avalanche(result);
+}
+
+ca_uint64_t
+merge_accs_64b(const ca_uint64_t *acc, const ca_char_t *secret, const ca_uint64_t len) {
+    return merge_accs(acc, secret + SECRET_MERGEACCS_START, len * PRIME64_1);
+}
+
+ca_hash128_t
+merge_accs_128b(const ca_uint64_t *acc, const ca_char_t *secret, const ca_size_t secret_size, const ca_uint64_t len) {
+    return { merge_accs(acc, secret + SECRET_MERGEACCS_START, len * PRIME64_1),
+             merge_accs(acc, secret + secret_size - STRIPE_LEN - SECRET_MERGEACCS_START, ~(len * PRIME64_2)) };
+}
+
+/*******************************************************************************/
+
+/**
+ * @brief Returns the secret for long inputs, deriving it from the seed if needed.
+ */
+inline const ca_char_t *
+long_secret(const ca_uint64_t seed, ca_char_t *custom_secret) {
+    if (seed == 0) {
+        return kSecret;
+    }
+    init_custom_secret(custom_secret, seed);
+    return custom_secret;
+}
+
+}
+
+// ----------------------------
+// One-shot hashing
+// ----------------------------
+
+ca_uint64_t
+ca_hash64(const ca_char_t *data, const ca_size_t size, const ca_uint64_t seed) {
+    assert(data != nullptr || size == 0);
+
+    if (size <= 16) {
+        return len_0to16_64b(data, size, kSecret, seed);
+    }
+    if (size <= 128) {
+        return len_17to128_64b(data, size, kSecret, seed);
+    }
+    if (size <= MIDSIZE_MAX) {
+        return len_129to240_64b(data, size, kSecret, seed);
+    }
+
+    alignas(64) ca_uint64_t acc[ACC_NB];
+    alignas(64) ca_char_t custom_secret[SECRET_DEFAULT_SIZE];
+    const ca_char_t *secret = long_secret(seed, custom_secret);
+
+    init_acc(acc);
+    hash_long_loop(acc, data, size, secret, SECRET_DEFAULT_SIZE);
+    return merge_accs_64b(acc, secret, size);
+}
+
+ca_hash128_t
+ca_hash128(const ca_char_t *data, const ca_size_t size, const ca_uint64_t seed) {
+    assert(data != nullptr || size == 0);
+
+    if (size <= 16) {
+        return len_0to16_128b(data, size, kSecret, seed);
+    }
+    if (size <= 128) {
+        return len_17to128_128b(data, size, kSecret, seed);
+    }
+    if (size <= MIDSIZE_MAX) {
+        return len_129to240_128b(data, size, kSecret, seed);
+    }
+
+    alignas(64) ca_uint64_t acc[ACC_NB];
+    alignas(64) ca_char_t custom_secret[SECRET_DEFAULT_SIZE];
+    const ca_char_t *secret = long_secret(seed, custom_secret);
+
+    init_acc(acc);
+    hash_long_loop(acc, data, size, secret, SECRET_DEFAULT_SIZE);
+    return merge_accs_128b(acc, secret, SECRET_DEFAULT_SIZE, size);
+}
+
+// ----------------------------
+// Streaming hashing
+// ----------------------------
+
+namespace {
+
+constexpr ca_size_t SECRET_LIMIT = SECRET_DEFAULT_SIZE - STRIPE_LEN;
+constexpr ca_size_t STRIPES_PER_BLOCK = SECRET_LIMIT / SECRET_CONSUME_RATE;
+
+/**
+ * @brief Accumulates whole stripes, scrambling at every block boundary.
+ *
+ * @return Pointer past the consumed input.
+ */
+const ca_char_t *
+consume_stripes(ca_uint64_t *acc, ca_size_t *stripes_so_far,
+                const ca_char_t *input, ca_size_t num_stripes, const ca_char_t *secret) {
+    const ca_char_t *initial_secret = secret + *stripes_so_far * SECRET_CONSUME_RATE;
+
+    if (num_stripes >= STRIPES_PER_BLOCK - *stripes_so_far) {
+        ca_size_t stripes_this_iter = STRIPES_PER_BLOCK - *stripes_so_far;
+        do {
+            accumulate(acc, input, initial_secret, stripes_this_iter);
+            scramble_acc(acc, secret + SECRET_LIMIT);
+            input += stripes_this_iter * STRIPE_LEN;
+            num_stripes -= stripes_this_iter;
+            stripes_this_iter = STRIPES_PER_BLOCK;
+            initial_secret = secret;
+        } while (num_stripes >= STRIPES_PER_BLOCK);
+        *stripes_so_far = 0;
+    }
+
+    if (num_stripes > 0) {
+        accumulate(acc, input, initial_secret, num_stripes);
+        input += num_stripes * STRIPE_LEN;
+        *stripes_so_far += num_stripes;
+    }
+
+    return input;
+}
+
+}
+
+ca_hash_state::ca_hash_state(const ca_uint64_t seed) {
+    reset(seed);
+}
+
+void
+ca_hash_state::reset(const ca_uint64_t seed) {
+    init_acc(acc);
+    buffered_size = 0;
+    stripes_so_far = 0;
+    total_len = 0;
+    this->seed = seed;
+    if (seed != 0) {
+        init_custom_secret(custom_secret, seed);
+    }
+}
+
+const ca_char_t *
+ca_hash_state::secret() const {
+    return seed == 0 ? kSecret : custom_secret;
+}
+
+void
+ca_hash_state::update(const ca_char_t *data, const ca_size_t size) {
+    assert(data != nullptr || size == 0);
+
+    if (size == 0) {
+        return;
+    }
+
+    const ca_char_t *input = data;
+    const ca_char_t *const end = data + size;
+    const ca_char_t *const sec = secret();
+    total_len += size;
+
+    // Small updates are only buffered
+    if (size <= BUFFER_SIZE - buffered_size) {
+        memcpy(buffer + buffered_size, input, size);
+        buffered_size += size;
+        return;
+    }
+
+    // Complete and consume the buffer. The last stripe of the input is always
+    // kept buffered, since the digest needs it.
+    if (buffered_size > 0) {
+        const ca_size_t load_size = BUFFER_SIZE - buffered_size;
+        memcpy(buffer + buffered_size, input, load_size);
+        input += load_size;
+        consume_stripes(acc, &stripes_so_far, buffer, BUFFER_SIZE / STRIPE_LEN, sec);
+        buffered_size = 0;
+    }
+
+    // Consume large inputs in place
+    if (static_cast<ca_size_t>(end - input) > BUFFER_SIZE) {
+        const ca_size_t num_stripes = static_cast<ca_size_t>(end - 1 - input) / STRIPE_LEN;
+        input = consume_stripes(acc, &stripes_so_far, input, num_stripes, sec);
+        // Keep the last consumed stripe for a digest of a short remainder
+        memcpy(buffer + BUFFER_SIZE - STRIPE_LEN, input - STRIPE_LEN, STRIPE_LEN);
+    }
+
+    memcpy(buffer, input, static_cast<ca_size_t>(end - input));
+    buffered_size = static_cast<ca_size_t>(end - input);
+}
+
+void
+ca_hash_state::digest_long(ca_uint64_t *acc_out) const {
+    const ca_char_t *const sec = secret();
+    alignas(64) ca_char_t last_stripe[STRIPE_LEN];
+    const ca_char_t *last_stripe_ptr;
+
+    memcpy(acc_out, acc, sizeof(acc));
+    if (buffered_size >= STRIPE_LEN) {
+        const ca_size_t num_stripes = (buffered_size - 1) / STRIPE_LEN;
+        ca_size_t stripes = stripes_so_far;
+        consume_stripes(acc_out, &stripes, buffer, num_stripes, sec);
+        last_stripe_ptr = buffer + buffered_size - STRIPE_LEN;
+    }
+    else {
+        // The last stripe spans the end of the previous buffer content
+        const ca_size_t catchup_size = STRIPE_LEN - buffered_size;
+        memcpy(last_stripe, buffer + BUFFER_SIZE - catchup_size, catchup_size);
+        memcpy(last_stripe + catchup_size, buffer, buffered_size);
+        last_stripe_ptr = last_stripe;
+    }
+
+    accumulate_512(acc_out, last_stripe_ptr, sec + SECRET_LIMIT - SECRET_LASTACC_START);
+}
+
+ca_uint64_t
+ca_hash_state::digest64() const {
+    if (total_len > MIDSIZE_MAX) {
+        alignas(64) ca_uint64_t acc_out[ACC_NB];
+        digest_long(acc_out);
+        return merge_accs_64b(acc_out, secret(), total_len);
+    }
+    return ca_hash64(buffer, static_cast<ca_size_t>(total_len), seed);
+}
+
+ca_hash128_t
+ca_hash_state::digest128() const {
+    if (total_len > MIDSIZE_MAX) {
+        alignas(64) ca_uint64_t acc_out[ACC_NB];
+        digest_long(acc_out);
+        return merge_accs_128b(acc_out, secret(), SECRET_DEFAULT_SIZE, total_len);
+    }
+    return ca_hash128(buffer, static_cast<ca_size_t>(total_len), seed);
+}
+
+ca_uint64_t
+ca_hash_state::total_size() const {
+    return total_len;
+}
+
+}
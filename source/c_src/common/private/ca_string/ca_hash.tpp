@@ -0,0 +1,37 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_string/ca_hash.tpp
+//
+// @file
+// @brief Implements the `ca_buffer` overloads of the hash functions.
+// ================================
+#pragma once
+
+namespace ca::ca_string {
+
+template <ca_encoding_t encoding>
+inline ca_uint64_t
+ca_hash64(const ca_buffer<encoding> buffer, const ca_uint64_t seed) {
+    if (buffer.empty()) {
+        return ca_hash64(nullptr, 0, seed);
+    }
+    return ca_hash64(buffer.buf, static_cast<ca_size_t>(buffer.after - buffer.buf), seed);
+}
+
+template <ca_encoding_t encoding>
+inline ca_hash128_t
+ca_hash128(const ca_buffer<encoding> buffer, const ca_uint64_t seed) {
+    if (buffer.empty()) {
+        return ca_hash128(nullptr, 0, seed);
+    }
+    return ca_hash128(buffer.buf, static_cast<ca_size_t>(buffer.after - buffer.buf), seed);
+}
+
+template <ca_encoding_t encoding>
+inline void
+ca_hash_state::update(const ca_buffer<encoding> buffer) {
+    if (!buffer.empty()) {
+        update(buffer.buf, static_cast<ca_size_t>(buffer.after - buffer.buf));
+    }
+}
+
+}
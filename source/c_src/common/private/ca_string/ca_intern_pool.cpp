@@ -0,0 +1,244 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_string/ca_intern_pool.cpp
+//
+// @file
+// @brief Implements `ca_intern_pool` and `ca_sharded_intern_pool`.
+// ================================
+
+#include "ca_intern_pool.h"
+#include "ca_hash.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+
+namespace ca::ca_string {
+
+namespace {
+
+constexpr ca_size_t INITIAL_SLOTS = 64;
+
+/**
+ * @brief Returns the home slot of a hash in a power of two sized table.
+ */
+inline ca_size_t
+slot_of(const ca_uint64_t hash, const ca_size_t mask) {
+    return static_cast<ca_size_t>(hash) & mask;
+}
+
+}
+
+// ----------------------------
+// ca_intern_pool
+// ----------------------------
+
+ca_intern_pool::ca_intern_pool(const ca_size_t chunk_size)
+    : chunk_cur(nullptr), chunk_left(0),
+      chunk_size(ca_math::ca_max<ca_size_t>(chunk_size, 64)), arena_bytes(0),
+      slots(INITIAL_SLOTS, INVALID_ID) {
+}
+
+ca_uint64_t
+ca_intern_pool::hash(const ca_char_t *str, const ca_size_t size) {
+    return ca_hash64(str, size);
+}
+
+ca_intern_pool::id_type
+ca_intern_pool::intern(const ca_char_t *str, const ca_size_t size) {
+    assert(str != nullptr || size == 0);
+    return intern_hashed(str, size, hash(str, size));
+}
+
+ca_intern_pool::id_type
+ca_intern_pool::find(const ca_char_t *str, const ca_size_t size) const {
+    assert(str != nullptr || size == 0);
+    return find_hashed(str, size, hash(str, size));
+}
+
+ca_intern_pool::id_type
+ca_intern_pool::find_hashed(const ca_char_t *str, const ca_size_t size, const ca_uint64_t hash) const {
+    const ca_size_t mask = slots.size() - 1;
+
+    for (ca_size_t i = slot_of(hash, mask); ; i = (i + 1) & mask) {
+        const id_type id = slots[i];
+        if (id == INVALID_ID) {
+            return INVALID_ID;
+        }
+
+        const entry &e = entries[id];
+        if (e.hash == hash && e.size == size && (size == 0 || memcmp(e.data, str, size) == 0)) {
+            return id;
+        }
+    }
+}
+
+ca_intern_pool::id_type
+ca_intern_pool::intern_hashed(const ca_char_t *str, const ca_size_t size, const ca_uint64_t hash) {
+    ca_size_t mask = slots.size() - 1;
+    ca_size_t i = slot_of(hash, mask);
+
+    for (; slots[i] != INVALID_ID; i = (i + 1) & mask) {
+        const entry &e = entries[slots[i]];
+        if (e.hash == hash && e.size == size && (size == 0 || memcmp(e.data, str, size) == 0)) {
+            return slots[i];
+        }
+    }
+
+    // INVALID_ID is reserved for empty slots
+    assert(entries.size() < static_cast<ca_size_t>(INVALID_ID));
+
+    const auto id = static_cast<id_type>(entries.size());
+    entries.push_back({ allocate(str, size), size, hash });
+
+    // Keep the load factor at most 1/2
+    if (entries.size() * 2 > slots.size()) {
+        grow();
+    }
+    else {
+        slots[i] = id;
+    }
+
+    return id;
+}
+
+ca_char_t *
+ca_intern_pool::allocate(const ca_char_t *str, const ca_size_t size) {
+    const ca_size_t needed = size + 1;
+
+    if (needed > chunk_left) {
+        // Oversized strings get a chunk of their own, the current one stays in use
+        if (needed > chunk_size / 4) {
+            chunks.push_back(std::make_unique<ca_char_t[]>(needed));
+            arena_bytes += needed;
+            ca_char_t *data = chunks.back().get();
+            if (size > 0) {
+                memcpy(data, str, size);
+            }
+            data[size] = '\0';
+            return data;
+        }
+
+        chunks.push_back(std::make_unique<ca_char_t[]>(chunk_size));
+        arena_bytes += chunk_size;
+        chunk_cur = chunks.back().get();
+        chunk_left = chunk_size;
+    }
+
+    ca_char_t *data = chunk_cur;
+    if (size > 0) {
+        memcpy(data, str, size);
+    }
+    data[size] = '\0';
+    chunk_cur += needed;
+    chunk_left -= needed;
+    return data;
+}
+
+void
+ca_intern_pool::grow() {
+    std::vector<id_type> new_slots(slots.size() * 2, INVALID_ID);
+    const ca_size_t mask = new_slots.size() - 1;
+
+    for (ca_size_t id = 0; id < entries.size(); ++id) {
+        ca_size_t i = slot_of(entries[id].hash, mask);
+        while (new_slots[i] != INVALID_ID) {
+            i = (i + 1) & mask;
+        }
+        new_slots[i] = static_cast<id_type>(id);
+    }
+
+    slots = std::move(new_slots);
+}
+
+ca_size_t
+ca_intern_pool::length(const id_type id) const {
+    assert(id < entries.size());
+    return entries[id].size;
+}
+
+ca_size_t
+ca_intern_pool::size() const {
+    return entries.size();
+}
+
+ca_size_t
+ca_intern_pool::memory_usage() const {
+    return arena_bytes + entries.capacity() * sizeof(entry) + slots.capacity() * sizeof(id_type);
+}
+
+// ----------------------------
+// ca_sharded_intern_pool
+// ----------------------------
+
+ca_sharded_intern_pool::shard::shard(const ca_size_t chunk_size) : pool(chunk_size) {
+}
+
+ca_sharded_intern_pool::ca_sharded_intern_pool(const ca_size_t num_shards, const ca_size_t chunk_size) {
+    const ca_size_t count = std::bit_ceil(std::clamp<ca_size_t>(num_shards, 1, 256));
+    shard_bits = static_cast<ca_size_t>(std::countr_zero(count));
+
+    shards.reserve(count);
+    for (ca_size_t i = 0; i < count; ++i) {
+        shards.push_back(std::make_unique<shard>(chunk_size));
+    }
+}
+
+ca_sharded_intern_pool::id_type
+ca_sharded_intern_pool::intern(const ca_char_t *str, const ca_size_t size) {
+    assert(str != nullptr || size == 0);
+
+    const ca_uint64_t hash = ca_intern_pool::hash(str, size);
+    // The table uses the low bits of the hash, so route by the high bits
+    const ca_size_t index = shard_bits == 0 ? 0 : static_cast<ca_size_t>(hash >> (64 - shard_bits));
+    shard &s = *shards[index];
+
+    id_type local;
+    {
+        std::shared_lock lock(s.mutex);
+        local = s.pool.find_hashed(str, size, hash);
+    }
+    if (local == INVALID_ID) {
+        std::unique_lock lock(s.mutex);
+        local = s.pool.intern_hashed(str, size, hash);
+    }
+
+    assert(local <= (INVALID_ID >> shard_bits) - 1);
+    return static_cast<id_type>((local << shard_bits) | index);
+}
+
+ca_sharded_intern_pool::id_type
+ca_sharded_intern_pool::find(const ca_char_t *str, const ca_size_t size) const {
+    assert(str != nullptr || size == 0);
+
+    const ca_uint64_t hash = ca_intern_pool::hash(str, size);
+    const ca_size_t index = shard_bits == 0 ? 0 : static_cast<ca_size_t>(hash >> (64 - shard_bits));
+    const shard &s = *shards[index];
+
+    std::shared_lock lock(s.mutex);
+    const id_type local = s.pool.find_hashed(str, size, hash);
+    return local == INVALID_ID ? INVALID_ID : static_cast<id_type>((local << shard_bits) | index);
+}
+
+ca_intern_pool::entry
+ca_sharded_intern_pool::entry_of(const id_type id) const {
+    const shard &s = *shards[id & ((static_cast<id_type>(1) << shard_bits) - 1)];
+    const id_type local = id >> shard_bits;
+
+    std::shared_lock lock(s.mutex);
+    assert(local < s.pool.entries.size());
+    return s.pool.entries[local];
+}
+
+ca_size_t
+ca_sharded_intern_pool::size() const {
+    ca_size_t total = 0;
+    for (const auto &s : shards) {
+        std::shared_lock lock(s->mutex);
+        total += s->pool.size();
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,46 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_string/ca_intern_pool.tpp
+//
+// @file
+// @brief Implements the template members of `ca_intern_pool` and
+//        `ca_sharded_intern_pool`.
+// ================================
+#pragma once
+
+#include <cassert>
+
+namespace ca::ca_string {
+
+template <ca_encoding_t encoding>
+inline ca_intern_pool::id_type
+ca_intern_pool::intern(const ca_buffer<encoding> text) {
+    if (text.empty()) {
+        return intern(nullptr, 0);
+    }
+    return intern(text.buf, static_cast<ca_size_t>(text.after - text.buf));
+}
+
+template <ca_encoding_t encoding>
+inline ca_buffer<encoding>
+ca_intern_pool::view(const id_type id) const {
+    assert(id < entries.size());
+    return ca_buffer<encoding>(entries[id].data, entries[id].size);
+}
+
+template <ca_encoding_t encoding>
+inline ca_sharded_intern_pool::id_type
+ca_sharded_intern_pool::intern(const ca_buffer<encoding> text) {
+    if (text.empty()) {
+        return intern(nullptr, 0);
+    }
+    return intern(text.buf, static_cast<ca_size_t>(text.after - text.buf));
+}
+
+template <ca_encoding_t encoding>
+inline ca_buffer<encoding>
+ca_sharded_intern_pool::view(const id_type id) const {
+    const ca_intern_pool::entry e = entry_of(id);
+    return ca_buffer<encoding>(e.data, e.size);
+}
+
+}
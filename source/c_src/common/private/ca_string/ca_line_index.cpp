@@ -0,0 +1,241 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_string/ca_line_index.cpp
+//
+// @file
+// @brief Implements `ca_line_index`, including the SIMD newline scan and the
+//        binary serialization format.
+// ================================
+
+#include "ca_line_index.h"
+#include "ca_fastsearch.h"
+#include "ca_utf8_utils.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <emmintrin.h>  // SSE2
+#ifdef __AVX2__
+#include <immintrin.h>  // AVX2
+#endif
+
+namespace ca::ca_string {
+
+namespace {
+
+constexpr ca_uint32_t LINE_INDEX_MAGIC = 0x494C4143;  // "CALI"
+constexpr ca_uint32_t LINE_INDEX_VERSION = 1;
+
+/**
+ * @brief Serialized header of a line index.
+ */
+struct line_index_header {
+    ca_uint32_t magic;
+    ca_uint32_t version;
+    ca_uint64_t source_size;
+    ca_uint64_t num_lines;
+};
+
+/**
+ * @brief Appends the offset following every `\n` in `buf[0, size)` to `starts`.
+ */
+void
+scan_newlines(const ca_char_t *buf, const ca_size_t size,
+              std::vector<ca_line_index::offset_type> &starts) {
+    ca_size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    while (i + 32 <= size) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf + i));
+        auto mask = static_cast<ca_uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline)));
+
+        while (mask != 0) {
+            const int pos = std::countr_zero(mask);
+            starts.push_back(static_cast<ca_line_index::offset_type>(i + pos + 1));
+            mask &= mask - 1;
+        }
+        i += 32;
+    }
+#endif
+
+    const __m128i newline16 = _mm_set1_epi8('\n');
+
+    while (i + 16 <= size) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i));
+        auto mask = static_cast<ca_uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline16)));
+
+        while (mask != 0) {
+            const int pos = std::countr_zero(mask);
+            starts.push_back(static_cast<ca_line_index::offset_type>(i + pos + 1));
+            mask &= mask - 1;
+        }
+        i += 16;
+    }
+
+    for (; i < size; ++i) {
+        if (buf[i] == '\n') {
+            starts.push_back(static_cast<ca_line_index::offset_type>(i + 1));
+        }
+    }
+}
+
+}
+
+ca_line_index::ca_line_index() : line_starts(1, 0), size(0) {
+}
+
+int
+ca_line_index::build(const ca_char_t *buf, const ca_size_t size) {
+    assert(buf != nullptr || size == 0);
+
+    if (size > std::numeric_limits<offset_type>::max()) {
+        return -1;
+    }
+
+    line_starts.clear();
+    this->size = size;
+
+    ca_size_t num_newlines = 0;
+    if (size > 0) {
+        const fastsearch::CheckedIndexer<const ca_char_t, false> indexer(buf, size);
+        num_newlines = fastsearch::count_char<const ca_char_t, false>(indexer, size, '\n', CA_SIZE_T_MAX);
+    }
+
+    line_starts.reserve(num_newlines + 1);
+    line_starts.push_back(0);
+    if (size > 0) {
+        scan_newlines(buf, size, line_starts);
+    }
+
+    return 0;
+}
+
+ca_size_t
+ca_line_index::num_lines() const {
+    return line_starts.size();
+}
+
+ca_size_t
+ca_line_index::source_size() const {
+    return size;
+}
+
+ca_size_t
+ca_line_index::line_start(const ca_size_t line) const {
+    assert(line < line_starts.size());
+    return line_starts[line];
+}
+
+ca_size_t
+ca_line_index::line_end(const ca_size_t line) const {
+    assert(line < line_starts.size());
+    if (line + 1 < line_starts.size()) {
+        return line_starts[line + 1] - 1;  // exclude the '\n'
+    }
+    return size;
+}
+
+ca_size_t
+ca_line_index::line_of(const ca_size_t offset) const {
+    if (offset >= size) {
+        return line_starts.size() - 1;
+    }
+
+    // The first line start greater than offset is one past the containing line
+    const auto it = std::upper_bound(line_starts.begin(), line_starts.end(),
+                                     static_cast<offset_type>(offset));
+    return static_cast<ca_size_t>(it - line_starts.begin()) - 1;
+}
+
+ca_size_t
+ca_line_index::column_of(const ca_char_t *buf, const ca_size_t offset) const {
+    assert(buf != nullptr);
+    assert(offset <= size);
+
+    const ca_size_t start = line_starts[line_of(offset)];
+    ca_size_t column = 0;
+    if (offset > start) {
+        utf8::num_codepoints_for_utf8_bytes_without_check(buf + start, offset - start, &column);
+    }
+    return column;
+}
+
+void
+ca_line_index::location_of(const ca_char_t *buf, const ca_size_t offset,
+                           ca_size_t *line, ca_size_t *column) const {
+    assert(buf != nullptr);
+    assert(line != nullptr);
+    assert(column != nullptr);
+    assert(offset <= size);
+
+    *line = line_of(offset);
+    *column = 0;
+
+    const ca_size_t start = line_starts[*line];
+    if (offset > start) {
+        utf8::num_codepoints_for_utf8_bytes_without_check(buf + start, offset - start, column);
+    }
+}
+
+ca_size_t
+ca_line_index::serialized_size() const {
+    return sizeof(line_index_header) + line_starts.size() * sizeof(offset_type);
+}
+
+int
+ca_line_index::serialize(ca_char_t *out, const ca_size_t capacity) const {
+    assert(out != nullptr);
+
+    if (capacity < serialized_size()) {
+        return -1;
+    }
+
+    line_index_header header{};
+    header.magic = LINE_INDEX_MAGIC;
+    header.version = LINE_INDEX_VERSION;
+    header.source_size = size;
+    header.num_lines = line_starts.size();
+
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), line_starts.data(), line_starts.size() * sizeof(offset_type));
+    return 0;
+}
+
+int
+ca_line_index::deserialize(const ca_char_t *data, const ca_size_t size) {
+    assert(data != nullptr);
+
+    if (size < sizeof(line_index_header)) {
+        return -1;
+    }
+
+    line_index_header header{};
+    memcpy(&header, data, sizeof(header));
+
+    if (header.magic != LINE_INDEX_MAGIC || header.version != LINE_INDEX_VERSION ||
+        header.num_lines == 0 || header.source_size > std::numeric_limits<offset_type>::max() ||
+        header.num_lines > (size - sizeof(header)) / sizeof(offset_type)) {
+        return -1;
+    }
+
+    std::vector<offset_type> starts(header.num_lines);
+    memcpy(starts.data(), data + sizeof(header), header.num_lines * sizeof(offset_type));
+
+    // Offsets must start at 0, strictly increase and stay inside the source
+    if (starts[0] != 0) {
+        return -1;
+    }
+    for (ca_size_t i = 1; i < starts.size(); ++i) {
+        if (starts[i] <= starts[i - 1] || starts[i] > header.source_size) {
+            return -1;
+        }
+    }
+
+    line_starts = std::move(starts);
+    this->size = header.source_size;
+    return 0;
+}
+
+}
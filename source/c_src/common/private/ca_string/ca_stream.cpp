@@ -1,3 +1,92 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_string/ca_stream.cpp
 //
-// Created by Eden_ on 2025/3/26.
-//
\ No newline at end of file
+// @file
+// @brief Implements `ca_stream`.
+// ================================
+
+#include "ca_stream.h"
+#include "ca_utf8_utils.h"
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace ca::ca_string {
+
+ca_stream::ca_stream(ca_stream_reader reader, const ca_size_t chunk_size, const bool validate)
+    : reader(std::move(reader)),
+      capacity(ca_math::ca_max<ca_size_t>(chunk_size, MIN_CHUNK_SIZE)),
+      filled(0), carry(0), offset(0), decoded(0),
+      status(ca_stream_status::CA_STREAM_OK), eof(false), validate(validate) {
+    assert(this->reader);
+    storage = std::make_unique<ca_char_t[]>(capacity);
+}
+
+int
+ca_stream::fill() {
+    while (!eof && filled < capacity) {
+        const ca_ssize_t n = reader(storage.get() + filled, capacity - filled);
+        if (n < 0) {
+            return -1;
+        }
+        if (n == 0) {
+            eof = true;
+            break;
+        }
+        assert(static_cast<ca_size_t>(n) <= capacity - filled);
+        filled += static_cast<ca_size_t>(n);
+    }
+    return 0;
+}
+
+ca_stream_status
+ca_stream::next(ca_buffer<ca_encoding_t::CA_ENCODING_UTF8> *chunk) {
+    assert(chunk != nullptr);
+
+    if (status != ca_stream_status::CA_STREAM_OK) {
+        return status;
+    }
+
+    // Move the unfinished character of the previous chunk to the front
+    if (carry > 0) {
+        memmove(storage.get(), storage.get() + filled - carry, carry);
+    }
+    filled = carry;
+    carry = 0;
+
+    if (fill() != 0) {
+        return status = ca_stream_status::CA_STREAM_READ_ERROR;
+    }
+
+    if (filled == 0) {
+        return status = ca_stream_status::CA_STREAM_END;
+    }
+
+    // Cut before a character split by the chunk boundary
+    if (!eof) {
+        carry = utf8::utf8_incomplete_tail_size(storage.get(), filled);
+    }
+    const ca_size_t size = filled - carry;
+
+    if (validate && utf8::utf8_validate(storage.get(), size) != 0) {
+        return status = ca_stream_status::CA_STREAM_INVALID_UTF8;
+    }
+
+    offset = decoded;
+    decoded += size;
+    *chunk = ca_buffer<ca_encoding_t::CA_ENCODING_UTF8>(storage.get(), size);
+    return ca_stream_status::CA_STREAM_OK;
+}
+
+ca_size_t
+ca_stream::chunk_offset() const {
+    return offset;
+}
+
+ca_size_t
+ca_stream::bytes_decoded() const {
+    return decoded;
+}
+
+}
@@ -5,7 +5,9 @@
 // @brief Implementation of UTF-8 utility functions, modified from NumPy utf8_utils.cpp.
 // ================================
 
+#include <bit>
 #include <cassert>
+#include <emmintrin.h>  // SSE2
 
 #include "ca_utf8_utils.h"
 
@@ -195,14 +197,25 @@ num_codepoints_for_utf8_bytes_without_check(
     assert(buf != nullptr);
     assert(num_codepoints != nullptr);
 
+    // In well-formed UTF-8 every byte that is not a continuation byte
+    // (10xxxxxx) starts a codepoint, so codepoints can be counted block-wise.
+    // Continuation bytes are the only bytes below -64 as signed bytes.
+    const __m128i continuation_limit = _mm_set1_epi8(-64);
+
     ca_size_t bytes_consumed = 0;
     ca_size_t codepoints_count = 0;
 
-    while (bytes_consumed < max_bytes) {
-        const int num_bytes = num_utf8_bytes_for_utf8_character_without_check(buf);
-        codepoints_count += 1;
-        bytes_consumed += num_bytes;
-        buf += num_bytes;
+    while (bytes_consumed + 16 <= max_bytes) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + bytes_consumed));
+        const int continuation_mask = _mm_movemask_epi8(_mm_cmplt_epi8(chunk, continuation_limit));
+        codepoints_count += 16 - std::popcount(static_cast<ca_uint32_t>(continuation_mask));
+        bytes_consumed += 16;
+    }
+
+    for (; bytes_consumed < max_bytes; ++bytes_consumed) {
+        if ((buf[bytes_consumed] & 0xC0) != 0x80) {
+            codepoints_count += 1;
+        }
     }
 
     *num_codepoints = codepoints_count;
@@ -246,6 +259,65 @@ num_codepoints_for_utf8_bytes(
     return state == UTF8_ACCEPT ? 0 : -1;
 }
 
+// ----------------------------
+// Validation functions
+// ----------------------------
+
+int
+utf8_validate(const ca_char_t *buf, const ca_size_t max_bytes) {
+    assert(buf != nullptr);
+
+    ca_char4_t codepoint;
+    ca_uint8_t state = UTF8_ACCEPT;
+    ca_size_t i = 0;
+
+    while (i < max_bytes) {
+        // ASCII blocks can only be skipped between two characters
+        if (state == UTF8_ACCEPT) {
+            while (i + 16 <= max_bytes) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i));
+                if (_mm_movemask_epi8(chunk) != 0) {
+                    break;
+                }
+                i += 16;
+            }
+        }
+
+        // Decode bytes until the next block boundary (or the end)
+        const ca_size_t stop = ca_math::ca_min<ca_size_t>(max_bytes, (i & ~static_cast<ca_size_t>(15)) + 16);
+        for (; i < stop; ++i) {
+            if (utf8_decode(&state, &codepoint, buf[i]) == UTF8_REJECT) {
+                return -1;
+            }
+        }
+    }
+
+    return state == UTF8_ACCEPT ? 0 : -1;
+}
+
+ca_size_t
+utf8_incomplete_tail_size(const ca_char_t *buf, const ca_size_t max_bytes) {
+    assert(buf != nullptr);
+
+    // Look back over at most 3 continuation bytes for the last lead byte
+    const ca_size_t lookback = ca_math::ca_min<ca_size_t>(max_bytes, 4);
+    for (ca_size_t back = 1; back <= lookback; ++back) {
+        const ca_char_t c = buf[max_bytes - back];
+        if ((c & 0xC0) == 0x80) {
+            continue;
+        }
+        if (c < 0xC2 || c > 0xF4) {
+            // ASCII ends a character, and invalid lead bytes are left to validation
+            return 0;
+        }
+
+        const auto needed = static_cast<ca_size_t>(num_utf8_bytes_for_utf8_character_without_check(&c));
+        return back < needed ? back : 0;
+    }
+
+    return 0;
+}
+
 // ----------------------------
 // Buffer Size calculation functions
 // ----------------------------
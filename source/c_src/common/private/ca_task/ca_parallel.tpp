@@ -0,0 +1,96 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_task/ca_parallel.tpp
+//
+// @file
+// @brief Implements `ca_parallel_for` and `ca_parallel_reduce`.
+// ================================
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace ca::ca_task {
+
+namespace internal {
+
+/**
+ * @brief Returns `grain`, or if 0 a grain giving each worker about 8 chunks.
+ */
+inline ca_size_t
+ca_parallel_grain(const ca_task_pool &pool, const ca_size_t length, const ca_size_t grain) {
+    if (grain != 0) {
+        return grain;
+    }
+    return std::max<ca_size_t>(1, length / (std::max<ca_size_t>(1, pool.threads()) * 8));
+}
+
+}
+
+template <typename Body>
+int
+ca_parallel_for(ca_task_pool &pool, const ca_size_t begin, const ca_size_t end, ca_size_t grain, Body &&body,
+                ca_cancel_token *cancel) {
+    if (end <= begin) {
+        return 0;
+    }
+    grain = internal::ca_parallel_grain(pool, end - begin, grain);
+
+    if (pool.threads() == 0) {
+        for (ca_size_t b = begin; b < end; b += std::min(grain, end - b)) {
+            if (cancel != nullptr && cancel->cancelled()) {
+                return -1;
+            }
+            body(b, std::min(b + grain, end));
+        }
+        return 0;
+    }
+
+    ca_task_group group(pool, cancel);
+    std::function<void(ca_size_t, ca_size_t)> split = [&](ca_size_t b, ca_size_t e) {
+        while (e - b > grain) {
+            if (group.cancelled()) {
+                return;
+            }
+            const ca_size_t middle = b + (e - b) / 2;
+            group.run([&split, middle, e] { split(middle, e); });
+            e = middle;
+        }
+        if (!group.cancelled()) {
+            body(b, e);
+        }
+    };
+    split(begin, end);
+    group.wait();
+    return group.cancelled() ? -1 : 0;
+}
+
+template <typename T, typename Map, typename Combine>
+T
+ca_parallel_reduce(ca_task_pool &pool, const ca_size_t begin, const ca_size_t end, ca_size_t grain, T identity,
+                   Map &&map, Combine &&combine, ca_cancel_token *cancel) {
+    if (end <= begin) {
+        return identity;
+    }
+    grain = internal::ca_parallel_grain(pool, end - begin, grain);
+
+    const ca_size_t chunks = (end - begin + grain - 1) / grain;
+    std::vector<T> partials(chunks, identity);
+    const int status = ca_parallel_for(pool, 0, chunks, 1, [&](const ca_size_t first, const ca_size_t last) {
+        for (ca_size_t chunk = first; chunk < last; ++chunk) {
+            const ca_size_t b = begin + chunk * grain;
+            partials[chunk] = map(b, std::min(b + grain, end));
+        }
+    }, cancel);
+    if (status != 0) {
+        return identity;
+    }
+
+    T result = std::move(identity);
+    for (T &partial : partials) {
+        result = combine(std::move(result), std::move(partial));
+    }
+    return result;
+}
+
+}
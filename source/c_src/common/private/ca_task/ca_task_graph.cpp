@@ -0,0 +1,95 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_task/ca_task_graph.cpp
+//
+// @file
+// @brief Implements `ca_task_graph`.
+// ================================
+
+#include "ca_task_graph.h"
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+
+namespace ca::ca_task {
+
+ca_task_graph::node_id
+ca_task_graph::add(std::function<void()> function) {
+    assert(function);
+    nodes.push_back({ std::move(function), {}, 0 });
+    return nodes.size() - 1;
+}
+
+void
+ca_task_graph::precede(const node_id before, const node_id after) {
+    assert(before < nodes.size() && after < nodes.size());
+    nodes[before].successors.push_back(after);
+    ++nodes[after].predecessors;
+}
+
+int
+ca_task_graph::sort(std::vector<node_id> *order) const {
+    assert(order != nullptr);
+    // Kahn's algorithm, with `order` as the queue
+    std::vector<ca_size_t> remaining(nodes.size());
+    order->clear();
+    order->reserve(nodes.size());
+    for (node_id i = 0; i < nodes.size(); ++i) {
+        remaining[i] = nodes[i].predecessors;
+        if (remaining[i] == 0) {
+            order->push_back(i);
+        }
+    }
+    for (ca_size_t head = 0; head < order->size(); ++head) {
+        for (const node_id next : nodes[(*order)[head]].successors) {
+            if (--remaining[next] == 0) {
+                order->push_back(next);
+            }
+        }
+    }
+    return order->size() == nodes.size() ? 0 : -1;
+}
+
+int
+ca_task_graph::run(ca_task_pool &pool, ca_cancel_token *cancel) {
+    std::vector<node_id> order;
+    if (sort(&order) != 0) {
+        return -1;
+    }
+
+    if (pool.threads() == 0) {
+        for (const node_id id : order) {
+            if (cancel != nullptr && cancel->cancelled()) {
+                return -1;
+            }
+            nodes[id].function();
+        }
+        return 0;
+    }
+
+    const auto remaining = std::make_unique<std::atomic<ca_size_t>[]>(nodes.size());
+    for (node_id i = 0; i < nodes.size(); ++i) {
+        remaining[i].store(nodes[i].predecessors, std::memory_order_relaxed);
+    }
+    ca_task_group group(pool, cancel);
+    std::function<void(node_id)> launch = [&](const node_id id) {
+        group.run([&, id] {
+            nodes[id].function();
+            // The thread finishing the last dependency starts the successor
+            for (const node_id next : nodes[id].successors) {
+                if (remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    launch(next);
+                }
+            }
+        });
+    };
+    for (node_id i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].predecessors == 0) {
+            launch(i);
+        }
+    }
+    group.wait();
+    return group.cancelled() ? -1 : 0;
+}
+
+}
@@ -0,0 +1,289 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_task/ca_task_pool.cpp
+//
+// @file
+// @brief Implements `ca_task_pool` and `ca_task_group`.
+// ================================
+
+#include "ca_task_pool.h"
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(CA_ENABLE_THREADING) && defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(CA_ENABLE_THREADING) && defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace ca::ca_task {
+
+namespace {
+
+/**
+ * @brief Number of times a thread looks for a task, yielding in between,
+ *        before going to sleep.
+ */
+constexpr int SPIN_ROUNDS = 64;
+
+/**
+ * @struct current_worker
+ * @brief The pool and index of the worker running on this thread, if any.
+ */
+struct current_worker {
+    const ca_task_pool *pool = nullptr;    ///< The pool, `nullptr` outside workers.
+    ca_size_t index = 0;                   ///< The index in the pool.
+    ca_size_t victim = 0;                  ///< Where the next search for a victim starts.
+};
+
+thread_local current_worker current;
+
+#ifdef CA_ENABLE_THREADING
+/**
+ * @brief Pins the calling thread to the logical CPU `index` modulo the number
+ *        of CPUs. Best effort: failures leave the thread unpinned.
+ */
+void
+pin_current_thread(const ca_size_t index) {
+    const ca_size_t cpus = std::max(1u, std::thread::hardware_concurrency());
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(index % cpus), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << (index % std::min<ca_size_t>(cpus, 64)));
+#else
+    (void)cpus;
+#endif
+}
+#endif
+
+}
+
+struct ca_task_pool::worker {
+    ca_work_deque<internal::ca_task *> deque;    ///< Tasks submitted by the worker.
+    std::thread thread;                          ///< The thread.
+};
+
+ca_task_pool::ca_task_pool(const ca_task_pool_options &options)
+    : injected_count(0), sleepers(0), stopping(false),
+      executed(0), skipped(0), stolen(0), injections(0), sleeps(0) {
+#ifdef CA_ENABLE_THREADING
+    const ca_size_t count = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    // Every deque exists before any worker may look for a victim
+    workers.reserve(count);
+    for (ca_size_t i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<worker>());
+    }
+    for (ca_size_t i = 0; i < count; ++i) {
+        workers[i]->thread = std::thread(&ca_task_pool::work, this, i, options.pin_threads);
+    }
+#else
+    (void)options;
+#endif
+}
+
+ca_task_pool::~ca_task_pool() {
+    stopping.store(true, std::memory_order_seq_cst);
+    {
+        std::lock_guard lock(sleep_lock);
+        wake.notify_all();
+    }
+    for (const auto &w : workers) {
+        w->thread.join();
+    }
+}
+
+ca_size_t
+ca_task_pool::worker_index() const {
+    return current.pool == this ? current.index : NOT_A_WORKER;
+}
+
+ca_task_pool_stats
+ca_task_pool::stats() const {
+    return {
+        executed.load(std::memory_order_relaxed),
+        skipped.load(std::memory_order_relaxed),
+        stolen.load(std::memory_order_relaxed),
+        injections.load(std::memory_order_relaxed),
+        sleeps.load(std::memory_order_relaxed),
+    };
+}
+
+void
+ca_task_pool::submit(internal::ca_task *task) {
+    if (workers.empty()) {
+        execute(task);
+        return;
+    }
+    const ca_size_t index = worker_index();
+    if (index != NOT_A_WORKER) {
+        workers[index]->deque.push(task);
+    } else {
+        std::lock_guard lock(inject_lock);
+        injected.push_back(task);
+        injected_count.fetch_add(1, std::memory_order_relaxed);
+        injections.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Pairs with the fence of a thread going to sleep: either it sees the
+    // task, or this sees it counted in `sleepers` and wakes it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed) != 0) {
+        std::lock_guard lock(sleep_lock);
+        wake.notify_one();
+    }
+}
+
+internal::ca_task *
+ca_task_pool::find_task(const ca_size_t index) {
+    internal::ca_task *task = nullptr;
+    if (index != NOT_A_WORKER && workers[index]->deque.pop(&task)) {
+        return task;
+    }
+    if (injected_count.load(std::memory_order_relaxed) != 0) {
+        std::lock_guard lock(inject_lock);
+        if (!injected.empty()) {
+            task = injected.front();
+            injected.pop_front();
+            injected_count.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    // Victims are tried in turn from a point that moves on every search, so
+    // thieves spread over the workers instead of all hitting the first one
+    const ca_size_t count = workers.size();
+    const ca_size_t start = current.victim++;
+    for (ca_size_t i = 0; i < count; ++i) {
+        const ca_size_t victim = (start + i) % count;
+        if (victim != index && workers[victim]->deque.steal(&task)) {
+            stolen.fetch_add(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void
+ca_task_pool::execute(internal::ca_task *task) {
+    ca_task_group *group = task->group;
+    if (group->cancelled()) {
+        skipped.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        task->function();
+        executed.fetch_add(1, std::memory_order_relaxed);
+    }
+    delete task;
+    group->finish();
+}
+
+bool
+ca_task_pool::has_work() const {
+    if (injected_count.load(std::memory_order_relaxed) != 0) {
+        return true;
+    }
+    return std::any_of(workers.begin(), workers.end(), [](const auto &w) { return !w->deque.empty(); });
+}
+
+void
+ca_task_pool::work(const ca_size_t index, const bool pin) {
+#ifdef CA_ENABLE_THREADING
+    if (pin) {
+        pin_current_thread(index);
+    }
+#else
+    (void)pin;
+#endif
+    current.pool = this;
+    current.index = index;
+    current.victim = index + 1;
+
+    int idle = 0;
+    while (true) {
+        if (internal::ca_task *task = find_task(index)) {
+            execute(task);
+            idle = 0;
+            continue;
+        }
+        if (++idle < SPIN_ROUNDS) {
+            std::this_thread::yield();
+            continue;
+        }
+        idle = 0;
+        sleepers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock lock(sleep_lock);
+            if (!has_work() && !stopping.load(std::memory_order_relaxed)) {
+                sleeps.fetch_add(1, std::memory_order_relaxed);
+                wake.wait(lock);
+            }
+        }
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+        if (stopping.load(std::memory_order_seq_cst) && !has_work()) {
+            break;
+        }
+    }
+    current.pool = nullptr;
+}
+
+ca_task_group::ca_task_group(ca_task_pool &pool, ca_cancel_token *cancel)
+    : owner(pool), token(cancel != nullptr ? cancel : &own_token), pending(0) {}
+
+ca_task_group::~ca_task_group() {
+    wait();
+}
+
+void
+ca_task_group::run(std::function<void()> function) {
+    assert(function);
+    pending.fetch_add(1, std::memory_order_relaxed);
+    owner.submit(new internal::ca_task{ std::move(function), this });
+}
+
+void
+ca_task_group::finish() {
+    // Touches only the pool after the last decrement, since the waiting
+    // thread may destroy the group as soon as it sees zero
+    ca_task_pool &pool = owner;
+    if (pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (pool.sleepers.load(std::memory_order_relaxed) != 0) {
+        std::lock_guard lock(pool.sleep_lock);
+        pool.wake.notify_all();
+    }
+}
+
+void
+ca_task_group::wait() {
+    const ca_size_t index = owner.worker_index();
+    int idle = 0;
+    while (pending.load(std::memory_order_acquire) != 0) {
+        if (internal::ca_task *task = owner.find_task(index)) {
+            owner.execute(task);
+            idle = 0;
+            continue;
+        }
+        if (++idle < SPIN_ROUNDS) {
+            std::this_thread::yield();
+            continue;
+        }
+        // The tasks left are running on other threads: sleep until one of
+        // the groups finishes or a task is queued
+        idle = 0;
+        owner.sleepers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock lock(owner.sleep_lock);
+            if (pending.load(std::memory_order_relaxed) != 0 && !owner.has_work()) {
+                owner.wake.wait(lock);
+            }
+        }
+        owner.sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+}
@@ -0,0 +1,95 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/private/ca_task/ca_work_deque.tpp
+//
+// @file
+// @brief Implements `ca_work_deque`.
+// ================================
+#pragma once
+
+#include <bit>
+
+namespace ca::ca_task {
+
+template <typename T>
+ca_work_deque<T>::ring::ring(const ca_size_t capacity)
+    : capacity(capacity), mask(capacity - 1), items(std::make_unique<std::atomic<T>[]>(capacity)) {}
+
+template <typename T>
+ca_work_deque<T>::ca_work_deque(const ca_size_t capacity)
+    : top(0), bottom(0), array(nullptr) {
+    rings.push_back(std::make_unique<ring>(std::bit_ceil(capacity < 2 ? ca_size_t{ 2 } : capacity)));
+    array.store(rings.back().get(), std::memory_order_relaxed);
+}
+
+template <typename T>
+void
+ca_work_deque<T>::push(const T item) {
+    const ca_int64_t b = bottom.load(std::memory_order_relaxed);
+    const ca_int64_t t = top.load(std::memory_order_acquire);
+    ring *current = array.load(std::memory_order_relaxed);
+    if (b - t > static_cast<ca_int64_t>(current->capacity) - 1) {
+        // Full: copy the live items to a ring twice as large. Thieves reading
+        // the old ring at the same time still find the same items there.
+        rings.push_back(std::make_unique<ring>(current->capacity * 2));
+        ring *grown = rings.back().get();
+        for (ca_int64_t i = t; i < b; ++i) {
+            grown->put(i, current->get(i));
+        }
+        array.store(grown, std::memory_order_release);
+        current = grown;
+    }
+    current->put(b, item);
+    // Publishes the item before the new bottom
+    bottom.store(b + 1, std::memory_order_release);
+}
+
+template <typename T>
+bool
+ca_work_deque<T>::pop(T *item) {
+    const ca_int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    ring *current = array.load(std::memory_order_relaxed);
+    // Claims the bottom item before looking at top; sequentially consistent
+    // so that a thief cannot miss the claim while the owner misses the steal
+    bottom.store(b, std::memory_order_seq_cst);
+    ca_int64_t t = top.load(std::memory_order_seq_cst);
+    if (t > b) {
+        // Empty
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+    *item = current->get(b);
+    if (t < b) {
+        return true;
+    }
+    // Last item: race the thieves for it
+    const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return won;
+}
+
+template <typename T>
+bool
+ca_work_deque<T>::steal(T *item) {
+    ca_int64_t t = top.load(std::memory_order_seq_cst);
+    const ca_int64_t b = bottom.load(std::memory_order_seq_cst);
+    if (t >= b) {
+        return false;
+    }
+    const ring *current = array.load(std::memory_order_acquire);
+    const T candidate = current->get(t);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return false;
+    }
+    *item = candidate;
+    return true;
+}
+
+template <typename T>
+ca_size_t
+ca_work_deque<T>::size() const {
+    const ca_int64_t b = bottom.load(std::memory_order_relaxed);
+    const ca_int64_t t = top.load(std::memory_order_relaxed);
+    return b > t ? static_cast<ca_size_t>(b - t) : 0;
+}
+
+}
@@ -9,6 +9,40 @@
 #ifndef CA_IO_FILE_H
 #define CA_IO_FILE_H
 
+#include "core/file_defs.h"
+#include "ca_math.h"
 
+namespace ca::ca_io {
+
+/**
+ * @struct ca_file_stamp
+ * @brief Identifies a version of a file: which file it is, and when and to
+ *        which size it was last written.
+ *
+ * Two stamps compare equal when they refer to the same file in the same
+ * state, so stamps can key caches of file contents across renames and hard
+ * links, and a changed stamp tells that the contents may have changed.
+ */
+struct ca_file_stamp {
+    ca_uint64_t device;         ///< Device, or volume serial number on Windows.
+    ca_uint64_t inode;          ///< Inode, or file index on Windows.
+    ca_uint64_t size;           ///< Size in bytes.
+    ca_int64_t mtime_ns;        ///< Last modification time in nanoseconds since the epoch.
+
+    friend bool
+    operator==(const ca_file_stamp &lhs, const ca_file_stamp &rhs) = default;
+};
+
+/**
+ * @brief Reads the stamp of a file, following symbolic links.
+ *
+ * @param path [in] Path of the file. Must not be `nullptr`.
+ * @param stamp [out] Receives the stamp. Must not be `nullptr`.
+ * @return `FILE_OK` on success, or the error reading the metadata.
+ */
+ca_file_result
+ca_file_stat(const char *path, ca_file_stamp *stamp);
+
+}
 
 #endif //CA_IO_FILE_H
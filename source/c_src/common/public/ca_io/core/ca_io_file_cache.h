@@ -0,0 +1,191 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_io/core/ca_io_file_cache.h
+//
+// @file
+// @brief Defines `ca_file_cache`, a thread-safe cache of loaded files keyed
+//        by their stamps, with precomputed facts about their contents and a
+//        memory budget enforced by LRU eviction.
+// ================================
+
+#ifndef CA_IO_FILE_CACHE_H
+#define CA_IO_FILE_CACHE_H
+
+#include "core/ca_io_file.h"
+#include "core/rw/ca_io_file_rw_sync.h"
+#include "ca_line_index.h"
+#include "ca_math.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ca::ca_io {
+
+/**
+ * @struct ca_cached_file
+ * @brief The contents of a file and facts computed once when it was loaded.
+ *
+ * Cached files are immutable and shared: a file evicted from the cache stays
+ * alive until the last reader releases it.
+ */
+struct ca_cached_file {
+    ca_file_stamp stamp;                ///< Stamp of the file when it was loaded.
+    ca_file_view view;                  ///< The contents.
+    ca_uint64_t hash;                   ///< `ca_hash64` of the contents.
+    bool is_ascii;                      ///< Whether every byte is below 0x80.
+    ca_string::ca_line_index lines;     ///< Line starts of the contents.
+
+    /**
+     * @brief Returns the bytes charged against the budget of the cache.
+     */
+    [[nodiscard]] ca_size_t
+    charge() const;
+};
+
+/**
+ * @typedef ca_cached_file_ptr
+ * @brief Shared handle of a cached file.
+ */
+typedef std::shared_ptr<const ca_cached_file> ca_cached_file_ptr;
+
+/**
+ * @struct ca_file_cache_stats
+ * @brief Counters of a `ca_file_cache`.
+ */
+struct ca_file_cache_stats {
+    ca_size_t hits;             ///< Lookups served from the cache.
+    ca_size_t misses;           ///< Lookups that loaded the file.
+    ca_size_t evictions;        ///< Files evicted to stay within the budget.
+    ca_size_t entries;          ///< Files currently cached.
+    ca_size_t bytes;            ///< Bytes currently charged.
+};
+
+/**
+ * @struct ca_file_cache
+ * @brief Caches loaded files for the whole analysis.
+ *
+ * Files are keyed by their `ca_file_stamp` rather than their path, so a
+ * header reached through different paths or links is loaded once, and a
+ * header modified on disk gets a new entry instead of stale contents. A
+ * lookup costs one `stat`; on a miss the file is loaded with `ca_file_read`
+ * and its hash, ASCII flag and line index are computed before it is
+ * published.
+ *
+ * Entries are split into shards, each with its own lock, map and LRU list,
+ * so concurrent analysis threads rarely contend. Every shard holds an equal
+ * part of the byte budget and evicts its least recently used files when it
+ * exceeds it; files larger than a shard's part are returned without being
+ * cached.
+ */
+struct ca_file_cache {
+    /**
+     * @brief Default byte budget.
+     */
+    static constexpr ca_size_t DEFAULT_BUDGET = 512 * 1024 * 1024;
+
+    /**
+     * @brief Number of shards.
+     */
+    static constexpr ca_size_t NUM_SHARDS = 16;
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param budget Maximum bytes charged by the cached files.
+     * @param read_options Options of the loads.
+     */
+    explicit ca_file_cache(ca_size_t budget = DEFAULT_BUDGET, const ca_file_read_options &read_options = {});
+
+    ca_file_cache(const ca_file_cache &) = delete;
+    ca_file_cache &operator=(const ca_file_cache &) = delete;
+
+    /**
+     * @brief Returns a file from the cache, loading it on a miss.
+     *
+     * If the file changes while it is loaded, it is returned but not cached.
+     *
+     * @param path [in] Path of the file. Must not be `nullptr`.
+     * @param file [out] Receives the file. Must not be `nullptr`.
+     * @return `FILE_OK` on success, or the error reading the file.
+     */
+    ca_file_result
+    get(const char *path, ca_cached_file_ptr *file);
+
+    /**
+     * @brief Changes the byte budget, evicting files as needed.
+     *
+     * @param budget The new budget.
+     */
+    void
+    set_budget(ca_size_t budget);
+
+    /**
+     * @brief Returns the byte budget.
+     */
+    [[nodiscard]] ca_size_t
+    budget() const;
+
+    /**
+     * @brief Evicts every file.
+     */
+    void
+    clear();
+
+    /**
+     * @brief Returns the counters of the cache.
+     */
+    [[nodiscard]] ca_file_cache_stats
+    stats() const;
+
+    /**
+     * @brief Returns the process-wide cache.
+     */
+    static ca_file_cache &
+    global();
+
+private:
+    /**
+     * @brief Hashes stamps for the shard maps.
+     */
+    struct stamp_hash {
+        ca_size_t
+        operator()(const ca_file_stamp &stamp) const;
+    };
+
+    /**
+     * @brief One part of the cache, padded to its own cache lines.
+     */
+    struct alignas(64) shard {
+        std::mutex mutex;                                   ///< Guards the members below.
+        std::list<ca_cached_file_ptr> lru;                  ///< Files, most recently used first.
+        std::unordered_map<ca_file_stamp, std::list<ca_cached_file_ptr>::iterator, stamp_hash> index;
+        ca_size_t bytes = 0;                                ///< Bytes charged by `lru`.
+    };
+
+    /**
+     * @brief Evicts the least recently used files of a shard until it fits
+     *        its budget. The shard must be locked.
+     */
+    void
+    trim(shard &part, ca_size_t limit);
+
+    /**
+     * @brief Returns the shard of a stamp.
+     */
+    [[nodiscard]] shard &
+    shard_of(const ca_file_stamp &stamp);
+
+    std::vector<std::unique_ptr<shard>> shards;     ///< The shards.
+    ca_file_read_options read_options;              ///< Options of the loads.
+    std::atomic<ca_size_t> max_bytes;               ///< Byte budget of the whole cache.
+    std::atomic<ca_size_t> hits;                    ///< Lookups served from the cache.
+    std::atomic<ca_size_t> misses;                  ///< Lookups that loaded the file.
+    std::atomic<ca_size_t> evictions;               ///< Files evicted.
+};
+
+}
+
+#endif //CA_IO_FILE_CACHE_H
@@ -0,0 +1,129 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_io/core/ca_io_file_metadata.h
+//
+// @file
+// @brief Defines batched file metadata scanning and the comparison of
+//        metadata snapshots for change detection.
+// ================================
+
+#ifndef CA_IO_FILE_METADATA_H
+#define CA_IO_FILE_METADATA_H
+
+#include "core/ca_io_path.h"
+#include "core/file_defs.h"
+#include "ca_math.h"
+
+#include <span>
+#include <vector>
+
+namespace ca::ca_io {
+
+/**
+ * @struct ca_file_metadata
+ * @brief The metadata of one file used to detect changes, 32 bytes.
+ *
+ * All fields but `result` are 0 if the file could not be queried.
+ */
+struct ca_file_metadata {
+    ca_uint64_t size;           ///< Size in bytes.
+    ca_int64_t mtime_ns;        ///< Last modification time in nanoseconds since the epoch.
+    ca_uint64_t inode;          ///< Inode, or file index on Windows.
+    ca_uint32_t mode;           ///< Type and permission bits as in `st_mode`.
+    ca_file_result result;      ///< Result of the query.
+
+    /**
+     * @brief Checks if two queries saw the same version of a file.
+     */
+    friend bool
+    operator==(const ca_file_metadata &lhs, const ca_file_metadata &rhs) = default;
+};
+
+/**
+ * @struct ca_metadata_scan_options
+ * @brief Controls `ca_file_metadata_scan`.
+ */
+struct ca_metadata_scan_options {
+    ca_size_t queue_depth = 256;        ///< Queries in flight at once with io_uring.
+    ca_size_t num_threads = 0;          ///< Threads of the fallback, 0 for one per hardware thread.
+    bool use_io_uring = true;           ///< Whether io_uring is used when the kernel supports it.
+};
+
+/**
+ * @brief Queries the metadata of many files at once.
+ *
+ * On Linux with io_uring, the `statx` calls are submitted to one ring with
+ * up to `queue_depth` in flight, so a whole tree is queried in a few system
+ * calls. Otherwise the paths are split between threads querying them one by
+ * one. Symbolic links are followed.
+ *
+ * @param paths [in] Null-terminated paths of the files. None may be `nullptr`.
+ * @param metadata [out] Receives the metadata of `paths[i]` at index `i`.
+ *                 Must be as long as `paths`.
+ * @param options [in] Scan options.
+ */
+void
+ca_file_metadata_scan(std::span<const char *const> paths, std::span<ca_file_metadata> metadata,
+                      const ca_metadata_scan_options &options = {});
+
+/**
+ * @struct ca_metadata_snapshot
+ * @brief The metadata of a set of files at one point in time.
+ *
+ * The files are interned paths of a `ca_path_table`, sorted by id, with
+ * their metadata in a parallel array, so two snapshots are compared in a
+ * single merge pass.
+ */
+struct ca_metadata_snapshot {
+    std::vector<ca_path_id> ids;                ///< Paths of the files, ascending.
+    std::vector<ca_file_metadata> metadata;     ///< Metadata of `ids[i]` at index `i`.
+};
+
+/**
+ * @brief Takes a metadata snapshot of a set of files.
+ *
+ * @param table [in] The table interning the paths.
+ * @param ids [in] Ids of the paths in `table`, in any order. Duplicates are removed.
+ * @param snapshot [out] Receives the snapshot. Must not be `nullptr`.
+ * @param options [in] Scan options.
+ */
+void
+ca_metadata_snapshot_take(const ca_path_table &table, std::span<const ca_path_id> ids,
+                          ca_metadata_snapshot *snapshot, const ca_metadata_scan_options &options = {});
+
+/**
+ * @enum ca_file_change_kind
+ * @brief How a file differs between two snapshots.
+ */
+enum class ca_file_change_kind {
+    FILE_CHANGE_ADDED,          ///< Missing before, present now.
+    FILE_CHANGE_REMOVED,        ///< Present before, missing now.
+    FILE_CHANGE_MODIFIED,       ///< Present in both with different metadata.
+};
+
+/**
+ * @struct ca_file_change
+ * @brief A file that changed between two snapshots.
+ */
+struct ca_file_change {
+    ca_path_id id;              ///< Path of the file.
+    ca_file_change_kind kind;   ///< How it changed.
+};
+
+/**
+ * @brief Compares two snapshots in one pass.
+ *
+ * A file counts as present when its query succeeded, so a file listed in
+ * both snapshots but deleted in between is reported as removed.
+ *
+ * @param before [in] The older snapshot.
+ * @param after [in] The newer snapshot.
+ * @param changes [out] Receives the changed files, by ascending id; previous
+ *                contents are cleared. Must not be `nullptr`.
+ */
+void
+ca_metadata_snapshot_diff(const ca_metadata_snapshot &before, const ca_metadata_snapshot &after,
+                          std::vector<ca_file_change> *changes);
+
+}
+
+#endif //CA_IO_FILE_METADATA_H
@@ -8,7 +8,8 @@
 #ifndef CA_IO_RW_H
 #define CA_IO_RW_H
 
-#include "rw/ca_io_rw_sync.h"
-#include "rw/ca_io_rw_asyn.h"
+#include "rw/ca_io_file_rw_asyn.h"
+#include "rw/ca_io_file_rw_sync.h"
+#include "rw/ca_io_file_writer.h"
 
 #endif //CA_IO_RW_H
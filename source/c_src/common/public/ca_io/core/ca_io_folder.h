@@ -8,4 +8,111 @@
 #ifndef CA_IO_FOLDER_H
 #define CA_IO_FOLDER_H
 
+#include "core/ca_io_glob.h"
+#include "core/file_defs.h"
+#include "ca_math.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ca::ca_io {
+
+/**
+ * @enum ca_folder_entry_type
+ * @brief Types of directory entries. Symbolic links report the type of
+ *        their target.
+ */
+enum class ca_folder_entry_type {
+    FOLDER_ENTRY_FILE,          ///< Regular file.
+    FOLDER_ENTRY_DIRECTORY,     ///< Directory.
+    FOLDER_ENTRY_OTHER,         ///< Anything else, including broken links.
+};
+
+/**
+ * @struct ca_folder_entry
+ * @brief A file found by `ca_folder_walk`.
+ *
+ * The views are only valid during the visitor call.
+ */
+struct ca_folder_entry {
+    std::string_view path;              ///< Root joined with `relative_path`.
+    std::string_view relative_path;     ///< Path relative to the root, `/`-separated.
+    std::string_view name;              ///< Last component of the path.
+    bool is_symlink;                    ///< Whether the entry is a symbolic link to a file.
+};
+
+/**
+ * @typedef ca_folder_visitor
+ * @brief Receives the files found by `ca_folder_walk`.
+ *
+ * The visitor is called concurrently from all walker threads.
+ */
+typedef std::function<void(const ca_folder_entry &entry)> ca_folder_visitor;
+
+/**
+ * @struct ca_folder_walk_options
+ * @brief Controls `ca_folder_walk`.
+ */
+struct ca_folder_walk_options {
+    /**
+     * @brief Extensions of the files to report, including the dot, e.g.
+     *        `".c"`. All files are reported if empty.
+     */
+    std::vector<std::string> extensions;
+
+    /**
+     * @brief Rules of the paths to skip, in `.gitignore` syntax, see
+     *        `ca_glob_set`. Excluded directories are not descended.
+     */
+    std::vector<std::string> exclude;
+
+    /**
+     * @brief Precompiled rules, e.g. of a `.gitignore` file, that `exclude`
+     *        is appended to.
+     */
+    ca_glob_set ignore;
+
+    ca_size_t num_threads = 0;          ///< Walker threads including the caller, 0 for one per hardware thread.
+    bool include_hidden = false;        ///< Whether names starting with `.` are walked.
+    bool follow_symlinks = false;       ///< Whether symbolic links to directories are descended.
+};
+
+/**
+ * @struct ca_folder_walk_stats
+ * @brief Counters of a walk.
+ */
+struct ca_folder_walk_stats {
+    ca_size_t files;            ///< Files reported.
+    ca_size_t directories;      ///< Directories listed, including the root.
+    ca_size_t errors;           ///< Directories below the root that could not be listed.
+};
+
+/**
+ * @brief Walks a directory tree in parallel and streams the files found to
+ *        a visitor.
+ *
+ * Every thread lists directories on its own deque, depth first, and steals
+ * the oldest directories of other threads when it runs dry, so wide and deep
+ * trees both keep all threads busy. Exclusions are applied before a
+ * directory is queued, so excluded subtrees are never opened. On Linux
+ * directories are read with `getdents64` in large batches.
+ *
+ * Files are reported as soon as their directory is listed; the order of the
+ * visitor calls is unspecified.
+ *
+ * @param root [in] The directory to walk. Must not be `nullptr`.
+ * @param options [in] Walk options.
+ * @param visitor [in] Receives every matching file.
+ * @param stats [out] Receives the counters of the walk. May be `nullptr`.
+ * @return `FILE_OK` if the root could be listed, otherwise the error listing it.
+ *         Errors below the root are only counted in `stats`.
+ */
+ca_file_result
+ca_folder_walk(const char *root, const ca_folder_walk_options &options, const ca_folder_visitor &visitor,
+               ca_folder_walk_stats *stats = nullptr);
+
+}
+
 #endif //CA_IO_FOLDER_H
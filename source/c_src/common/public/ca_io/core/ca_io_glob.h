@@ -0,0 +1,130 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_io/core/ca_io_glob.h
+//
+// @file
+// @brief Defines `ca_glob_set`, a `.gitignore`-style rule set compiled into
+//        one matcher for filtering paths.
+// ================================
+
+#ifndef CA_IO_GLOB_H
+#define CA_IO_GLOB_H
+
+#include "ca_math.h"
+
+#include <memory>
+#include <string_view>
+
+namespace ca::ca_io {
+
+namespace internal {
+struct ca_glob_matcher;
+}
+
+/**
+ * @enum ca_glob_result
+ * @brief Verdict of a `ca_glob_set` on a path.
+ */
+enum class ca_glob_result {
+    GLOB_NONE,          ///< No rule matches.
+    GLOB_EXCLUDED,      ///< The last matching rule excludes the path.
+    GLOB_INCLUDED,      ///< The last matching rule is a `!` rule re-including the path.
+};
+
+/**
+ * @struct ca_glob_set
+ * @brief A set of `.gitignore` rules compiled for matching many paths.
+ *
+ * A rule without `/` matches the name of an entry at any depth, a rule
+ * containing `/` matches the path relative to the root, a trailing `/`
+ * restricts it to directories and a leading `!` re-includes what earlier
+ * rules excluded. `*` and `?` do not match `/`, `**` as a whole component
+ * matches any number of directories, `[...]` matches a character class and
+ * `\` escapes the next character. The last matching rule wins.
+ *
+ * Rules are sorted by shape as they are added:
+ * - literal names (`.git`, `node_modules`) go to a hash table,
+ * - extension rules (`*.o`, `*.tar.gz`) go to a hash table of suffixes,
+ * - literal paths and literal directories with everything below them
+ *   (`/build`, and `third_party/` followed by `**`) go to a trie of path
+ *   components,
+ * - anything else is compiled into one bit-parallel NFA for names and one
+ *   for paths, which advance all such rules together by one step per byte.
+ *
+ * A match thus costs a few hash lookups and one pass over the path, however
+ * many rules there are.
+ *
+ * Only the path itself is judged; callers walking a tree prune excluded
+ * directories, so the files below them are never asked about.
+ *
+ * @note Matching is thread-safe; adding rules is not.
+ */
+struct ca_glob_set {
+    ca_glob_set();
+    ~ca_glob_set();
+
+    ca_glob_set(const ca_glob_set &other);
+    ca_glob_set &operator=(const ca_glob_set &other);
+    ca_glob_set(ca_glob_set &&other) noexcept;
+    ca_glob_set &operator=(ca_glob_set &&other) noexcept;
+
+    /**
+     * @brief Adds one rule.
+     *
+     * Blank lines and comments starting with `#` are ignored, as are
+     * unescaped trailing spaces.
+     *
+     * @param rule [in] The rule, in `.gitignore` syntax.
+     * @return `true` if a rule was added.
+     */
+    bool
+    add(std::string_view rule);
+
+    /**
+     * @brief Adds every line of a `.gitignore` file.
+     *
+     * @param text [in] Contents of the file.
+     * @return Number of rules added.
+     */
+    ca_size_t
+    add_lines(std::string_view text);
+
+    /**
+     * @brief Judges a path.
+     *
+     * @param relative_path [in] Path relative to the root, `/`-separated,
+     *                      without leading or trailing `/`.
+     * @param is_directory [in] Whether the path is a directory.
+     * @return The verdict of the last matching rule.
+     */
+    [[nodiscard]] ca_glob_result
+    match(std::string_view relative_path, bool is_directory) const;
+
+    /**
+     * @brief Checks if a path is excluded.
+     */
+    [[nodiscard]] bool
+    excluded(const std::string_view relative_path, const bool is_directory) const {
+        return match(relative_path, is_directory) == ca_glob_result::GLOB_EXCLUDED;
+    }
+
+    /**
+     * @brief Returns the number of rules.
+     */
+    [[nodiscard]] ca_size_t
+    size() const;
+
+    /**
+     * @brief Checks if the set has no rules.
+     */
+    [[nodiscard]] bool
+    empty() const {
+        return size() == 0;
+    }
+
+private:
+    std::unique_ptr<internal::ca_glob_matcher> matcher;     ///< The compiled rules.
+};
+
+}
+
+#endif //CA_IO_GLOB_H
@@ -2,38 +2,350 @@
 // CodeAnalyzer - source/c_src/common/public/ca_io/core/ca_io_path.h
 //
 // @file
-// @brief Defines function declarations for path operations.
+// @brief Defines `ca_io_path`, a path with inline storage whose operations
+//        do not allocate, and `ca_path_table`, which interns normalized paths
+//        as 32-bit ids.
 // ================================
 
 #ifndef CA_IO_PATH_H
 #define CA_IO_PATH_H
 
-//TODO
+#include "ca_intern_pool.h"
+#include "ca_math.h"
+
+#include <shared_mutex>
+#include <string_view>
+
 namespace ca::ca_io {
-class ca_io_path {
-public:
-    explicit ca_io_path(const char* path);
-    ca_io_path join(const char* path) const;
-    ca_io_path parent() const;
-    char* name() const;
-    char* suffix() const;
-    char* stem() const;
-    bool is_absolute() const;
-    ca_io_path to_absolute() const;
-    ca_io_path normalize() const;
-    char* as_posix() const;
-    char* as_windows() const;
-    bool is_valid() const;
-    bool exists() const;
+
+/**
+ * @struct ca_io_path
+ * @brief A file system path stored inline.
+ *
+ * Paths of up to `INLINE_CAPACITY` bytes live inside the object, so creating,
+ * copying, joining and normalizing typical paths never touches the heap;
+ * longer paths spill to a heap buffer. The components returned by `name`,
+ * `stem`, `suffix` and `parent` are views into the path, valid until it is
+ * modified.
+ *
+ * On Windows both `/` and `\` separate components and paths may start with a
+ * drive or a UNC prefix; elsewhere only `/` is a separator.
+ *
+ * The path is always null terminated, so `c_str` can be passed to the system.
+ */
+struct ca_io_path {
+    /**
+     * @brief Longest path stored without allocating, in bytes.
+     */
+    static constexpr ca_size_t INLINE_CAPACITY = 231;
+
+#ifdef _WIN32
+    static constexpr char PREFERRED_SEPARATOR = '\\';  ///< Separator written by `normalize` and `append`.
+#else
+    static constexpr char PREFERRED_SEPARATOR = '/';   ///< Separator written by `normalize` and `append`.
+#endif
+
+    /**
+     * @brief Constructs an empty path.
+     */
+    ca_io_path() noexcept;
+
+    /**
+     * @brief Constructs a path from a string.
+     *
+     * @param path The path.
+     */
+    explicit ca_io_path(std::string_view path);
+
+    /**
+     * @brief Constructs a path from a null-terminated string.
+     *
+     * @param path [in] The path. Must not be `nullptr`.
+     */
+    explicit ca_io_path(const char *path);
+
+    ~ca_io_path();
+
+    ca_io_path(const ca_io_path &other);
+    ca_io_path &operator=(const ca_io_path &other);
+    ca_io_path(ca_io_path &&other) noexcept;
+    ca_io_path &operator=(ca_io_path &&other) noexcept;
+
+    /**
+     * @brief Replaces the path.
+     *
+     * @param path The new path. May view this path.
+     * @return This path.
+     */
+    ca_io_path &
+    assign(std::string_view path);
+
+    /**
+     * @brief Appends a component in place, adding a separator if needed.
+     *
+     * An absolute `path` replaces this path, as in `pathlib`.
+     *
+     * @param path The path to append. May view this path.
+     * @return This path.
+     */
+    ca_io_path &
+    append(std::string_view path);
+
+    /**
+     * @brief Returns this path with a component appended.
+     *
+     * @param path The path to append.
+     * @return The joined path.
+     */
+    [[nodiscard]] ca_io_path
+    join(std::string_view path) const;
+
+    /**
+     * @brief Returns the path without its last component.
+     *
+     * The parent of a root is the root itself, and the parent of a single
+     * relative component is empty.
+     */
+    [[nodiscard]] std::string_view
+    parent() const;
+
+    /**
+     * @brief Returns the last component, empty for a root.
+     */
+    [[nodiscard]] std::string_view
+    name() const;
+
+    /**
+     * @brief Returns the last component without its suffix.
+     */
+    [[nodiscard]] std::string_view
+    stem() const;
+
+    /**
+     * @brief Returns the suffix of the last component, including the dot.
+     *
+     * Empty if the name has no dot, or only a leading one as in `.gitignore`.
+     */
+    [[nodiscard]] std::string_view
+    suffix() const;
+
+    /**
+     * @brief Checks if the path starts at a root: `/` on POSIX systems, a
+     *        drive followed by a separator or a UNC prefix on Windows.
+     */
+    [[nodiscard]] bool
+    is_absolute() const;
+
+    /**
+     * @brief Normalizes the path lexically, in place.
+     *
+     * Repeated separators and `.` components are removed, `..` removes the
+     * component before it, and separators become `PREFERRED_SEPARATOR`.
+     * Leading `..` components of relative paths are kept; those of absolute
+     * paths are dropped. An empty result becomes `.`. Symbolic links are not
+     * resolved.
+     *
+     * @return This path.
+     */
+    ca_io_path &
+    normalize();
+
+    /**
+     * @brief Makes the path absolute by prepending the current directory, then
+     *        normalizes it.
+     *
+     * @return `0` on success, or `-1` if the current directory is unavailable,
+     *         in which case the path is unchanged.
+     */
+    int
+    make_absolute();
+
+    /**
+     * @brief Replaces every `\` with `/`, in place.
+     *
+     * @return This path.
+     */
+    ca_io_path &
+    make_posix();
+
+    /**
+     * @brief Replaces every `/` with `\`, in place.
+     *
+     * @return This path.
+     */
+    ca_io_path &
+    make_windows();
+
+    /**
+     * @brief Checks if the path is non-empty and holds no null bytes and, on
+     *        Windows, none of the reserved characters `<>"|?*` nor a `:`
+     *        outside the drive.
+     */
+    [[nodiscard]] bool
+    is_valid() const;
+
+    /**
+     * @brief Checks if something exists at the path.
+     */
+    [[nodiscard]] bool
+    exists() const;
+
+    /**
+     * @brief Returns the path as a string view.
+     */
+    [[nodiscard]] std::string_view
+    view() const;
+
+    /**
+     * @brief Returns the null-terminated path.
+     */
+    [[nodiscard]] const char *
+    c_str() const;
+
+    /**
+     * @brief Returns the length of the path in bytes.
+     */
+    [[nodiscard]] ca_size_t
+    size() const;
+
+    /**
+     * @brief Checks if the path is empty.
+     */
+    [[nodiscard]] bool
+    empty() const;
+
+    /**
+     * @brief Checks if the path is stored inline rather than on the heap.
+     */
+    [[nodiscard]] bool
+    is_inline() const;
+
+    /**
+     * @brief Checks if a character separates components on this platform.
+     */
+    static constexpr bool
+    is_separator(char c);
+
+    /**
+     * @brief Returns the current working directory.
+     *
+     * @param path [out] Receives the directory. Must not be `nullptr`.
+     * @return `0` on success, `-1` on failure.
+     */
+    static int
+    current_directory(ca_io_path *path);
+
+    friend bool
+    operator==(const ca_io_path &lhs, const ca_io_path &rhs);
 
 private:
-    const char* path;
-    const bool isWindows;
+    /**
+     * @brief Ensures room for `capacity` bytes plus the null terminator,
+     *        keeping the contents.
+     */
+    void
+    reserve(ca_size_t capacity);
+
+    [[nodiscard]] char *
+    data();
+
+    char *heap;                             ///< Heap storage, `nullptr` while inline.
+    ca_size_t len;                          ///< Length of the path.
+    ca_size_t cap;                          ///< Capacity of `heap`, excluding the terminator.
+    char local[INLINE_CAPACITY + 1];        ///< Inline storage.
+};
+
+/**
+ * @typedef ca_path_id
+ * @brief Id of a path interned in a `ca_path_table`.
+ */
+typedef ca_string::ca_intern_pool::id_type ca_path_id;
+
+/**
+ * @struct ca_path_table
+ * @brief A thread-safe table of normalized paths identified by dense ids.
+ *
+ * Paths are normalized before they are interned, so different spellings of
+ * the same path get the same id. Ids are assigned densely from 0, so include
+ * graphs and caches can key on them and index side tables directly. Paths
+ * stay in the table until it is destroyed, so views of them never dangle.
+ *
+ * Lookups of known paths only take a shared lock.
+ */
+struct ca_path_table {
+    /**
+     * @brief Id returned by `find` for paths that are not interned.
+     */
+    static constexpr ca_path_id INVALID_ID = ca_string::ca_intern_pool::INVALID_ID;
 
-    static char preferred_separator() const;
-    static char* normalize_path(const char* path) const;
-    static bool validate_path(const char* path) const;
+    ca_path_table() = default;
+
+    ca_path_table(const ca_path_table &) = delete;
+    ca_path_table &operator=(const ca_path_table &) = delete;
+
+    /**
+     * @brief Interns a path, normalizing it first.
+     *
+     * @param path The path.
+     * @return The id of the normalized path.
+     */
+    ca_path_id
+    intern(std::string_view path);
+
+    /**
+     * @brief Interns a path that is already normalized.
+     *
+     * @param path The normalized path.
+     * @return The id of the path.
+     */
+    ca_path_id
+    intern_normalized(std::string_view path);
+
+    /**
+     * @brief Looks up a path without interning it, normalizing it first.
+     *
+     * @param path The path.
+     * @return The id of the normalized path, or `INVALID_ID` if it is not interned.
+     */
+    [[nodiscard]] ca_path_id
+    find(std::string_view path) const;
+
+    /**
+     * @brief Returns an interned path, valid for the lifetime of the table.
+     *
+     * The view is followed by a null terminator.
+     *
+     * @param id The id of the path. Must have been returned by this table.
+     */
+    [[nodiscard]] std::string_view
+    view(ca_path_id id) const;
+
+    /**
+     * @brief Returns the number of distinct paths.
+     */
+    [[nodiscard]] ca_size_t
+    size() const;
+
+    /**
+     * @brief Returns the process-wide table.
+     */
+    static ca_path_table &
+    global();
+
+private:
+    mutable std::shared_mutex mutex;        ///< Guards `pool`.
+    ca_string::ca_intern_pool pool;         ///< The normalized paths.
 };
+
+constexpr bool
+ca_io_path::is_separator(const char c) {
+#ifdef _WIN32
+    return c == '/' || c == '\\';
+#else
+    return c == '/';
+#endif
+}
+
 }
 
 #endif //CA_IO_PATH_H
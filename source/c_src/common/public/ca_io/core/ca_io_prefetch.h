@@ -0,0 +1,180 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_io/core/ca_io_prefetch.h
+//
+// @file
+// @brief Defines `ca_prefetcher`, which warms the page cache for the files
+//        the analysis will read next, following its schedule.
+// ================================
+
+#ifndef CA_IO_PREFETCH_H
+#define CA_IO_PREFETCH_H
+
+#include "core/file_defs.h"
+#include "core/rw/ca_io_file_rw_sync.h"
+#include "ca_math.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ca::ca_io {
+
+/**
+ * @struct ca_prefetch_options
+ * @brief Controls a `ca_prefetcher`.
+ */
+struct ca_prefetch_options {
+    /**
+     * @brief Files hinted ahead of the consumers, counted from the number of
+     *        files acquired so far.
+     */
+    ca_size_t distance = 32;
+
+    /**
+     * @brief Bytes hinted but not acquired yet above which hinting pauses.
+     *        The last hint may overshoot it by one file.
+     */
+    ca_size_t memory_budget = 256 * 1024 * 1024;
+
+    ca_file_read_options read;      ///< Options of the loads in `acquire`.
+};
+
+/**
+ * @struct ca_prefetch_stats
+ * @brief Counters of a `ca_prefetcher`.
+ */
+struct ca_prefetch_stats {
+    ca_size_t hinted;           ///< Files hinted.
+    ca_size_t hinted_bytes;     ///< Bytes hinted.
+    ca_size_t acquired;         ///< Files acquired.
+    ca_size_t stalls;           ///< Files acquired before their hint was issued, i.e. read cold.
+    ca_uint64_t read_ns;        ///< Time spent loading in `acquire`, in nanoseconds.
+};
+
+/**
+ * @struct ca_prefetcher
+ * @brief Hints the kernel to read files ahead of the parsers.
+ *
+ * The analysis schedules the files it will read, in the order it will read
+ * them, e.g. from the compile command list or the include graph, and loads
+ * them through `acquire`. A background thread walks the schedule up to
+ * `distance` files ahead of the acquired count and asks the kernel to start
+ * reading each of them: `readahead` on Linux, `posix_fadvise` with
+ * `POSIX_FADV_WILLNEED` on other POSIX systems, and `PrefetchVirtualMemory`
+ * over a mapping on Windows. The hints do not block the parsers and do not
+ * hold any memory in the process; the page cache keeps the data until it is
+ * read.
+ *
+ * Hinting pauses while the files hinted but not yet acquired exceed the
+ * memory budget, so the prefetcher cannot evict its own work from the page
+ * cache. The `stalls` counter tells how often a parser loaded a file that
+ * was not hinted yet; with a good distance it stays near 0.
+ */
+struct ca_prefetcher {
+    /**
+     * @brief Constructs a prefetcher with an empty schedule and starts its
+     *        thread.
+     *
+     * @param options Prefetch options.
+     */
+    explicit ca_prefetcher(const ca_prefetch_options &options = {});
+
+    /**
+     * @brief Stops the thread; pending hints are dropped.
+     */
+    ~ca_prefetcher();
+
+    ca_prefetcher(const ca_prefetcher &) = delete;
+    ca_prefetcher &operator=(const ca_prefetcher &) = delete;
+
+    /**
+     * @brief Appends files to the schedule.
+     *
+     * @param paths The files, in the order they will be acquired.
+     * @return The index of the first appended file.
+     */
+    ca_size_t
+    schedule(std::span<const std::string> paths);
+
+    /**
+     * @brief Loads a scheduled file, moving the prefetch window forward.
+     *
+     * Consumers may acquire files from several threads and somewhat out of
+     * order; the window follows the number of files acquired.
+     *
+     * @param index [in] Index of the file in the schedule.
+     * @param view [out] Receives the contents. Must not be `nullptr`.
+     * @return The result of `ca_file_read`.
+     */
+    ca_file_result
+    acquire(ca_size_t index, ca_file_view *view);
+
+    /**
+     * @brief Returns the path of a scheduled file.
+     *
+     * @param index Index of the file in the schedule.
+     */
+    [[nodiscard]] std::string
+    path(ca_size_t index) const;
+
+    /**
+     * @brief Returns the number of scheduled files.
+     */
+    [[nodiscard]] ca_size_t
+    size() const;
+
+    /**
+     * @brief Returns the counters of the prefetcher.
+     */
+    [[nodiscard]] ca_prefetch_stats
+    stats() const;
+
+private:
+    /**
+     * @brief States of a scheduled file.
+     */
+    enum class file_state : ca_uint8_t {
+        PENDING,        ///< Not hinted nor acquired.
+        HINTING,        ///< Being hinted.
+        HINTED,         ///< Hinted, counted in `outstanding_bytes`.
+        ACQUIRED,       ///< Acquired.
+    };
+
+    /**
+     * @brief A scheduled file.
+     */
+    struct entry {
+        std::string path;           ///< Path of the file.
+        ca_size_t size;             ///< Bytes hinted, while `HINTED`.
+        file_state state;           ///< State of the file.
+    };
+
+    /**
+     * @brief Checks if the next file may be hinted. `mutex` must be held.
+     */
+    [[nodiscard]] bool
+    can_hint() const;
+
+    /**
+     * @brief Runs the hinting thread.
+     */
+    void
+    run();
+
+    ca_prefetch_options options;            ///< Prefetch options.
+    mutable std::mutex mutex;               ///< Guards the members below.
+    std::condition_variable wakeup;         ///< Signaled on new work and on stop.
+    std::vector<entry> files;               ///< The schedule.
+    ca_size_t next_hint;                    ///< Next file to consider for hinting.
+    ca_size_t outstanding_bytes;            ///< Bytes hinted but not acquired.
+    ca_prefetch_stats counters;             ///< Counters.
+    bool stopping;                          ///< Whether the thread should exit.
+    std::thread thread;                     ///< The hinting thread.
+};
+
+}
+
+#endif //CA_IO_PREFETCH_H
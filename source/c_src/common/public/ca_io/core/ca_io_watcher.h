@@ -0,0 +1,150 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_io/core/ca_io_watcher.h
+//
+// @file
+// @brief Defines `ca_file_watcher`, which watches a directory tree and
+//        reports debounced batches of changed files.
+// ================================
+
+#ifndef CA_IO_WATCHER_H
+#define CA_IO_WATCHER_H
+
+#include "core/ca_io_path.h"
+#include "core/file_defs.h"
+#include "ca_math.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ca::ca_io {
+
+namespace internal {
+struct ca_watch_backend;
+}
+
+/**
+ * @struct ca_watch_options
+ * @brief Controls a `ca_file_watcher`.
+ */
+struct ca_watch_options {
+    /**
+     * @brief Extensions of the files to report, including the dot, e.g.
+     *        `".c"`. All files are reported if empty.
+     */
+    std::vector<std::string> extensions;
+
+    bool include_hidden = false;        ///< Whether names starting with `.` are watched.
+    ca_size_t debounce_ms = 50;         ///< Quiet time after the last event before a batch is delivered.
+    ca_size_t max_delay_ms = 500;       ///< Longest time a change waits during a continuous burst.
+    ca_path_table *table = nullptr;     ///< Table interning the changed paths, `global()` if `nullptr`.
+};
+
+/**
+ * @struct ca_watch_batch
+ * @brief Files changed during one burst of events.
+ */
+struct ca_watch_batch {
+    std::vector<std::string> paths;     ///< Root joined with the relative paths of the files, sorted, unique.
+    std::vector<ca_path_id> ids;        ///< Ids of `paths[i]` in the path table, at index `i`.
+
+    /**
+     * @brief Whether events were lost, because the kernel queue overflowed
+     *        or a directory was moved away. The consumer must then rescan
+     *        the tree, e.g. with `ca_metadata_snapshot_diff`; `paths` only
+     *        holds the changes that were seen.
+     */
+    bool rescan;
+};
+
+/**
+ * @typedef ca_watch_callback
+ * @brief Receives the batches of a `ca_file_watcher`, on its thread.
+ */
+typedef std::function<void(const ca_watch_batch &batch)> ca_watch_callback;
+
+/**
+ * @struct ca_file_watcher
+ * @brief Watches a directory tree and reports the files created, written,
+ *        moved or deleted in it.
+ *
+ * On Linux every directory of the tree gets an inotify watch, registered
+ * before the directory is listed so nothing created meanwhile is missed;
+ * directories created or moved in later are registered as they appear and
+ * their files reported. Files are reported when they are closed after
+ * writing, moved or deleted, so an editor saving through a temporary file
+ * and a rename yields a single change.
+ *
+ * Events are coalesced into a set of paths that is delivered once no event
+ * arrived for `debounce_ms`, or at the latest `max_delay_ms` after the first
+ * event of the burst. Each path is interned in the path table, so caches
+ * keyed on path ids can drop exactly the changed entries; `ca_file_cache` is
+ * keyed on file stamps and needs no invalidation.
+ *
+ * Other platforms are not supported yet: `start` returns
+ * `FILE_ERROR_NOT_SUPPORTED`.
+ */
+struct ca_file_watcher {
+    ca_file_watcher();
+
+    /**
+     * @brief Stops watching.
+     */
+    ~ca_file_watcher();
+
+    ca_file_watcher(const ca_file_watcher &) = delete;
+    ca_file_watcher &operator=(const ca_file_watcher &) = delete;
+
+    /**
+     * @brief Registers the tree and starts delivering batches.
+     *
+     * @param root [in] The directory to watch. Must not be `nullptr`.
+     * @param options [in] Watch options.
+     * @param callback [in] Receives the batches on the watcher's thread.
+     * @return `FILE_OK` on success, `FILE_ERROR_NOT_SUPPORTED` without a
+     *         platform backend, `FILE_ERROR_BUSY` if already started, or the
+     *         error registering the root.
+     */
+    ca_file_result
+    start(const char *root, const ca_watch_options &options, const ca_watch_callback &callback);
+
+    /**
+     * @brief Stops watching, dropping changes not delivered yet. Must not be
+     *        called from the callback.
+     */
+    void
+    stop();
+
+    /**
+     * @brief Checks if the watcher is started.
+     */
+    [[nodiscard]] bool
+    is_running() const;
+
+private:
+    /**
+     * @brief Runs the watcher's thread: collects events and delivers batches.
+     */
+    void
+    run();
+
+    /**
+     * @brief Delivers the collected changes and clears them.
+     */
+    void
+    deliver(std::vector<std::string> *changed, bool *rescan);
+
+    std::unique_ptr<internal::ca_watch_backend> backend;   ///< Platform event source.
+    std::string root;                                       ///< Root without trailing separators.
+    ca_watch_options options;                               ///< Watch options.
+    ca_watch_callback callback;                             ///< Receives the batches.
+    std::atomic<bool> stopping;                             ///< Whether the thread should exit.
+    std::thread thread;                                     ///< The watcher's thread.
+};
+
+}
+
+#endif //CA_IO_WATCHER_H
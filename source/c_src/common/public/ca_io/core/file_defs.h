@@ -0,0 +1,54 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_io/core/file_defs.h
+//
+// @file
+// @brief Defines the file open modes and result codes shared by all file
+//        I/O operations.
+// ================================
+
+#ifndef CA_FILE_DEFS_H
+#define CA_FILE_DEFS_H
+
+namespace ca::ca_io {
+
+/**
+ * @enum ca_file_mode
+ * @brief Modes a file can be opened with.
+ *
+ * Modes without the `_EXISTING` suffix create the file if it does not exist.
+ */
+enum class ca_file_mode {
+    FILE_MODE_READ,                     ///< Read only.
+    FILE_MODE_WRITE,                    ///< Write only, creating or truncating the file.
+    FILE_MODE_APPEND,                   ///< Append only, creating the file.
+    FILE_MODE_READ_WRITE,               ///< Read and write, creating the file.
+    FILE_MODE_READ_EXISTING,            ///< Read only an existing file.
+    FILE_MODE_WRITE_EXISTING,           ///< Write only an existing file.
+    FILE_MODE_READ_WRITE_EXISTING,      ///< Read and write an existing file.
+    FILE_MODE_APPEND_EXISTING,          ///< Append only to an existing file.
+    FILE_MODE_TRUNCATE_WRITE,           ///< Write only an existing file, truncating it.
+    FILE_MODE_TRUNCATE_READ_WRITE,      ///< Read and write an existing file, truncating it.
+};
+
+/**
+ * @enum ca_file_result
+ * @brief Results of file operations, translated from the platform errors.
+ */
+enum class ca_file_result {
+    FILE_OK,                            ///< The operation succeeded.
+    FILE_ERROR_NOT_FOUND,               ///< The file or a directory of its path does not exist.
+    FILE_ERROR_ACCESS_DENIED,           ///< Missing permissions, read-only media, or a directory.
+    FILE_ERROR_ALREADY_EXISTS,          ///< The file exists but was required not to.
+    FILE_ERROR_INVALID_HANDLE,          ///< The file handle is not open.
+    FILE_ERROR_IO_ERROR,                ///< The device reported an error.
+    FILE_ERROR_OUT_OF_MEMORY,           ///< Out of memory or file handles.
+    FILE_ERROR_INVALID_PARAMETER,       ///< An argument was rejected by the system.
+    FILE_ERROR_NOT_SUPPORTED,           ///< The operation is not supported for this file.
+    FILE_ERROR_DISK_FULL,               ///< No space is left on the device.
+    FILE_ERROR_BUSY,                    ///< The file is in use.
+    FILE_ERROR_GENERIC,                 ///< Any other error.
+};
+
+}
+
+#endif //CA_FILE_DEFS_H
@@ -1,9 +1,139 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_io/core/rw/ca_io_file_rw_asyn.h
 //
-// Created by Eden_ on 25-4-29.
-//
+// @file
+// @brief Defines asynchronous batch file reading, backed by io_uring on
+//        Linux and by a pool of threads reading synchronously elsewhere.
+// ================================
 
 #ifndef CA_IO_RW_ASYN_H
 #define CA_IO_RW_ASYN_H
 
+#include "core/file_defs.h"
+#include "core/rw/ca_io_file_rw_sync.h"
+#include "ca_math.h"
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+
+namespace ca::ca_io {
+
+namespace internal {
+struct ca_async_backend;
+}
+
+/**
+ * @typedef ca_async_read_callback
+ * @brief Receives the outcome of one asynchronous read.
+ *
+ * The arguments are the index of the path in its batch, the result of the
+ * read, and the contents, which are empty unless the result is `FILE_OK`.
+ * Callbacks run on the reader's own threads and should be short, e.g. hand
+ * the view over to a parser queue.
+ */
+typedef std::function<void(ca_size_t index, ca_file_result result, ca_file_view &&view)> ca_async_read_callback;
+
+/**
+ * @struct ca_async_read_result
+ * @brief Outcome of a read through `ca_async_file_reader::read`.
+ */
+struct ca_async_read_result {
+    ca_file_result result;      ///< Result of the read.
+    ca_file_view view;          ///< Contents of the file, empty on error.
+};
+
+/**
+ * @struct ca_async_reader_options
+ * @brief Controls a `ca_async_file_reader`.
+ */
+struct ca_async_reader_options {
+    ca_size_t queue_depth = 256;        ///< Files in flight at once with io_uring.
+    ca_size_t num_threads = 0;          ///< Threads of the fallback, 0 for one per hardware thread.
+    bool use_io_uring = true;           ///< Whether io_uring is used when the kernel supports it.
+    ca_file_read_options read;          ///< Options of the fallback reads; `read.pool` serves both backends.
+};
+
+/**
+ * @struct ca_async_file_reader
+ * @brief Reads whole files in the background and delivers their contents
+ *        to callbacks or futures.
+ *
+ * On Linux with io_uring, every file goes through `openat`, `statx`, `read`
+ * and `close` submitted to one ring, with the `openat` and `statx` of a file
+ * issued together and up to `queue_depth` files in flight, so that the
+ * latency of cold reads overlaps instead of adding up. Files are read into
+ * buffers of the pool; files of unknown size, such as pipes, are read with
+ * `ca_file_read` by a pool of `num_threads` threads started on first use.
+ *
+ * Without io_uring, or when it is disabled, a pool of threads loads the files
+ * with `ca_file_read`, which memory maps large files.
+ *
+ * The destructor waits for all submitted reads to complete.
+ */
+struct ca_async_file_reader {
+    /**
+     * @brief Constructs a reader and starts its threads.
+     *
+     * @param options Reader options.
+     */
+    explicit ca_async_file_reader(const ca_async_reader_options &options = {});
+
+    ~ca_async_file_reader();
+
+    ca_async_file_reader(const ca_async_file_reader &) = delete;
+    ca_async_file_reader &operator=(const ca_async_file_reader &) = delete;
+
+    /**
+     * @brief Queues a batch of files for reading.
+     *
+     * The paths are copied, so they need not outlive the call.
+     *
+     * @param paths The files to read.
+     * @param callback Called once for every path, in completion order.
+     */
+    void
+    read_batch(std::span<const std::string> paths, const ca_async_read_callback &callback);
+
+    /**
+     * @brief Queues a single file for reading.
+     *
+     * @param path [in] Path of the file. Must not be `nullptr`.
+     * @return A future receiving the outcome of the read.
+     */
+    std::future<ca_async_read_result>
+    read(const char *path);
+
+    /**
+     * @brief Blocks until every read submitted so far has completed and its
+     *        callback has returned.
+     */
+    void
+    wait();
+
+    /**
+     * @brief Checks if the reader uses io_uring rather than the thread pool.
+     */
+    [[nodiscard]] bool
+    uses_io_uring() const;
+
+private:
+    /**
+     * @brief Marks one read as completed.
+     */
+    void
+    complete_one();
+
+    std::unique_ptr<internal::ca_async_backend> backend;    ///< Backend running the reads.
+    std::mutex mutex;                                       ///< Guards `pending`.
+    std::condition_variable idle;                           ///< Signaled when `pending` drops to 0.
+    ca_size_t pending;                                      ///< Reads submitted but not completed.
+};
+
+}
 
 #endif //CA_IO_RW_ASYN_H
@@ -1,8 +1,212 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_io/core/rw/ca_io_file_rw_sync.h
 //
-// Created by Eden_ on 25-4-29.
-//
+// @file
+// @brief Defines synchronous whole-file reading into read-only `ca_buffer`
+//        views, backed by memory mapping or by pooled read buffers.
+// ================================
 
 #ifndef CA_IO_RW_SYNC_H
 #define CA_IO_RW_SYNC_H
 
+#include "core/file_defs.h"
+#include "ca_buffer.h"
+#include "ca_char_types.h"
+#include "ca_math.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ca::ca_io {
+
+namespace internal {
+struct ca_file_view_access;
+}
+
+/**
+ * @struct ca_io_buffer_pool
+ * @brief A thread-safe pool of read buffers, recycled between file reads.
+ *
+ * Buffers are handed out in power of two size classes starting at
+ * `MIN_BLOCK_SIZE`, so reading many small files of similar sizes reuses the
+ * same few allocations instead of hitting the allocator for every file.
+ * Released buffers are kept until `max_cached_bytes` is reached and freed
+ * beyond that.
+ */
+struct ca_io_buffer_pool {
+    /**
+     * @brief Smallest buffer handed out, in bytes.
+     */
+    static constexpr ca_size_t MIN_BLOCK_SIZE = 4 * 1024;
+
+    /**
+     * @brief Default limit of the bytes kept in the pool.
+     */
+    static constexpr ca_size_t DEFAULT_MAX_CACHED_BYTES = 16 * 1024 * 1024;
+
+    /**
+     * @brief Constructs an empty pool.
+     *
+     * @param max_cached_bytes Maximum total size of the buffers kept for reuse.
+     */
+    explicit ca_io_buffer_pool(ca_size_t max_cached_bytes = DEFAULT_MAX_CACHED_BYTES);
+
+    ca_io_buffer_pool(const ca_io_buffer_pool &) = delete;
+    ca_io_buffer_pool &operator=(const ca_io_buffer_pool &) = delete;
+
+    /**
+     * @brief Takes a buffer of at least `size` bytes out of the pool.
+     *
+     * @param size [in] Number of bytes needed.
+     * @param capacity [out] Receives the actual size of the buffer, to be
+     *                 passed back to `release`. Must not be `nullptr`.
+     * @return The buffer.
+     */
+    ca_string::ca_char_t *
+    acquire(ca_size_t size, ca_size_t *capacity);
+
+    /**
+     * @brief Returns a buffer obtained from `acquire` to the pool.
+     *
+     * @param block The buffer. Ignored if `nullptr`.
+     * @param capacity The capacity reported by `acquire`.
+     */
+    void
+    release(ca_string::ca_char_t *block, ca_size_t capacity);
+
+    /**
+     * @brief Returns the total size of the buffers currently kept for reuse.
+     */
+    [[nodiscard]] ca_size_t
+    cached_bytes() const;
+
+    /**
+     * @brief Returns the process-wide pool used when no pool is given.
+     */
+    static ca_io_buffer_pool &
+    global();
+
+private:
+    /**
+     * @brief Returns the size class of a capacity.
+     */
+    static ca_size_t
+    class_of(ca_size_t capacity);
+
+    mutable std::mutex mutex;                                       ///< Guards the free lists.
+    std::vector<std::vector<std::unique_ptr<ca_string::ca_char_t[]>>> free_lists;  ///< Free buffers per size class.
+    ca_size_t cached;                                               ///< Bytes held in the free lists.
+    ca_size_t max_cached;                                           ///< Limit of `cached`.
+};
+
+/**
+ * @struct ca_file_read_options
+ * @brief Controls how `ca_file_read` loads a file.
+ */
+struct ca_file_read_options {
+    /**
+     * @brief Regular files of at least this many bytes are memory mapped;
+     *        smaller files are read, since copying them is cheaper than
+     *        setting up and faulting in a mapping.
+     */
+    ca_size_t mmap_threshold = 64 * 1024;
+
+    bool sequential = true;                 ///< Hint that the mapping is read front to back.
+    bool will_need = true;                  ///< Hint to start reading the mapping ahead.
+    ca_io_buffer_pool *pool = nullptr;      ///< Pool of read buffers, `global()` if `nullptr`.
+};
+
+/**
+ * @struct ca_file_view
+ * @brief Owns the contents of a file loaded by `ca_file_read`.
+ *
+ * The contents are either a private read-only memory mapping of the file or
+ * a buffer of a `ca_io_buffer_pool`, and are released when the view is
+ * destroyed or reset. In both cases the lexer reads the bytes in place.
+ *
+ * @note The bytes must not be modified, even through `buffer()`: mapped
+ *       pages are read-only.
+ */
+struct ca_file_view {
+    /**
+     * @brief Constructs an empty view.
+     */
+    ca_file_view();
+
+    ~ca_file_view();
+
+    ca_file_view(const ca_file_view &) = delete;
+    ca_file_view &operator=(const ca_file_view &) = delete;
+    ca_file_view(ca_file_view &&other) noexcept;
+    ca_file_view &operator=(ca_file_view &&other) noexcept;
+
+    /**
+     * @brief Returns a `ca_buffer` over the contents, valid while the view
+     *        holds them.
+     */
+    [[nodiscard]] ca_string::ca_buffer<ca_string::ca_encoding_t::CA_ENCODING_UTF8>
+    buffer() const;
+
+    /**
+     * @brief Returns a pointer to the contents, `nullptr` if the view is empty.
+     */
+    [[nodiscard]] const ca_string::ca_char_t *
+    data() const;
+
+    /**
+     * @brief Returns the size of the contents in bytes.
+     */
+    [[nodiscard]] ca_size_t
+    size() const;
+
+    /**
+     * @brief Checks if the view holds no bytes.
+     */
+    [[nodiscard]] bool
+    empty() const;
+
+    /**
+     * @brief Checks if the contents are memory mapped rather than read.
+     */
+    [[nodiscard]] bool
+    is_mapped() const;
+
+    /**
+     * @brief Releases the contents, leaving the view empty.
+     */
+    void
+    reset();
+
+private:
+    friend struct internal::ca_file_view_access;
+
+    ca_string::ca_char_t *ptr;              ///< Start of the contents.
+    ca_size_t len;                          ///< Size of the contents.
+    ca_size_t capacity;                     ///< Size of the pooled buffer, or of the mapping.
+    ca_io_buffer_pool *pool;                ///< Pool owning `ptr`, `nullptr` if mapped or empty.
+    bool mapped;                            ///< Whether `ptr` is a mapping.
+};
+
+/**
+ * @brief Loads the whole contents of a file.
+ *
+ * Regular files of at least `options.mmap_threshold` bytes are memory mapped
+ * with sequential and read-ahead hints, so files already in the page cache
+ * load without copying. Smaller files, files that cannot be mapped, and
+ * files of unknown size such as pipes and character devices are read into a
+ * buffer of the pool.
+ *
+ * @param path [in] Path of the file. Must not be `nullptr`.
+ * @param view [out] Receives the contents; its previous contents are released
+ *             first. Must not be `nullptr`.
+ * @param options [in] Loading options.
+ * @return `FILE_OK` on success, or the error that stopped the read, in which
+ *         case `view` is left empty.
+ */
+ca_file_result
+ca_file_read(const char *path, ca_file_view *view, const ca_file_read_options &options = {});
+
+}
+
 #endif //CA_IO_RW_SYNC_H
@@ -0,0 +1,168 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_io/core/rw/ca_io_file_writer.h
+//
+// @file
+// @brief Defines `ca_file_writer`, a buffered writer gathering copied and
+//        borrowed fragments into vectored writes, with optional background
+//        flushing and atomic replacement of the target file.
+// ================================
+
+#ifndef CA_IO_FILE_WRITER_H
+#define CA_IO_FILE_WRITER_H
+
+#include "core/file_defs.h"
+#include "ca_buffer.h"
+#include "ca_char_types.h"
+#include "ca_math.h"
+
+#include <memory>
+#include <string_view>
+
+namespace ca::ca_io {
+
+namespace internal {
+struct ca_writer_state;
+}
+
+/**
+ * @struct ca_file_writer_options
+ * @brief Controls a `ca_file_writer`.
+ */
+struct ca_file_writer_options {
+    /**
+     * @brief Bytes gathered, copied or borrowed, before a batch is written.
+     */
+    ca_size_t buffer_size = 8 * 1024 * 1024;
+
+    bool async_flush = false;       ///< Whether batches are written by a background thread.
+    bool atomic_replace = true;     ///< Whether the target is only replaced by `commit`.
+    bool sync_on_commit = false;    ///< Whether `commit` flushes the file to the device.
+};
+
+/**
+ * @struct ca_file_writer
+ * @brief Writes a file from many small fragments with few system calls.
+ *
+ * Fragments written with `write` are copied into chunks of the writer, and
+ * consecutive copies share one segment. Fragments written with
+ * `write_borrowed` are referenced in place, so large buffers, such as file
+ * contents or interned strings, are never copied. Segments are gathered
+ * into a batch of up to `buffer_size` bytes that is written with one
+ * `pwritev` per `IOV_MAX` segments.
+ *
+ * With `async_flush`, batches are written by a background thread while the
+ * caller keeps producing the next one; at most two batches wait, which
+ * bounds the memory used. With `atomic_replace`, the data goes to a
+ * temporary file in the target's directory that `commit` renames over the
+ * target, so readers never observe a partial file.
+ *
+ * @note Borrowed bytes must stay valid and unchanged until the next `flush`,
+ *       `commit` or `discard` returns.
+ */
+struct ca_file_writer {
+    ca_file_writer();
+
+    /**
+     * @brief Commits a non-atomic writer, or discards an atomic writer that
+     *        was not committed.
+     */
+    ~ca_file_writer();
+
+    ca_file_writer(const ca_file_writer &) = delete;
+    ca_file_writer &operator=(const ca_file_writer &) = delete;
+
+    /**
+     * @brief Opens the target, or the temporary file replacing it.
+     *
+     * @param path [in] Path of the target. Must not be `nullptr`.
+     * @param options [in] Writer options.
+     * @return `FILE_OK` on success, `FILE_ERROR_BUSY` if already open, or the
+     *         error creating the file.
+     */
+    ca_file_result
+    open(const char *path, const ca_file_writer_options &options = {});
+
+    /**
+     * @brief Appends a copy of some bytes.
+     *
+     * @param data [in] The bytes. Must not be `nullptr` unless `size` is 0.
+     * @param size [in] Number of bytes.
+     * @return `FILE_OK`, or the first error met by the writer.
+     */
+    ca_file_result
+    write(const void *data, ca_size_t size);
+
+    /**
+     * @brief Appends a copy of a string.
+     */
+    ca_file_result
+    write(std::string_view text);
+
+    /**
+     * @brief Appends some bytes without copying them.
+     *
+     * @param data [in] The bytes, valid until the next flush. Must not be
+     *             `nullptr` unless `size` is 0.
+     * @param size [in] Number of bytes.
+     * @return `FILE_OK`, or the first error met by the writer.
+     */
+    ca_file_result
+    write_borrowed(const void *data, ca_size_t size);
+
+    /**
+     * @brief Appends the bytes of a buffer without copying them.
+     *
+     * @tparam encoding The encoding of the buffer.
+     * @param text The buffer, valid until the next flush.
+     * @return `FILE_OK`, or the first error met by the writer.
+     */
+    template <ca_string::ca_encoding_t encoding>
+    ca_file_result
+    write_borrowed(ca_string::ca_buffer<encoding> text) {
+        return write_borrowed(text.buf, static_cast<ca_size_t>(text.after - text.buf));
+    }
+
+    /**
+     * @brief Writes everything appended so far and waits for it.
+     *
+     * @return `FILE_OK`, or the first error met by the writer.
+     */
+    ca_file_result
+    flush();
+
+    /**
+     * @brief Flushes and closes the file, then renames the temporary file
+     *        over the target if the writer is atomic.
+     *
+     * On failure the temporary file is removed and the target is unchanged.
+     *
+     * @return `FILE_OK`, or the first error met by the writer.
+     */
+    ca_file_result
+    commit();
+
+    /**
+     * @brief Closes the file, removing it if the writer is atomic.
+     */
+    void
+    discard();
+
+    /**
+     * @brief Checks if the writer is open.
+     */
+    [[nodiscard]] bool
+    is_open() const;
+
+    /**
+     * @brief Returns the number of bytes appended since `open`.
+     */
+    [[nodiscard]] ca_uint64_t
+    size() const;
+
+private:
+    std::unique_ptr<internal::ca_writer_state> state;   ///< State of the open file, `nullptr` if closed.
+};
+
+}
+
+#endif //CA_IO_FILE_WRITER_H
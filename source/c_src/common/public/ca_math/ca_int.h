@@ -38,6 +38,14 @@ typedef uint64_t ca_uint64_t;
 typedef size_t ca_size_t;
 typedef ssize_t ca_ssize_t;
 
+// Index type for ids and element indices of large tables, widened to 64 bits
+// by the ENABLE_64BIT_INDEX build option
+#ifdef CA_ENABLE_64BIT_INDEX
+typedef uint64_t ca_index_t;
+#else
+typedef uint32_t ca_index_t;
+#endif
+
 // Common C-style aliases
 typedef short ca_short_t;
 typedef unsigned short ca_ushort_t;
@@ -84,6 +92,8 @@ constexpr ca_size_t CA_SIZE_T_MAX = std::numeric_limits<ca_size_t>::max();
 constexpr ca_ssize_t CA_SSIZE_T_MIN = std::numeric_limits<ca_ssize_t>::min();
 constexpr ca_ssize_t CA_SSIZE_T_MAX = std::numeric_limits<ca_ssize_t>::max();
 
+constexpr ca_index_t CA_INDEX_T_MAX = std::numeric_limits<ca_index_t>::max();
+
 }
 
 #endif //CA_INT_H
@@ -0,0 +1,177 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_misc/ca_arena.h
+//
+// @file
+// @brief Defines `ca_arena`, a bump allocator over chained chunks freed all
+//        at once, and `ca_memory_stats`, the counters of the allocators.
+// ================================
+
+#ifndef CA_ARENA_H
+#define CA_ARENA_H
+
+#include "ca_math.h"
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ca::ca_misc {
+
+/**
+ * @struct ca_memory_stats
+ * @brief Counters of an allocator.
+ */
+struct ca_memory_stats {
+    ca_uint64_t allocations;    ///< Allocations served.
+    ca_uint64_t requested;      ///< Bytes requested by those allocations.
+    ca_uint64_t reserved;       ///< Bytes currently held from the system.
+    ca_uint64_t peak_reserved;  ///< Largest value `reserved` has had.
+    ca_uint64_t chunks;         ///< Blocks obtained from the system.
+    ca_uint64_t resets;         ///< Times all the allocations were freed at once.
+};
+
+/**
+ * @struct ca_arena
+ * @brief Bump allocator: allocations are carved from large chunks and freed
+ *        all together.
+ *
+ * An allocation moves a pointer forward in the current chunk; when it does
+ * not fit, a new chunk twice as large as the previous one is chained, up to
+ * `MAX_CHUNK_SIZE` unless a single request needs more. `reset` frees every
+ * allocation and keeps the largest chunk for reuse, so an arena reset once
+ * per translation unit stops asking the system for memory once it has seen
+ * its largest unit; `release` gives everything back.
+ *
+ * Objects placed in the arena are never destroyed, so `create` accepts only
+ * trivially destructible types. An arena is used by one thread at a time.
+ *
+ * Without ENABLE_OPTIMIZER every allocation gets a chunk of its own, so that
+ * memory checkers see each allocation separately.
+ */
+struct ca_arena {
+    /**
+     * @brief Default size of the first chunk.
+     */
+    static constexpr ca_size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Size at which chunks stop doubling.
+     */
+    static constexpr ca_size_t MAX_CHUNK_SIZE = 64 * 1024 * 1024;
+
+    /**
+     * @brief Constructs an empty arena; no memory is reserved until the
+     *        first allocation.
+     *
+     * @param first_chunk Size of the first chunk.
+     */
+    explicit ca_arena(ca_size_t first_chunk = MIN_CHUNK_SIZE);
+
+    ca_arena(const ca_arena &) = delete;
+    ca_arena &operator=(const ca_arena &) = delete;
+
+    /**
+     * @brief Allocates memory valid until the next `reset` or `release`.
+     *
+     * @param size Number of bytes.
+     * @param alignment Alignment, a power of two.
+     * @return The memory, never `nullptr`.
+     */
+    void *
+    allocate(const ca_size_t size, const ca_size_t alignment = alignof(std::max_align_t)) {
+        assert(std::has_single_bit(alignment));
+        const std::uintptr_t start = (cursor + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+        if (start < limit && size <= limit - start) {
+            cursor = start + size;
+            ++counters.allocations;
+            counters.requested += size;
+            return reinterpret_cast<void *>(start);
+        }
+        return allocate_chunk(size, alignment);
+    }
+
+    /**
+     * @brief Allocates an uninitialized array.
+     */
+    template <typename T>
+    T *
+    allocate_array(const ca_size_t count) {
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Constructs an object in the arena.
+     */
+    template <typename T, typename... Args>
+    T *
+    create(Args &&...args) {
+        static_assert(std::is_trivially_destructible_v<T>, "arena objects are never destroyed");
+        return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Frees every allocation, keeping the largest chunk.
+     */
+    void
+    reset();
+
+    /**
+     * @brief Frees every allocation and every chunk.
+     */
+    void
+    release();
+
+    /**
+     * @brief Returns the number of bytes held by the chunks.
+     */
+    [[nodiscard]] ca_size_t
+    capacity() const {
+        return static_cast<ca_size_t>(counters.reserved);
+    }
+
+    /**
+     * @brief Returns the counters of the arena.
+     */
+    [[nodiscard]] const ca_memory_stats &
+    stats() const {
+        return counters;
+    }
+
+private:
+    /**
+     * @struct chunk
+     * @brief One block of memory of the arena.
+     */
+    struct chunk {
+        std::unique_ptr<std::byte[]> data;  ///< The memory.
+        ca_size_t size;                     ///< Size of the memory.
+    };
+
+    /**
+     * @brief Chains a chunk large enough for the request and allocates from it.
+     */
+    void *
+    allocate_chunk(ca_size_t size, ca_size_t alignment);
+
+    /**
+     * @brief Makes the allocations start over at the beginning of the last chunk.
+     */
+    void
+    rewind();
+
+    ca_size_t first_size;           ///< Size of the first chunk.
+    std::vector<chunk> chunks;      ///< The chunks; the last one is being filled.
+    std::uintptr_t cursor;          ///< Next free address in the last chunk.
+    std::uintptr_t limit;           ///< End of the last chunk, 0 if none.
+    ca_memory_stats counters;       ///< The counters.
+};
+
+}
+
+#endif //CA_ARENA_H
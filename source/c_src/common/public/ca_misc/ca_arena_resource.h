@@ -0,0 +1,57 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_misc/ca_arena_resource.h
+//
+// @file
+// @brief Defines `ca_arena_resource`, a monotonic `std::pmr::memory_resource`
+//        over a `ca_arena`.
+// ================================
+
+#ifndef CA_ARENA_RESOURCE_H
+#define CA_ARENA_RESOURCE_H
+
+#include "ca_arena.h"
+
+#include <memory_resource>
+
+namespace ca::ca_misc {
+
+/**
+ * @struct ca_arena_resource
+ * @brief Lets `std::pmr` containers allocate from a `ca_arena`.
+ *
+ * The resource is monotonic: deallocation does nothing, and the memory comes
+ * back when the arena is reset. Containers using it must therefore be
+ * destroyed, or at least no longer used, before the arena is reset.
+ */
+struct ca_arena_resource final : std::pmr::memory_resource {
+    /**
+     * @brief Constructs a resource allocating from `arena`.
+     *
+     * @param arena The arena, which must outlive the resource.
+     */
+    explicit ca_arena_resource(ca_arena &arena) : source(arena) {}
+
+    /**
+     * @brief Returns the arena of the resource.
+     */
+    [[nodiscard]] ca_arena &
+    arena() const {
+        return source;
+    }
+
+private:
+    void *
+    do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void
+    do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+
+    [[nodiscard]] bool
+    do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    ca_arena &source;   ///< The arena.
+};
+
+}
+
+#endif //CA_ARENA_RESOURCE_H
@@ -0,0 +1,208 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_misc/ca_fixed_pool.h
+//
+// @file
+// @brief Defines `ca_fixed_pool`, an allocator of fixed-size blocks with
+//        per-thread free lists, and `ca_object_pool`, its typed form.
+// ================================
+
+#ifndef CA_FIXED_POOL_H
+#define CA_FIXED_POOL_H
+
+#include "ca_arena.h"
+#include "ca_math.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ca::ca_misc {
+
+/**
+ * @struct ca_fixed_pool
+ * @brief Allocator of blocks of one size, for many small objects allocated
+ *        and freed in any order, possibly from several threads.
+ *
+ * Blocks are carved from slabs of `blocks_per_slab` blocks and recycled
+ * through free lists. Each thread keeps a free list of its own per pool, so
+ * that allocating and freeing take no lock; a thread whose list is empty
+ * takes a batch of blocks from the shared list, or carves one from the
+ * current slab, and a thread whose list grows long gives a batch back. A
+ * block may be freed by another thread than the one that allocated it.
+ *
+ * Slabs are freed only with the pool. Blocks left in the list of a thread
+ * that exits are not reused before then. The lists other threads keep for a
+ * destroyed pool are dropped the next time each of them switches to another
+ * pool.
+ *
+ * Without ENABLE_OPTIMIZER every block is allocated and freed on its own.
+ */
+struct ca_fixed_pool {
+    /**
+     * @brief Number of blocks moved at once between a thread's list and the
+     *        shared list.
+     */
+    static constexpr ca_size_t BATCH_SIZE = 32;
+
+    /**
+     * @brief Constructs an empty pool.
+     *
+     * @param block_size Size of the blocks, rounded up to hold a pointer and
+     *                   to a multiple of `alignment`.
+     * @param alignment Alignment of the blocks, a power of two.
+     * @param blocks_per_slab Number of blocks per slab, 0 for slabs of about
+     *                        64 KiB.
+     */
+    explicit ca_fixed_pool(ca_size_t block_size, ca_size_t alignment = alignof(std::max_align_t),
+                           ca_size_t blocks_per_slab = 0);
+
+    /**
+     * @brief Frees every slab. The blocks must no longer be used.
+     */
+    ~ca_fixed_pool();
+
+    ca_fixed_pool(const ca_fixed_pool &) = delete;
+    ca_fixed_pool &operator=(const ca_fixed_pool &) = delete;
+
+    /**
+     * @brief Allocates a block.
+     *
+     * @return The block, never `nullptr`.
+     */
+    void *
+    allocate();
+
+    /**
+     * @brief Frees a block allocated by this pool. `nullptr` is ignored.
+     */
+    void
+    deallocate(void *block);
+
+    /**
+     * @brief Returns the size of the blocks, after rounding.
+     */
+    [[nodiscard]] ca_size_t
+    block_size() const {
+        return size;
+    }
+
+    /**
+     * @brief Returns the counters of the pool. Each thread adds up its
+     *        allocations a batch at a time, so they may lag by less than a
+     *        batch per thread.
+     */
+    [[nodiscard]] ca_memory_stats
+    stats() const;
+
+    /**
+     * @brief Returns the number of pools the calling thread keeps a free list
+     *        for, including destroyed pools not yet dropped.
+     */
+    [[nodiscard]] static ca_size_t
+    thread_list_count();
+
+private:
+    /**
+     * @struct node
+     * @brief A free block, linked to the next one.
+     */
+    struct node {
+        node *next;     ///< The next free block.
+    };
+
+    /**
+     * @struct local_list
+     * @brief The free list of a thread for one pool.
+     */
+    struct local_list {
+        node *head = nullptr;           ///< The first free block.
+        ca_size_t count = 0;            ///< Number of free blocks.
+        ca_size_t allocations = 0;      ///< Allocations not yet added to `allocated`.
+    };
+
+    /**
+     * @brief Returns the free list of the calling thread.
+     */
+    local_list &
+    local();
+
+    /**
+     * @brief Refills an empty list from the shared list or the last slab.
+     */
+    void
+    refill(local_list &list);
+
+    /**
+     * @brief Moves `BATCH_SIZE` blocks of a list to the shared list.
+     */
+    void
+    give_back(local_list &list);
+
+    ca_size_t size;                 ///< Size of the blocks.
+    ca_size_t align;                ///< Alignment of the blocks.
+    ca_size_t slab_blocks;          ///< Number of blocks per slab.
+    ca_uint64_t id;                 ///< Unique id keying the thread lists.
+    std::atomic<ca_uint64_t> allocated; ///< Allocations added up by the threads.
+
+    mutable std::mutex lock;        ///< Guards the members below.
+    node *shared_head;              ///< The first block of the shared list.
+    std::byte *fresh;               ///< The first block never handed out in the last slab.
+    ca_size_t fresh_blocks;         ///< Number of blocks never handed out in the last slab.
+    std::vector<void *> slabs;      ///< The slabs.
+    ca_memory_stats counters;       ///< The counters.
+};
+
+/**
+ * @struct ca_object_pool
+ * @brief A `ca_fixed_pool` of objects of type `T`.
+ */
+template <typename T>
+struct ca_object_pool {
+    /**
+     * @brief Constructs an empty pool.
+     *
+     * @param objects_per_slab Number of objects per slab, 0 for slabs of
+     *                         about 64 KiB.
+     */
+    explicit ca_object_pool(const ca_size_t objects_per_slab = 0)
+        : blocks(sizeof(T), alignof(T), objects_per_slab) {}
+
+    /**
+     * @brief Constructs an object in a block of the pool.
+     */
+    template <typename... Args>
+    T *
+    create(Args &&...args) {
+        return ::new (blocks.allocate()) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys an object created by this pool and frees its block.
+     *        `nullptr` is ignored.
+     */
+    void
+    destroy(T *object) {
+        if (object != nullptr) {
+            object->~T();
+            blocks.deallocate(object);
+        }
+    }
+
+    /**
+     * @brief Returns the counters of the pool.
+     */
+    [[nodiscard]] ca_memory_stats
+    stats() const {
+        return blocks.stats();
+    }
+
+private:
+    ca_fixed_pool blocks;   ///< The blocks.
+};
+
+}
+
+#endif //CA_FIXED_POOL_H
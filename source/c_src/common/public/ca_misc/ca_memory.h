@@ -0,0 +1,16 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_misc/ca_memory.h
+//
+// @file
+// @brief Defines the memory allocators: arenas, fixed-size pools and the
+//        `std::pmr` adapter of the arenas.
+// ================================
+
+#ifndef CA_MEMORY_H
+#define CA_MEMORY_H
+
+#include "ca_arena.h"
+#include "ca_arena_resource.h"
+#include "ca_fixed_pool.h"
+
+#endif //CA_MEMORY_H
@@ -13,6 +13,8 @@
 #include "ca_char.h"
 #include "ca_math.h"
 
+#include <span>
+
 namespace ca::ca_string {
 
 /**
@@ -32,6 +34,16 @@ enum class ca_buffer_implemented_unary_functions {
     STR_LEN     ///< Returns the length of a string
 };
 
+/**
+ * @enum ca_buffer_case_mapping_functions
+ * @brief Enumeration for implemented case mapping functions.
+ */
+enum class ca_buffer_case_mapping_functions {
+    TO_LOWER,   ///< Maps every character to lowercase
+    TO_UPPER,   ///< Maps every character to uppercase
+    CASEFOLD    ///< Applies full case folding for caseless matching
+};
+
 /**
  * @struct ca_buffer
  * @brief A template struct representing a buffer for handling
@@ -261,9 +273,9 @@ struct ca_buffer {
     /**
      * @brief Apply a unary function to each codepoint in the buffer.
      *
-     * This function iterates over each codepoint in the buffer and applies
-     * the specified unary function. If the function fails for any codepoint,
-     * the iteration stops and returns false.
+     * This function decodes the buffer block-wise with `ca_buffer_block_iterator`
+     * and applies the specified unary function to each codepoint. If the function
+     * fails for any codepoint, the iteration stops and returns false.
      *
      * @tparam unary_type The unary function to be applied to each codepoint.
      *
@@ -369,6 +381,105 @@ struct ca_buffer {
     [[nodiscard]] inline bool
     isnumeric() const;
 
+    /**
+     * @brief Compute the output length needed by a case mapping of the buffer.
+     *
+     * Case mapping can change the encoded length of a UTF-8 buffer (e.g. `ı`
+     * (2 bytes) maps to `I` (1 byte)) and case folding may expand a character
+     * into several ones (e.g. `ß` folds to `ss`). Running this pass first lets
+     * the caller do a single allocation for `case_mapping`.
+     *
+     * Pure ASCII runs are skipped with SIMD, since their length never changes.
+     *
+     * @tparam mapping The case mapping function to size.
+     *
+     * @return The len of the mapped buffer:
+     *         - For ASCII and UTF8, this is the number of bytes.
+     *         - For UTF32, this is the number of characters.
+     */
+    template <ca_buffer_case_mapping_functions mapping>
+    [[nodiscard]] inline ca_size_t
+    case_mapping_size() const;
+
+    /**
+     * @brief Write a case mapped copy of the buffer into a caller buffer.
+     *
+     * ASCII characters are mapped with vector compare/add on whole blocks, and
+     * other characters are mapped through utf8proc. Trailing null characters
+     * are copied unchanged.
+     *
+     * @tparam mapping The case mapping function to apply.
+     *
+     * @param out The destination buffer. It must not overlap with this buffer
+     *            unless it starts at the same position and the mapping keeps
+     *            the length unchanged, and it must hold at least
+     *            `case_mapping_size<mapping>()` elements.
+     *
+     * @return The len written into `out`:
+     *         - For ASCII and UTF8, this is the number of bytes.
+     *         - For UTF32, this is the number of characters.
+     */
+    template <ca_buffer_case_mapping_functions mapping>
+    inline ca_size_t
+    case_mapping(ca_buffer<encoding> out) const;
+
+    /**
+     * @brief Compute the output len of `to_lower`.
+     *
+     * @return The len needed by `to_lower`, see `case_mapping_size`.
+     */
+    [[nodiscard]] inline ca_size_t
+    to_lower_size() const;
+
+    /**
+     * @brief Write a lowercase copy of the buffer into `out`.
+     *
+     * @param out The destination buffer, holding at least `to_lower_size()` elements.
+     *
+     * @return The len written into `out`, see `case_mapping`.
+     */
+    inline ca_size_t
+    to_lower(ca_buffer<encoding> out) const;
+
+    /**
+     * @brief Compute the output len of `to_upper`.
+     *
+     * @return The len needed by `to_upper`, see `case_mapping_size`.
+     */
+    [[nodiscard]] inline ca_size_t
+    to_upper_size() const;
+
+    /**
+     * @brief Write an uppercase copy of the buffer into `out`.
+     *
+     * @param out The destination buffer, holding at least `to_upper_size()` elements.
+     *
+     * @return The len written into `out`, see `case_mapping`.
+     */
+    inline ca_size_t
+    to_upper(ca_buffer<encoding> out) const;
+
+    /**
+     * @brief Compute the output len of `casefold`.
+     *
+     * @return The len needed by `casefold`, see `case_mapping_size`.
+     */
+    [[nodiscard]] inline ca_size_t
+    casefold_size() const;
+
+    /**
+     * @brief Write a case folded copy of the buffer into `out`.
+     *
+     * Two buffers compare equal ignoring case if their folded copies are
+     * byte-wise equal.
+     *
+     * @param out The destination buffer, holding at least `casefold_size()` elements.
+     *
+     * @return The len written into `out`, see `case_mapping`.
+     */
+    inline ca_size_t
+    casefold(ca_buffer<encoding> out) const;
+
     /**
      * @brief Compare memory of two buffers.
      *
@@ -424,11 +535,11 @@ struct ca_buffer {
     /**
      * @brief Remove trailing whitespace and null characters from the buffer.
      *
-     * This function modifies the buffer by removing any trailing whitespace characters
-     * (such as spaces, tabs, and newlines) as well as null characters ("\0") from the end
-     * of the buffer. It works in-place and does not allocate additional memory.
+     * This function returns a view of the buffer without any trailing whitespace
+     * characters (such as spaces, tabs, and newlines) and null characters ("\0").
+     * The buffer itself is left unchanged and no memory is allocated.
      *
-     * @return The modified buffer with trailing whitespace and null characters removed.
+     * @return A copy of the buffer with trailing whitespace and null characters removed.
      */
     inline ca_buffer<encoding>
     rstrip() const;
@@ -444,6 +555,9 @@ struct ca_buffer {
      * @param ignore_trailing_whitespace If true, trailing whitespace will be ignored
      *                                   in both buffers before comparison.
      *
+     * Both buffers are decoded block-wise with `ca_buffer_block_iterator` and
+     * compared several codepoints at a time.
+     *
      * @return
      *   - A negative integer if the current buffer is less than `other`.
      *   - A positive integer if the current buffer is greater than `other`.
@@ -453,6 +567,58 @@ struct ca_buffer {
     strcmp(ca_buffer<encoding> other, bool ignore_trailing_whitespace = false) const;
 };
 
+/**
+ * @struct ca_buffer_block_iterator
+ * @brief Decodes a `ca_buffer` into blocks of UTF-32 codepoints.
+ *
+ * Every call to `next` decodes up to `BLOCK_SIZE` codepoints and returns them
+ * as a span, so that algorithms can run tight loops over fixed-width
+ * codepoints instead of decoding one character per `operator*`/`operator++`.
+ *
+ * - ASCII buffers, and ASCII runs inside UTF-8 buffers, are widened 16 bytes
+ *   at a time with SIMD.
+ * - Other UTF-8 characters are decoded one by one into the block.
+ * - UTF-32 buffers are handed out in place without copying.
+ *
+ * Like `ca_buffer::num_codepoints`, the iteration of ASCII and UTF-32 buffers
+ * stops before trailing null characters. An incomplete UTF-8 sequence at the
+ * end of the buffer is not decoded.
+ *
+ * @tparam encoding The character encoding of the buffer.
+ *
+ * @note The returned spans point into the iterator (or the buffer for UTF-32)
+ *       and are valid until the next call to `next`.
+ */
+template <ca_encoding_t encoding>
+struct ca_buffer_block_iterator {
+    /**
+     * @brief Maximum number of codepoints decoded per block.
+     */
+    static constexpr ca_size_t BLOCK_SIZE = 32;
+
+    /**
+     * @brief Constructs an iterator over the codepoints of a buffer.
+     *
+     * @param buffer The buffer to decode. It must stay alive while iterating.
+     */
+    inline explicit
+    ca_buffer_block_iterator(ca_buffer<encoding> buffer);
+
+    /**
+     * @brief Decodes the next block of codepoints.
+     *
+     * @return A span of at most `BLOCK_SIZE` codepoints, or an empty span
+     *         when the buffer is exhausted.
+     */
+    inline std::span<const ca_char4_t>
+    next();
+
+private:
+    const ca_char_t *cur;                       ///< Next byte to decode.
+    const ca_char_t *end;                       ///< End of the decoded range.
+    alignas(16) ca_char4_t block[BLOCK_SIZE];   ///< Decoded codepoints of the current block.
+};
+
 }
 
 #include "../../private/ca_string/ca_buffer.tpp"
@@ -208,6 +208,66 @@ template <ca_encoding_t encoding>
 inline bool
 ca_isdecimal(ca_char4_t c);
 
+/**
+ * @constant CA_CASEFOLD_MAX_CODEPOINTS
+ * @brief Maximum number of code points a single code point can fold to.
+ *        Full Unicode case folding may expand one character (e.g. U+0390)
+ *        into up to three characters.
+ */
+constexpr int CA_CASEFOLD_MAX_CODEPOINTS = 3;
+
+/**
+ * @brief Template function to map a character to lowercase.
+ *
+ * @param c The character (Unicode code point) to map.
+ *
+ * @return The simple (one-to-one) lowercase mapping of `c`, or `c` itself
+ *         if it has no lowercase mapping.
+ * @tparam encoding The character encoding type for proper mapping.
+ *
+ * @note For ASCII only `A-Z` are mapped. For unsupported encoding types,
+ *       this function will return `c` unchanged.
+ */
+template <ca_encoding_t encoding>
+inline ca_char4_t
+ca_tolower(ca_char4_t c);
+
+/**
+ * @brief Template function to map a character to uppercase.
+ *
+ * @param c The character (Unicode code point) to map.
+ *
+ * @return The simple (one-to-one) uppercase mapping of `c`, or `c` itself
+ *         if it has no uppercase mapping.
+ * @tparam encoding The character encoding type for proper mapping.
+ *
+ * @note For ASCII only `a-z` are mapped. For unsupported encoding types,
+ *       this function will return `c` unchanged.
+ */
+template <ca_encoding_t encoding>
+inline ca_char4_t
+ca_toupper(ca_char4_t c);
+
+/**
+ * @brief Template function to apply full Unicode case folding to a character.
+ *
+ * Case folding is intended for caseless matching, and unlike `ca_tolower` it
+ * may expand one character into several (e.g. `ß` folds to `ss`).
+ *
+ * @param c The character (Unicode code point) to fold.
+ * @param out [out] Buffer receiving the folded code points. Must hold at least
+ *            `CA_CASEFOLD_MAX_CODEPOINTS` elements and must not be `nullptr`.
+ *
+ * @return The number of code points written to `out` (1 to `CA_CASEFOLD_MAX_CODEPOINTS`).
+ * @tparam encoding The character encoding type for proper mapping.
+ *
+ * @note For ASCII folding is the same as `ca_tolower`. For unsupported encoding
+ *       types, `c` is written unchanged.
+ */
+template <ca_encoding_t encoding>
+inline int
+ca_casefold(ca_char4_t c, ca_char4_t *out);
+
 /**
  * @brief Template function to check a character based on the specified encoding and check type.
  *
@@ -0,0 +1,184 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_string/ca_hash.h
+//
+// @file
+// @brief Defines fast non-cryptographic 64-bit and 128-bit hash functions
+//        for byte ranges and `ca_buffer`, with a streaming interface.
+// ================================
+
+#ifndef CA_HASH_H
+#define CA_HASH_H
+
+#include "ca_buffer.h"
+#include "ca_char_types.h"
+#include "ca_math.h"
+
+namespace ca::ca_string {
+
+/**
+ * @struct ca_hash128_t
+ * @brief A 128-bit hash value.
+ */
+struct ca_hash128_t {
+    ca_uint64_t low;    ///< Low 64 bits.
+    ca_uint64_t high;   ///< High 64 bits.
+
+    bool operator==(const ca_hash128_t &other) const = default;
+};
+
+// ----------------------------
+// One-shot hashing
+// ----------------------------
+
+/**
+ * @brief Computes the 64-bit hash of a byte range.
+ *
+ * The hash is XXH3 (xxHash 0.8) with the default secret, so values match
+ * `XXH3_64bits_withSeed` of the reference implementation. Inputs longer than
+ * 240 bytes are consumed in 64-byte stripes with SSE2 (AVX2 when available).
+ *
+ * @param data [in] Pointer to the bytes. Must not be `nullptr` unless `size` is 0.
+ * @param size [in] Number of bytes.
+ * @param seed [in] Seed to derive independent hash functions.
+ * @return The 64-bit hash.
+ */
+ca_uint64_t
+ca_hash64(const ca_char_t *data, ca_size_t size, ca_uint64_t seed = 0);
+
+/**
+ * @brief Computes the 128-bit hash of a byte range.
+ *
+ * Values match `XXH3_128bits_withSeed` of the reference implementation.
+ *
+ * @param data [in] Pointer to the bytes. Must not be `nullptr` unless `size` is 0.
+ * @param size [in] Number of bytes.
+ * @param seed [in] Seed to derive independent hash functions.
+ * @return The 128-bit hash.
+ */
+ca_hash128_t
+ca_hash128(const ca_char_t *data, ca_size_t size, ca_uint64_t seed = 0);
+
+/**
+ * @brief Computes the 64-bit hash of the raw bytes of a buffer.
+ *
+ * The bytes are hashed as stored, without decoding, so equal text in
+ * different encodings has different hashes.
+ *
+ * @tparam encoding The encoding of the buffer.
+ * @param buffer The buffer to hash.
+ * @param seed Seed to derive independent hash functions.
+ * @return The 64-bit hash.
+ */
+template <ca_encoding_t encoding>
+ca_uint64_t
+ca_hash64(ca_buffer<encoding> buffer, ca_uint64_t seed = 0);
+
+/**
+ * @brief Computes the 128-bit hash of the raw bytes of a buffer.
+ *
+ * @tparam encoding The encoding of the buffer.
+ * @param buffer The buffer to hash.
+ * @param seed Seed to derive independent hash functions.
+ * @return The 128-bit hash.
+ */
+template <ca_encoding_t encoding>
+ca_hash128_t
+ca_hash128(ca_buffer<encoding> buffer, ca_uint64_t seed = 0);
+
+// ----------------------------
+// Streaming hashing
+// ----------------------------
+
+/**
+ * @struct ca_hash_state
+ * @brief Incrementally hashes data delivered in pieces, e.g. the chunks of a
+ *        `ca_stream`.
+ *
+ * Feeding the same bytes in any split yields the same values as `ca_hash64`
+ * and `ca_hash128` over the concatenation. Both digests can be taken from the
+ * same state, and taking a digest does not end the stream.
+ */
+struct ca_hash_state {
+    /**
+     * @brief Constructs a state for an empty input.
+     *
+     * @param seed Seed to derive independent hash functions.
+     */
+    explicit ca_hash_state(ca_uint64_t seed = 0);
+
+    /**
+     * @brief Restarts hashing from an empty input.
+     *
+     * @param seed Seed to derive independent hash functions.
+     */
+    void
+    reset(ca_uint64_t seed = 0);
+
+    /**
+     * @brief Appends bytes to the hashed input.
+     *
+     * @param data [in] Pointer to the bytes. Must not be `nullptr` unless `size` is 0.
+     * @param size [in] Number of bytes.
+     */
+    void
+    update(const ca_char_t *data, ca_size_t size);
+
+    /**
+     * @brief Appends the raw bytes of a buffer to the hashed input.
+     *
+     * @tparam encoding The encoding of the buffer.
+     * @param buffer The buffer to append.
+     */
+    template <ca_encoding_t encoding>
+    void
+    update(ca_buffer<encoding> buffer);
+
+    /**
+     * @brief Returns the 64-bit hash of the input so far.
+     */
+    [[nodiscard]] ca_uint64_t
+    digest64() const;
+
+    /**
+     * @brief Returns the 128-bit hash of the input so far.
+     */
+    [[nodiscard]] ca_hash128_t
+    digest128() const;
+
+    /**
+     * @brief Returns the number of bytes hashed so far.
+     */
+    [[nodiscard]] ca_uint64_t
+    total_size() const;
+
+    static constexpr ca_size_t STRIPE_SIZE = 64;        ///< Bytes consumed per accumulation.
+    static constexpr ca_size_t BUFFER_SIZE = 256;       ///< Bytes buffered between updates.
+    static constexpr ca_size_t SECRET_SIZE = 192;       ///< Size of the secret in bytes.
+
+private:
+    /**
+     * @brief Returns the secret used for long inputs.
+     */
+    [[nodiscard]] const ca_char_t *
+    secret() const;
+
+    /**
+     * @brief Runs the long input digest on a copy of the accumulators.
+     */
+    void
+    digest_long(ca_uint64_t *acc) const;
+
+    alignas(64) ca_uint64_t acc[8];                     ///< Stripe accumulators.
+    alignas(64) ca_char_t buffer[BUFFER_SIZE];          ///< Bytes not consumed yet.
+    alignas(64) ca_char_t custom_secret[SECRET_SIZE];   ///< Secret derived from a non-zero seed.
+    ca_size_t buffered_size;                            ///< Bytes held in `buffer`.
+    ca_size_t stripes_so_far;                           ///< Stripes consumed in the current block.
+    ca_uint64_t total_len;                              ///< Bytes hashed so far.
+    ca_uint64_t seed;                                   ///< Seed of the hash.
+};
+
+}
+
+#include "../../private/ca_string/ca_hash.tpp"
+
+#endif //CA_HASH_H
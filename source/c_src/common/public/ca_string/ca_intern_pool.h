@@ -0,0 +1,297 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_string/ca_intern_pool.h
+//
+// @file
+// @brief Defines `ca_intern_pool`, an arena-backed string interning pool
+//        mapping identifier text to stable integer ids, and its thread-safe
+//        sharded variant `ca_sharded_intern_pool`.
+// ================================
+
+#ifndef CA_INTERN_POOL_H
+#define CA_INTERN_POOL_H
+
+#include "ca_buffer.h"
+#include "ca_char_types.h"
+#include "ca_math.h"
+
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+namespace ca::ca_string {
+
+/**
+ * @struct ca_intern_pool
+ * @brief Stores every distinct string once and identifies it by an integer id.
+ *
+ * Interned bytes are copied into large arena chunks that are never moved or
+ * freed before the pool itself, so views returned by `view` stay valid for
+ * the lifetime of the pool. Lookups go through an open-addressing hash table
+ * with linear probing that stores only ids; the hash of each string is kept
+ * next to its entry so that probing and rehashing never touch the text.
+ *
+ * Ids are assigned densely from 0 in insertion order, so two strings of the
+ * same pool are equal exactly when their ids are equal, and ids can index
+ * side tables directly.
+ *
+ * Strings are interned as raw bytes, independently of their encoding.
+ *
+ * @note The pool is not thread-safe; see `ca_sharded_intern_pool`.
+ */
+struct ca_intern_pool {
+    /**
+     * @typedef id_type
+     * @brief Type of the ids, 32-bit unless built with ENABLE_64BIT_INDEX.
+     */
+    typedef ca_index_t id_type;
+
+    /**
+     * @brief Id returned by `find` for strings that are not interned.
+     */
+    static constexpr id_type INVALID_ID = CA_INDEX_T_MAX;
+
+    /**
+     * @brief Default size of an arena chunk in bytes.
+     */
+    static constexpr ca_size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Constructs an empty pool.
+     *
+     * @param chunk_size Size of the arena chunks in bytes. A string that does
+     *                   not fit in the current chunk and needs more than a
+     *                   quarter of a chunk, counting its terminator, gets a
+     *                   chunk of its own.
+     */
+    explicit ca_intern_pool(ca_size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    ca_intern_pool(const ca_intern_pool &) = delete;
+    ca_intern_pool &operator=(const ca_intern_pool &) = delete;
+    ca_intern_pool(ca_intern_pool &&) noexcept = default;
+    ca_intern_pool &operator=(ca_intern_pool &&) noexcept = default;
+
+    /**
+     * @brief Interns a string, copying it into the pool if it is new.
+     *
+     * @param str [in] Pointer to the bytes. Must not be `nullptr` unless `size` is 0.
+     * @param size [in] Number of bytes.
+     * @return The id of the string.
+     */
+    id_type
+    intern(const ca_char_t *str, ca_size_t size);
+
+    /**
+     * @brief Interns the bytes of a buffer.
+     *
+     * @tparam encoding The encoding of the buffer.
+     * @param text The buffer to intern.
+     * @return The id of the buffer content.
+     */
+    template <ca_encoding_t encoding>
+    id_type
+    intern(ca_buffer<encoding> text);
+
+    /**
+     * @brief Looks up a string without interning it.
+     *
+     * @param str [in] Pointer to the bytes. Must not be `nullptr` unless `size` is 0.
+     * @param size [in] Number of bytes.
+     * @return The id of the string, or `INVALID_ID` if it is not interned.
+     */
+    [[nodiscard]] id_type
+    find(const ca_char_t *str, ca_size_t size) const;
+
+    /**
+     * @brief Returns a zero-copy view of an interned string.
+     *
+     * The bytes are followed by a null terminator that is not part of the view.
+     *
+     * @tparam encoding The encoding the view is interpreted with.
+     * @param id The id of the string. Must have been returned by this pool.
+     * @return A buffer viewing the interned bytes.
+     */
+    template <ca_encoding_t encoding = ca_encoding_t::CA_ENCODING_UTF8>
+    [[nodiscard]] ca_buffer<encoding>
+    view(id_type id) const;
+
+    /**
+     * @brief Returns the number of bytes of an interned string.
+     *
+     * @param id The id of the string. Must have been returned by this pool.
+     */
+    [[nodiscard]] ca_size_t
+    length(id_type id) const;
+
+    /**
+     * @brief Returns the number of distinct strings in the pool.
+     */
+    [[nodiscard]] ca_size_t
+    size() const;
+
+    /**
+     * @brief Returns the number of bytes allocated by the arena and the table.
+     */
+    [[nodiscard]] ca_size_t
+    memory_usage() const;
+
+private:
+    friend struct ca_sharded_intern_pool;
+
+    /**
+     * @brief Interned string entry.
+     */
+    struct entry {
+        ca_char_t *data;        ///< Interned bytes, followed by a null terminator.
+        ca_size_t size;         ///< Number of bytes.
+        ca_uint64_t hash;       ///< Hash of the bytes.
+    };
+
+    /**
+     * @brief Hashes a string the way the table expects.
+     */
+    static ca_uint64_t
+    hash(const ca_char_t *str, ca_size_t size);
+
+    /**
+     * @brief `find` with a precomputed hash.
+     */
+    [[nodiscard]] id_type
+    find_hashed(const ca_char_t *str, ca_size_t size, ca_uint64_t hash) const;
+
+    /**
+     * @brief `intern` with a precomputed hash.
+     */
+    id_type
+    intern_hashed(const ca_char_t *str, ca_size_t size, ca_uint64_t hash);
+
+    /**
+     * @brief Copies bytes into the arena, adding a null terminator.
+     */
+    ca_char_t *
+    allocate(const ca_char_t *str, ca_size_t size);
+
+    /**
+     * @brief Doubles the table and reinserts all ids.
+     */
+    void
+    grow();
+
+    std::vector<std::unique_ptr<ca_char_t[]>> chunks;   ///< Arena chunks.
+    ca_char_t *chunk_cur;                               ///< Next free byte of the current chunk.
+    ca_size_t chunk_left;                               ///< Free bytes in the current chunk.
+    ca_size_t chunk_size;                               ///< Size of regular chunks.
+    ca_size_t arena_bytes;                              ///< Total bytes allocated for chunks.
+    std::vector<entry> entries;                         ///< Entries indexed by id.
+    std::vector<id_type> slots;                         ///< Hash table of ids, `INVALID_ID` if empty.
+};
+
+/**
+ * @struct ca_sharded_intern_pool
+ * @brief A thread-safe interning pool split into independently locked shards.
+ *
+ * Each string is routed to a shard by its hash, and each shard is a
+ * `ca_intern_pool` guarded by a `std::shared_mutex`: lookups of strings that
+ * are already interned only take a shared lock, so parsers running in
+ * parallel mostly proceed without contention. The shard index is stored in
+ * the low bits of the id, which keeps ids unique and stable across shards.
+ *
+ * Ids are not dense; use `ca_intern_pool` where ids index side tables.
+ */
+struct ca_sharded_intern_pool {
+    /**
+     * @typedef id_type
+     * @brief Type of the ids, 32-bit unless built with ENABLE_64BIT_INDEX.
+     */
+    typedef ca_intern_pool::id_type id_type;
+
+    /**
+     * @brief Id returned by `find` for strings that are not interned.
+     */
+    static constexpr id_type INVALID_ID = ca_intern_pool::INVALID_ID;
+
+    /**
+     * @brief Default number of shards.
+     */
+    static constexpr ca_size_t DEFAULT_SHARDS = 16;
+
+    /**
+     * @brief Constructs an empty pool.
+     *
+     * @param num_shards Number of shards, rounded up to a power of two
+     *                   between 1 and 256.
+     * @param chunk_size Size of the arena chunks of each shard in bytes.
+     */
+    explicit ca_sharded_intern_pool(ca_size_t num_shards = DEFAULT_SHARDS,
+                                    ca_size_t chunk_size = ca_intern_pool::DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Interns a string, copying it into the pool if it is new.
+     *
+     * @param str [in] Pointer to the bytes. Must not be `nullptr` unless `size` is 0.
+     * @param size [in] Number of bytes.
+     * @return The id of the string.
+     */
+    id_type
+    intern(const ca_char_t *str, ca_size_t size);
+
+    /**
+     * @brief Interns the bytes of a buffer.
+     *
+     * @tparam encoding The encoding of the buffer.
+     * @param text The buffer to intern.
+     * @return The id of the buffer content.
+     */
+    template <ca_encoding_t encoding>
+    id_type
+    intern(ca_buffer<encoding> text);
+
+    /**
+     * @brief Looks up a string without interning it.
+     *
+     * @return The id of the string, or `INVALID_ID` if it is not interned.
+     */
+    [[nodiscard]] id_type
+    find(const ca_char_t *str, ca_size_t size) const;
+
+    /**
+     * @brief Returns a zero-copy view of an interned string.
+     *
+     * @param id The id of the string. Must have been returned by this pool.
+     * @return A buffer viewing the interned bytes, valid for the lifetime of the pool.
+     */
+    template <ca_encoding_t encoding = ca_encoding_t::CA_ENCODING_UTF8>
+    [[nodiscard]] ca_buffer<encoding>
+    view(id_type id) const;
+
+    /**
+     * @brief Returns the number of distinct strings in all shards.
+     */
+    [[nodiscard]] ca_size_t
+    size() const;
+
+private:
+    /**
+     * @brief A pool and the lock guarding it, padded to its own cache lines.
+     */
+    struct alignas(64) shard {
+        mutable std::shared_mutex mutex;    ///< Guards `pool`.
+        ca_intern_pool pool;                ///< Strings routed to this shard.
+
+        explicit shard(ca_size_t chunk_size);
+    };
+
+    /**
+     * @brief Returns the entry of an id under a shared lock of its shard.
+     */
+    [[nodiscard]] ca_intern_pool::entry
+    entry_of(id_type id) const;
+
+    std::vector<std::unique_ptr<shard>> shards;     ///< The shards.
+    ca_size_t shard_bits;                           ///< log2 of the number of shards.
+};
+
+}
+
+#include "../../private/ca_string/ca_intern_pool.tpp"
+
+#endif //CA_INTERN_POOL_H
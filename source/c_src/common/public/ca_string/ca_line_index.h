@@ -0,0 +1,155 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_string/ca_line_index.h
+//
+// @file
+// @brief Defines `ca_line_index`, a compact table of line start offsets for
+//        translating byte offsets of source buffers into (line, column)
+//        locations.
+// ================================
+
+#ifndef CA_LINE_INDEX_H
+#define CA_LINE_INDEX_H
+
+#include "ca_char_types.h"
+#include "ca_math.h"
+
+#include <vector>
+
+namespace ca::ca_string {
+
+/**
+ * @struct ca_line_index
+ * @brief A table of line start offsets of an ASCII or UTF-8 buffer.
+ *
+ * The table is built in one SIMD pass over the buffer (sized beforehand with
+ * `fastsearch::count_char`) and answers offset to line queries in O(log n)
+ * with a binary search. Lines are terminated by `\n`; a `\r` before it is
+ * treated as part of the line. Lines and columns are 0-based.
+ *
+ * The index does not keep a pointer to the buffer, so it can be serialized
+ * and stored next to cached file contents.
+ */
+struct ca_line_index {
+    /**
+     * @typedef offset_type
+     * @brief Type of the stored offsets. Buffers must be smaller than 4 GiB.
+     */
+    typedef ca_uint32_t offset_type;
+
+    /**
+     * @brief Constructs an empty index (a single empty line).
+     */
+    ca_line_index();
+
+    /**
+     * @brief Builds the index for a buffer, replacing the current content.
+     *
+     * @param buf [in] Pointer to the buffer. Must not be `nullptr` unless `size` is 0.
+     * @param size [in] Size of the buffer in bytes.
+     * @return
+     * - `0` on success.
+     * - `-1` if the buffer is too large for `offset_type`.
+     */
+    int
+    build(const ca_char_t *buf, ca_size_t size);
+
+    /**
+     * @brief Returns the number of lines, which is the number of `\n` plus one.
+     */
+    [[nodiscard]] ca_size_t
+    num_lines() const;
+
+    /**
+     * @brief Returns the size of the indexed buffer in bytes.
+     */
+    [[nodiscard]] ca_size_t
+    source_size() const;
+
+    /**
+     * @brief Returns the byte offset of the first character of a line.
+     *
+     * @param line The 0-based line number. Must be smaller than `num_lines()`.
+     */
+    [[nodiscard]] ca_size_t
+    line_start(ca_size_t line) const;
+
+    /**
+     * @brief Returns the byte offset just past the last character of a line,
+     *        excluding its `\n` terminator.
+     *
+     * @param line The 0-based line number. Must be smaller than `num_lines()`.
+     */
+    [[nodiscard]] ca_size_t
+    line_end(ca_size_t line) const;
+
+    /**
+     * @brief Returns the 0-based line containing a byte offset in O(log n).
+     *
+     * @param offset The byte offset. Offsets past the end of the buffer map
+     *               to the last line.
+     */
+    [[nodiscard]] ca_size_t
+    line_of(ca_size_t offset) const;
+
+    /**
+     * @brief Returns the 0-based column of a byte offset, counted in code points.
+     *
+     * @param buf [in] The indexed buffer (UTF-8 or ASCII). Must not be `nullptr`.
+     * @param offset The byte offset, at most `source_size()`.
+     */
+    [[nodiscard]] ca_size_t
+    column_of(const ca_char_t *buf, ca_size_t offset) const;
+
+    /**
+     * @brief Translates a byte offset into a 0-based (line, column) location.
+     *
+     * @param buf [in] The indexed buffer (UTF-8 or ASCII). Must not be `nullptr`.
+     * @param offset The byte offset, at most `source_size()`.
+     * @param line [out] Pointer to store the line. Must not be `nullptr`.
+     * @param column [out] Pointer to store the column in code points. Must not be `nullptr`.
+     */
+    void
+    location_of(const ca_char_t *buf, ca_size_t offset,
+                ca_size_t *line, ca_size_t *column) const;
+
+    /**
+     * @brief Returns the number of bytes `serialize` writes.
+     */
+    [[nodiscard]] ca_size_t
+    serialized_size() const;
+
+    /**
+     * @brief Serializes the index into a byte buffer.
+     *
+     * The format is a small header (magic, version, source size, line count)
+     * followed by the offsets, all in host byte order.
+     *
+     * @param out [out] Destination buffer. Must not be `nullptr`.
+     * @param capacity Size of `out` in bytes.
+     * @return
+     * - `0` on success.
+     * - `-1` if `capacity` is smaller than `serialized_size()`.
+     */
+    int
+    serialize(ca_char_t *out, ca_size_t capacity) const;
+
+    /**
+     * @brief Restores an index written by `serialize`.
+     *
+     * @param data [in] Serialized bytes. Must not be `nullptr`.
+     * @param size Size of `data` in bytes.
+     * @return
+     * - `0` on success.
+     * - `-1` if the data is truncated or malformed; the index is left unchanged.
+     */
+    int
+    deserialize(const ca_char_t *data, ca_size_t size);
+
+private:
+    std::vector<offset_type> line_starts;   ///< Offset of the first byte of every line.
+    ca_size_t size;                         ///< Size of the indexed buffer in bytes.
+};
+
+}
+
+#endif //CA_LINE_INDEX_H
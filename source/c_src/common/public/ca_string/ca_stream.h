@@ -1,8 +1,135 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_string/ca_stream.h
 //
-// Created by Eden_ on 2025/3/26.
-//
+// @file
+// @brief Defines `ca_stream`, an incremental UTF-8 decoder that pulls input
+//        in fixed-size chunks and hands them out as `ca_buffer` views.
+// ================================
 
 #ifndef CA_STREAM_H
 #define CA_STREAM_H
 
+#include "ca_buffer.h"
+#include "ca_char_types.h"
+#include "ca_math.h"
+
+#include <functional>
+#include <memory>
+
+namespace ca::ca_string {
+
+/**
+ * @typedef ca_stream_reader
+ * @brief Callback the stream pulls its input from.
+ *
+ * The reader fills up to `size` bytes at `buf` and returns the number of
+ * bytes written, `0` at the end of the input, or a negative value on error.
+ * Short reads are allowed.
+ */
+typedef std::function<ca_ssize_t(ca_char_t *buf, ca_size_t size)> ca_stream_reader;
+
+/**
+ * @enum ca_stream_status
+ * @brief Result of `ca_stream::next`.
+ */
+enum class ca_stream_status {
+    CA_STREAM_OK,               ///< A chunk was produced.
+    CA_STREAM_END,              ///< The input is exhausted; no chunk was produced.
+    CA_STREAM_READ_ERROR,       ///< The reader reported an error.
+    CA_STREAM_INVALID_UTF8,     ///< The input is not valid UTF-8, or ends inside a character.
+};
+
+/**
+ * @struct ca_stream
+ * @brief A pull-based UTF-8 decoder over an arbitrary byte source.
+ *
+ * Every call to `next` refills an internal buffer of `chunk_size` bytes from
+ * the reader and returns a view of it that ends on a character boundary. The
+ * bytes of a character split by the chunk boundary are carried over and
+ * prepended to the next chunk, so consumers never see partial sequences and
+ * the whole input is decoded without being held in memory at once.
+ *
+ * Chunks are validated with `utf8::utf8_validate` unless validation is
+ * disabled, in which case the input is trusted to be valid UTF-8.
+ *
+ * Once `next` returns anything but `CA_STREAM_OK`, later calls return the
+ * same status.
+ */
+struct ca_stream {
+    /**
+     * @brief Default chunk size in bytes.
+     */
+    static constexpr ca_size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Smallest accepted chunk size, which must hold the longest sequence.
+     */
+    static constexpr ca_size_t MIN_CHUNK_SIZE = 16;
+
+    /**
+     * @brief Constructs a stream over a reader.
+     *
+     * @param reader The input callback. Must not be empty.
+     * @param chunk_size Size of the internal buffer in bytes, raised to
+     *                   `MIN_CHUNK_SIZE` if smaller.
+     * @param validate Whether chunks are checked for valid UTF-8.
+     */
+    explicit ca_stream(ca_stream_reader reader,
+                       ca_size_t chunk_size = DEFAULT_CHUNK_SIZE,
+                       bool validate = true);
+
+    ca_stream(const ca_stream &) = delete;
+    ca_stream &operator=(const ca_stream &) = delete;
+
+    /**
+     * @brief Decodes the next chunk of input.
+     *
+     * @param chunk [out] Receives a view of the decoded bytes. The view stays
+     *              valid until the next call to `next` or until the stream is
+     *              destroyed. Must not be `nullptr`.
+     * @return
+     * - `CA_STREAM_OK` if a non-empty chunk was stored in `chunk`.
+     * - `CA_STREAM_END` at the end of the input.
+     * - `CA_STREAM_READ_ERROR` if the reader failed.
+     * - `CA_STREAM_INVALID_UTF8` if validation failed or the input ends in the
+     *   middle of a character.
+     */
+    ca_stream_status
+    next(ca_buffer<ca_encoding_t::CA_ENCODING_UTF8> *chunk);
+
+    /**
+     * @brief Returns the stream offset of the first byte of the last chunk.
+     */
+    [[nodiscard]] ca_size_t
+    chunk_offset() const;
+
+    /**
+     * @brief Returns the number of bytes handed out in chunks so far.
+     */
+    [[nodiscard]] ca_size_t
+    bytes_decoded() const;
+
+private:
+    /**
+     * @brief Reads until the buffer is full or the reader reaches its end.
+     *
+     * @return `0` on success, or `-1` if the reader failed.
+     */
+    int
+    fill();
+
+    ca_stream_reader reader;                ///< Input callback.
+    std::unique_ptr<ca_char_t[]> storage;   ///< Chunk buffer of `capacity` bytes.
+    ca_size_t capacity;                     ///< Size of `storage` in bytes.
+    ca_size_t filled;                       ///< Bytes currently held in `storage`.
+    ca_size_t carry;                        ///< Bytes at `storage + filled - carry` to keep for the next chunk.
+    ca_size_t offset;                       ///< Stream offset of the last chunk.
+    ca_size_t decoded;                      ///< Total bytes handed out.
+    ca_stream_status status;                ///< Sticky status once the stream has stopped.
+    bool eof;                               ///< Whether the reader reached its end.
+    bool validate;                          ///< Whether chunks are validated.
+};
+
+}
+
 #endif //CA_STREAM_H
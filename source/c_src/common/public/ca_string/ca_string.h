@@ -13,6 +13,9 @@
 #include "ca_char.h"
 #include "ca_char_types.h"
 #include "ca_fastsearch.h"
+#include "ca_hash.h"
+#include "ca_intern_pool.h"
+#include "ca_line_index.h"
 #include "ca_stream.h"
 #include "ca_utf8_utils.h"
 
@@ -119,6 +119,45 @@ num_codepoints_for_utf8_bytes(
         const ca_char_t *buf, ca_size_t max_bytes,
         ca_size_t *num_codepoints);
 
+// ----------------------------
+// Validation functions
+// ----------------------------
+
+/**
+ * @brief Validates that a buffer holds well-formed UTF-8.
+ *
+ * Whole 16-byte blocks of ASCII are skipped with SIMD while the decoder is
+ * between characters; every other byte goes through the UTF-8 DFA.
+ *
+ * @param buf [in] Pointer to the UTF-8 encoded bytes. Must not be `nullptr`.
+ * @param max_bytes [in] Number of bytes to validate.
+ * @return
+ * - `0` if the bytes are valid UTF-8 and end on a character boundary.
+ * - `-1` if an invalid or truncated sequence is found.
+ *
+ * @note Unlike the counting functions, trailing nulls are validated as
+ *       regular characters.
+ */
+int
+utf8_validate(const ca_char_t *buf, ca_size_t max_bytes);
+
+/**
+ * @brief Returns the number of trailing bytes that form an incomplete
+ *        UTF-8 sequence.
+ *
+ * This only inspects the last (at most 3) bytes, and is meant to find where a
+ * chunk of a longer stream must be cut so that no character is split.
+ *
+ * @param buf [in] Pointer to the UTF-8 encoded bytes. Must not be `nullptr`.
+ * @param max_bytes [in] Number of bytes in the buffer.
+ * @return The number of bytes (0 to 3) of the last, unfinished sequence.
+ *
+ * @note Bytes that can never start a complete sequence are not reported as
+ *       incomplete, and are left to `utf8_validate` to reject.
+ */
+ca_size_t
+utf8_incomplete_tail_size(const ca_char_t *buf, ca_size_t max_bytes);
+
 // ----------------------------
 // Buffer Size calculation functions
 // ----------------------------
@@ -0,0 +1,72 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_task/ca_parallel.h
+//
+// @file
+// @brief Declares `ca_parallel_for` and `ca_parallel_reduce`, loops over
+//        index ranges split across a `ca_task_pool`.
+// ================================
+
+#ifndef CA_PARALLEL_H
+#define CA_PARALLEL_H
+
+#include "ca_task_pool.h"
+#include "ca_math.h"
+
+namespace ca::ca_task {
+
+/**
+ * @brief Calls `body` on chunks covering `[begin, end)`, in parallel.
+ *
+ * The range is split in halves recursively: the thread splitting a range
+ * queues the right half, where idle workers can steal it, and goes on with
+ * the left half, until the pieces are at most `grain` indexes long. Large
+ * pieces are thus stolen first, and each worker walks its own pieces in
+ * index order. Without workers the chunks run in order on the calling thread.
+ *
+ * @param pool The pool running the chunks.
+ * @param begin The first index.
+ * @param end The index past the last one.
+ * @param grain The maximum length of a chunk, 0 to pick one giving each
+ *              worker about 8 chunks.
+ * @param body Called as `body(chunk_begin, chunk_end)` once per chunk, from
+ *             any thread.
+ * @param cancel Token stopping the loop, or `nullptr`. Chunks not started
+ *               when it is cancelled are skipped.
+ * @return 0 if every chunk ran, -1 if the loop was cancelled.
+ */
+template <typename Body>
+int
+ca_parallel_for(ca_task_pool &pool, ca_size_t begin, ca_size_t end, ca_size_t grain, Body &&body,
+                ca_cancel_token *cancel = nullptr);
+
+/**
+ * @brief Reduces `[begin, end)` in parallel.
+ *
+ * The range is cut into consecutive chunks of `grain` indexes, `map` reduces
+ * each chunk to a partial result, in parallel, and the partial results are
+ * combined from left to right, starting from `identity`. The grouping thus
+ * depends only on `grain`, so that the result does not depend on the
+ * scheduling even when `combine` is not associative, as for floating-point
+ * sums.
+ *
+ * @param pool The pool running the chunks.
+ * @param begin The first index.
+ * @param end The index past the last one.
+ * @param grain The length of a chunk, 0 to pick one giving each worker about
+ *              8 chunks.
+ * @param identity The result of an empty range.
+ * @param map Called as `map(chunk_begin, chunk_end)`, returning a `T`.
+ * @param combine Called as `combine(T, T)`, returning a `T`.
+ * @param cancel Token stopping the reduction, or `nullptr`.
+ * @return The result; `identity` if the reduction was cancelled.
+ */
+template <typename T, typename Map, typename Combine>
+T
+ca_parallel_reduce(ca_task_pool &pool, ca_size_t begin, ca_size_t end, ca_size_t grain, T identity, Map &&map,
+                   Combine &&combine, ca_cancel_token *cancel = nullptr);
+
+}
+
+#include "../../private/ca_task/ca_parallel.tpp"
+
+#endif //CA_PARALLEL_H
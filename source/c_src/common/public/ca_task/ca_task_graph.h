@@ -0,0 +1,106 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_task/ca_task_graph.h
+//
+// @file
+// @brief Defines `ca_task_graph`, tasks with dependencies run on a
+//        `ca_task_pool`.
+// ================================
+
+#ifndef CA_TASK_GRAPH_H
+#define CA_TASK_GRAPH_H
+
+#include "ca_task_pool.h"
+#include "ca_math.h"
+
+#include <functional>
+#include <vector>
+
+namespace ca::ca_task {
+
+/**
+ * @struct ca_task_graph
+ * @brief Directed acyclic graph of tasks, each started once all the tasks
+ *        it depends on have finished.
+ *
+ * The graph is built once and may be run any number of times. A run starts
+ * the tasks without dependencies, and the thread finishing the last
+ * dependency of a task starts it, so independent branches run in parallel
+ * with no thread waiting on a dependency.
+ */
+struct ca_task_graph {
+    typedef ca_size_t node_id;  ///< Index of a task in the graph.
+
+    /**
+     * @brief Adds a task.
+     *
+     * @param function The work, called with no argument.
+     * @return The id of the task.
+     */
+    node_id
+    add(std::function<void()> function);
+
+    /**
+     * @brief Makes `after` wait for `before` to finish.
+     *
+     * @param before The id of the task that runs first.
+     * @param after The id of the task that depends on it.
+     */
+    void
+    precede(node_id before, node_id after);
+
+    /**
+     * @brief Runs every task once, in an order compatible with the
+     *        dependencies, and waits for them.
+     *
+     * @param pool The pool running the tasks.
+     * @param cancel Token stopping the run, or `nullptr`. Tasks not started
+     *               when it is cancelled are skipped, with their successors.
+     * @return 0 on success, -1 if the dependencies form a cycle (nothing is
+     *         run) or the run was cancelled.
+     */
+    int
+    run(ca_task_pool &pool, ca_cancel_token *cancel = nullptr);
+
+    /**
+     * @brief Returns the number of tasks.
+     */
+    [[nodiscard]] ca_size_t
+    size() const {
+        return nodes.size();
+    }
+
+    /**
+     * @brief Removes every task.
+     */
+    void
+    clear() {
+        nodes.clear();
+    }
+
+private:
+    /**
+     * @struct node
+     * @brief A task and its edges.
+     */
+    struct node {
+        std::function<void()> function;     ///< The work.
+        std::vector<node_id> successors;    ///< Tasks depending on this one.
+        ca_size_t predecessors;             ///< Number of tasks this one depends on.
+    };
+
+    /**
+     * @brief Sorts the tasks topologically.
+     *
+     * @param order [out] Receives the ids in an order compatible with the
+     *              dependencies.
+     * @return 0 on success, -1 if the dependencies form a cycle.
+     */
+    int
+    sort(std::vector<node_id> *order) const;
+
+    std::vector<node> nodes;    ///< The tasks, indexed by id.
+};
+
+}
+
+#endif //CA_TASK_GRAPH_H
@@ -0,0 +1,305 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_task/ca_task_pool.h
+//
+// @file
+// @brief Defines `ca_task_pool`, a pool of work-stealing worker threads,
+//        `ca_task_group`, which runs tasks on it and waits for them, and
+//        `ca_cancel_token`, which stops them cooperatively.
+// ================================
+
+#ifndef CA_TASK_POOL_H
+#define CA_TASK_POOL_H
+
+#include "ca_work_deque.h"
+#include "ca_math.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ca::ca_task {
+
+/**
+ * @struct ca_cancel_token
+ * @brief Flag asking running work to stop.
+ *
+ * Cancellation is cooperative: tasks of a cancelled group that have not
+ * started are skipped, and long tasks are expected to poll `cancelled`.
+ */
+struct ca_cancel_token {
+    /**
+     * @brief Asks the work to stop. Thread-safe.
+     */
+    void
+    cancel() {
+        flag.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Checks if the work was asked to stop. Thread-safe.
+     */
+    [[nodiscard]] bool
+    cancelled() const {
+        return flag.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Clears the request, for reuse once the work has stopped.
+     */
+    void
+    reset() {
+        flag.store(false, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> flag{ false };    ///< Whether the work was asked to stop.
+};
+
+/**
+ * @struct ca_task_pool_options
+ * @brief Controls a `ca_task_pool`.
+ */
+struct ca_task_pool_options {
+    /**
+     * @brief Number of worker threads, 0 for one per hardware thread.
+     *        Ignored without ENABLE_THREADING, where the pool has none.
+     */
+    ca_size_t threads = 0;
+
+    /**
+     * @brief Whether to pin worker `i` to logical CPU `i` (modulo the number
+     *        of CPUs), so its deque and the data of its tasks stay in one
+     *        core's caches. Supported on Linux and Windows, ignored elsewhere.
+     */
+    bool pin_threads = false;
+};
+
+/**
+ * @struct ca_task_pool_stats
+ * @brief Counters of a `ca_task_pool` since it was constructed.
+ */
+struct ca_task_pool_stats {
+    ca_uint64_t executed;       ///< Tasks run, by workers or by waiting threads.
+    ca_uint64_t skipped;        ///< Tasks skipped because their group was cancelled.
+    ca_uint64_t stolen;         ///< Tasks taken from the deque of another worker.
+    ca_uint64_t injected;       ///< Tasks submitted from outside the workers.
+    ca_uint64_t sleeps;         ///< Times a worker went to sleep for lack of work.
+};
+
+struct ca_task_group;
+
+namespace internal {
+
+/**
+ * @struct ca_task
+ * @brief A submitted task, owned by the pool until it has run.
+ */
+struct ca_task {
+    std::function<void()> function;     ///< The work.
+    ca_task_group *group;               ///< The group waiting for it.
+};
+
+}
+
+/**
+ * @struct ca_task_pool
+ * @brief Worker threads running tasks, balanced by work stealing.
+ *
+ * Each worker owns a `ca_work_deque`. A task submitted by a worker, such as
+ * the halves of a split range, goes to the bottom of that worker's deque,
+ * where the worker takes it back next; idle workers steal from the top of
+ * the others' deques. Tasks submitted from other threads go to a shared
+ * injection queue, which workers check before stealing. Workers with
+ * nothing to run sleep on a condition variable and are woken by the next
+ * submission.
+ *
+ * Tasks are run through a `ca_task_group`, whose `wait` runs tasks itself
+ * instead of blocking while there are any, so a task may start and wait for
+ * nested tasks without tying up its worker.
+ *
+ * Without ENABLE_THREADING the pool has no threads and every task runs
+ * inline, in the thread that submits it.
+ */
+struct ca_task_pool {
+    /**
+     * @brief Worker index of the threads that are not workers of the pool.
+     */
+    static constexpr ca_size_t NOT_A_WORKER = static_cast<ca_size_t>(-1);
+
+    /**
+     * @brief Constructs a pool and starts its workers.
+     *
+     * @param options The options.
+     */
+    explicit ca_task_pool(const ca_task_pool_options &options = {});
+
+    /**
+     * @brief Runs the tasks left, then stops and joins the workers.
+     */
+    ~ca_task_pool();
+
+    ca_task_pool(const ca_task_pool &) = delete;
+    ca_task_pool &operator=(const ca_task_pool &) = delete;
+
+    /**
+     * @brief Returns the number of worker threads, 0 without ENABLE_THREADING.
+     */
+    [[nodiscard]] ca_size_t
+    threads() const {
+        return workers.size();
+    }
+
+    /**
+     * @brief Returns the index of the calling thread among the workers of
+     *        the pool, or `NOT_A_WORKER`.
+     */
+    [[nodiscard]] ca_size_t
+    worker_index() const;
+
+    /**
+     * @brief Returns the counters of the pool.
+     */
+    [[nodiscard]] ca_task_pool_stats
+    stats() const;
+
+private:
+    friend struct ca_task_group;
+
+    struct worker;
+
+    /**
+     * @brief Queues a task, or runs it inline without threads.
+     */
+    void
+    submit(internal::ca_task *task);
+
+    /**
+     * @brief Takes a task for the worker `index` (or a waiting thread if
+     *        `NOT_A_WORKER`): its own deque, then the injection queue, then
+     *        the other deques.
+     */
+    internal::ca_task *
+    find_task(ca_size_t index);
+
+    /**
+     * @brief Runs a task, unless its group was cancelled, and frees it.
+     */
+    void
+    execute(internal::ca_task *task);
+
+    /**
+     * @brief Checks if any queue holds a task.
+     */
+    [[nodiscard]] bool
+    has_work() const;
+
+    /**
+     * @brief Main loop of the worker `index`.
+     */
+    void
+    work(ca_size_t index, bool pin);
+
+    std::vector<std::unique_ptr<worker>> workers;   ///< The workers.
+    std::mutex inject_lock;                         ///< Guards `injected`.
+    std::deque<internal::ca_task *> injected;       ///< Tasks submitted from outside.
+    std::atomic<ca_size_t> injected_count;          ///< Size of `injected`, read without the lock.
+    std::mutex sleep_lock;                          ///< Guards sleeping and waking.
+    std::condition_variable wake;                   ///< Wakes sleeping workers.
+    std::atomic<ca_size_t> sleepers;                ///< Workers sleeping or about to.
+    std::atomic<bool> stopping;                     ///< Set when the pool is destroyed.
+
+    std::atomic<ca_uint64_t> executed;              ///< See `ca_task_pool_stats`.
+    std::atomic<ca_uint64_t> skipped;               ///< See `ca_task_pool_stats`.
+    std::atomic<ca_uint64_t> stolen;                ///< See `ca_task_pool_stats`.
+    std::atomic<ca_uint64_t> injections;            ///< See `ca_task_pool_stats`.
+    std::atomic<ca_uint64_t> sleeps;                ///< See `ca_task_pool_stats`.
+};
+
+/**
+ * @struct ca_task_group
+ * @brief Tasks run on a pool and waited for together.
+ *
+ * Tasks may be added from any thread, including from tasks of the group.
+ * `wait` returns once every task added so far and every task they added
+ * has finished or been skipped; the destructor waits too.
+ */
+struct ca_task_group {
+    /**
+     * @brief Constructs an empty group.
+     *
+     * @param pool The pool running the tasks.
+     * @param cancel Token cancelling the group, or `nullptr` for a token of
+     *               the group's own, reachable through `cancel`.
+     */
+    explicit ca_task_group(ca_task_pool &pool, ca_cancel_token *cancel = nullptr);
+
+    /**
+     * @brief Waits for the tasks.
+     */
+    ~ca_task_group();
+
+    ca_task_group(const ca_task_group &) = delete;
+    ca_task_group &operator=(const ca_task_group &) = delete;
+
+    /**
+     * @brief Adds a task.
+     *
+     * @param function The work, called with no argument.
+     */
+    void
+    run(std::function<void()> function);
+
+    /**
+     * @brief Waits for every task of the group, running queued tasks of any
+     *        group meanwhile.
+     */
+    void
+    wait();
+
+    /**
+     * @brief Cancels the group: tasks that have not started are skipped.
+     */
+    void
+    cancel() {
+        token->cancel();
+    }
+
+    /**
+     * @brief Checks if the group was cancelled.
+     */
+    [[nodiscard]] bool
+    cancelled() const {
+        return token->cancelled();
+    }
+
+    /**
+     * @brief Returns the pool of the group.
+     */
+    [[nodiscard]] ca_task_pool &
+    pool() const {
+        return owner;
+    }
+
+private:
+    friend struct ca_task_pool;
+
+    /**
+     * @brief Marks one task as done.
+     */
+    void
+    finish();
+
+    ca_task_pool &owner;                    ///< The pool.
+    ca_cancel_token own_token;              ///< Token used when none is given.
+    ca_cancel_token *token;                 ///< The token of the group.
+    std::atomic<ca_size_t> pending;         ///< Tasks added and not finished.
+};
+
+}
+
+#endif //CA_TASK_POOL_H
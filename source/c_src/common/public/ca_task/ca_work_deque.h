@@ -0,0 +1,126 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/public/ca_task/ca_work_deque.h
+//
+// @file
+// @brief Defines `ca_work_deque`, the lock-free Chase-Lev work-stealing
+//        deque of the task pool.
+// ================================
+
+#ifndef CA_WORK_DEQUE_H
+#define CA_WORK_DEQUE_H
+
+#include "ca_math.h"
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ca::ca_task {
+
+/**
+ * @struct ca_work_deque
+ * @brief Deque of work items with one owner and any number of thieves.
+ *
+ * The owner pushes and pops at the bottom, newest first, which keeps the
+ * items it spawned hot in its cache; thieves steal at the top, oldest first,
+ * which are usually the largest pieces of work left. This is the Chase-Lev
+ * deque with the memory orderings of Lê et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013): push and pop cost no
+ * atomic read-modify-write except when racing a thief for the last item,
+ * and steals contend only on `top`.
+ *
+ * The ring grows by doubling when full. A thief may still be reading the
+ * old ring, so old rings are kept until the deque is destroyed; they add up
+ * to less than the current ring.
+ *
+ * @tparam T Type of the items, trivially copyable, typically a pointer.
+ */
+template <typename T>
+struct ca_work_deque {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    /**
+     * @brief Constructs an empty deque.
+     *
+     * @param capacity Initial capacity, rounded up to a power of two.
+     */
+    explicit ca_work_deque(ca_size_t capacity = 256);
+
+    ca_work_deque(const ca_work_deque &) = delete;
+    ca_work_deque &operator=(const ca_work_deque &) = delete;
+
+    /**
+     * @brief Adds an item at the bottom. Owner only.
+     */
+    void
+    push(T item);
+
+    /**
+     * @brief Removes the item at the bottom. Owner only.
+     *
+     * @param item [out] Receives the item. Must not be `nullptr`.
+     * @return Whether an item was removed.
+     */
+    bool
+    pop(T *item);
+
+    /**
+     * @brief Removes the item at the top. Any thread.
+     *
+     * @param item [out] Receives the item. Must not be `nullptr`.
+     * @return Whether an item was removed; `false` if the deque was empty or
+     *         another thread took the item first.
+     */
+    bool
+    steal(T *item);
+
+    /**
+     * @brief Returns the number of items, which may be stale as soon as it
+     *        is returned unless called by the owner with no thief running.
+     */
+    [[nodiscard]] ca_size_t
+    size() const;
+
+    /**
+     * @brief Checks if the deque looks empty, with the same caveat as `size`.
+     */
+    [[nodiscard]] bool
+    empty() const {
+        return size() == 0;
+    }
+
+private:
+    /**
+     * @struct ring
+     * @brief Circular array of the items, indexed modulo its capacity.
+     */
+    struct ring {
+        explicit ring(ca_size_t capacity);
+
+        [[nodiscard]] T
+        get(ca_int64_t index) const {
+            return items[static_cast<ca_size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        void
+        put(ca_int64_t index, T item) {
+            items[static_cast<ca_size_t>(index) & mask].store(item, std::memory_order_relaxed);
+        }
+
+        ca_size_t capacity;                         ///< Number of slots, a power of two.
+        ca_size_t mask;                             ///< `capacity - 1`.
+        std::unique_ptr<std::atomic<T>[]> items;    ///< The slots.
+    };
+
+    alignas(64) std::atomic<ca_int64_t> top;        ///< Index of the oldest item, advanced by thieves and the last pop.
+    alignas(64) std::atomic<ca_int64_t> bottom;     ///< Index past the newest item, moved by the owner.
+    std::atomic<ring *> array;                      ///< The current ring.
+    std::vector<std::unique_ptr<ring>> rings;       ///< Every ring allocated, the current one last.
+};
+
+}
+
+#include "../../private/ca_task/ca_work_deque.tpp"
+
+#endif //CA_WORK_DEQUE_H
@@ -0,0 +1,157 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_io_core/test_ca_io_file_cache.cpp
+//
+// @file
+// @brief Tests file stamps and the stamp-keyed file cache.
+// ================================
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/ca_io_file_cache.h"
+#include "ca_hash.h"
+#include "ca_test_temp_dir.h"
+
+using namespace ca;
+using namespace ca::ca_io;
+
+namespace {
+
+class CaFileCacheTest : public ca_test::ca_temp_dir_test<> {
+};
+
+std::string as_string(const ca_cached_file &file) {
+    return { reinterpret_cast<const char *>(file.view.data()), file.view.size() };
+}
+
+}
+
+TEST_F(CaFileCacheTest, Stat_IdentifiesFiles) {
+    const std::string path = write_file("a.h", "int a;\n");
+    ca_file_stamp first{};
+    ca_file_stamp second{};
+    ASSERT_EQ(ca_file_stat(path.c_str(), &first), ca_file_result::FILE_OK);
+    ASSERT_EQ(ca_file_stat(path.c_str(), &second), ca_file_result::FILE_OK);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first.size, 7u);
+
+    const std::string other = write_file("b.h", "int a;\n");
+    ASSERT_EQ(ca_file_stat(other.c_str(), &second), ca_file_result::FILE_OK);
+    EXPECT_NE(first, second);
+
+    EXPECT_EQ(ca_file_stat((dir / "missing.h").string().c_str(), &second), ca_file_result::FILE_ERROR_NOT_FOUND);
+}
+
+TEST_F(CaFileCacheTest, Get_ComputesFactsAndHits) {
+    const std::string content = "#include <a.h>\nint main() {\n    return 0;\n}\n";
+    const std::string path = write_file("main.c", content);
+
+    ca_file_cache cache;
+    ca_cached_file_ptr file;
+    ASSERT_EQ(cache.get(path.c_str(), &file), ca_file_result::FILE_OK);
+    EXPECT_EQ(as_string(*file), content);
+    EXPECT_EQ(file->hash, ca_string::ca_hash64(file->view.data(), file->view.size()));
+    EXPECT_TRUE(file->is_ascii);
+    EXPECT_EQ(file->lines.num_lines(), 5u);
+    EXPECT_EQ(file->lines.line_start(2), 28u);
+
+    ca_cached_file_ptr again;
+    ASSERT_EQ(cache.get(path.c_str(), &again), ca_file_result::FILE_OK);
+    EXPECT_EQ(again.get(), file.get());
+
+    const ca_file_cache_stats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_EQ(stats.bytes, file->charge());
+
+    // Non-ASCII contents, past the 32-byte blocks
+    const std::string utf8 = std::string(40, 'x') + "\xC3\xA9";
+    ASSERT_EQ(cache.get(write_file("u.c", utf8).c_str(), &file), ca_file_result::FILE_OK);
+    EXPECT_FALSE(file->is_ascii);
+
+    EXPECT_EQ(cache.get((dir / "missing.h").string().c_str(), &file), ca_file_result::FILE_ERROR_NOT_FOUND);
+}
+
+TEST_F(CaFileCacheTest, Get_ModifiedFileIsReloaded) {
+    const std::string path = write_file("a.h", "old");
+    ca_file_cache cache;
+    ca_cached_file_ptr old_file;
+    ASSERT_EQ(cache.get(path.c_str(), &old_file), ca_file_result::FILE_OK);
+
+    write_file("a.h", "newer");
+    ca_cached_file_ptr new_file;
+    ASSERT_EQ(cache.get(path.c_str(), &new_file), ca_file_result::FILE_OK);
+    EXPECT_EQ(as_string(*new_file), "newer");
+    // Readers of the old version keep it
+    EXPECT_EQ(as_string(*old_file), "old");
+    EXPECT_EQ(cache.stats().misses, 2u);
+}
+
+TEST_F(CaFileCacheTest, Budget_EvictsLeastRecentlyUsed) {
+    // One file fits a shard, whatever shard the stamps hash to
+    ca_cached_file_ptr probe;
+    ca_file_cache sizing;
+    ASSERT_EQ(sizing.get(write_file("probe.h", std::string(1000, 'p')).c_str(), &probe), ca_file_result::FILE_OK);
+    const ca_size_t charge = probe->charge();
+
+    ca_file_cache cache(ca_file_cache::NUM_SHARDS * (charge + charge / 2));
+    std::vector<std::string> paths;
+    for (int i = 0; i < 64; ++i) {
+        paths.push_back(write_file("f" + std::to_string(i) + ".h", std::string(1000, static_cast<char>('a' + i % 26))));
+        ca_cached_file_ptr file;
+        ASSERT_EQ(cache.get(paths.back().c_str(), &file), ca_file_result::FILE_OK);
+    }
+
+    ca_file_cache_stats stats = cache.stats();
+    EXPECT_LE(stats.bytes, cache.budget());
+    EXPECT_LE(stats.entries, ca_file_cache::NUM_SHARDS);
+    EXPECT_EQ(stats.entries + stats.evictions, 64u);
+
+    // The newest file is always cached
+    ca_cached_file_ptr file;
+    ASSERT_EQ(cache.get(paths.back().c_str(), &file), ca_file_result::FILE_OK);
+    EXPECT_EQ(cache.stats().hits, 1u);
+
+    cache.set_budget(0);
+    stats = cache.stats();
+    EXPECT_EQ(stats.entries, 0u);
+    EXPECT_EQ(stats.bytes, 0u);
+    // Evicted files stay alive for their readers
+    EXPECT_EQ(file->view.size(), 1000u);
+
+    // Files beyond the budget are returned uncached
+    ASSERT_EQ(cache.get(paths.front().c_str(), &file), ca_file_result::FILE_OK);
+    EXPECT_EQ(file->view.size(), 1000u);
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+TEST_F(CaFileCacheTest, Get_ConcurrentReaders) {
+    std::vector<std::string> paths;
+    for (int i = 0; i < 32; ++i) {
+        paths.push_back(write_file("h" + std::to_string(i) + ".h", "// header " + std::to_string(i) + "\n"));
+    }
+
+    ca_file_cache cache;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&cache, &paths] {
+            for (int round = 0; round < 20; ++round) {
+                for (ca_size_t i = 0; i < paths.size(); ++i) {
+                    ca_cached_file_ptr file;
+                    ASSERT_EQ(cache.get(paths[i].c_str(), &file), ca_file_result::FILE_OK);
+                    ASSERT_EQ(as_string(*file), "// header " + std::to_string(i) + "\n");
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    const ca_file_cache_stats stats = cache.stats();
+    EXPECT_EQ(stats.entries, paths.size());
+    EXPECT_EQ(stats.hits + stats.misses, 8u * 20u * paths.size());
+}
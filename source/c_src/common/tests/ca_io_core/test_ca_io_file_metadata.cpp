@@ -0,0 +1,117 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_io_core/test_ca_io_file_metadata.cpp
+//
+// @file
+// @brief Tests batched metadata scanning and snapshot comparison.
+// ================================
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+#include "core/ca_io_file_metadata.h"
+#include "ca_test_temp_dir.h"
+
+using namespace ca;
+using namespace ca::ca_io;
+
+namespace {
+
+/**
+ * Runs every test with io_uring enabled and disabled.
+ */
+class CaFileMetadataTest : public ca_test::ca_temp_dir_test<::testing::TestWithParam<bool>> {
+protected:
+    void SetUp() override {
+        ca_temp_dir_test::SetUp();
+        options.use_io_uring = GetParam();
+        options.queue_depth = 16;
+        options.num_threads = 4;
+    }
+
+    ca_metadata_scan_options options;
+};
+
+std::vector<ca_file_change>
+diff(const ca_metadata_snapshot &before, const ca_metadata_snapshot &after) {
+    std::vector<ca_file_change> changes;
+    ca_metadata_snapshot_diff(before, after, &changes);
+    return changes;
+}
+
+}
+
+TEST_P(CaFileMetadataTest, Scan_QueriesEveryPath) {
+    // More files than the queue depth and than one thread chunk
+    std::vector<std::string> names;
+    for (ca_size_t i = 0; i < 1000; ++i) {
+        names.push_back(write_file("f" + std::to_string(i) + ".c", std::string(i % 97, 'x')));
+    }
+    names.push_back((dir / "missing.c").string());
+    names.push_back(dir.string());
+
+    std::vector<const char *> paths;
+    for (const std::string &name : names) {
+        paths.push_back(name.c_str());
+    }
+    std::vector<ca_file_metadata> metadata(paths.size());
+    ca_file_metadata_scan(paths, metadata, options);
+
+    for (ca_size_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(metadata[i].result, ca_file_result::FILE_OK) << i;
+        EXPECT_EQ(metadata[i].size, i % 97);
+        EXPECT_TRUE((metadata[i].mode & S_IFMT) == S_IFREG);
+        EXPECT_GT(metadata[i].mtime_ns, 0);
+    }
+    EXPECT_EQ(metadata[1000].result, ca_file_result::FILE_ERROR_NOT_FOUND);
+    EXPECT_EQ(metadata[1000].size, 0u);
+    EXPECT_EQ(metadata[1001].result, ca_file_result::FILE_OK);
+    EXPECT_TRUE((metadata[1001].mode & S_IFMT) == S_IFDIR);
+}
+
+TEST_P(CaFileMetadataTest, SnapshotDiff_ReportsChanges) {
+    ca_path_table table;
+    std::vector<ca_path_id> ids;
+    for (int i = 0; i < 6; ++i) {
+        ids.push_back(table.intern(write_file("h" + std::to_string(i) + ".h", "int x;\n")));
+    }
+    const ca_path_id later = table.intern((dir / "later.h").string());
+    ids.push_back(later);
+
+    ca_metadata_snapshot before;
+    ca_metadata_snapshot_take(table, ids, &before, options);
+    EXPECT_EQ(before.ids.size(), ids.size());
+    EXPECT_TRUE(diff(before, before).empty());
+
+    write_file("h1.h", "int x, y;\n");                  // modified
+    std::filesystem::remove(dir / "h2.h");              // removed
+    write_file("later.h", "");                          // added
+    const ca_path_id extra = table.intern(write_file("extra.h", ""));
+    ids.push_back(extra);                               // added to the set
+    ids.erase(ids.begin() + 3);                         // dropped from the set
+    ids.push_back(ids.front());                         // duplicate
+
+    ca_metadata_snapshot after;
+    ca_metadata_snapshot_take(table, ids, &after, options);
+    EXPECT_EQ(after.ids.size(), 7u);
+    EXPECT_TRUE(std::is_sorted(after.ids.begin(), after.ids.end()));
+
+    const std::vector<ca_file_change> changes = diff(before, after);
+    ASSERT_EQ(changes.size(), 5u);
+    EXPECT_EQ(changes[0].id, ids[1]);
+    EXPECT_EQ(changes[0].kind, ca_file_change_kind::FILE_CHANGE_MODIFIED);
+    EXPECT_EQ(changes[1].id, ids[2]);
+    EXPECT_EQ(changes[1].kind, ca_file_change_kind::FILE_CHANGE_REMOVED);
+    EXPECT_EQ(changes[2].kind, ca_file_change_kind::FILE_CHANGE_REMOVED);      // h3, no longer tracked
+    EXPECT_EQ(changes[3].id, later);
+    EXPECT_EQ(changes[3].kind, ca_file_change_kind::FILE_CHANGE_ADDED);
+    EXPECT_EQ(changes[4].id, extra);
+    EXPECT_EQ(changes[4].kind, ca_file_change_kind::FILE_CHANGE_ADDED);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, CaFileMetadataTest, ::testing::Bool(),
+                         [](const ::testing::TestParamInfo<bool> &info) {
+                             return info.param ? "IoUring" : "Threaded";
+                         });
@@ -0,0 +1,157 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_io_core/test_ca_io_file_rw_asyn.cpp
+//
+// @file
+// @brief Tests asynchronous batch file reading with both backends.
+// ================================
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "core/ca_io_file_rw.h"
+#include "ca_test_temp_dir.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ca;
+using namespace ca::ca_io;
+
+namespace {
+
+/**
+ * Runs every test with io_uring enabled and disabled.
+ */
+class CaAsyncFileReaderTest : public ca_test::ca_temp_dir_test<::testing::TestWithParam<bool>> {
+protected:
+    void SetUp() override {
+        ca_temp_dir_test::SetUp();
+        options.use_io_uring = GetParam();
+        options.queue_depth = 8;
+        options.num_threads = 4;
+    }
+
+    static std::string content_of(const ca_size_t i) {
+        // Sizes from empty to a few hundred KiB
+        std::string content((i * i * 37) % (300 * 1024), '\0');
+        for (ca_size_t j = 0; j < content.size(); ++j) {
+            content[j] = static_cast<char>('a' + (i + j) % 26);
+        }
+        return content;
+    }
+
+    ca_async_reader_options options;
+};
+
+std::string as_string(const ca_file_view &view) {
+    return { reinterpret_cast<const char *>(view.data()), view.size() };
+}
+
+}
+
+TEST_P(CaAsyncFileReaderTest, ReadBatch_DeliversEveryFile) {
+    constexpr ca_size_t num_files = 100;
+    std::vector<std::string> paths;
+    for (ca_size_t i = 0; i < num_files; ++i) {
+        paths.push_back(write_file("f" + std::to_string(i) + ".c", content_of(i)));
+    }
+    paths.push_back((dir / "missing.c").string());
+
+    std::mutex mutex;
+    std::vector<int> seen(paths.size(), 0);
+    std::vector<std::string> contents(paths.size());
+    std::vector<ca_file_result> results(paths.size());
+
+    ca_async_file_reader reader(options);
+    EXPECT_EQ(reader.uses_io_uring() && !GetParam(), false);
+    reader.read_batch(paths, [&](const ca_size_t index, const ca_file_result result, ca_file_view &&view) {
+        std::lock_guard lock(mutex);
+        ++seen[index];
+        results[index] = result;
+        contents[index] = as_string(view);
+    });
+    reader.wait();
+
+    for (ca_size_t i = 0; i < num_files; ++i) {
+        EXPECT_EQ(seen[i], 1);
+        EXPECT_EQ(results[i], ca_file_result::FILE_OK) << paths[i];
+        EXPECT_EQ(contents[i], content_of(i)) << paths[i];
+    }
+    EXPECT_EQ(seen[num_files], 1);
+    EXPECT_EQ(results[num_files], ca_file_result::FILE_ERROR_NOT_FOUND);
+}
+
+TEST_P(CaAsyncFileReaderTest, Read_Future) {
+    const std::string path = write_file("single.c", content_of(7));
+
+    ca_async_file_reader reader(options);
+    std::future<ca_async_read_result> future = reader.read(path.c_str());
+    std::future<ca_async_read_result> directory = reader.read(dir.string().c_str());
+
+    ca_async_read_result result = future.get();
+    EXPECT_EQ(result.result, ca_file_result::FILE_OK);
+    EXPECT_EQ(as_string(result.view), content_of(7));
+    EXPECT_EQ(directory.get().result, ca_file_result::FILE_ERROR_ACCESS_DENIED);
+}
+
+TEST_P(CaAsyncFileReaderTest, ReadBatch_SeveralBatches) {
+    std::vector<std::string> paths;
+    for (ca_size_t i = 0; i < 20; ++i) {
+        paths.push_back(write_file("b" + std::to_string(i) + ".h", content_of(i + 3)));
+    }
+
+    std::atomic<ca_size_t> total = 0;
+    ca_async_file_reader reader(options);
+    for (int batch = 0; batch < 5; ++batch) {
+        reader.read_batch(paths, [&](ca_size_t, const ca_file_result result, ca_file_view &&view) {
+            EXPECT_EQ(result, ca_file_result::FILE_OK);
+            total += view.size();
+        });
+    }
+    reader.wait();
+
+    ca_size_t expected = 0;
+    for (ca_size_t i = 0; i < 20; ++i) {
+        expected += content_of(i + 3).size();
+    }
+    EXPECT_EQ(total.load(), 5 * expected);
+}
+
+#if !defined(_WIN32)
+TEST_P(CaAsyncFileReaderTest, Read_PipeDoesNotDelayOtherFiles) {
+    const std::string fifo = (dir / "fifo").string();
+    ASSERT_EQ(mkfifo(fifo.c_str(), 0600), 0);
+    const std::string path = write_file("after.c", content_of(5));
+
+    // Holding the write end open lets the FIFO be opened, but its read waits for the data
+    const int fd = open(fifo.c_str(), O_RDWR | O_CLOEXEC);
+    ASSERT_GE(fd, 0);
+
+    ca_async_file_reader reader(options);
+    std::future<ca_async_read_result> pipe = reader.read(fifo.c_str());
+    std::future<ca_async_read_result> file = reader.read(path.c_str());
+    const bool file_ready = file.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+
+    EXPECT_EQ(write(fd, "abc", 3), 3);
+    close(fd);
+    ASSERT_TRUE(file_ready);
+    ca_async_read_result result = file.get();
+    EXPECT_EQ(result.result, ca_file_result::FILE_OK);
+    EXPECT_EQ(as_string(result.view), content_of(5));
+
+    result = pipe.get();
+    EXPECT_EQ(result.result, ca_file_result::FILE_OK);
+    EXPECT_EQ(as_string(result.view), "abc");
+}
+#endif
+
+INSTANTIATE_TEST_SUITE_P(Backends, CaAsyncFileReaderTest, ::testing::Bool(),
+                         [](const ::testing::TestParamInfo<bool> &info) {
+                             return info.param ? "IoUring" : "ThreadPool";
+                         });
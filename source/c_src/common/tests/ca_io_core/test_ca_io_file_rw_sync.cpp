@@ -0,0 +1,168 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_io_core/test_ca_io_file_rw_sync.cpp
+//
+// @file
+// @brief Tests synchronous file loading and the read buffer pool.
+// ================================
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "core/ca_io_file_rw.h"
+#include "ca_test_temp_dir.h"
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
+using namespace ca;
+using namespace ca::ca_io;
+
+namespace {
+
+class CaIoFileRwSyncTest : public ca_test::ca_temp_dir_test<> {
+};
+
+std::string make_content(const ca_size_t size) {
+    std::string content(size, '\0');
+    for (ca_size_t i = 0; i < size; ++i) {
+        content[i] = static_cast<char>('a' + i % 26);
+    }
+    return content;
+}
+
+std::string as_string(const ca_file_view &view) {
+    return { reinterpret_cast<const char *>(view.data()), view.size() };
+}
+
+}
+
+// ===============================
+// Buffer pool
+// ===============================
+
+TEST(CaIoBufferPoolTest, Acquire_ReusesReleasedBlocks) {
+    ca_io_buffer_pool pool;
+    ca_size_t capacity;
+    ca_string::ca_char_t *block = pool.acquire(5000, &capacity);
+    EXPECT_EQ(capacity, 8192u);
+
+    pool.release(block, capacity);
+    EXPECT_EQ(pool.cached_bytes(), 8192u);
+
+    ca_size_t capacity2;
+    EXPECT_EQ(pool.acquire(6000, &capacity2), block);
+    EXPECT_EQ(capacity2, 8192u);
+    EXPECT_EQ(pool.cached_bytes(), 0u);
+    pool.release(block, capacity2);
+
+    // Sizes below the minimum share the smallest class
+    ca_size_t capacity3;
+    ca_string::ca_char_t *small = pool.acquire(1, &capacity3);
+    pool.release(small, capacity3);
+    EXPECT_EQ(capacity3, ca_io_buffer_pool::MIN_BLOCK_SIZE);
+}
+
+TEST(CaIoBufferPoolTest, Release_RespectsLimit) {
+    ca_io_buffer_pool pool(8192);
+    ca_size_t c1, c2;
+    ca_string::ca_char_t *b1 = pool.acquire(8192, &c1);
+    ca_string::ca_char_t *b2 = pool.acquire(8192, &c2);
+    pool.release(b1, c1);
+    pool.release(b2, c2);
+    EXPECT_EQ(pool.cached_bytes(), 8192u);
+}
+
+// ===============================
+// File reading
+// ===============================
+
+TEST_F(CaIoFileRwSyncTest, Read_SmallFileIsPooled) {
+    const std::string path = write_file("small.c", "int main() { return 0; }\n");
+    ca_io_buffer_pool pool;
+    ca_file_read_options options;
+    options.pool = &pool;
+
+    ca_file_view view;
+    ASSERT_EQ(ca_file_read(path.c_str(), &view, options), ca_file_result::FILE_OK);
+    EXPECT_FALSE(view.is_mapped());
+    EXPECT_EQ(as_string(view), "int main() { return 0; }\n");
+
+    const auto buffer = view.buffer();
+    EXPECT_EQ(buffer.buf, view.data());
+    EXPECT_EQ(static_cast<ca_size_t>(buffer.after - buffer.buf), view.size());
+
+    view.reset();
+    EXPECT_TRUE(view.empty());
+    EXPECT_EQ(pool.cached_bytes(), ca_io_buffer_pool::MIN_BLOCK_SIZE);
+}
+
+TEST_F(CaIoFileRwSyncTest, Read_LargeFileIsMapped) {
+    const std::string content = make_content(300 * 1024 + 17);
+    const std::string path = write_file("large.c", content);
+
+    ca_file_view view;
+    ASSERT_EQ(ca_file_read(path.c_str(), &view), ca_file_result::FILE_OK);
+    EXPECT_TRUE(view.is_mapped());
+    EXPECT_EQ(as_string(view), content);
+
+    // The threshold decides between the two paths
+    ca_file_read_options options;
+    options.mmap_threshold = CA_SIZE_T_MAX;
+    ASSERT_EQ(ca_file_read(path.c_str(), &view, options), ca_file_result::FILE_OK);
+    EXPECT_FALSE(view.is_mapped());
+    EXPECT_EQ(as_string(view), content);
+}
+
+TEST_F(CaIoFileRwSyncTest, Read_EmptyFile) {
+    const std::string path = write_file("empty.c", "");
+    ca_file_view view;
+    ASSERT_EQ(ca_file_read(path.c_str(), &view), ca_file_result::FILE_OK);
+    EXPECT_TRUE(view.empty());
+    EXPECT_EQ(view.data(), nullptr);
+}
+
+TEST_F(CaIoFileRwSyncTest, Read_Errors) {
+    ca_file_view view;
+    EXPECT_EQ(ca_file_read((dir / "missing.c").string().c_str(), &view), ca_file_result::FILE_ERROR_NOT_FOUND);
+    EXPECT_EQ(ca_file_read(dir.string().c_str(), &view), ca_file_result::FILE_ERROR_ACCESS_DENIED);
+    EXPECT_TRUE(view.empty());
+}
+
+TEST_F(CaIoFileRwSyncTest, View_Move) {
+    const std::string content = make_content(100 * 1024);
+    const std::string path = write_file("moved.c", content);
+
+    ca_file_view view;
+    ASSERT_EQ(ca_file_read(path.c_str(), &view), ca_file_result::FILE_OK);
+    ca_file_view moved(std::move(view));
+    EXPECT_TRUE(view.empty());
+    EXPECT_EQ(as_string(moved), content);
+
+    ca_file_view assigned;
+    assigned = std::move(moved);
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(as_string(assigned), content);
+}
+
+#if !defined(_WIN32)
+TEST_F(CaIoFileRwSyncTest, Read_Pipe) {
+    const std::string path = (dir / "fifo").string();
+    ASSERT_EQ(mkfifo(path.c_str(), 0600), 0);
+
+    // Larger than the initial buffer, so the buffer has to grow
+    const std::string content = make_content(200 * 1024 + 3);
+    std::thread writer([&path, &content] {
+        std::ofstream(path, std::ios::binary) << content;
+    });
+
+    ca_file_view view;
+    const ca_file_result result = ca_file_read(path.c_str(), &view);
+    writer.join();
+    ASSERT_EQ(result, ca_file_result::FILE_OK);
+    EXPECT_FALSE(view.is_mapped());
+    EXPECT_EQ(as_string(view), content);
+}
+#endif
@@ -0,0 +1,160 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_io_core/test_ca_io_file_writer.cpp
+//
+// @file
+// @brief Tests the vectored file writer with and without background flushing.
+// ================================
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "core/ca_io_file_rw.h"
+#include "ca_test_temp_dir.h"
+
+using namespace ca;
+using namespace ca::ca_io;
+
+namespace {
+
+class CaFileWriterTest : public ca_test::ca_temp_dir_test<::testing::TestWithParam<bool>> {
+protected:
+    ca_file_writer_options options(const bool atomic = true) const {
+        ca_file_writer_options result;
+        result.async_flush = GetParam();
+        result.atomic_replace = atomic;
+        return result;
+    }
+
+    static std::string read_file(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream content;
+        content << in.rdbuf();
+        return content.str();
+    }
+
+    ca_size_t count_files() const {
+        return static_cast<ca_size_t>(std::distance(std::filesystem::directory_iterator(dir),
+                                                    std::filesystem::directory_iterator()));
+    }
+};
+
+}
+
+TEST_P(CaFileWriterTest, Write_KeepsFragmentOrderAcrossBatches) {
+    const std::string path = (dir / "out.txt").string();
+    const std::string borrowed(100000, 'b');
+
+    ca_file_writer_options small = options();
+    small.buffer_size = 4096;   // many batches, each with many segments
+    ca_file_writer writer;
+    ASSERT_EQ(writer.open(path.c_str(), small), ca_file_result::FILE_OK);
+
+    std::string expected;
+    for (int i = 0; i < 5000; ++i) {
+        const std::string line = "line " + std::to_string(i) + "\n";
+        ASSERT_EQ(writer.write(line), ca_file_result::FILE_OK);
+        expected += line;
+        if (i % 7 == 0) {
+            // Interleaved borrowed fragments break up the copied runs
+            ASSERT_EQ(writer.write_borrowed(borrowed.data() + i % 13, 3), ca_file_result::FILE_OK);
+            expected.append(borrowed.data() + i % 13, 3);
+        }
+    }
+    ASSERT_EQ(writer.write_borrowed(borrowed.data(), borrowed.size()), ca_file_result::FILE_OK);
+    expected += borrowed;
+
+    EXPECT_EQ(writer.size(), expected.size());
+    ASSERT_EQ(writer.commit(), ca_file_result::FILE_OK);
+    EXPECT_FALSE(writer.is_open());
+    EXPECT_EQ(read_file(path), expected);
+}
+
+TEST_P(CaFileWriterTest, WriteBorrowed_TakesBuffers) {
+    const std::string path = (dir / "out.txt").string();
+    ca_string::ca_char_t text[] = { 'i', 'n', 't', ';' };
+
+    ca_file_writer writer;
+    ASSERT_EQ(writer.open(path.c_str(), options()), ca_file_result::FILE_OK);
+    ASSERT_EQ(writer.write_borrowed(ca_string::ca_buffer<ca_string::ca_encoding_t::CA_ENCODING_UTF8>(text, 4)),
+              ca_file_result::FILE_OK);
+
+    // More segments than one vectored call takes
+    std::string expected = "int;";
+    const std::string digits = "0123456789";
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(writer.write_borrowed(digits.data() + i % 5 * 2, 1), ca_file_result::FILE_OK);
+        expected += digits[i % 5 * 2];
+    }
+    ASSERT_EQ(writer.commit(), ca_file_result::FILE_OK);
+    EXPECT_EQ(read_file(path), expected);
+}
+
+TEST_P(CaFileWriterTest, Commit_ReplacesTargetAtomically) {
+    const std::filesystem::path path = dir / "report.txt";
+    std::ofstream(path, std::ios::binary) << "old report";
+
+    ca_file_writer writer;
+    ASSERT_EQ(writer.open(path.string().c_str(), options()), ca_file_result::FILE_OK);
+    ASSERT_EQ(writer.write("new report"), ca_file_result::FILE_OK);
+    ASSERT_EQ(writer.flush(), ca_file_result::FILE_OK);
+
+    // Flushed data goes to the temporary file only
+    EXPECT_EQ(read_file(path), "old report");
+    EXPECT_EQ(count_files(), 2u);
+
+    ASSERT_EQ(writer.commit(), ca_file_result::FILE_OK);
+    EXPECT_EQ(read_file(path), "new report");
+    EXPECT_EQ(count_files(), 1u);
+}
+
+TEST_P(CaFileWriterTest, Discard_KeepsTarget) {
+    const std::filesystem::path path = dir / "report.txt";
+    std::ofstream(path, std::ios::binary) << "old report";
+
+    {
+        ca_file_writer writer;
+        ASSERT_EQ(writer.open(path.string().c_str(), options()), ca_file_result::FILE_OK);
+        ASSERT_EQ(writer.write("partial"), ca_file_result::FILE_OK);
+        // Destroyed without commit
+    }
+    EXPECT_EQ(read_file(path), "old report");
+    EXPECT_EQ(count_files(), 1u);
+
+    ca_file_writer writer;
+    ASSERT_EQ(writer.open(path.string().c_str(), options()), ca_file_result::FILE_OK);
+    EXPECT_EQ(writer.open(path.string().c_str(), options()), ca_file_result::FILE_ERROR_BUSY);
+    writer.discard();
+    EXPECT_FALSE(writer.is_open());
+    EXPECT_EQ(count_files(), 1u);
+}
+
+TEST_P(CaFileWriterTest, NonAtomic_WritesInPlace) {
+    const std::filesystem::path path = dir / "log.txt";
+    std::ofstream(path, std::ios::binary) << "a much longer old log";
+
+    {
+        ca_file_writer writer;
+        ASSERT_EQ(writer.open(path.string().c_str(), options(false)), ca_file_result::FILE_OK);
+        EXPECT_EQ(read_file(path), "");
+        ASSERT_EQ(writer.write("first\n"), ca_file_result::FILE_OK);
+        ASSERT_EQ(writer.flush(), ca_file_result::FILE_OK);
+        EXPECT_EQ(read_file(path), "first\n");
+        ASSERT_EQ(writer.write("second\n"), ca_file_result::FILE_OK);
+        // Destroyed without commit
+    }
+    EXPECT_EQ(read_file(path), "first\nsecond\n");
+
+    ca_file_writer writer;
+    EXPECT_EQ(writer.open((dir / "missing" / "log.txt").string().c_str(), options(false)),
+              ca_file_result::FILE_ERROR_NOT_FOUND);
+    EXPECT_EQ(writer.open((dir / "missing" / "log.txt").string().c_str(), options()),
+              ca_file_result::FILE_ERROR_NOT_FOUND);
+    EXPECT_FALSE(writer.is_open());
+}
+
+INSTANTIATE_TEST_SUITE_P(Flushing, CaFileWriterTest, ::testing::Bool(),
+                         [](const ::testing::TestParamInfo<bool> &info) {
+                             return info.param ? "Async" : "Sync";
+                         });
@@ -0,0 +1,161 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_io_core/test_ca_io_folder.cpp
+//
+// @file
+// @brief Tests the parallel directory walker.
+// ================================
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include "core/ca_io_folder.h"
+#include "ca_test_temp_dir.h"
+
+using namespace ca;
+using namespace ca::ca_io;
+
+namespace {
+
+class CaFolderWalkTest : public ca_test::ca_temp_dir_test<> {
+protected:
+    void SetUp() override {
+        ca_temp_dir_test::SetUp();
+
+        // src/<a..e>/<0..9>/f<k>.c|.h plus some noise
+        for (char a = 'a'; a <= 'e'; ++a) {
+            for (int b = 0; b < 10; ++b) {
+                for (int k = 0; k < 3; ++k) {
+                    touch("src/" + std::string(1, a) + "/" + std::to_string(b) + "/f" + std::to_string(k) +
+                          (k == 2 ? ".h" : ".c"));
+                }
+            }
+        }
+        touch("src/readme.md");
+        touch("build/gen.c");
+        touch("third_party/lib/x.c");
+        touch(".git/objects/y.c");
+        touch("src/a/0/test_skip.c");
+    }
+
+    void touch(const std::string &relative) const {
+        write_file(relative, "x");
+    }
+
+    std::set<std::string> walk(const ca_folder_walk_options &options, ca_folder_walk_stats *stats = nullptr) const {
+        std::mutex mutex;
+        std::set<std::string> found;
+        const ca_file_result result = ca_folder_walk(dir.string().c_str(), options, [&](const ca_folder_entry &entry) {
+            EXPECT_TRUE(entry.path.ends_with(entry.relative_path));
+            EXPECT_TRUE(entry.relative_path.ends_with(entry.name));
+            std::lock_guard lock(mutex);
+            EXPECT_TRUE(found.insert(std::string(entry.relative_path)).second) << entry.relative_path;
+        }, stats);
+        EXPECT_EQ(result, ca_file_result::FILE_OK);
+        return found;
+    }
+};
+
+}
+
+TEST_F(CaFolderWalkTest, Walk_FindsAllFiles) {
+    for (const ca_size_t threads : { 1, 2, 8 }) {
+        ca_folder_walk_options options;
+        options.num_threads = threads;
+        ca_folder_walk_stats stats{};
+        const std::set<std::string> found = walk(options, &stats);
+
+        // Hidden directories are skipped by default
+        EXPECT_EQ(found.size(), 150u + 4u) << threads << " threads";
+        EXPECT_EQ(stats.files, found.size());
+        EXPECT_EQ(stats.errors, 0u);
+        EXPECT_TRUE(found.contains("src/c/7/f1.c"));
+        EXPECT_FALSE(found.contains(".git/objects/y.c"));
+    }
+
+    ca_folder_walk_options hidden;
+    hidden.include_hidden = true;
+    EXPECT_TRUE(walk(hidden).contains(".git/objects/y.c"));
+}
+
+TEST_F(CaFolderWalkTest, Walk_ExtensionFilter) {
+    ca_folder_walk_options options;
+    options.extensions = { ".h" };
+    const std::set<std::string> found = walk(options);
+    EXPECT_EQ(found.size(), 50u);
+    EXPECT_TRUE(std::ranges::all_of(found, [](const std::string &path) { return path.ends_with(".h"); }));
+}
+
+TEST_F(CaFolderWalkTest, Walk_ExcludePrunesSubtrees) {
+    ca_folder_walk_options options;
+    options.extensions = { ".c" };
+    options.exclude = { "build/", "third_party", "src/b/**", "test_*.c", "src/[cd]/?/f0.c" };
+    ca_folder_walk_stats stats{};
+    const std::set<std::string> found = walk(options, &stats);
+
+    EXPECT_FALSE(found.contains("build/gen.c"));
+    EXPECT_FALSE(found.contains("third_party/lib/x.c"));
+    EXPECT_FALSE(found.contains("src/b/3/f0.c"));
+    EXPECT_FALSE(found.contains("src/a/0/test_skip.c"));
+    EXPECT_FALSE(found.contains("src/c/3/f0.c"));
+    EXPECT_TRUE(found.contains("src/c/3/f1.c"));
+    EXPECT_TRUE(found.contains("src/e/3/f0.c"));
+    // a, c, d, e with two .c files each, minus f0.c in c and d
+    EXPECT_EQ(found.size(), 4u * 10u * 2u - 2u * 10u);
+    // Excluded directories are never listed: the root, src, src/b whose children are all
+    // excluded, and 4 * 11 below the other letters
+    EXPECT_EQ(stats.directories, 3u + 4u * 11u);
+}
+
+TEST_F(CaFolderWalkTest, Walk_IgnoreRulesWithNegation) {
+    ca_folder_walk_options options;
+    options.ignore.add_lines("# like a .gitignore\n"
+                             "*.h\n"
+                             "!f2.h\n"
+                             "/src/[a-d]/\n");
+    options.exclude = { "src/e/9/f2.h" };
+    const std::set<std::string> found = walk(options);
+
+    EXPECT_FALSE(found.contains("src/a/0/f2.h"));
+    EXPECT_TRUE(found.contains("src/e/0/f2.h"));
+    EXPECT_FALSE(found.contains("src/e/9/f2.h"));
+    EXPECT_TRUE(found.contains("src/e/9/f0.c"));
+    // src/e with 3 files in 9 directories and 2 in the last, plus readme.md, gen.c and x.c
+    EXPECT_EQ(found.size(), 9u * 3u + 2u + 3u);
+}
+
+TEST_F(CaFolderWalkTest, Walk_MissingRoot) {
+    ca_folder_walk_stats stats{};
+    const ca_file_result result = ca_folder_walk((dir / "missing").string().c_str(), {},
+                                                 [](const ca_folder_entry &) { FAIL(); }, &stats);
+    EXPECT_EQ(result, ca_file_result::FILE_ERROR_NOT_FOUND);
+    EXPECT_EQ(stats.files, 0u);
+}
+
+#if !defined(_WIN32)
+TEST_F(CaFolderWalkTest, Walk_SymlinkLoops) {
+    std::filesystem::create_directory_symlink(dir / "src", dir / "src/a/loop");
+    const std::filesystem::path outside = dir.string() + "_outside";
+    std::filesystem::create_directories(outside);
+    std::ofstream(outside / "o.c") << "x";
+    std::filesystem::create_directory_symlink(outside, dir / "src/e/linked");
+    std::filesystem::create_directory_symlink(outside, dir / "src/d/linked_again");
+    std::filesystem::create_symlink(dir / "src/readme.md", dir / "src/readme_link.md");
+
+    ca_folder_walk_options options;
+    const std::set<std::string> plain = walk(options);
+    EXPECT_FALSE(plain.contains("src/e/linked/o.c"));
+    EXPECT_TRUE(plain.contains("src/readme_link.md"));
+
+    options.follow_symlinks = true;
+    const std::set<std::string> followed = walk(options);
+    EXPECT_NE(followed.contains("src/e/linked/o.c"), followed.contains("src/d/linked_again/o.c"));
+    EXPECT_FALSE(followed.contains("src/a/loop/readme.md"));
+    // Both links lead to the same target, which is walked once
+    EXPECT_EQ(followed.size(), plain.size() + 1);
+    std::filesystem::remove_all(outside);
+}
+#endif
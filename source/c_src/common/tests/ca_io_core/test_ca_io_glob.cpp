@@ -0,0 +1,208 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_io_core/test_ca_io_glob.cpp
+//
+// @file
+// @brief Tests the compiled `.gitignore` matcher.
+// ================================
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/ca_io_glob.h"
+
+using namespace ca;
+using namespace ca::ca_io;
+
+namespace {
+
+/**
+ * @brief Straightforward backtracking glob matcher to check against.
+ *
+ * @param p Position in the pattern; `**` is only special at component starts.
+ */
+bool
+reference_match(const std::string_view pattern, const ca_size_t p, const std::string_view text) {
+    const std::string_view rest = pattern.substr(p);
+    const bool component_start = p == 0 || pattern[p - 1] == '/';
+    if (component_start && rest.starts_with("**/")) {
+        for (ca_size_t i = 0; i <= text.size(); ++i) {
+            if ((i == 0 || text[i - 1] == '/') && reference_match(pattern, p + 3, text.substr(i))) {
+                return true;
+            }
+        }
+        return false;
+    }
+    if (component_start && rest == "**") {
+        return true;
+    }
+    if (rest.empty()) {
+        return text.empty();
+    }
+    if (rest[0] == '*') {
+        for (ca_size_t i = 0; i <= text.size(); ++i) {
+            if (reference_match(pattern, p + 1, text.substr(i))) {
+                return true;
+            }
+            if (i < text.size() && text[i] == '/') {
+                return false;
+            }
+        }
+        return false;
+    }
+    if (text.empty()) {
+        return false;
+    }
+    if (rest[0] == '?') {
+        return text[0] != '/' && reference_match(pattern, p + 1, text.substr(1));
+    }
+    return rest[0] == text[0] && reference_match(pattern, p + 1, text.substr(1));
+}
+
+struct reference_rule {
+    std::string pattern;
+    bool anchored;
+    bool negated;
+};
+
+ca_glob_result
+reference_verdict(const std::vector<reference_rule> &rules, const std::string &path) {
+    const std::string name = path.substr(path.rfind('/') + 1);
+    for (auto it = rules.rbegin(); it != rules.rend(); ++it) {
+        if (reference_match(it->pattern, 0, it->anchored ? path : name)) {
+            return it->negated ? ca_glob_result::GLOB_INCLUDED : ca_glob_result::GLOB_EXCLUDED;
+        }
+    }
+    return ca_glob_result::GLOB_NONE;
+}
+
+}
+
+TEST(CaGlobSetTest, Match_Names) {
+    ca_glob_set set;
+    EXPECT_TRUE(set.add(".git"));
+    EXPECT_TRUE(set.add("*.o"));
+    EXPECT_TRUE(set.add("*.tar.gz"));
+    EXPECT_TRUE(set.add("test_*.c"));
+    EXPECT_TRUE(set.add("lib?.a"));
+    EXPECT_TRUE(set.add("*.py[co]"));
+    EXPECT_EQ(set.size(), 6u);
+
+    EXPECT_TRUE(set.excluded(".git", true));
+    EXPECT_TRUE(set.excluded("sub/dir/.git", true));
+    EXPECT_TRUE(set.excluded("a.o", false));
+    EXPECT_TRUE(set.excluded("x/y/.o", false));
+    EXPECT_TRUE(set.excluded("dist/pkg-1.0.tar.gz", false));
+    EXPECT_TRUE(set.excluded("src/test_lexer.c", false));
+    EXPECT_TRUE(set.excluded("libm.a", false));
+    EXPECT_TRUE(set.excluded("tools/x.pyc", false));
+
+    EXPECT_FALSE(set.excluded("a.c", false));
+    EXPECT_FALSE(set.excluded("a.o.c", false));
+    EXPECT_FALSE(set.excluded("pkg.gz", false));
+    EXPECT_FALSE(set.excluded("test_lexer.h", false));
+    EXPECT_FALSE(set.excluded("libmm.a", false));
+    EXPECT_FALSE(set.excluded("x.py", false));
+    EXPECT_EQ(set.match("git", true), ca_glob_result::GLOB_NONE);
+}
+
+TEST(CaGlobSetTest, Match_AnchoredPaths) {
+    ca_glob_set set;
+    set.add("/build");
+    set.add("third_party/**");
+    set.add("src/gen/");
+    set.add("docs/**/*.png");
+    set.add("*/tmp");
+
+    EXPECT_TRUE(set.excluded("build", true));
+    EXPECT_FALSE(set.excluded("src/build", true));
+    EXPECT_TRUE(set.excluded("third_party/zlib", true));
+    EXPECT_TRUE(set.excluded("third_party/zlib/zlib.h", false));
+    EXPECT_FALSE(set.excluded("third_party", true));
+    EXPECT_TRUE(set.excluded("src/gen", true));
+    EXPECT_FALSE(set.excluded("src/gen", false));
+    EXPECT_TRUE(set.excluded("docs/a.png", false));
+    EXPECT_TRUE(set.excluded("docs/a/b/c.png", false));
+    EXPECT_FALSE(set.excluded("docs/a/b/c.svg", false));
+    EXPECT_TRUE(set.excluded("x/tmp", true));
+    EXPECT_FALSE(set.excluded("tmp", true));
+    EXPECT_FALSE(set.excluded("x/y/tmp", true));
+}
+
+TEST(CaGlobSetTest, Match_LastRuleWins) {
+    ca_glob_set set;
+    set.add_lines("# generated files\n"
+                  "*.c\n"
+                  "\n"
+                  "!keep.c\n"
+                  "!src/*.c\n"
+                  "src/bad.c\n"
+                  "\\#literal\n"
+                  "trailing   \n"
+                  "\\!bang\r\n");
+    EXPECT_EQ(set.size(), 7u);
+
+    EXPECT_EQ(set.match("a.c", false), ca_glob_result::GLOB_EXCLUDED);
+    EXPECT_EQ(set.match("lib/keep.c", false), ca_glob_result::GLOB_INCLUDED);
+    EXPECT_EQ(set.match("src/ok.c", false), ca_glob_result::GLOB_INCLUDED);
+    EXPECT_EQ(set.match("src/bad.c", false), ca_glob_result::GLOB_EXCLUDED);
+    EXPECT_EQ(set.match("lib/#literal", false), ca_glob_result::GLOB_EXCLUDED);
+    EXPECT_EQ(set.match("trailing", false), ca_glob_result::GLOB_EXCLUDED);
+    EXPECT_EQ(set.match("!bang", false), ca_glob_result::GLOB_EXCLUDED);
+    EXPECT_EQ(set.match("a.h", false), ca_glob_result::GLOB_NONE);
+
+    // Copies keep the rules and their order
+    const ca_glob_set copy = set;
+    EXPECT_EQ(copy.size(), set.size());
+    EXPECT_EQ(copy.match("src/ok.c", false), ca_glob_result::GLOB_INCLUDED);
+}
+
+TEST(CaGlobSetTest, Match_AgreesWithReference) {
+    // Random rules and paths over a small alphabet, so that many match
+    const std::vector<std::string> atoms = { "a", "b", "ab", ".c", "x", "y", "*", "?" };
+    const std::vector<char> letters = { 'a', 'b', '.', 'c', 'x', 'y' };
+    std::mt19937 random(7);
+    const auto component = [&] {
+        std::string text;
+        const int n = 1 + static_cast<int>(random() % 3);
+        for (int i = 0; i < n; ++i) {
+            text += atoms[random() % atoms.size()];
+        }
+        return text;
+    };
+
+    for (int round = 0; round < 20; ++round) {
+        ca_glob_set set;
+        std::vector<reference_rule> rules;
+        for (int r = 0; r < 40; ++r) {
+            reference_rule rule;
+            const int components = 1 + static_cast<int>(random() % 3);
+            for (int i = 0; i < components; ++i) {
+                if (i != 0) {
+                    rule.pattern += '/';
+                }
+                rule.pattern += components > 1 && random() % 4 == 0 ? std::string("**") : component();
+            }
+            rule.anchored = components > 1;
+            rule.negated = random() % 3 == 0;
+            set.add((rule.negated ? "!" : "") + rule.pattern);
+            rules.push_back(rule);
+        }
+        ASSERT_EQ(set.size(), rules.size());
+
+        for (int p = 0; p < 500; ++p) {
+            std::string path;
+            const int components = 1 + static_cast<int>(random() % 4);
+            for (int i = 0; i < components; ++i) {
+                if (i != 0) {
+                    path += '/';
+                }
+                const int n = 1 + static_cast<int>(random() % 4);
+                for (int k = 0; k < n; ++k) {
+                    path += letters[random() % letters.size()];
+                }
+            }
+            ASSERT_EQ(set.match(path, false), reference_verdict(rules, path)) << path;
+        }
+    }
+}
@@ -0,0 +1,186 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_io_core/test_ca_io_path.cpp
+//
+// @file
+// @brief Tests `ca_io_path` and the interned path table.
+// ================================
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/ca_io_path.h"
+
+using namespace ca;
+using namespace ca::ca_io;
+
+namespace {
+
+std::string
+normalized(const char *path) {
+    ca_io_path result(path);
+    result.normalize();
+    return std::string(result.view());
+}
+
+}
+
+TEST(CaIoPathTest, Components) {
+    const ca_io_path path("src/include/ca_io.tar.gz");
+    EXPECT_EQ(path.name(), "ca_io.tar.gz");
+    EXPECT_EQ(path.stem(), "ca_io.tar");
+    EXPECT_EQ(path.suffix(), ".gz");
+    EXPECT_EQ(path.parent(), "src/include");
+    EXPECT_FALSE(path.is_absolute());
+
+    EXPECT_EQ(ca_io_path(".gitignore").suffix(), "");
+    EXPECT_EQ(ca_io_path(".gitignore").stem(), ".gitignore");
+    EXPECT_EQ(ca_io_path("..").suffix(), "");
+    EXPECT_EQ(ca_io_path("a/b/").name(), "b");
+    EXPECT_EQ(ca_io_path("a/b/").parent(), "a");
+    EXPECT_EQ(ca_io_path("a").parent(), "");
+
+#ifndef _WIN32
+    EXPECT_TRUE(ca_io_path("/usr/include").is_absolute());
+    EXPECT_EQ(ca_io_path("/usr").parent(), "/");
+    EXPECT_EQ(ca_io_path("/").parent(), "/");
+    EXPECT_EQ(ca_io_path("/").name(), "");
+#else
+    EXPECT_TRUE(ca_io_path("C:\\include").is_absolute());
+    EXPECT_TRUE(ca_io_path("\\\\server\\share\\x").is_absolute());
+    EXPECT_FALSE(ca_io_path("C:include").is_absolute());
+    EXPECT_EQ(ca_io_path("C:\\include\\a.h").parent(), "C:\\include");
+    EXPECT_EQ(ca_io_path("C:\\").parent(), "C:\\");
+#endif
+}
+
+TEST(CaIoPathTest, Normalize) {
+#ifndef _WIN32
+    EXPECT_EQ(normalized("a//b/./c/../d/"), "a/b/d");
+    EXPECT_EQ(normalized("../../a/.."), "../..");
+    EXPECT_EQ(normalized("a/../.."), "..");
+    EXPECT_EQ(normalized("/../x/./y/.."), "/x");
+    EXPECT_EQ(normalized("//usr///lib"), "/usr/lib");
+    EXPECT_EQ(normalized("a/.."), ".");
+    EXPECT_EQ(normalized(""), ".");
+    EXPECT_EQ(normalized("/"), "/");
+    EXPECT_EQ(normalized("./include/../src/main.c"), "src/main.c");
+#else
+    EXPECT_EQ(normalized("a/b\\.\\c\\..\\d"), "a\\b\\d");
+    EXPECT_EQ(normalized("C:/../x/y/.."), "C:\\x");
+    EXPECT_EQ(normalized("C:..\\x"), "C:..\\x");
+    EXPECT_EQ(normalized("\\\\server\\share\\..\\a"), "\\\\server\\share\\a");
+#endif
+}
+
+TEST(CaIoPathTest, AppendAndJoin) {
+    ca_io_path path("include");
+    path.append("ca_io").append("core/");
+    path.append("ca_io_path.h");
+    const char separator = ca_io_path::PREFERRED_SEPARATOR;
+    EXPECT_EQ(path.view(), std::string("include") + separator + "ca_io" + separator + "core/ca_io_path.h");
+
+    const ca_io_path joined = ca_io_path("a").join("b");
+    EXPECT_EQ(joined.view(), std::string("a") + separator + "b");
+
+#ifndef _WIN32
+    EXPECT_EQ(ca_io_path("a/b").join("/usr").view(), "/usr");
+#endif
+
+    // Appending a view of the path itself
+    ca_io_path self("x/y");
+    self.append(self.view());
+    EXPECT_EQ(self.view(), std::string("x/y") + separator + "x/y");
+}
+
+TEST(CaIoPathTest, SmallBufferStorage) {
+    ca_io_path small("src/main.c");
+    EXPECT_TRUE(small.is_inline());
+
+    const std::string long_path(3 * ca_io_path::INLINE_CAPACITY, 'a');
+    ca_io_path large(long_path);
+    EXPECT_FALSE(large.is_inline());
+    EXPECT_EQ(large.view(), long_path);
+    EXPECT_EQ(large.c_str()[large.size()], '\0');
+
+    // Growing past the inline storage, then copies and moves of both kinds
+    for (int i = 0; i < 40; ++i) {
+        small.append("component");
+    }
+    EXPECT_FALSE(small.is_inline());
+    const ca_io_path copy = small;
+    EXPECT_EQ(copy, small);
+
+    ca_io_path moved = std::move(small);
+    EXPECT_EQ(moved, copy);
+    EXPECT_TRUE(small.empty());
+
+    ca_io_path inline_moved = ca_io_path("a/b");
+    inline_moved = ca_io_path("c/d");
+    EXPECT_TRUE(inline_moved.is_inline());
+    EXPECT_EQ(inline_moved.view(), "c/d");
+
+    // Shrinking assignment keeps the heap buffer and stays correct
+    moved.assign(moved.name());
+    EXPECT_EQ(moved.view(), "component");
+}
+
+TEST(CaIoPathTest, Conversions) {
+    ca_io_path path("a\\b/c");
+    EXPECT_EQ(path.make_posix().view(), "a/b/c");
+    EXPECT_EQ(path.make_windows().view(), "a\\b\\c");
+
+    EXPECT_FALSE(ca_io_path("").is_valid());
+    EXPECT_FALSE(ca_io_path(std::string_view("a\0b", 3)).is_valid());
+    EXPECT_TRUE(ca_io_path("src/main.c").is_valid());
+
+    ca_io_path relative("a/../b");
+    ASSERT_EQ(relative.make_absolute(), 0);
+    EXPECT_TRUE(relative.is_absolute());
+    EXPECT_EQ(relative.name(), "b");
+
+    ca_io_path current;
+    ASSERT_EQ(ca_io_path::current_directory(&current), 0);
+    EXPECT_TRUE(current.exists());
+    EXPECT_FALSE(current.join("ca_io_path_missing_entry").exists());
+}
+
+TEST(CaPathTableTest, InternNormalizedPaths) {
+    ca_path_table table;
+    const ca_path_id id = table.intern("src/./include/../main.c");
+    EXPECT_EQ(table.intern("src//main.c"), id);
+    EXPECT_EQ(table.find("src/main.c/"), id);
+    EXPECT_EQ(table.find("src/other.c"), ca_path_table::INVALID_ID);
+    EXPECT_EQ(table.intern("src/other.c"), id + 1);
+
+    const std::string_view view = table.view(id);
+    EXPECT_EQ(ca_io_path(view).name(), "main.c");
+    EXPECT_EQ(view.data()[view.size()], '\0');
+    EXPECT_EQ(table.size(), 2u);
+}
+
+TEST(CaPathTableTest, ConcurrentIntern) {
+    ca_path_table table;
+    constexpr int THREADS = 8;
+    constexpr int PATHS = 500;
+    std::vector<std::vector<ca_path_id>> ids(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&table, &ids, t] {
+            for (int i = 0; i < PATHS; ++i) {
+                ids[t].push_back(table.intern("dir/" + std::to_string(i) + "/./file.h"));
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(table.size(), static_cast<ca_size_t>(PATHS));
+    for (int t = 1; t < THREADS; ++t) {
+        EXPECT_EQ(ids[t], ids[0]);
+    }
+    for (int i = 0; i < PATHS; ++i) {
+        EXPECT_LT(ids[0][i], static_cast<ca_path_id>(PATHS));
+    }
+}
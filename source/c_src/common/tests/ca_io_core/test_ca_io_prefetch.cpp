@@ -0,0 +1,121 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_io_core/test_ca_io_prefetch.cpp
+//
+// @file
+// @brief Tests the schedule-ordered prefetcher.
+// ================================
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/ca_io_prefetch.h"
+#include "ca_test_temp_dir.h"
+
+using namespace ca;
+using namespace ca::ca_io;
+
+namespace {
+
+class CaPrefetcherTest : public ca_test::ca_temp_dir_test<> {
+protected:
+    void SetUp() override {
+        ca_temp_dir_test::SetUp();
+        for (int i = 0; i < 40; ++i) {
+            paths.push_back(write_file("tu" + std::to_string(i) + ".c",
+                                       std::string(1000, static_cast<char>('a' + i % 26))));
+        }
+    }
+
+    /**
+     * Polls until a condition holds or a second has passed.
+     */
+    static bool eventually(const std::function<bool()> &condition) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    std::vector<std::string> paths;
+};
+
+}
+
+TEST_F(CaPrefetcherTest, Acquire_HintsAheadWithinDistance) {
+    ca_prefetch_options options;
+    options.distance = 8;
+    ca_prefetcher prefetcher(options);
+    EXPECT_EQ(prefetcher.schedule(paths), 0u);
+    EXPECT_EQ(prefetcher.size(), paths.size());
+
+    ASSERT_TRUE(eventually([&] { return prefetcher.stats().hinted == 8; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(prefetcher.stats().hinted, 8u);
+    EXPECT_EQ(prefetcher.stats().hinted_bytes, 8u * 1000u);
+
+    for (ca_size_t i = 0; i < paths.size(); ++i) {
+        // Give the hints time to stay ahead
+        ASSERT_TRUE(eventually([&] { return prefetcher.stats().hinted >= ca_math::ca_min(i + 1, paths.size()); }));
+        ca_file_view view;
+        ASSERT_EQ(prefetcher.acquire(i, &view), ca_file_result::FILE_OK);
+        ASSERT_EQ(view.size(), 1000u);
+        EXPECT_EQ(view.data()[0], 'a' + i % 26);
+    }
+
+    const ca_prefetch_stats stats = prefetcher.stats();
+    EXPECT_EQ(stats.acquired, paths.size());
+    EXPECT_EQ(stats.hinted, paths.size());
+    EXPECT_EQ(stats.stalls, 0u);
+}
+
+TEST_F(CaPrefetcherTest, Acquire_BudgetLimitsHints) {
+    ca_prefetch_options options;
+    options.distance = 100;
+    options.memory_budget = 2500;
+    ca_prefetcher prefetcher(options);
+    prefetcher.schedule(paths);
+
+    // Hinting stops once 2500 bytes are outstanding, overshooting by one file
+    ASSERT_TRUE(eventually([&] { return prefetcher.stats().hinted == 3; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(prefetcher.stats().hinted, 3u);
+
+    ca_file_view view;
+    ASSERT_EQ(prefetcher.acquire(0, &view), ca_file_result::FILE_OK);
+    EXPECT_TRUE(eventually([&] { return prefetcher.stats().hinted == 4; }));
+}
+
+TEST_F(CaPrefetcherTest, Acquire_CountsStalls) {
+    ca_prefetch_options options;
+    options.distance = 0;
+    ca_prefetcher prefetcher(options);
+    const ca_size_t first = prefetcher.schedule(std::span(paths).first(5));
+    EXPECT_EQ(prefetcher.schedule(std::span(paths).subspan(5, 5)), first + 5);
+
+    for (ca_size_t i = 0; i < 10; ++i) {
+        ca_file_view view;
+        ASSERT_EQ(prefetcher.acquire(i, &view), ca_file_result::FILE_OK);
+    }
+    const ca_prefetch_stats stats = prefetcher.stats();
+    EXPECT_EQ(stats.stalls, 10u);
+    EXPECT_EQ(stats.hinted, 0u);
+    EXPECT_EQ(prefetcher.path(3), paths[3]);
+}
+
+TEST_F(CaPrefetcherTest, Acquire_MissingFile) {
+    ca_prefetcher prefetcher;
+    const std::vector<std::string> missing = { (dir / "missing.c").string() };
+    prefetcher.schedule(missing);
+
+    ca_file_view view;
+    EXPECT_EQ(prefetcher.acquire(0, &view), ca_file_result::FILE_ERROR_NOT_FOUND);
+    EXPECT_TRUE(view.empty());
+}
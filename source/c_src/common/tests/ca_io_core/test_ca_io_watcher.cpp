@@ -0,0 +1,174 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_io_core/test_ca_io_watcher.cpp
+//
+// @file
+// @brief Tests the debounced file watcher.
+// ================================
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "core/ca_io_watcher.h"
+#include "ca_test_temp_dir.h"
+
+using namespace ca;
+using namespace ca::ca_io;
+
+#ifdef __linux__
+
+namespace {
+
+class CaFileWatcherTest : public ca_test::ca_temp_dir_test<> {
+protected:
+    void SetUp() override {
+        ca_temp_dir_test::SetUp();
+        write_file("src/lib/a.c", "int a;\n");
+        options.debounce_ms = 30;
+        options.table = &table;
+    }
+
+    void TearDown() override {
+        watcher.stop();
+        ca_temp_dir_test::TearDown();
+    }
+
+    ca_file_result start() {
+        return watcher.start(dir.string().c_str(), options, [this](const ca_watch_batch &batch) {
+            std::lock_guard lock(mutex);
+            batches.push_back(batch);
+            arrived.notify_all();
+        });
+    }
+
+    /**
+     * Waits for the next batch, or returns an empty one after two seconds.
+     */
+    ca_watch_batch next_batch() {
+        std::unique_lock lock(mutex);
+        arrived.wait_for(lock, std::chrono::seconds(2), [this] { return !batches.empty(); });
+        if (batches.empty()) {
+            return {};
+        }
+        ca_watch_batch batch = std::move(batches.front());
+        batches.erase(batches.begin());
+        return batch;
+    }
+
+    std::string path_of(const std::string &relative) const {
+        return dir.string() + "/" + relative;
+    }
+
+    ca_path_table table;
+    ca_watch_options options;
+    ca_file_watcher watcher;
+
+    std::mutex mutex;
+    std::condition_variable arrived;
+    std::vector<ca_watch_batch> batches;
+};
+
+}
+
+TEST_F(CaFileWatcherTest, Start_Errors) {
+    EXPECT_EQ(watcher.start((dir / "missing").string().c_str(), options, [](const ca_watch_batch &) {}),
+              ca_file_result::FILE_ERROR_NOT_FOUND);
+    EXPECT_FALSE(watcher.is_running());
+    ASSERT_EQ(start(), ca_file_result::FILE_OK);
+    EXPECT_TRUE(watcher.is_running());
+    EXPECT_EQ(start(), ca_file_result::FILE_ERROR_BUSY);
+    watcher.stop();
+    EXPECT_FALSE(watcher.is_running());
+}
+
+TEST_F(CaFileWatcherTest, Batch_CoalescesBurst) {
+    ASSERT_EQ(start(), ca_file_result::FILE_OK);
+
+    for (int round = 0; round < 3; ++round) {
+        write_file("src/lib/a.c", "int a = " + std::to_string(round) + ";\n");
+        write_file("src/b.c", "int b;\n");
+    }
+    const ca_watch_batch batch = next_batch();
+    ASSERT_EQ(batch.paths.size(), 2u);
+    EXPECT_EQ(batch.paths[0], path_of("src/b.c"));
+    EXPECT_EQ(batch.paths[1], path_of("src/lib/a.c"));
+    EXPECT_FALSE(batch.rescan);
+    ASSERT_EQ(batch.ids.size(), 2u);
+    EXPECT_EQ(table.view(batch.ids[1]), path_of("src/lib/a.c"));
+}
+
+TEST_F(CaFileWatcherTest, Batch_AtomicSaveAndDelete) {
+    ASSERT_EQ(start(), ca_file_result::FILE_OK);
+
+    // Editors write a hidden temporary file and rename it over the original
+    write_file("src/lib/.a.c.tmp", "int a = 1;\n");
+    std::filesystem::rename(dir / "src/lib/.a.c.tmp", dir / "src/lib/a.c");
+    ca_watch_batch batch = next_batch();
+    ASSERT_EQ(batch.paths.size(), 1u);
+    EXPECT_EQ(batch.paths[0], path_of("src/lib/a.c"));
+
+    std::filesystem::remove(dir / "src/lib/a.c");
+    batch = next_batch();
+    ASSERT_EQ(batch.paths.size(), 1u);
+    EXPECT_EQ(batch.paths[0], path_of("src/lib/a.c"));
+}
+
+TEST_F(CaFileWatcherTest, Batch_NewDirectoriesAreWatched) {
+    options.extensions = { ".h" };
+    ASSERT_EQ(start(), ca_file_result::FILE_OK);
+
+    std::filesystem::create_directories(dir / "include/deep");
+    write_file("include/deep/x.h", "#pragma once\n");
+    write_file("include/deep/x.txt", "notes\n");
+    ca_watch_batch batch = next_batch();
+    ASSERT_EQ(batch.paths.size(), 1u);
+    EXPECT_EQ(batch.paths[0], path_of("include/deep/x.h"));
+
+    // Directories moved in report their files
+    const std::filesystem::path outside = dir.string() + "_outside";
+    std::filesystem::create_directories(outside / "sub");
+    std::ofstream(outside / "sub/y.h") << "int y;\n";
+    std::filesystem::rename(outside, dir / "moved");
+    batch = next_batch();
+    ASSERT_EQ(batch.paths.size(), 1u);
+    EXPECT_EQ(batch.paths[0], path_of("moved/sub/y.h"));
+
+    // ... and watch them
+    write_file("moved/sub/y.h", "int y = 1;\n");
+    batch = next_batch();
+    ASSERT_EQ(batch.paths.size(), 1u);
+    EXPECT_EQ(batch.paths[0], path_of("moved/sub/y.h"));
+
+    // Moving a directory away asks for a rescan
+    std::filesystem::rename(dir / "moved", outside);
+    batch = next_batch();
+    EXPECT_TRUE(batch.rescan);
+    std::filesystem::remove_all(outside);
+}
+
+TEST_F(CaFileWatcherTest, Batch_MovedAwayDirectoriesAreUnwatched) {
+    std::filesystem::create_directories(dir / "gone/sub");
+    ASSERT_EQ(start(), ca_file_result::FILE_OK);
+
+    const std::filesystem::path outside = dir.string() + "_outside";
+    std::filesystem::remove_all(outside);
+    std::filesystem::rename(dir / "gone", outside);
+    ca_watch_batch batch = next_batch();
+    EXPECT_TRUE(batch.rescan);
+
+    // Changes in the moved directory are no longer reported, under any path
+    std::ofstream(outside / "sub/z.c") << "int z;\n";
+    std::ofstream(outside / "w.c") << "int w;\n";
+    write_file("src/b.c", "int b;\n");
+    batch = next_batch();
+    ASSERT_EQ(batch.paths.size(), 1u);
+    EXPECT_EQ(batch.paths[0], path_of("src/b.c"));
+    EXPECT_FALSE(batch.rescan);
+    std::filesystem::remove_all(outside);
+}
+
+#endif
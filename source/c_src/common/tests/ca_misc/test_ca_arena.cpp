@@ -0,0 +1,113 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_misc/test_ca_arena.cpp
+//
+// @file
+// @brief Tests the arena and its `std::pmr` adapter.
+// ================================
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "ca_memory.h"
+
+using namespace ca;
+using namespace ca::ca_misc;
+
+namespace {
+
+struct point {
+    int x;
+    int y;
+};
+
+}
+
+TEST(CaArenaTest, Allocate_AlignsAndKeepsData) {
+    ca_arena arena(256);
+    EXPECT_EQ(arena.capacity(), 0u);
+
+    std::vector<std::pair<unsigned char *, ca_size_t>> blocks;
+    for (ca_size_t i = 0; i < 200; ++i) {
+        const ca_size_t alignment = ca_size_t{ 1 } << (i % 7);
+        auto *block = static_cast<unsigned char *>(arena.allocate(i + 1, alignment));
+        ASSERT_NE(block, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % alignment, 0u);
+        std::memset(block, static_cast<int>(i), i + 1);
+        blocks.emplace_back(block, i + 1);
+    }
+    for (ca_size_t i = 0; i < blocks.size(); ++i) {
+        for (ca_size_t j = 0; j < blocks[i].second; ++j) {
+            ASSERT_EQ(blocks[i].first[j], static_cast<unsigned char>(i));
+        }
+    }
+    EXPECT_NE(arena.allocate(0), nullptr);
+
+    const point *p = arena.create<point>(point{ 3, 4 });
+    EXPECT_EQ(p->x + p->y, 7);
+    const ca_memory_stats &stats = arena.stats();
+    EXPECT_EQ(stats.allocations, 202u);
+    EXPECT_EQ(stats.requested, 200u * 201u / 2 + sizeof(point));
+    EXPECT_GE(stats.reserved, stats.requested);
+    EXPECT_EQ(stats.reserved, arena.capacity());
+}
+
+#ifdef CA_ENABLE_OPTIMIZER
+TEST(CaArenaTest, Reset_KeepsLargestChunk) {
+    ca_arena arena;
+    void *first = arena.allocate(16);
+    EXPECT_EQ(arena.capacity(), ca_arena::MIN_CHUNK_SIZE);
+
+    // Filling the chunk chains one twice as large
+    void *large = arena.allocate(ca_arena::MIN_CHUNK_SIZE);
+    EXPECT_NE(large, first);
+    EXPECT_EQ(arena.capacity(), 3 * ca_arena::MIN_CHUNK_SIZE);
+    EXPECT_EQ(arena.stats().chunks, 2u);
+
+    arena.reset();
+    EXPECT_EQ(arena.capacity(), 2 * ca_arena::MIN_CHUNK_SIZE);
+    EXPECT_EQ(arena.allocate(16), large);
+    EXPECT_EQ(arena.stats().peak_reserved, 3 * ca_arena::MIN_CHUNK_SIZE);
+    EXPECT_EQ(arena.stats().resets, 1u);
+
+    // A request larger than any chunk gets one of its size
+    arena.allocate(10 * ca_arena::MAX_CHUNK_SIZE / 8, 64);
+    EXPECT_GE(arena.capacity(), 10 * ca_arena::MAX_CHUNK_SIZE / 8);
+
+    arena.release();
+    EXPECT_EQ(arena.capacity(), 0u);
+    EXPECT_EQ(arena.stats().resets, 2u);
+}
+#else
+TEST(CaArenaTest, Reset_FreesEveryAllocation) {
+    ca_arena arena;
+    arena.allocate(16);
+    arena.allocate(16);
+    EXPECT_EQ(arena.stats().chunks, 2u);
+    arena.reset();
+    EXPECT_EQ(arena.capacity(), 0u);
+}
+#endif
+
+TEST(CaArenaTest, Resource_BacksPmrContainers) {
+    ca_arena arena;
+    ca_arena_resource resource(arena);
+    {
+        std::pmr::vector<std::pmr::string> names(&resource);
+        for (int i = 0; i < 1000; ++i) {
+            names.emplace_back("a name long enough to need memory " + std::to_string(i));
+        }
+        EXPECT_EQ(names[999], "a name long enough to need memory 999");
+        EXPECT_EQ(names.get_allocator().resource(), &resource);
+    }
+    EXPECT_GT(arena.stats().allocations, 1000u);
+
+    ca_arena_resource same(arena);
+    ca_arena other_arena;
+    ca_arena_resource other(other_arena);
+    EXPECT_TRUE(resource.is_equal(same));
+    EXPECT_FALSE(resource.is_equal(other));
+    EXPECT_EQ(&resource.arena(), &arena);
+}
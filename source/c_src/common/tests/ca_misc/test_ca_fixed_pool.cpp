@@ -0,0 +1,158 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_misc/test_ca_fixed_pool.cpp
+//
+// @file
+// @brief Tests the fixed-size and object pools.
+// ================================
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ca_memory.h"
+
+using namespace ca;
+using namespace ca::ca_misc;
+
+TEST(CaFixedPoolTest, Allocate_ReusesFreedBlocks) {
+    ca_fixed_pool pool(24, 32, 8);
+    EXPECT_EQ(pool.block_size(), 32u);
+
+    // A whole number of slabs, so no block is left unused in the last one
+    std::set<void *> blocks;
+    for (int i = 0; i < 96; ++i) {
+        void *block = pool.allocate();
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % 32, 0u);
+        EXPECT_TRUE(blocks.insert(block).second);
+    }
+    for (void *block : blocks) {
+        pool.deallocate(block);
+    }
+    pool.deallocate(nullptr);
+    const ca_memory_stats before = pool.stats();
+
+    // Freed blocks come back before any new slab
+    std::set<void *> again;
+    for (int i = 0; i < 96; ++i) {
+        again.insert(pool.allocate());
+    }
+    EXPECT_EQ(again.size(), 96u);
+#ifdef CA_ENABLE_OPTIMIZER
+    EXPECT_EQ(again, blocks);
+    EXPECT_EQ(pool.stats().chunks, before.chunks);
+    EXPECT_EQ(pool.stats().reserved, 12u * 8 * 32);
+#endif
+    for (void *block : again) {
+        pool.deallocate(block);
+    }
+    (void)before;
+}
+
+TEST(CaFixedPoolTest, Threads_AllocateAndFreeAcross) {
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 20000;
+    ca_fixed_pool pool(sizeof(std::uint64_t));
+    std::vector<std::vector<std::uint64_t *>> made(THREADS);
+
+    // Each thread allocates, and frees the blocks of the previous thread
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                auto *value = static_cast<std::uint64_t *>(pool.allocate());
+                *value = static_cast<std::uint64_t>(t) << 32 | static_cast<std::uint64_t>(i);
+                made[t].push_back(value);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    std::set<std::uint64_t *> distinct;
+    for (int t = 0; t < THREADS; ++t) {
+        for (int i = 0; i < PER_THREAD; ++i) {
+            ASSERT_EQ(*made[t][i], static_cast<std::uint64_t>(t) << 32 | static_cast<std::uint64_t>(i));
+            distinct.insert(made[t][i]);
+        }
+    }
+    EXPECT_EQ(distinct.size(), static_cast<ca_size_t>(THREADS * PER_THREAD));
+
+    threads.clear();
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::uint64_t *value : made[(t + 1) % THREADS]) {
+                pool.deallocate(value);
+            }
+            for (int i = 0; i < PER_THREAD; ++i) {
+                pool.deallocate(pool.allocate());
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    // Each thread may hold back less than a batch of its count
+    EXPECT_GT(pool.stats().allocations + THREADS * ca_fixed_pool::BATCH_SIZE,
+              static_cast<ca_uint64_t>(2 * THREADS * PER_THREAD));
+}
+
+#ifdef CA_ENABLE_OPTIMIZER
+TEST(CaFixedPoolTest, Threads_DropListsOfDestroyedPools) {
+    std::mutex mutex;
+    std::condition_variable changed;
+    ca_fixed_pool *current = nullptr;
+    bool done = false;
+    ca_size_t max_lists = 0;
+
+    // A long-lived worker uses each pool once before it is destroyed, as
+    // with pools made per unit of work
+    std::thread worker([&] {
+        std::unique_lock guard(mutex);
+        for (;;) {
+            changed.wait(guard, [&] { return current != nullptr || done; });
+            if (done) {
+                break;
+            }
+            current->deallocate(current->allocate());
+            max_lists = std::max(max_lists, ca_fixed_pool::thread_list_count());
+            current = nullptr;
+            changed.notify_all();
+        }
+    });
+    for (int i = 0; i < 50; ++i) {
+        ca_fixed_pool pool(16);
+        std::unique_lock guard(mutex);
+        current = &pool;
+        changed.notify_all();
+        changed.wait(guard, [&] { return current == nullptr; });
+    }
+    {
+        std::lock_guard guard(mutex);
+        done = true;
+    }
+    changed.notify_all();
+    worker.join();
+
+    // Only the list of the pool in use is left
+    EXPECT_EQ(max_lists, 1u);
+}
+#endif
+
+TEST(CaFixedPoolTest, ObjectPool_ConstructsAndDestroys) {
+    ca_object_pool<std::string> pool;
+    std::vector<std::string *> strings;
+    for (int i = 0; i < 100; ++i) {
+        strings.push_back(pool.create(std::string(40, static_cast<char>('a' + i % 26))));
+    }
+    EXPECT_EQ(*strings[27], std::string(40, 'b'));
+    for (std::string *s : strings) {
+        pool.destroy(s);
+    }
+    pool.destroy(nullptr);
+    EXPECT_GE(pool.stats().peak_reserved, 100 * sizeof(std::string));
+}
@@ -0,0 +1,311 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_string/test_ca_buffer.cpp
+//
+// @file
+// @brief Tests ca_buffer functions.
+// ================================
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "ca_string.h"
+
+using namespace ca;
+using namespace ca::ca_string;
+
+namespace {
+
+using ascii_buffer = ca_buffer<ca_encoding_t::CA_ENCODING_ASCII>;
+using utf8_buffer = ca_buffer<ca_encoding_t::CA_ENCODING_UTF8>;
+using utf32_buffer = ca_buffer<ca_encoding_t::CA_ENCODING_UTF32>;
+
+ascii_buffer make_ascii(std::string &s) {
+    return { reinterpret_cast<ca_char_t *>(s.data()), s.size() };
+}
+
+utf8_buffer make_utf8(std::string &s) {
+    return { reinterpret_cast<ca_char_t *>(s.data()), s.size() };
+}
+
+utf32_buffer make_utf32(std::vector<ca_char4_t> &s) {
+    return { reinterpret_cast<ca_char_t *>(s.data()), s.size() * sizeof(ca_char4_t) };
+}
+
+}
+
+// ===============================
+// Case mapping
+// ===============================
+
+TEST(CaBufferTest, ToLower_ASCII) {
+    // longer than one SIMD block, with a tail
+    std::string in = "Hello WORLD, Static_Analyzer 0123 [AZaz@`{] ~End";
+    std::string out(in.size(), '\0');
+    const ascii_buffer src = make_ascii(in);
+
+    EXPECT_EQ(src.to_lower_size(), in.size());
+    EXPECT_EQ(src.to_lower(make_ascii(out)), in.size());
+    EXPECT_EQ(out, "hello world, static_analyzer 0123 [azaz@`{] ~end");
+}
+
+TEST(CaBufferTest, ToUpper_ASCII) {
+    std::string in = "Hello WORLD, Static_Analyzer 0123 [AZaz@`{] ~End";
+    std::string out(in.size(), '\0');
+    const ascii_buffer src = make_ascii(in);
+
+    EXPECT_EQ(src.to_upper(make_ascii(out)), in.size());
+    EXPECT_EQ(out, "HELLO WORLD, STATIC_ANALYZER 0123 [AZAZ@`{] ~END");
+}
+
+TEST(CaBufferTest, ToLower_ASCII_InPlace) {
+    std::string in = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    const ascii_buffer src = make_ascii(in);
+
+    EXPECT_EQ(src.to_lower(src), in.size());
+    EXPECT_EQ(in, "abcdefghijklmnopqrstuvwxyz");
+}
+
+TEST(CaBufferTest, ToLower_ASCII_HighBytesUnchanged) {
+    std::string in = "\xC0\xD0\xE0\xFF" "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    std::string out(in.size(), '\0');
+    const ascii_buffer src = make_ascii(in);
+
+    src.to_lower(make_ascii(out));
+    EXPECT_EQ(out, "\xC0\xD0\xE0\xFF" "abcdefghijklmnopqrstuvwxyz");
+}
+
+TEST(CaBufferTest, ToLower_UTF8_Mixed) {
+    // ASCII blocks around multibyte characters
+    std::string in = "IDENTIFIER_NUMBER_ONE \xC3\x89T\xC3\x89 IDENTIFIER_NUMBER_TWO";  // ÉTÉ
+    const utf8_buffer src = make_utf8(in);
+
+    const ca_size_t size = src.to_lower_size();
+    ASSERT_EQ(size, in.size());
+
+    std::string out(size, '\0');
+    EXPECT_EQ(src.to_lower(make_utf8(out)), size);
+    EXPECT_EQ(out, "identifier_number_one \xC3\xA9t\xC3\xA9 identifier_number_two");  // été
+}
+
+TEST(CaBufferTest, ToUpper_UTF8_LengthChanges) {
+    // U+0131 (dotless i, 2 bytes) maps to 'I' (1 byte)
+    std::string in = "\xC4\xB1" "dentifier";
+    const utf8_buffer src = make_utf8(in);
+
+    const ca_size_t size = src.to_upper_size();
+    EXPECT_EQ(size, in.size() - 1);
+
+    std::string out(size, '\0');
+    EXPECT_EQ(src.to_upper(make_utf8(out)), size);
+    EXPECT_EQ(out, "IDENTIFIER");
+}
+
+TEST(CaBufferTest, Casefold_UTF8_Expands) {
+    // U+00DF (sharp s) folds to "ss"
+    std::string in = "Stra\xC3\x9F" "e_WITH_A_LONG_ASCII_SUFFIX_TO_FILL_BLOCKS";
+    const utf8_buffer src = make_utf8(in);
+
+    const ca_size_t size = src.casefold_size();
+    EXPECT_EQ(size, in.size());  // 2 bytes folded into 2 bytes
+
+    std::string out(size, '\0');
+    EXPECT_EQ(src.casefold(make_utf8(out)), size);
+    EXPECT_EQ(out, "strasse_with_a_long_ascii_suffix_to_fill_blocks");
+}
+
+TEST(CaBufferTest, Casefold_UTF8_CaselessEquality) {
+    std::string a = "MAX_BUFFER_SIZE_\xC3\x84";  // Ä
+    std::string b = "max_buffer_size_\xC3\xA4";  // ä
+    const utf8_buffer buf_a = make_utf8(a);
+    const utf8_buffer buf_b = make_utf8(b);
+
+    std::string fa(buf_a.casefold_size(), '\0');
+    std::string fb(buf_b.casefold_size(), '\0');
+    buf_a.casefold(make_utf8(fa));
+    buf_b.casefold(make_utf8(fb));
+    EXPECT_EQ(fa, fb);
+}
+
+TEST(CaBufferTest, ToUpper_UTF32_Mixed) {
+    std::vector<ca_char4_t> in = { 'a', 'b', 'c', 'd', 0x00E9, 'f', 'g', 'h', 'i', 'j', '_', '1' };
+    std::vector<ca_char4_t> out(in.size(), 0);
+    const utf32_buffer src = make_utf32(in);
+
+    EXPECT_EQ(src.to_upper_size(), in.size());
+    EXPECT_EQ(src.to_upper(make_utf32(out)), in.size());
+
+    const std::vector<ca_char4_t> expected = { 'A', 'B', 'C', 'D', 0x00C9, 'F', 'G', 'H', 'I', 'J', '_', '1' };
+    EXPECT_EQ(out, expected);
+}
+
+TEST(CaBufferTest, Casefold_UTF32_Expands) {
+    std::vector<ca_char4_t> in = { 'G', 'R', 'O', 0x00DF, 'E' };
+    const utf32_buffer src = make_utf32(in);
+
+    const ca_size_t size = src.casefold_size();
+    ASSERT_EQ(size, in.size() + 1);
+
+    std::vector<ca_char4_t> out(size, 0);
+    EXPECT_EQ(src.casefold(make_utf32(out)), size);
+
+    const std::vector<ca_char4_t> expected = { 'g', 'r', 'o', 's', 's', 'e' };
+    EXPECT_EQ(out, expected);
+}
+
+TEST(CaBufferTest, CaseMapping_Empty) {
+    const utf8_buffer src;
+    EXPECT_EQ(src.to_lower_size(), 0u);
+    EXPECT_EQ(src.to_lower(utf8_buffer()), 0u);
+}
+
+// ===============================
+// Block iteration
+// ===============================
+
+namespace {
+
+template <ca_encoding_t encoding>
+std::vector<ca_char4_t> decode_blocks(const ca_buffer<encoding> &buffer, ca_size_t *num_blocks = nullptr) {
+    std::vector<ca_char4_t> result;
+    ca_buffer_block_iterator<encoding> iter(buffer);
+    ca_size_t blocks = 0;
+    for (auto block = iter.next(); !block.empty(); block = iter.next()) {
+        EXPECT_LE(block.size(), ca_buffer_block_iterator<encoding>::BLOCK_SIZE);
+        result.insert(result.end(), block.begin(), block.end());
+        ++blocks;
+    }
+    if (num_blocks != nullptr) {
+        *num_blocks = blocks;
+    }
+    return result;
+}
+
+template <ca_encoding_t encoding>
+std::vector<ca_char4_t> decode_one_by_one(ca_buffer<encoding> buffer) {
+    std::vector<ca_char4_t> result;
+    const ca_size_t n = buffer.num_codepoints();
+    for (ca_size_t i = 0; i < n; ++i) {
+        result.push_back(*buffer);
+        ++buffer;
+    }
+    return result;
+}
+
+}
+
+TEST(CaBufferTest, BlockIterator_ASCII) {
+    std::string in(75, 'a');
+    for (size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<char>('!' + i);
+    }
+    in += std::string(3, '\0');  // trailing nulls are not iterated
+
+    ca_size_t blocks = 0;
+    const std::vector<ca_char4_t> decoded = decode_blocks(make_ascii(in), &blocks);
+    EXPECT_EQ(decoded, decode_one_by_one(make_ascii(in)));
+    EXPECT_EQ(decoded.size(), 75u);
+    EXPECT_EQ(blocks, 3u);
+}
+
+TEST(CaBufferTest, BlockIterator_UTF8) {
+    // ASCII runs long enough for the SIMD path, split by multibyte characters
+    std::string in;
+    for (int i = 0; i < 20; ++i) {
+        in += "static_identifier_";
+        in += (i % 2 == 0) ? "\xC3\xA9" : "\xF0\x9F\x98\x80";
+        in += "\xE2\x82\xAC";
+    }
+
+    const std::vector<ca_char4_t> decoded = decode_blocks(make_utf8(in));
+    EXPECT_EQ(decoded, decode_one_by_one(make_utf8(in)));
+    EXPECT_EQ(decoded.size(), 20u * 20u);
+}
+
+TEST(CaBufferTest, BlockIterator_UTF32) {
+    std::vector<ca_char4_t> in;
+    for (ca_char4_t c = 0x41; c < 0x41 + 40; ++c) {
+        in.push_back(c);
+    }
+    in.push_back(0x1F600);
+    in.push_back(0);
+
+    const std::vector<ca_char4_t> decoded = decode_blocks(make_utf32(in));
+    EXPECT_EQ(decoded, std::vector<ca_char4_t>(in.begin(), in.end() - 1));
+}
+
+TEST(CaBufferTest, BlockIterator_Empty) {
+    EXPECT_TRUE(decode_blocks(utf8_buffer()).empty());
+    std::string nulls(4, '\0');
+    EXPECT_TRUE(decode_blocks(make_ascii(nulls)).empty());
+}
+
+TEST(CaBufferTest, UnaryLoop_AcrossBlocks) {
+    std::string alpha = std::string(40, 'x') + "\xC3\xA9" + std::string(40, 'y');
+    EXPECT_TRUE(make_utf8(alpha).is_alpha());
+    EXPECT_TRUE(make_utf8(alpha).islower());
+    EXPECT_FALSE(make_utf8(alpha).isupper());
+
+    std::string mixed = alpha + "1";
+    EXPECT_FALSE(make_utf8(mixed).is_alpha());
+    EXPECT_TRUE(make_utf8(mixed).is_alphanumeric());
+
+    std::string title = "Static Analyzer For C Sources With Long Titles";
+    EXPECT_TRUE(make_ascii(title).istitle());
+    std::string not_title = "Static Analyzer For C Sources With long Titles";
+    EXPECT_FALSE(make_ascii(not_title).istitle());
+
+    std::string empty;
+    EXPECT_FALSE(make_ascii(empty).is_alpha());
+}
+
+TEST(CaBufferTest, Strcmp_Blocks) {
+    std::string a = std::string(50, 'a') + "\xC3\xA9" + "b";
+    std::string b = std::string(50, 'a') + "\xC3\xA9" + "c";
+    std::string a_nulls = a + std::string(20, '\0');
+    std::string a_space = a + "  \t";
+
+    EXPECT_LT(make_utf8(a).strcmp(make_utf8(b)), 0);
+    EXPECT_GT(make_utf8(b).strcmp(make_utf8(a)), 0);
+    EXPECT_EQ(make_utf8(a).strcmp(make_utf8(a_nulls)), 0);
+    EXPECT_EQ(make_utf8(a_nulls).strcmp(make_utf8(a)), 0);
+    EXPECT_GT(make_utf8(a_space).strcmp(make_utf8(a)), 0);
+    EXPECT_EQ(make_utf8(a_space).strcmp(make_utf8(a), true), 0);
+
+    std::string prefix = std::string(50, 'a');
+    EXPECT_GT(make_ascii(a).strcmp(make_ascii(prefix)), 0);
+    EXPECT_LT(make_ascii(prefix).strcmp(make_ascii(a)), 0);
+
+    std::vector<ca_char4_t> u1 = { 'a', 0x1F600, 'b' };
+    std::vector<ca_char4_t> u2 = { 'a', 0x1F600, 'c', 0 };
+    EXPECT_LT(make_utf32(u1).strcmp(make_utf32(u2)), 0);
+}
+
+TEST(CaBufferTest, Rstrip_ReturnsView) {
+    std::string in = "value \t\n";
+    const utf8_buffer src = make_utf8(in);
+    const utf8_buffer stripped = src.rstrip();
+
+    EXPECT_EQ(stripped.after - stripped.buf, 5);
+    EXPECT_EQ(src.after - src.buf, static_cast<ca_ssize_t>(in.size()));  // unchanged
+
+    std::string spaces = "   ";
+    EXPECT_TRUE(make_ascii(spaces).rstrip().empty());
+}
+
+TEST(CaBufferTest, BufferMemset) {
+    std::string out(200, '\0');
+    utf8_buffer dst = make_utf8(out);
+    EXPECT_EQ(dst.buffer_memset(0x20AC, 66), 66u * 3);  // €
+    std::string expected;
+    for (int i = 0; i < 66; ++i) {
+        expected += "\xE2\x82\xAC";
+    }
+    EXPECT_EQ(out.substr(0, expected.size()), expected);
+    EXPECT_EQ(out[expected.size()], '\0');
+
+    std::vector<ca_char4_t> out32(10, 0);
+    utf32_buffer dst32 = make_utf32(out32);
+    EXPECT_EQ(dst32.buffer_memset(0x1F600, 9), 9u);
+    EXPECT_EQ(out32, std::vector<ca_char4_t>({ 0x1F600, 0x1F600, 0x1F600, 0x1F600, 0x1F600,
+                                               0x1F600, 0x1F600, 0x1F600, 0x1F600, 0 }));
+}
@@ -0,0 +1,176 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_string/test_ca_hash.cpp
+//
+// @file
+// @brief Tests the 64-bit and 128-bit hashes against reference values and
+//        the streaming interface against one-shot hashing.
+// ================================
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "ca_string.h"
+
+using namespace ca;
+using namespace ca::ca_string;
+
+namespace {
+
+/**
+ * Reference value of XXH3 from xxHash 0.8.
+ */
+struct hash_vector {
+    ca_size_t size;
+    ca_uint64_t seed;
+    ca_uint64_t hash64;
+    ca_uint64_t hash128_low;
+    ca_uint64_t hash128_high;
+};
+
+// Lengths around every size class boundary of the hash
+constexpr hash_vector VECTORS[] = {
+    { 0, 0x0ULL, 0x2d06800538d394c2ULL, 0x6001c324468d497fULL, 0x99aa06d3014798d8ULL },
+    { 0, 0x9e3779b97f4a7c15ULL, 0x602b0e2cd6662c8bULL, 0x4ca5176998171787ULL, 0xd142977a2cca554bULL },
+    { 1, 0x0ULL, 0x13e608bc156defedULL, 0x13e608bc156defedULL, 0x22bbb76b211a39baULL },
+    { 1, 0x9e3779b97f4a7c15ULL, 0x1b4c466098160569ULL, 0x1b4c466098160569ULL, 0x8b0bde64ebb5391aULL },
+    { 3, 0x0ULL, 0x7a241cd186d86429ULL, 0x7a241cd186d86429ULL, 0x47395964ec9f014cULL },
+    { 3, 0x9e3779b97f4a7c15ULL, 0x5284c6e1cc192edcULL, 0x5284c6e1cc192edcULL, 0x187e911ed254dacbULL },
+    { 4, 0x0ULL, 0xee63e61db2240dfdULL, 0x5bbaa3cc92091074ULL, 0xa22d16fce91927e6ULL },
+    { 4, 0x9e3779b97f4a7c15ULL, 0x56b5e2e126853323ULL, 0x71cffd058e3b792dULL, 0x5324dc118cf1ffa2ULL },
+    { 8, 0x0ULL, 0xc79bde02ac2c4070ULL, 0x5e68e48c12c68b1cULL, 0xde8e0298e1e577a6ULL },
+    { 8, 0x9e3779b97f4a7c15ULL, 0x413251d6baa662c9ULL, 0xb2f1bdf6dba7358aULL, 0xb58e7eb0a9de750fULL },
+    { 9, 0x0ULL, 0xf0fe029643147ba0ULL, 0x8add9838deae7620ULL, 0x2f4075ff057503a4ULL },
+    { 9, 0x9e3779b97f4a7c15ULL, 0xe7e75d219d5637c2ULL, 0x7b6b2ea57cbf858eULL, 0xbb9ce3402c95d50cULL },
+    { 16, 0x0ULL, 0x3fb07c03792d802cULL, 0x4d305d93281918d4ULL, 0xb453d0434d2e6ef4ULL },
+    { 16, 0x9e3779b97f4a7c15ULL, 0x854d00ac2fe1360eULL, 0x4025d5f0b07ef882ULL, 0x7381e5851fdc5238ULL },
+    { 17, 0x0ULL, 0xb7166a1157e2e64bULL, 0x945e6c0a74141c83ULL, 0xa2b42b8e17a8bf63ULL },
+    { 17, 0x9e3779b97f4a7c15ULL, 0x70f200cd48562c08ULL, 0x73508a1987835edeULL, 0xa5f7959f8d1bc030ULL },
+    { 128, 0x0ULL, 0x07777867b1a4f190ULL, 0x7b303e83a6857c07ULL, 0xc6556250888874a4ULL },
+    { 128, 0x9e3779b97f4a7c15ULL, 0xc5b0c207c2435a02ULL, 0x160fd7dc9941cdc8ULL, 0xf520565c74597717ULL },
+    { 129, 0x0ULL, 0x767a4eb58d3d27e9ULL, 0x7f4e6cad6a193587ULL, 0x4ad58b604757cc78ULL },
+    { 129, 0x9e3779b97f4a7c15ULL, 0xc653b6ffd9a55d00ULL, 0x6bc048926952dae6ULL, 0xfa81b34ddeb242beULL },
+    { 240, 0x0ULL, 0xe544ded3a6e1802aULL, 0x553a3b1c95e75797ULL, 0x8af4452f2635aec7ULL },
+    { 240, 0x9e3779b97f4a7c15ULL, 0x42cd1b8f3a7a927bULL, 0x332c14b2fc72f877ULL, 0x0ddb52163869cb7fULL },
+    { 241, 0x0ULL, 0x5a0e42cf41af9a05ULL, 0x5a0e42cf41af9a05ULL, 0xbf4801b3e05df157ULL },
+    { 241, 0x9e3779b97f4a7c15ULL, 0x9adb7f04036a8dc9ULL, 0x9adb7f04036a8dc9ULL, 0x2aa1e6f886d4bbf3ULL },
+    { 1024, 0x0ULL, 0x357fdbb193091875ULL, 0x357fdbb193091875ULL, 0x85d83b580a4b567eULL },
+    { 1024, 0x9e3779b97f4a7c15ULL, 0x9e498778f9e0ac32ULL, 0x9e498778f9e0ac32ULL, 0xdf6d9656929aed83ULL },
+    { 3000, 0x0ULL, 0x26aad9e9a1b3a109ULL, 0x26aad9e9a1b3a109ULL, 0x614a6fc1161f58b9ULL },
+    { 3000, 0x9e3779b97f4a7c15ULL, 0x773dc7a7394d77eeULL, 0x773dc7a7394d77eeULL, 0x8ce6172f15db6812ULL },
+};
+
+/**
+ * Returns the deterministic input the reference values were computed on.
+ */
+std::vector<ca_char_t> pattern(const ca_size_t size) {
+    std::vector<ca_char_t> data(size);
+    for (ca_size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<ca_char_t>((i * 131 + 7) >> 1);
+    }
+    return data;
+}
+
+}
+
+// ===============================
+// One-shot hashing
+// ===============================
+
+TEST(CaHashTest, Hash64_ReferenceVectors) {
+    const std::vector<ca_char_t> data = pattern(3000);
+    for (const hash_vector &v : VECTORS) {
+        EXPECT_EQ(ca_hash64(data.data(), v.size, v.seed), v.hash64) << "size " << v.size << " seed " << v.seed;
+    }
+}
+
+TEST(CaHashTest, Hash128_ReferenceVectors) {
+    const std::vector<ca_char_t> data = pattern(3000);
+    for (const hash_vector &v : VECTORS) {
+        const ca_hash128_t h = ca_hash128(data.data(), v.size, v.seed);
+        EXPECT_EQ(h.low, v.hash128_low) << "size " << v.size << " seed " << v.seed;
+        EXPECT_EQ(h.high, v.hash128_high) << "size " << v.size << " seed " << v.seed;
+    }
+}
+
+TEST(CaHashTest, Hash_UnalignedInput) {
+    const std::vector<ca_char_t> data = pattern(3000);
+    for (const ca_size_t size : { 17, 200, 1000, 2999 }) {
+        std::vector<ca_char_t> shifted(size + 1);
+        memcpy(shifted.data() + 1, data.data(), size);
+        EXPECT_EQ(ca_hash64(shifted.data() + 1, size), ca_hash64(data.data(), size));
+        EXPECT_EQ(ca_hash128(shifted.data() + 1, size), ca_hash128(data.data(), size));
+    }
+}
+
+TEST(CaHashTest, Hash_Buffer) {
+    std::string text = "identifier_name";
+    ca_buffer<ca_encoding_t::CA_ENCODING_UTF8> buffer(reinterpret_cast<ca_char_t *>(text.data()), text.size());
+    const auto *bytes = reinterpret_cast<const ca_char_t *>(text.data());
+    EXPECT_EQ(ca_hash64(buffer), ca_hash64(bytes, text.size()));
+    EXPECT_EQ(ca_hash128(buffer, 7), ca_hash128(bytes, text.size(), 7));
+    EXPECT_EQ(ca_hash64(ca_buffer<ca_encoding_t::CA_ENCODING_UTF8>()), ca_hash64(nullptr, 0));
+}
+
+// ===============================
+// Streaming hashing
+// ===============================
+
+TEST(CaHashTest, State_RandomSplitsMatchOneShot) {
+    const std::vector<ca_char_t> data = pattern(3000);
+    std::mt19937 rng(42);
+
+    for (const hash_vector &v : VECTORS) {
+        for (const ca_size_t max_piece : { 1, 15, 64, 300, 4096 }) {
+            ca_hash_state state(v.seed);
+            ca_size_t pos = 0;
+            while (pos < v.size) {
+                const ca_size_t piece = std::min<ca_size_t>(v.size - pos, rng() % max_piece + 1);
+                state.update(data.data() + pos, piece);
+                pos += piece;
+            }
+            EXPECT_EQ(state.total_size(), v.size);
+            EXPECT_EQ(state.digest64(), v.hash64) << "size " << v.size << " piece " << max_piece;
+            EXPECT_EQ(state.digest128(), (ca_hash128_t{ v.hash128_low, v.hash128_high }))
+                << "size " << v.size << " piece " << max_piece;
+        }
+    }
+}
+
+TEST(CaHashTest, State_DigestDoesNotEndStream) {
+    const std::vector<ca_char_t> data = pattern(3000);
+    ca_hash_state state;
+    state.update(data.data(), 1000);
+    EXPECT_EQ(state.digest64(), ca_hash64(data.data(), 1000));
+    state.update(data.data() + 1000, 2000);
+    EXPECT_EQ(state.digest64(), ca_hash64(data.data(), 3000));
+
+    state.reset(3);
+    state.update(data.data(), 10);
+    EXPECT_EQ(state.digest64(), ca_hash64(data.data(), 10, 3));
+}
+
+TEST(CaHashTest, State_HashesStreamChunks) {
+    std::string text;
+    for (int i = 0; i < 500; ++i) {
+        text += "static int value_" + std::to_string(i) + " = \"\xC3\xA9\xE2\x82\xAC\";\n";
+    }
+
+    auto pos = std::make_shared<ca_size_t>(0);
+    ca_stream stream([&text, pos](ca_char_t *buf, const ca_size_t size) -> ca_ssize_t {
+        const ca_size_t n = std::min({ ca_size_t{ 37 }, size, text.size() - *pos });
+        memcpy(buf, text.data() + *pos, n);
+        *pos += n;
+        return static_cast<ca_ssize_t>(n);
+    }, 100);
+
+    ca_hash_state state;
+    ca_buffer<ca_encoding_t::CA_ENCODING_UTF8> chunk;
+    while (stream.next(&chunk) == ca_stream_status::CA_STREAM_OK) {
+        state.update(chunk);
+    }
+    EXPECT_EQ(state.digest64(), ca_hash64(reinterpret_cast<const ca_char_t *>(text.data()), text.size()));
+}
@@ -0,0 +1,150 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_string/test_ca_intern_pool.cpp
+//
+// @file
+// @brief Tests the string interning pools.
+// ================================
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ca_string.h"
+
+using namespace ca;
+using namespace ca::ca_string;
+
+namespace {
+
+const ca_char_t *bytes(const std::string &s) {
+    return reinterpret_cast<const ca_char_t *>(s.data());
+}
+
+std::string to_string(const ca_buffer<ca_encoding_t::CA_ENCODING_UTF8> &view) {
+    return { reinterpret_cast<const char *>(view.buf), static_cast<size_t>(view.after - view.buf) };
+}
+
+}
+
+TEST(CaInternPoolTest, Intern_Deduplicates) {
+    ca_intern_pool pool;
+    const std::string a = "identifier";
+    const std::string b = "identifier";
+    const std::string c = "identifie";
+
+    const auto id_a = pool.intern(bytes(a), a.size());
+    const auto id_b = pool.intern(bytes(b), b.size());
+    const auto id_c = pool.intern(bytes(c), c.size());
+
+    EXPECT_EQ(id_a, 0u);
+    EXPECT_EQ(id_a, id_b);
+    EXPECT_EQ(id_c, 1u);
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(pool.find(bytes(a), a.size()), id_a);
+
+    const std::string missing = "other";
+    EXPECT_EQ(pool.find(bytes(missing), missing.size()), ca_intern_pool::INVALID_ID);
+}
+
+TEST(CaInternPoolTest, View_IsZeroCopyAndStable) {
+    ca_intern_pool pool(256);
+    const std::string first = "first_symbol";
+    const auto id = pool.intern(bytes(first), first.size());
+    const auto view = pool.view(id);
+
+    // Force many chunks and table growth
+    for (int i = 0; i < 5000; ++i) {
+        const std::string s = "sym_" + std::to_string(i);
+        pool.intern(bytes(s), s.size());
+    }
+
+    EXPECT_EQ(pool.view(id).buf, view.buf);
+    EXPECT_EQ(to_string(view), first);
+    EXPECT_EQ(view.after[0], '\0');
+    EXPECT_EQ(pool.length(id), first.size());
+}
+
+TEST(CaInternPoolTest, Intern_ManyStrings) {
+    ca_intern_pool pool(128);
+    std::vector<ca_intern_pool::id_type> ids;
+    for (int i = 0; i < 20000; ++i) {
+        const std::string s = "name_" + std::to_string(i * 7919);
+        ids.push_back(pool.intern(bytes(s), s.size()));
+    }
+    ASSERT_EQ(pool.size(), 20000u);
+
+    for (int i = 0; i < 20000; ++i) {
+        const std::string s = "name_" + std::to_string(i * 7919);
+        ASSERT_EQ(pool.find(bytes(s), s.size()), ids[i]);
+        ASSERT_EQ(to_string(pool.view(ids[i])), s);
+    }
+}
+
+TEST(CaInternPoolTest, Intern_SpecialStrings) {
+    ca_intern_pool pool(64);
+    const std::string empty;
+    const std::string with_null("a\0b", 3);
+    const std::string large(1000, 'x');  // larger than a chunk
+
+    const auto id_empty = pool.intern(bytes(empty), 0);
+    const auto id_null = pool.intern(bytes(with_null), with_null.size());
+    const auto id_large = pool.intern(bytes(large), large.size());
+
+    EXPECT_EQ(pool.intern(nullptr, 0), id_empty);
+    EXPECT_EQ(pool.length(id_empty), 0u);
+    EXPECT_NE(pool.find(bytes(with_null), 1), id_null);
+    EXPECT_EQ(to_string(pool.view(id_null)), with_null);
+    EXPECT_EQ(to_string(pool.view(id_large)), large);
+}
+
+TEST(CaInternPoolTest, Intern_Buffer) {
+    ca_intern_pool pool;
+    std::string s = "\xC3\xA9t\xC3\xA9";
+    const ca_buffer<ca_encoding_t::CA_ENCODING_UTF8> buffer(reinterpret_cast<ca_char_t *>(s.data()), s.size());
+
+    const auto id = pool.intern(buffer);
+    EXPECT_EQ(pool.find(bytes(s), s.size()), id);
+    EXPECT_EQ(pool.view(id).num_codepoints(), 3u);
+}
+
+TEST(CaShardedInternPoolTest, Intern_Concurrent) {
+    ca_sharded_intern_pool pool(8);
+    constexpr int num_threads = 8;
+    constexpr int num_strings = 2000;
+
+    std::vector<std::vector<ca_sharded_intern_pool::id_type>> ids(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&pool, &ids, t] {
+            // Every thread interns the same strings in a different order
+            ids[t].resize(num_strings);
+            for (int i = 0; i < num_strings; ++i) {
+                const int k = (i + t * 257) % num_strings;
+                const std::string s = "token_" + std::to_string(k);
+                ids[t][k] = pool.intern(bytes(s), s.size());
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(pool.size(), static_cast<ca_size_t>(num_strings));
+    for (int i = 0; i < num_strings; ++i) {
+        const std::string s = "token_" + std::to_string(i);
+        for (int t = 1; t < num_threads; ++t) {
+            ASSERT_EQ(ids[t][i], ids[0][i]);
+        }
+        ASSERT_EQ(pool.find(bytes(s), s.size()), ids[0][i]);
+        ASSERT_EQ(to_string(pool.view(ids[0][i])), s);
+    }
+}
+
+TEST(CaShardedInternPoolTest, SingleShard) {
+    ca_sharded_intern_pool pool(1);
+    const std::string a = "a";
+    const std::string b = "b";
+    EXPECT_EQ(pool.intern(bytes(a), 1), 0u);
+    EXPECT_EQ(pool.intern(bytes(b), 1), 1u);
+    EXPECT_EQ(pool.intern(bytes(a), 1), 0u);
+}
@@ -0,0 +1,120 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_string/test_ca_line_index.cpp
+//
+// @file
+// @brief Tests the line start offset index.
+// ================================
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "ca_string.h"
+
+using namespace ca;
+using namespace ca::ca_string;
+
+namespace {
+
+const ca_char_t *bytes(const std::string &s) {
+    return reinterpret_cast<const ca_char_t *>(s.data());
+}
+
+}
+
+TEST(CaLineIndexTest, Build_Empty) {
+    ca_line_index index;
+    ASSERT_EQ(index.build(nullptr, 0), 0);
+    EXPECT_EQ(index.num_lines(), 1u);
+    EXPECT_EQ(index.line_of(0), 0u);
+    EXPECT_EQ(index.line_end(0), 0u);
+}
+
+TEST(CaLineIndexTest, Build_LineStarts) {
+    const std::string text = "int main(void) {\n    return 0;\n}\n";
+    ca_line_index index;
+    ASSERT_EQ(index.build(bytes(text), text.size()), 0);
+
+    ASSERT_EQ(index.num_lines(), 4u);
+    EXPECT_EQ(index.line_start(0), 0u);
+    EXPECT_EQ(index.line_start(1), 17u);
+    EXPECT_EQ(index.line_start(2), 31u);
+    EXPECT_EQ(index.line_start(3), 33u);
+    EXPECT_EQ(index.line_end(0), 16u);
+    EXPECT_EQ(index.line_end(3), text.size());
+}
+
+TEST(CaLineIndexTest, LineOf_MatchesScalarScan) {
+    // Long enough to exercise the vector loop, with irregular line lengths
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text.append(static_cast<size_t>(i % 37), 'x');
+        text.push_back('\n');
+    }
+    text += "last line without terminator";
+
+    ca_line_index index;
+    ASSERT_EQ(index.build(bytes(text), text.size()), 0);
+    ASSERT_EQ(index.num_lines(), 201u);
+
+    ca_size_t line = 0;
+    for (ca_size_t offset = 0; offset < text.size(); ++offset) {
+        ASSERT_EQ(index.line_of(offset), line) << "offset " << offset;
+        if (text[offset] == '\n') {
+            ++line;
+        }
+    }
+    EXPECT_EQ(index.line_of(text.size() + 10), 200u);
+}
+
+TEST(CaLineIndexTest, ColumnOf_Utf8) {
+    // "é" and "€" are 2 and 3 bytes
+    const std::string text = "first\n  x = \"\xC3\xA9\xE2\x82\xAC\"; y\n";
+    ca_line_index index;
+    ASSERT_EQ(index.build(bytes(text), text.size()), 0);
+
+    const ca_size_t y_offset = text.find('y');
+    ca_size_t line = 0;
+    ca_size_t column = 0;
+    index.location_of(bytes(text), y_offset, &line, &column);
+    EXPECT_EQ(line, 1u);
+    EXPECT_EQ(column, 12u);  // 15 bytes, 12 code points
+    EXPECT_EQ(index.column_of(bytes(text), y_offset), 12u);
+    EXPECT_EQ(index.column_of(bytes(text), 6), 0u);
+}
+
+TEST(CaLineIndexTest, Serialize_RoundTrip) {
+    const std::string text = "a\nbb\n\nccc\r\ndddd";
+    ca_line_index index;
+    ASSERT_EQ(index.build(bytes(text), text.size()), 0);
+
+    std::vector<ca_char_t> data(index.serialized_size());
+    ASSERT_EQ(index.serialize(data.data(), data.size() - 1), -1);
+    ASSERT_EQ(index.serialize(data.data(), data.size()), 0);
+
+    ca_line_index restored;
+    ASSERT_EQ(restored.deserialize(data.data(), data.size()), 0);
+    ASSERT_EQ(restored.num_lines(), index.num_lines());
+    EXPECT_EQ(restored.source_size(), text.size());
+    for (ca_size_t i = 0; i < index.num_lines(); ++i) {
+        EXPECT_EQ(restored.line_start(i), index.line_start(i));
+    }
+}
+
+TEST(CaLineIndexTest, Deserialize_RejectsMalformed) {
+    const std::string text = "a\nb\nc";
+    ca_line_index index;
+    ASSERT_EQ(index.build(bytes(text), text.size()), 0);
+
+    std::vector<ca_char_t> data(index.serialized_size());
+    ASSERT_EQ(index.serialize(data.data(), data.size()), 0);
+
+    ca_line_index restored;
+    EXPECT_EQ(restored.deserialize(data.data(), data.size() - 1), -1);
+
+    std::vector<ca_char_t> bad_magic = data;
+    bad_magic[0] ^= 0xFF;
+    EXPECT_EQ(restored.deserialize(bad_magic.data(), bad_magic.size()), -1);
+
+    // restored is left unchanged
+    EXPECT_EQ(restored.num_lines(), 1u);
+}
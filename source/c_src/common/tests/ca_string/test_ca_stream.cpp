@@ -0,0 +1,160 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_string/test_ca_stream.cpp
+//
+// @file
+// @brief Tests the streaming UTF-8 decoder and the UTF-8 validation helpers.
+// ================================
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include "ca_string.h"
+
+using namespace ca;
+using namespace ca::ca_string;
+
+namespace {
+
+const ca_char_t *bytes(const std::string &s) {
+    return reinterpret_cast<const ca_char_t *>(s.data());
+}
+
+/**
+ * Returns a reader serving `text` in pieces of at most `piece` bytes.
+ */
+ca_stream_reader make_reader(const std::string &text, const ca_size_t piece) {
+    auto pos = std::make_shared<ca_size_t>(0);
+    return [text, piece, pos](ca_char_t *buf, const ca_size_t size) -> ca_ssize_t {
+        const ca_size_t n = std::min({ piece, size, text.size() - *pos });
+        memcpy(buf, text.data() + *pos, n);
+        *pos += n;
+        return static_cast<ca_ssize_t>(n);
+    };
+}
+
+/**
+ * Drains a stream, checking that no chunk splits a character.
+ */
+ca_stream_status drain(ca_stream &stream, std::string *out) {
+    ca_buffer<ca_encoding_t::CA_ENCODING_UTF8> chunk;
+    ca_stream_status status;
+    while ((status = stream.next(&chunk)) == ca_stream_status::CA_STREAM_OK) {
+        EXPECT_EQ(stream.chunk_offset(), out->size());
+        EXPECT_EQ(utf8::utf8_validate(chunk.buf, chunk.after - chunk.buf), 0);
+        out->append(reinterpret_cast<const char *>(chunk.buf), chunk.after - chunk.buf);
+    }
+    return status;
+}
+
+std::string mixed_text() {
+    // 1, 2, 3 and 4 byte characters at every alignment
+    std::string text;
+    for (int i = 0; i < 50; ++i) {
+        text += "int x";
+        text.append(static_cast<size_t>(i % 5), ' ');
+        text += "= \"\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\";\n";
+    }
+    return text;
+}
+
+}
+
+// ===============================
+// UTF-8 validation
+// ===============================
+
+TEST(CaStreamTest, Validate_AcceptsWellFormed) {
+    const std::string text = mixed_text();
+    EXPECT_EQ(utf8::utf8_validate(bytes(text), text.size()), 0);
+    EXPECT_EQ(utf8::utf8_validate(bytes(text), 0), 0);
+}
+
+TEST(CaStreamTest, Validate_RejectsMalformed) {
+    // Long ASCII runs before the error exercise the SIMD skip
+    const std::string prefix(40, 'a');
+    EXPECT_EQ(utf8::utf8_validate(bytes(prefix + "\xC0\xAF"), prefix.size() + 2), -1);          // overlong
+    EXPECT_EQ(utf8::utf8_validate(bytes(prefix + "\xED\xA0\x80"), prefix.size() + 3), -1);      // surrogate
+    EXPECT_EQ(utf8::utf8_validate(bytes(prefix + "\x80" + prefix), 2 * prefix.size() + 1), -1); // stray continuation
+    EXPECT_EQ(utf8::utf8_validate(bytes(prefix + "\xE2\x82"), prefix.size() + 2), -1);          // truncated
+}
+
+TEST(CaStreamTest, IncompleteTailSize) {
+    const std::string text = "ab\xF0\x9F\x98\x80";
+    EXPECT_EQ(utf8::utf8_incomplete_tail_size(bytes(text), text.size()), 0u);
+    EXPECT_EQ(utf8::utf8_incomplete_tail_size(bytes(text), 5), 3u);
+    EXPECT_EQ(utf8::utf8_incomplete_tail_size(bytes(text), 4), 2u);
+    EXPECT_EQ(utf8::utf8_incomplete_tail_size(bytes(text), 3), 1u);
+    EXPECT_EQ(utf8::utf8_incomplete_tail_size(bytes(text), 2), 0u);
+    EXPECT_EQ(utf8::utf8_incomplete_tail_size(bytes(text), 0), 0u);
+}
+
+// ===============================
+// Stream
+// ===============================
+
+TEST(CaStreamTest, Next_ReassemblesInput) {
+    const std::string text = mixed_text();
+
+    for (const ca_size_t chunk_size : { 16, 17, 31, 64, 1000 }) {
+        for (const ca_size_t piece : { 1, 3, 7, 4096 }) {
+            ca_stream stream(make_reader(text, piece), chunk_size);
+            std::string out;
+            ASSERT_EQ(drain(stream, &out), ca_stream_status::CA_STREAM_END)
+                << "chunk " << chunk_size << " piece " << piece;
+            EXPECT_EQ(out, text);
+            EXPECT_EQ(stream.bytes_decoded(), text.size());
+        }
+    }
+}
+
+TEST(CaStreamTest, Next_EmptyInput) {
+    ca_stream stream(make_reader("", 16));
+    ca_buffer<ca_encoding_t::CA_ENCODING_UTF8> chunk;
+    EXPECT_EQ(stream.next(&chunk), ca_stream_status::CA_STREAM_END);
+    EXPECT_EQ(stream.next(&chunk), ca_stream_status::CA_STREAM_END);
+}
+
+TEST(CaStreamTest, Next_InvalidInput) {
+    std::string text(100, 'a');
+    text[70] = '\xFF';
+
+    ca_stream stream(make_reader(text, 100), 32);
+    std::string out;
+    EXPECT_EQ(drain(stream, &out), ca_stream_status::CA_STREAM_INVALID_UTF8);
+    EXPECT_EQ(out.size(), 64u);  // the first two chunks were valid
+
+    // Without validation the bytes are passed through
+    ca_stream unchecked(make_reader(text, 100), 32, false);
+    ca_buffer<ca_encoding_t::CA_ENCODING_UTF8> chunk;
+    ca_size_t total = 0;
+    while (unchecked.next(&chunk) == ca_stream_status::CA_STREAM_OK) {
+        total += chunk.after - chunk.buf;
+    }
+    EXPECT_EQ(total, text.size());
+}
+
+TEST(CaStreamTest, Next_TruncatedAtEnd) {
+    const std::string text = std::string(20, 'a') + "\xE2\x82";
+    ca_stream stream(make_reader(text, 5), 16);
+    std::string out;
+    EXPECT_EQ(drain(stream, &out), ca_stream_status::CA_STREAM_INVALID_UTF8);
+    EXPECT_EQ(out, std::string(16, 'a'));
+}
+
+TEST(CaStreamTest, Next_ReadError) {
+    int calls = 0;
+    ca_stream stream([&calls](ca_char_t *buf, const ca_size_t size) -> ca_ssize_t {
+        if (calls++ > 0) {
+            return -1;
+        }
+        memset(buf, 'a', size);
+        return static_cast<ca_ssize_t>(size);
+    }, 16);
+
+    ca_buffer<ca_encoding_t::CA_ENCODING_UTF8> chunk;
+    EXPECT_EQ(stream.next(&chunk), ca_stream_status::CA_STREAM_OK);
+    EXPECT_EQ(stream.next(&chunk), ca_stream_status::CA_STREAM_READ_ERROR);
+    EXPECT_EQ(stream.next(&chunk), ca_stream_status::CA_STREAM_READ_ERROR);
+}
@@ -0,0 +1,85 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_task/test_ca_parallel.cpp
+//
+// @file
+// @brief Tests the parallel loops.
+// ================================
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include "ca_parallel.h"
+
+using namespace ca;
+using namespace ca::ca_task;
+
+TEST(CaParallelTest, For_CoversRangeOnce) {
+    ca_task_pool_options options;
+    options.threads = 4;
+    ca_task_pool pool(options);
+    for (const ca_size_t grain : { 0u, 1u, 7u, 5000u }) {
+        std::vector<std::atomic<int>> hits(10007);
+        std::atomic<ca_size_t> longest{ 0 };
+        ASSERT_EQ(ca_parallel_for(pool, 3, hits.size(), grain, [&](const ca_size_t b, const ca_size_t e) {
+            ca_size_t seen = longest.load();
+            while (e - b > seen && !longest.compare_exchange_weak(seen, e - b)) {}
+            for (ca_size_t i = b; i < e; ++i) {
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        }), 0);
+        for (ca_size_t i = 0; i < hits.size(); ++i) {
+            ASSERT_EQ(hits[i].load(), i < 3 ? 0 : 1) << "grain " << grain << " index " << i;
+        }
+        if (grain != 0) {
+            EXPECT_LE(longest.load(), grain);
+        }
+    }
+    EXPECT_EQ(ca_parallel_for(pool, 5, 5, 1, [](ca_size_t, ca_size_t) { FAIL(); }), 0);
+}
+
+TEST(CaParallelTest, For_StopsWhenCancelled) {
+    ca_task_pool_options options;
+    options.threads = 2;
+    ca_task_pool pool(options);
+    ca_cancel_token token;
+    std::atomic<int> chunks{ 0 };
+    EXPECT_EQ(ca_parallel_for(pool, 0, 100000, 1, [&](ca_size_t, ca_size_t) {
+        if (chunks.fetch_add(1) == 100) {
+            token.cancel();
+        }
+    }, &token), -1);
+    EXPECT_LT(chunks.load(), 100000);
+}
+
+TEST(CaParallelTest, Reduce_IsDeterministic) {
+    std::vector<double> values(100000);
+    for (ca_size_t i = 0; i < values.size(); ++i) {
+        values[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    const auto map = [&](const ca_size_t b, const ca_size_t e) {
+        double sum = 0;
+        for (ca_size_t i = b; i < e; ++i) {
+            sum += values[i];
+        }
+        return sum;
+    };
+    const auto add = [](const double a, const double b) { return a + b; };
+
+    // Chunks of 1000 combined left to right, whatever the threads
+    double expected = 0;
+    for (ca_size_t b = 0; b < values.size(); b += 1000) {
+        expected = add(expected, map(b, b + 1000));
+    }
+    for (const ca_size_t threads : { 1u, 3u, 8u }) {
+        ca_task_pool_options options;
+        options.threads = threads;
+        ca_task_pool pool(options);
+        EXPECT_EQ(ca_parallel_reduce(pool, 0, values.size(), 1000, 0.0, map, add), expected);
+    }
+
+    ca_task_pool pool;
+    const ca_uint64_t count = ca_parallel_reduce(pool, 10, 20, 0, ca_uint64_t{ 0 },
+        [](const ca_size_t b, const ca_size_t e) { return static_cast<ca_uint64_t>(e - b); },
+        [](const ca_uint64_t a, const ca_uint64_t b) { return a + b; });
+    EXPECT_EQ(count, 10u);
+}
@@ -0,0 +1,97 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_task/test_ca_task_graph.cpp
+//
+// @file
+// @brief Tests the task graph.
+// ================================
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include "ca_task_graph.h"
+
+using namespace ca;
+using namespace ca::ca_task;
+
+TEST(CaTaskGraphTest, Run_RespectsDependencies) {
+    ca_task_pool_options options;
+    options.threads = 3;
+    ca_task_pool pool(options);
+
+    // A diamond per column, each column depending on the previous one
+    constexpr int COLUMNS = 50;
+    std::atomic<int> clock{ 0 };
+    std::vector<int> finished(COLUMNS * 4, -1);
+    ca_task_graph graph;
+    std::vector<ca_task_graph::node_id> ids;
+    for (int i = 0; i < COLUMNS * 4; ++i) {
+        ids.push_back(graph.add([&, i] { finished[i] = clock.fetch_add(1); }));
+    }
+    for (int c = 0; c < COLUMNS; ++c) {
+        const int top = c * 4;
+        graph.precede(ids[top], ids[top + 1]);
+        graph.precede(ids[top], ids[top + 2]);
+        graph.precede(ids[top + 1], ids[top + 3]);
+        graph.precede(ids[top + 2], ids[top + 3]);
+        if (c != 0) {
+            graph.precede(ids[top - 1], ids[top]);
+        }
+    }
+    ASSERT_EQ(graph.size(), static_cast<ca_size_t>(COLUMNS * 4));
+
+    for (int round = 0; round < 2; ++round) {
+        clock.store(0);
+        ASSERT_EQ(graph.run(pool), 0);
+        for (int c = 0; c < COLUMNS; ++c) {
+            const int top = c * 4;
+            EXPECT_LT(finished[top], finished[top + 1]);
+            EXPECT_LT(finished[top], finished[top + 2]);
+            EXPECT_LT(finished[top + 1], finished[top + 3]);
+            EXPECT_LT(finished[top + 2], finished[top + 3]);
+            if (c != 0) {
+                EXPECT_LT(finished[top - 1], finished[top]);
+            }
+        }
+        EXPECT_EQ(clock.load(), COLUMNS * 4);
+    }
+}
+
+TEST(CaTaskGraphTest, Run_RejectsCycles) {
+    ca_task_pool pool;
+    int ran = 0;
+    ca_task_graph graph;
+    const auto a = graph.add([&] { ++ran; });
+    const auto b = graph.add([&] { ++ran; });
+    const auto c = graph.add([&] { ++ran; });
+    graph.precede(a, b);
+    graph.precede(b, c);
+    graph.precede(c, b);
+    EXPECT_EQ(graph.run(pool), -1);
+    EXPECT_EQ(ran, 0);
+
+    graph.clear();
+    EXPECT_EQ(graph.size(), 0u);
+    EXPECT_EQ(graph.run(pool), 0);
+}
+
+TEST(CaTaskGraphTest, Run_StopsWhenCancelled) {
+    ca_task_pool_options options;
+    options.threads = 2;
+    ca_task_pool pool(options);
+    ca_cancel_token token;
+    std::atomic<int> ran{ 0 };
+    ca_task_graph graph;
+    ca_task_graph::node_id previous = graph.add([&] { ++ran; });
+    for (int i = 1; i < 100; ++i) {
+        const auto next = graph.add([&, i] {
+            ++ran;
+            if (i == 10) {
+                token.cancel();
+            }
+        });
+        graph.precede(previous, next);
+        previous = next;
+    }
+    EXPECT_EQ(graph.run(pool, &token), -1);
+    EXPECT_EQ(ran.load(), 11);
+}
@@ -0,0 +1,114 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_task/test_ca_task_pool.cpp
+//
+// @file
+// @brief Tests the task pool, task groups and cancellation.
+// ================================
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "ca_task_pool.h"
+
+using namespace ca;
+using namespace ca::ca_task;
+
+TEST(CaTaskPoolTest, Threads_FollowOptions) {
+    ca_task_pool_options options;
+    options.threads = 3;
+    options.pin_threads = true;
+    ca_task_pool pool(options);
+#ifdef CA_ENABLE_THREADING
+    EXPECT_EQ(pool.threads(), 3u);
+#else
+    EXPECT_EQ(pool.threads(), 0u);
+#endif
+    EXPECT_EQ(pool.worker_index(), ca_task_pool::NOT_A_WORKER);
+}
+
+TEST(CaTaskPoolTest, Group_RunsEveryTask) {
+    ca_task_pool_options options;
+    options.threads = 4;
+    ca_task_pool pool(options);
+    std::atomic<int> sum{ 0 };
+    std::mutex lock;
+    std::set<ca_size_t> workers;
+    {
+        ca_task_group group(pool);
+        for (int i = 1; i <= 1000; ++i) {
+            group.run([&, i] {
+                sum.fetch_add(i, std::memory_order_relaxed);
+                std::lock_guard guard(lock);
+                workers.insert(pool.worker_index());
+            });
+        }
+        group.wait();
+        EXPECT_EQ(sum.load(), 500500);
+    }
+    for (const ca_size_t index : workers) {
+        EXPECT_TRUE(index == ca_task_pool::NOT_A_WORKER || index < pool.threads());
+    }
+    const ca_task_pool_stats stats = pool.stats();
+    EXPECT_EQ(stats.executed, 1000u);
+    EXPECT_EQ(stats.skipped, 0u);
+#ifdef CA_ENABLE_THREADING
+    EXPECT_EQ(stats.injected, 1000u);
+#endif
+}
+
+TEST(CaTaskPoolTest, Group_WaitsForNestedTasks) {
+    ca_task_pool_options options;
+    options.threads = 2;
+    ca_task_pool pool(options);
+    std::atomic<int> leaves{ 0 };
+
+    // Each task spawns two children in a group of its own and waits for
+    // them, so workers wait inside tasks and must help instead of blocking
+    std::function<void(int)> tree = [&](const int depth) {
+        if (depth == 0) {
+            leaves.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ca_task_group children(pool);
+        children.run([&, depth] { tree(depth - 1); });
+        children.run([&, depth] { tree(depth - 1); });
+        children.wait();
+    };
+    ca_task_group group(pool);
+    group.run([&] { tree(10); });
+    group.wait();
+    EXPECT_EQ(leaves.load(), 1024);
+}
+
+TEST(CaTaskPoolTest, Cancel_SkipsTasksNotStarted) {
+    ca_task_pool_options options;
+    options.threads = 2;
+    ca_task_pool pool(options);
+    ca_cancel_token token;
+    std::atomic<int> ran{ 0 };
+    {
+        ca_task_group group(pool, &token);
+        for (int i = 0; i < 1000; ++i) {
+            group.run([&] {
+                if (ran.fetch_add(1, std::memory_order_relaxed) == 9) {
+                    token.cancel();
+                }
+            });
+        }
+        group.wait();
+        EXPECT_TRUE(group.cancelled());
+    }
+    EXPECT_GE(ran.load(), 10);
+    EXPECT_LT(ran.load(), 1000);
+    const ca_task_pool_stats stats = pool.stats();
+    EXPECT_EQ(stats.executed + stats.skipped, 1000u);
+
+    token.reset();
+    ca_task_group again(pool, &token);
+    again.run([&] { ran.store(-1); });
+    again.wait();
+    EXPECT_EQ(ran.load(), -1);
+}
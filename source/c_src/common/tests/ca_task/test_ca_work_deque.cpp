@@ -0,0 +1,97 @@
+// ================================
+// CodeAnalyzer - source/c_src/common/tests/ca_task/test_ca_work_deque.cpp
+//
+// @file
+// @brief Tests the work-stealing deque.
+// ================================
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "ca_work_deque.h"
+
+using namespace ca;
+using namespace ca::ca_task;
+
+TEST(CaWorkDequeTest, PopIsLifoAndStealIsFifo) {
+    ca_work_deque<int> deque(4);
+    for (int i = 0; i < 4; ++i) {
+        deque.push(i);
+    }
+    EXPECT_EQ(deque.size(), 4u);
+
+    int item = -1;
+    ASSERT_TRUE(deque.pop(&item));
+    EXPECT_EQ(item, 3);
+    ASSERT_TRUE(deque.steal(&item));
+    EXPECT_EQ(item, 0);
+    ASSERT_TRUE(deque.pop(&item));
+    EXPECT_EQ(item, 2);
+    ASSERT_TRUE(deque.steal(&item));
+    EXPECT_EQ(item, 1);
+    EXPECT_FALSE(deque.pop(&item));
+    EXPECT_FALSE(deque.steal(&item));
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(CaWorkDequeTest, Push_GrowsKeepingOrder) {
+    ca_work_deque<int> deque(2);
+    int item = -1;
+    // Moves `top` away from 0 so the copy wraps around the ring
+    deque.push(-1);
+    ASSERT_TRUE(deque.steal(&item));
+    for (int i = 0; i < 1000; ++i) {
+        deque.push(i);
+    }
+    EXPECT_EQ(deque.size(), 1000u);
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_TRUE(deque.steal(&item));
+        EXPECT_EQ(item, i);
+    }
+    for (int i = 999; i >= 500; --i) {
+        ASSERT_TRUE(deque.pop(&item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(CaWorkDequeTest, ConcurrentSteal_TakesEachItemOnce) {
+    constexpr int ITEMS = 200000;
+    constexpr int THIEVES = 3;
+    ca_work_deque<int> deque(16);
+    std::vector<std::atomic<int>> taken(ITEMS);
+    std::atomic<bool> done{ false };
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < THIEVES; ++t) {
+        thieves.emplace_back([&] {
+            int item;
+            while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+                if (deque.steal(&item)) {
+                    taken[item].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    // The owner interleaves pushes and pops, racing the thieves for the last
+    // items and growing the ring under them
+    int item;
+    for (int i = 0; i < ITEMS; ++i) {
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(&item)) {
+            taken[item].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    while (deque.pop(&item)) {
+        taken[item].fetch_add(1, std::memory_order_relaxed);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &thief : thieves) {
+        thief.join();
+    }
+
+    for (int i = 0; i < ITEMS; ++i) {
+        ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+    }
+}
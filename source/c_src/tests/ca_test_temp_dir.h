@@ -0,0 +1,65 @@
+// ================================
+// CodeAnalyzer - source/c_src/tests/ca_test_temp_dir.h
+//
+// @file
+// @brief Defines `ca_temp_dir_test`, the base of the test fixtures working
+//        in a temporary directory.
+// ================================
+
+#ifndef CA_TEST_TEMP_DIR_H
+#define CA_TEST_TEMP_DIR_H
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace ca::ca_test {
+
+/**
+ * @class ca_temp_dir_test
+ * @brief Creates a fresh temporary directory for each test, removed with
+ *        the fixture.
+ *
+ * The directory is named after the test suite, the random seed and the
+ * test, so parameterized tests and concurrent runs do not share one.
+ *
+ * @tparam Base `::testing::Test`, or `::testing::TestWithParam<T>`.
+ */
+template <typename Base = ::testing::Test>
+class ca_temp_dir_test : public Base {
+protected:
+    void SetUp() override {
+        const ::testing::TestInfo *info = ::testing::UnitTest::GetInstance()->current_test_info();
+        // Parameterized names have the form `Prefix/Suite` and `Test/0`
+        std::string name = std::string(info->test_suite_name()) + "_" +
+                           std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_" + info->name();
+        std::replace(name.begin(), name.end(), '/', '_');
+        dir = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    /**
+     * Writes a file below the directory, creating its parents.
+     *
+     * @return The path of the file.
+     */
+    std::string write_file(const std::string &name, const std::string &content) const {
+        const std::filesystem::path path = dir / name;
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary) << content;
+        return path.string();
+    }
+
+    std::filesystem::path dir;
+};
+
+}
+
+#endif //CA_TEST_TEMP_DIR_H